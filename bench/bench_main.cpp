@@ -0,0 +1,814 @@
+// Throughput benchmark of the Tx/Rx stages and the end-to-end chain.
+//
+//   dcomm_bench [--blocks N] [--symbols N] [--modulation NAME]...
+//               [--repeat N] [--output PATH]
+//               [--baseline PATH [--threshold PERCENT] [--min-delta US]]
+//
+// Every stage is timed on its own against a reference input block produced
+// by the stages before it; the reference is copied into a fresh pooled
+// buffer outside the timed region so in-place stages behave exactly as they
+// do inside the chain. Results go to stdout and to PATH (default
+// bench_output.txt) in the format documented in report.hpp. With --repeat
+// the whole set runs N times and each case reports its run with the lowest
+// p50.
+//
+// With --baseline the results are compared case by case against an earlier
+// report from the same machine, such as the one the bench_baseline target
+// records, and every case whose median block throughput fell by more than
+// the threshold (default 15%) and by at least --min-delta microseconds
+// (default 1) is listed; the exit status is then 3.
+// Running with DCOMM_ISA=scalar against a report of the vector kernels
+// shows the speedup of each one the same way.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dcomm/bits.hpp"
+#include "dcomm/channel.hpp"
+#include "dcomm/clock.hpp"
+#include "dcomm/complex_layout.hpp"
+#include "dcomm/convcode.hpp"
+#include "dcomm/crc.hpp"
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/ldpc.hpp"
+#include "dcomm/mimo.hpp"
+#include "dcomm/pipeline.hpp"
+#include "dcomm/resampler.hpp"
+#include "dcomm/scrambler.hpp"
+#include "dcomm/sync.hpp"
+#include "dcomm/turbo.hpp"
+#include "report.hpp"
+
+namespace dcomm::bench {
+namespace {
+
+struct Options {
+    std::size_t blocks = 2000;
+    std::size_t warmup = 100;
+    std::size_t symbols_per_block = 8;
+    std::vector<Modulation> modulations;
+    // Paths point into argv: a heap copy would shift every later allocation
+    // with the path length and with it the cache aliasing of the timed
+    // buffers, which moves some cases by a third between invocations.
+    const char* output = "bench_output.txt";
+    std::size_t repeat = 1;
+    const char* baseline = nullptr;
+    double threshold = 0.15;
+    double min_delta_us = 1.0;
+};
+
+constexpr Modulation kAllModulations[] = {Modulation::bpsk, Modulation::qpsk,
+                                          Modulation::qam16, Modulation::qam64,
+                                          Modulation::qam256};
+
+/// Per-block wall time and cycle samples of one case.
+class Recorder {
+public:
+    explicit Recorder(std::size_t blocks) { ns_.reserve(blocks); }
+
+    void add(std::uint64_t ns, std::uint64_t cycles) {
+        ns_.push_back(ns);
+        cycles_ += cycles;
+    }
+
+    CaseResult summarize(std::string name, std::size_t samples_per_block) {
+        CaseResult r;
+        r.name = std::move(name);
+        if (ns_.empty()) {
+            return r;
+        }
+        std::uint64_t total_ns = 0;
+        for (std::uint64_t v : ns_) {
+            total_ns += v;
+        }
+        const double samples = double(samples_per_block) * double(ns_.size());
+        r.msps = total_ns == 0 ? 0.0 : samples / (double(total_ns) * 1e-3);
+        r.cycles_per_sample = double(cycles_) / samples;
+        r.p50_us = percentile(0.50) * 1e-3;
+        r.p99_us = percentile(0.99) * 1e-3;
+        return r;
+    }
+
+private:
+    double percentile(double q) {
+        const std::size_t k =
+            std::min(ns_.size() - 1, std::size_t(q * double(ns_.size())));
+        std::nth_element(ns_.begin(), ns_.begin() + std::ptrdiff_t(k), ns_.end());
+        return double(ns_[k]);
+    }
+
+    std::vector<std::uint64_t> ns_;
+    std::uint64_t cycles_ = 0;
+};
+
+/// Time `fn` once per block after a warm-up; `fn` returns false on stall.
+template <class Fn>
+CaseResult run_case(std::string name, const Options& opt,
+                    std::size_t samples_per_block, Fn&& fn) {
+    Recorder rec(opt.blocks);
+    for (std::size_t i = 0; i < opt.warmup + opt.blocks; ++i) {
+        std::uint64_t ns = 0;
+        std::uint64_t cycles = 0;
+        if (!fn(ns, cycles)) {
+            throw std::runtime_error(name + ": pipeline stalled");
+        }
+        if (i >= opt.warmup) {
+            rec.add(ns, cycles);
+        }
+    }
+    return rec.summarize(std::move(name), samples_per_block);
+}
+
+/// Wrap a single-stage call with the untimed copy of its reference input.
+/// Stages taking scratch from `arena` get it reset after every block, as
+/// their chain would.
+template <class In, class Out>
+CaseResult bench_stage(const std::string& prefix, Stage<In, Out>& stage,
+                       const BufferView<In>& reference, const Options& opt,
+                       std::size_t samples_per_block, FrameArena* arena = nullptr) {
+    BufferPool<In> feed(2, reference.size());
+    return run_case(prefix + stage.name(), opt, samples_per_block,
+                    [&](std::uint64_t& ns, std::uint64_t& cycles) {
+                        BufferView<In> in = feed.acquire();
+                        std::copy(reference.begin(), reference.end(), in.begin());
+                        const std::uint64_t t0 = now_ns();
+                        const std::uint64_t c0 = read_cycles();
+                        BufferView<Out> out = stage.process(std::move(in));
+                        cycles = read_cycles() - c0;
+                        ns = now_ns() - t0;
+                        if (arena != nullptr) {
+                            arena->reset();
+                        }
+                        return bool(out);
+                    });
+}
+
+/// One draw per bit, so the data matches an unpacked fill from the same seed.
+void fill_random_bits(BitSpan bits, std::mt19937& rng) {
+    for (std::size_t i = 0; i < bits.size(); ++i) {
+        bits.set(i, rng() & 1u);
+    }
+}
+
+void bench_modulation(Modulation m, const Options& opt,
+                      std::vector<CaseResult>& results) {
+    PhyConfig config;
+    config.modulation = m;
+    config.symbols_per_block = opt.symbols_per_block;
+    const std::size_t spb = config.samples_per_block();
+
+    TxChain tx(config);
+    RxChain rx(config);
+
+    std::mt19937 rng(1234);
+    BufferView<std::uint64_t> data = tx.acquire_input();
+    fill_random_bits(BitSpan(data.span(), config.info_bits_per_block()), rng);
+
+    // Reference blocks at every stage boundary. Holding them keeps the
+    // stages below on their out-of-place path, which is fine here.
+    const auto scrambled = tx.scrambler().process(data);
+    const auto coded = tx.encoder().process(scrambled);
+    const auto interleaved = tx.interleaver().process(coded);
+    const auto symbols = tx.mapper().process(interleaved);
+    const auto samples = tx.modulator().process(symbols);
+    const auto rx_symbols = rx.demodulator().process(samples);
+    const auto llrs = rx.demapper().process(rx_symbols);
+    const auto deinterleaved = rx.deinterleaver().process(llrs);
+    const auto decoded = rx.decoder().process(deinterleaved);
+
+    const std::string tx_prefix = std::string(to_string(m)) + ".tx.";
+    const std::string rx_prefix = std::string(to_string(m)) + ".rx.";
+    results.push_back(bench_stage(tx_prefix, tx.scrambler(), data, opt, spb));
+    results.push_back(bench_stage(tx_prefix, tx.encoder(), scrambled, opt, spb));
+    results.push_back(bench_stage(tx_prefix, tx.interleaver(), coded, opt, spb));
+    results.push_back(bench_stage(tx_prefix, tx.mapper(), interleaved, opt, spb));
+    results.push_back(bench_stage(tx_prefix, tx.modulator(), symbols, opt, spb));
+    results.push_back(bench_stage(rx_prefix, rx.demodulator(), samples, opt, spb, &rx.arena()));
+    results.push_back(bench_stage(rx_prefix, rx.demapper(), rx_symbols, opt, spb, &rx.arena()));
+    results.push_back(bench_stage(rx_prefix, rx.deinterleaver(), llrs, opt, spb));
+    results.push_back(bench_stage(rx_prefix, rx.decoder(), deinterleaved, opt, spb));
+    results.push_back(bench_stage(rx_prefix, rx.descrambler(), decoded, opt, spb));
+
+    const std::string chain_prefix = std::string(to_string(m)) + ".chain.";
+    BufferPool<std::uint64_t> feed(2, data.size());
+    BufferPool<cf32> sample_feed(2, samples.size());
+    results.push_back(run_case(chain_prefix + "tx", opt, spb,
+                               [&](std::uint64_t& ns, std::uint64_t& cycles) {
+        BufferView<std::uint64_t> in = feed.acquire();
+        std::copy(data.begin(), data.end(), in.begin());
+        const std::uint64_t t0 = now_ns();
+        const std::uint64_t c0 = read_cycles();
+        BufferView<cf32> out = tx.process(std::move(in));
+        cycles = read_cycles() - c0;
+        ns = now_ns() - t0;
+        return bool(out);
+    }));
+    results.push_back(run_case(chain_prefix + "rx", opt, spb,
+                               [&](std::uint64_t& ns, std::uint64_t& cycles) {
+        BufferView<cf32> in = sample_feed.acquire();
+        std::copy(samples.begin(), samples.end(), in.begin());
+        const std::uint64_t t0 = now_ns();
+        const std::uint64_t c0 = read_cycles();
+        BufferView<std::uint64_t> out = rx.process(std::move(in));
+        cycles = read_cycles() - c0;
+        ns = now_ns() - t0;
+        return bool(out);
+    }));
+    results.push_back(run_case(chain_prefix + "end_to_end", opt, spb,
+                               [&](std::uint64_t& ns, std::uint64_t& cycles) {
+        BufferView<std::uint64_t> in = feed.acquire();
+        std::copy(data.begin(), data.end(), in.begin());
+        const std::uint64_t t0 = now_ns();
+        const std::uint64_t c0 = read_cycles();
+        BufferView<std::uint64_t> out = rx.process(tx.process(std::move(in)));
+        cycles = read_cycles() - c0;
+        ns = now_ns() - t0;
+        return bool(out);
+    }));
+}
+
+/// The sample-type dependent stages of `m` in sample type T, with the
+/// pilot equaliser on.
+template <SampleType T>
+void bench_sample_stages(Modulation m, const Options& opt, std::vector<CaseResult>& results) {
+    PhyConfig config;
+    config.modulation = m;
+    config.symbols_per_block = opt.symbols_per_block;
+    config.equalizer = Equalizer::pilot_zf;
+    const std::size_t spb = config.samples_per_block();
+
+    BasicTxChain<T> tx(config);
+    BasicRxChain<T> rx(config);
+
+    std::mt19937 rng(1234);
+    BufferView<std::uint64_t> data = tx.acquire_input();
+    fill_random_bits(BitSpan(data.span(), config.info_bits_per_block()), rng);
+    const auto coded =
+        tx.interleaver().process(tx.encoder().process(tx.scrambler().process(data)));
+    const auto symbols = tx.mapper().process(coded);
+    const auto samples = tx.modulator().process(symbols);
+    const auto rx_symbols = rx.demodulator().process(samples);
+
+    const std::string prefix = std::string(to_string(m)) + "." + SampleTraits<T>::name;
+    results.push_back(bench_stage(prefix + ".tx.", tx.mapper(), coded, opt, spb));
+    results.push_back(bench_stage(prefix + ".tx.", tx.modulator(), symbols, opt, spb));
+    results.push_back(
+        bench_stage(prefix + ".rx.", rx.demodulator(), samples, opt, spb, &rx.arena()));
+    results.push_back(
+        bench_stage(prefix + ".rx.", rx.demapper(), rx_symbols, opt, spb, &rx.arena()));
+}
+
+/// BPSK-over-AWGN LLRs of `count` random codewords of `code`.
+std::vector<float> ldpc_llrs(const LdpcCode& code, std::size_t count, double ebn0_db,
+                             std::mt19937& rng) {
+    const double rate = double(code.k()) / double(code.n());
+    const double sigma = std::sqrt(1.0 / (2.0 * rate * std::pow(10.0, ebn0_db / 10.0)));
+    std::normal_distribution<double> noise(0.0, sigma);
+    std::vector<std::uint8_t> info(code.k());
+    std::vector<std::uint8_t> codeword(code.n());
+    std::vector<float> llrs;
+    llrs.reserve(count * code.n());
+    for (std::size_t b = 0; b < count; ++b) {
+        for (auto& bit : info) {
+            bit = std::uint8_t(rng() & 1u);
+        }
+        code.encode(info, codeword);
+        for (std::uint8_t bit : codeword) {
+            const double y = (bit ? -1.0 : 1.0) + noise(rng);
+            llrs.push_back(float(2.0 * y / (sigma * sigma)));
+        }
+    }
+    return llrs;
+}
+
+/// BPSK-over-AWGN LLRs of `count` random convolutional codewords of
+/// `info_bits` bits punctured to `rate`.
+std::vector<float> conv_llrs(std::size_t info_bits, CodeRate rate, std::size_t count,
+                             double ebn0_db, std::mt19937& rng) {
+    const double r = double(code_rate_numerator(rate)) / double(code_rate_denominator(rate));
+    const double sigma = std::sqrt(1.0 / (2.0 * r * std::pow(10.0, ebn0_db / 10.0)));
+    std::normal_distribution<double> noise(0.0, sigma);
+    std::vector<std::uint8_t> info(info_bits);
+    std::vector<std::uint8_t> codeword(conv_coded_bits(info_bits));
+    const std::size_t n = punctured_bits(rate, codeword.size());
+    std::vector<float> llrs;
+    llrs.reserve(count * n);
+    for (std::size_t b = 0; b < count; ++b) {
+        for (auto& bit : info) {
+            bit = std::uint8_t(rng() & 1u);
+        }
+        conv_encode(info, codeword);
+        puncture(rate, codeword, codeword);
+        for (std::size_t i = 0; i < n; ++i) {
+            const double y = (codeword[i] ? -1.0 : 1.0) + noise(rng);
+            llrs.push_back(float(2.0 * y / (sigma * sigma)));
+        }
+    }
+    return llrs;
+}
+
+/// BPSK-over-AWGN LLRs of `count` random turbo codeblocks with CRC24B.
+std::vector<float> turbo_llrs(const QppInterleaver& pi, std::size_t count, double ebn0_db,
+                              std::mt19937& rng) {
+    const std::size_t k = pi.size();
+    const double rate = double(k) / double(turbo_coded_bits(k));
+    const double sigma = std::sqrt(1.0 / (2.0 * rate * std::pow(10.0, ebn0_db / 10.0)));
+    std::normal_distribution<double> noise(0.0, sigma);
+    std::vector<std::uint8_t> info(k);
+    std::vector<std::uint8_t> codeword(turbo_coded_bits(k));
+    std::vector<float> llrs;
+    llrs.reserve(count * codeword.size());
+    for (std::size_t b = 0; b < count; ++b) {
+        for (auto& bit : info) {
+            bit = std::uint8_t(rng() & 1u);
+        }
+        crc24_attach(kCrc24bPoly, info);
+        turbo_encode(pi, info, codeword);
+        for (std::uint8_t bit : codeword) {
+            const double y = (bit ? -1.0 : 1.0) + noise(rng);
+            llrs.push_back(float(2.0 * y / (sigma * sigma)));
+        }
+    }
+    return llrs;
+}
+
+/// FEC kernels on their own; these rows count decoded information bits.
+void bench_kernels(const Options& opt, std::vector<CaseResult>& results) {
+    std::mt19937 rng(99);
+    constexpr std::size_t kCodewords = 64;
+
+    const LdpcCode ldpc(LdpcBaseGraph::ieee80211_648_r12(), 27);
+    const std::vector<float> llrs = ldpc_llrs(ldpc, kCodewords, 2.5, rng);
+    std::vector<std::uint8_t> info(kCodewords * ldpc.k());
+    LdpcDecoder decoder(ldpc);
+    std::size_t next = 0;
+    results.push_back(run_case("kernel.ldpc_648_r12.decode", opt, ldpc.k(),
+                               [&](std::uint64_t& ns, std::uint64_t& cycles) {
+        const std::size_t b = next++ % kCodewords;
+        const std::uint64_t t0 = now_ns();
+        const std::uint64_t c0 = read_cycles();
+        decoder.decode(std::span(llrs).subspan(b * ldpc.n(), ldpc.n()),
+                       std::span(info).subspan(b * ldpc.k(), ldpc.k()));
+        cycles = read_cycles() - c0;
+        ns = now_ns() - t0;
+        return true;
+    }));
+
+    WorkStealingPool pool;
+    LdpcBatchDecoder batch(ldpc, pool);
+    std::vector<LdpcResult> status(kCodewords);
+    results.push_back(run_case("kernel.ldpc_648_r12.batch64", opt, kCodewords * ldpc.k(),
+                               [&](std::uint64_t& ns, std::uint64_t& cycles) {
+        const std::uint64_t t0 = now_ns();
+        const std::uint64_t c0 = read_cycles();
+        batch.decode(llrs, info, status);
+        cycles = read_cycles() - c0;
+        ns = now_ns() - t0;
+        return true;
+    }));
+
+    // One 256-QAM rate-1/2 block worth of bits, long enough for the sliding
+    // traceback to run.
+    constexpr std::size_t kConvInfo = 1530;
+    ViterbiDecoder viterbi;
+    std::vector<std::uint8_t> bits(kConvInfo);
+    for (CodeRate rate : {CodeRate::r1_2, CodeRate::r3_4}) {
+        const std::vector<float> soft = conv_llrs(kConvInfo, rate, kCodewords, 4.0, rng);
+        const std::size_t n = soft.size() / kCodewords;
+        next = 0;
+        results.push_back(run_case(std::string("kernel.viterbi_") + to_string(rate) + ".decode",
+                                   opt, kConvInfo,
+                                   [&](std::uint64_t& ns, std::uint64_t& cycles) {
+            const std::size_t b = next++ % kCodewords;
+            const std::uint64_t t0 = now_ns();
+            const std::uint64_t c0 = read_cycles();
+            viterbi.decode(std::span(soft).subspan(b * n, n), bits, rate);
+            cycles = read_cycles() - c0;
+            ns = now_ns() - t0;
+            return true;
+        }));
+    }
+
+    // Largest LTE codeblock a little above its waterfall, stopping on CRC24B.
+    constexpr std::size_t kTurboBlocks = 16;
+    const QppInterleaver qpp(6144);
+    const std::size_t tn = turbo_coded_bits(qpp.size());
+    const std::vector<float> turbo_soft = turbo_llrs(qpp, kTurboBlocks, 1.0, rng);
+    std::vector<std::uint8_t> turbo_info(kTurboBlocks * qpp.size());
+    TurboDecoder turbo(qpp.size());
+    next = 0;
+    results.push_back(run_case("kernel.turbo_6144.decode", opt, qpp.size(),
+                               [&](std::uint64_t& ns, std::uint64_t& cycles) {
+        const std::size_t b = next++ % kTurboBlocks;
+        const std::uint64_t t0 = now_ns();
+        const std::uint64_t c0 = read_cycles();
+        turbo.decode(std::span(turbo_soft).subspan(b * tn, tn),
+                     std::span(turbo_info).subspan(b * qpp.size(), qpp.size()));
+        cycles = read_cycles() - c0;
+        ns = now_ns() - t0;
+        return true;
+    }));
+
+    TurboBatchDecoder turbo_batch(qpp.size(), pool);
+    std::vector<TurboResult> turbo_status(kTurboBlocks);
+    results.push_back(run_case("kernel.turbo_6144.batch16", opt, kTurboBlocks * qpp.size(),
+                               [&](std::uint64_t& ns, std::uint64_t& cycles) {
+        const std::uint64_t t0 = now_ns();
+        const std::uint64_t c0 = read_cycles();
+        turbo_batch.decode(turbo_soft, turbo_info, turbo_status);
+        cycles = read_cycles() - c0;
+        ns = now_ns() - t0;
+        return true;
+    }));
+
+    // CRC rows count bytes: an 802.11 MPDU and a 6144-bit LTE transport
+    // block, on the active kernels and on the slicing-by-8 tables.
+    std::vector<std::uint8_t> crc_bytes(1500);
+    for (auto& b : crc_bytes) {
+        b = std::uint8_t(rng());
+    }
+    volatile std::uint32_t crc_sink = 0;
+    auto crc_case = [&]<CrcSpec S>(const char* name, std::size_t bytes, Isa isa) {
+        Crc<S> crc(isa);
+        results.push_back(run_case(name, opt, bytes,
+                                   [&, crc](std::uint64_t& ns, std::uint64_t& cycles) mutable {
+            const std::uint64_t t0 = now_ns();
+            const std::uint64_t c0 = read_cycles();
+            crc.reset();
+            crc_sink = crc.update({crc_bytes.data(), bytes}).value();
+            cycles = read_cycles() - c0;
+            ns = now_ns() - t0;
+            return true;
+        }));
+    };
+    crc_case.template operator()<kCrc32>("kernel.crc32.1500B", 1500, active_isa());
+    crc_case.template operator()<kCrc32>("kernel.crc32.1500B.table", 1500, Isa::scalar);
+    crc_case.template operator()<kCrc24a>("kernel.crc24a.768B", 768, active_isa());
+    crc_case.template operator()<kCrc24a>("kernel.crc24a.768B.table", 768, Isa::scalar);
+
+    // Scrambler rows count bits of one 1500-byte MPDU.
+    constexpr std::size_t kScramblerBits = 8 * 1500;
+    std::vector<std::uint8_t> scrambler_bits(kScramblerBits);
+    for (auto& bit : scrambler_bits) {
+        bit = std::uint8_t(rng() & 1u);
+    }
+    std::vector<float> scrambler_llrs(kScramblerBits, 1.0f);
+    Scrambler scrambler(0x5d);
+    GoldSequence gold(0x1234567);
+    auto scrambler_case = [&](const char* name, auto body) {
+        results.push_back(run_case(name, opt, kScramblerBits,
+                                   [&](std::uint64_t& ns, std::uint64_t& cycles) {
+            const std::uint64_t t0 = now_ns();
+            const std::uint64_t c0 = read_cycles();
+            body();
+            cycles = read_cycles() - c0;
+            ns = now_ns() - t0;
+            return true;
+        }));
+    };
+    scrambler_case("kernel.scrambler.unpacked", [&] {
+        scrambler.apply(scrambler_bits, scrambler_bits);
+    });
+    PackedBits scrambler_words(kScramblerBits);
+    pack_bits(scrambler_bits, scrambler_words.view());
+    scrambler_case("kernel.scrambler.packed", [&] {
+        scrambler.apply(scrambler_words.view(), scrambler_words.view());
+    });
+    scrambler_case("kernel.gold.unpacked", [&] { gold.apply(scrambler_bits, scrambler_bits); });
+    scrambler_case("kernel.gold.packed", [&] {
+        gold.apply(scrambler_words.view(), scrambler_words.view());
+    });
+    scrambler_case("kernel.gold.llr", [&] { gold.apply(scrambler_llrs, scrambler_llrs); });
+
+    // Packed-bit conversions over the same 12000 bits; the .scalar row
+    // emulates pdep.
+    std::vector<std::uint8_t> axis_codes(kScramblerBits / 3);
+    PackedBits punctured(punctured_bits(CodeRate::r3_4, kScramblerBits));
+    scrambler_case("kernel.bits.pack", [&] {
+        pack_bits(scrambler_bits, scrambler_words.view());
+    });
+    scrambler_case("kernel.bits.unpack", [&] {
+        unpack_bits(scrambler_words.view(), scrambler_bits);
+    });
+    scrambler_case("kernel.bits.hard_decisions", [&] {
+        pack_hard_decisions(scrambler_llrs, scrambler_words.view());
+    });
+    scrambler_case("kernel.bits.unpack_llrs", [&] {
+        unpack_llrs(scrambler_words.view(), 1.0f, scrambler_llrs);
+    });
+    scrambler_case("kernel.bits.indices3", [&] {
+        unpack_indices(scrambler_words.view(), 3, axis_codes);
+    });
+    scrambler_case("kernel.bits.indices3.scalar", [&] {
+        unpack_indices(Isa::scalar, scrambler_words.view(), 3, axis_codes);
+    });
+    scrambler_case("kernel.bits.puncture34", [&] {
+        puncture(CodeRate::r3_4, scrambler_words.view(), punctured.view());
+    });
+
+    constexpr std::size_t kChannelSamples = 4096;
+    std::vector<cf32> channel_in(kChannelSamples, cf32(0.5f, -0.5f));
+    std::vector<cf32> channel_out(kChannelSamples);
+    GaussianNoise noise(1, 0);
+    results.push_back(run_case("kernel.channel.awgn", opt, kChannelSamples,
+                               [&](std::uint64_t& ns, std::uint64_t& cycles) {
+        const std::uint64_t t0 = now_ns();
+        const std::uint64_t c0 = read_cycles();
+        noise.add(channel_in, channel_out, 0.1f);
+        cycles = read_cycles() - c0;
+        ns = now_ns() - t0;
+        return true;
+    }));
+    for (FadingProfile profile : {FadingProfile::epa, FadingProfile::eva, FadingProfile::etu}) {
+        FadingConfig fc;
+        fc.profile = profile;
+        FadingChannel fading(fc, 1, 0);
+        results.push_back(run_case(std::string("kernel.channel.") + to_string(profile), opt,
+                                   kChannelSamples, [&](std::uint64_t& ns, std::uint64_t& cycles) {
+            const std::uint64_t t0 = now_ns();
+            const std::uint64_t c0 = read_cycles();
+            fading.process(channel_in, channel_out);
+            cycles = read_cycles() - c0;
+            ns = now_ns() - t0;
+            return true;
+        }));
+    }
+
+    // Rates per input sample: 20 <-> 80 Msps and 30.72 -> 25 Msps.
+    HalfbandCascade interpolate(HalfbandMode::interpolate, 2);
+    HalfbandCascade decimate(HalfbandMode::decimate, 2);
+    PolyphaseResampler rational(resample_ratio(30.72e6, 25e6));
+    std::vector<cf32> resampled(4 * kChannelSamples);
+    const auto resample_case = [&](const char* name, auto& resampler) {
+        results.push_back(run_case(name, opt, kChannelSamples,
+                                   [&](std::uint64_t& ns, std::uint64_t& cycles) {
+            const std::uint64_t t0 = now_ns();
+            const std::uint64_t c0 = read_cycles();
+            resampler.process(channel_in, resampled);
+            cycles = read_cycles() - c0;
+            ns = now_ns() - t0;
+            return true;
+        }));
+    };
+    resample_case("kernel.resample.halfband_x4", interpolate);
+    resample_case("kernel.resample.halfband_d4", decimate);
+    resample_case("kernel.resample.polyphase_625_768", rational);
+
+    // Packet search on an idle channel: the per-sample cost of listening.
+    SyncConfig sync_config;
+    sync_config.payload_samples = PhyConfig{}.samples_per_block();
+    PacketSync sync(sync_config);
+    std::vector<cf32> idle(kChannelSamples);
+    noise.fill(idle, 1.0f);
+    results.push_back(run_case("kernel.sync.idle", opt, kChannelSamples,
+                               [&](std::uint64_t& ns, std::uint64_t& cycles) {
+        const std::uint64_t t0 = now_ns();
+        const std::uint64_t c0 = read_cycles();
+        sync.process(idle, {});
+        cycles = read_cycles() - c0;
+        ns = now_ns() - t0;
+        return true;
+    }));
+
+    // Spatial multiplexing per subcarrier: weights once per channel
+    // estimate, then detection per OFDM symbol.
+    constexpr std::size_t kMimoSubcarriers = 1024;
+    std::mt19937 mimo_rng(7);
+    std::normal_distribution<float> mimo_gauss(0.0f, 1.0f);
+    for (const std::size_t streams : {std::size_t(2), std::size_t(4)}) {
+        SubcarrierMatrix h(streams, streams, kMimoSubcarriers);
+        SubcarrierMatrix y(streams, 1, kMimoSubcarriers), x;
+        for (std::size_t k = 0; k < kMimoSubcarriers; ++k) {
+            for (std::size_t i = 0; i < streams; ++i) {
+                y.set(i, 0, k, {mimo_gauss(mimo_rng), mimo_gauss(mimo_rng)});
+                for (std::size_t j = 0; j < streams; ++j) {
+                    h.set(i, j, k, {mimo_gauss(mimo_rng), mimo_gauss(mimo_rng)});
+                }
+            }
+        }
+        MimoEqualizer eq(streams, streams, MimoDetector::mmse);
+        eq.prepare(h, 0.1f);
+        const std::string name = "kernel.mimo.mmse_" + std::to_string(streams) + "x" +
+                                 std::to_string(streams);
+        results.push_back(run_case(name + ".prepare", opt, kMimoSubcarriers,
+                                   [&](std::uint64_t& ns, std::uint64_t& cycles) {
+            const std::uint64_t t0 = now_ns();
+            const std::uint64_t c0 = read_cycles();
+            eq.prepare(h, 0.1f);
+            cycles = read_cycles() - c0;
+            ns = now_ns() - t0;
+            return true;
+        }));
+        results.push_back(run_case(name + ".apply", opt, kMimoSubcarriers,
+                                   [&](std::uint64_t& ns, std::uint64_t& cycles) {
+            const std::uint64_t t0 = now_ns();
+            const std::uint64_t c0 = read_cycles();
+            eq.apply(y, x);
+            cycles = read_cycles() - c0;
+            ns = now_ns() - t0;
+            return true;
+        }));
+    }
+
+    // The same element-wise work in either complex layout, and the bulk
+    // conversion a stage pays to switch between them.
+    std::vector<cf32> layout_b(kChannelSamples);
+    noise.fill(layout_b, 1.0f);
+    const auto layout_cases = [&]<ComplexLayout L>() {
+        ComplexBuffer<L> a(kChannelSamples), b(kChannelSamples), out(kChannelSamples);
+        convert(idle, a.view());
+        convert(layout_b, b.view());
+        std::vector<float> power(kChannelSamples);
+        FadingChannel fading(FadingConfig{}, 1, 0);
+        const std::string suffix = std::string(".") + L::name;
+        const auto layout_case = [&](const char* name, auto&& op) {
+            results.push_back(run_case(std::string("kernel.") + name + suffix, opt, kChannelSamples,
+                                       [&](std::uint64_t& ns, std::uint64_t& cycles) {
+                const std::uint64_t t0 = now_ns();
+                const std::uint64_t c0 = read_cycles();
+                op();
+                cycles = read_cycles() - c0;
+                ns = now_ns() - t0;
+                return true;
+            }));
+        };
+        layout_case("cmul", [&] { multiply(a.view(), b.view(), out.view()); });
+        layout_case("cmul_conj", [&] { multiply_conj(a.view(), b.view(), out.view()); });
+        layout_case("abs2", [&] { magnitude_squared(a.view(), power); });
+        layout_case("fading_epa", [&] { fading.process(a.view(), out.view()); });
+    };
+    layout_cases.template operator()<Interleaved>();
+    layout_cases.template operator()<Split>();
+    ComplexBuffer<Split> split(kChannelSamples);
+    results.push_back(run_case("kernel.layout.to_split", opt, kChannelSamples,
+                               [&](std::uint64_t& ns, std::uint64_t& cycles) {
+        const std::uint64_t t0 = now_ns();
+        const std::uint64_t c0 = read_cycles();
+        convert(idle, split.view());
+        cycles = read_cycles() - c0;
+        ns = now_ns() - t0;
+        return true;
+    }));
+    results.push_back(run_case("kernel.layout.to_interleaved", opt, kChannelSamples,
+                               [&](std::uint64_t& ns, std::uint64_t& cycles) {
+        const std::uint64_t t0 = now_ns();
+        const std::uint64_t c0 = read_cycles();
+        convert(split.view(), channel_out);
+        cycles = read_cycles() - c0;
+        ns = now_ns() - t0;
+        return true;
+    }));
+}
+
+[[noreturn]] void usage(const char* argv0) {
+    std::fprintf(stderr,
+                 "usage: %s [--blocks N] [--symbols N] [--modulation NAME]... "
+                 "[--repeat N] [--output PATH] "
+                 "[--baseline PATH [--threshold PERCENT] [--min-delta US]]\n",
+                 argv0);
+    std::exit(2);
+}
+
+Options parse_options(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+        }
+        const char* value = argv[++i];
+        if (std::strcmp(arg, "--blocks") == 0) {
+            opt.blocks = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--symbols") == 0) {
+            opt.symbols_per_block = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--output") == 0) {
+            opt.output = value;
+        } else if (std::strcmp(arg, "--repeat") == 0) {
+            opt.repeat = std::strtoul(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--baseline") == 0) {
+            opt.baseline = value;
+        } else if (std::strcmp(arg, "--threshold") == 0) {
+            opt.threshold = std::strtod(value, nullptr) / 100.0;
+        } else if (std::strcmp(arg, "--min-delta") == 0) {
+            opt.min_delta_us = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--modulation") == 0) {
+            bool found = false;
+            for (Modulation m : kAllModulations) {
+                if (std::strcmp(value, to_string(m)) == 0) {
+                    opt.modulations.push_back(m);
+                    found = true;
+                }
+            }
+            if (!found) {
+                usage(argv[0]);
+            }
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (opt.blocks == 0 || opt.symbols_per_block == 0 || opt.repeat == 0 ||
+        !(opt.threshold > 0.0) || !(opt.min_delta_us >= 0.0)) {
+        usage(argv[0]);
+    }
+    if (opt.modulations.empty()) {
+        opt.modulations.assign(std::begin(kAllModulations), std::end(kAllModulations));
+    }
+    return opt;
+}
+
+/// Print the cases slower than the baseline; returns the exit status.
+int compare_with_baseline(const Options& opt, const std::vector<std::string>& comments,
+                          const std::vector<CaseResult>& results) {
+    std::vector<std::string> baseline_comments;
+    std::vector<CaseResult> baseline;
+    std::FILE* f = std::fopen(opt.baseline, "r");
+    if (f == nullptr) {
+        std::perror(opt.baseline);
+        std::fprintf(stderr, "record one on this machine first, e.g. with the bench_baseline "
+                             "target\n");
+        return 1;
+    }
+    const bool ok = read_report(f, baseline_comments, baseline);
+    std::fclose(f);
+    if (!ok) {
+        std::fprintf(stderr, "%s: not a bench report\n", opt.baseline);
+        return 1;
+    }
+    // Comment 1 names the ISA, 2 the block geometry; either changes the cases.
+    for (std::size_t i : {1, 2}) {
+        if (i < baseline_comments.size() && baseline_comments[i] != comments[i]) {
+            std::printf("# note: baseline has '%s', this run '%s'\n",
+                        baseline_comments[i].c_str(), comments[i].c_str());
+        }
+    }
+
+    const std::vector<Regression> regressions =
+        find_regressions(baseline, results, opt.threshold, opt.min_delta_us);
+    std::printf("# %zu of %zu cases more than %.0f%% and %.1f us slower than %s\n",
+                regressions.size(), results.size(), opt.threshold * 100.0, opt.min_delta_us,
+                opt.baseline);
+    for (const Regression& r : regressions) {
+        std::printf("%-32s p50 %10.3f -> %10.3f us (throughput %+.1f%%)\n", r.name.c_str(),
+                    r.baseline_p50_us, r.p50_us, (r.baseline_p50_us / r.p50_us - 1.0) * 100.0);
+    }
+    return regressions.empty() ? 0 : 3;
+}
+
+}  // namespace
+}  // namespace dcomm::bench
+
+int main(int argc, char** argv) {
+    using namespace dcomm;
+    using namespace dcomm::bench;
+
+    const Options opt = parse_options(argc, argv);
+    std::vector<CaseResult> results;
+    for (std::size_t run = 0; run < opt.repeat; ++run) {
+        std::vector<CaseResult> r;
+        for (Modulation m : opt.modulations) {
+            bench_modulation(m, opt, r);
+        }
+        bench_sample_stages<cf32>(Modulation::qam16, opt, r);
+        bench_sample_stages<ci16>(Modulation::qam16, opt, r);
+        bench_sample_stages<ci8>(Modulation::qam16, opt, r);
+        bench_kernels(opt, r);
+        // Keep each case's least disturbed run.
+        for (std::size_t i = 0; i < r.size(); ++i) {
+            if (run == 0 || r[i].p50_us < results[i].p50_us) {
+                (run == 0 ? results.emplace_back() : results[i]) = std::move(r[i]);
+            }
+        }
+    }
+
+    PhyConfig config;
+    config.symbols_per_block = opt.symbols_per_block;
+    const std::vector<std::string> comments = {
+        "dcomm bench v1",
+        std::string("isa=") + to_string(active_isa()),
+        "samples_per_block=" + std::to_string(config.samples_per_block()) +
+            " blocks=" + std::to_string(opt.blocks) +
+            " warmup=" + std::to_string(opt.warmup) +
+            (opt.repeat > 1 ? " best_of=" + std::to_string(opt.repeat) : std::string()),
+        "msps and cycles/sample count baseband samples at the DAC/ADC side",
+        "kernel.* rows count decoded information bits instead (msps = Mbit/s)",
+        "<mod>.<cf32|ci16|ci8>.* rows run in that sample type with eq=zf",
+        "threads=" + std::to_string(std::thread::hardware_concurrency()),
+    };
+    write_report(stdout, comments, results);
+    std::FILE* f = std::fopen(opt.output, "w");
+    if (f == nullptr) {
+        std::perror(opt.output);
+        return 1;
+    }
+    write_report(f, comments, results);
+    std::fclose(f);
+    return opt.baseline == nullptr ? 0 : compare_with_baseline(opt, comments, results);
+}
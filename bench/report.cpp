@@ -0,0 +1,69 @@
+#include "report.hpp"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace dcomm::bench {
+
+void write_report(std::FILE* out, const std::vector<std::string>& comments,
+                  const std::vector<CaseResult>& results) {
+    for (const std::string& c : comments) {
+        std::fprintf(out, "# %s\n", c.c_str());
+    }
+    std::fprintf(out, "%-32s %12s %14s %10s %10s\n", "case", "msps",
+                 "cycles/sample", "p50_us", "p99_us");
+    for (const CaseResult& r : results) {
+        std::fprintf(out, "%-32s %12.3f %14.3f %10.3f %10.3f\n", r.name.c_str(),
+                     r.msps, r.cycles_per_sample, r.p50_us, r.p99_us);
+    }
+}
+
+bool read_report(std::FILE* in, std::vector<std::string>& comments,
+                 std::vector<CaseResult>& results) {
+    char line[512];
+    bool header = false;
+    while (std::fgets(line, sizeof line, in) != nullptr) {
+        line[std::strcspn(line, "\n")] = '\0';
+        if (!header && std::strncmp(line, "# ", 2) == 0) {
+            comments.emplace_back(line + 2);
+            continue;
+        }
+        if (!header) {
+            if (std::strncmp(line, "case ", 5) != 0) {
+                return false;
+            }
+            header = true;
+            continue;
+        }
+        char name[256];
+        CaseResult r;
+        if (std::sscanf(line, "%255s %lf %lf %lf %lf", name, &r.msps, &r.cycles_per_sample,
+                        &r.p50_us, &r.p99_us) != 5) {
+            return false;
+        }
+        r.name = name;
+        results.push_back(std::move(r));
+    }
+    return header;
+}
+
+std::vector<Regression> find_regressions(const std::vector<CaseResult>& baseline,
+                                         const std::vector<CaseResult>& results,
+                                         double threshold, double min_delta_us) {
+    std::unordered_map<std::string, double> before;
+    for (const CaseResult& r : baseline) {
+        before.emplace(r.name, r.p50_us);
+    }
+    std::vector<Regression> regressions;
+    for (const CaseResult& r : results) {
+        const auto it = before.find(r.name);
+        // samples / p50 < (1 - threshold) * samples / baseline p50
+        if (it != before.end() && (1.0 - threshold) * r.p50_us > it->second &&
+            r.p50_us - it->second >= min_delta_us) {
+            regressions.push_back({r.name, it->second, r.p50_us});
+        }
+    }
+    return regressions;
+}
+
+}  // namespace dcomm::bench
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace dcomm::bench {
+
+/// Timing summary of one benchmark case.
+///
+/// Throughput is expressed in baseband samples (the DAC/ADC-side sample
+/// count of the blocks processed) for every stage, so stages working on
+/// bits, symbols or samples can be compared on the same scale.
+struct CaseResult {
+    std::string name;
+    double msps = 0.0;
+    double cycles_per_sample = 0.0;
+    double p50_us = 0.0;
+    double p99_us = 0.0;
+};
+
+/// Write the report: '#' comment lines, a column header, then one
+/// fixed-width row per case in the order given.
+void write_report(std::FILE* out, const std::vector<std::string>& comments,
+                  const std::vector<CaseResult>& results);
+
+/// Read a report written by write_report() back: comments without their
+/// "# " and the case rows. Returns false if `in` is not such a report.
+bool read_report(std::FILE* in, std::vector<std::string>& comments,
+                 std::vector<CaseResult>& results);
+
+/// A case whose throughput fell against the baseline.
+struct Regression {
+    std::string name;
+    double baseline_p50_us = 0.0;
+    double p50_us = 0.0;
+};
+
+/// Cases of `results` whose median block throughput fell below
+/// (1 - threshold) times that of the case of the same name in `baseline`,
+/// in the order of `results`. The median (p50_us) is compared rather than
+/// msps, the mean, because preemption on a shared machine moves the mean
+/// of a run by tens of percent and the median hardly at all. A case must
+/// also be at least `min_delta_us` slower: the median of a sub-microsecond
+/// block jumps between a few discrete values with cache placement, which
+/// is tens of percent of it but nothing of the chain. Cases missing on
+/// either side are skipped.
+std::vector<Regression> find_regressions(const std::vector<CaseResult>& baseline,
+                                         const std::vector<CaseResult>& results,
+                                         double threshold, double min_delta_us = 0.0);
+
+}  // namespace dcomm::bench
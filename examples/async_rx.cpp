@@ -0,0 +1,160 @@
+// Bursty frame reception on coroutines: bursts of 802.11a-style frames of
+// mixed rate and length, plus noise bursts that pass for detections, go to
+// an AsyncReceiver. The same bursts are then decoded one frame after the
+// other in arrival order, and the latency from the burst's arrival to each
+// frame's delivery is compared.
+//
+//   async_rx [bursts] [frames per burst] [workers]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <random>
+#include <vector>
+
+#include "dcomm/async_rx.hpp"
+#include "dcomm/channel.hpp"
+#include "dcomm/clock.hpp"
+
+namespace {
+
+using namespace dcomm;
+
+struct Sent {
+    SignalField signal;  // length 0: a noise burst
+    std::vector<std::uint64_t> words;
+    std::vector<cf32> samples;
+};
+
+struct Latencies {
+    std::vector<double> short_us, long_us;
+
+    void add(const Sent& f, double us, std::size_t short_symbols) {
+        (payload_symbols(f.signal) <= short_symbols ? short_us : long_us).push_back(us);
+    }
+};
+
+double percentile(std::vector<double> v, double p) {
+    if (v.empty()) {
+        return 0.0;
+    }
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, std::size_t(p * double(v.size())))];
+}
+
+void report(const char* name, const Latencies& l) {
+    std::printf("  %-8s short p50 %8.1f p99 %8.1f us   long p50 %8.1f p99 %8.1f us\n", name,
+                percentile(l.short_us, 0.5), percentile(l.short_us, 0.99),
+                percentile(l.long_us, 0.5), percentile(l.long_us, 0.99));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) try {
+    const int bursts = argc > 1 ? std::atoi(argv[1]) : 40;
+    const int per_burst = argc > 2 ? std::atoi(argv[2]) : 16;
+    const std::size_t workers = argc > 3 ? std::size_t(std::atol(argv[3])) : 2;
+    constexpr std::size_t kShortSymbols = 16;
+
+    PhyConfig base;
+    base.interleave = true;
+    base.noise_variance = 0.005f;
+    FrameCodec tx(base);
+    GaussianNoise noise(1, 0);
+    std::mt19937 rng(7);
+
+    // Mostly short frames at high rates, some long ones at low rates.
+    std::vector<std::vector<Sent>> traffic(bursts);
+    for (auto& burst : traffic) {
+        for (int i = 0; i < per_burst; ++i) {
+            Sent f;
+            const unsigned kind = rng() % 8;
+            if (kind == 0) {
+                f.samples.resize(kSignalSamples * 4);
+                noise.add(f.samples, 1.0f);
+            } else {
+                f.signal = kind == 1 ? SignalField{Modulation::bpsk, CodeRate::r1_2,
+                                                   std::uint16_t(1000 + rng() % 3000)}
+                                     : SignalField{Modulation::qam64, CodeRate::r3_4,
+                                                   std::uint16_t(20 + rng() % 200)};
+                const std::size_t n_bits = 8 * std::size_t(f.signal.length);
+                f.words.resize(packed_words(n_bits));
+                for (std::uint64_t& w : f.words) {
+                    w = std::uint64_t(rng()) << 32 | rng();
+                }
+                f.words.back() &= tail_mask(n_bits);
+                f.samples.resize(frame_samples(f.signal));
+                tx.encode(f.signal, ConstBitSpan(f.words.data(), n_bits), f.samples);
+                noise.add(f.samples, base.noise_variance);
+            }
+            burst.push_back(std::move(f));
+        }
+    }
+
+    std::size_t errors = 0, wrong = 0;
+    auto check = [&](const Sent& f, const SignalField& signal, ConstBitSpan payload) {
+        if (f.signal.length == 0 || !(signal == f.signal)) {
+            ++wrong;
+            return;
+        }
+        errors += count_bit_errors(ConstBitSpan(f.words.data(), payload.size()), payload);
+    };
+
+    // Coroutines on the executor.
+    Latencies async_latency;
+    {
+        Executor executor(workers);
+        const std::vector<Sent>* burst = nullptr;
+        std::uint64_t first_id = 0;
+        std::uint64_t arrival = 0;
+        AsyncReceiver rx(
+            executor, base,
+            [&](std::uint64_t id, const SignalField& signal, ConstBitSpan payload) {
+                const Sent& f = (*burst)[id - first_id];
+                async_latency.add(f, double(now_ns() - arrival) * 1e-3, kShortSymbols);
+                check(f, signal, payload);
+            },
+            std::size_t(per_burst), kShortSymbols);
+        for (const auto& frames : traffic) {
+            burst = &frames;
+            first_id = rx.submitted();
+            arrival = now_ns();
+            for (const Sent& f : frames) {
+                rx.submit(f.samples);
+            }
+            rx.drain();
+        }
+        std::printf("async, %zu workers: %llu frames, %llu delivered, %llu dropped at SIGNAL, "
+                    "%zu wrong headers, %zu bit errors\n",
+                    workers, static_cast<unsigned long long>(rx.submitted()),
+                    static_cast<unsigned long long>(rx.delivered()),
+                    static_cast<unsigned long long>(rx.dropped()), wrong, errors);
+    }
+
+    // The same bursts decoded in arrival order on this thread.
+    Latencies serial_latency;
+    FrameCodec codec(base);
+    std::vector<std::uint64_t> words(packed_words(8 * kMaxFrameBytes));
+    for (const auto& frames : traffic) {
+        const std::uint64_t arrival = now_ns();
+        for (const Sent& f : frames) {
+            const std::optional<SignalField> signal = codec.decode_signal(f.samples);
+            if (!signal || f.samples.size() < frame_samples(*signal)) {
+                continue;
+            }
+            const ConstBitSpan payload(words.data(), 8 * std::size_t(signal->length));
+            codec.decode_payload(*signal, std::span<const cf32>(f.samples).subspan(kSignalSamples),
+                                 BitSpan(words.data(), payload.size()));
+            serial_latency.add(f, double(now_ns() - arrival) * 1e-3, kShortSymbols);
+        }
+    }
+
+    std::printf("latency from burst arrival to delivery:\n");
+    report("async", async_latency);
+    report("serial", serial_latency);
+    return errors == 0 && wrong == 0 ? 0 : 1;
+} catch (const std::exception& e) {
+    std::fprintf(stderr, "async_rx: %s\n", e.what());
+    return 1;
+}
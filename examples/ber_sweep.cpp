@@ -0,0 +1,76 @@
+// BER/BLER versus Es/N0 over AWGN or a fading channel, as CSV on stdout.
+//
+//   ber_sweep [qpsk|qam16|qam64|qam256|bpsk] [r12|r23|r34] [from dB] [to dB]
+//             [step dB] [target block errors] [threads, 0 = all]
+//             [awgn|flat|epa|eva|etu] [Doppler Hz]
+//
+// Fading runs switch the receiver to the pilot ZF equalizer and turn the
+// 802.11 interleaver on.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+
+#include "dcomm/montecarlo.hpp"
+
+int main(int argc, char** argv) try {
+    using namespace dcomm;
+
+    SweepConfig config;
+    if (argc > 1) {
+        for (Modulation m : {Modulation::bpsk, Modulation::qpsk, Modulation::qam16,
+                             Modulation::qam64, Modulation::qam256}) {
+            if (std::strcmp(argv[1], to_string(m)) == 0) {
+                config.phy.modulation = m;
+            }
+        }
+    }
+    if (argc > 2) {
+        for (CodeRate r : {CodeRate::r1_2, CodeRate::r2_3, CodeRate::r3_4}) {
+            if (std::strcmp(argv[2], to_string(r)) == 0) {
+                config.phy.code_rate = r;
+            }
+        }
+    }
+    const double from = argc > 3 ? std::atof(argv[3]) : 0.0;
+    const double to = argc > 4 ? std::atof(argv[4]) : 12.0;
+    const double step = argc > 5 && std::atof(argv[5]) > 0.0 ? std::atof(argv[5]) : 1.0;
+    if (argc > 6) {
+        config.target_block_errors = std::strtoull(argv[6], nullptr, 10);
+    }
+    if (argc > 7) {
+        config.workers = std::strtoul(argv[7], nullptr, 10);
+    }
+    if (argc > 8) {
+        for (FadingProfile p : {FadingProfile::flat, FadingProfile::epa, FadingProfile::eva,
+                                FadingProfile::etu}) {
+            if (std::strcmp(argv[8], to_string(p)) == 0) {
+                config.fading = FadingConfig{};
+                config.fading->profile = p;
+            }
+        }
+        if (config.fading) {
+            config.phy.equalizer = Equalizer::pilot_zf;
+            config.phy.interleave = true;
+            if (argc > 9) {
+                config.fading->doppler_hz = std::atof(argv[9]);
+            }
+        }
+    }
+    for (double snr = from; snr <= to + 1e-9; snr += step) {
+        config.snr_db.push_back(snr);
+    }
+
+    std::fprintf(stderr, "%s %s, %s, %zu points, target %llu block errors\n",
+                 to_string(config.phy.modulation), to_string(config.phy.code_rate),
+                 config.fading ? to_string(config.fading->profile) : "awgn", config.snr_db.size(),
+                 static_cast<unsigned long long>(config.target_block_errors));
+    MonteCarloSweep sweep(config);
+    write_csv_header(stdout);
+    sweep.run([](const SweepPoint& p) { write_csv_row(stdout, p); });
+    return 0;
+} catch (const std::exception& e) {
+    std::fprintf(stderr, "ber_sweep: %s\n", e.what());
+    return 1;
+}
@@ -0,0 +1,188 @@
+// Run TxChain into a DacStream and RxChain from an AdcStream over one of the
+// converter backends, and report whether the chains kept up with the
+// converter clock: late blocks and the processing budget left per block.
+//
+//   converter_stream [shm|udp|file] [blocks] [sample rate in Msps] [buffers]
+//
+//   shm:  DacStream -> shared-memory ring -> AdcStream, within this process
+//   udp:  DacStream -> 127.0.0.1:50505 -> AdcStream
+//   file: DacStream -> converter_stream.sigmf-data, then replayed through
+//         an AdcStream at the same rate
+//
+// The Tx thread and the Rx loop run at the same time in the first two
+// modes. With 2 buffers each side has one block period to produce or
+// consume a block, with 3 buffers two.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <random>
+#include <thread>
+
+#include "dcomm/converter_stream.hpp"
+#include "dcomm/pipeline.hpp"
+
+namespace {
+
+using namespace dcomm;
+
+void fill_payload(std::size_t block, BitSpan payload) {
+    std::mt19937 rng(unsigned(block) + 1);
+    for (std::size_t i = 0; i < payload.size(); ++i) {
+        payload.set(i, rng() & 1u);
+    }
+}
+
+void print_deadlines(const char* name, const DeadlineStats& s) {
+    std::printf("  %-3s %6llu blocks, %4llu late, period %7.1f us, budget left min %7.1f / "
+                "mean %7.1f us\n",
+                name, static_cast<unsigned long long>(s.blocks),
+                static_cast<unsigned long long>(s.late), double(s.period.count()) / 1e3,
+                double(s.min_budget.count()) / 1e3, double(s.mean_budget.count()) / 1e3);
+}
+
+/// Start `dac` and encode `blocks` blocks into it, one per acquire/commit.
+void transmit(const PhyConfig& config, std::size_t blocks, DacStream& dac) {
+    TxChain tx(config);  // built before the clock starts
+    dac.start();
+    const std::size_t block_bits = config.info_bits_per_block();
+    for (std::size_t b = 0; b < blocks; ++b) {
+        BufferView<std::uint64_t> data = tx.acquire_input();
+        fill_payload(b, BitSpan(data.span(), block_bits));
+        BufferView<cf32> samples = tx.process(std::move(data));
+        const std::span<cf32> out = dac.acquire();
+        if (out.empty() || !samples) {
+            return;
+        }
+        std::copy(samples.begin(), samples.end(), out.begin());
+        dac.commit();
+    }
+    dac.stop();
+}
+
+struct RxResult {
+    std::size_t blocks = 0;
+    std::size_t errors = 0;
+};
+
+/// Start `adc` and decode every block from it until the stream ends.
+RxResult receive(const PhyConfig& config, AdcStream& adc) {
+    RxChain rx(config);
+    adc.start();
+    const std::size_t block_bits = config.info_bits_per_block();
+    PackedBits expected(block_bits);
+    RxResult r;
+    for (std::span<const cf32> in; !(in = adc.acquire()).empty(); ++r.blocks) {
+        BufferView<cf32> samples = rx.acquire_input();
+        std::copy(in.begin(), in.end(), samples.begin());
+        adc.release();
+        BufferView<std::uint64_t> received = rx.process(std::move(samples));
+        fill_payload(r.blocks, expected.view());
+        r.errors += count_bit_errors(expected.view(),
+                                     ConstBitSpan(received.span(), block_bits));
+    }
+    adc.stop();
+    return r;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) try {
+    const char* mode = argc > 1 ? argv[1] : "shm";
+    const std::size_t blocks = argc > 2 ? std::size_t(std::atol(argv[2])) : 2000;
+    const double sample_rate = (argc > 3 ? std::atof(argv[3]) : 10.0) * 1e6;
+    const std::size_t buffers = argc > 4 ? std::size_t(std::atol(argv[4])) : 2;
+
+    PhyConfig config;
+    config.modulation = Modulation::qam16;
+    StreamConfig stream;
+    stream.sample_rate = sample_rate;
+    stream.samples_per_block = config.samples_per_block();
+    stream.buffers = buffers;
+
+    DeadlineStats dac_stats, adc_stats;
+    RxResult r;
+    std::uint64_t dropped = 0;  // blocks lost on the way
+    if (std::strcmp(mode, "file") == 0) {
+        const char* path = "converter_stream.sigmf-data";
+        {
+            SigmfMeta meta;
+            meta.sample_rate = sample_rate;
+            meta.description = "converter_stream capture";
+            FileBackend capture("", path, meta);
+            DacStream dac(capture, stream);
+            transmit(config, blocks, dac);
+            dac_stats = dac.deadline_stats();
+            capture.close();
+        }
+        FileBackend replay(path, "");
+        AdcStream adc(replay, stream);
+        r = receive(config, adc);
+        adc_stats = adc.deadline_stats();
+        dropped = adc_stats.late;  // a paced AdcStream drops late blocks
+    } else {
+        // The radio end paces the ADC side, so its stream only watches the
+        // deadlines.
+        StreamConfig rx_stream = stream;
+        rx_stream.paced = false;
+        std::unique_ptr<ConverterBackend> rx_end, tx_end;
+        SharedMemoryBackend* shm = nullptr;
+        if (std::strcmp(mode, "udp") == 0) {
+            UdpConfig rx_udp;
+            rx_udp.listen_port = 50505;
+            rx_udp.receive_timeout = std::chrono::milliseconds(200);
+            rx_end = std::make_unique<UdpBackend>(rx_udp);
+            UdpConfig tx_udp;
+            tx_udp.remote_host = "127.0.0.1";
+            tx_udp.remote_port = 50505;
+            tx_end = std::make_unique<UdpBackend>(tx_udp);
+        } else {
+            SharedMemoryConfig tx_shm;
+            tx_shm.tx_name = "/dcomm_converter_stream";
+            tx_shm.capacity = 8 * stream.samples_per_block;
+            tx_shm.samples_per_block = stream.samples_per_block;
+            auto owner = std::make_unique<SharedMemoryBackend>(tx_shm);
+            shm = owner.get();
+            SharedMemoryConfig rx_shm;
+            rx_shm.rx_name = tx_shm.tx_name;
+            rx_shm.samples_per_block = stream.samples_per_block;
+            rx_shm.create = false;
+            rx_end = std::make_unique<SharedMemoryBackend>(rx_shm);
+            tx_end = std::move(owner);
+        }
+        AdcStream adc(*rx_end, rx_stream);
+        std::thread producer([&] {
+            DacStream dac(*tx_end, stream);
+            transmit(config, blocks, dac);
+            dac_stats = dac.deadline_stats();
+            if (shm != nullptr) {
+                dropped = shm->dropped();
+            }
+            tx_end.reset();  // closes the ring, ending the Rx side
+        });
+        r = receive(config, adc);
+        producer.join();
+        adc_stats = adc.deadline_stats();
+    }
+
+    // Silence sent on an underrun or a block lost on the way shifts the
+    // received blocks against the sent ones, so only a clean run is
+    // judged on its bit errors.
+    const bool clean = dac_stats.late == 0 && dropped == 0 && r.blocks == blocks;
+    std::printf("%s, %.1f Msps, %zu buffers: %zu/%zu blocks received, ", mode,
+                sample_rate / 1e6, buffers, r.blocks, blocks);
+    if (clean) {
+        std::printf("%zu bit errors\n", r.errors);
+    } else {
+        std::printf("late or lost blocks, not compared\n");
+    }
+    print_deadlines("dac", dac_stats);
+    print_deadlines("adc", adc_stats);
+    return clean && r.errors == 0 ? 0 : 1;
+} catch (const std::exception& e) {
+    std::fprintf(stderr, "converter_stream: %s\n", e.what());
+    return 1;
+}
@@ -0,0 +1,91 @@
+// Check every MCS's FramePhy against the streaming chains and time the
+// compile-time specialised pipelines against the runtime fallback.
+//
+//   frame_phy [frames per case] [symbols per frame]
+//
+// For each configuration the frame is encoded by a freshly reset TxChain
+// and by the FramePhy, which must agree sample for sample, then decoded.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "dcomm/pipeline.hpp"
+#include "dcomm/static_phy.hpp"
+
+namespace {
+
+using namespace dcomm;
+
+/// Average decode time of `phy` on `samples`, in microseconds.
+double time_decode(FramePhy& phy, const std::vector<cf32>& samples, BitSpan out, int frames) {
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        phy.decode(samples, out);
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0)
+               .count() /
+           frames;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const std::size_t symbols = argc > 2 ? std::size_t(std::atol(argv[2])) : 4;
+
+    std::mt19937 rng(3);
+    bool ok = true;
+    std::printf("%-8s %-4s %-5s %-11s %10s %10s %s\n", "mod", "rate", "intl", "pipeline",
+                "us/frame", "generic", "check");
+    for (Modulation m : {Modulation::bpsk, Modulation::qpsk, Modulation::qam16,
+                         Modulation::qam64, Modulation::qam256}) {
+        for (CodeRate r : {CodeRate::r1_2, CodeRate::r2_3, CodeRate::r3_4}) {
+            for (bool interleave : {false, true}) {
+                PhyConfig config;
+                config.modulation = m;
+                config.code_rate = r;
+                config.interleave = interleave;
+                config.symbols_per_block = symbols;
+                const std::size_t n_bits = config.info_bits_per_block();
+
+                TxChain tx(config);
+                BufferView<std::uint64_t> data = tx.acquire_input();
+                PackedBits sent(n_bits);
+                for (std::size_t i = 0; i < n_bits; ++i) {
+                    sent.set(i, rng() & 1u);
+                    BitSpan(data.span(), n_bits).set(i, sent.get(i));
+                }
+                const BufferView<cf32> reference = tx.process(std::move(data));
+
+                const std::unique_ptr<FramePhy> phy = make_frame_phy(config);
+                const std::unique_ptr<FramePhy> generic = make_generic_frame_phy(config);
+                std::vector<cf32> samples(config.samples_per_block());
+                phy->encode(sent.view(), samples);
+                const bool same_tx = std::equal(samples.begin(), samples.end(), reference.begin());
+
+                PackedBits received(n_bits);
+                phy->decode(samples, received.view());
+                const std::size_t errors = count_bit_errors(sent.view(), received.view());
+                PackedBits received_generic(n_bits);
+                generic->decode(samples, received_generic.view());
+                const std::size_t mismatches =
+                    count_bit_errors(received.view(), received_generic.view());
+
+                const double us = time_decode(*phy, samples, received.view(), frames);
+                const double us_generic =
+                    time_decode(*generic, samples, received_generic.view(), frames);
+                const bool pass = same_tx && errors == 0 && mismatches == 0;
+                ok = ok && pass;
+                std::printf("%-8s %-4s %-5s %-11s %10.2f %10.2f %s\n", to_string(m),
+                            to_string(r), interleave ? "on" : "off",
+                            phy->specialized() ? "specialized" : "generic", us, us_generic,
+                            pass ? "ok" : "FAIL");
+            }
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+// HARQ soft combining for many users: every process of every user sends an
+// 802.11 n = 648 rate-1/2 LDPC codeword over BPSK/AWGN and retransmits it
+// until it decodes, combining in HarqSoftBuffers. The block error rate
+// after each transmission is compared between float buffers (the
+// reference), int8 and int4 storage, and int8 under a budget too small for
+// every process, where old buffers are narrowed to int4 and evicted.
+//
+//   harq [Eb/N0 dB] [chase|ir] [users] [processes]
+//
+// Chase sends the whole codeword every time; ir sends 432 bits per
+// transmission at offsets 0, 432, 216, ... of the circular buffer.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "dcomm/clock.hpp"
+#include "dcomm/harq.hpp"
+#include "dcomm/ldpc.hpp"
+
+namespace {
+
+using namespace dcomm;
+
+constexpr std::size_t kMaxTx = 4;
+
+struct Run {
+    const char* name;
+    std::optional<HarqSoftBuffers> soft;  // empty: float buffers
+    std::vector<float> floats;
+    std::vector<int> decoded_at;          // transmission index, -1 if never
+    std::uint64_t buffer_ns = 0;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) try {
+    const double ebn0_db = argc > 1 ? std::atof(argv[1]) : 0.5;
+    const bool ir = argc > 2 && std::strcmp(argv[2], "ir") == 0;
+    const std::size_t users = argc > 3 ? std::size_t(std::atol(argv[3])) : 32;
+    const std::size_t processes = argc > 4 ? std::size_t(std::atol(argv[4])) : 8;
+    const std::size_t blocks = users * processes;
+
+    const LdpcCode code(LdpcBaseGraph::ieee80211_648_r12(), 27);
+    const std::size_t n = code.n();
+    const std::size_t k = code.k();
+    const std::size_t sent = ir ? 2 * n / 3 : n;
+
+    std::mt19937 rng(5);
+    std::vector<std::uint8_t> info(blocks * k), codewords(blocks * n);
+    for (std::size_t b = 0; b < blocks; ++b) {
+        for (std::size_t i = 0; i < k; ++i) {
+            info[b * k + i] = std::uint8_t(rng() & 1u);
+        }
+        code.encode(std::span(info).subspan(b * k, k), std::span(codewords).subspan(b * n, n));
+    }
+
+    HarqConfig config;
+    config.users = users;
+    config.processes = processes;
+    std::vector<Run> runs(4);
+    runs[0].name = "float";
+    runs[0].floats.resize(blocks * n);
+    runs[1].name = "int8";
+    runs[1].soft.emplace(config);
+    runs[2].name = "int4";
+    config.format = SoftFormat::int4;
+    runs[2].soft.emplace(config);
+    runs[3].name = "int8, 60% budget";
+    config.format = SoftFormat::int8;
+    config.budget_bytes = (blocks * n * 6 / 10) / config.page_bytes * config.page_bytes;
+    runs[3].soft.emplace(config);
+    for (Run& r : runs) {
+        r.decoded_at.assign(blocks, -1);
+    }
+
+    const double sigma = std::sqrt(1.0 / (2.0 * 0.5 * std::pow(10.0, ebn0_db / 10.0)));
+    std::normal_distribution<double> noise(0.0, sigma);
+    LdpcDecoder decoder(code);
+    std::vector<float> llrs(blocks * sent);
+    std::vector<std::int8_t> soft(n);
+    std::vector<std::uint8_t> decoded(k);
+
+    for (std::size_t t = 0; t < kMaxTx; ++t) {
+        const std::size_t offset = ir ? t * sent % n : 0;
+        for (std::size_t b = 0; b < blocks; ++b) {
+            for (std::size_t i = 0; i < sent; ++i) {
+                const double y = (codewords[b * n + (offset + i) % n] ? -1.0 : 1.0) + noise(rng);
+                llrs[b * sent + i] = float(2.0 * y / (sigma * sigma));
+            }
+        }
+        for (Run& r : runs) {
+            for (std::size_t b = 0; b < blocks; ++b) {
+                if (r.decoded_at[b] >= 0) {
+                    continue;
+                }
+                const std::span<const float> tx(llrs.data() + b * sent, sent);
+                const std::size_t user = b / processes, process = b % processes;
+                LdpcResult result;
+                const std::uint64_t t0 = now_ns();
+                if (r.soft) {
+                    r.soft->combine(user, process, n, offset, tx, t == 0);
+                    r.soft->read(user, process, soft);
+                    r.buffer_ns += now_ns() - t0;
+                    result = decoder.decode(std::span<const std::int8_t>(soft), decoded);
+                } else {
+                    float* acc = r.floats.data() + b * n;
+                    const std::size_t head = std::min(sent, n - offset);
+                    for (std::size_t i = 0; i < head; ++i) {
+                        acc[offset + i] += tx[i];
+                    }
+                    for (std::size_t i = head; i < sent; ++i) {
+                        acc[i - head] += tx[i];
+                    }
+                    r.buffer_ns += now_ns() - t0;
+                    result = decoder.decode(std::span<const float>(acc, n), decoded);
+                }
+                if (result.converged &&
+                    std::memcmp(decoded.data(), info.data() + b * k, k) == 0) {
+                    r.decoded_at[b] = int(t);
+                    if (r.soft) {
+                        r.soft->release(user, process);  // ACK
+                    }
+                }
+            }
+        }
+    }
+
+    std::printf("%zu users x %zu processes, %s, Eb/N0 %.1f dB\n", users, processes,
+                ir ? "incremental redundancy" : "Chase", ebn0_db);
+    std::printf("%-18s %10s %9s", "storage", "bytes/buf", "ns/llr");
+    for (std::size_t t = 0; t < kMaxTx; ++t) {
+        std::printf("   BLER tx%zu", t + 1);
+    }
+    std::printf("\n");
+    for (const Run& r : runs) {
+        const std::size_t bytes = !r.soft ? n * sizeof(float)
+                                  : r.soft->config().format == SoftFormat::int8 ? n
+                                                                                : (n + 1) / 2;
+        std::size_t combined = 0;
+        for (std::size_t t = 0; t < kMaxTx; ++t) {
+            for (const int d : r.decoded_at) {
+                combined += d >= int(t) ? 1 : 0;
+            }
+        }
+        std::printf("%-18s %10zu %9.2f", r.name, bytes,
+                    double(r.buffer_ns) / double(std::max<std::size_t>(combined, 1) * sent));
+        for (std::size_t t = 0; t < kMaxTx; ++t) {
+            std::size_t failed = 0;
+            for (const int d : r.decoded_at) {
+                failed += d < 0 || d > int(t) ? 1 : 0;
+            }
+            std::printf("   %8.4f", double(failed) / double(blocks));
+        }
+        std::printf("\n");
+    }
+    const HarqSoftBuffers::Stats& s = runs[3].soft->stats();
+    std::printf("%s: %zu pages of %zu bytes, %llu narrowed to int4, %llu evicted, "
+                "%llu retransmissions lost\n",
+                runs[3].name, runs[3].soft->pages(), runs[3].soft->config().page_bytes,
+                static_cast<unsigned long long>(s.compressions),
+                static_cast<unsigned long long>(s.evictions),
+                static_cast<unsigned long long>(s.lost));
+    return 0;
+} catch (const std::exception& e) {
+    std::fprintf(stderr, "harq: %s\n", e.what());
+    return 1;
+}
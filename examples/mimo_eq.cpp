@@ -0,0 +1,143 @@
+// 802.11n-style spatial multiplexing in the frequency domain: HT-LTF
+// channel estimation, optional comb interpolation, then ZF or MMSE
+// detection of QPSK on the 48 data subcarriers. Prints the measured error
+// vector magnitude next to the equaliser's own noise prediction, which
+// assumes a perfect estimate; the gap is the LS estimate's noise.
+//
+//   mimo_eq [2|4 streams] [rx antennas] [Es/N0 dB] [zf|mmse] [full|comb]
+//           [symbols]
+
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "dcomm/mimo.hpp"
+#include "dcomm/ofdm.hpp"
+
+int main(int argc, char** argv) try {
+    using namespace dcomm;
+
+    const std::size_t tx = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4;
+    const std::size_t rx = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : tx;
+    const double snr_db = argc > 3 ? std::atof(argv[3]) : 20.0;
+    const MimoDetector detector =
+        argc > 4 && std::strcmp(argv[4], "zf") == 0 ? MimoDetector::zf : MimoDetector::mmse;
+    const bool comb = argc > 5 && std::strcmp(argv[5], "comb") == 0;
+    const std::size_t symbols = argc > 6 ? std::strtoul(argv[6], nullptr, 10) : 1000;
+
+    constexpr std::size_t kN = PhyConfig::fft_size;
+    const OfdmLayout& layout = OfdmLayout::ieee80211();
+    const auto subcarrier = [](std::uint16_t bin) {
+        return bin < kN / 2 ? int(bin) : int(bin) - int(kN);
+    };
+    const float n0 = float(std::pow(10.0, -snr_db / 10.0));
+    std::mt19937 rng(1);
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    const auto noise = [&] { return cf32(gauss(rng), gauss(rng)) * std::sqrt(n0 / 2.0f); };
+
+    // Four-tap channel per antenna pair, unit average power, as FFT bins.
+    std::vector<cf32> h(rx * tx * kN);
+    for (std::size_t p = 0; p < rx * tx; ++p) {
+        cf32 taps[4];
+        for (cf32& t : taps) {
+            t = cf32(gauss(rng), gauss(rng)) * 0.35355339f;
+        }
+        for (std::size_t b = 0; b < kN; ++b) {
+            for (std::size_t l = 0; l < 4; ++l) {
+                h[p * kN + b] += taps[l] * std::polar(1.0f, -2.0f * std::numbers::pi_v<float> *
+                                                                float(b * l) / float(kN));
+            }
+        }
+    }
+
+    // HT-LTF: stream t sends ref[b] P[t][s] in symbol s; estimate on every
+    // data subcarrier or on every other one and interpolate.
+    std::vector<std::uint16_t> est_bins;
+    std::vector<int> est_sc, data_sc;
+    for (std::size_t k = 0; k < layout.data_bins.size(); ++k) {
+        data_sc.push_back(subcarrier(layout.data_bins[k]));
+        if (!comb || k % 2 == 0 || k + 1 == layout.data_bins.size()) {
+            est_bins.push_back(layout.data_bins[k]);
+            est_sc.push_back(data_sc.back());
+        }
+    }
+    std::vector<float> ref(est_bins.size());
+    for (float& v : ref) {
+        v = rng() & 1u ? 1.0f : -1.0f;
+    }
+    LtfChannelEstimator estimator(rx, tx, est_bins, ref);
+    const std::size_t n_ltf = estimator.ltf_symbols();
+    std::vector<std::vector<cf32>> ltf(n_ltf * rx, std::vector<cf32>(kN));
+    for (std::size_t s = 0; s < n_ltf; ++s) {
+        for (std::size_t r = 0; r < rx; ++r) {
+            for (std::size_t k = 0; k < est_bins.size(); ++k) {
+                const std::uint16_t b = est_bins[k];
+                cf32 y = noise();
+                for (std::size_t t = 0; t < tx; ++t) {
+                    y += h[(r * tx + t) * kN + b] * (ref[k] * ht_ltf_cover(t, s));
+                }
+                ltf[s * rx + r][b] = y;
+            }
+        }
+    }
+    std::vector<const cf32*> ltf_ptrs;
+    for (const auto& v : ltf) {
+        ltf_ptrs.push_back(v.data());
+    }
+    SubcarrierMatrix estimate;
+    estimator.estimate(ltf_ptrs, estimate);
+    SubcarrierMatrix channel;
+    SubcarrierInterpolator(est_sc, data_sc).apply(estimate, channel);
+
+    MimoEqualizer eq(rx, tx, detector);
+    eq.prepare(channel, n0);
+
+    // QPSK data through the true channel.
+    const std::size_t kData = layout.data_bins.size();
+    SubcarrierMatrix y(rx, 1, kData), x;
+    std::vector<cf32> sent(tx * kData);
+    double error = 0.0, predicted = 0.0;
+    std::size_t symbol_errors = 0;
+    const float a = std::numbers::sqrt2_v<float> / 2.0f;
+    for (std::size_t n = 0; n < symbols; ++n) {
+        for (cf32& v : sent) {
+            v = cf32(rng() & 1u ? a : -a, rng() & 1u ? a : -a);
+        }
+        for (std::size_t r = 0; r < rx; ++r) {
+            for (std::size_t k = 0; k < kData; ++k) {
+                cf32 v = noise();
+                for (std::size_t t = 0; t < tx; ++t) {
+                    v += h[(r * tx + t) * kN + layout.data_bins[k]] * sent[t * kData + k];
+                }
+                y.set(r, 0, k, v);
+            }
+        }
+        eq.apply(y, x);
+        for (std::size_t t = 0; t < tx; ++t) {
+            for (std::size_t k = 0; k < kData; ++k) {
+                const cf32 d = x.at(t, 0, k);
+                const cf32 s = sent[t * kData + k];
+                error += std::norm(d - s);
+                symbol_errors +=
+                    (d.real() > 0) != (s.real() > 0) || (d.imag() > 0) != (s.imag() > 0);
+                predicted += eq.noise(t)[k];
+            }
+        }
+    }
+    const double count = double(symbols * tx * kData);
+    std::printf("%zux%zu %s %.1f dB, %s estimate: EVM %.2f dB (predicted %.2f dB), "
+                "QPSK SER %.3g\n",
+                rx, tx, to_string(detector), snr_db, comb ? "comb" : "full",
+                10.0 * std::log10(error / count), 10.0 * std::log10(predicted / count),
+                double(symbol_errors) / count);
+    return 0;
+} catch (const std::exception& e) {
+    std::fprintf(stderr, "mimo_eq: %s\n", e.what());
+    return 1;
+}
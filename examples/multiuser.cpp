@@ -0,0 +1,124 @@
+// Decode a batch of short frames from many users with mixed MCS in one
+// BatchReceiver call, check every frame against what was sent, and time
+// the batch against decoding the frames one by one with RxChain.
+//
+//   multiuser [frames] [symbols per frame] [decode workers, 0 = inline]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "dcomm/batch.hpp"
+#include "dcomm/pipeline.hpp"
+
+int main(int argc, char** argv) {
+    using namespace dcomm;
+
+    const std::size_t n_frames = argc > 1 ? std::size_t(std::atol(argv[1])) : 64;
+    const std::size_t symbols = argc > 2 ? std::size_t(std::atol(argv[2])) : 2;
+    const std::size_t workers = argc > 3 ? std::size_t(std::atol(argv[3])) : 0;
+    constexpr int kRounds = 200;
+
+    // Stations at a handful of link qualities, in arrival order.
+    const McsKey kMcs[] = {
+        {Modulation::bpsk, CodeRate::r1_2, true},  {Modulation::qpsk, CodeRate::r3_4, true},
+        {Modulation::qam16, CodeRate::r1_2, true}, {Modulation::qam64, CodeRate::r2_3, true},
+        {Modulation::qam64, CodeRate::r3_4, true},
+    };
+
+    std::mt19937 rng(5);
+    std::vector<PhyConfig> configs(n_frames);
+    std::vector<std::vector<cf32>> samples(n_frames);
+    std::vector<PackedBits> sent;
+    std::vector<PackedBits> received;
+    std::map<McsKey, std::unique_ptr<TxChain>> tx;
+    std::map<McsKey, std::unique_ptr<RxChain>> rx;
+    for (std::size_t i = 0; i < n_frames; ++i) {
+        const McsKey key = kMcs[rng() % std::size(kMcs)];
+        PhyConfig& c = configs[i];
+        c.modulation = key.modulation;
+        c.code_rate = key.code_rate;
+        c.interleave = key.interleave;
+        c.symbols_per_block = symbols;
+        c.scrambler_seed = std::uint8_t(1 + rng() % 127);
+        if (!tx.count(key)) {
+            tx[key] = std::make_unique<TxChain>(c);
+        }
+        TxChain& chain = *tx[key];
+        chain.scrambler().scrambler().reset(c.scrambler_seed);
+        chain.modulator().reset();
+        BufferView<std::uint64_t> data = chain.acquire_input();
+        sent.emplace_back(c.info_bits_per_block());
+        for (std::size_t b = 0; b < c.info_bits_per_block(); ++b) {
+            sent.back().set(b, rng() & 1u);
+            BitSpan(data.span(), c.info_bits_per_block()).set(b, sent.back().get(b));
+        }
+        const BufferView<cf32> out = chain.process(std::move(data));
+        samples[i].assign(out.begin(), out.end());
+        received.emplace_back(c.info_bits_per_block());
+    }
+
+    std::vector<BatchFrame> frames(n_frames);
+    for (std::size_t i = 0; i < n_frames; ++i) {
+        frames[i] = {configs[i], samples[i], received[i].view()};
+    }
+    std::unique_ptr<WorkStealingPool> pool;
+    if (workers > 0) {
+        pool = std::make_unique<WorkStealingPool>(workers);
+    }
+    BatchReceiver batch(n_frames * symbols, Equalizer::none, pool.get());
+
+    using clock = std::chrono::steady_clock;
+    auto t0 = clock::now();
+    for (int r = 0; r < kRounds; ++r) {
+        batch.process(frames);
+    }
+    const double batch_s = std::chrono::duration<double>(clock::now() - t0).count();
+
+    std::size_t errors = 0;
+    for (std::size_t i = 0; i < n_frames; ++i) {
+        errors += count_bit_errors(sent[i].view(), received[i].view());
+    }
+
+    // The same frames through one RxChain per MCS, a frame at a time.
+    for (std::size_t i = 0; i < n_frames; ++i) {
+        const McsKey key = McsKey::of(configs[i]);
+        if (!rx.count(key)) {
+            rx[key] = std::make_unique<RxChain>(configs[i]);
+        }
+    }
+    std::size_t serial_errors = 0;
+    t0 = clock::now();
+    for (int r = 0; r < kRounds; ++r) {
+        for (std::size_t i = 0; i < n_frames; ++i) {
+            RxChain& chain = *rx[McsKey::of(configs[i])];
+            chain.descrambler().scrambler().reset(configs[i].scrambler_seed);
+            chain.demodulator().reset();
+            BufferView<cf32> in = chain.acquire_input();
+            std::copy(samples[i].begin(), samples[i].end(), in.begin());
+            const BufferView<std::uint64_t> out = chain.process(std::move(in));
+            if (r == 0) {
+                serial_errors += count_bit_errors(
+                    sent[i].view(), ConstBitSpan(out.span(), configs[i].info_bits_per_block()));
+            }
+        }
+    }
+    const double serial_s = std::chrono::duration<double>(clock::now() - t0).count();
+
+    const double frames_total = double(n_frames) * kRounds;
+    std::printf("%zu frames x %zu symbols, %zu MCS groups, %zu decode workers\n", n_frames,
+                symbols, batch.groups(), pool ? pool->size() : std::size_t(0));
+    std::printf("  batch   %8.2f us/frame  %zu bit errors\n", batch_s / frames_total * 1e6,
+                errors);
+    std::printf("  serial  %8.2f us/frame  %zu bit errors\n", serial_s / frames_total * 1e6,
+                serial_errors);
+    std::printf("  rx arena high water %zu of %zu bytes, %llu heap allocations\n",
+                batch.arena().high_water(), batch.arena().capacity(),
+                static_cast<unsigned long long>(batch.arena().heap_allocations()));
+    return errors == 0 && serial_errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+// Bursty packet reception: preamble + one chain block per packet, at random
+// gaps in noise, with a carrier frequency offset. PacketSync finds each one
+// and the Rx chain decodes its payload.
+//
+//   packet_rx [packets] [qpsk|qam16|qam64|qam256|bpsk] [Es/N0 dB] [CFO kHz]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "dcomm/channel.hpp"
+#include "dcomm/pipeline.hpp"
+#include "dcomm/sync.hpp"
+
+int main(int argc, char** argv) try {
+    using namespace dcomm;
+
+    constexpr double kSampleRate = 20e6;
+    PhyConfig config;
+    const long packets = argc > 1 ? std::atol(argv[1]) : 200;
+    if (argc > 2) {
+        for (Modulation m : {Modulation::bpsk, Modulation::qpsk, Modulation::qam16,
+                             Modulation::qam64, Modulation::qam256}) {
+            if (std::strcmp(argv[2], to_string(m)) == 0) {
+                config.modulation = m;
+            }
+        }
+    }
+    const double snr_db = argc > 3 ? std::atof(argv[3]) : 20.0;
+    // The pilots take out the phase drift left by the CFO estimate's error.
+    config.equalizer = Equalizer::pilot_zf;
+    const double cfo = (argc > 4 ? std::atof(argv[4]) : 100.0) * 1e3 / kSampleRate;
+
+    TxChain tx(config);
+    RxChain rx(config);
+    SyncConfig sync_config;
+    sync_config.payload_samples = config.samples_per_block();
+    PacketSync sync(sync_config);
+    GaussianNoise noise(1, 0);
+    std::mt19937 rng(1);
+    const float variance = float(std::pow(10.0, -snr_db / 10.0));
+    const std::size_t block_bits = config.info_bits_per_block();
+
+    // Build the whole stream first: gaps of noise, packets, and the CFO as
+    // a running phase across all of it.
+    struct Sent {
+        std::uint64_t start;
+        std::vector<std::uint64_t> words;
+    };
+    std::vector<Sent> sent;
+    std::vector<cf32> stream;
+    const auto preamble = Preamble80211::samples();
+    for (long p = 0; p < packets; ++p) {
+        stream.resize(stream.size() + 200 + rng() % 2000);
+        tx.reset();
+        BufferView<std::uint64_t> data = tx.acquire_input();
+        const BitSpan payload(data.span(), block_bits);
+        for (std::size_t i = 0; i < block_bits; ++i) {
+            payload.set(i, rng() & 1u);
+        }
+        sent.push_back({stream.size(), std::vector<std::uint64_t>(data.begin(), data.end())});
+        BufferView<cf32> samples = tx.process(std::move(data));
+        stream.insert(stream.end(), preamble.begin(), preamble.end());
+        stream.insert(stream.end(), samples.begin(), samples.end());
+    }
+    stream.resize(stream.size() + 1000);
+    for (std::size_t k = 0; k < stream.size(); ++k) {
+        const double phase = 2.0 * std::numbers::pi * std::fmod(cfo * double(k), 1.0);
+        stream[k] *= std::polar(1.0f, float(phase));
+    }
+    noise.add(stream, variance);
+
+    std::size_t found = 0, bits = 0, errors = 0, next = 0;
+    double cfo_error = 0.0;
+    const auto on_frame = [&](const SyncDetection& d, std::span<const cf32> payload) {
+        while (next < sent.size() && sent[next].start + 16 < d.start) {
+            ++next;
+        }
+        if (next == sent.size() || d.start + 16 < sent[next].start) {
+            std::fprintf(stderr, "spurious frame at %llu\n",
+                         static_cast<unsigned long long>(d.start));
+            return;
+        }
+        ++found;
+        cfo_error = std::max(cfo_error, std::abs(d.cfo - cfo));
+        rx.reset();
+        BufferView<cf32> in = rx.acquire_input();
+        std::copy(payload.begin(), payload.end(), in.begin());
+        BufferView<std::uint64_t> received = rx.process(std::move(in));
+        const std::vector<std::uint64_t>& ref = sent[next++].words;
+        errors += count_bit_errors(ConstBitSpan(ref.data(), block_bits),
+                                   ConstBitSpan(received.span(), block_bits));
+        bits += block_bits;
+    };
+    for (std::size_t k = 0; k < stream.size(); k += 1000) {
+        const std::size_t n = std::min<std::size_t>(1000, stream.size() - k);
+        sync.process(std::span<const cf32>(stream).subspan(k, n), on_frame);
+    }
+
+    std::printf("%s %.1f dB, CFO %.1f kHz: %zu/%ld packets, %llu false alarms, "
+                "max CFO error %.2f kHz, %zu bits, %zu errors\n",
+                to_string(config.modulation), snr_db, cfo * kSampleRate / 1e3, found, packets,
+                static_cast<unsigned long long>(sync.false_alarms()),
+                cfo_error * kSampleRate / 1e3, bits, errors);
+    return found == std::size_t(packets) ? 0 : 1;
+} catch (const std::exception& e) {
+    std::fprintf(stderr, "packet_rx: %s\n", e.what());
+    return 1;
+}
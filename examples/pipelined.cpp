@@ -0,0 +1,158 @@
+// Run the Tx/Rx chain as pinned pipeline tasks, with the Viterbi decoder
+// fanned out over a work-stealing pool, and check the data arrives intact
+// and in order.
+//
+//   pipelined [blocks] [qpsk|qam16|qam64|qam256|bpsk] [decode workers] [batch]
+//
+//   tx task -> ring -> rx.front task (OFDM demod, demap, deinterleave)
+//     -> ring -> rx.decode task (Viterbi x workers, in order; descramble)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "dcomm/pipeline.hpp"
+#include "dcomm/scheduler.hpp"
+#include "dcomm/spsc_ring.hpp"
+
+int main(int argc, char** argv) {
+    using namespace dcomm;
+
+    PhyConfig config;
+    const long blocks = argc > 1 ? std::atol(argv[1]) : 2000;
+    if (argc > 2) {
+        for (Modulation m : {Modulation::bpsk, Modulation::qpsk, Modulation::qam16,
+                             Modulation::qam64, Modulation::qam256}) {
+            if (std::strcmp(argv[2], to_string(m)) == 0) {
+                config.modulation = m;
+            }
+        }
+    }
+    const std::size_t workers = argc > 3 ? std::size_t(std::atol(argv[3])) : 2;
+    const std::size_t batch = argc > 4 ? std::max(1L, std::atol(argv[4])) : 4;
+    config.pool_depth = 32;
+    constexpr std::size_t kRingDepth = 8;
+    const std::size_t block_bits = config.info_bits_per_block();
+
+    TxChain tx(config);
+    RxChain rx(config);
+    SpscRing<BufferView<cf32>> sample_ring(kRingDepth);
+    SpscRing<BufferView<float>> llr_ring(kRingDepth);
+    SpscRing<BufferView<std::uint64_t>> sent_ring(config.pool_depth / 2);
+
+    WorkStealingPool decode_pool(workers);
+    OrderedFanOut<float, std::uint8_t> viterbi(decode_pool, [&] {
+        return std::make_unique<ViterbiStage>(block_bits, config.code_rate, config.pool_depth);
+    });
+
+    PipelineScheduler sched;
+    const std::vector<int> cpus = PipelineScheduler::spread(3);
+
+    std::mt19937 rng(1);
+    long produced = 0;
+    sched.add("tx", cpus[0], [&] {
+        if (produced == blocks || sample_ring.full() || sent_ring.full()) {
+            return false;
+        }
+        BufferView<std::uint64_t> data = tx.acquire_input();
+        BufferView<cf32> cable = rx.acquire_input();
+        if (!data || !cable) {
+            return false;
+        }
+        const BitSpan payload(data.span(), block_bits);
+        for (std::size_t i = 0; i < block_bits; ++i) {
+            payload.set(i, rng() & 1u);
+        }
+        BufferView<std::uint64_t> sent = data;
+        BufferView<cf32> samples = tx.process(std::move(data));
+        if (!samples) {
+            return false;
+        }
+        // The copy stands in for the converters, landing in the Rx chain's
+        // own input pool on the Rx node.
+        std::copy(samples.begin(), samples.end(), cable.begin());
+        sent_ring.try_push(sent);
+        sample_ring.try_push(cable);
+        ++produced;
+        return true;
+    });
+
+    const std::size_t front = sched.add("rx.front", cpus[1], [&] {
+        if (sample_ring.empty() || llr_ring.full()) {
+            return false;
+        }
+        BufferView<cf32> samples;
+        sample_ring.try_pop(samples);
+        auto symbols = rx.demodulator().process(std::move(samples));
+        auto llrs = rx.demapper().process(std::move(symbols));
+        rx.arena().reset();
+        if (config.interleave) {
+            llrs = rx.deinterleaver().process(std::move(llrs));
+        }
+        llr_ring.try_push(llrs);
+        return true;
+    });
+    sched.place_for(rx.input_pool(), front);
+
+    std::atomic<long> received{0};
+    std::atomic<std::size_t> errors{0};
+    std::atomic<bool> stalled{false};
+    std::vector<BufferView<float>> in(batch);
+    std::vector<BufferView<std::uint8_t>> out(batch);
+    sched.add("rx.decode", cpus[2], [&] {
+        std::size_t n = 0;
+        while (n < batch && !llr_ring.empty()) {
+            llr_ring.try_pop(in[n++]);
+        }
+        if (n == 0) {
+            return false;
+        }
+        viterbi.process(std::span(in.data(), n), std::span(out.data(), n));
+        std::size_t e = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            BufferView<std::uint64_t> bits = rx.descrambler().process(std::move(out[i]));
+            // Pushed before its samples, so always there.
+            BufferView<std::uint64_t> sent;
+            sent_ring.try_pop(sent);
+            if (!bits) {
+                stalled.store(true);
+                continue;
+            }
+            e += count_bit_errors(ConstBitSpan(sent.span(), block_bits),
+                                  ConstBitSpan(bits.span(), block_bits));
+        }
+        errors.fetch_add(e, std::memory_order_relaxed);
+        received.fetch_add(long(n), std::memory_order_release);
+        return true;
+    });
+
+    const auto t0 = std::chrono::steady_clock::now();
+    sched.start();
+    while (received.load(std::memory_order_acquire) < blocks && !stalled.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    sched.stop();
+
+    const double msps = double(blocks) * double(config.samples_per_block()) / seconds * 1e-6;
+    std::printf("%s: %ld blocks, %zu decode workers, batch %zu, %.1f Msps, %zu errors\n",
+                to_string(config.modulation), received.load(), decode_pool.size(), batch, msps,
+                errors.load());
+    for (const TaskStats& s : sched.stats()) {
+        std::printf("  %-10s cpu %3d node %d %-8s busy %8llu  idle %10llu  sleeps %6llu\n",
+                    s.name.c_str(), s.cpu, s.node, s.pinned ? "pinned" : "unpinned",
+                    static_cast<unsigned long long>(s.busy_polls),
+                    static_cast<unsigned long long>(s.idle_polls),
+                    static_cast<unsigned long long>(s.sleeps));
+    }
+    return !stalled.load() && errors.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// Record TxChain output to a SigMF file, or replay a recording through
+// RxChain and count bit errors against the same pseudo-random data.
+//
+//   replay record <file.sigmf-data> [blocks] [mod] [cf32|ci16|ci8]
+//   replay play   <file.sigmf-data> [mod] [cf32|ci16|ci8]
+//
+// The recording's datatype sets the file format; `play` converts it to the
+// sample type the Rx chain runs in, which defaults to the file's own.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <random>
+#include <string>
+
+#include "dcomm/iq_file.hpp"
+#include "dcomm/pipeline.hpp"
+
+namespace {
+
+using namespace dcomm;
+using Clock = std::chrono::steady_clock;
+
+void parse_modulation(const char* arg, PhyConfig& config) {
+    for (Modulation m : {Modulation::bpsk, Modulation::qpsk, Modulation::qam16,
+                         Modulation::qam64, Modulation::qam256}) {
+        if (std::strcmp(arg, to_string(m)) == 0) {
+            config.modulation = m;
+        }
+    }
+}
+
+double seconds_since(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+template <SampleType T>
+int record(const std::string& path, const PhyConfig& config, long blocks) {
+    BasicTxChain<T> tx(config);
+    SigmfMeta meta;
+    meta.format = iq_format_of<T>;
+    meta.sample_rate = 20e6;
+    meta.description = std::string("dcomm ") + to_string(config.modulation) + " " +
+                       to_string(config.code_rate);
+    IqFileSink sink(path, meta);
+    std::mt19937 rng(1);
+
+    const auto t0 = Clock::now();
+    const std::size_t block_bits = config.info_bits_per_block();
+    for (long b = 0; b < blocks; ++b) {
+        BufferView<std::uint64_t> data = tx.acquire_input();
+        const BitSpan payload(data.span(), block_bits);
+        for (std::size_t i = 0; i < block_bits; ++i) {
+            payload.set(i, rng() & 1u);
+        }
+        BufferView<T> samples = tx.process(std::move(data));
+        sink.write<T>(samples.span());
+    }
+    sink.close();
+    const double s = seconds_since(t0);
+    const double mb = double(sink.samples() * sample_bytes(meta.format)) / 1e6;
+    std::printf("recorded %llu %s samples (%.1f MB) in %.3f s, %.1f MB/s\n",
+                static_cast<unsigned long long>(sink.samples()), to_string(meta.format), mb, s,
+                mb / s);
+    return 0;
+}
+
+template <SampleType T>
+int play(IqFileSource& source, const PhyConfig& config) {
+    BasicRxChain<T> rx(config);
+    BufferPool<T> pool(config.pool_depth, config.samples_per_block());
+    std::mt19937 rng(1);
+
+    const std::size_t block_bits = config.info_bits_per_block();
+    std::size_t bits = 0;
+    std::size_t errors = 0;
+    long blocks = 0;
+    const auto t0 = Clock::now();
+    while (source.remaining() >= config.samples_per_block()) {
+        BufferView<T> samples = pool.acquire();
+        source.read<T>(samples.span());
+        BufferView<std::uint64_t> received = rx.process(std::move(samples));
+        if (!received) {
+            std::fprintf(stderr, "pipeline stalled at block %ld\n", blocks);
+            return 1;
+        }
+        const ConstBitSpan decoded(received.span(), block_bits);
+        for (std::size_t i = 0; i < block_bits; ++i) {
+            errors += decoded[i] != std::uint8_t(rng() & 1u);
+        }
+        bits += block_bits;
+        ++blocks;
+    }
+    const double s = seconds_since(t0);
+    const double mb = double(source.position() * sample_bytes(source.format())) / 1e6;
+    std::printf("%s as %s: %ld blocks, %zu bits, %zu errors, %.1f MB/s\n",
+                to_string(source.format()), SampleTraits<T>::name, blocks, bits, errors, mb / s);
+    if (source.saturation().saturated > 0) {
+        std::printf("conversion saturation: %.3g%%\n", 100.0 * source.saturation().rate());
+    }
+    return errors == 0 ? 0 : 1;
+}
+
+int usage() {
+    std::fprintf(stderr,
+                 "usage: replay record <file.sigmf-data> [blocks] [mod] [cf32|ci16|ci8]\n"
+                 "       replay play   <file.sigmf-data> [mod] [cf32|ci16|ci8]\n");
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) try {
+    if (argc < 3) {
+        return usage();
+    }
+    const std::string mode = argv[1];
+    const std::string path = argv[2];
+    PhyConfig config;
+
+    if (mode == "record") {
+        const long blocks = argc > 3 ? std::atol(argv[3]) : 1000;
+        if (argc > 4) {
+            parse_modulation(argv[4], config);
+        }
+        const char* sample = argc > 5 ? argv[5] : "cf32";
+        if (std::strcmp(sample, "ci16") == 0) {
+            return record<ci16>(path, config, blocks);
+        }
+        if (std::strcmp(sample, "ci8") == 0) {
+            return record<ci8>(path, config, blocks);
+        }
+        return record<cf32>(path, config, blocks);
+    }
+    if (mode == "play") {
+        if (argc > 3) {
+            parse_modulation(argv[3], config);
+        }
+        IqFileSource source(path);
+        const char* sample = argc > 4 ? argv[4] : SampleTraits<cf32>::name;
+        if (argc <= 4) {
+            sample = source.format() == IqFormat::ci16  ? SampleTraits<ci16>::name
+                     : source.format() == IqFormat::ci8 ? SampleTraits<ci8>::name
+                                                        : sample;
+        }
+        if (std::strcmp(sample, "ci16") == 0) {
+            return play<ci16>(source, config);
+        }
+        if (std::strcmp(sample, "ci8") == 0) {
+            return play<ci8>(source, config);
+        }
+        return play<cf32>(source, config);
+    }
+    return usage();
+} catch (const std::exception& e) {
+    std::fprintf(stderr, "replay: %s\n", e.what());
+    return 1;
+}
@@ -0,0 +1,189 @@
+// Run TxChain and RxChain on their own threads, joined through SPSC rings
+// and a simulated DAC -> ADC cable, and report ring fill, counters and the
+// per-stage cost that shows which stage bounds the chain.
+//
+//   streaming [blocks] [qpsk|qam16|qam64|qam256|bpsk] [sample rate in Msps, 0 = free-running]
+//             [trace.json]
+//
+// With a trace path, the last stage calls of both chains are written as
+// Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+//
+//   Tx thread -> tx ring -> DacSink -> cable -> AdcSource -> rx ring -> Rx (main)
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+
+#include "dcomm/clock.hpp"
+#include "dcomm/converter.hpp"
+#include "dcomm/instrument.hpp"
+#include "dcomm/pipeline.hpp"
+#include "dcomm/spsc_ring.hpp"
+
+namespace {
+
+void print_ring(const char* name, const dcomm::RingStats& s) {
+    std::printf("  %-6s pushed %8llu  popped %8llu  overruns %6llu  underruns %8llu\n", name,
+                static_cast<unsigned long long>(s.pushed),
+                static_cast<unsigned long long>(s.popped),
+                static_cast<unsigned long long>(s.overruns),
+                static_cast<unsigned long long>(s.underruns));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    using namespace dcomm;
+
+    PhyConfig config;
+    const long blocks = argc > 1 ? std::atol(argv[1]) : 1000;
+    if (argc > 2) {
+        for (Modulation m : {Modulation::bpsk, Modulation::qpsk, Modulation::qam16,
+                             Modulation::qam64, Modulation::qam256}) {
+            if (std::strcmp(argv[2], to_string(m)) == 0) {
+                config.modulation = m;
+            }
+        }
+    }
+    const double sample_rate = argc > 3 ? std::atof(argv[3]) * 1e6 : 0.0;
+    const char* trace_path = argc > 4 ? argv[4] : nullptr;
+    // Blocks queue up in three rings between the chains; the pools behind
+    // them must outlast every block in flight.
+    config.pool_depth = 32;
+    constexpr std::size_t kRingDepth = 4;
+
+    TxChain tx(config);
+    RxChain rx(config);
+    TraceRing trace(1 << 14);
+    if (trace_path != nullptr) {
+        tx.attach_trace(&trace);
+        rx.attach_trace(&trace);
+    }
+    const std::size_t block_samples = config.samples_per_block();
+    const std::size_t block_bits = config.info_bits_per_block();
+
+    SampleRing tx_ring(kRingDepth);
+    SampleRing cable(kRingDepth);
+    SampleRing rx_ring(kRingDepth);
+    SpscRing<BufferView<std::uint64_t>> sent_ring(config.pool_depth / 2);
+
+    DacSink dac(tx_ring, sample_rate, block_samples, [&](BufferView<cf32> block) {
+        while (cable.full()) {
+            std::this_thread::yield();
+        }
+        cable.try_push(block);
+    });
+    AdcSource adc(rx_ring, config.pool_depth, sample_rate, block_samples,
+                  [&, taken = 0L](std::span<cf32> out) mutable {
+                      if (taken == blocks) {
+                          return false;
+                      }
+                      while (cable.empty()) {
+                          std::this_thread::yield();
+                      }
+                      BufferView<cf32> block;
+                      cable.try_pop(block);
+                      std::copy(block.begin(), block.end(), out.begin());
+                      ++taken;
+                      return true;
+                  });
+
+    std::thread producer([&] {
+        std::mt19937 rng(1);
+        for (long b = 0; b < blocks; ++b) {
+            BufferView<std::uint64_t> data;
+            while (!(data = tx.acquire_input())) {
+                std::this_thread::yield();
+            }
+            const BitSpan payload(data.span(), block_bits);
+            for (std::size_t i = 0; i < block_bits; ++i) {
+                payload.set(i, rng() & 1u);
+            }
+            BufferView<std::uint64_t> sent = data;
+            BufferView<cf32> samples;
+            while (!(samples = tx.process(data))) {
+                std::this_thread::yield();
+            }
+            while (tx_ring.full() || sent_ring.full()) {
+                std::this_thread::yield();
+            }
+            sent_ring.try_push(sent);
+            tx_ring.try_push(samples);
+        }
+    });
+
+    dac.start();
+    adc.start();
+
+    std::size_t bits = 0;
+    std::size_t errors = 0;
+    std::size_t received_blocks = 0;
+    std::size_t max_fill = 0;
+    BufferView<cf32> samples;
+    BufferView<std::uint64_t> sent;
+    std::uint64_t wait_begin = 0;
+    while (!(adc.finished() && rx_ring.empty())) {
+        max_fill = std::max(max_fill, rx_ring.size());
+        if (rx_ring.empty()) {
+            if (wait_begin == 0) {
+                wait_begin = read_cycles();
+            }
+            std::this_thread::yield();
+            continue;
+        }
+        if (wait_begin != 0) {
+            rx.record_input_wait(read_cycles() - wait_begin);
+            wait_begin = 0;
+        }
+        rx_ring.try_pop(samples);
+        BufferView<std::uint64_t> received = rx.process(std::move(samples));
+        if (!received) {
+            std::fprintf(stderr, "pipeline stalled at block %zu\n", received_blocks);
+            return 1;
+        }
+        while (sent_ring.empty()) {
+            std::this_thread::yield();
+        }
+        sent_ring.try_pop(sent);
+        errors += count_bit_errors(ConstBitSpan(sent.span(), block_bits),
+                                   ConstBitSpan(received.span(), block_bits));
+        bits += block_bits;
+        ++received_blocks;
+    }
+
+    producer.join();
+    adc.stop();
+    dac.stop();
+
+    // Dropped blocks desynchronise the sent/received pairing, so only a
+    // lossless run is judged on its bit errors.
+    const bool lossless = received_blocks == std::size_t(blocks);
+    std::printf("%s, %s: %zu/%ld blocks, %zu bits, ", to_string(config.modulation),
+                sample_rate > 0.0 ? "paced" : "free-running", received_blocks, blocks, bits);
+    if (lossless) {
+        std::printf("%zu errors\n", errors);
+    } else {
+        std::printf("blocks dropped, not compared\n");
+    }
+    std::printf("  rx ring peak fill %zu/%zu, adc pool overruns %llu, dropped %llu\n",
+                max_fill, rx_ring.capacity(),
+                static_cast<unsigned long long>(adc.pool_overruns()),
+                static_cast<unsigned long long>(adc.dropped()));
+    print_ring("tx", tx_ring.stats());
+    print_ring("cable", cable.stats());
+    print_ring("rx", rx_ring.stats());
+    std::printf("tx stages:\n");
+    write_stage_report(stdout, tx.stage_stats());
+    std::printf("rx stages:\n");
+    write_stage_report(stdout, rx.stage_stats());
+    if (trace_path != nullptr) {
+        trace.write_chrome_trace(trace_path);
+        std::printf("trace: %llu events, last %zu in %s\n",
+                    static_cast<unsigned long long>(trace.pushed()),
+                    std::min<std::size_t>(trace.pushed(), trace.capacity()), trace_path);
+    }
+    return lossless && errors == 0 ? 0 : 1;
+}
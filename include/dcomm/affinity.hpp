@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace dcomm {
+
+/// Logical CPUs the process may run on.
+unsigned cpu_count() noexcept;
+
+/// NUMA node of logical CPU `cpu`, from sysfs; 0 when the machine has no
+/// NUMA topology to report or `cpu` is unknown.
+int numa_node_of_cpu(int cpu) noexcept;
+
+/// NUMA nodes in the machine (1 without NUMA).
+int numa_node_count() noexcept;
+
+/// Restrict the calling thread to logical CPU `cpu`. Returns false if the
+/// platform does not support pinning or refused it; the thread then keeps
+/// running unpinned.
+bool pin_current_thread(int cpu) noexcept;
+
+/// Move the pages of `memory` to NUMA node `node` and keep them there
+/// (mbind with MPOL_BIND, MPOL_MF_MOVE). Only whole pages inside the span
+/// are moved. Returns false without NUMA support, in which case pages stay
+/// where first touch put them.
+bool bind_to_numa_node(std::span<std::byte> memory, int node) noexcept;
+
+}  // namespace dcomm
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+/// Bump allocator for the scratch memory of one frame.
+///
+/// The arena allocates one block of `capacity` bytes up front. allocate()
+/// hands out cache-line aligned slices of it by advancing an offset, and
+/// reset() takes them all back at once when the frame is done. Slices are
+/// uninitialised and T must be trivially destructible, as with
+/// AlignedArray.
+///
+/// A request that does not fit is served from the heap instead of failing;
+/// the block lives until the next reset() and is counted in
+/// heap_allocations(). An arena sized for the largest configuration it
+/// serves (BasicRxChain::scratch_bytes()) keeps that counter at zero, so a
+/// non-zero count in steady state means the sizing is wrong. Not
+/// thread-safe: one arena per thread.
+class FrameArena {
+public:
+    explicit FrameArena(std::size_t capacity);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /// `count` uninitialised elements, aligned to kCacheLine.
+    template <class T>
+    std::span<T> allocate(std::size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "the arena never runs destructors");
+        static_assert(alignof(T) <= kCacheLine, "over-aligned type");
+        return {static_cast<T*>(allocate_bytes(count * sizeof(T))), count};
+    }
+
+    /// Release every slice, including the heap fallbacks. Call once per
+    /// frame, after its last use of the scratch.
+    void reset() noexcept;
+
+    std::size_t capacity() const noexcept { return capacity_; }
+    /// Bytes handed out since the last reset(), padding included.
+    std::size_t used() const noexcept { return offset_; }
+    /// Largest used() so far, counting requests that spilled to the heap.
+    std::size_t high_water() const noexcept { return high_water_; }
+    /// Requests served from the heap since construction.
+    std::uint64_t heap_allocations() const noexcept { return heap_allocations_; }
+
+private:
+    void* allocate_bytes(std::size_t bytes);
+
+    AlignedArray<std::byte> block_;
+    std::size_t capacity_;
+    std::size_t offset_ = 0;
+    std::size_t high_water_ = 0;
+    std::size_t spilled_ = 0;  // bytes on the heap since the last reset()
+    std::vector<AlignedArray<std::byte>> overflow_;
+    std::uint64_t heap_allocations_ = 0;
+};
+
+}  // namespace dcomm
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "dcomm/buffer.hpp"
+#include "dcomm/executor.hpp"
+#include "dcomm/frame.hpp"
+
+namespace dcomm {
+
+/// Post-detection receiver for bursty traffic: each frame is a coroutine
+/// on an Executor.
+///
+/// A submitted frame first decodes its SIGNAL symbol at Priority::high,
+/// so a header never waits behind queued payloads; a frame whose SIGNAL
+/// does not parse, or that is shorter than the SIGNAL says, is dropped
+/// there. The coroutine then suspends and requeues its payload decode by
+/// length, at Priority::normal up to `short_symbols` OFDM symbols and
+/// Priority::low beyond, so short frames overtake long ones and are
+/// delivered first. Messages therefore come out in completion order,
+/// tagged with the id submit() returned.
+///
+/// Frames are copied into `max_in_flight` pooled buffers of
+/// kMaxFrameSamples, so steady-state reception does not touch the heap
+/// beyond the coroutine frames. Each worker decodes with its own
+/// FrameCodec; the handler is called on the workers, one call at a time.
+class AsyncReceiver {
+public:
+    using Handler =
+        std::function<void(std::uint64_t id, const SignalField& signal, ConstBitSpan payload)>;
+
+    /// Throws std::invalid_argument if `base` is invalid.
+    AsyncReceiver(Executor& executor, const PhyConfig& base, Handler on_message,
+                  std::size_t max_in_flight = 16, std::size_t short_symbols = 16);
+    /// Waits for the frames in flight.
+    ~AsyncReceiver();
+
+    AsyncReceiver(const AsyncReceiver&) = delete;
+    AsyncReceiver& operator=(const AsyncReceiver&) = delete;
+
+    /// Queue a frame: `samples` start with the SIGNAL symbol, e.g. the
+    /// payload PacketSync hands on, and up to kMaxFrameSamples of them are
+    /// copied. Blocks while max_in_flight frames are queued. Returns the
+    /// frame's id, counting from 0.
+    std::uint64_t submit(std::span<const cf32> samples);
+
+    /// Block until every submitted frame is delivered or dropped.
+    void drain();
+
+    std::uint64_t submitted() const noexcept { return next_id_; }
+    std::uint64_t delivered() const noexcept { return delivered_.load(std::memory_order_relaxed); }
+    /// Frames dropped at the SIGNAL symbol.
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    Detached receive(std::uint64_t id, BufferView<cf32> samples);
+    FrameCodec& codec() { return *codecs_[executor_.current_worker()]; }
+    void finish();
+
+    Executor& executor_;
+    Handler on_message_;
+    std::size_t short_symbols_;
+    std::size_t max_in_flight_;
+    std::vector<std::unique_ptr<FrameCodec>> codecs_;  // per worker
+    BufferPool<cf32> samples_;
+    BufferPool<std::uint64_t> payloads_;
+
+    std::mutex deliver_;  // serialises on_message_
+
+    std::mutex mutex_;
+    std::condition_variable finished_;
+    std::size_t in_flight_ = 0;
+
+    std::uint64_t next_id_ = 0;
+    std::atomic<std::uint64_t> delivered_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+};
+
+}  // namespace dcomm
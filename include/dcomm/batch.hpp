@@ -0,0 +1,87 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "dcomm/arena.hpp"
+#include "dcomm/bits.hpp"
+#include "dcomm/convcode.hpp"
+#include "dcomm/phy_config.hpp"
+#include "dcomm/thread_pool.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+/// Parameters that decide how a frame is demapped, deinterleaved and
+/// decoded; frames sharing one run through those kernels together.
+struct McsKey {
+    Modulation modulation;
+    CodeRate code_rate;
+    bool interleave;
+
+    static McsKey of(const PhyConfig& c) noexcept {
+        return {c.modulation, c.code_rate, c.interleave};
+    }
+    friend auto operator<=>(const McsKey&, const McsKey&) = default;
+};
+
+/// One frame of a multi-user batch.
+///
+/// `config` carries the frame's own MCS, length (symbols_per_block OFDM
+/// symbols), noise variance and scrambler seed; `samples` holds
+/// config.samples_per_block() received samples, and the decoded data,
+/// config.info_bits_per_block() bits, is written to `bits`. Every frame is
+/// a stream of its own: pilots and scrambler start afresh.
+struct BatchFrame {
+    PhyConfig config;
+    std::span<const cf32> samples;
+    BitSpan bits;
+};
+
+/// Receiver for many short frames at once, e.g. one per station or UE.
+///
+/// Decoding small frames one by one keeps the vector kernels on short
+/// runs and reloads their tables per frame. process() instead runs each
+/// step across the whole batch:
+///
+///   - one batched FFT over the OFDM symbols of every frame, then the
+///     per-frame pilot equaliser if enabled;
+///   - frames grouped by McsKey, with each group's symbols laid out back to
+///     back, so one demap_maxlog() call and one deinterleave covers the
+///     group (noise variance is applied per frame as an LLR scale);
+///   - Viterbi decoding of every frame, spread over `pool` when given;
+///   - descrambling per frame.
+///
+/// All scratch comes from an arena sized for `max_ofdm_symbols` symbols
+/// across the batch; a larger batch spills to the heap (see FrameArena).
+/// Not thread-safe: one receiver per thread.
+class BatchReceiver {
+public:
+    explicit BatchReceiver(std::size_t max_ofdm_symbols, Equalizer equalizer = Equalizer::none,
+                           WorkStealingPool* pool = nullptr);
+
+    /// Decode every frame. Throws std::invalid_argument if a frame's
+    /// config is invalid or its spans are too short.
+    void process(std::span<const BatchFrame> frames);
+
+    /// Parameter-set groups of the last batch.
+    std::size_t groups() const noexcept { return groups_; }
+
+    const FrameArena& arena() const noexcept { return arena_; }
+
+    /// Arena capacity a batch of `ofdm_symbols` symbols in total needs.
+    static std::size_t scratch_bytes(std::size_t ofdm_symbols) noexcept;
+
+private:
+    Equalizer equalizer_;
+    WorkStealingPool* pool_;
+    FrameArena arena_;
+    std::vector<ViterbiDecoder> decoders_;  // one per pool worker
+    std::vector<std::uint32_t> order_;      // frame indices sorted by McsKey
+    std::size_t groups_ = 0;
+};
+
+}  // namespace dcomm
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+// Packed bits: bit i of a stream is bit i % 64 of 64-bit word i / 64, so
+// each word holds 64 consecutive bits with the earliest in its LSB. Bits
+// past the end of the last word are padding: every function here ignores
+// them on input and clears them on output.
+
+constexpr std::size_t packed_words(std::size_t bits) noexcept { return (bits + 63) / 64; }
+
+/// Valid bits of the last word of a `bits`-bit stream.
+constexpr std::uint64_t tail_mask(std::size_t bits) noexcept {
+    return bits % 64 == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << (bits % 64)) - 1;
+}
+
+/// Non-owning view of packed bits; W is std::uint64_t or const std::uint64_t.
+template <class W>
+struct BasicBitSpan {
+    W* words = nullptr;
+    std::size_t count = 0;  // bits
+
+    BasicBitSpan() noexcept = default;
+    BasicBitSpan(W* w, std::size_t bits) noexcept : words(w), count(bits) {}
+    /// The first `bits` bits of `w`.
+    BasicBitSpan(std::span<W> w, std::size_t bits) noexcept : words(w.data()), count(bits) {
+        assert(packed_words(bits) <= w.size());
+    }
+    /// BitSpan converts to ConstBitSpan, as std::span does.
+    template <class V>
+        requires(!std::same_as<V, W> && std::convertible_to<V*, W*>)
+    BasicBitSpan(const BasicBitSpan<V>& o) noexcept : words(o.words), count(o.count) {}
+
+    std::size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+    std::size_t word_count() const noexcept { return packed_words(count); }
+    std::span<W> word_span() const noexcept { return {words, word_count()}; }
+
+    std::uint8_t operator[](std::size_t i) const noexcept {
+        assert(i < count);
+        return std::uint8_t((words[i / 64] >> (i % 64)) & 1u);
+    }
+    void set(std::size_t i, unsigned bit) const noexcept
+        requires(!std::is_const_v<W>)
+    {
+        assert(i < count);
+        const std::uint64_t m = std::uint64_t(1) << (i % 64);
+        words[i / 64] = (words[i / 64] & ~m) | (bit & 1u ? m : 0);
+    }
+
+    /// Bits [offset, offset + n); offset must be a multiple of 64.
+    BasicBitSpan subspan(std::size_t offset, std::size_t n) const noexcept {
+        assert(offset % 64 == 0 && offset + n <= count);
+        return {words + offset / 64, n};
+    }
+};
+
+using BitSpan = BasicBitSpan<std::uint64_t>;
+using ConstBitSpan = BasicBitSpan<const std::uint64_t>;
+
+/// Owning, cache-line aligned packed bits, zero-initialised.
+class PackedBits {
+public:
+    PackedBits() = default;
+    explicit PackedBits(std::size_t bits)
+        : bits_(bits), data_(make_aligned_array<std::uint64_t>(packed_words(bits))) {}
+
+    std::size_t size() const noexcept { return bits_; }
+    BitSpan view() noexcept { return {data_.get(), bits_}; }
+    ConstBitSpan view() const noexcept { return {data_.get(), bits_}; }
+
+    std::uint8_t get(std::size_t i) const noexcept { return view()[i]; }
+    void set(std::size_t i, unsigned bit) noexcept { view().set(i, bit); }
+
+private:
+    std::size_t bits_ = 0;
+    AlignedArray<std::uint64_t> data_;
+};
+
+/// Positions where `a` and `b` (equal sizes) differ.
+std::size_t count_bit_errors(ConstBitSpan a, ConstBitSpan b) noexcept;
+
+// Conversions between packed bits and one-value-per-element arrays, and the
+// bit shuffles the Tx chain is built from. Sizes must match as stated;
+// outputs must not overlap inputs unless noted. On x86 CPUs with BMI2 the
+// field, zip and select kernels are single pdep/pext instructions per
+// word; AVX-512 moves bytes and float signs through mask registers. Every
+// variant produces identical bits.
+
+/// Pack one bit per byte (bit 0 of each byte). out.size() == bits.size().
+void pack_bits(std::span<const std::uint8_t> bits, BitSpan out) noexcept;
+/// One bit per byte, 0 or 1.
+void unpack_bits(ConstBitSpan bits, std::span<std::uint8_t> out) noexcept;
+
+/// Hard decisions of LLRs (positive favours 0): bit i is the sign bit of
+/// llrs[i].
+void pack_hard_decisions(std::span<const float> llrs, BitSpan out) noexcept;
+/// Ideal LLRs of known bits: +magnitude for a 0, -magnitude for a 1.
+void unpack_llrs(ConstBitSpan bits, float magnitude, std::span<float> llrs) noexcept;
+
+/// Consecutive `width`-bit groups (1..8) as one index per byte, the first
+/// bit of a group most significant: the axis codes of map_bits().
+/// bits.size() == indices.size() * width.
+void unpack_indices(ConstBitSpan bits, unsigned width, std::span<std::uint8_t> indices) noexcept;
+/// The inverse; indices must be below 2^width.
+void pack_indices(std::span<const std::uint8_t> indices, unsigned width, BitSpan out) noexcept;
+
+/// out = a0 b0 a1 b1 ...; a.size() == b.size(), out.size() == 2 a.size().
+void zip_bits(ConstBitSpan a, ConstBitSpan b, BitSpan out) noexcept;
+
+/// Keep bit i of `in` where bit i mod (64 keep.size()) of the periodic mask
+/// `keep` is set, in order, and return how many were kept. out.size() must
+/// be at least that; extra bits are left cleared. `out` may be `in`.
+std::size_t select_bits(ConstBitSpan in, std::span<const std::uint64_t> keep,
+                        BitSpan out) noexcept;
+
+// The functions above run the kernels of active_isa(); these pick the
+// variant explicitly. `isa` must be isa_available().
+void pack_bits(Isa isa, std::span<const std::uint8_t> bits, BitSpan out) noexcept;
+void unpack_bits(Isa isa, ConstBitSpan bits, std::span<std::uint8_t> out) noexcept;
+void pack_hard_decisions(Isa isa, std::span<const float> llrs, BitSpan out) noexcept;
+void unpack_llrs(Isa isa, ConstBitSpan bits, float magnitude, std::span<float> llrs) noexcept;
+void unpack_indices(Isa isa, ConstBitSpan bits, unsigned width,
+                    std::span<std::uint8_t> indices) noexcept;
+void pack_indices(Isa isa, std::span<const std::uint8_t> indices, unsigned width,
+                  BitSpan out) noexcept;
+void zip_bits(Isa isa, ConstBitSpan a, ConstBitSpan b, BitSpan out) noexcept;
+std::size_t select_bits(Isa isa, ConstBitSpan in, std::span<const std::uint64_t> keep,
+                        BitSpan out) noexcept;
+
+}  // namespace dcomm
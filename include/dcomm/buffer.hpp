@@ -0,0 +1,240 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+template <class T>
+class BufferPool;
+
+/// Reference-counted view into one buffer of a BufferPool.
+///
+/// Copying a view shares the underlying buffer; the buffer returns to its
+/// pool when the last view referencing it is destroyed. A view covers a
+/// window [offset, offset + size) of the buffer and can be narrowed with
+/// slice() without touching the samples.
+template <class T>
+class BufferView {
+public:
+    BufferView() noexcept = default;
+
+    BufferView(const BufferView& other) noexcept
+        : pool_(other.pool_), slot_(other.slot_), data_(other.data_),
+          size_(other.size_), capacity_(other.capacity_) {
+        if (pool_ != nullptr) {
+            pool_->add_ref(slot_);
+        }
+    }
+
+    BufferView(BufferView&& other) noexcept
+        : pool_(std::exchange(other.pool_, nullptr)), slot_(other.slot_),
+          data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)) {}
+
+    BufferView& operator=(BufferView other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~BufferView() { reset(); }
+
+    void swap(BufferView& other) noexcept {
+        std::swap(pool_, other.pool_);
+        std::swap(slot_, other.slot_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    /// Drop this reference; the view becomes empty.
+    void reset() noexcept {
+        if (pool_ != nullptr) {
+            std::exchange(pool_, nullptr)->release(slot_);
+        }
+        data_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+    }
+
+    explicit operator bool() const noexcept { return pool_ != nullptr; }
+
+    T* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    /// Elements available from the start of this view to the end of the
+    /// underlying buffer.
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    /// Grow or shrink the view within its capacity.
+    void resize(std::size_t n) noexcept {
+        assert(n <= capacity_);
+        size_ = n;
+    }
+
+    std::span<T> span() const noexcept { return {data_, size_}; }
+    T& operator[](std::size_t i) const noexcept { return data_[i]; }
+    T* begin() const noexcept { return data_; }
+    T* end() const noexcept { return data_ + size_; }
+
+    /// True when no other view shares the buffer, i.e. the holder may
+    /// write to it in place.
+    bool unique() const noexcept {
+        return pool_ != nullptr && pool_->use_count(slot_) == 1;
+    }
+
+    /// A new reference to the sub-range [offset, offset + length).
+    BufferView slice(std::size_t offset, std::size_t length) const noexcept {
+        assert(offset + length <= size_);
+        BufferView v(*this);
+        v.data_ += offset;
+        v.size_ = length;
+        v.capacity_ -= offset;
+        return v;
+    }
+
+private:
+    friend class BufferPool<T>;
+
+    BufferView(BufferPool<T>* pool, std::uint32_t slot, T* data,
+               std::size_t capacity) noexcept
+        : pool_(pool), slot_(slot), data_(data), size_(capacity),
+          capacity_(capacity) {}
+
+    BufferPool<T>* pool_ = nullptr;
+    std::uint32_t slot_ = 0;
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+/// Fixed set of equally sized, cache-line aligned buffers.
+///
+/// All memory is allocated by the constructor; acquire() and the release
+/// performed by BufferView never touch the heap. The free list is a
+/// tagged lock-free stack, so buffers may be acquired and released from
+/// different threads. The pool must outlive every view it hands out.
+template <class T>
+class BufferPool {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "pooled buffers hold plain sample or bit data");
+
+public:
+    BufferPool(std::size_t count, std::size_t capacity)
+        : count_(count), capacity_(capacity),
+          stride_(align_up(capacity * sizeof(T), kCacheLine) / sizeof(T)),
+          storage_(make_aligned_array<T>(stride_ * count)),
+          slots_(std::make_unique<Slot[]>(count)) {
+        static_assert(kCacheLine % sizeof(T) == 0,
+                      "element size must divide the cache line");
+        for (std::size_t i = 0; i < count_; ++i) {
+            slots_[i].next.store(i + 1 < count_ ? std::uint32_t(i + 1) : kNil,
+                                 std::memory_order_relaxed);
+        }
+        head_.store(pack(0, count_ > 0 ? 0 : kNil), std::memory_order_relaxed);
+        available_.store(count_, std::memory_order_relaxed);
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    ~BufferPool() {
+        assert(available_.load() == count_ && "views outlived their pool");
+    }
+
+    /// Take a buffer from the pool, sized to full capacity. Returns an empty
+    /// view when every buffer is in use; stages treat that as back-pressure.
+    BufferView<T> acquire() noexcept {
+        std::uint64_t head = head_.load(std::memory_order_acquire);
+        for (;;) {
+            const std::uint32_t idx = index_of(head);
+            if (idx == kNil) {
+                return {};
+            }
+            const std::uint32_t next =
+                slots_[idx].next.load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(head, pack(tag_of(head) + 1, next),
+                                            std::memory_order_acquire,
+                                            std::memory_order_acquire)) {
+                slots_[idx].refs.store(1, std::memory_order_relaxed);
+                available_.fetch_sub(1, std::memory_order_relaxed);
+                return BufferView<T>(this, idx, storage_.get() + idx * stride_,
+                                     capacity_);
+            }
+        }
+    }
+
+    std::size_t count() const noexcept { return count_; }
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    /// The memory behind every buffer, e.g. to move it next to the thread
+    /// that reads it (bind_to_numa_node()) before the pool is used.
+    std::span<std::byte> storage() noexcept {
+        return {reinterpret_cast<std::byte*>(storage_.get()), stride_ * count_ * sizeof(T)};
+    }
+
+    /// Buffers currently free. Only a snapshot when other threads are active.
+    std::size_t available() const noexcept {
+        return available_.load(std::memory_order_relaxed);
+    }
+
+private:
+    friend class BufferView<T>;
+
+    static constexpr std::uint32_t kNil = 0xffffffffu;
+
+    struct alignas(kCacheLine) Slot {
+        std::atomic<std::uint32_t> refs{0};
+        std::atomic<std::uint32_t> next{kNil};
+    };
+
+    static constexpr std::uint64_t pack(std::uint32_t tag, std::uint32_t idx) {
+        return (std::uint64_t(tag) << 32) | idx;
+    }
+    static constexpr std::uint32_t index_of(std::uint64_t v) {
+        return std::uint32_t(v);
+    }
+    static constexpr std::uint32_t tag_of(std::uint64_t v) {
+        return std::uint32_t(v >> 32);
+    }
+
+    void add_ref(std::uint32_t idx) noexcept {
+        slots_[idx].refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::uint32_t use_count(std::uint32_t idx) const noexcept {
+        return slots_[idx].refs.load(std::memory_order_acquire);
+    }
+
+    void release(std::uint32_t idx) noexcept {
+        if (slots_[idx].refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        do {
+            slots_[idx].next.store(index_of(head), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, pack(tag_of(head) + 1, idx),
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+        available_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::size_t count_;
+    std::size_t capacity_;
+    std::size_t stride_;
+    AlignedArray<T> storage_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(kCacheLine) std::atomic<std::uint64_t> head_{0};
+    std::atomic<std::size_t> available_{0};
+};
+
+}  // namespace dcomm
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "dcomm/complex_layout.hpp"
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+namespace kernels {
+struct ChannelKernels;
+}
+
+/// Complex white Gaussian noise, generated a buffer at a time.
+///
+/// Samples come from a Philox4x32 stream: each counter block gives two
+/// complex samples through Box-Muller, with log and sincos evaluated by
+/// polynomials so that whole registers of samples are produced per
+/// iteration. The noise is a pure function of (seed, stream, position) and
+/// is bit-identical across instruction sets, so simulations reproduce on
+/// any machine. A call for an odd number of samples still consumes a whole
+/// block; the stream position is always a whole number of blocks.
+class GaussianNoise {
+public:
+    GaussianNoise(std::uint64_t seed, std::uint64_t stream) noexcept;
+    GaussianNoise(std::uint64_t seed, std::uint64_t stream, Isa isa) noexcept;
+
+    /// out = noise with E|n|^2 = variance.
+    void fill(std::span<cf32> out, float variance) noexcept;
+    /// out = in + noise; in and out may be the same buffer.
+    void add(std::span<const cf32> in, std::span<cf32> out, float variance) noexcept;
+    void add(std::span<cf32> samples, float variance) noexcept {
+        add(samples, samples, variance);
+    }
+
+    /// Restart at the beginning of `stream`.
+    void seek(std::uint64_t stream, std::uint64_t block = 0) noexcept {
+        stream_ = stream;
+        counter_ = block;
+    }
+    /// Counter blocks consumed so far.
+    std::uint64_t position() const noexcept { return counter_; }
+
+private:
+    void generate(const cf32* in, cf32* out, std::size_t n, float variance) noexcept;
+
+    const kernels::ChannelKernels* kernels_;
+    std::uint32_t key_[2];
+    std::uint64_t stream_;
+    std::uint64_t counter_ = 0;
+};
+
+/// Power delay profiles of the 3GPP tapped-delay-line fading models.
+enum class FadingProfile : std::uint8_t {
+    flat,  ///< single Rayleigh tap
+    epa,   ///< Extended Pedestrian A, 410 ns spread (TS 36.101 B.2.1)
+    eva,   ///< Extended Vehicular A, 2510 ns
+    etu,   ///< Extended Typical Urban, 5000 ns
+};
+
+const char* to_string(FadingProfile p) noexcept;
+
+struct FadingTap {
+    float delay_ns;
+    float power_db;
+};
+
+/// The taps of `p`, first tap at delay 0.
+std::span<const FadingTap> fading_taps(FadingProfile p) noexcept;
+
+struct FadingConfig {
+    FadingProfile profile = FadingProfile::epa;
+    /// Maximum Doppler shift.
+    double doppler_hz = 5.0;
+    double sample_rate = 20e6;
+    /// Samples between updates of the tap gains; the default is one 802.11
+    /// OFDM symbol, far shorter than the coherence time at any of the
+    /// standard Doppler values.
+    std::size_t update_interval = 80;
+};
+
+/// Time-varying multipath Rayleigh channel (tapped delay line).
+///
+/// Each path of the profile is a band-limited fractional delay: its
+/// windowed-sinc interpolation filter is precomputed at construction, so
+/// per update the channel only forms the combined FIR as the sum of the
+/// path filters weighted by the current path gains. Paths fade
+/// independently with a Clarke/Jakes spectrum generated by a sum of
+/// sinusoids with random arrival angles and phases; the sinusoids are
+/// advanced by phasor rotation, not re-evaluated. Path powers are
+/// normalised so the channel has unit average gain.
+///
+/// The filters are causal, with no bulk delay added: the first path
+/// arrives undelayed, and the pre-cursor of a path that falls between
+/// samples is truncated (its filter renormalised to the path's power).
+/// Filter state carries over between process() calls; reset() starts an
+/// independent realisation.
+class FadingChannel {
+public:
+    /// Throws std::invalid_argument for an unknown profile, an invalid
+    /// rate, Doppler or update interval, or an `isa` not available on this
+    /// CPU.
+    FadingChannel(const FadingConfig& config, std::uint64_t seed, std::uint64_t stream);
+    FadingChannel(const FadingConfig& config, std::uint64_t seed, std::uint64_t stream, Isa isa);
+
+    /// Filter `in` into `out` (the same size; may be the same buffer).
+    void process(std::span<const cf32> in, std::span<cf32> out) noexcept;
+    /// The same on split samples, which the filter runs on natively; the
+    /// interleaved overload converts on the way in and out. Both give
+    /// identical output.
+    void process(ConstSplitSpan in, SplitSpan out) noexcept;
+
+    /// New realisation from `stream`: fresh angles and phases, time 0,
+    /// empty filter history.
+    void reset(std::uint64_t stream) noexcept;
+
+    /// Current combined impulse response, one tap per sample of delay.
+    std::span<const cf32> impulse_response() const noexcept { return taps_; }
+    const FadingConfig& config() const noexcept { return config_; }
+
+private:
+    static constexpr std::size_t kSinusoids = 16;
+    static constexpr std::size_t kHalfWidth = 8;  // sinc taps on either side
+
+    void update_taps() noexcept;
+    template <ComplexLayout L>
+    void filter(ConstComplexSpan<L> in, ComplexSpan<L> out) noexcept;
+
+    const kernels::ChannelKernels* kernels_;
+    FadingConfig config_;
+    std::uint64_t seed_;
+    std::size_t paths_;
+    std::size_t length_;  // combined FIR taps
+    std::vector<float> path_filters_;  // paths_ x length_, scaled by path amplitude
+    std::vector<std::complex<double>> phasors_;  // paths_ x kSinusoids, exp(j theta) now
+    std::vector<std::complex<double>> steps_;    // rotation per update
+    std::vector<cf32> taps_;     // current combined FIR
+    std::vector<float> history_;  // split re/im: length_ - 1 past inputs + one update
+    std::size_t until_update_ = 0;  // samples left with the current taps
+};
+
+}  // namespace dcomm
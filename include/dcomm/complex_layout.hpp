@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+/// Complex samples as cf32, re and im of each sample adjacent: the layout
+/// of FFT output, mapper output and sample streams.
+struct Interleaved {
+    static constexpr const char* name = "interleaved";
+};
+
+/// Complex samples as two float planes, all re values then all im values.
+/// A complex multiply is then four real multiplies on whole registers,
+/// with no shuffles to pair re and im lanes.
+struct Split {
+    static constexpr const char* name = "split";
+};
+
+template <class L>
+concept ComplexLayout = std::same_as<L, Interleaved> || std::same_as<L, Split>;
+
+/// Non-owning view of split complex samples; F is float or const float.
+template <class F>
+struct BasicSplitSpan {
+    F* re = nullptr;
+    F* im = nullptr;
+    std::size_t count = 0;
+
+    BasicSplitSpan() noexcept = default;
+    BasicSplitSpan(F* r, F* i, std::size_t n) noexcept : re(r), im(i), count(n) {}
+    /// SplitSpan converts to ConstSplitSpan, as std::span does.
+    template <class G>
+        requires(!std::same_as<G, F> && std::convertible_to<G*, F*>)
+    BasicSplitSpan(const BasicSplitSpan<G>& o) noexcept : re(o.re), im(o.im), count(o.count) {}
+
+    std::size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+    cf32 operator[](std::size_t i) const noexcept { return {re[i], im[i]}; }
+
+    BasicSplitSpan subspan(std::size_t offset, std::size_t n) const noexcept {
+        assert(offset + n <= count);
+        return {re + offset, im + offset, n};
+    }
+};
+
+using SplitSpan = BasicSplitSpan<float>;
+using ConstSplitSpan = BasicSplitSpan<const float>;
+
+/// View types of a layout, for code templated on it.
+template <ComplexLayout L>
+struct LayoutTraits;
+
+template <>
+struct LayoutTraits<Interleaved> {
+    using span = std::span<cf32>;
+    using const_span = std::span<const cf32>;
+};
+
+template <>
+struct LayoutTraits<Split> {
+    using span = SplitSpan;
+    using const_span = ConstSplitSpan;
+};
+
+template <ComplexLayout L>
+using ComplexSpan = typename LayoutTraits<L>::span;
+template <ComplexLayout L>
+using ConstComplexSpan = typename LayoutTraits<L>::const_span;
+
+/// Owning, cache-line aligned buffer of complex samples in layout L.
+///
+/// The layout is a template parameter, so a stage written against
+/// ComplexBuffer<L> and the kernels below is compiled for either one and
+/// nothing is decided per sample. Split planes are padded to a whole
+/// number of cache lines, so the im plane is aligned too.
+template <ComplexLayout L>
+class ComplexBuffer {
+public:
+    ComplexBuffer() = default;
+    explicit ComplexBuffer(std::size_t size)
+        : size_(size), stride_(std::same_as<L, Split> ? align_up(size, kCacheLine / sizeof(float))
+                                                      : size),
+          data_(make_aligned_array<float>(2 * stride_)) {}
+
+    std::size_t size() const noexcept { return size_; }
+
+    ComplexSpan<L> view() noexcept {
+        if constexpr (std::same_as<L, Split>) {
+            return {data_.get(), data_.get() + stride_, size_};
+        } else {
+            return {reinterpret_cast<cf32*>(data_.get()), size_};
+        }
+    }
+    ConstComplexSpan<L> view() const noexcept {
+        if constexpr (std::same_as<L, Split>) {
+            return {data_.get(), data_.get() + stride_, size_};
+        } else {
+            return {reinterpret_cast<const cf32*>(data_.get()), size_};
+        }
+    }
+
+    cf32 get(std::size_t i) const noexcept { return view()[i]; }
+    void set(std::size_t i, cf32 v) noexcept {
+        if constexpr (std::same_as<L, Split>) {
+            data_[i] = v.real();
+            data_[stride_ + i] = v.imag();
+        } else {
+            reinterpret_cast<cf32*>(data_.get())[i] = v;
+        }
+    }
+
+private:
+    std::size_t size_ = 0;
+    std::size_t stride_ = 0;  // floats from the re plane to the im plane
+    AlignedArray<float> data_;
+};
+
+// Bulk conversion at stage boundaries. Sizes must match. The same-layout
+// overloads copy, so code templated on both ends can always call
+// convert(). Conversion only moves floats, so every variant agrees.
+void convert(std::span<const cf32> in, SplitSpan out) noexcept;
+void convert(ConstSplitSpan in, std::span<cf32> out) noexcept;
+void convert(std::span<const cf32> in, std::span<cf32> out) noexcept;
+void convert(ConstSplitSpan in, SplitSpan out) noexcept;
+
+// Element-wise kernels in either layout. Outputs may alias inputs of the
+// same layout. Both layouts run the same arithmetic in the same order, so
+// results agree bit for bit across layouts as well as instruction sets.
+
+/// out[i] = a[i] * b[i].
+void multiply(std::span<const cf32> a, std::span<const cf32> b, std::span<cf32> out) noexcept;
+void multiply(ConstSplitSpan a, ConstSplitSpan b, SplitSpan out) noexcept;
+
+/// out[i] = a[i] * conj(b[i]).
+void multiply_conj(std::span<const cf32> a, std::span<const cf32> b,
+                   std::span<cf32> out) noexcept;
+void multiply_conj(ConstSplitSpan a, ConstSplitSpan b, SplitSpan out) noexcept;
+
+/// out[i] = |x[i]|^2.
+void magnitude_squared(std::span<const cf32> x, std::span<float> out) noexcept;
+void magnitude_squared(ConstSplitSpan x, std::span<float> out) noexcept;
+
+// The functions above run the kernels of active_isa(); these pick the
+// variant explicitly. `isa` must be isa_available().
+void convert(Isa isa, std::span<const cf32> in, SplitSpan out) noexcept;
+void convert(Isa isa, ConstSplitSpan in, std::span<cf32> out) noexcept;
+void multiply(Isa isa, std::span<const cf32> a, std::span<const cf32> b,
+              std::span<cf32> out) noexcept;
+void multiply(Isa isa, ConstSplitSpan a, ConstSplitSpan b, SplitSpan out) noexcept;
+void multiply_conj(Isa isa, std::span<const cf32> a, std::span<const cf32> b,
+                   std::span<cf32> out) noexcept;
+void multiply_conj(Isa isa, ConstSplitSpan a, ConstSplitSpan b, SplitSpan out) noexcept;
+void magnitude_squared(Isa isa, std::span<const cf32> x, std::span<float> out) noexcept;
+void magnitude_squared(Isa isa, ConstSplitSpan x, std::span<float> out) noexcept;
+
+}  // namespace dcomm
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "dcomm/bits.hpp"
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/phy_config.hpp"
+#include "dcomm/stage.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm::kernels {
+struct ViterbiKernels;
+}
+
+namespace dcomm {
+
+/// Industry-standard K=7 rate-1/2 convolutional code (g0 = 133, g1 = 171
+/// octal) used by 802.11a/g/n. Codewords are zero-terminated: the encoder
+/// appends `kConvMemory` zero tail bits and starts every block in state 0.
+inline constexpr unsigned kConvMemory = 6;
+inline constexpr unsigned kConvStates = 1u << kConvMemory;
+inline constexpr std::uint8_t kConvPolyA = 0133;
+inline constexpr std::uint8_t kConvPolyB = 0171;
+
+/// Number of coded bits for `info_bits` information bits, tail included.
+constexpr std::size_t conv_coded_bits(std::size_t info_bits) noexcept {
+    return 2 * (info_bits + kConvMemory);
+}
+
+/// Encode unpacked bits. `coded` must hold conv_coded_bits(info.size()).
+void conv_encode(std::span<const std::uint8_t> info,
+                 std::span<std::uint8_t> coded) noexcept;
+/// Encode packed bits, 64 per step: each output stream is an XOR of the
+/// input word shifted by the generator's taps, and the two are zipped into
+/// A0 B0 A1 B1 ... coded.size() == conv_coded_bits(info.size()).
+void conv_encode(ConstBitSpan info, BitSpan coded) noexcept;
+
+/// Length of a mother codeword of `mother_bits` bits after puncturing to
+/// `rate` with the 802.11 patterns (2/3 drops every second B bit, 3/4 keeps
+/// A1 B1 A2 B3 of every three pairs).
+std::size_t punctured_bits(CodeRate rate, std::size_t mother_bits) noexcept;
+
+/// Puncture `coded` to `rate`. `out` must hold punctured_bits(rate,
+/// coded.size()) bits and may alias `coded`.
+void puncture(CodeRate rate, std::span<const std::uint8_t> coded,
+              std::span<std::uint8_t> out) noexcept;
+/// The same on packed bits, one select_bits() step per word; out.size() ==
+/// punctured_bits(rate, coded.size()).
+void puncture(CodeRate rate, ConstBitSpan coded, BitSpan out) noexcept;
+
+/// Soft-decision Viterbi decoder for terminated K=7 codewords.
+///
+/// Input LLRs follow the library convention (positive means bit 0); punctured
+/// positions are restored as erasures. LLRs are scaled to 8-bit soft values
+/// and the trellis runs on int16 metrics in a SIMD add-compare-select kernel
+/// (all 64 states per instruction sequence), `kWindow` stages at a time.
+/// Survivors are kept for the last kTracebackDepth + kWindow stages only:
+/// once that much is buffered the oldest kWindow bits are traced back from
+/// the best state and released, so memory is fixed and codewords may be any
+/// length. Decoding never allocates; one decoder per thread.
+///
+/// begin() / feed() / finish() run the same decoder on a codeword that
+/// arrives in pieces: every complete window is decoded as soon as its LLRs
+/// are in, and feed() reports how many leading bits are already final, so
+/// a receiver can act on the start of a frame before the rest arrives.
+class ViterbiDecoder {
+public:
+    static constexpr std::size_t kWindow = 96;
+    static constexpr std::size_t kTracebackDepth = 96;
+
+    explicit ViterbiDecoder(Isa isa = active_isa());
+
+    /// Decode `llrs`, punctured_bits(rate, conv_coded_bits(info.size()))
+    /// values, into info.size() bits.
+    void decode(std::span<const float> llrs, std::span<std::uint8_t> info,
+                CodeRate rate = CodeRate::r1_2) noexcept;
+
+    /// Soft-value scale decode() applies to `llrs`: the trellis works on a
+    /// fixed mean magnitude, estimated from a sample of them.
+    static float soft_scale(std::span<const float> llrs) noexcept;
+
+    /// Start a codeword of `info_bits` bits punctured to `rate`, its LLRs
+    /// multiplied by `scale` (e.g. soft_scale() of the first ones).
+    void begin(std::size_t info_bits, CodeRate rate, float scale) noexcept;
+    /// The next LLRs of the codeword, in order and in pieces of any size.
+    /// Released bits are written to `info` (info_bits long); returns how
+    /// many leading bits of it are final.
+    std::size_t feed(std::span<const float> llrs, std::span<std::uint8_t> info) noexcept;
+    /// After the last LLR: trace back the remaining bits into `info`.
+    void finish(std::span<std::uint8_t> info) noexcept;
+
+private:
+    static constexpr std::size_t kRing = kTracebackDepth + kWindow;
+    static_assert(kRing % kWindow == 0, "chunks must not wrap the survivor ring");
+
+    /// Trace back from `state` at stage `end`, writing the bits of stages
+    /// [begin, stop) into `info`.
+    void traceback(unsigned state, std::size_t end, std::size_t begin, std::size_t stop,
+                   std::span<std::uint8_t> info) const noexcept;
+
+    const kernels::ViterbiKernels* kernels_;
+    alignas(kCacheLine) std::array<std::int16_t, kConvStates> metrics_;
+    alignas(kCacheLine) std::array<std::int16_t, 2 * kWindow> soft_;
+    alignas(kCacheLine) std::array<float, 2 * kWindow> depunctured_;
+    std::array<std::uint64_t, kRing> survivors_;
+
+    // Codeword in progress.
+    CodeRate rate_ = CodeRate::r1_2;
+    float scale_ = 1.0f;
+    std::size_t n_info_ = 0;
+    std::size_t steps_ = 0;
+    unsigned phase_ = 0;      // position in the puncturing pattern
+    std::size_t filled_ = 0;  // values in depunctured_
+    std::size_t done_ = 0;    // stages through the trellis
+    std::size_t out_ = 0;     // bits released so far
+};
+
+/// Convolutional encoder stage: N packed information bits in, 2(N + 6)
+/// coded bits punctured to `rate` out, packed.
+class ConvEncoderStage final : public Stage<std::uint64_t, std::uint64_t> {
+public:
+    ConvEncoderStage(std::size_t info_bits, CodeRate rate, std::size_t pool_depth);
+
+    BufferView<std::uint64_t> process(BufferView<std::uint64_t> in) override;
+    const char* name() const noexcept override { return "conv_encoder"; }
+
+private:
+    std::size_t info_bits_;
+    CodeRate rate_;
+    BufferPool<std::uint64_t> pool_;
+};
+
+/// Viterbi decoder stage: coded-bit LLRs in, information bits out.
+class ViterbiStage final : public Stage<float, std::uint8_t> {
+public:
+    ViterbiStage(std::size_t info_bits, CodeRate rate, std::size_t pool_depth);
+
+    BufferView<std::uint8_t> process(BufferView<float> in) override;
+    const char* name() const noexcept override { return "viterbi"; }
+
+private:
+    std::size_t info_bits_;
+    CodeRate rate_;
+    ViterbiDecoder decoder_;
+    BufferPool<std::uint8_t> pool_;
+};
+
+}  // namespace dcomm
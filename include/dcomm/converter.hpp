@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <thread>
+
+#include "dcomm/buffer.hpp"
+#include "dcomm/spsc_ring.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+/// Ring of sample blocks at the DAC/ADC boundary.
+using SampleRing = SpscRing<BufferView<cf32>>;
+
+/// Simulated DAC: a thread that consumes sample blocks from a ring at the
+/// converter rate.
+///
+/// With a sample rate set, the thread wakes once per block period and takes
+/// one block; if none is queued the DAC has nothing to play and the miss is
+/// counted as an underrun (the ring's counter). With a rate of 0 it drains
+/// blocks as fast as they arrive, for offline runs. Each block is handed to
+/// `handler`, e.g. to loop it back into an AdcSource ring, and released.
+class DacSink {
+public:
+    using Handler = std::function<void(BufferView<cf32>)>;
+
+    DacSink(SampleRing& ring, double sample_rate, std::size_t samples_per_block,
+            Handler handler = {});
+    ~DacSink();
+
+    DacSink(const DacSink&) = delete;
+    DacSink& operator=(const DacSink&) = delete;
+
+    void start();
+    /// Stop and join the thread; blocks still queued stay in the ring.
+    void stop();
+
+    /// Blocks played so far.
+    std::uint64_t blocks() const noexcept { return blocks_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    SampleRing* ring_;
+    double block_period_s_;  // 0: free-running
+    Handler handler_;
+    std::atomic<bool> stop_{false};
+    std::atomic<std::uint64_t> blocks_{0};
+    std::thread thread_;
+};
+
+/// Simulated ADC: a thread that produces sample blocks into a ring at the
+/// converter rate.
+///
+/// Blocks come from the source's own pool and are filled by `fill`, which
+/// returns false once the stream has ended. With a sample rate set, a block
+/// that cannot be queued because the ring is full is dropped and counted as
+/// an overrun, as is a period in which no pooled buffer was free (the
+/// consumer is holding on to all of them). With a rate of 0 the thread
+/// waits instead, for offline runs; only a block already filled when stop()
+/// interrupts the wait for ring space is then dropped, and counted.
+class AdcSource {
+public:
+    using Fill = std::function<bool(std::span<cf32>)>;
+
+    AdcSource(SampleRing& ring, std::size_t pool_depth, double sample_rate,
+              std::size_t samples_per_block, Fill fill);
+    ~AdcSource();
+
+    AdcSource(const AdcSource&) = delete;
+    AdcSource& operator=(const AdcSource&) = delete;
+
+    void start();
+    void stop();
+
+    /// True once `fill` reported the end of the stream.
+    bool finished() const noexcept { return finished_.load(std::memory_order_acquire); }
+    /// Blocks queued so far.
+    std::uint64_t blocks() const noexcept { return blocks_.load(std::memory_order_relaxed); }
+    /// Periods lost because no pooled buffer was free.
+    std::uint64_t pool_overruns() const noexcept {
+        return pool_overruns_.load(std::memory_order_relaxed);
+    }
+    /// Filled blocks lost because the ring was full.
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    SampleRing* ring_;
+    BufferPool<cf32> pool_;
+    double block_period_s_;
+    Fill fill_;
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> finished_{false};
+    std::atomic<std::uint64_t> blocks_{0};
+    std::atomic<std::uint64_t> pool_overruns_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::thread thread_;
+};
+
+}  // namespace dcomm
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dcomm/iq_file.hpp"
+#include "dcomm/sample.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+/// Where converter samples come from and go to: the hardware side of a
+/// DacStream / AdcStream, one whole block per call.
+///
+/// The streams call write() and read() from their transfer thread only,
+/// so a backend need not be thread-safe, but it may be shared by one
+/// DacStream and one AdcStream, each using one direction.
+class ConverterBackend {
+public:
+    virtual ~ConverterBackend() = default;
+
+    /// Send one block towards the DAC. Returns false once the far end is
+    /// gone.
+    virtual bool write(std::span<const cf32> block) = 0;
+    /// Fill one block from the ADC. Returns false at the end of the
+    /// stream; `block` is then unspecified.
+    virtual bool read(std::span<cf32> block) = 0;
+};
+
+/// Backend over IQ recordings (iq_file.hpp): the ADC side replays a SigMF
+/// recording, the DAC side captures into one. Either path may be empty,
+/// leaving that direction unused (read() then ends at once, write() fails).
+/// The last, partial block of the recording is zero-padded.
+class FileBackend final : public ConverterBackend {
+public:
+    /// `read_path` is a .sigmf-data file; `write_meta` describes the
+    /// capture written to `write_path`. Throws as IqFileSource / IqFileSink.
+    FileBackend(const std::string& read_path, const std::string& write_path,
+                SigmfMeta write_meta = {});
+    /// Closes the capture; errors are only reported by an explicit close().
+    ~FileBackend() override;
+
+    bool write(std::span<const cf32> block) override;
+    bool read(std::span<cf32> block) override;
+
+    /// Flush the capture and write its metadata.
+    void close();
+
+private:
+    std::unique_ptr<IqFileSource> source_;
+    std::unique_ptr<IqFileSink> sink_;
+};
+
+struct UdpConfig {
+    /// Local port read() receives on; 0 leaves the ADC side unused.
+    std::uint16_t listen_port = 0;
+    /// Destination of write(), an IPv4 address; empty leaves the DAC side
+    /// unused.
+    std::string remote_host;
+    std::uint16_t remote_port = 0;
+    /// Wire format of the samples, as GNU Radio's UDP blocks carry them.
+    IqFormat format = IqFormat::cf32;
+    /// Payload per datagram; the default fits an Ethernet MTU.
+    std::size_t datagram_bytes = 1472;
+    /// read() gives up and reports the end of the stream after this long
+    /// without a datagram; 0 waits forever.
+    std::chrono::milliseconds receive_timeout{1000};
+};
+
+/// Backend exchanging raw interleaved samples over UDP with a software
+/// radio (GNU Radio, SoapyRemote-style bridges).
+///
+/// Datagrams carry whole samples in `format`, no header, so a lost
+/// datagram shifts the stream rather than being detected; blocks and
+/// datagrams need not line up. The socket buffer is enlarged to hold a
+/// few blocks, since the receive side only drains it once per block.
+/// Narrowing to ci16 / ci8 saturates and counts into saturation().
+class UdpBackend final : public ConverterBackend {
+public:
+    /// Throws std::system_error if the socket cannot be set up and
+    /// std::invalid_argument for a bad address or datagram size.
+    explicit UdpBackend(const UdpConfig& config);
+    ~UdpBackend() override;
+
+    UdpBackend(const UdpBackend&) = delete;
+    UdpBackend& operator=(const UdpBackend&) = delete;
+
+    bool write(std::span<const cf32> block) override;
+    bool read(std::span<cf32> block) override;
+
+    const SaturationStats& saturation() const noexcept { return saturation_; }
+
+private:
+    void close_sockets() noexcept;
+
+    UdpConfig config_;
+    int rx_fd_ = -1;
+    int tx_fd_ = -1;
+    std::vector<std::byte> datagram_;
+    std::vector<std::byte> outgoing_;
+    std::size_t pending_ = 0;  // received bytes of datagram_ not yet read
+    std::size_t consumed_ = 0;
+    SaturationStats saturation_;
+};
+
+struct SharedMemoryConfig {
+    /// POSIX shared memory names ("/dcomm.tx"); empty leaves a direction
+    /// unused. write() feeds `tx_name`, read() drains `rx_name`, so two
+    /// processes pair up by swapping the names.
+    std::string tx_name;
+    std::string rx_name;
+    /// Ring capacity in samples, rounded up to a power of two. Only the
+    /// side creating a ring uses it; the other takes the ring's own.
+    std::size_t capacity = std::size_t(1) << 16;
+    /// Samples per write() / read() block, the streams'
+    /// StreamConfig::samples_per_block. A ring must hold at least one
+    /// block: read() waits for a whole one and write() drops what does not
+    /// fit, so a smaller ring would hang the reader and drop every block.
+    std::size_t samples_per_block = 0;
+    IqFormat format = IqFormat::cf32;
+    /// Create the rings (and unlink them on destruction) rather than
+    /// attach to existing ones.
+    bool create = true;
+};
+
+/// Backend over lock-free single-producer / single-consumer sample rings
+/// in POSIX shared memory, for a software radio in another process.
+///
+/// Each ring holds a small header (capacity, format, head and tail
+/// counters on separate cache lines, a closed flag) followed by the
+/// samples. write() never waits: a block that does not fit is dropped and
+/// counted, as a converter would lose it. read() waits for a whole block,
+/// so the peer paces the ADC side, and ends when the peer has closed the
+/// ring and it has drained. Blocks are at most samples_per_block long; a
+/// longer one fails the call rather than never fitting. The writer closes
+/// its ring on destruction.
+class SharedMemoryBackend final : public ConverterBackend {
+public:
+    /// Throws std::system_error if a ring cannot be created or attached and
+    /// std::invalid_argument if samples_per_block is 0, a ring (created or
+    /// attached) holds fewer samples than a block, or an attached ring's
+    /// format differs.
+    explicit SharedMemoryBackend(const SharedMemoryConfig& config);
+    ~SharedMemoryBackend() override;
+
+    SharedMemoryBackend(const SharedMemoryBackend&) = delete;
+    SharedMemoryBackend& operator=(const SharedMemoryBackend&) = delete;
+
+    bool write(std::span<const cf32> block) override;
+    bool read(std::span<cf32> block) override;
+
+    /// Blocks write() dropped because the peer had not drained the ring.
+    std::uint64_t dropped() const noexcept { return dropped_; }
+    const SaturationStats& saturation() const noexcept { return saturation_; }
+
+    struct Ring;
+
+private:
+    struct Mapping {
+        Ring* ring = nullptr;
+        std::size_t bytes = 0;
+        std::string name;
+    };
+    Mapping map(const std::string& name);
+    void unmap(Mapping& m) noexcept;
+
+    SharedMemoryConfig config_;
+    Mapping tx_;
+    Mapping rx_;
+    std::uint64_t dropped_ = 0;
+    SaturationStats saturation_;
+};
+
+struct StreamConfig {
+    /// Converter sample rate in Hz; 0 runs free, waiting on the other side
+    /// instead of timing it, for offline runs.
+    double sample_rate = 0.0;
+    std::size_t samples_per_block = 0;
+    /// Transfer buffers: 2 for double, 3 for triple buffering.
+    std::size_t buffers = 2;
+    /// AdcStream only: pace reads from the stream's own clock, one per
+    /// block period. Turn off when the backend already blocks at the
+    /// converter rate (a radio feeding UDP or shared memory); deadlines are
+    /// then taken from the moment each read completes. A DacStream always
+    /// paces itself, since no backend holds back a write.
+    bool paced = true;
+};
+
+/// Deadline record of a DacStream or AdcStream.
+///
+/// Budgets are the processing time left when a block was handed over: for
+/// the DAC, how long a committed block waited before its transfer; for the
+/// ADC, how long before its buffer was due back for refilling when it was
+/// released, negative if after. A DAC underrun has no committed block and
+/// is not in the budget figures. All durations are zero when running free.
+struct DeadlineStats {
+    std::uint64_t blocks = 0;  ///< blocks transferred
+    std::uint64_t late = 0;    ///< DAC underruns (silence sent) / ADC drops or stalls
+    std::chrono::nanoseconds period{0};
+    std::chrono::nanoseconds min_budget{0};
+    std::chrono::nanoseconds mean_budget{0};
+};
+
+/// DMA-style DAC output over a ConverterBackend.
+///
+/// The stream owns `buffers` transfer buffers. The application fills them
+/// in turn (acquire(), commit()); a transfer thread, standing in for the
+/// DMA engine, sends one per block period in order and hands it back.
+/// With double buffering the chain therefore has one period to produce the
+/// next block while the previous one is on the wire, with triple buffering
+/// two. A period whose buffer is not committed in time is an underrun:
+/// silence goes out, the block is counted late and follows one period
+/// later. Buffers may be committed before start() to prime the stream;
+/// the first transfer is one period after start().
+class DacStream {
+public:
+    /// Throws std::invalid_argument for a bad rate, block size or fewer
+    /// than two buffers.
+    DacStream(ConverterBackend& backend, const StreamConfig& config);
+    ~DacStream();
+
+    DacStream(const DacStream&) = delete;
+    DacStream& operator=(const DacStream&) = delete;
+
+    void start();
+    /// Send every committed block, then stop the thread.
+    void stop();
+
+    /// The next buffer to fill, waiting until the transfer thread has
+    /// handed it back. Empty once the backend has failed.
+    std::span<cf32> acquire();
+    /// Queue the buffer from acquire() for transfer.
+    void commit() noexcept;
+
+    /// Time left until the transfer of the buffer from acquire() is due;
+    /// negative when it is already late. Zero when running free.
+    std::chrono::nanoseconds budget_left() const noexcept;
+
+    DeadlineStats deadline_stats() const noexcept;
+
+private:
+    void run();
+
+    ConverterBackend* backend_;
+    StreamConfig config_;
+    std::chrono::nanoseconds period_;
+    AlignedArray<cf32> memory_;
+    std::vector<std::atomic<std::int64_t>> committed_at_;  // steady-clock ns per buffer
+    std::atomic<std::uint64_t> committed_{0};
+    std::atomic<std::uint64_t> sent_{0};
+    std::atomic<std::int64_t> next_transfer_{0};
+    std::atomic<std::uint64_t> late_{0};
+    std::atomic<std::int64_t> budget_sum_{0};
+    std::atomic<std::int64_t> budget_min_{0};
+    std::atomic<bool> failed_{false};
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
+
+/// DMA-style ADC input over a ConverterBackend.
+///
+/// A transfer thread reads one block per period into the next of
+/// `buffers` transfer buffers; the application takes them in order
+/// (acquire(), release()). A buffer must be released before the transfer
+/// thread comes back to refill it, `buffers - 1` periods after it was
+/// filled. When paced, a block read while the application still holds
+/// every buffer is dropped and counted late. Unpaced, the thread instead
+/// waits for a buffer, leaving the samples queued in the backend, and
+/// counts the stall as late; the backend's own losses show up there.
+class AdcStream {
+public:
+    /// Throws std::invalid_argument for a bad rate, block size or fewer
+    /// than two buffers.
+    AdcStream(ConverterBackend& backend, const StreamConfig& config);
+    ~AdcStream();
+
+    AdcStream(const AdcStream&) = delete;
+    AdcStream& operator=(const AdcStream&) = delete;
+
+    void start();
+    void stop();
+
+    /// The next filled buffer, waiting for the transfer thread. Empty once
+    /// the stream has ended and every block was taken.
+    std::span<const cf32> acquire();
+    /// Hand the buffer from acquire() back for refilling.
+    void release() noexcept;
+
+    /// Time left until the buffer from acquire() is due back; negative
+    /// when it is already late. Zero when running free.
+    std::chrono::nanoseconds budget_left() const noexcept;
+
+    /// True once the backend reported the end of the stream.
+    bool finished() const noexcept { return finished_.load(std::memory_order_acquire); }
+
+    DeadlineStats deadline_stats() const noexcept;
+
+private:
+    void run();
+
+    ConverterBackend* backend_;
+    StreamConfig config_;
+    std::chrono::nanoseconds period_;
+    AlignedArray<cf32> memory_;
+    AlignedArray<cf32> scratch_;  // target of dropped blocks
+    std::vector<std::atomic<std::int64_t>> filled_at_;  // steady-clock ns per buffer
+    std::atomic<std::uint64_t> filled_{0};
+    std::atomic<std::uint64_t> released_{0};
+    std::atomic<std::uint64_t> late_{0};
+    std::atomic<std::int64_t> budget_sum_{0};
+    std::atomic<std::int64_t> budget_min_{0};
+    std::atomic<bool> finished_{false};
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
+
+}  // namespace dcomm
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace dcomm {
+
+/// Instruction-set level of a kernel variant.
+enum class Isa : std::uint8_t {
+    scalar,
+    avx2,
+    avx512,  ///< AVX-512 F + BW + VL + DQ
+    neon,
+};
+
+const char* to_string(Isa isa) noexcept;
+
+/// CPU capabilities, probed once during static initialisation.
+struct CpuFeatures {
+    bool avx2 = false;
+    bool avx512 = false;  ///< F, BW, VL and DQ all present
+    bool bmi2 = false;
+    bool pclmul = false;
+    bool vpclmul = false;
+    bool neon = false;
+    bool pmull = false;
+};
+
+const CpuFeatures& cpu_features() noexcept;
+
+/// True if kernels for `isa` were compiled in and the CPU runs them.
+bool isa_available(Isa isa) noexcept;
+
+/// ISA used by dispatched kernels: the best available one, or the level
+/// named by the DCOMM_ISA environment variable (scalar, avx2, avx512, neon)
+/// when that is available. Fixed at startup.
+Isa active_isa() noexcept;
+
+}  // namespace dcomm
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "dcomm/cpu_features.hpp"
+
+namespace dcomm {
+
+namespace kernels {
+struct CrcKernels;
+}
+
+/// LTE transport-block and codeblock CRCs (TS 36.212 5.1.1), generator
+/// polynomials without the leading x^24 term.
+inline constexpr std::uint32_t kCrc24aPoly = 0x864cfb;
+inline constexpr std::uint32_t kCrc24bPoly = 0x800063;
+/// NR polar-coded control CRC (TS 38.212 5.1).
+inline constexpr std::uint32_t kCrc24cPoly = 0xb2b117;
+/// gCRC16 of TS 36.212 / 38.212, x^16 + x^12 + x^5 + 1.
+inline constexpr std::uint32_t kCrc16Poly = 0x1021;
+
+/// CRC-24 of unpacked bits (one bit per byte, first bit is the highest
+/// power), zero initial state and no final inversion. A block with its CRC
+/// appended MSB first therefore yields 0. The CRC-24A/B/C generators run
+/// whole bytes through Crc<>; any other one goes bit by bit.
+std::uint32_t crc24(std::uint32_t poly, std::span<const std::uint8_t> bits) noexcept;
+
+inline std::uint32_t crc24a(std::span<const std::uint8_t> bits) noexcept {
+    return crc24(kCrc24aPoly, bits);
+}
+inline std::uint32_t crc24b(std::span<const std::uint8_t> bits) noexcept {
+    return crc24(kCrc24bPoly, bits);
+}
+
+/// Compute the CRC of the first bits.size() - 24 bits and write it MSB
+/// first into the last 24.
+void crc24_attach(std::uint32_t poly, std::span<std::uint8_t> bits) noexcept;
+
+/// A CRC in the usual parametrised model: `width` register bits (8..32),
+/// generator `poly` without its x^width term, register preset `init` and
+/// `xorout` applied to the result. A `reflected` CRC takes the bits of each
+/// byte LSB first (802.11); otherwise MSB first (3GPP).
+struct CrcSpec {
+    unsigned width;
+    std::uint32_t poly;
+    std::uint32_t init = 0;
+    std::uint32_t xorout = 0;
+    bool reflected = false;
+};
+
+inline constexpr CrcSpec kCrc24a{24, kCrc24aPoly};
+inline constexpr CrcSpec kCrc24b{24, kCrc24bPoly};
+inline constexpr CrcSpec kCrc24c{24, kCrc24cPoly};
+inline constexpr CrcSpec kCrc16{16, kCrc16Poly};
+/// 802.11 FCS (IEEE 802.3 CRC-32), sent least significant byte first.
+inline constexpr CrcSpec kCrc32{32, 0x04c11db7, 0xffffffff, 0xffffffff, true};
+
+/// CRC of packed bytes.
+///
+/// The tables and folding multipliers are constexpr functions of Spec,
+/// built at compile time. Messages of 64 bytes and more fold 128-bit
+/// blocks with carry-less multiplies (PCLMULQDQ, VPCLMULQDQ on AVX-512,
+/// PMULL); shorter ones and CPUs without them use slicing-by-8 tables.
+/// Every variant gives the same result. As with crc24(), a 3GPP block with
+/// its CRC appended MSB first yields 0.
+template <CrcSpec Spec>
+class Crc {
+public:
+    static_assert(Spec.width >= 8 && Spec.width <= 32, "CRC width must be 8..32");
+
+    Crc() noexcept;
+    /// Run the `isa` variant; isa must be isa_available(). Without the
+    /// carry-less multiply the x86 and NEON variants use the tables.
+    explicit Crc(Isa isa) noexcept;
+
+    /// Append bytes to the message.
+    Crc& update(std::span<const std::uint8_t> bytes) noexcept;
+    /// CRC of the message so far.
+    std::uint32_t value() const noexcept;
+    /// Start a new message.
+    void reset() noexcept;
+
+    /// CRC of `bytes` with the kernels of active_isa().
+    static std::uint32_t compute(std::span<const std::uint8_t> bytes) noexcept;
+
+private:
+    const kernels::CrcKernels* kernels_;
+    std::uint32_t reg_;  // 32-bit register, see crc_kernels.hpp
+};
+
+using Crc24a = Crc<kCrc24a>;
+using Crc24b = Crc<kCrc24b>;
+using Crc24c = Crc<kCrc24c>;
+using Crc16 = Crc<kCrc16>;
+using Crc32 = Crc<kCrc32>;
+
+extern template class Crc<kCrc24a>;
+extern template class Crc<kCrc24b>;
+extern template class Crc<kCrc24c>;
+extern template class Crc<kCrc16>;
+extern template class Crc<kCrc32>;
+
+}  // namespace dcomm
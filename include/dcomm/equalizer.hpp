@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "dcomm/phy_config.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+/// Pilot-aided one-tap equaliser of the 802.11 data subcarriers.
+///
+/// estimate() takes the FFT output of the OFDM symbols of one block, in FFT
+/// bin order and `stride` samples apart. It strips the pilot polarity,
+/// averages each pilot's least-squares estimate over the block (the channel
+/// is taken to be constant within a block), interpolates linearly across
+/// subcarriers, extrapolating at the band edges, and forms zero-forcing
+/// weights conj(H) / |H|^2 for every data subcarrier. apply() then costs
+/// one complex multiply per subcarrier. Because the weights are derived
+/// from the received pilots they also absorb the FFT gain, so the output is
+/// at unit level without a separate Rx scale.
+///
+/// W is the working sample type, cf32 or ci16. In fixed point the pilots
+/// are accumulated in 32 bits, interpolated with Q14 weights, and the ZF
+/// weights are int16 sharing one block exponent chosen so that no weight
+/// exceeds 2^14 and every product fits in 32 bits. Outputs are at
+/// SampleTraits<ci16>::unit and saturate.
+template <class W>
+class PilotEqualizer {
+public:
+    static constexpr std::size_t kData = PhyConfig::data_subcarriers;
+
+    /// `first_symbol` is the pilot polarity index of the first symbol.
+    void estimate(const W* bins, std::size_t count, std::size_t stride,
+                  std::size_t first_symbol) noexcept;
+
+    /// Equalise the data subcarriers of the symbol whose bins start at
+    /// `bins` into `out` (kData values). Clipped components are added to
+    /// `saturated` (fixed point only).
+    void apply(const W* bins, W* out, std::uint64_t& saturated) const noexcept;
+
+    /// Channel estimate of each data subcarrier from the last estimate().
+    std::span<const W, kData> channel() const noexcept { return h_; }
+
+private:
+    std::array<W, kData> h_{};
+    std::array<W, kData> w_{};
+    unsigned shift_ = 0;  // fixed point: w_ = ZF weights * 2^shift_
+};
+
+extern template class PilotEqualizer<cf32>;
+extern template class PilotEqualizer<ci16>;
+
+}  // namespace dcomm
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dcomm {
+
+/// Queue a coroutine waits in on an Executor; higher ones are resumed
+/// first, each queue in FIFO order.
+enum class Priority : std::uint8_t {
+    high,
+    normal,
+    low,
+};
+
+/// Worker threads resuming C++20 coroutines.
+///
+/// A coroutine moves onto the pool with `co_await executor.schedule(p)`:
+/// it is suspended, queued at priority `p` and resumed by the next free
+/// worker, which always takes the highest non-empty queue. Suspending
+/// again is how a coroutine lets more urgent work ahead of its next step.
+/// Coroutines still queued when the executor is destroyed are destroyed
+/// without being resumed.
+class Executor {
+public:
+    /// `workers` = 0 uses std::thread::hardware_concurrency().
+    explicit Executor(std::size_t workers = 0);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    std::size_t size() const noexcept { return threads_.size(); }
+
+    class ScheduleAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) const { executor_.post(h, priority_); }
+        void await_resume() const noexcept {}
+
+    private:
+        friend class Executor;
+        ScheduleAwaiter(Executor& e, Priority p) noexcept : executor_(e), priority_(p) {}
+        Executor& executor_;
+        Priority priority_;
+    };
+
+    /// Awaitable that resumes the coroutine on a worker.
+    ScheduleAwaiter schedule(Priority p = Priority::normal) noexcept { return {*this, p}; }
+
+    /// Queue `h` to be resumed on a worker.
+    void post(std::coroutine_handle<> h, Priority p);
+
+    /// Index < size() of the calling worker thread, or size() on any
+    /// other thread; for per-worker scratch state.
+    std::size_t current_worker() const noexcept;
+
+private:
+    void worker_loop(std::size_t id);
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::array<std::deque<std::coroutine_handle<>>, 3> queues_;  // by Priority
+    bool stop_ = false;
+};
+
+/// Return type of a coroutine that is started and not waited for: it runs
+/// on the caller up to its first suspension and frees its frame when it
+/// finishes. An escaping exception terminates the program.
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+}  // namespace dcomm
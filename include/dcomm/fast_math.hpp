@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+/// Table and polynomial replacements for the libm calls of per-sample DSP
+/// loops. Every function is deterministic and bit-exact across
+/// instruction sets. The error bounds below are absolute, measured against
+/// libm in double over the phase word and over dense argument grids, and
+/// checked by the golden tests.
+
+/// 32-bit NCO phase word of `cycles`, the fractional part of a turn
+/// (negative values wrap), rounded to 2^-32 of a turn.
+std::uint32_t nco_phase(double cycles) noexcept;
+
+/// cos and sin of 2 pi phase / 2^32, from a 1024-entry table turned by
+/// the residual angle to second order. |error| <= 1.2e-7.
+void nco_sincos(std::uint32_t phase, float& c, float& s) noexcept;
+
+/// Mix with a numerically controlled oscillator: out[k] = in[k] * exp(j 2 pi
+/// (phase + k step) / 2^32). The phase accumulates exactly in integers, so
+/// unlike a recursively rotated phasor it never drifts and needs no
+/// re-seeding; the oscillator itself is as accurate as nco_sincos(). `out`
+/// may be `in`. Sizes must match.
+void nco_mix(std::span<const cf32> in, std::uint32_t phase, std::uint32_t step,
+             std::span<cf32> out) noexcept;
+void nco_mix(Isa isa, std::span<const cf32> in, std::uint32_t phase, std::uint32_t step,
+             std::span<cf32> out) noexcept;
+
+/// atan2(y, x) in radians from the Cephes atanf polynomial after octant
+/// folding; one division. |error| <= 3e-7; atan2(0, 0) = 0 and the
+/// sign of a zero y is ignored.
+float fast_atan2(float y, float x) noexcept;
+
+/// Phase angle of each sample, fast_atan2(im, re). Sizes must match.
+void fast_angle(std::span<const cf32> in, std::span<float> out) noexcept;
+void fast_angle(Isa isa, std::span<const cf32> in, std::span<float> out) noexcept;
+
+/// Jacobian logarithm correction log(1 + exp(-|d|)) by linear
+/// interpolation in a 16-per-unit table over [0, 10], 0 beyond.
+/// |error| <= 1.3e-4.
+float jacobian_log(float d) noexcept;
+
+/// max*(a, b) = log(exp(a) + exp(b)) = max(a, b) + jacobian_log(a - b),
+/// the exact log-MAP combination that max-log drops the correction of.
+inline float max_star(float a, float b) noexcept {
+    return (a > b ? a : b) + jacobian_log(a - b);
+}
+
+}  // namespace dcomm
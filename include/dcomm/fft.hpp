@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+namespace kernels {
+struct FftKernels;
+}
+
+/// Precomputed in-place FFT of one power-of-two size.
+///
+/// The transform is a decimation-in-frequency radix-4 pipeline, preceded by
+/// one radix-2 pass when log2(N) is odd, followed by a digit-reversal
+/// permutation stored as a precomputed swap list. Twiddles for both
+/// directions and both sample formats are generated by the constructor;
+/// afterwards the plan is immutable and may be shared between threads.
+///
+/// Passes run breadth-first only while a sub-transform is larger than
+/// kBlockPoints; below that each block is finished depth-first while it is
+/// still in L1. Float transforms are unscaled in both directions. Q15
+/// transforms halve the data at every butterfly level and so return
+/// DFT / N (forward) and IDFT / N (inverse), which cannot overflow.
+class FftPlan {
+public:
+    static constexpr std::size_t kMaxSize = std::size_t(1) << 16;
+    static constexpr std::size_t kBlockPoints = 2048;
+
+    explicit FftPlan(std::size_t n, Isa isa = active_isa());
+    ~FftPlan();
+
+    FftPlan(FftPlan&&) noexcept;
+    FftPlan& operator=(FftPlan&&) noexcept;
+
+    /// Shared plan for size `n`, built on first request. Thread-safe.
+    static const FftPlan& get(std::size_t n);
+
+    std::size_t size() const noexcept { return n_; }
+    Isa isa() const noexcept { return isa_; }
+
+    void forward(std::span<cf32> x) const noexcept { transform(x.data(), false); }
+    void inverse(std::span<cf32> x) const noexcept { transform(x.data(), true); }
+    void forward(std::span<ci16> x) const noexcept { transform(x.data(), false); }
+    void inverse(std::span<ci16> x) const noexcept { transform(x.data(), true); }
+
+    /// Transform `count` blocks of size() points whose starts are `stride`
+    /// elements apart, e.g. all OFDM symbols of a slot with their cyclic
+    /// prefixes interleaved (stride = N + CP).
+    void forward_batch(cf32* x, std::size_t count, std::size_t stride) const noexcept;
+    void inverse_batch(cf32* x, std::size_t count, std::size_t stride) const noexcept;
+    void forward_batch(ci16* x, std::size_t count, std::size_t stride) const noexcept;
+    void inverse_batch(ci16* x, std::size_t count, std::size_t stride) const noexcept;
+
+private:
+    struct Pass {
+        std::uint32_t radix;
+        std::uint32_t span;
+        std::size_t twiddle_offset;  // complex elements into the tables
+    };
+
+    void transform(cf32* x, bool inverse) const noexcept;
+    void transform(ci16* x, bool inverse) const noexcept;
+    template <class T>
+    void permute(T* x) const noexcept;
+
+    std::size_t n_;
+    Isa isa_;
+    const kernels::FftKernels* kernels_;
+    std::vector<Pass> passes_;
+    std::size_t first_blocked_pass_ = 0;
+    AlignedArray<float> twiddles_[2];         // [forward, inverse], interleaved
+    AlignedArray<std::int16_t> twiddles_q15_[2];
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> swaps_;
+};
+
+}  // namespace dcomm
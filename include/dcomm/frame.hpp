@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+#include "dcomm/bits.hpp"
+#include "dcomm/convcode.hpp"
+#include "dcomm/equalizer.hpp"
+#include "dcomm/phy_config.hpp"
+#include "dcomm/static_phy.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+/// The 802.11a SIGNAL field (17.3.4): rate and length of the payload.
+struct SignalField {
+    Modulation modulation = Modulation::bpsk;
+    CodeRate code_rate = CodeRate::r1_2;
+    std::uint16_t length = 0;  ///< payload bytes, 1..kMaxFrameBytes
+
+    bool operator==(const SignalField&) const = default;
+};
+
+inline constexpr std::size_t kMaxFrameBytes = 4095;
+/// Samples of the SIGNAL symbol.
+inline constexpr std::size_t kSignalSamples = PhyConfig::fft_size + PhyConfig::cp_length;
+
+/// True for the eight rates of 802.11a, 6 to 54 Mbit/s.
+bool is_ieee80211a_rate(Modulation m, CodeRate r) noexcept;
+
+/// The 18 SIGNAL bits ahead of its tail, bit i transmitted i-th: RATE
+/// R1..R4, a reserved 0, LENGTH LSB first and even parity over the 17
+/// before it. Throws std::invalid_argument for a rate outside 802.11a or a
+/// length outside 1..kMaxFrameBytes.
+std::uint32_t pack_signal(const SignalField& signal);
+/// The reverse; nothing if the rate is unknown, the reserved bit set, the
+/// parity wrong or the length 0.
+std::optional<SignalField> parse_signal(std::uint32_t bits) noexcept;
+
+/// Data OFDM symbols carrying `signal.length` bytes and the 6-bit tail,
+/// padded to a whole number of symbols.
+constexpr std::size_t payload_symbols(const SignalField& signal) noexcept {
+    const std::size_t n_dbps = PhyConfig::data_subcarriers * bits_per_symbol(signal.modulation) *
+                               code_rate_numerator(signal.code_rate) /
+                               code_rate_denominator(signal.code_rate);
+    return (8 * std::size_t(signal.length) + PhyConfig::code_memory + n_dbps - 1) / n_dbps;
+}
+/// Samples of the whole frame, SIGNAL symbol included.
+constexpr std::size_t frame_samples(const SignalField& signal) noexcept {
+    return kSignalSamples * (1 + payload_symbols(signal));
+}
+/// The longest frame: kMaxFrameBytes at 6 Mbit/s.
+inline constexpr std::size_t kMaxFrameSamples =
+    frame_samples({Modulation::bpsk, CodeRate::r1_2, std::uint16_t(kMaxFrameBytes)});
+
+/// Encoder and decoder of 802.11a-style frames behind the preamble that
+/// PacketSync detects: one SIGNAL symbol (BPSK rate 1/2, interleaved, not
+/// scrambled, pilots p_0), then payload_symbols() data symbols of the
+/// signalled rate, scrambled from base.scrambler_seed with pilots from
+/// p_1. There is no SERVICE field; both ends know the scrambler seed.
+///
+/// Interleaving, equaliser, scrambler seed and noise variance come from
+/// `base`. The payload pipeline of each rate is a FramePhy (static_phy.hpp)
+/// sized for kMaxFrameBytes, created on first use. Not thread-safe.
+class FrameCodec {
+public:
+    /// Throws std::invalid_argument if `base` is invalid.
+    explicit FrameCodec(const PhyConfig& base);
+
+    const PhyConfig& base() const noexcept { return base_; }
+
+    /// Encode 8 * signal.length payload bits into frame_samples(signal)
+    /// samples and return that count.
+    std::size_t encode(const SignalField& signal, ConstBitSpan payload, std::span<cf32> samples);
+
+    /// The SIGNAL field of the kSignalSamples samples at `symbol`, if it
+    /// decodes to a valid one.
+    std::optional<SignalField> decode_signal(std::span<const cf32> symbol);
+
+    /// Decode the payload_symbols(signal) symbols following the SIGNAL
+    /// symbol into 8 * signal.length bits.
+    void decode_payload(const SignalField& signal, std::span<const cf32> samples,
+                        BitSpan payload);
+
+private:
+    FramePhy& phy(Modulation m, CodeRate r);
+
+    PhyConfig base_;
+    std::array<std::unique_ptr<FramePhy>, 15> phys_;  // by modulation and rate
+    PackedBits padded_;  // payload and pad bits of the longest frame
+    ViterbiDecoder signal_decoder_;
+    PilotEqualizer<cf32> signal_equalizer_;
+};
+
+}  // namespace dcomm
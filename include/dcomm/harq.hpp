@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+namespace kernels {
+struct HarqKernels;
+}
+
+/// How HarqSoftBuffers stores soft bits.
+enum class SoftFormat : std::uint8_t {
+    /// One byte per LLR: round(llr * llr_scale) clipped to +-127, the
+    /// input LdpcDecoder quantises to itself.
+    int8,
+    /// Two LLRs per byte: round(llr * llr_scale / 8) clipped to +-7, read
+    /// back as steps of 8 (+-56).
+    int4,
+};
+
+struct HarqConfig {
+    /// Bytes of soft-bit storage, allocated once at construction.
+    std::size_t budget_bytes = std::size_t(4) << 20;
+    /// Allocation unit; a multiple of 64. A buffer occupies whole pages.
+    std::size_t page_bytes = 128;
+    std::size_t users = 64;
+    std::size_t processes = 16;
+    /// Format of new buffers.
+    SoftFormat format = SoftFormat::int8;
+    /// When pages run out, narrow the least recently used int8 buffers,
+    /// then the new buffer, to int4 before evicting any buffer outright.
+    bool compress_under_pressure = true;
+    /// Same meaning as LdpcDecoderOptions::llr_scale.
+    float llr_scale = 4.0f;
+};
+
+/// Soft buffers of the HARQ processes of many users under a fixed memory
+/// budget.
+///
+/// Each (user, process) pair owns at most one circular buffer of `length`
+/// soft bits, typically one codeword. combine() adds a transmission's LLRs
+/// into it at positions (offset + i) mod length: offset 0 and every bit
+/// is Chase combining, per-redundancy-version offsets into a longer
+/// mother codeword are incremental redundancy, and positions never
+/// transmitted stay 0 (erased). read() returns the combined LLRs in the
+/// int8 units LdpcDecoder::decode() takes.
+///
+/// Storage is one block of budget_bytes split into pages; buffers are
+/// lists of pages, so nothing is allocated after construction. When a new
+/// buffer does not fit, the least recently used buffers of other
+/// processes are first narrowed to int4, then the new buffer itself (if
+/// compress_under_pressure), and only then are the least recently used
+/// buffers evicted; a retransmission that finds its buffer gone starts over
+/// and is counted in Stats::lost. Quantisation, combining and the int4
+/// conversions run in per-ISA kernels. Not thread-safe.
+class HarqSoftBuffers {
+public:
+    struct Stats {
+        std::uint64_t fresh = 0;         ///< transmissions starting a buffer
+        std::uint64_t combines = 0;      ///< transmissions added to stored soft bits
+        std::uint64_t lost = 0;          ///< retransmissions whose buffer was gone
+        std::uint64_t compressions = 0;  ///< buffers narrowed or started as int4 under pressure
+        std::uint64_t evictions = 0;
+    };
+
+    /// Throws std::invalid_argument if the configuration is invalid or
+    /// `isa` is not available on this CPU.
+    explicit HarqSoftBuffers(const HarqConfig& config, Isa isa = active_isa());
+
+    /// Add `llrs` (positive means 0) to the buffer of (user, process) at
+    /// positions (offset + i) mod length. With `new_data`, or when the
+    /// buffer is missing or of another length, the buffer starts over
+    /// from zeros first. Returns true if earlier soft bits were combined.
+    /// Requires offset < length and llrs.size() <= length; throws
+    /// std::invalid_argument if one buffer of `length` exceeds the budget.
+    bool combine(std::size_t user, std::size_t process, std::size_t length, std::size_t offset,
+                 std::span<const float> llrs, bool new_data);
+
+    /// The combined soft bits of (user, process), out.size() == length.
+    /// Returns false, leaving `out` alone, if no buffer is held.
+    bool read(std::size_t user, std::size_t process, std::span<std::int8_t> out) const;
+
+    /// Drop the buffer of (user, process), e.g. on ACK.
+    void release(std::size_t user, std::size_t process) noexcept;
+
+    bool holds(std::size_t user, std::size_t process) const noexcept;
+    /// Length of the held buffer, 0 if none.
+    std::size_t length(std::size_t user, std::size_t process) const noexcept;
+    /// Format of the held buffer.
+    SoftFormat format(std::size_t user, std::size_t process) const noexcept;
+
+    const HarqConfig& config() const noexcept { return config_; }
+    std::size_t pages() const noexcept { return next_.size(); }
+    std::size_t free_pages() const noexcept { return free_count_; }
+    /// Bytes in pages held by buffers.
+    std::size_t bytes_used() const noexcept {
+        return (pages() - free_count_) * config_.page_bytes;
+    }
+    const Stats& stats() const noexcept { return stats_; }
+
+private:
+    struct Entry {
+        std::uint32_t first;  // first page, kNone if no buffer
+        std::uint32_t pages;
+        std::uint32_t length;
+        SoftFormat format;
+        std::uint32_t older;  // LRU links
+        std::uint32_t newer;
+    };
+
+    std::size_t index(std::size_t user, std::size_t process) const noexcept;
+    std::size_t pages_for(std::size_t length, SoftFormat format) const noexcept;
+    std::uint8_t* page(std::uint32_t p) const noexcept;
+    std::uint32_t page_at(const Entry& e, std::size_t k) const noexcept;
+    void allocate(std::uint32_t id, std::size_t length);
+    void drop(std::uint32_t id) noexcept;
+    void narrow(std::uint32_t id) noexcept;
+    void free_chain(std::uint32_t first) noexcept;
+    void link_newest(std::uint32_t id) noexcept;
+    void unlink(std::uint32_t id) noexcept;
+    void add_s8(const Entry& e, std::size_t pos, const float* llrs, std::size_t n) noexcept;
+    void add_s4(const Entry& e, std::size_t pos, const float* llrs, std::size_t n) noexcept;
+
+    HarqConfig config_;
+    const kernels::HarqKernels* kernels_;
+    AlignedArray<std::uint8_t> arena_;
+    std::vector<std::uint32_t> next_;  // page links, within a buffer or the free list
+    std::uint32_t free_;
+    std::size_t free_count_;
+    std::vector<Entry> entries_;
+    std::uint32_t newest_;
+    std::uint32_t oldest_;
+    Stats stats_;
+};
+
+}  // namespace dcomm
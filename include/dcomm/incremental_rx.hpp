@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "dcomm/bits.hpp"
+#include "dcomm/convcode.hpp"
+#include "dcomm/equalizer.hpp"
+#include "dcomm/fft.hpp"
+#include "dcomm/frame.hpp"
+#include "dcomm/interleaver.hpp"
+#include "dcomm/scrambler.hpp"
+
+namespace dcomm {
+
+/// Early verdict on a frame from its SIGNAL field and first payload bytes,
+/// e.g. the receiver address of an 802.11 MAC header (bytes 4..9).
+struct FrameFilter {
+    /// Payload bytes to decode before asking; 0 asks right after the
+    /// SIGNAL symbol, before any payload work.
+    std::size_t header_bytes = 0;
+    /// Return false to drop the frame; empty accepts every frame. The
+    /// header holds min(header_bytes, length) bytes.
+    std::function<bool(const SignalField& signal, std::span<const std::uint8_t> header)> accept;
+};
+
+/// Receiver that decodes a frame (frame.hpp) symbol by symbol as its
+/// samples arrive, instead of buffering it whole.
+///
+/// The SIGNAL symbol is decoded as soon as its 80 samples are in; a frame
+/// whose SIGNAL does not parse is dropped there. Each payload symbol then
+/// goes through FFT, equalisation, demapping and deinterleaving on
+/// arrival and its LLRs are fed to a streaming ViterbiDecoder, which
+/// releases bits a window at a time, ViterbiDecoder::kTracebackDepth
+/// stages behind the newest symbol. Released bits are descrambled on the
+/// spot, so the filter sees the header bytes as soon as they are final.
+/// A frame it rejects is dropped without touching its remaining symbols:
+/// their samples are consumed and skipped.
+///
+/// With Equalizer::pilot_zf each symbol is equalised from its own pilots.
+/// The Viterbi soft scale comes from the first payload symbol. Only one
+/// symbol of samples is buffered; nothing is allocated per frame. Not
+/// thread-safe.
+class IncrementalReceiver {
+public:
+    enum class State : std::uint8_t {
+        signal,   ///< waiting for the SIGNAL symbol
+        payload,  ///< decoding payload symbols
+        done,     ///< payload() holds the frame
+        dropped,  ///< bad SIGNAL or rejected by the filter
+    };
+
+    struct Stats {
+        std::uint64_t frames = 0;
+        std::uint64_t delivered = 0;
+        std::uint64_t dropped_signal = 0;
+        std::uint64_t dropped_filter = 0;
+        std::uint64_t symbols_decoded = 0;  ///< payload symbols processed
+        std::uint64_t symbols_skipped = 0;  ///< payload symbols of dropped frames
+    };
+
+    /// Throws std::invalid_argument if `base` is invalid.
+    explicit IncrementalReceiver(const PhyConfig& base, FrameFilter filter = {});
+
+    /// Start the next frame.
+    void reset() noexcept;
+
+    /// Push the next samples of the current frame, starting with its SIGNAL
+    /// symbol. Returns how many were used: all of them while the frame
+    /// lasts, fewer once it is done or dropped. After a bad SIGNAL nothing
+    /// past that symbol is used, since the frame's length is unknown.
+    std::size_t push(std::span<const cf32> samples);
+
+    State state() const noexcept { return state_; }
+    /// The frame's SIGNAL field, once past State::signal.
+    const SignalField& signal() const noexcept { return signal_; }
+    /// 8 * signal().length bits in State::done.
+    ConstBitSpan payload() const noexcept {
+        return payload_.view().subspan(0, 8 * std::size_t(signal_.length));
+    }
+    /// Payload symbols of the current frame processed so far.
+    std::size_t symbols_decoded() const noexcept { return symbol_; }
+
+    const Stats& stats() const noexcept { return stats_; }
+
+private:
+    void decode_signal();
+    void decode_symbol();
+    bool admit();
+    void drop_payload();
+
+    PhyConfig base_;
+    FrameFilter filter_;
+    FrameCodec signal_codec_;
+    const FftPlan& fft_;
+    PilotEqualizer<cf32> equalizer_;
+    ViterbiDecoder decoder_;
+    Scrambler scrambler_{1};
+
+    State state_ = State::signal;
+    SignalField signal_;
+    std::size_t n_sym_ = 0;
+    std::size_t n_cbps_ = 0;
+    std::size_t n_info_ = 0;
+    const BlockInterleaver* interleaver_ = nullptr;
+    std::size_t symbol_ = 0;       // payload symbols decoded
+    std::size_t released_ = 0;     // final, descrambled bits in info_
+    std::size_t skip_ = 0;         // samples left of a dropped frame
+    bool admitted_ = false;
+
+    std::array<cf32, kSignalSamples> pending_;
+    std::size_t filled_ = 0;
+    std::array<cf32, PhyConfig::fft_size> bins_;
+    std::array<cf32, PhyConfig::data_subcarriers> symbols_;
+    std::array<float, PhyConfig::data_subcarriers * 8> llrs_;
+    std::array<float, PhyConfig::data_subcarriers * 8> deinterleaved_;
+    std::vector<std::uint8_t> info_;  // unpacked bits of the longest frame
+    std::vector<std::uint8_t> header_;
+    PackedBits payload_;
+
+    Stats stats_;
+};
+
+}  // namespace dcomm
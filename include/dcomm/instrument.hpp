@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <span>
+
+#include "dcomm/clock.hpp"
+#include "dcomm/types.hpp"
+
+// Set by CMake from the DCOMM_INSTRUMENTATION option. With 0 every probe
+// below is an empty inline no-op and the chains carry no extra state.
+#ifndef DCOMM_INSTRUMENT
+#define DCOMM_INSTRUMENT 1
+#endif
+
+namespace dcomm {
+
+inline constexpr bool kInstrumented = DCOMM_INSTRUMENT != 0;
+
+/// Threads with their own counter slot in every StageProbe. Threads past
+/// this many share slots, which stays correct but brings back contention.
+inline constexpr std::size_t kProbeThreads = 64;
+
+/// Small dense id of the calling thread, assigned on first use.
+std::uint32_t probe_thread_id() noexcept;
+
+/// Totals of one stage across all threads. Cycles are read_cycles() ticks.
+struct StageStats {
+    const char* name = "";
+    std::uint64_t blocks = 0;
+    std::uint64_t samples = 0;       ///< baseband samples of the blocks processed
+    std::uint64_t busy_cycles = 0;   ///< inside process()
+    std::uint64_t wait_cycles = 0;   ///< waiting on an input queue
+
+    /// Share of the stage's time spent working rather than waiting.
+    double utilisation() const noexcept {
+        const std::uint64_t total = busy_cycles + wait_cycles;
+        return total == 0 ? 0.0 : double(busy_cycles) / double(total);
+    }
+};
+
+/// One timed block in a TraceRing.
+struct TraceEvent {
+    const char* name;
+    std::uint32_t thread;
+    std::uint32_t samples;
+    std::uint64_t begin;  ///< read_cycles() ticks
+    std::uint64_t end;
+};
+
+/// Fixed-size binary log of the most recent stage executions.
+///
+/// Writers claim a slot with one fetch_add and overwrite the oldest event
+/// once the ring has wrapped; nothing is allocated after construction.
+/// The tick rate needed to turn cycles into time is calibrated between
+/// construction and export, so export after the traced run, once the
+/// writing threads have stopped.
+class TraceRing {
+public:
+    /// Capacity is rounded up to a power of two.
+    explicit TraceRing(std::size_t capacity);
+
+    TraceRing(const TraceRing&) = delete;
+    TraceRing& operator=(const TraceRing&) = delete;
+
+    void push(const TraceEvent& e) noexcept {
+        const std::uint64_t i = next_.fetch_add(1, std::memory_order_relaxed);
+        events_[i & mask_] = e;
+    }
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+    /// Events pushed so far, including those since overwritten.
+    std::uint64_t pushed() const noexcept { return next_.load(std::memory_order_relaxed); }
+
+    /// The retained events, oldest first.
+    template <class Fn>
+    void for_each(Fn&& fn) const {
+        const std::uint64_t end = pushed();
+        const std::uint64_t begin = end > capacity() ? end - capacity() : 0;
+        for (std::uint64_t i = begin; i < end; ++i) {
+            fn(events_[i & mask_]);
+        }
+    }
+
+    /// Write the retained events as Chrome trace JSON ("X" events, one
+    /// track per thread), which chrome://tracing and Perfetto load as is.
+    void write_chrome_trace(std::FILE* out) const;
+    /// Same, to a file; throws std::runtime_error if it cannot be written.
+    void write_chrome_trace(const char* path) const;
+
+private:
+    std::size_t mask_;
+    AlignedArray<TraceEvent> events_;
+    std::uint64_t origin_cycles_;
+    std::uint64_t origin_ns_;
+    alignas(kCacheLine) std::atomic<std::uint64_t> next_{0};
+};
+
+#if DCOMM_INSTRUMENT
+
+/// Counters of one pipeline stage.
+///
+/// Each thread adds to its own cache-line sized slot, so probes shared by
+/// stage replicas on several threads never bounce a line between cores on
+/// the hot path; stats() sums the slots. With a TraceRing attached every
+/// record() also logs a TraceEvent.
+class StageProbe {
+public:
+    explicit StageProbe(const char* name);
+
+    const char* name() const noexcept { return name_; }
+
+    /// Start of a timed region, to pass to record().
+    static std::uint64_t start() noexcept { return read_cycles(); }
+
+    /// One block of `samples` baseband samples processed since `begin`.
+    void record(std::uint64_t begin, std::size_t samples) noexcept {
+        const std::uint64_t end = read_cycles();
+        const std::uint32_t tid = probe_thread_id();
+        Slot& s = slots_[tid % kProbeThreads];
+        s.blocks.fetch_add(1, std::memory_order_relaxed);
+        s.samples.fetch_add(samples, std::memory_order_relaxed);
+        s.busy.fetch_add(end - begin, std::memory_order_relaxed);
+        if (TraceRing* t = trace_.load(std::memory_order_relaxed)) {
+            t->push({name_, tid, std::uint32_t(samples), begin, end});
+        }
+    }
+
+    /// Cycles spent waiting for input before a block.
+    void add_wait(std::uint64_t cycles) noexcept {
+        slots_[probe_thread_id() % kProbeThreads].wait.fetch_add(cycles,
+                                                                 std::memory_order_relaxed);
+    }
+
+    /// Log to `trace` from now on, or stop logging with nullptr.
+    void attach(TraceRing* trace) noexcept { trace_.store(trace, std::memory_order_relaxed); }
+
+    StageStats stats() const noexcept;
+    void clear() noexcept;
+
+private:
+    struct alignas(kCacheLine) Slot {
+        std::atomic<std::uint64_t> blocks{0};
+        std::atomic<std::uint64_t> samples{0};
+        std::atomic<std::uint64_t> busy{0};
+        std::atomic<std::uint64_t> wait{0};
+    };
+
+    const char* name_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<TraceRing*> trace_{nullptr};
+};
+
+#else
+
+class StageProbe {
+public:
+    explicit StageProbe(const char* name) noexcept : name_(name) {}
+    const char* name() const noexcept { return name_; }
+    static std::uint64_t start() noexcept { return 0; }
+    void record(std::uint64_t, std::size_t) noexcept {}
+    void add_wait(std::uint64_t) noexcept {}
+    void attach(TraceRing*) noexcept {}
+    StageStats stats() const noexcept { return {name_}; }
+    void clear() noexcept {}
+
+private:
+    const char* name_;
+};
+
+#endif
+
+/// Run `stage` on `in` and charge the block to `probe`.
+template <class StageT, class In>
+auto timed_process(StageProbe& probe, std::size_t samples, StageT& stage, In&& in) {
+    const std::uint64_t begin = StageProbe::start();
+    auto out = stage.process(static_cast<In&&>(in));
+    probe.record(begin, samples);
+    return out;
+}
+
+/// Per-stage table: blocks, cycles per sample and per block, wait share,
+/// with the stage that has the highest busy cycles per block marked as
+/// the bottleneck. Prints nothing useful when instrumentation is compiled
+/// out, and says so.
+void write_stage_report(std::FILE* out, std::span<const StageStats> stats);
+
+}  // namespace dcomm
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "dcomm/bits.hpp"
+#include "dcomm/buffer.hpp"
+#include "dcomm/phy_config.hpp"
+#include "dcomm/stage.hpp"
+
+namespace dcomm {
+
+/// Fixed permutation of a block of coded bits, applied by table lookup.
+///
+/// out[j] = in[source(j)] within each block of size() values; a longer
+/// input is a run of blocks permuted alike, e.g. one per OFDM symbol. The
+/// permutation and its inverse are precomputed index tables, so both
+/// directions are one gather per value, whether the values are unpacked
+/// bits, packed bits or LLRs. The tables are immutable once built, and the
+/// factories hand out one shared instance per parameter set.
+class BlockInterleaver {
+public:
+    /// out[j] = in[source[j]]. Throws std::invalid_argument unless `source`
+    /// is a permutation of 0 .. source.size() - 1.
+    explicit BlockInterleaver(std::vector<std::uint32_t> source);
+
+    /// 802.11 OFDM interleaver (17.3.5.7) of N_CBPS coded bits per symbol
+    /// with N_BPSC bits per subcarrier. Shared, built on first request.
+    /// Thread-safe. Throws std::invalid_argument unless N_CBPS is a
+    /// multiple of 16 and of N_BPSC.
+    static const BlockInterleaver& ieee80211(std::size_t n_cbps, unsigned n_bpsc);
+    /// The interleaver of `config`'s modulation.
+    static const BlockInterleaver& ieee80211(const PhyConfig& config);
+
+    /// `rows` x `columns` matrix written row by row and read column by
+    /// column. Shared like ieee80211().
+    static const BlockInterleaver& row_column(std::size_t rows, std::size_t columns);
+
+    std::size_t size() const noexcept { return source_.size(); }
+    std::uint32_t source(std::size_t j) const noexcept { return source_[j]; }
+
+    // Inputs are whole blocks; outputs are as long and must not overlap
+    // them. Packed blocks need not start on a word; runs of them are
+    // unpacked, permuted as bytes and packed again.
+    void interleave(std::span<const std::uint8_t> in, std::span<std::uint8_t> out) const noexcept;
+    void deinterleave(std::span<const std::uint8_t> in,
+                      std::span<std::uint8_t> out) const noexcept;
+    void interleave(std::span<const float> in, std::span<float> out) const noexcept;
+    void deinterleave(std::span<const float> in, std::span<float> out) const noexcept;
+    void interleave(ConstBitSpan in, BitSpan out) const noexcept;
+    void deinterleave(ConstBitSpan in, BitSpan out) const noexcept;
+
+private:
+    std::vector<std::uint32_t> source_;  // out[j] = in[source_[j]]
+    std::vector<std::uint32_t> target_;  // the inverse: in[i] = out[target_[i]]
+};
+
+/// Interleaver stage over packed blocks of `block_bits` coded bits.
+class InterleaverStage final : public Stage<std::uint64_t, std::uint64_t> {
+public:
+    InterleaverStage(const BlockInterleaver& interleaver, std::size_t block_bits,
+                     std::size_t pool_depth);
+
+    BufferView<std::uint64_t> process(BufferView<std::uint64_t> in) override;
+    const char* name() const noexcept override { return "interleaver"; }
+
+private:
+    const BlockInterleaver& interleaver_;
+    std::size_t block_bits_;
+    BufferPool<std::uint64_t> pool_;
+};
+
+/// Deinterleaver stage over coded-bit LLRs.
+class DeinterleaverStage final : public Stage<float, float> {
+public:
+    DeinterleaverStage(const BlockInterleaver& interleaver, std::size_t block_bits,
+                       std::size_t pool_depth);
+
+    BufferView<float> process(BufferView<float> in) override;
+    const char* name() const noexcept override { return "deinterleaver"; }
+
+private:
+    const BlockInterleaver& interleaver_;
+    BufferPool<float> pool_;
+};
+
+}  // namespace dcomm
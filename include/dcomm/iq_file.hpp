@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "dcomm/sample.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+/// On-disk sample format of an IQ recording: interleaved little-endian
+/// re/im components, one of the SigMF datatypes "cf32_le", "ci16_le" or
+/// "ci8". Fixed-point files use the SampleTraits scaling of their type.
+enum class IqFormat : std::uint8_t { cf32, ci16, ci8 };
+
+/// SigMF datatype string of `f`.
+const char* to_string(IqFormat f) noexcept;
+
+/// Bytes per complex sample.
+constexpr std::size_t sample_bytes(IqFormat f) noexcept {
+    switch (f) {
+    case IqFormat::cf32: return sizeof(cf32);
+    case IqFormat::ci16: return sizeof(ci16);
+    case IqFormat::ci8: return sizeof(ci8);
+    }
+    return 0;
+}
+
+template <SampleType T>
+inline constexpr IqFormat iq_format_of = std::same_as<T, cf32>   ? IqFormat::cf32
+                                         : std::same_as<T, ci16> ? IqFormat::ci16
+                                                                 : IqFormat::ci8;
+
+/// The subset of a SigMF recording's metadata the chains care about.
+struct SigmfMeta {
+    IqFormat format = IqFormat::cf32;
+    double sample_rate = 0.0;  // Hz, 0 if unknown
+    double frequency = 0.0;    // centre frequency of the first capture, Hz
+    std::string description;
+};
+
+/// `<base>.sigmf-meta` for a `<base>.sigmf-data` path (or a bare base).
+std::string sigmf_meta_path(const std::string& data_path);
+
+/// Parse the global datatype, sample rate and description and the first
+/// capture's frequency of a .sigmf-meta file. Throws std::system_error if
+/// it cannot be read and std::invalid_argument if the datatype is missing
+/// or not one of the IqFormat types (big-endian and real-valued recordings
+/// are not supported).
+SigmfMeta read_sigmf_meta(const std::string& path);
+
+/// Write a minimal SigMF 1.0 metadata file for one capture starting at
+/// sample 0.
+void write_sigmf_meta(const std::string& path, const SigmfMeta& meta);
+
+/// Memory-mapped reader of an IQ recording.
+///
+/// The whole file is mapped read-only and advised for sequential access;
+/// the kernel reads ahead as the mapping is walked, and read() copies the
+/// samples straight from the page cache into the caller's buffer without a
+/// read() syscall per block. Pages more than one window behind the read
+/// position are dropped with MADV_DONTNEED, so resident memory stays
+/// bounded however large the capture is.
+///
+/// read() converts from the file format to the requested sample type:
+/// float is quantised at SampleTraits<T>::unit, ci8 widens exactly to
+/// ci16, and narrowing conversions saturate and count into saturation().
+/// view() returns the samples in place when no conversion is needed.
+class IqFileSource {
+public:
+    /// Open a SigMF recording: `path` is the .sigmf-data file, its format
+    /// and rate come from the .sigmf-meta file next to it.
+    explicit IqFileSource(const std::string& path);
+    /// Open a raw headerless recording in `format`.
+    IqFileSource(const std::string& path, IqFormat format, double sample_rate = 0.0);
+    ~IqFileSource();
+
+    IqFileSource(const IqFileSource&) = delete;
+    IqFileSource& operator=(const IqFileSource&) = delete;
+
+    const SigmfMeta& meta() const noexcept { return meta_; }
+    IqFormat format() const noexcept { return meta_.format; }
+
+    /// Complete samples in the file; a trailing partial sample is ignored.
+    std::uint64_t samples() const noexcept { return samples_; }
+    std::uint64_t position() const noexcept { return position_; }
+    std::uint64_t remaining() const noexcept { return samples_ - position_; }
+
+    /// Move the read position, clamped to the end of the file.
+    void seek(std::uint64_t sample) noexcept;
+
+    /// Convert up to out.size() samples into `out` and advance. Returns the
+    /// number of samples read, 0 at the end of the file.
+    template <SampleType T>
+    std::size_t read(std::span<T> out) noexcept;
+
+    /// The next up to `count` samples, in place in the mapping, and
+    /// advance. T must be the file's format; valid while the source lives.
+    template <SampleType T>
+    std::span<const T> view(std::size_t count);
+
+    /// Components clipped by narrowing conversions in read().
+    const SaturationStats& saturation() const noexcept { return saturation_; }
+
+private:
+    void open(const std::string& path);
+    void advance(std::uint64_t count) noexcept;
+
+    SigmfMeta meta_;
+    int fd_ = -1;
+    const std::byte* map_ = nullptr;
+    std::size_t map_bytes_ = 0;
+    std::uint64_t samples_ = 0;
+    std::uint64_t position_ = 0;
+    std::size_t released_ = 0;  // bytes before this offset have been dropped
+    std::size_t prefetched_ = 0;  // bytes before this offset were advised WILLNEED
+    SaturationStats saturation_;
+};
+
+/// Writer of an IQ recording in large aligned chunks.
+///
+/// Samples are converted into a page-aligned chunk buffer and written out
+/// one whole chunk at a time, so the kernel only ever sees large,
+/// page-aligned writes. On Linux each chunk's writeback is started as soon
+/// as it is written and the previous chunk is dropped from the page cache
+/// once it is on disk, so multi-gigabyte captures do not evict everything
+/// else. With `direct` set the file is opened with O_DIRECT (falling back
+/// to buffered I/O where the filesystem does not support it) and the page
+/// cache is bypassed entirely.
+///
+/// If `path` ends in ".sigmf-data", close() writes the matching
+/// .sigmf-meta file.
+class IqFileSink {
+public:
+    static constexpr std::size_t kDefaultChunkBytes = std::size_t(4) << 20;
+    static constexpr std::size_t kPageBytes = 4096;
+
+    IqFileSink(const std::string& path, SigmfMeta meta,
+               std::size_t chunk_bytes = kDefaultChunkBytes, bool direct = false);
+    /// Closes the file; errors are only reported by an explicit close().
+    ~IqFileSink();
+
+    IqFileSink(const IqFileSink&) = delete;
+    IqFileSink& operator=(const IqFileSink&) = delete;
+
+    /// Append samples, converting to the file format. Throws
+    /// std::system_error if a chunk cannot be written.
+    template <SampleType T>
+    void write(std::span<const T> in);
+
+    /// Write out the buffered tail and the metadata and close the file.
+    void close();
+
+    const SigmfMeta& meta() const noexcept { return meta_; }
+    /// Samples appended so far.
+    std::uint64_t samples() const noexcept { return samples_; }
+    /// Components clipped by narrowing conversions in write().
+    const SaturationStats& saturation() const noexcept { return saturation_; }
+
+private:
+    void write_chunk(std::size_t bytes);
+
+    std::string path_;
+    SigmfMeta meta_;
+    int fd_ = -1;
+    bool direct_ = false;
+    AlignedArray<std::byte> chunk_;
+    std::size_t chunk_bytes_;
+    std::size_t fill_ = 0;  // bytes buffered in chunk_
+    std::uint64_t offset_ = 0;  // bytes written to the file
+    std::uint64_t samples_ = 0;
+    SaturationStats saturation_;
+};
+
+extern template std::size_t IqFileSource::read<cf32>(std::span<cf32>) noexcept;
+extern template std::size_t IqFileSource::read<ci16>(std::span<ci16>) noexcept;
+extern template std::size_t IqFileSource::read<ci8>(std::span<ci8>) noexcept;
+extern template std::span<const cf32> IqFileSource::view<cf32>(std::size_t);
+extern template std::span<const ci16> IqFileSource::view<ci16>(std::size_t);
+extern template std::span<const ci8> IqFileSource::view<ci8>(std::size_t);
+extern template void IqFileSink::write<cf32>(std::span<const cf32>);
+extern template void IqFileSink::write<ci16>(std::span<const ci16>);
+extern template void IqFileSink::write<ci8>(std::span<const ci8>);
+
+}  // namespace dcomm
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/thread_pool.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+namespace kernels {
+struct LdpcKernels;
+}
+
+/// Quasi-cyclic LDPC base graph: a rows x cols matrix of circulant shifts,
+/// -1 marking an all-zero block.
+///
+/// The first cols - rows block columns carry information. The built-in
+/// graph is the 802.11n/ac Z = 27 rate-1/2 matrix (n = 648). The other
+/// 802.11 matrices and the 5G NR base graphs (38.212 Table 5.3.2-2/-3,
+/// the V column of one lifting set) are loaded with parse() from text
+/// copied out of the standards. LdpcCode lifts shifts as V mod Z, which is
+/// the NR rule and the identity for 802.11 tables.
+struct LdpcBaseGraph {
+    std::string name;
+    std::size_t rows = 0;
+    std::size_t cols = 0;
+    std::vector<std::int16_t> shifts;  ///< row-major, rows * cols
+
+    std::int16_t shift(std::size_t r, std::size_t c) const noexcept {
+        return shifts[r * cols + c];
+    }
+
+    /// 802.11n/ac n = 648, rate 1/2 (Z = 27).
+    static const LdpcBaseGraph& ieee80211_648_r12();
+
+    /// Parse "rows cols" followed by rows * cols shifts ('-' or -1 for a
+    /// zero block). '#' starts a comment. Throws std::invalid_argument.
+    static LdpcBaseGraph parse(std::string name, std::string_view text);
+};
+
+/// A base graph lifted by Z, with a precomputed encoding schedule.
+///
+/// Encoding needs the usual 802.11/NR parity structure: one parity block
+/// column solvable from the sum of the core rows (the dual-diagonal part
+/// cancels in pairs) and every other parity block column then solvable one
+/// row at a time. The constructor throws std::invalid_argument otherwise.
+class LdpcCode {
+public:
+    struct Edge {
+        std::uint32_t col;
+        std::uint32_t shift;
+    };
+
+    LdpcCode(const LdpcBaseGraph& graph, std::size_t z);
+
+    std::size_t z() const noexcept { return z_; }
+    std::size_t n() const noexcept { return cols_ * z_; }
+    std::size_t k() const noexcept { return (cols_ - rows_) * z_; }
+    std::size_t rows() const noexcept { return rows_; }
+    std::size_t cols() const noexcept { return cols_; }
+    std::size_t max_row_degree() const noexcept { return max_degree_; }
+
+    /// Nonzero blocks of base row `r`.
+    std::span<const Edge> row(std::size_t r) const noexcept {
+        return {edges_.data() + row_start_[r], row_start_[r + 1] - row_start_[r]};
+    }
+    std::size_t edge_count() const noexcept { return edges_.size(); }
+    std::size_t edge_offset(std::size_t r) const noexcept { return row_start_[r]; }
+
+    /// Systematic encoding of k() unpacked bits into n() unpacked bits.
+    void encode(std::span<const std::uint8_t> info, std::span<std::uint8_t> codeword) const;
+
+    /// True if every parity check of the hard-decision `codeword` holds.
+    bool check(std::span<const std::uint8_t> codeword) const;
+
+private:
+    struct Step {
+        std::uint32_t row;  ///< row solved for `col`, or UINT32_MAX for the core sum
+        std::uint32_t col;
+        std::uint32_t shift;
+    };
+
+    std::size_t z_;
+    std::size_t rows_;
+    std::size_t cols_;
+    std::size_t max_degree_ = 0;
+    std::vector<Edge> edges_;
+    std::vector<std::size_t> row_start_;
+    std::vector<std::uint32_t> core_rows_;
+    std::vector<Step> schedule_;
+};
+
+struct LdpcDecoderOptions {
+    unsigned max_iterations = 10;
+    /// Min-sum normalisation in eighths (6 = 0.75).
+    unsigned alpha_eighths = 6;
+    /// Channel LLRs are quantised as round(llr * llr_scale), clipped to
+    /// +-127.
+    float llr_scale = 4.0f;
+};
+
+struct LdpcResult {
+    unsigned iterations = 0;
+    bool converged = false;  ///< all parity checks hold
+};
+
+/// Layered normalised min-sum decoder with int8 messages.
+///
+/// Each layer (base row) gathers its rotated a-posteriori blocks into
+/// contiguous rows and runs one SIMD check-node kernel over all Z checks at
+/// once. The kernel also reports whether the layer's checks held on entry;
+/// after an iteration in which all of them did, a full syndrome check
+/// confirms convergence and decoding stops early. Storage is
+/// sized at construction; decode() does not allocate. One decoder per
+/// thread.
+class LdpcDecoder {
+public:
+    LdpcDecoder(const LdpcCode& code, LdpcDecoderOptions options = {},
+                Isa isa = active_isa());
+    ~LdpcDecoder();
+
+    LdpcDecoder(LdpcDecoder&&) noexcept;
+    LdpcDecoder& operator=(LdpcDecoder&&) noexcept;
+
+    /// Decode n() LLRs (positive means 0; punctured bits 0) into k()
+    /// information bits.
+    LdpcResult decode(std::span<const float> llrs, std::span<std::uint8_t> info);
+    /// Same on already-quantised LLRs.
+    LdpcResult decode(std::span<const std::int8_t> llrs, std::span<std::uint8_t> info);
+
+    const LdpcCode& code() const noexcept { return *code_; }
+
+private:
+    LdpcResult run(std::span<std::uint8_t> info);
+    void gather(std::span<const LdpcCode::Edge> edges) noexcept;
+    void scatter(std::span<const LdpcCode::Edge> edges) noexcept;
+    bool syndrome_ok() noexcept;
+
+    const LdpcCode* code_;
+    LdpcDecoderOptions options_;
+    const kernels::LdpcKernels* kernels_;
+    std::size_t lanes_;         // z rounded up to the kernel lane multiple
+    std::size_t block_stride_;  // a-posteriori block pitch, with copy slack
+    AlignedArray<std::int8_t> app_;    // cols() blocks
+    AlignedArray<std::int8_t> check_;  // edge_count() rows of lanes_
+    AlignedArray<std::int8_t> rows_;   // max_row_degree() buffers of 2 * lanes_
+    std::vector<std::int8_t*> row_ptrs_;
+};
+
+/// Decodes independent codeblocks of one code in parallel on a
+/// WorkStealingPool, with one LdpcDecoder per worker.
+class LdpcBatchDecoder {
+public:
+    LdpcBatchDecoder(const LdpcCode& code, WorkStealingPool& pool,
+                     LdpcDecoderOptions options = {});
+
+    /// `llrs` holds count * n() values, `info` count * k() bits and
+    /// `results` count entries, codeblock after codeblock.
+    void decode(std::span<const float> llrs, std::span<std::uint8_t> info,
+                std::span<LdpcResult> results);
+
+private:
+    const LdpcCode* code_;
+    WorkStealingPool* pool_;
+    std::vector<LdpcDecoder> decoders_;
+};
+
+}  // namespace dcomm
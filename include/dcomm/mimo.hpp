@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+namespace kernels {
+struct MimoKernels;
+}
+
+/// A rows x cols complex matrix per subcarrier over a batch of
+/// subcarriers, stored as structure of arrays: each entry is a plane of re
+/// values then a plane of im values, one float per subcarrier, so batched
+/// kernels work on many subcarriers per instruction. Planes are stride()
+/// floats apart and cache-line aligned. A column vector per subcarrier
+/// (received or detected symbols) is a rows x 1 matrix.
+class SubcarrierMatrix {
+public:
+    SubcarrierMatrix() = default;
+    SubcarrierMatrix(std::size_t rows, std::size_t cols, std::size_t subcarriers);
+
+    std::size_t rows() const noexcept { return rows_; }
+    std::size_t cols() const noexcept { return cols_; }
+    std::size_t subcarriers() const noexcept { return subcarriers_; }
+    std::size_t stride() const noexcept { return stride_; }
+
+    float* re(std::size_t i, std::size_t j) noexcept { return plane(i, j); }
+    float* im(std::size_t i, std::size_t j) noexcept { return plane(i, j) + stride_; }
+    const float* re(std::size_t i, std::size_t j) const noexcept { return plane(i, j); }
+    const float* im(std::size_t i, std::size_t j) const noexcept { return plane(i, j) + stride_; }
+    float* data() noexcept { return data_.get(); }
+    const float* data() const noexcept { return data_.get(); }
+
+    cf32 at(std::size_t i, std::size_t j, std::size_t k) const noexcept {
+        return {re(i, j)[k], im(i, j)[k]};
+    }
+    void set(std::size_t i, std::size_t j, std::size_t k, cf32 v) noexcept {
+        re(i, j)[k] = v.real();
+        im(i, j)[k] = v.imag();
+    }
+
+    /// Entry (i, j) of every subcarrier k from bins[index[k]] of an
+    /// interleaved FFT output; index.size() must equal subcarriers().
+    void load(std::size_t i, std::size_t j, const cf32* bins,
+              std::span<const std::uint16_t> index) noexcept;
+    /// Entry (i, j) of every subcarrier into out[0..subcarriers()).
+    void store(std::size_t i, std::size_t j, cf32* out) const noexcept;
+
+private:
+    float* plane(std::size_t i, std::size_t j) const noexcept {
+        return data_.get() + 2 * (i * cols_ + j) * stride_;
+    }
+
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    std::size_t subcarriers_ = 0;
+    std::size_t stride_ = 0;
+    AlignedArray<float> data_;
+};
+
+/// Long training symbols that carry `streams` spatial streams in 802.11n
+/// (HT-LTF, 20.3.9.4.6): 1, 2, 4, 4 for 1..4 streams; 0 otherwise.
+std::size_t ht_ltf_symbols(std::size_t streams) noexcept;
+
+/// Entry (stream, symbol) of the HT-LTF orthogonal cover P_HTLTF, +-1.
+float ht_ltf_cover(std::size_t stream, std::size_t symbol) noexcept;
+
+/// Least-squares MIMO channel estimate from long training symbols.
+///
+/// Stream t sends reference[k] ht_ltf_cover(t, s) on subcarrier k in LTF
+/// symbol s, so with N = ht_ltf_symbols(tx) symbols the cover's
+/// orthogonality separates the streams:
+///
+///   H[r][t][k] = 1/N sum_s ht_ltf_cover(t, s) Y_s,r[bins[k]] / reference[k].
+///
+/// One symbol and a single stream give the per-subcarrier LS estimate of
+/// a SISO preamble, or of the pilots when `bins` are the pilot bins.
+class LtfChannelEstimator {
+public:
+    /// `reference` is the known real value of each subcarrier, nonzero.
+    /// Throws std::invalid_argument for 0 or more than 4 streams, rx
+    /// outside 1..8, mismatched spans or a zero reference.
+    LtfChannelEstimator(std::size_t rx, std::size_t tx, std::span<const std::uint16_t> bins,
+                        std::span<const float> reference);
+
+    /// `symbols[s * rx + r]` is the FFT output of LTF symbol s on receive
+    /// antenna r. `h` is resized to rx x tx over the estimator's subcarriers.
+    void estimate(std::span<const cf32* const> symbols, SubcarrierMatrix& h) const;
+
+    std::size_t ltf_symbols() const noexcept { return ltf_symbols_; }
+
+private:
+    std::size_t rx_;
+    std::size_t tx_;
+    std::size_t ltf_symbols_;
+    std::vector<std::uint16_t> bins_;
+    std::vector<float> inverse_;  // 1 / reference
+};
+
+/// Linear interpolation of per-subcarrier matrices across frequency, from
+/// estimated subcarriers to the ones to equalise, extrapolating past the
+/// outermost ones like PilotEqualizer does.
+class SubcarrierInterpolator {
+public:
+    /// Subcarrier indices (e.g. -26..26); `from` strictly increasing with
+    /// at least two entries. Throws std::invalid_argument otherwise.
+    SubcarrierInterpolator(std::span<const int> from, std::span<const int> to);
+
+    /// `out` is resized to in's shape over the target subcarriers.
+    void apply(const SubcarrierMatrix& in, SubcarrierMatrix& out) const;
+
+private:
+    std::size_t from_size_;
+    std::vector<std::uint32_t> left_;  // segment start in `from`
+    std::vector<float> weight_;        // of the right end
+};
+
+enum class MimoDetector : std::uint8_t {
+    zf,    ///< zero forcing, (H^H H)^-1 H^H
+    mmse,  ///< unbiased linear MMSE, (H^H H + N0 I)^-1 H^H with row scaling
+};
+
+const char* to_string(MimoDetector d) noexcept;
+
+/// Linear MIMO detection over all subcarriers at once.
+///
+/// prepare() forms per-subcarrier weights of `streams` x rx from an rx x
+/// streams channel estimate: the Gram matrix, its 2x2 or 4x4 Hermitian
+/// inverse in closed form, and the product with H^H, fused into one
+/// batched kernel over the SoA planes. There is no dense matrix library
+/// and no per-subcarrier call. apply() is then rx complex multiply-adds per
+/// stream and subcarrier. The MMSE weights are scaled to unit gain on the
+/// wanted stream, so both detectors output symbols at unit level, and
+/// noise() gives each stream's post-detection noise plus interference
+/// variance for the demapper.
+class MimoEqualizer {
+public:
+    /// Throws std::invalid_argument unless streams is 2 or 4 and
+    /// streams <= rx <= 8.
+    MimoEqualizer(std::size_t rx, std::size_t streams, MimoDetector detector);
+    MimoEqualizer(std::size_t rx, std::size_t streams, MimoDetector detector, Isa isa);
+
+    /// Weights for channel `h` (rx x streams) and noise variance N0 per
+    /// receive antenna. Throws std::invalid_argument on a shape mismatch.
+    void prepare(const SubcarrierMatrix& h, float noise_variance);
+
+    /// Detect `y` (rx x 1 over the prepared subcarriers) into `x`
+    /// (streams x 1), which is resized to fit.
+    void apply(const SubcarrierMatrix& y, SubcarrierMatrix& x) const;
+
+    std::size_t rx() const noexcept { return rx_; }
+    std::size_t streams() const noexcept { return streams_; }
+    MimoDetector detector() const noexcept { return detector_; }
+    /// Weights from the last prepare(), streams x rx.
+    const SubcarrierMatrix& weights() const noexcept { return weights_; }
+    /// Post-detection noise variance of `stream` on each subcarrier.
+    std::span<const float> noise(std::size_t stream) const noexcept {
+        return {noise_.get() + stream * weights_.stride(), weights_.subcarriers()};
+    }
+
+private:
+    const kernels::MimoKernels* kernels_;
+    std::size_t rx_;
+    std::size_t streams_;
+    MimoDetector detector_;
+    SubcarrierMatrix weights_;
+    AlignedArray<float> noise_;
+};
+
+}  // namespace dcomm
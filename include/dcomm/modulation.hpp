@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "dcomm/arena.hpp"
+#include "dcomm/bits.hpp"
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/phy_config.hpp"
+#include "dcomm/sample.hpp"
+#include "dcomm/stage.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+/// Normalisation factor K_MOD giving unit average symbol energy:
+/// 1, 1/sqrt(2), 1/sqrt(10), 1/sqrt(42) and 1/sqrt(170).
+float modulation_scale(Modulation m) noexcept;
+
+/// Map unpacked bits onto Gray-coded constellation points.
+///
+/// The first half of each symbol's bits selects the in-phase level and
+/// the second half the quadrature level (BPSK uses I only), following the
+/// 802.11 bit-to-constellation tables. `bits.size()` must equal
+/// `symbols.size() * bits_per_symbol(m)`.
+void map_bits(Modulation m, std::span<const std::uint8_t> bits,
+              std::span<cf32> symbols) noexcept;
+
+/// The same from packed bits, unpacked 512 symbols at a time in front of
+/// the vector kernels. `bits.size()` must equal `symbols.size() *
+/// bits_per_symbol(m)`.
+void map_bits(Modulation m, ConstBitSpan bits, std::span<cf32> symbols) noexcept;
+
+/// Max-log soft demapper.
+///
+/// For every bit, llr = (min_{s: b=1} |y - s|^2 - min_{s: b=0} |y - s|^2)
+/// / noise_variance, so positive values favour 0. `llrs.size()` must equal
+/// `symbols.size() * bits_per_symbol(m)`.
+void demap_maxlog(Modulation m, std::span<const cf32> symbols,
+                  float noise_variance, std::span<float> llrs) noexcept;
+
+// The two functions above run the kernels of active_isa(). These overloads
+// pick the variant explicitly, e.g. to compare it against Isa::scalar; every
+// variant produces bit-identical output. `isa` must be isa_available().
+void map_bits(Isa isa, Modulation m, std::span<const std::uint8_t> bits,
+              std::span<cf32> symbols) noexcept;
+void demap_maxlog(Isa isa, Modulation m, std::span<const cf32> symbols,
+                  float noise_variance, std::span<float> llrs) noexcept;
+
+/// Fixed-point mapper: the same constellation at SampleTraits<T>::unit,
+/// rounded once per level. Clipped components are added to `stats`. From
+/// packed bits, unpack_indices() splits 64 symbols at a time into axis
+/// codes that index the level table directly.
+void map_bits(Modulation m, std::span<const std::uint8_t> bits, std::span<ci16> symbols,
+              SaturationStats& stats) noexcept;
+void map_bits(Modulation m, std::span<const std::uint8_t> bits, std::span<ci8> symbols,
+              SaturationStats& stats) noexcept;
+void map_bits(Modulation m, ConstBitSpan bits, std::span<ci16> symbols,
+              SaturationStats& stats) noexcept;
+void map_bits(Modulation m, ConstBitSpan bits, std::span<ci8> symbols,
+              SaturationStats& stats) noexcept;
+
+/// Constellation mapper stage: packed coded bits in, `symbols`
+/// data-subcarrier symbols out.
+template <SampleType T>
+class BasicMapperStage final : public Stage<std::uint64_t, T> {
+public:
+    BasicMapperStage(Modulation m, std::size_t symbols, std::size_t pool_depth);
+
+    BufferView<T> process(BufferView<std::uint64_t> in) override;
+    const char* name() const noexcept override { return "mapper"; }
+
+    const SaturationStats& saturation() const noexcept { return saturation_; }
+
+private:
+    Modulation modulation_;
+    std::size_t symbols_;
+    BufferPool<T> pool_;
+    SaturationStats saturation_;
+};
+
+/// Soft demapper stage: equalised symbols in, coded-bit LLRs out.
+/// Fixed-point symbols are converted to float on the way in, in scratch
+/// taken from `arena`; its owner resets it after each block.
+template <SampleType T>
+class BasicDemapperStage final : public Stage<T, float> {
+public:
+    BasicDemapperStage(Modulation m, float noise_variance, std::size_t max_symbols,
+                       std::size_t pool_depth, FrameArena& arena);
+
+    /// Arena space one block of up to `max_symbols` symbols may take.
+    static std::size_t scratch_bytes(std::size_t max_symbols) noexcept;
+
+    BufferView<float> process(BufferView<T> in) override;
+    const char* name() const noexcept override { return "demapper"; }
+
+    void set_noise_variance(float nv) noexcept { noise_variance_ = nv; }
+
+private:
+    Modulation modulation_;
+    float noise_variance_;
+    BufferPool<float> pool_;
+    FrameArena& arena_;  // fixed-point input only
+};
+
+using MapperStage = BasicMapperStage<cf32>;
+using DemapperStage = BasicDemapperStage<cf32>;
+
+extern template class BasicMapperStage<cf32>;
+extern template class BasicMapperStage<ci16>;
+extern template class BasicMapperStage<ci8>;
+extern template class BasicDemapperStage<cf32>;
+extern template class BasicDemapperStage<ci16>;
+extern template class BasicDemapperStage<ci8>;
+
+}  // namespace dcomm
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "dcomm/channel.hpp"
+#include "dcomm/phy_config.hpp"
+
+namespace dcomm {
+
+/// Parameters of a BER/BLER sweep over an AWGN or fading channel.
+struct SweepConfig {
+    /// Chain under test. noise_variance is overridden per point so the
+    /// demapper's LLRs match the channel.
+    PhyConfig phy;
+    /// Es/N0 per data subcarrier, in dB, in sweep order.
+    std::vector<double> snr_db;
+    std::uint64_t seed = 1;
+    /// A point stops once it has counted both targets (0 = no target) ...
+    std::uint64_t target_block_errors = 100;
+    std::uint64_t target_bit_errors = 0;
+    /// ... or simulated this many blocks.
+    std::uint64_t max_blocks = 1'000'000;
+    /// Blocks per work item; the granularity of the stopping rule.
+    std::size_t batch_blocks = 16;
+    /// Threads; 0 = std::thread::hardware_concurrency().
+    std::size_t workers = 0;
+    /// Skip the remaining points once one ends without any block error.
+    bool stop_when_error_free = true;
+    /// Multipath fading ahead of the noise, a fresh realisation per block;
+    /// AWGN only when unset. Usually wants phy.equalizer = pilot_zf.
+    std::optional<FadingConfig> fading;
+};
+
+/// Counts of one SNR point.
+struct SweepPoint {
+    double snr_db = 0.0;
+    double ebn0_db = 0.0;  // same point as information-bit Eb/N0
+    std::uint64_t blocks = 0;
+    std::uint64_t bits = 0;
+    std::uint64_t bit_errors = 0;
+    std::uint64_t block_errors = 0;
+    double seconds = 0.0;
+
+    double ber() const noexcept { return bits == 0 ? 0.0 : double(bit_errors) / double(bits); }
+    double bler() const noexcept {
+        return blocks == 0 ? 0.0 : double(block_errors) / double(blocks);
+    }
+};
+
+/// Parallel Monte-Carlo BER/BLER sweep of TxChain -> channel -> RxChain.
+///
+/// Every block is an independent trial: the chains are reset before it,
+/// and its data bits, fading realisation and noise come from Philox4x32
+/// streams keyed by the seed and indexed by (point, block). Trials run in
+/// batches on a WorkStealingPool, one chain pair per worker. Batches are issued in
+/// rounds and their counts folded in block order, stopping at the first
+/// batch that meets the error targets; batches past it are discarded. A
+/// point's result is therefore a function of the configuration alone,
+/// whatever the number of threads.
+class MonteCarloSweep {
+public:
+    using PointHandler = std::function<void(const SweepPoint&)>;
+
+    /// Throws std::invalid_argument for an unusable configuration.
+    explicit MonteCarloSweep(SweepConfig config);
+
+    const SweepConfig& config() const noexcept { return config_; }
+
+    /// Run every point in order, calling `on_point` as each completes.
+    std::vector<SweepPoint> run(const PointHandler& on_point = {});
+
+private:
+    SweepConfig config_;
+};
+
+/// CSV output of a sweep, one row per point, for streaming as points
+/// complete. Rows are flushed so partial sweeps survive interruption.
+void write_csv_header(std::FILE* out);
+void write_csv_row(std::FILE* out, const SweepPoint& point);
+
+}  // namespace dcomm
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "dcomm/arena.hpp"
+#include "dcomm/equalizer.hpp"
+#include "dcomm/fft.hpp"
+#include "dcomm/phy_config.hpp"
+#include "dcomm/phy_tables.hpp"
+#include "dcomm/sample.hpp"
+#include "dcomm/stage.hpp"
+
+namespace dcomm {
+
+/// 802.11a/g 20 MHz subcarrier layout: FFT bin of each data subcarrier in
+/// transmission order (subcarriers -26..26 without DC and pilots) and of
+/// the four pilots (-21, -7, 7, 21).
+struct OfdmLayout {
+    std::array<std::uint16_t, PhyConfig::data_subcarriers> data_bins;
+    std::array<std::uint16_t, PhyConfig::pilot_subcarriers> pilot_bins;
+    /// Base pilot values before the per-symbol polarity is applied.
+    static constexpr std::array<float, PhyConfig::pilot_subcarriers> pilot_values =
+        tables::kPilotValues;
+
+    static const OfdmLayout& ieee80211();
+};
+
+/// Pilot polarity p_n of 802.11 (17.3.5.10): the scrambler sequence with an
+/// all-ones seed, 0 -> +1 and 1 -> -1, period 127.
+float pilot_polarity(std::size_t symbol_index) noexcept;
+
+/// Tx OFDM stage: places data symbols and pilots on the subcarriers, runs
+/// the IFFT and prepends the cyclic prefix. Output has unit average power
+/// (SampleTraits<T>::unit in fixed point).
+///
+/// Fixed-point symbols are transformed in Q15 with the subcarriers at
+/// twice the unit level, since the Q15 IFFT scales by 1/N, and a Q12 gain
+/// brings the result back to the unit level before it is narrowed to T.
+template <SampleType T>
+class BasicOfdmModulatorStage final : public Stage<T, T> {
+public:
+    BasicOfdmModulatorStage(std::size_t max_ofdm_symbols, std::size_t pool_depth);
+
+    BufferView<T> process(BufferView<T> in) override;
+    const char* name() const noexcept override { return "ofdm_mod"; }
+
+    /// Restart the pilot polarity sequence at p_0.
+    void reset() noexcept { symbol_index_ = 0; }
+
+    const SaturationStats& saturation() const noexcept { return saturation_; }
+
+private:
+    const FftPlan& fft_;
+    BufferPool<T> pool_;
+    std::array<ci16, PhyConfig::fft_size> scratch_{};  // fixed point only
+    std::size_t symbol_index_ = 0;
+    SaturationStats saturation_;
+};
+
+/// Rx OFDM stage: strips the cyclic prefix, runs the FFT and extracts the
+/// data subcarriers, optionally equalised through their pilots.
+///
+/// The symbols of a block are transformed in one batch, in place when the
+/// stage owns its input block and T is the working type, otherwise in
+/// scratch taken from `arena` (ci8 always widens to ci16 there). The owner
+/// of the arena resets it after each block. With
+/// Equalizer::pilot_zf the stage tracks the pilot polarity index like the
+/// modulator, so it must see every block of the stream in order.
+template <SampleType T>
+class BasicOfdmDemodulatorStage final : public Stage<T, T> {
+public:
+    using work_type = std::conditional_t<SampleTraits<T>::fixed_point, ci16, cf32>;
+
+    BasicOfdmDemodulatorStage(std::size_t max_ofdm_symbols, std::size_t pool_depth,
+                              FrameArena& arena, Equalizer equalizer = Equalizer::none);
+
+    /// Arena space one block of up to `max_ofdm_symbols` symbols may take.
+    static std::size_t scratch_bytes(std::size_t max_ofdm_symbols) noexcept;
+
+    BufferView<T> process(BufferView<T> in) override;
+    const char* name() const noexcept override { return "ofdm_demod"; }
+
+    /// Restart the pilot polarity sequence at p_0.
+    void reset() noexcept { symbol_index_ = 0; }
+
+    const PilotEqualizer<work_type>& equalizer() const noexcept { return equalizer_; }
+    const SaturationStats& saturation() const noexcept { return saturation_; }
+
+private:
+    const FftPlan& fft_;
+    Equalizer mode_;
+    PilotEqualizer<work_type> equalizer_;
+    FrameArena& arena_;  // FFT bodies when not transformed in place
+    BufferPool<T> pool_;
+    std::size_t symbol_index_ = 0;
+    SaturationStats saturation_;
+};
+
+using OfdmModulatorStage = BasicOfdmModulatorStage<cf32>;
+using OfdmDemodulatorStage = BasicOfdmDemodulatorStage<cf32>;
+
+extern template class BasicOfdmModulatorStage<cf32>;
+extern template class BasicOfdmModulatorStage<ci16>;
+extern template class BasicOfdmModulatorStage<ci8>;
+extern template class BasicOfdmDemodulatorStage<cf32>;
+extern template class BasicOfdmDemodulatorStage<ci16>;
+extern template class BasicOfdmDemodulatorStage<ci8>;
+
+}  // namespace dcomm
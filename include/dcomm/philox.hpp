@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace dcomm {
+
+/// Philox4x32-10 counter-based random number generator (Salmon et al.,
+/// "Parallel random numbers: as easy as 1, 2, 3", SC'11).
+///
+/// Output block i of a stream is a pure function of (key, counter i): ten
+/// rounds of multiply-xor over a 128-bit counter. Any number of threads
+/// can therefore draw from disjoint streams without sharing state, and a
+/// stream can be started at any offset in O(1), which is what makes
+/// parallel Monte-Carlo runs reproducible independently of the thread
+/// count. The key holds the user seed; the upper 64 counter bits select
+/// the stream and the lower 64 count blocks within it.
+///
+/// Satisfies UniformRandomBitGenerator, so it also drives the standard
+/// distributions.
+class Philox4x32 {
+public:
+    using result_type = std::uint32_t;
+    using Block = std::array<std::uint32_t, 4>;
+    using Key = std::array<std::uint32_t, 2>;
+
+    constexpr Philox4x32(std::uint64_t seed, std::uint64_t stream) noexcept
+        : key_{std::uint32_t(seed), std::uint32_t(seed >> 32)},
+          counter_{0, 0, std::uint32_t(stream), std::uint32_t(stream >> 32)} {}
+
+    /// The ten-round bijection of one counter block under `key`.
+    static constexpr Block generate(Block c, Key k) noexcept {
+        for (int round = 0; round < 10; ++round) {
+            const std::uint64_t p0 = std::uint64_t(kM0) * c[0];
+            const std::uint64_t p1 = std::uint64_t(kM1) * c[2];
+            c = {std::uint32_t(p1 >> 32) ^ c[1] ^ k[0], std::uint32_t(p1),
+                 std::uint32_t(p0 >> 32) ^ c[3] ^ k[1], std::uint32_t(p0)};
+            k = {k[0] + kW0, k[1] + kW1};
+        }
+        return c;
+    }
+
+    /// Next four outputs of the stream.
+    constexpr Block next_block() noexcept {
+        const Block out = generate(counter_, key_);
+        if (++counter_[0] == 0) {
+            ++counter_[1];
+        }
+        return out;
+    }
+
+    constexpr result_type operator()() noexcept {
+        if (used_ == 4) {
+            buffer_ = next_block();
+            used_ = 0;
+        }
+        return buffer_[used_++];
+    }
+
+    /// Skip `blocks` blocks of four outputs; buffered outputs are dropped.
+    constexpr void discard_blocks(std::uint64_t blocks) noexcept {
+        const std::uint64_t c = (std::uint64_t(counter_[1]) << 32 | counter_[0]) + blocks;
+        counter_[0] = std::uint32_t(c);
+        counter_[1] = std::uint32_t(c >> 32);
+        used_ = 4;
+    }
+
+    /// Uniform float in (0, 1], never 0, from the top 24 bits of `u`.
+    static constexpr float to_unit_open(std::uint32_t u) noexcept {
+        return float((u >> 8) + 1) * (1.0f / 16777216.0f);
+    }
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept {
+        return std::numeric_limits<result_type>::max();
+    }
+
+private:
+    static constexpr std::uint32_t kM0 = 0xD2511F53u;
+    static constexpr std::uint32_t kM1 = 0xCD9E8D57u;
+    static constexpr std::uint32_t kW0 = 0x9E3779B9u;  // golden ratio
+    static constexpr std::uint32_t kW1 = 0xBB67AE85u;  // sqrt(3) - 1
+
+    Key key_;
+    Block counter_;
+    Block buffer_{};
+    unsigned used_ = 4;
+};
+
+}  // namespace dcomm
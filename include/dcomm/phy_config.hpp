@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dcomm {
+
+/// Square Gray-coded constellations of 802.11a/g/n/ac.
+enum class Modulation : std::uint8_t {
+    bpsk,
+    qpsk,
+    qam16,
+    qam64,
+    qam256,
+};
+
+/// Coded bits carried by one constellation symbol.
+constexpr unsigned bits_per_symbol(Modulation m) noexcept {
+    switch (m) {
+    case Modulation::bpsk: return 1;
+    case Modulation::qpsk: return 2;
+    case Modulation::qam16: return 4;
+    case Modulation::qam64: return 6;
+    case Modulation::qam256: return 8;
+    }
+    return 0;
+}
+
+const char* to_string(Modulation m) noexcept;
+
+/// Convolutional code rates of 802.11a/g: the rate-1/2 mother code and its
+/// punctured 2/3 and 3/4 variants.
+enum class CodeRate : std::uint8_t {
+    r1_2,
+    r2_3,
+    r3_4,
+};
+
+/// Rate as numerator / denominator.
+constexpr unsigned code_rate_numerator(CodeRate r) noexcept {
+    switch (r) {
+    case CodeRate::r1_2: return 1;
+    case CodeRate::r2_3: return 2;
+    case CodeRate::r3_4: return 3;
+    }
+    return 0;
+}
+constexpr unsigned code_rate_denominator(CodeRate r) noexcept {
+    switch (r) {
+    case CodeRate::r1_2: return 2;
+    case CodeRate::r2_3: return 3;
+    case CodeRate::r3_4: return 4;
+    }
+    return 0;
+}
+
+const char* to_string(CodeRate r) noexcept;
+
+/// Channel correction applied by the Rx OFDM demodulator.
+enum class Equalizer : std::uint8_t {
+    none,      ///< fixed Rx gain only, for an AWGN channel
+    pilot_zf,  ///< per-block pilot channel estimate, one-tap zero forcing
+};
+
+const char* to_string(Equalizer e) noexcept;
+
+/// Parameters shared by the Tx and Rx chains.
+///
+/// The OFDM numerology is the 802.11a/g 20 MHz one: 64-point FFT, 16-sample
+/// cyclic prefix, 48 data and 4 pilot subcarriers. Each block is a whole
+/// number of OFDM symbols and carries one terminated codeword of the K=7
+/// convolutional code, punctured to `code_rate`. Every supported rate divides
+/// N_CBPS exactly, so the codeword always fills the block.
+struct PhyConfig {
+    Modulation modulation = Modulation::qam16;
+    CodeRate code_rate = CodeRate::r1_2;
+    Equalizer equalizer = Equalizer::none;
+    /// Run coded bits through the 802.11 per-symbol interleaver. It spreads
+    /// a faded subcarrier's bits across the codeword; over AWGN the chain
+    /// decodes a little better without it, hence off by default.
+    bool interleave = false;
+    /// OFDM symbols per pipeline block.
+    std::size_t symbols_per_block = 8;
+    /// Buffers per stage pool; bounds the number of blocks in flight.
+    std::size_t pool_depth = 4;
+    /// Initial state of the 7-bit 802.11 scrambler (must be non-zero).
+    std::uint8_t scrambler_seed = 0x5d;
+    /// Noise variance per data subcarrier assumed by the soft demapper.
+    float noise_variance = 0.1f;
+
+    static constexpr std::size_t fft_size = 64;
+    static constexpr std::size_t cp_length = 16;
+    static constexpr std::size_t data_subcarriers = 48;
+    static constexpr std::size_t pilot_subcarriers = 4;
+    static constexpr unsigned code_memory = 6;
+
+    /// Coded bits per OFDM symbol (N_CBPS).
+    constexpr std::size_t coded_bits_per_ofdm_symbol() const noexcept {
+        return data_subcarriers * bits_per_symbol(modulation);
+    }
+    constexpr std::size_t coded_bits_per_block() const noexcept {
+        return coded_bits_per_ofdm_symbol() * symbols_per_block;
+    }
+    /// Information bits per block, i.e. the codeword minus its tail.
+    constexpr std::size_t info_bits_per_block() const noexcept {
+        return coded_bits_per_block() * code_rate_numerator(code_rate) /
+                   code_rate_denominator(code_rate) -
+               code_memory;
+    }
+    constexpr std::size_t constellation_symbols_per_block() const noexcept {
+        return data_subcarriers * symbols_per_block;
+    }
+    constexpr std::size_t samples_per_block() const noexcept {
+        return (fft_size + cp_length) * symbols_per_block;
+    }
+
+    /// Throws std::invalid_argument if the configuration is unusable.
+    void validate() const;
+};
+
+}  // namespace dcomm
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "dcomm/phy_config.hpp"
+
+// Tables of the 802.11a/g 20 MHz PHY computed at compile time. Everything
+// here is constexpr, so the tables are emitted into .rodata and nothing is
+// generated at startup; the runtime factories (OfdmLayout::ieee80211(),
+// pilot_polarity(), BlockInterleaver::ieee80211()) hand out the same values.
+
+namespace dcomm::tables {
+
+inline constexpr std::size_t kFftSize = PhyConfig::fft_size;
+inline constexpr std::size_t kCpLength = PhyConfig::cp_length;
+inline constexpr std::size_t kSymbolLength = kFftSize + kCpLength;
+inline constexpr std::size_t kDataSubcarriers = PhyConfig::data_subcarriers;
+inline constexpr std::size_t kPilotSubcarriers = PhyConfig::pilot_subcarriers;
+inline constexpr std::size_t kUsedSubcarriers = kDataSubcarriers + kPilotSubcarriers;
+
+/// Tx IFFT gain 1/sqrt(52) giving unit average power, and the Rx gain
+/// sqrt(52)/64 undoing it together with the unscaled forward FFT.
+inline constexpr float kTxScale = float(0.13867504905630728);
+inline constexpr float kRxScale = float(7.2111025509279782 / 64.0);
+
+constexpr std::uint16_t fft_bin(int subcarrier) noexcept {
+    return std::uint16_t(subcarrier < 0 ? subcarrier + int(kFftSize) : subcarrier);
+}
+
+/// FFT bin of each data subcarrier in transmission order (-26..26 without
+/// DC and the pilots).
+inline constexpr std::array<std::uint16_t, kDataSubcarriers> kDataBins = [] {
+    std::array<std::uint16_t, kDataSubcarriers> bins{};
+    std::size_t d = 0;
+    for (int k = -26; k <= 26; ++k) {
+        if (k != 0 && k != -21 && k != -7 && k != 7 && k != 21) {
+            bins[d++] = fft_bin(k);
+        }
+    }
+    return bins;
+}();
+
+/// FFT bins of the pilots at -21, -7, 7 and 21.
+inline constexpr std::array<std::uint16_t, kPilotSubcarriers> kPilotBins = {
+    fft_bin(-21), fft_bin(-7), fft_bin(7), fft_bin(21)};
+
+/// Base pilot values before the per-symbol polarity is applied.
+inline constexpr std::array<float, kPilotSubcarriers> kPilotValues = {1.0f, 1.0f, 1.0f, -1.0f};
+
+/// Pilot polarity p_n (17.3.5.10): the scrambler sequence from the all-ones
+/// state, 0 -> +1 and 1 -> -1, period 127.
+inline constexpr std::array<float, 127> kPilotPolarity = [] {
+    std::array<float, 127> p{};
+    unsigned state = 0x7f;
+    for (float& v : p) {
+        const unsigned fb = ((state >> 6) ^ (state >> 3)) & 1u;
+        state = ((state << 1) | fb) & 0x7fu;
+        v = fb != 0 ? -1.0f : 1.0f;
+    }
+    return p;
+}();
+
+/// The 802.11 interleaver (17.3.5.7) of N_CBPS bits with N_BPSC bits per
+/// subcarrier, as out[j] = in[source[j]]; see BlockInterleaver.
+template <std::size_t NCbps, unsigned NBpsc>
+inline constexpr std::array<std::uint16_t, NCbps> kInterleaverSource = [] {
+    static_assert(NCbps % 16 == 0 && NCbps % NBpsc == 0, "bad N_CBPS / N_BPSC");
+    constexpr std::size_t s = NBpsc / 2 > 1 ? NBpsc / 2 : 1;
+    std::array<std::uint16_t, NCbps> source{};
+    for (std::size_t k = 0; k < NCbps; ++k) {
+        const std::size_t i = (NCbps / 16) * (k % 16) + k / 16;
+        const std::size_t j = s * (i / s) + (i + NCbps - (16 * i / NCbps)) % s;
+        source[j] = std::uint16_t(k);
+    }
+    return source;
+}();
+
+/// Its inverse: in[i] = out[target[i]].
+template <std::size_t NCbps, unsigned NBpsc>
+inline constexpr std::array<std::uint16_t, NCbps> kInterleaverTarget = [] {
+    std::array<std::uint16_t, NCbps> target{};
+    for (std::size_t j = 0; j < NCbps; ++j) {
+        target[kInterleaverSource<NCbps, NBpsc>[j]] = std::uint16_t(j);
+    }
+    return target;
+}();
+
+/// Compile-time parameters of one modulation and coding scheme.
+template <Modulation M, CodeRate R>
+struct Mcs {
+    static constexpr Modulation modulation = M;
+    static constexpr CodeRate code_rate = R;
+    static constexpr unsigned n_bpsc = bits_per_symbol(M);
+    static constexpr std::size_t n_cbps = kDataSubcarriers * n_bpsc;
+    /// Data bits per OFDM symbol before the tail is taken off.
+    static constexpr std::size_t n_dbps =
+        n_cbps * code_rate_numerator(R) / code_rate_denominator(R);
+
+    static constexpr const auto& interleaver_source = kInterleaverSource<n_cbps, n_bpsc>;
+    static constexpr const auto& interleaver_target = kInterleaverTarget<n_cbps, n_bpsc>;
+};
+
+}  // namespace dcomm::tables
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "dcomm/arena.hpp"
+#include "dcomm/buffer.hpp"
+#include "dcomm/convcode.hpp"
+#include "dcomm/instrument.hpp"
+#include "dcomm/interleaver.hpp"
+#include "dcomm/modulation.hpp"
+#include "dcomm/ofdm.hpp"
+#include "dcomm/phy_config.hpp"
+#include "dcomm/sample.hpp"
+#include "dcomm/scrambler.hpp"
+
+namespace dcomm {
+
+/// Streaming transmitter: data bits to time-domain baseband samples.
+///
+///   scrambler -> conv encoder -> [interleaver] -> mapper -> OFDM modulator
+///
+/// Blocks travel between stages as pooled views; the only per-block work
+/// besides the DSP itself is a handful of reference-count updates. Bits
+/// stay packed (bits.hpp) up to the mapper. The producer fills blocks
+/// obtained from acquire_input() so the data stream enters the chain
+/// without a copy. T is the sample type from the mapper
+/// on (see sample.hpp); TxChain is the float chain. The interleaver runs
+/// only with PhyConfig::interleave.
+///
+/// Every stage call is charged to a StageProbe (instrument.hpp); with
+/// DCOMM_INSTRUMENTATION off the probes compile to nothing.
+template <SampleType T>
+class BasicTxChain {
+public:
+    explicit BasicTxChain(const PhyConfig& config);
+
+    const PhyConfig& config() const noexcept { return config_; }
+
+    /// An input block of packed_words(info_bits_per_block()) words, or empty
+    /// if all input buffers are still in flight. Padding bits are ignored.
+    BufferView<std::uint64_t> acquire_input() noexcept { return input_pool_.acquire(); }
+
+    /// Run one block through every stage. Returns an empty view on
+    /// back-pressure.
+    BufferView<T> process(BufferView<std::uint64_t> bits);
+
+    /// Start a new stream: rewind the scrambler to its seed and the pilot
+    /// polarity sequence to p_0.
+    void reset() noexcept;
+
+    ScramblerStage& scrambler() noexcept { return scrambler_; }
+    ConvEncoderStage& encoder() noexcept { return encoder_; }
+    InterleaverStage& interleaver() noexcept { return interleaver_; }
+    BasicMapperStage<T>& mapper() noexcept { return mapper_; }
+    BasicOfdmModulatorStage<T>& modulator() noexcept { return modulator_; }
+
+    /// Clipping in the fixed-point stages so far (always zero for float).
+    SaturationStats saturation() const noexcept;
+
+    /// Per-stage counters in chain order; samples are baseband samples.
+    std::vector<StageStats> stage_stats() const;
+    void clear_stage_stats() noexcept;
+    /// Log every stage call to `trace` from now on (nullptr to stop).
+    void attach_trace(TraceRing* trace) noexcept;
+
+private:
+    PhyConfig config_;
+    std::array<StageProbe, 5> probes_;
+    BufferPool<std::uint64_t> input_pool_;
+    ScramblerStage scrambler_;
+    ConvEncoderStage encoder_;
+    InterleaverStage interleaver_;
+    BasicMapperStage<T> mapper_;
+    BasicOfdmModulatorStage<T> modulator_;
+};
+
+/// Streaming receiver: time-domain samples back to data bits.
+///
+///   OFDM demodulator (+ equaliser) -> soft demapper -> [deinterleaver]
+///   -> Viterbi decoder -> descrambler
+///
+/// T is the sample type up to the demapper; RxChain is the float chain.
+/// Decoded blocks come out packed, like TxChain's input.
+///
+/// Scratch the stages need within a block comes from a FrameArena that
+/// process() resets after every block. By default the chain owns one of
+/// scratch_bytes(config); a thread running several chains can share one
+/// arena sized for the largest of their configurations instead. Either way
+/// arena().heap_allocations() stays zero.
+template <SampleType T>
+class BasicRxChain {
+public:
+    explicit BasicRxChain(const PhyConfig& config);
+    /// Take scratch from `arena`, which must outlive the chain and hold at
+    /// least scratch_bytes(config); throws std::invalid_argument otherwise.
+    BasicRxChain(const PhyConfig& config, FrameArena& arena);
+
+    /// Arena capacity one block of `config` needs.
+    static std::size_t scratch_bytes(const PhyConfig& config) noexcept;
+
+    const PhyConfig& config() const noexcept { return config_; }
+
+    /// A sample block sized to samples_per_block(), for sources that write
+    /// received samples straight into pooled memory.
+    BufferView<T> acquire_input() noexcept { return input_pool_.acquire(); }
+    /// The pool behind acquire_input(), e.g. to place it on the NUMA node of
+    /// the thread running the chain (scheduler.hpp).
+    BufferPool<T>& input_pool() noexcept { return input_pool_; }
+
+    BufferView<std::uint64_t> process(BufferView<T> samples);
+
+    /// Start a new stream, matching BasicTxChain::reset().
+    void reset() noexcept;
+
+    BasicOfdmDemodulatorStage<T>& demodulator() noexcept { return demodulator_; }
+    BasicDemapperStage<T>& demapper() noexcept { return demapper_; }
+    DeinterleaverStage& deinterleaver() noexcept { return deinterleaver_; }
+    ViterbiStage& decoder() noexcept { return decoder_; }
+    DescramblerStage& descrambler() noexcept { return descrambler_; }
+
+    SaturationStats saturation() const noexcept { return demodulator_.saturation(); }
+
+    FrameArena& arena() noexcept { return arena_; }
+    const FrameArena& arena() const noexcept { return arena_; }
+
+    /// Per-stage counters in chain order, as for BasicTxChain.
+    std::vector<StageStats> stage_stats() const;
+    void clear_stage_stats() noexcept;
+    void attach_trace(TraceRing* trace) noexcept;
+    /// Charge cycles the caller spent waiting for an input block to the
+    /// first stage.
+    void record_input_wait(std::uint64_t cycles) noexcept { probes_[0].add_wait(cycles); }
+
+private:
+    BasicRxChain(const PhyConfig& config, FrameArena* shared);
+
+    PhyConfig config_;
+    std::array<StageProbe, 5> probes_;
+    FrameArena own_arena_;  // empty when the arena is shared
+    FrameArena& arena_;
+    BufferPool<T> input_pool_;
+    BasicOfdmDemodulatorStage<T> demodulator_;
+    BasicDemapperStage<T> demapper_;
+    DeinterleaverStage deinterleaver_;
+    ViterbiStage decoder_;
+    DescramblerStage descrambler_;
+};
+
+using TxChain = BasicTxChain<cf32>;
+using RxChain = BasicRxChain<cf32>;
+
+extern template class BasicTxChain<cf32>;
+extern template class BasicTxChain<ci16>;
+extern template class BasicTxChain<ci8>;
+extern template class BasicRxChain<cf32>;
+extern template class BasicRxChain<ci16>;
+extern template class BasicRxChain<ci8>;
+
+}  // namespace dcomm
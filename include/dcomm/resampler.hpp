@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+namespace kernels {
+struct ResamplerKernels;
+}
+
+/// Anti-aliasing / anti-imaging filter specification shared by the
+/// resamplers. Filters are Kaiser-windowed sincs designed at construction,
+/// as short as the specification allows.
+struct ResamplerConfig {
+    /// Passband edge as a fraction of the lower of the two Nyquist rates;
+    /// the stopband starts at that Nyquist rate. The default keeps the
+    /// 802.11 occupied band (0.81 of Nyquist) in the passband.
+    double passband = 0.85;
+    /// Stopband attenuation, in dB.
+    double stopband_db = 80.0;
+};
+
+/// Output rate / input rate as a reduced fraction.
+struct ResampleRatio {
+    std::uint32_t up = 1;
+    std::uint32_t down = 1;
+};
+
+/// up/down = out_rate / in_rate, e.g. {625, 768} for 30.72 -> 25 Msps.
+/// Throws std::invalid_argument unless the ratio is a fraction with
+/// up <= PolyphaseResampler::kMaxPhases and a denominator below 2^20.
+ResampleRatio resample_ratio(double in_rate, double out_rate);
+
+/// Rational resampler by up/down as a polyphase FIR.
+///
+/// The prototype low-pass runs at up times the input rate; it is stored
+/// as `up` phases of taps_per_phase() taps each, time-reversed and with
+/// every tap duplicated for the re and im floats, so each output sample is
+/// one contiguous dot product over the input history, whichever phase it
+/// falls on. Per-phase successor and input-advance tables replace the
+/// division of the output time by `up`. The filter has unit passband gain.
+///
+/// Blocks of any size may be passed; the history and the output phase
+/// carry over between calls, so a stream split into blocks resamples
+/// exactly as if passed whole. The history buffer grows to the largest
+/// block seen and is reused after that.
+class PolyphaseResampler {
+public:
+    static constexpr std::uint32_t kMaxPhases = 4096;
+
+    /// Throws std::invalid_argument for a zero, oversized or unusable ratio
+    /// or filter specification.
+    PolyphaseResampler(ResampleRatio ratio, const ResamplerConfig& config = {});
+    PolyphaseResampler(ResampleRatio ratio, const ResamplerConfig& config, Isa isa);
+
+    /// Output samples the next process() call yields for `input` samples.
+    std::size_t output_size(std::size_t input) const noexcept;
+
+    /// Resample `in` into the front of `out`, which must hold at least
+    /// output_size(in.size()) samples; returns the number written.
+    std::size_t process(std::span<const cf32> in, std::span<cf32> out);
+
+    /// Clear the history and restart at output phase 0.
+    void reset() noexcept;
+
+    ResampleRatio ratio() const noexcept { return {up_, down_}; }
+    std::size_t taps_per_phase() const noexcept { return taps_; }
+    /// Group delay, in output samples.
+    double delay() const noexcept;
+
+private:
+    const kernels::ResamplerKernels* kernels_;
+    std::uint32_t up_;
+    std::uint32_t down_;
+    std::size_t taps_;                    // per phase, a multiple of kernels::kDotTaps
+    std::vector<float> phases_;           // up_ x 2 * taps_, reversed and duplicated
+    std::vector<std::uint32_t> next_phase_;  // phase of the following output
+    std::vector<std::uint32_t> advance_;     // input samples to skip to it
+    std::vector<cf32> history_;           // taps_ - 1 past inputs, then the block
+    std::size_t offset_ = 0;              // window start of the next output
+    std::uint32_t phase_ = 0;
+};
+
+enum class HalfbandMode : std::uint8_t {
+    interpolate,  ///< x2 per stage, baseband to converter rate
+    decimate,     ///< /2 per stage, converter rate to baseband
+};
+
+/// Interpolation or decimation by 2^stages as a cascade of half-band
+/// filters, e.g. two stages for 20 <-> 80 Msps.
+///
+/// A half-band filter has every other tap zero and a centre tap of 1/2,
+/// so each stage is a dense FIR on one polyphase branch plus a pure delay
+/// on the other: about a quarter of the multiplies of a general filter of
+/// the same length, and the dense branch runs on consecutive samples, the
+/// FIR kernel's register-blocked form. Each stage is designed for its own
+/// rate: only the one next to baseband needs the sharp transition set by
+/// the passband, so the stages towards the converter are much shorter.
+/// The cascade has unit passband gain.
+///
+/// State carries over between process() calls; a decimating cascade holds
+/// back a sample whenever a stage sees an odd total.
+class HalfbandCascade {
+public:
+    /// Throws std::invalid_argument for 0 or more than 8 stages or an
+    /// unusable filter specification.
+    HalfbandCascade(HalfbandMode mode, std::size_t stages, const ResamplerConfig& config = {});
+    HalfbandCascade(HalfbandMode mode, std::size_t stages, const ResamplerConfig& config,
+                    Isa isa);
+
+    /// Output samples the next process() call yields for `input` samples.
+    std::size_t output_size(std::size_t input) const noexcept;
+
+    /// Resample `in` into the front of `out`, which must hold at least
+    /// output_size(in.size()) samples; returns the number written.
+    std::size_t process(std::span<const cf32> in, std::span<cf32> out);
+
+    void reset() noexcept;
+
+    HalfbandMode mode() const noexcept { return mode_; }
+    std::size_t stages() const noexcept { return stages_.size(); }
+    /// Dense-branch taps of each stage, baseband side first.
+    std::vector<std::size_t> stage_taps() const;
+    /// Group delay, in output samples.
+    double delay() const noexcept;
+
+private:
+    struct Stage {
+        std::vector<float> taps;     // dense branch, time-reversed
+        std::vector<cf32> history;   // taps.size() - 1 past inputs, then the block
+        std::vector<cf32> odd;       // decimation: delay-branch history, then the block
+        std::vector<cf32> dense;     // interpolation: dense-branch outputs
+        bool pending = false;        // decimation: the odd sample of a pair is due
+    };
+
+    std::size_t interpolate(Stage& s, std::span<const cf32> in, cf32* out);
+    std::size_t decimate(Stage& s, std::span<const cf32> in, cf32* out);
+
+    const kernels::ResamplerKernels* kernels_;
+    HalfbandMode mode_;
+    std::vector<Stage> stages_;      // in processing order
+    std::vector<cf32> scratch_[2];   // ping-pong between stages
+};
+
+}  // namespace dcomm
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+/// Properties of the sample types a chain can be instantiated with.
+///
+/// Fixed-point samples represent the unit-power signal level by `unit`,
+/// leaving 12 dB of headroom for OFDM peaks and channel gain. The ci8 scale
+/// equals the ci16 one shifted right by 8, so fixed-point stages compute in
+/// ci16 and only narrow on output.
+template <class T>
+struct SampleTraits;
+
+template <>
+struct SampleTraits<cf32> {
+    using component = float;
+    static constexpr bool fixed_point = false;
+    static constexpr float unit = 1.0f;
+    static constexpr const char* name = "cf32";
+};
+
+template <>
+struct SampleTraits<ci16> {
+    using component = std::int16_t;
+    static constexpr bool fixed_point = true;
+    static constexpr float unit = 8192.0f;  // Q13
+    static constexpr int shift = 0;         // ci16 = value << shift
+    static constexpr const char* name = "ci16";
+};
+
+template <>
+struct SampleTraits<ci8> {
+    using component = std::int8_t;
+    static constexpr bool fixed_point = true;
+    static constexpr float unit = 32.0f;  // Q5
+    static constexpr int shift = 8;
+    static constexpr const char* name = "ci8";
+};
+
+template <class T>
+concept SampleType = std::same_as<T, cf32> || std::same_as<T, ci16> || std::same_as<T, ci8>;
+
+template <class T>
+concept FixedSample = SampleType<T> && SampleTraits<T>::fixed_point;
+
+/// Saturation counters of a fixed-point stage. `values` counts real
+/// components written, `saturated` those that had to be clipped.
+struct SaturationStats {
+    std::uint64_t values = 0;
+    std::uint64_t saturated = 0;
+
+    double rate() const noexcept {
+        return values == 0 ? 0.0 : double(saturated) / double(values);
+    }
+    SaturationStats& operator+=(const SaturationStats& o) noexcept {
+        values += o.values;
+        saturated += o.saturated;
+        return *this;
+    }
+};
+
+/// Clip `v` to the component range of T, counting clipped values.
+template <FixedSample T>
+constexpr typename SampleTraits<T>::component saturate(std::int32_t v,
+                                                       std::uint64_t& saturated) noexcept {
+    using C = typename SampleTraits<T>::component;
+    constexpr std::int32_t hi = std::numeric_limits<C>::max();
+    constexpr std::int32_t lo = std::numeric_limits<C>::min();
+    // Branch-free so that loops over it vectorise.
+    const std::int32_t c = v < lo ? lo : (v > hi ? hi : v);
+    saturated += c != v;
+    return C(c);
+}
+
+/// ci16 working value of a fixed-point sample.
+template <FixedSample T>
+constexpr ci16 widen(T s) noexcept {
+    constexpr int sh = SampleTraits<T>::shift;
+    return {std::int16_t(s.re * (1 << sh)), std::int16_t(s.im * (1 << sh))};
+}
+
+/// Round a ci16-scaled value to T and saturate.
+template <FixedSample T>
+constexpr T narrow(std::int32_t re, std::int32_t im, std::uint64_t& saturated) noexcept {
+    constexpr int sh = SampleTraits<T>::shift;
+    if constexpr (sh > 0) {
+        re = (re + (1 << (sh - 1))) >> sh;
+        im = (im + (1 << (sh - 1))) >> sh;
+    }
+    return {saturate<T>(re, saturated), saturate<T>(im, saturated)};
+}
+
+/// Float to fixed point at SampleTraits<T>::unit, rounding to nearest.
+template <FixedSample T>
+void quantize(std::span<const cf32> in, std::span<T> out, SaturationStats& stats) noexcept {
+    constexpr float u = SampleTraits<T>::unit;
+    std::uint64_t saturated = 0;
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        const float re = std::nearbyint(in[i].real() * u);
+        const float im = std::nearbyint(in[i].imag() * u);
+        // Clamp in float first so the int conversion is always defined.
+        out[i] = {saturate<T>(std::int32_t(std::fmax(std::fmin(re, 1e9f), -1e9f)), saturated),
+                  saturate<T>(std::int32_t(std::fmax(std::fmin(im, 1e9f), -1e9f)), saturated)};
+    }
+    stats.values += 2 * in.size();
+    stats.saturated += saturated;
+}
+
+/// Fixed point back to float, unit level 1.0.
+template <FixedSample T>
+void dequantize(std::span<const T> in, std::span<cf32> out) noexcept {
+    constexpr float inv = 1.0f / SampleTraits<T>::unit;
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        out[i] = cf32(float(in[i].re) * inv, float(in[i].im) * inv);
+    }
+}
+
+}  // namespace dcomm
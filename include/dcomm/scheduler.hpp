@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dcomm/affinity.hpp"
+#include "dcomm/buffer.hpp"
+#include "dcomm/stage.hpp"
+#include "dcomm/thread_pool.hpp"
+
+namespace dcomm {
+
+/// How an idle pipeline thread waits for work: busy-spin first (lowest
+/// wake-up latency), then yield the core, then sleep with exponential
+/// backoff up to `max_sleep` so a quiet stage stops burning a core.
+struct WaitPolicy {
+    unsigned spin = 4096;
+    unsigned yield = 64;
+    std::chrono::microseconds max_sleep{500};
+};
+
+/// Idle-loop helper implementing WaitPolicy. Call idle() after every poll
+/// that found nothing to do and reset() after one that did.
+class AdaptiveWaiter {
+public:
+    explicit AdaptiveWaiter(const WaitPolicy& policy = {}) noexcept : policy_(policy) {}
+
+    void idle() noexcept;
+    void reset() noexcept { idle_ = 0; sleep_ = std::chrono::microseconds(1); }
+
+    /// Idle calls that ended in a sleep, since construction.
+    std::uint64_t sleeps() const noexcept { return sleeps_; }
+
+private:
+    WaitPolicy policy_;
+    std::uint64_t idle_ = 0;
+    std::chrono::microseconds sleep_{1};
+    std::uint64_t sleeps_ = 0;
+};
+
+/// Counters of one scheduled task. Snapshots only while it runs.
+struct TaskStats {
+    std::string name;
+    int cpu = -1;           ///< -1: unpinned
+    int node = 0;           ///< NUMA node of `cpu`
+    bool pinned = false;    ///< pinning succeeded
+    std::uint64_t busy_polls = 0;
+    std::uint64_t idle_polls = 0;
+    std::uint64_t sleeps = 0;
+};
+
+/// Maps pipeline tasks onto pinned threads.
+///
+/// A task is one poll of a stage (or group of stages) wired between
+/// SpscRings: it moves whatever input is ready through its stages and
+/// returns true, or returns false when it found nothing to do, in which
+/// case its thread waits per the WaitPolicy. Every task gets its own
+/// thread, pinned to the CPU it was added with, from start() until stop().
+///
+/// Buffers should live on the NUMA node of the thread that reads them:
+/// place_for() moves a pool's pages next to a task's CPU. Call it before
+/// start(), while nothing has been acquired from the pool.
+class PipelineScheduler {
+public:
+    using Task = std::function<bool()>;
+
+    explicit PipelineScheduler(const WaitPolicy& policy = {}) : policy_(policy) {}
+    ~PipelineScheduler() { stop(); }
+
+    PipelineScheduler(const PipelineScheduler&) = delete;
+    PipelineScheduler& operator=(const PipelineScheduler&) = delete;
+
+    /// Register `task` to run on logical CPU `cpu` (-1: let the OS place
+    /// it). Returns the task's index. Only before start().
+    std::size_t add(std::string name, int cpu, Task task);
+
+    /// NUMA node the task's thread runs on.
+    int node_of(std::size_t task) const { return tasks_.at(task)->node; }
+
+    /// Move `pool` to the node of `consumer`. Returns false if the memory
+    /// stays where it is (no NUMA, or the pool is smaller than a page).
+    template <class T>
+    bool place_for(BufferPool<T>& pool, std::size_t consumer) {
+        return bind_to_numa_node(pool.storage(), node_of(consumer));
+    }
+
+    void start();
+    /// Ask every task to finish its current poll, then join the threads.
+    void stop();
+    bool running() const noexcept { return !threads_.empty(); }
+
+    std::vector<TaskStats> stats() const;
+
+    /// `count` CPUs for a pipeline of `count` tasks, one per core, filling
+    /// NUMA node `node` first so neighbouring stages share a node; wraps
+    /// around when there are fewer CPUs than tasks.
+    static std::vector<int> spread(std::size_t count, int node = 0);
+
+private:
+    struct Entry {
+        std::string name;
+        int cpu;
+        int node;
+        Task task;
+        std::atomic<bool> pinned{false};
+        std::atomic<std::uint64_t> busy{0};
+        std::atomic<std::uint64_t> idle{0};
+        std::atomic<std::uint64_t> sleeps{0};
+    };
+
+    void run(Entry& e);
+
+    WaitPolicy policy_;
+    std::vector<std::unique_ptr<Entry>> tasks_;
+    std::vector<std::thread> threads_;
+    std::atomic<bool> stop_{false};
+};
+
+/// A stateless stage fanned out over a WorkStealingPool, in order.
+///
+/// Holds one replica of the stage per pool worker (stages keep per-call
+/// scratch and output pools, so replicas are never shared). process()
+/// runs a batch of independent blocks, e.g. the codeblocks or OFDM blocks
+/// of several frames, across the pool and writes each result to the same
+/// position it came from, so downstream stateful stages see the original
+/// order. A block whose replica hits back-pressure yields an empty view in
+/// its position.
+template <class In, class Out>
+class OrderedFanOut {
+public:
+    using Replica = std::unique_ptr<Stage<In, Out>>;
+
+    /// `make()` builds one replica; it is called pool.size() times.
+    OrderedFanOut(WorkStealingPool& pool, const std::function<Replica()>& make) : pool_(&pool) {
+        replicas_.reserve(pool.size());
+        for (std::size_t i = 0; i < pool.size(); ++i) {
+            replicas_.push_back(make());
+        }
+    }
+
+    std::size_t replicas() const noexcept { return replicas_.size(); }
+
+    /// out[i] = stage(in[i]) for every i; the inputs are consumed.
+    void process(std::span<BufferView<In>> in, std::span<BufferView<Out>> out) {
+        if (out.size() < in.size()) {
+            throw std::invalid_argument("OrderedFanOut: output span too small");
+        }
+        if (in.size() == 1) {
+            out[0] = replicas_[0]->process(std::move(in[0]));
+            return;
+        }
+        pool_->run(in.size(), [&](std::size_t i, std::size_t worker) {
+            out[i] = replicas_[worker]->process(std::move(in[i]));
+        });
+    }
+
+private:
+    WorkStealingPool* pool_;
+    std::vector<Replica> replicas_;
+};
+
+}  // namespace dcomm
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "dcomm/bits.hpp"
+#include "dcomm/stage.hpp"
+
+namespace dcomm {
+
+/// 802.11 frame-synchronous scrambler, generator x^7 + x^4 + 1.
+///
+/// The same object descrambles: applying the sequence twice restores the
+/// input. The LFSR state carries over between calls so a stream split into
+/// blocks scrambles exactly like one long frame.
+///
+/// The generator is an m-sequence of period 127, so apply() does not step
+/// the LFSR: it finds the state's position in one precomputed period, XORs
+/// whole blocks against the table and reads the state at the new position
+/// back. Packed bits take one XOR per 64-bit word against the table word
+/// starting at the current phase. next_bit() still steps the register.
+///
+/// Only the low seven bits of a seed are used; they must not all be zero,
+/// the one state the register never leaves (std::invalid_argument).
+class Scrambler {
+public:
+    explicit Scrambler(std::uint8_t seed) { reset(seed); }
+
+    void reset(std::uint8_t seed);
+    std::uint8_t state() const noexcept { return state_; }
+
+    /// Next bit of the scrambling sequence.
+    std::uint8_t next_bit() noexcept {
+        const std::uint8_t fb = ((state_ >> 6) ^ (state_ >> 3)) & 1;
+        state_ = std::uint8_t(((state_ << 1) | fb) & 0x7f);
+        return fb;
+    }
+
+    /// out[i] = in[i] ^ sequence[i]. `in` and `out` may be the same range.
+    void apply(std::span<const std::uint8_t> in,
+               std::span<std::uint8_t> out) noexcept;
+
+    /// The same on packed bits (see bits.hpp); out.size() == in.size().
+    void apply(ConstBitSpan in, BitSpan out) noexcept;
+
+private:
+    std::uint8_t state_ = 0;
+};
+
+/// Length-31 Gold sequence c(n) of TS 38.211 5.2.1, behind every NR
+/// scrambler: c(n) = x1(n + 1600) + x2(n + 1600), x2 preset to c_init.
+///
+/// The sequence is produced 64 bits at a time. Squaring a GF(2) generator
+/// twice gives a recurrence of the same sequence whose lags (112 to 124)
+/// all reach past the previous word, so each word is a few shifts and
+/// XORs of the two before it. reset() jumps over the first 1600 outputs
+/// with precomputed states: x1 is always the same and x2 depends linearly
+/// on c_init, one table entry per bit.
+class GoldSequence {
+public:
+    explicit GoldSequence(std::uint32_t c_init) noexcept { reset(c_init); }
+
+    /// Restart at c(0) for `c_init` (31 bits).
+    void reset(std::uint32_t c_init) noexcept;
+
+    /// Next `count` (1..64) bits of the sequence, the first in bit 0.
+    std::uint64_t next_bits(unsigned count) noexcept;
+
+    /// out[i] = in[i] ^ c(n + i) over unpacked bits. May run in place.
+    void apply(std::span<const std::uint8_t> in, std::span<std::uint8_t> out) noexcept;
+    /// The same on packed bits, one sequence word per input word.
+    void apply(ConstBitSpan in, BitSpan out) noexcept;
+    /// Descramble LLRs (positive for bit 0): negate in[i] where c(n + i)
+    /// is 1. May run in place.
+    void apply(std::span<const float> in, std::span<float> out) noexcept;
+
+private:
+    std::uint64_t step() noexcept;
+
+    std::uint64_t x1_[2] = {};  // next two words of x1(n + 1600)
+    std::uint64_t x2_[2] = {};
+    std::uint64_t word_ = 0;    // unused bits of the last word, next in bit 0
+    unsigned left_ = 0;
+};
+
+/// Scrambler as a pipeline stage over packed blocks of `block_bits` bits.
+/// Works in place whenever it holds the only reference to its input.
+class ScramblerStage final : public Stage<std::uint64_t, std::uint64_t> {
+public:
+    ScramblerStage(const char* name, std::uint8_t seed, std::size_t block_bits,
+                   std::size_t pool_depth);
+
+    BufferView<std::uint64_t> process(BufferView<std::uint64_t> in) override;
+    const char* name() const noexcept override { return name_; }
+
+    Scrambler& scrambler() noexcept { return scrambler_; }
+
+private:
+    const char* name_;
+    Scrambler scrambler_;
+    std::size_t block_bits_;
+    BufferPool<std::uint64_t> pool_;
+};
+
+/// Receive-side descrambler: decoded bits, one per byte, in; packed and
+/// descrambled blocks out, the form the transmitter takes its data in.
+class DescramblerStage final : public Stage<std::uint8_t, std::uint64_t> {
+public:
+    DescramblerStage(std::uint8_t seed, std::size_t block_bits, std::size_t pool_depth);
+
+    BufferView<std::uint64_t> process(BufferView<std::uint8_t> in) override;
+    const char* name() const noexcept override { return "descrambler"; }
+
+    Scrambler& scrambler() noexcept { return scrambler_; }
+
+private:
+    Scrambler scrambler_;
+    std::size_t block_bits_;
+    BufferPool<std::uint64_t> pool_;
+};
+
+}  // namespace dcomm
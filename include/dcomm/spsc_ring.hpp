@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+/// Counters of an SpscRing. Snapshots only while the ring is in use.
+struct RingStats {
+    std::uint64_t pushed = 0;
+    std::uint64_t popped = 0;
+    std::uint64_t overruns = 0;   ///< try_push() calls that found the ring full
+    std::uint64_t underruns = 0;  ///< try_pop() calls that found it empty
+};
+
+/// Bounded lock-free single-producer / single-consumer queue.
+///
+/// Meant for handing pooled blocks (BufferView) between pipeline threads
+/// and to the converter threads at the DAC/ADC boundary. The producer and
+/// consumer indices live on separate cache lines, each side caches the
+/// other's index and only reloads it when the ring looks full or empty, so
+/// an uncontended push or pop touches no shared line besides the slot
+/// itself. Neither side ever blocks or allocates: a full or empty ring is
+/// reported to the caller and counted as an overrun or underrun. Threads
+/// that poll should wait on empty() / full() rather than on failed try_*
+/// calls, which would inflate those counters.
+template <class T>
+class SpscRing {
+    static_assert(std::is_nothrow_move_assignable_v<T>,
+                  "ring slots are moved in and out without a failure path");
+
+public:
+    /// Capacity is rounded up to a power of two.
+    explicit SpscRing(std::size_t capacity)
+        : mask_(std::bit_ceil(capacity) - 1), slots_(std::make_unique<T[]>(mask_ + 1)) {
+        if (capacity == 0) {
+            throw std::invalid_argument("SpscRing: capacity must be > 0");
+        }
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+
+    /// Producer side. Moves `value` in and returns true, or returns false
+    /// and leaves `value` untouched when the ring is full.
+    bool try_push(T& value) noexcept {
+        const std::size_t head = producer_.head.load(std::memory_order_relaxed);
+        if (head - producer_.cached_tail > mask_) {
+            producer_.cached_tail = consumer_.tail.load(std::memory_order_acquire);
+            if (head - producer_.cached_tail > mask_) {
+                bump(producer_.overruns);
+                return false;
+            }
+        }
+        slots_[head & mask_] = std::move(value);
+        producer_.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    bool try_push(T&& value) noexcept { return try_push(value); }
+
+    /// Consumer side. Moves the oldest element into `out` and returns true,
+    /// or returns false when the ring is empty.
+    bool try_pop(T& out) noexcept {
+        const std::size_t tail = consumer_.tail.load(std::memory_order_relaxed);
+        if (tail == consumer_.cached_head) {
+            consumer_.cached_head = producer_.head.load(std::memory_order_acquire);
+            if (tail == consumer_.cached_head) {
+                bump(consumer_.underruns);
+                return false;
+            }
+        }
+        out = std::move(slots_[tail & mask_]);
+        consumer_.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Fill level; exact from either side's own thread with respect to
+    /// its own operations, a snapshot otherwise.
+    std::size_t size() const noexcept {
+        const std::size_t tail = consumer_.tail.load(std::memory_order_acquire);
+        const std::size_t head = producer_.head.load(std::memory_order_acquire);
+        return head - tail;
+    }
+    bool empty() const noexcept { return size() == 0; }
+    bool full() const noexcept { return size() > mask_; }
+
+    RingStats stats() const noexcept {
+        RingStats s;
+        s.popped = consumer_.tail.load(std::memory_order_relaxed);
+        s.pushed = producer_.head.load(std::memory_order_relaxed);
+        s.overruns = producer_.overruns.load(std::memory_order_relaxed);
+        s.underruns = consumer_.underruns.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    /// Counters have a single writer, so a plain load/store pair suffices.
+    static void bump(std::atomic<std::uint64_t>& c) noexcept {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    struct alignas(kCacheLine) Producer {
+        std::atomic<std::size_t> head{0};
+        std::size_t cached_tail = 0;
+        std::atomic<std::uint64_t> overruns{0};
+    };
+    struct alignas(kCacheLine) Consumer {
+        std::atomic<std::size_t> tail{0};
+        std::size_t cached_head = 0;
+        std::atomic<std::uint64_t> underruns{0};
+    };
+
+    std::size_t mask_;
+    std::unique_ptr<T[]> slots_;
+    Producer producer_;
+    Consumer consumer_;
+};
+
+}  // namespace dcomm
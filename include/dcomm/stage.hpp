@@ -0,0 +1,29 @@
+#pragma once
+
+#include "dcomm/buffer.hpp"
+
+namespace dcomm {
+
+/// One block-processing step of the Tx or Rx chain.
+///
+/// A stage consumes a view of its input block and returns a view of its
+/// output block. Stages that can work in place return the input buffer
+/// itself when they hold the only reference to it; otherwise the output is
+/// written to a buffer from the stage's own pool. An empty input or an
+/// exhausted pool yields an empty output view (back-pressure), never a heap
+/// allocation.
+template <class In, class Out>
+class Stage {
+public:
+    using input_type = In;
+    using output_type = Out;
+
+    virtual ~Stage() = default;
+
+    virtual BufferView<Out> process(BufferView<In> in) = 0;
+
+    /// Short identifier used in logs and benchmark reports.
+    virtual const char* name() const noexcept = 0;
+};
+
+}  // namespace dcomm
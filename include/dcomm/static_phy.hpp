@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <span>
+
+#include "dcomm/bits.hpp"
+#include "dcomm/phy_config.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+/// Baseband processing of one whole frame, Tx and Rx, without pools.
+///
+/// Each frame is a stream of its own: the scrambler starts from
+/// config.scrambler_seed and the pilots from p_0, so encode() produces the
+/// samples a freshly reset TxChain would and decode() inverts them.
+/// Buffers are sized for config.symbols_per_block at construction, which
+/// bounds the frame length; a FramePhy is not thread-safe.
+class FramePhy {
+public:
+    explicit FramePhy(const PhyConfig& config) : config_(config) {}
+    virtual ~FramePhy() = default;
+
+    FramePhy(const FramePhy&) = delete;
+    FramePhy& operator=(const FramePhy&) = delete;
+
+    const PhyConfig& config() const noexcept { return config_; }
+
+    /// config.info_bits_per_block() data bits to samples_per_block()
+    /// samples.
+    void encode(ConstBitSpan bits, std::span<cf32> samples) {
+        encode(bits, samples, config_.symbols_per_block);
+    }
+    /// The reverse, into info_bits_per_block() bits.
+    void decode(std::span<const cf32> samples, BitSpan bits) {
+        decode(samples, bits, config_.symbols_per_block);
+    }
+
+    /// A shorter frame of `symbols` <= config.symbols_per_block OFDM
+    /// symbols, carrying info_bits(symbols) bits.
+    virtual void encode(ConstBitSpan bits, std::span<cf32> samples, std::size_t symbols) = 0;
+    virtual void decode(std::span<const cf32> samples, BitSpan bits, std::size_t symbols) = 0;
+
+    /// Data bits of a frame of `symbols` OFDM symbols.
+    std::size_t info_bits(std::size_t symbols) const noexcept {
+        PhyConfig c = config_;
+        c.symbols_per_block = symbols;
+        return c.info_bits_per_block();
+    }
+
+    /// Pilot polarity index of the first symbol: 1 for the data symbols
+    /// behind an 802.11 SIGNAL symbol (frame.hpp), 0 by default.
+    void set_pilot_offset(std::size_t first_symbol) noexcept { pilot_offset_ = first_symbol; }
+
+    /// True when the MCS was compiled into its own pipeline; false for the
+    /// runtime fallback.
+    virtual bool specialized() const noexcept = 0;
+
+protected:
+    PhyConfig config_;
+    std::size_t pilot_offset_ = 0;
+};
+
+/// A FramePhy for `config`.
+///
+/// The eight 802.11a MCS (BPSK and QPSK at 1/2 and 3/4, 16-QAM at 1/2 and
+/// 3/4, 64-QAM at 2/3 and 3/4), with or without the interleaver, each have
+/// a pipeline instantiated from compile-time parameters: N_BPSC, N_CBPS and
+/// the interleaver permutation are constants (phy_tables.hpp), so the
+/// per-symbol loops have fixed bounds and the tables sit in .rodata. Any
+/// other configuration gets the same pipeline driven by runtime values and
+/// the shared BlockInterleaver tables. Both produce identical output.
+/// Throws std::invalid_argument if `config` is invalid.
+std::unique_ptr<FramePhy> make_frame_phy(const PhyConfig& config);
+
+/// The runtime pipeline for any configuration, e.g. to compare against a
+/// specialised one.
+std::unique_ptr<FramePhy> make_generic_frame_phy(const PhyConfig& config);
+
+}  // namespace dcomm
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm {
+
+namespace kernels {
+struct SyncKernels;
+}
+
+/// 802.11a/g legacy preamble (17.3.3) at 20 Msps: ten 16-sample short
+/// training symbols (L-STF), then a 32-sample guard and two 64-sample long
+/// training symbols (L-LTF). Unit average power, like the OFDM modulator's
+/// output, and without the edge windowing of the standard.
+struct Preamble80211 {
+    static constexpr std::size_t stf_length = 160;
+    static constexpr std::size_t stf_period = 16;
+    static constexpr std::size_t ltf_guard = 32;
+    static constexpr std::size_t ltf_symbol = 64;
+    static constexpr std::size_t length = 320;
+    /// First sample of the first long training symbol.
+    static constexpr std::size_t ltf_start = stf_length + ltf_guard;
+
+    /// All 320 samples.
+    static std::span<const cf32> samples();
+    /// One long training symbol.
+    static std::span<const cf32> ltf() { return samples().subspan(ltf_start, ltf_symbol); }
+};
+
+struct SyncConfig {
+    /// Samples of each frame after the preamble, handed on per detection;
+    /// PhyConfig::samples_per_block() for one chain block.
+    std::size_t payload_samples = 0;
+    /// Schmidl-Cox window, in samples (lag products summed): 16..144.
+    std::size_t window = 48;
+    /// Detection threshold on |P|^2 / R^2, which is the square of the
+    /// STF's correlation coefficient: about (SNR / (SNR + 1))^2 on the
+    /// preamble and 1 / window on noise.
+    float threshold = 0.35f;
+    /// Consecutive samples the metric must stay above the threshold.
+    std::size_t plateau = 48;
+    /// Minimum normalised L-LTF correlation to accept a detection.
+    float ltf_threshold = 0.5f;
+};
+
+/// One synchronised frame.
+struct SyncDetection {
+    std::uint64_t start = 0;  ///< stream index of the first preamble sample
+    double cfo = 0.0;         ///< carrier frequency offset, cycles per sample
+    cf32 gain{};              ///< flat channel estimate from the L-LTF
+    float quality = 0.0f;     ///< normalised L-LTF correlation, 0..1
+};
+
+/// 802.11 packet detection, timing and CFO correction on a sample stream.
+///
+/// Every sample goes through a Schmidl-Cox autocorrelator at the L-STF
+/// period: P(n) = sum conj(x[k - 16]) x[k] and R(n) = sum |x[k]|^2 over
+/// the last `window` samples, and the metric |P|^2 / R^2. The sums slide
+/// by recursion, O(1) per sample, and every step (lag products, window
+/// sums as a vectorised prefix scan, metric, threshold search) runs in the
+/// per-ISA kernels; on an idle channel that is all the work done. The sums
+/// are recomputed directly every 4096 samples, so float rounding cannot
+/// drift over long streams.
+///
+/// When the metric has held above the threshold for `plateau` samples and
+/// then falls, the end of the L-STF is in sight. Everything after that is
+/// paid once per detection: coarse CFO from the L-STF's lag-16
+/// correlation, fine timing by cross-correlating the two long training
+/// symbols, fine CFO from their lag-64 correlation and a flat gain and
+/// phase from their match to the reference. The payload is then handed to
+/// the handler derotated and divided by that gain, ready for an Rx chain
+/// with Equalizer::none on a flat channel (pilot_zf otherwise). The
+/// correlator resumes after the payload. A frame whose preamble began
+/// before the stream did is counted as a false alarm, not reported.
+class PacketSync {
+public:
+    using Handler = std::function<void(const SyncDetection&, std::span<const cf32> payload)>;
+
+    /// Throws std::invalid_argument for an unusable configuration or an
+    /// `isa` not available on this CPU.
+    explicit PacketSync(const SyncConfig& config);
+    PacketSync(const SyncConfig& config, Isa isa);
+
+    /// Push stream samples. Frames found are passed to `on_frame` before
+    /// the call returns; returns how many.
+    std::size_t process(std::span<const cf32> in, const Handler& on_frame);
+
+    /// Forget all buffered samples and state; the stream restarts at 0.
+    void reset();
+
+    const SyncConfig& config() const noexcept { return config_; }
+    std::uint64_t samples() const noexcept { return end_ - pad_; }
+    std::uint64_t detections() const noexcept { return detections_; }
+    /// Metric plateaus the L-LTF did not confirm.
+    std::uint64_t false_alarms() const noexcept { return false_alarms_; }
+
+private:
+    static constexpr std::size_t kLag = Preamble80211::stf_period;
+    static constexpr std::size_t kChunk = 1024;
+    static constexpr std::uint64_t kResync = 4096;
+
+    void correlate();
+    void restart(std::uint64_t from);
+    void resync() noexcept;
+    bool synchronise(const Handler& on_frame);
+    std::uint64_t keep_from() const noexcept;
+    const cf32* at(std::uint64_t index) const noexcept { return &samples_[index - base_]; }
+
+    const kernels::SyncKernels* kernels_;
+    SyncConfig config_;
+    std::size_t pad_;  // zeros ahead of the stream: window + lag
+
+    // Stream buffer: samples_[0] is internal index base_; end_ is one past
+    // the newest sample. Internal indices are stream indices + pad_.
+    std::vector<cf32> samples_;
+    std::uint64_t base_ = 0;
+    std::uint64_t end_ = 0;
+
+    // Correlator: products c_re / c_im / e with `window` values of history
+    // in front, then a chunk; sums and metric of the chunk.
+    std::vector<float> c_re_, c_im_, e_;
+    std::vector<float> p_re_, p_im_, r_, metric_;
+    float carry_re_ = 0.0f, carry_im_ = 0.0f, carry_e_ = 0.0f;
+    std::uint64_t next_ = 0;  // next sample whose metric is due
+
+    bool in_run_ = false;
+    std::uint64_t run_start_ = 0;
+    bool pending_ = false;    // a plateau ended; waiting for the L-LTF
+    std::uint64_t run_end_ = 0;
+
+    std::vector<cf32> frame_;  // derotated search region, then payload
+    std::uint64_t detections_ = 0;
+    std::uint64_t false_alarms_ = 0;
+};
+
+}  // namespace dcomm
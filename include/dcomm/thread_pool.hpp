@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dcomm {
+
+/// Fixed set of worker threads running index-parallel jobs with work
+/// stealing.
+///
+/// run(count, fn) splits [0, count) into one contiguous range per worker.
+/// Each worker takes indices from the front of its own range and, once that
+/// runs dry, steals the back half of the fullest-looking other range, so
+/// uneven items (e.g. codeblocks that stop early) balance without a shared
+/// queue. Ranges are packed into one atomic word each; the calling thread
+/// acts as worker 0, so a pool of size 1 runs everything inline.
+class WorkStealingPool {
+public:
+    /// `workers` = 0 uses std::thread::hardware_concurrency().
+    explicit WorkStealingPool(std::size_t workers = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    std::size_t size() const noexcept { return slots_.size(); }
+
+    /// Call fn(index, worker) once for every index in [0, count) and return
+    /// when all calls have finished. `worker` < size() identifies the
+    /// calling thread, for per-worker scratch state. Not reentrant.
+    void run(std::size_t count, const std::function<void(std::size_t, std::size_t)>& fn);
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> range{0};  // begin << 32 | end
+    };
+
+    void worker_loop(std::size_t id);
+    void work(std::size_t id);
+    bool pop(std::size_t id, std::uint32_t& index) noexcept;
+    bool steal(std::size_t id) noexcept;
+
+    std::unique_ptr<Slot[]> slots_storage_;
+    std::vector<Slot*> slots_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    std::uint64_t generation_ = 0;
+    std::size_t running_ = 0;
+    bool stop_ = false;
+    const std::function<void(std::size_t, std::size_t)>* job_ = nullptr;
+};
+
+}  // namespace dcomm
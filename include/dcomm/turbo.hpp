@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/thread_pool.hpp"
+#include "dcomm/types.hpp"
+
+namespace dcomm::kernels {
+struct TurboKernels;
+}
+
+namespace dcomm {
+
+/// Quadratic permutation polynomial interleaver of the LTE turbo code
+/// (TS 36.212 5.1.3.2.3): pi(i) = (f1 i + f2 i^2) mod K for the 188
+/// codeblock sizes K = 40 .. 6144 of Table 5.1.3-3.
+class QppInterleaver {
+public:
+    /// Throws std::invalid_argument if K is not a codeblock size.
+    explicit QppInterleaver(std::size_t k);
+
+    static bool supported(std::size_t k) noexcept;
+
+    std::size_t size() const noexcept { return k_; }
+    unsigned f1() const noexcept { return f1_; }
+    unsigned f2() const noexcept { return f2_; }
+
+    std::size_t operator()(std::size_t i) const noexcept {
+        return (std::uint64_t(f1_) * i + std::uint64_t(f2_) * i % k_ * i) % k_;
+    }
+
+private:
+    std::size_t k_;
+    unsigned f1_;
+    unsigned f2_;
+};
+
+/// Coded bits of a K-bit turbo codeblock: three streams of K + 4 bits.
+constexpr std::size_t turbo_coded_bits(std::size_t k) noexcept {
+    return 3 * (k + 4);
+}
+
+/// Rate-1/3 LTE turbo encoder: two 8-state RSC encoders (g0 = 13, g1 = 15
+/// octal) on the natural and QPP-interleaved input, each terminated with
+/// three tail steps. `coded` receives the streams d0 (systematic), d1 and
+/// d2 (parities) one after another, tails multiplexed as in 5.1.3.2.2.
+void turbo_encode(const QppInterleaver& pi, std::span<const std::uint8_t> info,
+                  std::span<std::uint8_t> coded) noexcept;
+
+/// CRC checked after every half-iteration to stop decoding early.
+enum class TurboCrc : std::uint8_t {
+    none,
+    crc24a,  ///< transport block carried in a single codeblock
+    crc24b,  ///< codeblock of a segmented transport block
+};
+
+struct TurboDecoderOptions {
+    unsigned max_iterations = 8;
+    TurboCrc crc = TurboCrc::crc24b;
+};
+
+struct TurboResult {
+    unsigned half_iterations = 0;
+    bool crc_ok = false;  ///< the CRC held (always false without one)
+};
+
+/// Max-log-MAP turbo decoder with int16 metrics.
+///
+/// The codeblock is split into up to 32 equal sub-blocks (windows) that
+/// are decoded side by side, one per SIMD lane. Each window starts from the
+/// boundary metrics its neighbours reached on the previous iteration, so
+/// windows need no training run. Extrinsic values are scaled by 3/4 between
+/// the constituent decoders. With a CRC configured, the a-posteriori hard
+/// decisions are checked after every half-iteration through a precomputed
+/// per-position syndrome, without reordering them, and decoding stops once
+/// the CRC holds. Storage is sized at construction; decode() does not
+/// allocate. One decoder per thread.
+class TurboDecoder {
+public:
+    explicit TurboDecoder(std::size_t k, TurboDecoderOptions options = {},
+                          Isa isa = active_isa());
+    ~TurboDecoder();
+
+    TurboDecoder(TurboDecoder&&) noexcept;
+    TurboDecoder& operator=(TurboDecoder&&) noexcept;
+
+    /// Decode turbo_coded_bits(k()) LLRs (positive means 0, stream layout of
+    /// turbo_encode) into k() bits.
+    TurboResult decode(std::span<const float> llrs, std::span<std::uint8_t> info);
+
+    std::size_t k() const noexcept { return pi_.size(); }
+    /// Number of windows decoded in parallel.
+    std::size_t windows() const noexcept { return windows_; }
+
+private:
+    void load(std::span<const float> llrs);
+    void exchange_boundaries(std::int16_t* alpha, std::int16_t* beta,
+                             const std::int16_t* tail) noexcept;
+    void output(bool interleaved, std::span<std::uint8_t> info) const noexcept;
+
+    QppInterleaver pi_;
+    TurboDecoderOptions options_;
+    const kernels::TurboKernels* kernels_;
+    std::size_t windows_;  // sub-blocks
+    std::size_t steps_;    // trellis steps per sub-block
+    std::size_t lanes_;    // windows rounded up to the kernel lane multiple
+    std::size_t slots_;    // steps_ * lanes_
+    // Slot t * lanes_ + l holds step t of window l; map12_[slot in the
+    // interleaved order] is the slot of the same bit in natural order and
+    // map21_ the inverse.
+    std::vector<std::uint32_t> map12_;
+    std::vector<std::uint32_t> map21_;
+    AlignedArray<std::uint32_t> syn1_;  // CRC syndrome of each slot
+    AlignedArray<std::uint32_t> syn2_;
+    AlignedArray<std::int16_t> soft_;   // quantised turbo_coded_bits(k)
+    AlignedArray<std::int16_t> sys1_;
+    AlignedArray<std::int16_t> par1_;
+    AlignedArray<std::int16_t> sys2_;
+    AlignedArray<std::int16_t> par2_;
+    AlignedArray<std::int16_t> apriori_;
+    AlignedArray<std::int16_t> ext1_;
+    AlignedArray<std::int16_t> ext2_;
+    AlignedArray<std::int16_t> alpha1_;  // 8 * lanes_ boundary metrics
+    AlignedArray<std::int16_t> beta1_;
+    AlignedArray<std::int16_t> alpha2_;
+    AlignedArray<std::int16_t> beta2_;
+    AlignedArray<std::int16_t> scratch_;
+    AlignedArray<std::uint8_t> hard_;
+    std::int16_t tail1_[8];  // backward metrics entering each tail
+    std::int16_t tail2_[8];
+};
+
+/// Decodes independent codeblocks of one size in parallel on a
+/// WorkStealingPool, with one TurboDecoder per worker.
+class TurboBatchDecoder {
+public:
+    TurboBatchDecoder(std::size_t k, WorkStealingPool& pool, TurboDecoderOptions options = {});
+
+    /// `llrs` holds count * turbo_coded_bits(k) values, `info` count * k
+    /// bits and `results` count entries, codeblock after codeblock.
+    void decode(std::span<const float> llrs, std::span<std::uint8_t> info,
+                std::span<TurboResult> results);
+
+private:
+    std::size_t k_;
+    WorkStealingPool* pool_;
+    std::vector<TurboDecoder> decoders_;
+};
+
+}  // namespace dcomm
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace dcomm {
+
+/// Complex baseband sample, interleaved re/im single precision.
+using cf32 = std::complex<float>;
+
+/// Complex baseband sample, interleaved re/im 16-bit fixed point. The
+/// chains scale it Q13 (unit level 8192, see SampleTraits) for 12 dB of
+/// headroom; the FFT arithmetic treats the same words as Q15 fractions.
+struct ci16 {
+    std::int16_t re;
+    std::int16_t im;
+};
+
+/// Complex baseband sample, interleaved re/im 8-bit fixed point, scaled
+/// Q5 by the chains.
+struct ci8 {
+    std::int8_t re;
+    std::int8_t im;
+};
+
+/// Destructive-interference size assumed for padding shared state.
+inline constexpr std::size_t kCacheLine = 64;
+
+/// Round `n` up to the next multiple of `align` (a power of two).
+constexpr std::size_t align_up(std::size_t n, std::size_t align) noexcept {
+    return (n + align - 1) & ~(align - 1);
+}
+
+struct AlignedFree {
+    void operator()(void* p) const noexcept { std::free(p); }
+};
+
+/// Owning pointer to an array of `T` aligned to a cache line.
+template <class T>
+using AlignedArray = std::unique_ptr<T[], AlignedFree>;
+
+/// Allocate `count` value-initialised elements aligned to kCacheLine.
+template <class T>
+AlignedArray<T> make_aligned_array(std::size_t count) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "AlignedArray never runs element destructors");
+    const std::size_t bytes = align_up(count * sizeof(T), kCacheLine);
+    void* p = std::aligned_alloc(kCacheLine, bytes == 0 ? kCacheLine : bytes);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    std::uninitialized_value_construct_n(static_cast<T*>(p), count);
+    return AlignedArray<T>(static_cast<T*>(p));
+}
+
+}  // namespace dcomm
@@ -0,0 +1,102 @@
+#include "dcomm/affinity.hpp"
+
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
+namespace dcomm {
+
+namespace {
+
+bool path_exists(const std::string& path) noexcept {
+    return ::access(path.c_str(), F_OK) == 0;
+}
+
+}  // namespace
+
+unsigned cpu_count() noexcept {
+#if defined(__linux__)
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        return unsigned(CPU_COUNT(&set));
+    }
+#endif
+    const unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+int numa_node_of_cpu(int cpu) noexcept {
+#if defined(__linux__)
+    // Each CPU directory carries a nodeN link to its node.
+    const std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/node";
+    for (int node = 0; node < 1024; ++node) {
+        if (path_exists(dir + std::to_string(node))) {
+            return node;
+        }
+        if (!path_exists("/sys/devices/system/node/node" + std::to_string(node))) {
+            break;
+        }
+    }
+#endif
+    (void)cpu;
+    return 0;
+}
+
+int numa_node_count() noexcept {
+    int n = 0;
+#if defined(__linux__)
+    while (path_exists("/sys/devices/system/node/node" + std::to_string(n))) {
+        ++n;
+    }
+#endif
+    return n == 0 ? 1 : n;
+}
+
+bool pin_current_thread(int cpu) noexcept {
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+bool bind_to_numa_node(std::span<std::byte> memory, int node) noexcept {
+#if defined(__linux__) && defined(SYS_mbind)
+    // Raw syscall so the library does not depend on libnuma.
+    constexpr int kMpolBind = 2;
+    constexpr unsigned kMpolMfMove = 1u << 1;
+    if (node < 0 || node >= 64 || numa_node_count() < 2) {
+        return false;
+    }
+    const auto page = std::uintptr_t(::sysconf(_SC_PAGESIZE));
+    const auto first = (std::uintptr_t(memory.data()) + page - 1) & ~(page - 1);
+    const auto last = (std::uintptr_t(memory.data()) + memory.size()) & ~(page - 1);
+    if (last <= first) {
+        return false;
+    }
+    // maxnode counts one past the highest bit the kernel reads.
+    const unsigned long mask = 1ul << node;
+    return ::syscall(SYS_mbind, first, last - first, kMpolBind, &mask, 65ul, kMpolMfMove) == 0;
+#else
+    (void)memory;
+    (void)node;
+    return false;
+#endif
+}
+
+}  // namespace dcomm
@@ -0,0 +1,33 @@
+#include "dcomm/arena.hpp"
+
+#include <algorithm>
+
+namespace dcomm {
+
+FrameArena::FrameArena(std::size_t capacity)
+    : block_(capacity == 0 ? nullptr : make_aligned_array<std::byte>(capacity)),
+      capacity_(align_up(capacity, kCacheLine)) {}
+
+void FrameArena::reset() noexcept {
+    offset_ = 0;
+    spilled_ = 0;
+    overflow_.clear();
+}
+
+void* FrameArena::allocate_bytes(std::size_t bytes) {
+    const std::size_t size = align_up(bytes, kCacheLine);
+    void* p;
+    if (size <= capacity_ - offset_) {
+        p = block_.get() + offset_;
+        offset_ += size;
+    } else {
+        overflow_.push_back(make_aligned_array<std::byte>(size));
+        p = overflow_.back().get();
+        spilled_ += size;
+        ++heap_allocations_;
+    }
+    high_water_ = std::max(high_water_, offset_ + spilled_);
+    return p;
+}
+
+}  // namespace dcomm
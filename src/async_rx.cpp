@@ -0,0 +1,80 @@
+#include "dcomm/async_rx.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace dcomm {
+
+AsyncReceiver::AsyncReceiver(Executor& executor, const PhyConfig& base, Handler on_message,
+                             std::size_t max_in_flight, std::size_t short_symbols)
+    : executor_(executor),
+      on_message_(std::move(on_message)),
+      short_symbols_(short_symbols),
+      max_in_flight_(std::max<std::size_t>(max_in_flight, 1)),
+      samples_(max_in_flight_, kMaxFrameSamples),
+      payloads_(max_in_flight_, packed_words(8 * kMaxFrameBytes)) {
+    codecs_.reserve(executor.size());
+    for (std::size_t i = 0; i < executor.size(); ++i) {
+        codecs_.push_back(std::make_unique<FrameCodec>(base));
+    }
+}
+
+AsyncReceiver::~AsyncReceiver() { drain(); }
+
+std::uint64_t AsyncReceiver::submit(std::span<const cf32> samples) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait(lock, [this] { return in_flight_ < max_in_flight_; });
+        ++in_flight_;
+    }
+    // Frames release their buffers before finish(), so one is free.
+    BufferView<cf32> copy = samples_.acquire();
+    copy.resize(std::min(samples.size(), copy.capacity()));
+    std::copy_n(samples.begin(), copy.size(), copy.begin());
+    const std::uint64_t id = next_id_++;
+    receive(id, std::move(copy));
+    return id;
+}
+
+void AsyncReceiver::drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_.wait(lock, [this] { return in_flight_ == 0; });
+}
+
+void AsyncReceiver::finish() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --in_flight_;
+    }
+    finished_.notify_all();
+}
+
+Detached AsyncReceiver::receive(std::uint64_t id, BufferView<cf32> samples) {
+    co_await executor_.schedule(Priority::high);
+    const std::optional<SignalField> signal =
+        samples.size() >= kSignalSamples ? codec().decode_signal(samples.span()) : std::nullopt;
+    if (!signal || samples.size() < frame_samples(*signal)) {
+        samples.reset();
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        finish();
+        co_return;
+    }
+
+    const std::size_t n_sym = payload_symbols(*signal);
+    co_await executor_.schedule(n_sym <= short_symbols_ ? Priority::normal : Priority::low);
+    const std::size_t n_bits = 8 * std::size_t(signal->length);
+    BufferView<std::uint64_t> payload = payloads_.acquire();
+    // The resuming worker may not be the one that read the SIGNAL.
+    codec().decode_payload(*signal, samples.span().subspan(kSignalSamples),
+                           BitSpan(payload.data(), n_bits));
+    {
+        std::lock_guard<std::mutex> lock(deliver_);
+        on_message_(id, *signal, ConstBitSpan(payload.data(), n_bits));
+    }
+    samples.reset();
+    payload.reset();
+    delivered_.fetch_add(1, std::memory_order_relaxed);
+    finish();
+}
+
+}  // namespace dcomm
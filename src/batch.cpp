@@ -0,0 +1,172 @@
+#include "dcomm/batch.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "dcomm/equalizer.hpp"
+#include "dcomm/fft.hpp"
+#include "dcomm/interleaver.hpp"
+#include "dcomm/modulation.hpp"
+#include "dcomm/ofdm.hpp"
+#include "dcomm/phy_tables.hpp"
+#include "dcomm/scrambler.hpp"
+
+namespace dcomm {
+
+namespace {
+
+constexpr std::size_t kN = PhyConfig::fft_size;
+constexpr std::size_t kCp = PhyConfig::cp_length;
+constexpr std::size_t kSymbolLen = kN + kCp;
+constexpr std::size_t kData = PhyConfig::data_subcarriers;
+constexpr std::size_t kMaxCodedPerSymbol = kData * 8;
+
+/// Where a frame's values start in the batch buffers, in group order.
+struct Offsets {
+    std::size_t symbol = 0;  // OFDM symbols
+    std::size_t coded = 0;   // coded bits / LLRs
+    std::size_t info = 0;    // decoded bits
+};
+
+}  // namespace
+
+BatchReceiver::BatchReceiver(std::size_t max_ofdm_symbols, Equalizer equalizer,
+                             WorkStealingPool* pool)
+    : equalizer_(equalizer),
+      pool_(pool),
+      arena_(scratch_bytes(max_ofdm_symbols)),
+      decoders_(pool == nullptr ? 1 : pool->size()) {}
+
+std::size_t BatchReceiver::scratch_bytes(std::size_t ofdm_symbols) noexcept {
+    return align_up(ofdm_symbols * kN * sizeof(cf32), kCacheLine) +
+           align_up(ofdm_symbols * kData * sizeof(cf32), kCacheLine) +
+           2 * align_up(ofdm_symbols * kMaxCodedPerSymbol * sizeof(float), kCacheLine) +
+           align_up(ofdm_symbols * kMaxCodedPerSymbol, kCacheLine) +
+           align_up(ofdm_symbols * sizeof(Offsets) + kCacheLine, kCacheLine);
+}
+
+void BatchReceiver::process(std::span<const BatchFrame> frames) {
+    for (const BatchFrame& f : frames) {
+        f.config.validate();
+        if (f.samples.size() < f.config.samples_per_block() ||
+            f.bits.size() < f.config.info_bits_per_block()) {
+            throw std::invalid_argument("BatchReceiver: frame buffers too short");
+        }
+    }
+
+    order_.resize(frames.size());
+    std::iota(order_.begin(), order_.end(), 0u);
+    std::stable_sort(order_.begin(), order_.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return McsKey::of(frames[a].config) < McsKey::of(frames[b].config);
+    });
+
+    // Lay the frames out back to back in group order.
+    const std::span<Offsets> at = arena_.allocate<Offsets>(frames.size());
+    Offsets total;
+    for (std::uint32_t i : order_) {
+        const PhyConfig& c = frames[i].config;
+        at[i] = total;
+        total.symbol += c.symbols_per_block;
+        total.coded += c.coded_bits_per_block();
+        total.info += c.info_bits_per_block();
+    }
+
+    // One FFT batch over every symbol of every frame.
+    const std::span<cf32> bodies = arena_.allocate<cf32>(total.symbol * kN);
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        const BatchFrame& f = frames[i];
+        for (std::size_t s = 0; s < f.config.symbols_per_block; ++s) {
+            const cf32* body = f.samples.data() + s * kSymbolLen + kCp;
+            std::copy(body, body + kN, bodies.data() + (at[i].symbol + s) * kN);
+        }
+    }
+    FftPlan::get(kN).forward_batch(bodies.data(), total.symbol, kN);
+
+    const OfdmLayout& layout = OfdmLayout::ieee80211();
+    const std::span<cf32> symbols = arena_.allocate<cf32>(total.symbol * kData);
+    PilotEqualizer<cf32> eq;
+    std::uint64_t saturated = 0;  // float: never touched
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        const std::size_t n_sym = frames[i].config.symbols_per_block;
+        const cf32* in = bodies.data() + at[i].symbol * kN;
+        cf32* out = symbols.data() + at[i].symbol * kData;
+        if (equalizer_ == Equalizer::pilot_zf) {
+            eq.estimate(in, n_sym, kN, 0);
+            for (std::size_t s = 0; s < n_sym; ++s) {
+                eq.apply(in + s * kN, out + s * kData, saturated);
+            }
+        } else {
+            for (std::size_t s = 0; s < n_sym; ++s) {
+                for (std::size_t k = 0; k < kData; ++k) {
+                    out[s * kData + k] = in[s * kN + layout.data_bins[k]] * tables::kRxScale;
+                }
+            }
+        }
+    }
+
+    // Demap and deinterleave a whole group per call.
+    const std::span<float> llrs = arena_.allocate<float>(total.coded);
+    const std::span<float> deinterleaved = arena_.allocate<float>(total.coded);
+    groups_ = 0;
+    for (std::size_t g = 0; g < order_.size();) {
+        const McsKey key = McsKey::of(frames[order_[g]].config);
+        std::size_t end = g;
+        std::size_t n_sym = 0;
+        std::size_t n_coded = 0;
+        while (end < order_.size() && McsKey::of(frames[order_[end]].config) == key) {
+            n_sym += frames[order_[end]].config.symbols_per_block;
+            n_coded += frames[order_[end]].config.coded_bits_per_block();
+            ++end;
+        }
+        const Offsets& first = at[order_[g]];
+        const std::span<float> group_llrs = llrs.subspan(first.coded, n_coded);
+        demap_maxlog(key.modulation, symbols.subspan(first.symbol * kData, n_sym * kData), 1.0f,
+                     group_llrs);
+        for (std::size_t k = g; k < end; ++k) {
+            const PhyConfig& c = frames[order_[k]].config;
+            const float scale = 1.0f / c.noise_variance;
+            if (scale != 1.0f) {
+                for (float& v : llrs.subspan(at[order_[k]].coded, c.coded_bits_per_block())) {
+                    v *= scale;
+                }
+            }
+        }
+        const std::span<float> group_out = deinterleaved.subspan(first.coded, n_coded);
+        if (key.interleave) {
+            const PhyConfig& c = frames[order_[g]].config;
+            BlockInterleaver::ieee80211(c).deinterleave(group_llrs, group_out);
+        } else {
+            std::copy(group_llrs.begin(), group_llrs.end(), group_out.begin());
+        }
+        ++groups_;
+        g = end;
+    }
+
+    // Codewords are per frame; decode them in group order so consecutive
+    // frames share a puncturing pattern, across the pool if there is one.
+    const std::span<std::uint8_t> info = arena_.allocate<std::uint8_t>(total.info);
+    auto decode = [&](std::size_t k, std::size_t worker) {
+        const std::uint32_t i = order_[k];
+        const PhyConfig& c = frames[i].config;
+        decoders_[worker].decode(deinterleaved.subspan(at[i].coded, c.coded_bits_per_block()),
+                                 info.subspan(at[i].info, c.info_bits_per_block()), c.code_rate);
+    };
+    if (pool_ != nullptr && frames.size() > 1) {
+        pool_->run(order_.size(), decode);
+    } else {
+        for (std::size_t k = 0; k < order_.size(); ++k) {
+            decode(k, 0);
+        }
+    }
+
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        const PhyConfig& c = frames[i].config;
+        const BitSpan out = frames[i].bits.subspan(0, c.info_bits_per_block());
+        pack_bits(info.subspan(at[i].info, c.info_bits_per_block()), out);
+        Scrambler(c.scrambler_seed).apply(out, out);
+    }
+    arena_.reset();
+}
+
+}  // namespace dcomm
@@ -0,0 +1,149 @@
+#include "dcomm/bits.hpp"
+
+#include <bit>
+
+#include "kernels/bits_kernels.hpp"
+
+namespace dcomm {
+
+namespace {
+
+const kernels::BitKernels& bit_kernels_for(Isa isa) noexcept {
+    assert(isa_available(isa));
+    [[maybe_unused]] const CpuFeatures& f = cpu_features();
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx512: return f.bmi2 ? kernels::bits_avx512 : kernels::bits_scalar;
+    case Isa::avx2: return f.bmi2 ? kernels::bits_avx2 : kernels::bits_scalar;
+#endif
+    default: return kernels::bits_scalar;
+    }
+}
+
+const kernels::BitKernels& active_kernels() noexcept {
+    static const kernels::BitKernels& k = bit_kernels_for(active_isa());
+    return k;
+}
+
+void pack_bits(const kernels::BitKernels& k, std::span<const std::uint8_t> bits,
+               BitSpan out) noexcept {
+    assert(bits.size() == out.size());
+    k.pack(bits.data(), bits.size(), out.words);
+}
+
+void unpack_bits(const kernels::BitKernels& k, ConstBitSpan bits,
+                 std::span<std::uint8_t> out) noexcept {
+    assert(bits.size() == out.size());
+    k.unpack(bits.words, bits.size(), out.data());
+}
+
+void pack_hard_decisions(const kernels::BitKernels& k, std::span<const float> llrs,
+                         BitSpan out) noexcept {
+    assert(llrs.size() == out.size());
+    k.pack_signs(llrs.data(), llrs.size(), out.words);
+}
+
+void unpack_llrs(const kernels::BitKernels& k, ConstBitSpan bits, float magnitude,
+                 std::span<float> llrs) noexcept {
+    assert(bits.size() == llrs.size());
+    k.unpack_signs(bits.words, bits.size(), magnitude, llrs.data());
+}
+
+void unpack_indices(const kernels::BitKernels& k, ConstBitSpan bits, unsigned width,
+                    std::span<std::uint8_t> indices) noexcept {
+    assert(width >= 1 && width <= 8 && bits.size() == indices.size() * width);
+    k.unpack_fields(bits.words, indices.size(), width, indices.data());
+}
+
+void pack_indices(const kernels::BitKernels& k, std::span<const std::uint8_t> indices,
+                  unsigned width, BitSpan out) noexcept {
+    assert(width >= 1 && width <= 8 && out.size() == indices.size() * width);
+    k.pack_fields(indices.data(), indices.size(), width, out.words);
+}
+
+void zip_bits(const kernels::BitKernels& k, ConstBitSpan a, ConstBitSpan b,
+              BitSpan out) noexcept {
+    assert(a.size() == b.size() && out.size() == 2 * a.size());
+    k.zip(a.words, b.words, a.size(), out.words);
+}
+
+std::size_t select_bits(const kernels::BitKernels& k, ConstBitSpan in,
+                        std::span<const std::uint64_t> keep, BitSpan out) noexcept {
+    assert(!keep.empty());
+    const std::size_t n = k.select(in.words, in.size(), keep.data(), keep.size(), out.words);
+    assert(n <= out.size());
+    // Clear the words the kept bits did not reach.
+    for (std::size_t w = packed_words(n); w < out.word_count(); ++w) {
+        out.words[w] = 0;
+    }
+    return n;
+}
+
+}  // namespace
+
+std::size_t count_bit_errors(ConstBitSpan a, ConstBitSpan b) noexcept {
+    assert(a.size() == b.size());
+    const std::size_t nw = a.word_count();
+    std::size_t errors = 0;
+    for (std::size_t w = 0; w < nw; ++w) {
+        const std::uint64_t mask = w + 1 == nw ? tail_mask(a.size()) : ~std::uint64_t(0);
+        errors += std::size_t(std::popcount((a.words[w] ^ b.words[w]) & mask));
+    }
+    return errors;
+}
+
+void pack_bits(std::span<const std::uint8_t> bits, BitSpan out) noexcept {
+    pack_bits(active_kernels(), bits, out);
+}
+void unpack_bits(ConstBitSpan bits, std::span<std::uint8_t> out) noexcept {
+    unpack_bits(active_kernels(), bits, out);
+}
+void pack_hard_decisions(std::span<const float> llrs, BitSpan out) noexcept {
+    pack_hard_decisions(active_kernels(), llrs, out);
+}
+void unpack_llrs(ConstBitSpan bits, float magnitude, std::span<float> llrs) noexcept {
+    unpack_llrs(active_kernels(), bits, magnitude, llrs);
+}
+void unpack_indices(ConstBitSpan bits, unsigned width, std::span<std::uint8_t> indices) noexcept {
+    unpack_indices(active_kernels(), bits, width, indices);
+}
+void pack_indices(std::span<const std::uint8_t> indices, unsigned width, BitSpan out) noexcept {
+    pack_indices(active_kernels(), indices, width, out);
+}
+void zip_bits(ConstBitSpan a, ConstBitSpan b, BitSpan out) noexcept {
+    zip_bits(active_kernels(), a, b, out);
+}
+std::size_t select_bits(ConstBitSpan in, std::span<const std::uint64_t> keep,
+                        BitSpan out) noexcept {
+    return select_bits(active_kernels(), in, keep, out);
+}
+
+void pack_bits(Isa isa, std::span<const std::uint8_t> bits, BitSpan out) noexcept {
+    pack_bits(bit_kernels_for(isa), bits, out);
+}
+void unpack_bits(Isa isa, ConstBitSpan bits, std::span<std::uint8_t> out) noexcept {
+    unpack_bits(bit_kernels_for(isa), bits, out);
+}
+void pack_hard_decisions(Isa isa, std::span<const float> llrs, BitSpan out) noexcept {
+    pack_hard_decisions(bit_kernels_for(isa), llrs, out);
+}
+void unpack_llrs(Isa isa, ConstBitSpan bits, float magnitude, std::span<float> llrs) noexcept {
+    unpack_llrs(bit_kernels_for(isa), bits, magnitude, llrs);
+}
+void unpack_indices(Isa isa, ConstBitSpan bits, unsigned width,
+                    std::span<std::uint8_t> indices) noexcept {
+    unpack_indices(bit_kernels_for(isa), bits, width, indices);
+}
+void pack_indices(Isa isa, std::span<const std::uint8_t> indices, unsigned width,
+                  BitSpan out) noexcept {
+    pack_indices(bit_kernels_for(isa), indices, width, out);
+}
+void zip_bits(Isa isa, ConstBitSpan a, ConstBitSpan b, BitSpan out) noexcept {
+    zip_bits(bit_kernels_for(isa), a, b, out);
+}
+std::size_t select_bits(Isa isa, ConstBitSpan in, std::span<const std::uint64_t> keep,
+                        BitSpan out) noexcept {
+    return select_bits(bit_kernels_for(isa), in, keep, out);
+}
+
+}  // namespace dcomm
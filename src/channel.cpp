@@ -0,0 +1,266 @@
+#include "dcomm/channel.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+#include "dcomm/philox.hpp"
+#include "kernels/channel_kernels.hpp"
+
+namespace dcomm {
+
+namespace {
+
+const kernels::ChannelKernels& channel_kernels_for(Isa isa) noexcept {
+    assert(isa_available(isa));
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx2: return kernels::channel_avx2;
+    case Isa::avx512: return kernels::channel_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+    case Isa::neon: return kernels::channel_neon;
+#endif
+    default: return kernels::channel_scalar;
+    }
+}
+
+const kernels::ChannelKernels& fading_kernels_for(Isa isa) {
+    if (!isa_available(isa)) {
+        throw std::invalid_argument("FadingChannel: ISA not available on this CPU");
+    }
+    return channel_kernels_for(isa);
+}
+
+// TS 36.101 Annex B.2.1.
+constexpr FadingTap kFlat[] = {{0.0f, 0.0f}};
+constexpr FadingTap kEpa[] = {{0.0f, 0.0f},    {30.0f, -1.0f},  {70.0f, -2.0f},
+                              {90.0f, -3.0f},  {110.0f, -8.0f}, {190.0f, -17.2f},
+                              {410.0f, -20.8f}};
+constexpr FadingTap kEva[] = {{0.0f, 0.0f},     {30.0f, -1.5f},   {150.0f, -1.4f},
+                              {310.0f, -3.6f},  {370.0f, -0.6f},  {710.0f, -9.1f},
+                              {1090.0f, -7.0f}, {1730.0f, -12.0f}, {2510.0f, -16.9f}};
+constexpr FadingTap kEtu[] = {{0.0f, -1.0f},    {50.0f, -1.0f},   {120.0f, -1.0f},
+                              {200.0f, 0.0f},   {230.0f, 0.0f},   {500.0f, 0.0f},
+                              {1600.0f, -3.0f}, {2300.0f, -5.0f}, {5000.0f, -7.0f}};
+
+double sinc(double x) noexcept {
+    const double px = std::numbers::pi * x;
+    return std::abs(x) < 1e-12 ? 1.0 : std::sin(px) / px;
+}
+
+/// Uniform double in [0, 1) from two Philox words.
+double uniform(Philox4x32& rng) noexcept {
+    const std::uint64_t bits = std::uint64_t(rng()) << 32 | rng();
+    return double(bits >> 11) * 0x1p-53;
+}
+
+}  // namespace
+
+// --- GaussianNoise -------------------------------------------------------
+
+GaussianNoise::GaussianNoise(std::uint64_t seed, std::uint64_t stream) noexcept
+    : GaussianNoise(seed, stream, active_isa()) {}
+
+GaussianNoise::GaussianNoise(std::uint64_t seed, std::uint64_t stream, Isa isa) noexcept
+    : kernels_(&channel_kernels_for(isa)),
+      key_{std::uint32_t(seed), std::uint32_t(seed >> 32)}, stream_(stream) {}
+
+void GaussianNoise::fill(std::span<cf32> out, float variance) noexcept {
+    generate(nullptr, out.data(), out.size(), variance);
+}
+
+void GaussianNoise::add(std::span<const cf32> in, std::span<cf32> out, float variance) noexcept {
+    assert(in.size() == out.size());
+    generate(in.data(), out.data(), out.size(), variance);
+}
+
+void GaussianNoise::generate(const cf32* in, cf32* out, std::size_t n, float variance) noexcept {
+    const float sigma = std::sqrt(variance * 0.5f);
+    const std::size_t blocks = n / 2;
+    const float* x = reinterpret_cast<const float*>(in);
+    float* y = reinterpret_cast<float*>(out);
+    kernels_->gaussian(key_, stream_, counter_, blocks, sigma, x, y);
+    counter_ += blocks;
+    if (n % 2 != 0) {
+        float last[4];
+        kernels_->gaussian(key_, stream_, counter_, 1, sigma, nullptr, last);
+        ++counter_;
+        y[2 * n - 2] = x != nullptr ? x[2 * n - 2] + last[0] : last[0];
+        y[2 * n - 1] = x != nullptr ? x[2 * n - 1] + last[1] : last[1];
+    }
+}
+
+// --- FadingChannel -------------------------------------------------------
+
+const char* to_string(FadingProfile p) noexcept {
+    switch (p) {
+    case FadingProfile::flat: return "flat";
+    case FadingProfile::epa: return "epa";
+    case FadingProfile::eva: return "eva";
+    case FadingProfile::etu: return "etu";
+    }
+    return "unknown";
+}
+
+std::span<const FadingTap> fading_taps(FadingProfile p) noexcept {
+    switch (p) {
+    case FadingProfile::flat: return kFlat;
+    case FadingProfile::epa: return kEpa;
+    case FadingProfile::eva: return kEva;
+    case FadingProfile::etu: return kEtu;
+    }
+    return {};
+}
+
+FadingChannel::FadingChannel(const FadingConfig& config, std::uint64_t seed,
+                             std::uint64_t stream)
+    : FadingChannel(config, seed, stream, active_isa()) {}
+
+FadingChannel::FadingChannel(const FadingConfig& config, std::uint64_t seed,
+                             std::uint64_t stream, Isa isa)
+    : kernels_(&fading_kernels_for(isa)), config_(config), seed_(seed) {
+    const std::span<const FadingTap> taps = fading_taps(config.profile);
+    if (taps.empty()) {
+        throw std::invalid_argument("FadingChannel: unknown profile");
+    }
+    if (!(config.sample_rate > 0.0) || !(config.doppler_hz >= 0.0) ||
+        config.update_interval == 0) {
+        throw std::invalid_argument("FadingChannel: invalid rate, Doppler or update interval");
+    }
+    paths_ = taps.size();
+
+    // Delays in samples, and the filter length that holds the last one.
+    std::vector<double> delay(paths_);
+    double total_power = 0.0;
+    length_ = 1;
+    for (std::size_t p = 0; p < paths_; ++p) {
+        delay[p] = double(taps[p].delay_ns) * 1e-9 * config.sample_rate;
+        total_power += std::pow(10.0, double(taps[p].power_db) / 10.0);
+        const bool integral = delay[p] == std::floor(delay[p]);
+        const std::size_t last =
+            std::size_t(std::floor(delay[p])) + (integral ? 0 : kHalfWidth + 1);
+        length_ = std::max(length_, last + 1);
+    }
+
+    path_filters_.assign(paths_ * length_, 0.0f);
+    for (std::size_t p = 0; p < paths_; ++p) {
+        std::vector<double> h(length_, 0.0);
+        double energy = 0.0;
+        for (std::size_t n = 0; n < length_; ++n) {
+            const double x = double(n) - delay[p];
+            if (std::abs(x) > double(kHalfWidth)) {
+                continue;
+            }
+            const double window =
+                0.5 * (1.0 + std::cos(std::numbers::pi * x / double(kHalfWidth + 1)));
+            h[n] = sinc(x) * window;
+            energy += h[n] * h[n];
+        }
+        const double amplitude =
+            std::sqrt(std::pow(10.0, double(taps[p].power_db) / 10.0) / total_power / energy);
+        for (std::size_t n = 0; n < length_; ++n) {
+            path_filters_[p * length_ + n] = float(h[n] * amplitude);
+        }
+    }
+
+    phasors_.resize(paths_ * kSinusoids);
+    steps_.resize(paths_ * kSinusoids);
+    taps_.resize(length_);
+    // Re and im history, then re and im accumulators for one update.
+    history_.assign(2 * (length_ - 1 + config_.update_interval) + 2 * config_.update_interval,
+                    0.0f);
+    reset(stream);
+}
+
+void FadingChannel::reset(std::uint64_t stream) noexcept {
+    Philox4x32 rng(seed_, stream);
+    const double two_pi = 2.0 * std::numbers::pi;
+    const double wd = two_pi * config_.doppler_hz * double(config_.update_interval) /
+                      config_.sample_rate;
+    for (std::size_t p = 0; p < paths_; ++p) {
+        const double theta = two_pi * uniform(rng) - std::numbers::pi;
+        for (std::size_t m = 0; m < kSinusoids; ++m) {
+            const double alpha =
+                (two_pi * double(m + 1) - std::numbers::pi + theta) / double(kSinusoids);
+            const double phi = two_pi * uniform(rng);
+            const double w = wd * std::cos(alpha);
+            phasors_[p * kSinusoids + m] = {std::cos(phi), std::sin(phi)};
+            steps_[p * kSinusoids + m] = {std::cos(w), std::sin(w)};
+        }
+    }
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    until_update_ = 0;
+}
+
+void FadingChannel::update_taps() noexcept {
+    // Path gains at the current time, then advance every sinusoid one
+    // update. The phasors are kept in double: single precision would let
+    // their magnitude drift over long runs.
+    std::fill(taps_.begin(), taps_.end(), cf32{});
+    const double norm = 1.0 / std::sqrt(double(kSinusoids));
+    for (std::size_t p = 0; p < paths_; ++p) {
+        double gr = 0.0, gi = 0.0;
+        for (std::size_t m = 0; m < kSinusoids; ++m) {
+            std::complex<double>& z = phasors_[p * kSinusoids + m];
+            const std::complex<double> s = steps_[p * kSinusoids + m];
+            gr += z.real();
+            gi += z.imag();
+            z = {z.real() * s.real() - z.imag() * s.imag(),
+                 z.real() * s.imag() + z.imag() * s.real()};
+        }
+        const float re = float(gr * norm), im = float(gi * norm);
+        const float* h = path_filters_.data() + p * length_;
+        float* t = reinterpret_cast<float*>(taps_.data());
+        for (std::size_t n = 0; n < length_; ++n) {
+            t[2 * n] += re * h[n];
+            t[2 * n + 1] += im * h[n];
+        }
+    }
+}
+
+template <ComplexLayout L>
+void FadingChannel::filter(ConstComplexSpan<L> in, ComplexSpan<L> out) noexcept {
+    assert(in.size() == out.size());
+    const std::size_t keep = length_ - 1;
+    const std::size_t stride = keep + config_.update_interval;
+    float* hr = history_.data();
+    float* hi = hr + stride;
+    float* yr = hi + stride;
+    float* yi = yr + config_.update_interval;
+    std::size_t done = 0;
+    while (done < in.size()) {
+        if (until_update_ == 0) {
+            update_taps();
+            until_update_ = config_.update_interval;
+        }
+        const std::size_t n = std::min(until_update_, in.size() - done);
+        // The chunk joins the history before anything is written, so `out`
+        // may alias `in`. The history is split re/im so the tap loop is
+        // plain multiply-adds over contiguous floats.
+        convert(in.subspan(done, n), SplitSpan(hr + keep, hi + keep, n));
+        const float* taps = reinterpret_cast<const float*>(taps_.data());
+        if constexpr (std::same_as<L, Split>) {
+            kernels_->fir(taps, length_, hr + keep, hi + keep, n, out.re + done, out.im + done);
+        } else {
+            kernels_->fir(taps, length_, hr + keep, hi + keep, n, yr, yi);
+            convert(ConstSplitSpan(yr, yi, n), out.subspan(done, n));
+        }
+        std::copy(hr + n, hr + n + keep, hr);
+        std::copy(hi + n, hi + n + keep, hi);
+        done += n;
+        until_update_ -= n;
+    }
+}
+
+void FadingChannel::process(std::span<const cf32> in, std::span<cf32> out) noexcept {
+    filter<Interleaved>(in, out);
+}
+
+void FadingChannel::process(ConstSplitSpan in, SplitSpan out) noexcept {
+    filter<Split>(in, out);
+}
+
+}  // namespace dcomm
@@ -0,0 +1,162 @@
+#include "dcomm/complex_layout.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "kernels/complex_kernels.hpp"
+
+namespace dcomm {
+
+namespace {
+
+const kernels::ComplexKernels& complex_kernels_for(Isa isa) noexcept {
+    assert(isa_available(isa));
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx2: return kernels::complex_avx2;
+    case Isa::avx512: return kernels::complex_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+    case Isa::neon: return kernels::complex_neon;
+#endif
+    default: return kernels::complex_scalar;
+    }
+}
+
+const kernels::ComplexKernels& active_kernels() noexcept {
+    static const kernels::ComplexKernels& k = complex_kernels_for(active_isa());
+    return k;
+}
+
+const float* floats(std::span<const cf32> x) noexcept {
+    return reinterpret_cast<const float*>(x.data());
+}
+float* floats(std::span<cf32> x) noexcept { return reinterpret_cast<float*>(x.data()); }
+
+void convert_with(const kernels::ComplexKernels& k, std::span<const cf32> in,
+                  SplitSpan out) noexcept {
+    assert(in.size() == out.size());
+    k.deinterleave(floats(in), in.size(), out.re, out.im);
+}
+
+void convert_with(const kernels::ComplexKernels& k, ConstSplitSpan in,
+                  std::span<cf32> out) noexcept {
+    assert(in.size() == out.size());
+    k.interleave(in.re, in.im, in.size(), floats(out));
+}
+
+void multiply_with(const kernels::ComplexKernels& k, std::span<const cf32> a,
+                   std::span<const cf32> b, bool conj, std::span<cf32> out) noexcept {
+    assert(a.size() == out.size() && b.size() == out.size());
+    k.multiply(floats(a), floats(b), out.size(), conj, floats(out));
+}
+
+void multiply_with(const kernels::ComplexKernels& k, ConstSplitSpan a, ConstSplitSpan b,
+                   bool conj, SplitSpan out) noexcept {
+    assert(a.size() == out.size() && b.size() == out.size());
+    k.multiply_split(a.re, a.im, b.re, b.im, out.size(), conj, out.re, out.im);
+}
+
+void magnitude_with(const kernels::ComplexKernels& k, std::span<const cf32> x,
+                    std::span<float> out) noexcept {
+    assert(x.size() == out.size());
+    k.magnitude_squared(floats(x), x.size(), out.data());
+}
+
+void magnitude_with(const kernels::ComplexKernels& k, ConstSplitSpan x,
+                    std::span<float> out) noexcept {
+    assert(x.size() == out.size());
+    k.magnitude_squared_split(x.re, x.im, x.size(), out.data());
+}
+
+}  // namespace
+
+// --- Conversion ----------------------------------------------------------
+
+void convert(std::span<const cf32> in, SplitSpan out) noexcept {
+    convert_with(active_kernels(), in, out);
+}
+
+void convert(ConstSplitSpan in, std::span<cf32> out) noexcept {
+    convert_with(active_kernels(), in, out);
+}
+
+void convert(std::span<const cf32> in, std::span<cf32> out) noexcept {
+    assert(in.size() == out.size());
+    if (in.data() != out.data()) {
+        std::copy(in.begin(), in.end(), out.begin());
+    }
+}
+
+void convert(ConstSplitSpan in, SplitSpan out) noexcept {
+    assert(in.size() == out.size());
+    if (in.re != out.re) {
+        std::copy(in.re, in.re + in.size(), out.re);
+    }
+    if (in.im != out.im) {
+        std::copy(in.im, in.im + in.size(), out.im);
+    }
+}
+
+void convert(Isa isa, std::span<const cf32> in, SplitSpan out) noexcept {
+    convert_with(complex_kernels_for(isa), in, out);
+}
+
+void convert(Isa isa, ConstSplitSpan in, std::span<cf32> out) noexcept {
+    convert_with(complex_kernels_for(isa), in, out);
+}
+
+// --- Element-wise kernels ------------------------------------------------
+
+void multiply(std::span<const cf32> a, std::span<const cf32> b, std::span<cf32> out) noexcept {
+    multiply_with(active_kernels(), a, b, false, out);
+}
+
+void multiply(ConstSplitSpan a, ConstSplitSpan b, SplitSpan out) noexcept {
+    multiply_with(active_kernels(), a, b, false, out);
+}
+
+void multiply_conj(std::span<const cf32> a, std::span<const cf32> b,
+                   std::span<cf32> out) noexcept {
+    multiply_with(active_kernels(), a, b, true, out);
+}
+
+void multiply_conj(ConstSplitSpan a, ConstSplitSpan b, SplitSpan out) noexcept {
+    multiply_with(active_kernels(), a, b, true, out);
+}
+
+void magnitude_squared(std::span<const cf32> x, std::span<float> out) noexcept {
+    magnitude_with(active_kernels(), x, out);
+}
+
+void magnitude_squared(ConstSplitSpan x, std::span<float> out) noexcept {
+    magnitude_with(active_kernels(), x, out);
+}
+
+void multiply(Isa isa, std::span<const cf32> a, std::span<const cf32> b,
+              std::span<cf32> out) noexcept {
+    multiply_with(complex_kernels_for(isa), a, b, false, out);
+}
+
+void multiply(Isa isa, ConstSplitSpan a, ConstSplitSpan b, SplitSpan out) noexcept {
+    multiply_with(complex_kernels_for(isa), a, b, false, out);
+}
+
+void multiply_conj(Isa isa, std::span<const cf32> a, std::span<const cf32> b,
+                   std::span<cf32> out) noexcept {
+    multiply_with(complex_kernels_for(isa), a, b, true, out);
+}
+
+void multiply_conj(Isa isa, ConstSplitSpan a, ConstSplitSpan b, SplitSpan out) noexcept {
+    multiply_with(complex_kernels_for(isa), a, b, true, out);
+}
+
+void magnitude_squared(Isa isa, std::span<const cf32> x, std::span<float> out) noexcept {
+    magnitude_with(complex_kernels_for(isa), x, out);
+}
+
+void magnitude_squared(Isa isa, ConstSplitSpan x, std::span<float> out) noexcept {
+    magnitude_with(complex_kernels_for(isa), x, out);
+}
+
+}  // namespace dcomm
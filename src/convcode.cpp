@@ -0,0 +1,331 @@
+#include "dcomm/convcode.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+#include "kernels/viterbi_kernels.hpp"
+
+namespace dcomm {
+
+namespace {
+
+/// Coded output pair for the 7-bit window (newest bit in bit 6).
+inline unsigned conv_output(unsigned window) noexcept {
+    const unsigned a = std::popcount(window & kConvPolyA) & 1u;
+    const unsigned b = std::popcount(window & kConvPolyB) & 1u;
+    return (a << 1) | b;
+}
+
+/// Keep pattern over the interleaved A/B mother bits.
+struct PuncturePattern {
+    const std::uint8_t* keep;
+    unsigned period;
+    unsigned kept;
+};
+
+constexpr std::uint8_t kKeep12[] = {1, 1};
+constexpr std::uint8_t kKeep23[] = {1, 1, 1, 0};
+constexpr std::uint8_t kKeep34[] = {1, 1, 1, 0, 0, 1};
+
+constexpr PuncturePattern pattern(CodeRate rate) noexcept {
+    switch (rate) {
+    case CodeRate::r2_3: return {kKeep23, 4, 3};
+    case CodeRate::r3_4: return {kKeep34, 6, 4};
+    case CodeRate::r1_2: break;
+    }
+    return {kKeep12, 2, 2};
+}
+
+/// A keep pattern repeated over whole words: lcm(period, 64) bits, at most
+/// three words for the 802.11 periods.
+struct PunctureMasks {
+    std::uint64_t words[3];
+    std::size_t count;
+};
+
+constexpr PunctureMasks make_masks(CodeRate rate) noexcept {
+    const PuncturePattern p = pattern(rate);
+    PunctureMasks m{};
+    m.count = p.period % 3 == 0 ? 3 : 1;
+    for (std::size_t i = 0; i < 64 * m.count; ++i) {
+        m.words[i / 64] |= std::uint64_t(p.keep[i % p.period]) << (i % 64);
+    }
+    return m;
+}
+
+constexpr PunctureMasks kMasks23 = make_masks(CodeRate::r2_3);
+constexpr PunctureMasks kMasks34 = make_masks(CodeRate::r3_4);
+static_assert(kMasks23.words[0] == 0x7777777777777777);
+
+/// Bit i of the word holds input i - d: the input shifted by `d` stages,
+/// continued from the previous word.
+constexpr std::uint64_t delayed(std::uint64_t cur, std::uint64_t prev, unsigned d) noexcept {
+    return d == 0 ? cur : (cur << d) | (prev >> (64 - d));
+}
+
+/// One output word of the generator `poly` (newest input in bit 6).
+constexpr std::uint64_t conv_word(std::uint8_t poly, std::uint64_t cur,
+                                  std::uint64_t prev) noexcept {
+    std::uint64_t out = 0;
+    for (unsigned d = 0; d <= kConvMemory; ++d) {
+        if ((poly >> (kConvMemory - d)) & 1u) {
+            out ^= delayed(cur, prev, d);
+        }
+    }
+    return out;
+}
+
+/// Mean |llr| over at most this many evenly strided samples sets the
+/// quantiser scale.
+constexpr std::size_t kScaleSamples = 1024;
+/// Target mean magnitude of the 8-bit soft values: leaves headroom for the
+/// reliable tail of the distribution before clipping at 127.
+constexpr float kSoftMean = 20.0f;
+/// Start metric of every state but 0; far below any reachable metric yet
+/// clear of int16 saturation after a few stages.
+constexpr std::int16_t kUnreachable = -16384;
+
+const kernels::ViterbiKernels& viterbi_kernels_for(Isa isa) {
+    if (!isa_available(isa)) {
+        throw std::invalid_argument("ViterbiDecoder: ISA not available on this CPU");
+    }
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx2: return kernels::viterbi_avx2;
+    case Isa::avx512: return kernels::viterbi_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+    case Isa::neon: return kernels::viterbi_neon;
+#endif
+    default: return kernels::viterbi_scalar;
+    }
+}
+
+}  // namespace
+
+void conv_encode(std::span<const std::uint8_t> info,
+                 std::span<std::uint8_t> coded) noexcept {
+    assert(coded.size() >= conv_coded_bits(info.size()));
+    // `state` holds the previous six inputs, most recent in bit 5.
+    unsigned state = 0;
+    std::size_t o = 0;
+    const std::size_t n = info.size() + kConvMemory;
+    for (std::size_t i = 0; i < n; ++i) {
+        const unsigned bit = i < info.size() ? (info[i] & 1u) : 0u;
+        const unsigned out = conv_output((bit << kConvMemory) | state);
+        coded[o++] = std::uint8_t(out >> 1);
+        coded[o++] = std::uint8_t(out & 1u);
+        state = (bit << (kConvMemory - 1)) | (state >> 1);
+    }
+}
+
+void conv_encode(ConstBitSpan info, BitSpan coded) noexcept {
+    assert(coded.size() == conv_coded_bits(info.size()));
+    // The tail is the zero padding past the last information bit, so the
+    // input runs on for kConvMemory more bits.
+    constexpr std::size_t kChunk = 16;  // words per zip
+    const std::size_t steps = info.size() + kConvMemory;
+    const std::size_t nw = packed_words(steps);
+    std::uint64_t a[kChunk];
+    std::uint64_t b[kChunk];
+    std::uint64_t prev = 0;
+    for (std::size_t base = 0; base < nw; base += kChunk) {
+        const std::size_t n = std::min(kChunk, nw - base);
+        for (std::size_t k = 0; k < n; ++k) {
+            const std::size_t w = base + k;
+            std::uint64_t cur = 0;
+            if (w < info.word_count()) {
+                cur = info.words[w];
+                if (w + 1 == info.word_count()) {
+                    cur &= tail_mask(info.size());
+                }
+            }
+            a[k] = conv_word(kConvPolyA, cur, prev);
+            b[k] = conv_word(kConvPolyB, cur, prev);
+            prev = cur;
+        }
+        const std::size_t bits = std::min(64 * kChunk, steps - 64 * base);
+        zip_bits(ConstBitSpan(a, bits), ConstBitSpan(b, bits),
+                 coded.subspan(2 * 64 * base, 2 * bits));
+    }
+}
+
+std::size_t punctured_bits(CodeRate rate, std::size_t mother_bits) noexcept {
+    const PuncturePattern p = pattern(rate);
+    std::size_t n = mother_bits / p.period * p.kept;
+    for (unsigned i = 0; i < mother_bits % p.period; ++i) {
+        n += p.keep[i];
+    }
+    return n;
+}
+
+void puncture(CodeRate rate, std::span<const std::uint8_t> coded,
+              std::span<std::uint8_t> out) noexcept {
+    assert(out.size() >= punctured_bits(rate, coded.size()));
+    const PuncturePattern p = pattern(rate);
+    std::size_t o = 0;
+    unsigned phase = 0;
+    for (const std::uint8_t bit : coded) {
+        // o never passes the read position, so in-place use is safe.
+        if (p.keep[phase]) {
+            out[o++] = bit;
+        }
+        phase = phase + 1 == p.period ? 0 : phase + 1;
+    }
+}
+
+void puncture(CodeRate rate, ConstBitSpan coded, BitSpan out) noexcept {
+    assert(out.size() == punctured_bits(rate, coded.size()));
+    if (rate == CodeRate::r1_2) {
+        if (out.words != coded.words) {
+            std::copy_n(coded.words, coded.word_count(), out.words);
+        }
+        return;
+    }
+    const PunctureMasks& m = rate == CodeRate::r2_3 ? kMasks23 : kMasks34;
+    [[maybe_unused]] const std::size_t kept =
+        select_bits(coded, std::span(m.words, m.count), out);
+    assert(kept == out.size());
+}
+
+ViterbiDecoder::ViterbiDecoder(Isa isa) : kernels_(&viterbi_kernels_for(isa)) {}
+
+void ViterbiDecoder::traceback(unsigned state, std::size_t end, std::size_t begin,
+                               std::size_t stop, std::span<std::uint8_t> info) const noexcept {
+    for (std::size_t t = end; t-- > begin;) {
+        if (t < stop) {
+            info[t] = std::uint8_t(state >> (kConvMemory - 1));
+        }
+        const unsigned x = unsigned(survivors_[t % kRing] >> state) & 1u;
+        state = ((state << 1) & (kConvStates - 1)) | x;
+    }
+}
+
+void ViterbiDecoder::decode(std::span<const float> llrs, std::span<std::uint8_t> info,
+                            CodeRate rate) noexcept {
+    assert(llrs.size() == punctured_bits(rate, conv_coded_bits(info.size())));
+    begin(info.size(), rate, soft_scale(llrs));
+    feed(llrs, info);
+    finish(info);
+}
+
+float ViterbiDecoder::soft_scale(std::span<const float> llrs) noexcept {
+    // The trellis is scale invariant, so normalise the soft values to a fixed
+    // mean magnitude whatever the channel SNR.
+    const std::size_t stride = std::max<std::size_t>(1, llrs.size() / kScaleSamples);
+    float sum = 0.0f;
+    std::size_t samples = 0;
+    for (std::size_t i = 0; i < llrs.size(); i += stride, ++samples) {
+        sum += std::fabs(llrs[i]);
+    }
+    return sum > 0.0f ? kSoftMean * float(samples) / sum : 1.0f;
+}
+
+void ViterbiDecoder::begin(std::size_t info_bits, CodeRate rate, float scale) noexcept {
+    rate_ = rate;
+    scale_ = scale;
+    n_info_ = info_bits;
+    steps_ = info_bits + kConvMemory;
+    phase_ = 0;
+    filled_ = 0;
+    done_ = 0;
+    out_ = 0;
+    std::fill(metrics_.begin(), metrics_.end(), kUnreachable);
+    metrics_[0] = 0;
+}
+
+std::size_t ViterbiDecoder::feed(std::span<const float> llrs,
+                                 std::span<std::uint8_t> info) noexcept {
+    assert(info.size() == n_info_);
+    const PuncturePattern p = pattern(rate_);
+    const float* in = llrs.data();
+    const float* const end = in + llrs.size();
+    while (done_ < steps_) {
+        const std::size_t n = std::min(kWindow, steps_ - done_);
+        if (rate_ == CodeRate::r1_2 && filled_ == 0 && std::size_t(end - in) >= 2 * n) {
+            // Whole window at hand and nothing to restore: no copy.
+            kernels_->quantize(in, 2 * n, scale_, soft_.data());
+            in += 2 * n;
+        } else {
+            while (filled_ < 2 * n) {
+                if (p.keep[phase_] != 0) {
+                    if (in == end) {
+                        break;
+                    }
+                    depunctured_[filled_++] = *in++;
+                } else {
+                    depunctured_[filled_++] = 0.0f;
+                }
+                phase_ = phase_ + 1 == p.period ? 0 : phase_ + 1;
+            }
+            if (filled_ < 2 * n) {
+                break;
+            }
+            kernels_->quantize(depunctured_.data(), 2 * n, scale_, soft_.data());
+            filled_ = 0;
+        }
+        kernels_->forward(soft_.data(), n, metrics_.data(), survivors_.data() + done_ % kRing);
+        done_ += n;
+
+        if (done_ - out_ == kRing && done_ < steps_) {
+            const auto best = std::max_element(metrics_.begin(), metrics_.end());
+            traceback(unsigned(best - metrics_.begin()), done_, out_, out_ + kWindow, info);
+            out_ += kWindow;
+        }
+    }
+    return out_;
+}
+
+void ViterbiDecoder::finish(std::span<std::uint8_t> info) noexcept {
+    assert(done_ == steps_ && info.size() == n_info_);
+    // Terminated code: the final survivor is state 0.
+    traceback(0, done_, out_, n_info_, info);
+    out_ = n_info_;
+}
+
+ConvEncoderStage::ConvEncoderStage(std::size_t info_bits, CodeRate rate,
+                                   std::size_t pool_depth)
+    : info_bits_(info_bits), rate_(rate),
+      pool_(pool_depth, packed_words(conv_coded_bits(info_bits))) {}
+
+BufferView<std::uint64_t> ConvEncoderStage::process(BufferView<std::uint64_t> in) {
+    if (!in) {
+        return {};
+    }
+    BufferView<std::uint64_t> out = pool_.acquire();
+    if (!out) {
+        return {};
+    }
+    assert(in.size() == packed_words(info_bits_));
+    const std::size_t mother = conv_coded_bits(info_bits_);
+    const BitSpan coded(out.span(), mother);
+    conv_encode(ConstBitSpan(in.span(), info_bits_), coded);
+    if (rate_ != CodeRate::r1_2) {
+        const std::size_t n = punctured_bits(rate_, mother);
+        puncture(rate_, coded, BitSpan(coded.words, n));
+        out.resize(packed_words(n));
+    }
+    return out;
+}
+
+ViterbiStage::ViterbiStage(std::size_t info_bits, CodeRate rate, std::size_t pool_depth)
+    : info_bits_(info_bits), rate_(rate), pool_(pool_depth, info_bits) {}
+
+BufferView<std::uint8_t> ViterbiStage::process(BufferView<float> in) {
+    if (!in) {
+        return {};
+    }
+    BufferView<std::uint8_t> out = pool_.acquire();
+    if (!out) {
+        return {};
+    }
+    assert(in.size() == punctured_bits(rate_, conv_coded_bits(info_bits_)));
+    out.resize(info_bits_);
+    decoder_.decode(in.span(), out.span(), rate_);
+    return out;
+}
+
+}  // namespace dcomm
@@ -0,0 +1,144 @@
+#include "dcomm/converter.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+namespace dcomm {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double block_period(double sample_rate, std::size_t samples_per_block, const char* what) {
+    if (samples_per_block == 0 || !(sample_rate >= 0.0)) {
+        throw std::invalid_argument(what);
+    }
+    return sample_rate > 0.0 ? double(samples_per_block) / sample_rate : 0.0;
+}
+
+Clock::duration to_duration(double seconds) {
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+}  // namespace
+
+DacSink::DacSink(SampleRing& ring, double sample_rate, std::size_t samples_per_block,
+                 Handler handler)
+    : ring_(&ring),
+      block_period_s_(block_period(sample_rate, samples_per_block,
+                                   "DacSink: invalid sample rate or block size")),
+      handler_(std::move(handler)) {}
+
+DacSink::~DacSink() { stop(); }
+
+void DacSink::start() {
+    if (thread_.joinable()) {
+        return;
+    }
+    stop_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread([this] { run(); });
+}
+
+void DacSink::stop() {
+    stop_.store(true, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void DacSink::run() {
+    BufferView<cf32> block;
+    const auto play = [&] {
+        blocks_.fetch_add(1, std::memory_order_relaxed);
+        if (handler_) {
+            handler_(std::move(block));
+        }
+        block.reset();
+    };
+    if (block_period_s_ == 0.0) {
+        while (!stop_.load(std::memory_order_relaxed)) {
+            if (ring_->empty()) {
+                std::this_thread::yield();
+            } else if (ring_->try_pop(block)) {
+                play();
+            }
+        }
+        return;
+    }
+    const Clock::duration period = to_duration(block_period_s_);
+    Clock::time_point deadline = Clock::now();
+    while (!stop_.load(std::memory_order_relaxed)) {
+        deadline += period;
+        std::this_thread::sleep_until(deadline);
+        if (ring_->try_pop(block)) {
+            play();
+        }
+    }
+}
+
+AdcSource::AdcSource(SampleRing& ring, std::size_t pool_depth, double sample_rate,
+                     std::size_t samples_per_block, Fill fill)
+    : ring_(&ring),
+      pool_(pool_depth, samples_per_block),
+      block_period_s_(block_period(sample_rate, samples_per_block,
+                                   "AdcSource: invalid sample rate or block size")),
+      fill_(std::move(fill)) {
+    if (!fill_) {
+        throw std::invalid_argument("AdcSource: fill callback required");
+    }
+}
+
+AdcSource::~AdcSource() { stop(); }
+
+void AdcSource::start() {
+    if (thread_.joinable()) {
+        return;
+    }
+    stop_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread([this] { run(); });
+}
+
+void AdcSource::stop() {
+    stop_.store(true, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void AdcSource::run() {
+    const bool paced = block_period_s_ > 0.0;
+    const Clock::duration period = to_duration(block_period_s_);
+    Clock::time_point deadline = Clock::now();
+    while (!stop_.load(std::memory_order_relaxed)) {
+        if (paced) {
+            deadline += period;
+            std::this_thread::sleep_until(deadline);
+        }
+        BufferView<cf32> block = pool_.acquire();
+        if (!block) {
+            if (paced) {
+                pool_overruns_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+        if (!fill_(block.span())) {
+            break;
+        }
+        if (!paced) {
+            while (ring_->full() && !stop_.load(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+            }
+        }
+        if (ring_->try_push(block)) {
+            blocks_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    finished_.store(true, std::memory_order_release);
+}
+
+}  // namespace dcomm
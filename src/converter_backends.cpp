@@ -0,0 +1,403 @@
+#include "dcomm/converter_stream.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dcomm {
+
+namespace {
+
+[[noreturn]] void throw_errno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+/// Convert `n` samples to the wire format at `out`.
+void to_wire(IqFormat format, const cf32* in, std::byte* out, std::size_t n,
+             SaturationStats& stats) noexcept {
+    switch (format) {
+    case IqFormat::cf32:
+        std::memcpy(out, in, n * sizeof(cf32));
+        break;
+    case IqFormat::ci16:
+        quantize<ci16>({in, n}, {reinterpret_cast<ci16*>(out), n}, stats);
+        break;
+    case IqFormat::ci8:
+        quantize<ci8>({in, n}, {reinterpret_cast<ci8*>(out), n}, stats);
+        break;
+    }
+}
+
+/// Convert `n` samples from the wire format at `in`.
+void from_wire(IqFormat format, const std::byte* in, cf32* out, std::size_t n) noexcept {
+    switch (format) {
+    case IqFormat::cf32:
+        std::memcpy(out, in, n * sizeof(cf32));
+        break;
+    case IqFormat::ci16:
+        dequantize<ci16>({reinterpret_cast<const ci16*>(in), n}, {out, n});
+        break;
+    case IqFormat::ci8:
+        dequantize<ci8>({reinterpret_cast<const ci8*>(in), n}, {out, n});
+        break;
+    }
+}
+
+}  // namespace
+
+// --- FileBackend ---------------------------------------------------------
+
+FileBackend::FileBackend(const std::string& read_path, const std::string& write_path,
+                         SigmfMeta write_meta) {
+    if (!read_path.empty()) {
+        source_ = std::make_unique<IqFileSource>(read_path);
+    }
+    if (!write_path.empty()) {
+        sink_ = std::make_unique<IqFileSink>(write_path, std::move(write_meta));
+    }
+}
+
+FileBackend::~FileBackend() = default;
+
+bool FileBackend::write(std::span<const cf32> block) {
+    if (!sink_) {
+        return false;
+    }
+    sink_->write(block);
+    return true;
+}
+
+bool FileBackend::read(std::span<cf32> block) {
+    if (!source_) {
+        return false;
+    }
+    const std::size_t n = source_->read(block);
+    std::fill(block.begin() + std::ptrdiff_t(n), block.end(), cf32{});
+    return n > 0;
+}
+
+void FileBackend::close() {
+    if (sink_) {
+        sink_->close();
+    }
+}
+
+// --- UdpBackend ----------------------------------------------------------
+
+UdpBackend::UdpBackend(const UdpConfig& config) : config_(config) {
+    const std::size_t unit = sample_bytes(config_.format);
+    if (config_.datagram_bytes < unit || config_.datagram_bytes > 65507) {
+        throw std::invalid_argument("UdpBackend: datagram size must hold a sample and fit UDP");
+    }
+    sockaddr_in remote{};
+    if (!config_.remote_host.empty()) {
+        remote.sin_family = AF_INET;
+        remote.sin_port = htons(config_.remote_port);
+        if (inet_pton(AF_INET, config_.remote_host.c_str(), &remote.sin_addr) != 1) {
+            throw std::invalid_argument("UdpBackend: not an IPv4 address: " +
+                                        config_.remote_host);
+        }
+    }
+    try {
+        if (config_.listen_port != 0) {
+            rx_fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+            if (rx_fd_ < 0) {
+                throw_errno("UdpBackend: socket");
+            }
+            const int buffer = 4 << 20;
+            ::setsockopt(rx_fd_, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+            if (config_.receive_timeout.count() > 0) {
+                timeval tv{};
+                tv.tv_sec = time_t(config_.receive_timeout.count() / 1000);
+                tv.tv_usec = suseconds_t(config_.receive_timeout.count() % 1000 * 1000);
+                ::setsockopt(rx_fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+            }
+            sockaddr_in local{};
+            local.sin_family = AF_INET;
+            local.sin_port = htons(config_.listen_port);
+            local.sin_addr.s_addr = htonl(INADDR_ANY);
+            if (::bind(rx_fd_, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0) {
+                throw_errno("UdpBackend: bind to port " + std::to_string(config_.listen_port));
+            }
+        }
+        if (!config_.remote_host.empty()) {
+            tx_fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+            if (tx_fd_ < 0) {
+                throw_errno("UdpBackend: socket");
+            }
+            if (::connect(tx_fd_, reinterpret_cast<const sockaddr*>(&remote), sizeof(remote)) !=
+                0) {
+                throw_errno("UdpBackend: connect to " + config_.remote_host);
+            }
+        }
+    } catch (...) {
+        close_sockets();
+        throw;
+    }
+    // Large enough for any datagram a peer may send, so none is truncated.
+    datagram_.resize(65536);
+    outgoing_.resize(config_.datagram_bytes);
+}
+
+UdpBackend::~UdpBackend() { close_sockets(); }
+
+void UdpBackend::close_sockets() noexcept {
+    if (rx_fd_ >= 0) {
+        ::close(rx_fd_);
+        rx_fd_ = -1;
+    }
+    if (tx_fd_ >= 0) {
+        ::close(tx_fd_);
+        tx_fd_ = -1;
+    }
+}
+
+bool UdpBackend::write(std::span<const cf32> block) {
+    if (tx_fd_ < 0) {
+        return false;
+    }
+    const std::size_t unit = sample_bytes(config_.format);
+    const std::size_t per_datagram = config_.datagram_bytes / unit;
+    for (std::size_t i = 0; i < block.size(); i += per_datagram) {
+        const std::size_t n = std::min(per_datagram, block.size() - i);
+        to_wire(config_.format, block.data() + i, outgoing_.data(), n, saturation_);
+        while (::send(tx_fd_, outgoing_.data(), n * unit, 0) < 0) {
+            // Nobody listening yet: the samples are lost, as on a real link.
+            if (errno == ECONNREFUSED) {
+                break;
+            }
+            if (errno != EINTR && errno != ENOBUFS) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool UdpBackend::read(std::span<cf32> block) {
+    if (rx_fd_ < 0) {
+        return false;
+    }
+    const std::size_t unit = sample_bytes(config_.format);
+    std::size_t filled = 0;
+    while (filled < block.size()) {
+        if (consumed_ == pending_) {
+            const ssize_t got = ::recv(rx_fd_, datagram_.data(), datagram_.size(), 0);
+            if (got < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;  // timed out or the socket failed
+            }
+            pending_ = std::size_t(got) / unit * unit;
+            consumed_ = 0;
+            continue;
+        }
+        const std::size_t n = std::min((pending_ - consumed_) / unit, block.size() - filled);
+        from_wire(config_.format, datagram_.data() + consumed_, block.data() + filled, n);
+        consumed_ += n * unit;
+        filled += n;
+    }
+    return true;
+}
+
+// --- SharedMemoryBackend -------------------------------------------------
+
+/// Header at the start of each shared ring; samples follow at kDataOffset.
+struct SharedMemoryBackend::Ring {
+    static constexpr std::uint64_t kMagic = 0x676e69722d6d6f63;  // "com-ring"
+    static constexpr std::size_t kDataOffset = 256;
+
+    std::atomic<std::uint64_t> magic;  // stored last by the creator
+    std::uint64_t capacity;            // samples, a power of two
+    std::uint32_t format;
+    alignas(64) std::atomic<std::uint64_t> head;  // samples written
+    alignas(64) std::atomic<std::uint64_t> tail;  // samples read
+    alignas(64) std::atomic<std::uint32_t> closed;
+
+    std::byte* data() noexcept { return reinterpret_cast<std::byte*>(this) + kDataOffset; }
+};
+
+static_assert(sizeof(SharedMemoryBackend::Ring) <= SharedMemoryBackend::Ring::kDataOffset);
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "shared rings need address-free atomics");
+
+SharedMemoryBackend::SharedMemoryBackend(const SharedMemoryConfig& config) : config_(config) {
+    if (config_.samples_per_block == 0) {
+        throw std::invalid_argument("SharedMemoryBackend: samples_per_block must be > 0");
+    }
+    if (config_.create && config_.capacity < config_.samples_per_block) {
+        throw std::invalid_argument("SharedMemoryBackend: capacity below one block");
+    }
+    config_.capacity = std::bit_ceil(config_.capacity);
+    try {
+        if (!config_.tx_name.empty()) {
+            tx_ = map(config_.tx_name);
+        }
+        if (!config_.rx_name.empty()) {
+            rx_ = map(config_.rx_name);
+        }
+        // An attached ring brings its creator's capacity.
+        for (const Mapping* m : {&tx_, &rx_}) {
+            if (m->ring != nullptr && m->ring->capacity < config_.samples_per_block) {
+                throw std::invalid_argument("SharedMemoryBackend: ring " + m->name +
+                                            " holds less than one block");
+            }
+        }
+    } catch (...) {
+        unmap(tx_);
+        unmap(rx_);
+        throw;
+    }
+}
+
+SharedMemoryBackend::~SharedMemoryBackend() {
+    if (tx_.ring != nullptr) {
+        tx_.ring->closed.store(1, std::memory_order_release);
+    }
+    unmap(tx_);
+    unmap(rx_);
+}
+
+SharedMemoryBackend::Mapping SharedMemoryBackend::map(const std::string& name) {
+    Mapping m;
+    m.name = name;
+    const int fd = ::shm_open(name.c_str(), config_.create ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR,
+                              0600);
+    if (fd < 0) {
+        throw_errno("SharedMemoryBackend: shm_open " + name);
+    }
+    if (config_.create) {
+        m.bytes = Ring::kDataOffset + config_.capacity * sample_bytes(config_.format);
+        if (::ftruncate(fd, off_t(m.bytes)) != 0) {
+            const int error = errno;
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            throw std::system_error(error, std::generic_category(),
+                                    "SharedMemoryBackend: ftruncate " + name);
+        }
+    } else {
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || std::size_t(st.st_size) < Ring::kDataOffset) {
+            ::close(fd);
+            throw std::invalid_argument("SharedMemoryBackend: not a sample ring: " + name);
+        }
+        m.bytes = std::size_t(st.st_size);
+    }
+    void* p = ::mmap(nullptr, m.bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        if (config_.create) {
+            ::shm_unlink(name.c_str());
+        }
+        throw std::system_error(error, std::generic_category(),
+                                "SharedMemoryBackend: mmap " + name);
+    }
+    if (config_.create) {
+        m.ring = new (p) Ring{};
+        m.ring->capacity = config_.capacity;
+        m.ring->format = std::uint32_t(config_.format);
+        m.ring->magic.store(Ring::kMagic, std::memory_order_release);
+        return m;
+    }
+    m.ring = static_cast<Ring*>(p);
+    const std::size_t unit = sample_bytes(config_.format);
+    if (m.ring->magic.load(std::memory_order_acquire) != Ring::kMagic ||
+        m.ring->format != std::uint32_t(config_.format) ||
+        !std::has_single_bit(m.ring->capacity) ||
+        Ring::kDataOffset + m.ring->capacity * unit > m.bytes) {
+        m.ring = nullptr;
+        ::munmap(p, m.bytes);
+        throw std::invalid_argument("SharedMemoryBackend: ring " + name +
+                                    " is not initialised or has another format");
+    }
+    return m;
+}
+
+void SharedMemoryBackend::unmap(Mapping& m) noexcept {
+    if (m.ring == nullptr) {
+        return;
+    }
+    ::munmap(m.ring, m.bytes);
+    m.ring = nullptr;
+    if (config_.create) {
+        ::shm_unlink(m.name.c_str());
+    }
+}
+
+bool SharedMemoryBackend::write(std::span<const cf32> block) {
+    Ring* ring = tx_.ring;
+    if (ring == nullptr) {
+        return false;
+    }
+    if (block.size() > config_.samples_per_block) {
+        return false;
+    }
+    const std::uint64_t capacity = ring->capacity;
+    const std::uint64_t head = ring->head.load(std::memory_order_relaxed);
+    if (head + block.size() - ring->tail.load(std::memory_order_acquire) > capacity) {
+        ++dropped_;
+        return true;
+    }
+    const std::size_t unit = sample_bytes(config_.format);
+    const std::size_t at = std::size_t(head & (capacity - 1));
+    const std::size_t first = std::min(block.size(), std::size_t(capacity) - at);
+    to_wire(config_.format, block.data(), ring->data() + at * unit, first, saturation_);
+    to_wire(config_.format, block.data() + first, ring->data(), block.size() - first,
+            saturation_);
+    ring->head.store(head + block.size(), std::memory_order_release);
+    return true;
+}
+
+bool SharedMemoryBackend::read(std::span<cf32> block) {
+    Ring* ring = rx_.ring;
+    if (ring == nullptr) {
+        return false;
+    }
+    if (block.size() > config_.samples_per_block) {
+        return false;
+    }
+    const std::uint64_t capacity = ring->capacity;
+    const std::uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    std::size_t n = block.size();
+    for (;;) {
+        // Closed is read before head, so a writer's last block is seen.
+        const bool closed = ring->closed.load(std::memory_order_acquire) != 0;
+        const std::uint64_t available = ring->head.load(std::memory_order_acquire) - tail;
+        if (available >= n) {
+            break;
+        }
+        if (closed) {
+            if (available == 0) {
+                return false;
+            }
+            n = std::size_t(available);
+            break;
+        }
+        std::this_thread::yield();
+    }
+    const std::size_t unit = sample_bytes(config_.format);
+    const std::size_t at = std::size_t(tail & (capacity - 1));
+    const std::size_t first = std::min(n, std::size_t(capacity) - at);
+    from_wire(config_.format, ring->data() + at * unit, block.data(), first);
+    from_wire(config_.format, ring->data(), block.data() + first, n - first);
+    std::fill(block.begin() + std::ptrdiff_t(n), block.end(), cf32{});
+    ring->tail.store(tail + n, std::memory_order_release);
+    return true;
+}
+
+}  // namespace dcomm
@@ -0,0 +1,282 @@
+#include "dcomm/converter_stream.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace dcomm {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::int64_t now_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               Clock::now().time_since_epoch())
+        .count();
+}
+
+Clock::time_point to_time_point(std::int64_t ns) noexcept {
+    return Clock::time_point(
+        std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(ns)));
+}
+
+std::chrono::nanoseconds block_period(const StreamConfig& config, const char* what) {
+    if (config.samples_per_block == 0 || !(config.sample_rate >= 0.0) || config.buffers < 2) {
+        throw std::invalid_argument(what);
+    }
+    if (config.sample_rate == 0.0) {
+        return std::chrono::nanoseconds(0);
+    }
+    return std::chrono::nanoseconds(
+        std::llround(double(config.samples_per_block) / config.sample_rate * 1e9));
+}
+
+void record_budget(std::atomic<std::int64_t>& sum, std::atomic<std::int64_t>& min,
+                   std::int64_t budget) noexcept {
+    sum.fetch_add(budget, std::memory_order_relaxed);
+    std::int64_t m = min.load(std::memory_order_relaxed);
+    while (budget < m && !min.compare_exchange_weak(m, budget, std::memory_order_relaxed)) {
+    }
+}
+
+DeadlineStats make_stats(std::uint64_t blocks, std::uint64_t late, std::uint64_t budgets,
+                         std::chrono::nanoseconds period, std::int64_t sum,
+                         std::int64_t min) noexcept {
+    DeadlineStats s;
+    s.blocks = blocks;
+    s.late = late;
+    s.period = period;
+    if (period.count() > 0 && budgets > 0) {
+        s.min_budget = std::chrono::nanoseconds(min);
+        s.mean_budget = std::chrono::nanoseconds(sum / std::int64_t(budgets));
+    }
+    return s;
+}
+
+constexpr std::int64_t kNoBudget = std::numeric_limits<std::int64_t>::max();
+
+}  // namespace
+
+// --- DacStream -----------------------------------------------------------
+
+DacStream::DacStream(ConverterBackend& backend, const StreamConfig& config)
+    : backend_(&backend),
+      config_(config),
+      period_(block_period(config, "DacStream: invalid sample rate, block size or buffers")),
+      memory_(make_aligned_array<cf32>(config.buffers * config.samples_per_block)),
+      committed_at_(config.buffers),
+      budget_min_(kNoBudget) {}
+
+DacStream::~DacStream() { stop(); }
+
+void DacStream::start() {
+    if (thread_.joinable()) {
+        return;
+    }
+    stop_.store(false, std::memory_order_relaxed);
+    next_transfer_.store(now_ns() + period_.count(), std::memory_order_relaxed);
+    thread_ = std::thread([this] { run(); });
+}
+
+void DacStream::stop() {
+    stop_.store(true, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::span<cf32> DacStream::acquire() {
+    const std::uint64_t k = committed_.load(std::memory_order_relaxed);
+    while (k - sent_.load(std::memory_order_acquire) >= config_.buffers) {
+        if (failed_.load(std::memory_order_relaxed)) {
+            return {};
+        }
+        std::this_thread::yield();
+    }
+    return {memory_.get() + k % config_.buffers * config_.samples_per_block,
+            config_.samples_per_block};
+}
+
+void DacStream::commit() noexcept {
+    const std::uint64_t k = committed_.load(std::memory_order_relaxed);
+    committed_at_[k % config_.buffers].store(now_ns(), std::memory_order_relaxed);
+    committed_.store(k + 1, std::memory_order_release);
+}
+
+std::chrono::nanoseconds DacStream::budget_left() const noexcept {
+    if (period_.count() == 0) {
+        return std::chrono::nanoseconds(0);
+    }
+    const std::uint64_t ahead =
+        committed_.load(std::memory_order_relaxed) - sent_.load(std::memory_order_acquire);
+    const std::int64_t due = next_transfer_.load(std::memory_order_relaxed) +
+                             std::int64_t(ahead) * period_.count();
+    return std::chrono::nanoseconds(due - now_ns());
+}
+
+DeadlineStats DacStream::deadline_stats() const noexcept {
+    const std::uint64_t sent = sent_.load(std::memory_order_relaxed);
+    return make_stats(sent, late_.load(std::memory_order_relaxed), sent, period_,
+                      budget_sum_.load(std::memory_order_relaxed),
+                      budget_min_.load(std::memory_order_relaxed));
+}
+
+void DacStream::run() {
+    const bool paced = period_.count() > 0;
+    const AlignedArray<cf32> silence = make_aligned_array<cf32>(config_.samples_per_block);
+    std::fill_n(silence.get(), config_.samples_per_block, cf32{});
+    std::int64_t due = next_transfer_.load(std::memory_order_relaxed);
+    for (;;) {
+        const std::uint64_t k = sent_.load(std::memory_order_relaxed);
+        const bool stopping = stop_.load(std::memory_order_relaxed);
+        const bool ready = committed_.load(std::memory_order_acquire) > k;
+        if (stopping && !ready) {
+            return;
+        }
+        if (!paced) {
+            if (!ready) {
+                std::this_thread::yield();
+                continue;
+            }
+        } else {
+            std::this_thread::sleep_until(to_time_point(due));
+        }
+        // The DMA engine looks at the buffer once, at its transfer time.
+        if (committed_.load(std::memory_order_acquire) > k) {
+            const std::size_t slot = k % config_.buffers;
+            if (paced) {
+                record_budget(budget_sum_, budget_min_,
+                              due - committed_at_[slot].load(std::memory_order_relaxed));
+            }
+            const std::span<const cf32> block(
+                memory_.get() + slot * config_.samples_per_block, config_.samples_per_block);
+            if (!backend_->write(block)) {
+                failed_.store(true, std::memory_order_relaxed);
+                return;
+            }
+            sent_.store(k + 1, std::memory_order_release);
+        } else {
+            late_.fetch_add(1, std::memory_order_relaxed);
+            if (!backend_->write({silence.get(), config_.samples_per_block})) {
+                failed_.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+        if (paced) {
+            due += period_.count();
+            next_transfer_.store(due, std::memory_order_relaxed);
+        }
+    }
+}
+
+// --- AdcStream -----------------------------------------------------------
+
+AdcStream::AdcStream(ConverterBackend& backend, const StreamConfig& config)
+    : backend_(&backend),
+      config_(config),
+      period_(block_period(config, "AdcStream: invalid sample rate, block size or buffers")),
+      memory_(make_aligned_array<cf32>(config.buffers * config.samples_per_block)),
+      scratch_(make_aligned_array<cf32>(config.samples_per_block)),
+      filled_at_(config.buffers),
+      budget_min_(kNoBudget) {}
+
+AdcStream::~AdcStream() { stop(); }
+
+void AdcStream::start() {
+    if (thread_.joinable()) {
+        return;
+    }
+    stop_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread([this] { run(); });
+}
+
+void AdcStream::stop() {
+    stop_.store(true, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::span<const cf32> AdcStream::acquire() {
+    const std::uint64_t k = released_.load(std::memory_order_relaxed);
+    while (filled_.load(std::memory_order_acquire) == k) {
+        // finished_ is stored after the last block, so recheck once it is set.
+        if (finished_.load(std::memory_order_acquire) &&
+            filled_.load(std::memory_order_acquire) == k) {
+            return {};
+        }
+        std::this_thread::yield();
+    }
+    return {memory_.get() + k % config_.buffers * config_.samples_per_block,
+            config_.samples_per_block};
+}
+
+void AdcStream::release() noexcept {
+    const std::uint64_t k = released_.load(std::memory_order_relaxed);
+    if (period_.count() > 0) {
+        record_budget(budget_sum_, budget_min_, budget_left().count());
+    }
+    released_.store(k + 1, std::memory_order_release);
+}
+
+std::chrono::nanoseconds AdcStream::budget_left() const noexcept {
+    if (period_.count() == 0) {
+        return std::chrono::nanoseconds(0);
+    }
+    const std::uint64_t k = released_.load(std::memory_order_relaxed);
+    const std::int64_t due = filled_at_[k % config_.buffers].load(std::memory_order_relaxed) +
+                             std::int64_t(config_.buffers - 1) * period_.count();
+    return std::chrono::nanoseconds(due - now_ns());
+}
+
+DeadlineStats AdcStream::deadline_stats() const noexcept {
+    return make_stats(filled_.load(std::memory_order_relaxed),
+                      late_.load(std::memory_order_relaxed),
+                      released_.load(std::memory_order_relaxed), period_,
+                      budget_sum_.load(std::memory_order_relaxed),
+                      budget_min_.load(std::memory_order_relaxed));
+}
+
+void AdcStream::run() {
+    const bool paced = config_.paced && period_.count() > 0;
+    std::int64_t due = now_ns();
+    while (!stop_.load(std::memory_order_relaxed)) {
+        const std::uint64_t k = filled_.load(std::memory_order_relaxed);
+        if (paced) {
+            due += period_.count();
+            std::this_thread::sleep_until(to_time_point(due));
+        }
+        bool free = k - released_.load(std::memory_order_acquire) < config_.buffers;
+        if (!free && !paced) {
+            // The backend queues samples itself: wait for a buffer rather
+            // than lose a block, and count the stall when on the clock.
+            if (period_.count() > 0) {
+                late_.fetch_add(1, std::memory_order_relaxed);
+            }
+            while (k - released_.load(std::memory_order_acquire) >= config_.buffers) {
+                if (stop_.load(std::memory_order_relaxed)) {
+                    finished_.store(true, std::memory_order_release);
+                    return;
+                }
+                std::this_thread::yield();
+            }
+            free = true;
+        }
+        cf32* target = free ? memory_.get() + k % config_.buffers * config_.samples_per_block
+                            : scratch_.get();
+        if (!backend_->read({target, config_.samples_per_block})) {
+            break;
+        }
+        if (!free) {
+            late_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        filled_at_[k % config_.buffers].store(paced ? due : now_ns(), std::memory_order_relaxed);
+        filled_.store(k + 1, std::memory_order_release);
+    }
+    finished_.store(true, std::memory_order_release);
+}
+
+}  // namespace dcomm
@@ -0,0 +1,111 @@
+#include "dcomm/cpu_features.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+#if defined(__aarch64__) && defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace dcomm {
+
+namespace {
+
+CpuFeatures detect() noexcept {
+    CpuFeatures f;
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    f.avx2 = __builtin_cpu_supports("avx2");
+    f.avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+               __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512dq");
+    f.bmi2 = __builtin_cpu_supports("bmi2");
+    f.pclmul = __builtin_cpu_supports("pclmul");
+    f.vpclmul = __builtin_cpu_supports("vpclmulqdq");
+#elif defined(__aarch64__)
+    f.neon = true;
+#if defined(__linux__)
+    f.pmull = (getauxval(AT_HWCAP) & HWCAP_PMULL) != 0;
+#endif
+#endif
+    return f;
+}
+
+bool compiled_in(Isa isa) noexcept {
+    switch (isa) {
+    case Isa::scalar: return true;
+    case Isa::avx2:
+    case Isa::avx512:
+#if defined(DCOMM_KERNELS_X86)
+        return true;
+#else
+        return false;
+#endif
+    case Isa::neon:
+#if defined(DCOMM_KERNELS_NEON)
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+Isa select_isa() noexcept {
+    if (const char* env = std::getenv("DCOMM_ISA")) {
+        for (Isa isa : {Isa::scalar, Isa::avx2, Isa::avx512, Isa::neon}) {
+            if (std::strcmp(env, to_string(isa)) == 0 && isa_available(isa)) {
+                return isa;
+            }
+        }
+    }
+    for (Isa isa : {Isa::avx512, Isa::avx2, Isa::neon}) {
+        if (isa_available(isa)) {
+            return isa;
+        }
+    }
+    return Isa::scalar;
+}
+
+}  // namespace
+
+const char* to_string(Isa isa) noexcept {
+    switch (isa) {
+    case Isa::scalar: return "scalar";
+    case Isa::avx2: return "avx2";
+    case Isa::avx512: return "avx512";
+    case Isa::neon: return "neon";
+    }
+    return "unknown";
+}
+
+const CpuFeatures& cpu_features() noexcept {
+    static const CpuFeatures features = detect();
+    return features;
+}
+
+bool isa_available(Isa isa) noexcept {
+    if (!compiled_in(isa)) {
+        return false;
+    }
+    switch (isa) {
+    case Isa::scalar: return true;
+    case Isa::avx2: return cpu_features().avx2;
+    case Isa::avx512: return cpu_features().avx512;
+    case Isa::neon: return cpu_features().neon;
+    }
+    return false;
+}
+
+Isa active_isa() noexcept {
+    static const Isa isa = select_isa();
+    return isa;
+}
+
+namespace {
+// Probe during static initialisation so no kernel call pays for it.
+[[maybe_unused]] const Isa g_startup_isa = active_isa();
+}  // namespace
+
+}  // namespace dcomm
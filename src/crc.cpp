@@ -0,0 +1,163 @@
+#include "dcomm/crc.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <string_view>
+
+#include "kernels/crc_kernels.hpp"
+
+namespace dcomm {
+
+namespace {
+
+const kernels::CrcKernels& crc_kernels_for(Isa isa) noexcept {
+    assert(isa_available(isa));
+    [[maybe_unused]] const CpuFeatures& f = cpu_features();
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx512:
+        if (f.vpclmul) {
+            return kernels::crc_avx512;
+        }
+        [[fallthrough]];
+    case Isa::avx2: return f.pclmul ? kernels::crc_avx2 : kernels::crc_scalar;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+    case Isa::neon: return f.pmull ? kernels::crc_neon : kernels::crc_scalar;
+#endif
+    default: return kernels::crc_scalar;
+    }
+}
+
+const kernels::CrcKernels& active_kernels() noexcept {
+    static const kernels::CrcKernels& k = crc_kernels_for(active_isa());
+    return k;
+}
+
+template <CrcSpec S>
+constexpr kernels::CrcConstants kConstants =
+    kernels::make_crc_constants(S.width, S.poly, S.reflected);
+
+constexpr std::uint32_t reflect(std::uint32_t v, unsigned width) noexcept {
+    return kernels::crc_reverse32(v) >> (32 - width);
+}
+
+/// Register layout of crc_kernels.hpp: MSB-first values in the top bits,
+/// reflected ones bit-reversed in the low bits.
+template <CrcSpec S>
+constexpr std::uint32_t initial_register() noexcept {
+    return S.reflected ? reflect(S.init, S.width) : S.init << (32 - S.width);
+}
+
+template <CrcSpec S>
+constexpr std::uint32_t finish(std::uint32_t reg) noexcept {
+    const std::uint32_t mask = 0xffffffffu >> (32 - S.width);
+    return ((S.reflected ? reg : reg >> (32 - S.width)) ^ S.xorout) & mask;
+}
+
+/// Byte-at-a-time CRC of the catalogue check string "123456789".
+template <CrcSpec S>
+constexpr std::uint32_t check_value() noexcept {
+    const auto& t = kConstants<S>.table[0];
+    std::uint32_t reg = initial_register<S>();
+    for (const char ch : std::string_view("123456789")) {
+        const auto b = std::uint8_t(ch);
+        reg = S.reflected ? (reg >> 8) ^ t[(reg ^ b) & 0xff] : (reg << 8) ^ t[(reg >> 24) ^ b];
+    }
+    return finish<S>(reg);
+}
+
+static_assert(check_value<kCrc24a>() == 0xcde703);  // CRC-24/LTE-A
+static_assert(check_value<kCrc24b>() == 0x23ef52);  // CRC-24/LTE-B
+static_assert(check_value<kCrc16>() == 0x31c3);     // CRC-16/XMODEM
+static_assert(check_value<kCrc32>() == 0xcbf43926);  // CRC-32/ISO-HDLC
+
+std::uint32_t crc24_bitwise(std::uint32_t poly, std::uint32_t reg,
+                            std::span<const std::uint8_t> bits) noexcept {
+    for (const std::uint8_t bit : bits) {
+        const std::uint32_t fb = ((reg >> 23) ^ bit) & 1u;
+        reg = ((reg << 1) & 0xffffff) ^ (fb ? poly : 0u);
+    }
+    return reg;
+}
+
+/// Whole bytes packed MSB first through Crc<S>, the last bits one by one.
+template <CrcSpec S>
+std::uint32_t crc24_packed(std::span<const std::uint8_t> bits) noexcept {
+    Crc<S> crc;
+    std::uint8_t bytes[256];
+    std::size_t done = 0;
+    while (bits.size() - done >= 8) {
+        const std::size_t n = std::min((bits.size() - done) / 8, sizeof bytes);
+        const std::uint8_t* b = bits.data() + done;
+        for (std::size_t j = 0; j < n; ++j, b += 8) {
+            unsigned v = 0;
+            for (int k = 0; k < 8; ++k) {
+                v = (v << 1) | (b[k] & 1u);
+            }
+            bytes[j] = std::uint8_t(v);
+        }
+        crc.update({bytes, n});
+        done += 8 * n;
+    }
+    return crc24_bitwise(S.poly, crc.value(), bits.subspan(done));
+}
+
+}  // namespace
+
+std::uint32_t crc24(std::uint32_t poly, std::span<const std::uint8_t> bits) noexcept {
+    switch (poly) {
+    case kCrc24aPoly: return crc24_packed<kCrc24a>(bits);
+    case kCrc24bPoly: return crc24_packed<kCrc24b>(bits);
+    case kCrc24cPoly: return crc24_packed<kCrc24c>(bits);
+    default: return crc24_bitwise(poly, 0, bits);
+    }
+}
+
+void crc24_attach(std::uint32_t poly, std::span<std::uint8_t> bits) noexcept {
+    assert(bits.size() >= 24);
+    const std::size_t n = bits.size() - 24;
+    const std::uint32_t crc = crc24(poly, bits.first(n));
+    for (unsigned i = 0; i < 24; ++i) {
+        bits[n + i] = std::uint8_t((crc >> (23 - i)) & 1u);
+    }
+}
+
+// --- Crc -----------------------------------------------------------------
+
+template <CrcSpec Spec>
+Crc<Spec>::Crc() noexcept : kernels_(&active_kernels()), reg_(initial_register<Spec>()) {}
+
+template <CrcSpec Spec>
+Crc<Spec>::Crc(Isa isa) noexcept
+    : kernels_(&crc_kernels_for(isa)), reg_(initial_register<Spec>()) {}
+
+template <CrcSpec Spec>
+Crc<Spec>& Crc<Spec>::update(std::span<const std::uint8_t> bytes) noexcept {
+    reg_ = kernels_->update(kConstants<Spec>, reg_, bytes.data(), bytes.size());
+    return *this;
+}
+
+template <CrcSpec Spec>
+std::uint32_t Crc<Spec>::value() const noexcept {
+    return finish<Spec>(reg_);
+}
+
+template <CrcSpec Spec>
+void Crc<Spec>::reset() noexcept {
+    reg_ = initial_register<Spec>();
+}
+
+template <CrcSpec Spec>
+std::uint32_t Crc<Spec>::compute(std::span<const std::uint8_t> bytes) noexcept {
+    return finish<Spec>(active_kernels().update(kConstants<Spec>, initial_register<Spec>(),
+                                                bytes.data(), bytes.size()));
+}
+
+template class Crc<kCrc24a>;
+template class Crc<kCrc24b>;
+template class Crc<kCrc24c>;
+template class Crc<kCrc16>;
+template class Crc<kCrc32>;
+
+}  // namespace dcomm
@@ -0,0 +1,208 @@
+#include "dcomm/equalizer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <type_traits>
+
+#include "dcomm/ofdm.hpp"
+#include "dcomm/sample.hpp"
+
+namespace dcomm {
+
+namespace {
+
+constexpr std::size_t kData = PhyConfig::data_subcarriers;
+constexpr std::size_t kPilots = PhyConfig::pilot_subcarriers;
+constexpr int kInterpBits = 14;
+constexpr int kWeightBits = 14;
+
+int subcarrier_of(std::uint16_t bin) {
+    return bin < PhyConfig::fft_size / 2 ? int(bin) : int(bin) - int(PhyConfig::fft_size);
+}
+
+/// Pilot pair and linear interpolation weights of every data subcarrier.
+struct InterpTable {
+    std::array<std::uint8_t, kData> a{};
+    std::array<float, kData> wa{};
+    std::array<float, kData> wb{};
+    std::array<std::int16_t, kData> qa{};  // Q14
+    std::array<std::int16_t, kData> qb{};
+
+    InterpTable() {
+        const OfdmLayout& layout = OfdmLayout::ieee80211();
+        int pilot[kPilots];
+        for (std::size_t j = 0; j < kPilots; ++j) {
+            pilot[j] = subcarrier_of(layout.pilot_bins[j]);
+        }
+        for (std::size_t k = 0; k < kData; ++k) {
+            const int sc = subcarrier_of(layout.data_bins[k]);
+            std::size_t j = 0;  // segment [pilot j, pilot j + 1], edges extrapolate
+            while (j + 2 < kPilots && sc > pilot[j + 1]) {
+                ++j;
+            }
+            const double t = double(sc - pilot[j]) / double(pilot[j + 1] - pilot[j]);
+            a[k] = std::uint8_t(j);
+            wa[k] = float(1.0 - t);
+            wb[k] = float(t);
+            qa[k] = std::int16_t(std::lround((1.0 - t) * (1 << kInterpBits)));
+            qb[k] = std::int16_t(std::lround(t * (1 << kInterpBits)));
+        }
+    }
+};
+
+const InterpTable& interp() {
+    static const InterpTable table;
+    return table;
+}
+
+/// Sign of pilot j in symbol s, base value times polarity.
+bool pilot_negative(std::size_t j, std::size_t symbol) noexcept {
+    return (OfdmLayout::pilot_values[j] < 0.0f) != (pilot_polarity(symbol) < 0.0f);
+}
+
+std::int16_t clamp16(std::int64_t v) noexcept {
+    return std::int16_t(std::clamp<std::int64_t>(v, -32768, 32767));
+}
+
+std::int64_t div_round(std::int64_t num, std::int64_t den) noexcept {
+    return (num + (num < 0 ? -den / 2 : den / 2)) / den;
+}
+
+}  // namespace
+
+template <class W>
+void PilotEqualizer<W>::estimate(const W* bins, std::size_t count, std::size_t stride,
+                                 std::size_t first_symbol) noexcept {
+    const OfdmLayout& layout = OfdmLayout::ieee80211();
+    const InterpTable& t = interp();
+    if constexpr (std::is_same_v<W, cf32>) {
+        cf32 hp[kPilots] = {};
+        for (std::size_t s = 0; s < count; ++s) {
+            const cf32* b = bins + s * stride;
+            for (std::size_t j = 0; j < kPilots; ++j) {
+                const cf32 y = b[layout.pilot_bins[j]];
+                hp[j] += pilot_negative(j, first_symbol + s) ? -y : y;
+            }
+        }
+        const float inv = count > 0 ? 1.0f / float(count) : 0.0f;
+        for (cf32& h : hp) {
+            h *= inv;
+        }
+        for (std::size_t k = 0; k < kData; ++k) {
+            const cf32 h = hp[t.a[k]] * t.wa[k] + hp[t.a[k] + 1] * t.wb[k];
+            const float power = std::norm(h);
+            h_[k] = h;
+            w_[k] = power > 0.0f ? std::conj(h) / power : cf32{};
+        }
+    } else {
+        std::int32_t acc[kPilots][2] = {};
+        for (std::size_t s = 0; s < count; ++s) {
+            const ci16* b = bins + s * stride;
+            for (std::size_t j = 0; j < kPilots; ++j) {
+                const ci16 y = b[layout.pilot_bins[j]];
+                const std::int32_t sign = pilot_negative(j, first_symbol + s) ? -1 : 1;
+                acc[j][0] += sign * y.re;
+                acc[j][1] += sign * y.im;
+            }
+        }
+        ci16 hp[kPilots] = {};
+        if (count > 0) {
+            for (std::size_t j = 0; j < kPilots; ++j) {
+                hp[j] = {clamp16(div_round(acc[j][0], std::int64_t(count))),
+                         clamp16(div_round(acc[j][1], std::int64_t(count)))};
+            }
+        }
+
+        // Interpolate, then pick the largest block exponent that keeps every
+        // weight component within 2^kWeightBits:
+        //   unit * max(|h.re|, |h.im|) * 2^s <= 2^kWeightBits * |h|^2.
+        constexpr std::int64_t unit = std::int64_t(SampleTraits<ci16>::unit);
+        std::int64_t power[kData];
+        unsigned shift = 30;
+        bool any = false;
+        for (std::size_t k = 0; k < kData; ++k) {
+            const ci16 a = hp[t.a[k]];
+            const ci16 b = hp[t.a[k] + 1];
+            constexpr std::int32_t half = 1 << (kInterpBits - 1);
+            const ci16 h = {
+                clamp16((std::int32_t(t.qa[k]) * a.re + std::int32_t(t.qb[k]) * b.re + half) >>
+                        kInterpBits),
+                clamp16((std::int32_t(t.qa[k]) * a.im + std::int32_t(t.qb[k]) * b.im + half) >>
+                        kInterpBits)};
+            h_[k] = h;
+            power[k] = std::int64_t(h.re) * h.re + std::int64_t(h.im) * h.im;
+            if (power[k] == 0) {
+                continue;
+            }
+            const std::int64_t peak =
+                std::max(std::abs(std::int64_t(h.re)), std::abs(std::int64_t(h.im)));
+            const std::uint64_t q = std::uint64_t((power[k] << kWeightBits) / (unit * peak));
+            shift = std::min(shift, q == 0 ? 0u : unsigned(std::bit_width(q)) - 1);
+            any = true;
+        }
+        shift_ = any ? shift : 0;
+        for (std::size_t k = 0; k < kData; ++k) {
+            if (power[k] == 0) {
+                w_[k] = {0, 0};
+                continue;
+            }
+            const std::int64_t re = (std::int64_t(h_[k].re) * unit) << shift_;
+            const std::int64_t im = (-std::int64_t(h_[k].im) * unit) << shift_;
+            w_[k] = {clamp16(div_round(re, power[k])), clamp16(div_round(im, power[k]))};
+        }
+    }
+}
+
+template <class W>
+void PilotEqualizer<W>::apply(const W* bins, W* out, std::uint64_t& saturated) const noexcept {
+    const OfdmLayout& layout = OfdmLayout::ieee80211();
+    // Components are accessed through plain arrays: going through the
+    // complex types makes GCC assemble each value on the stack and stall
+    // on store forwarding, and std::complex multiplication carries the
+    // Annex G inf/nan fix-up call.
+    if constexpr (std::is_same_v<W, cf32>) {
+        (void)saturated;
+        const float* y = reinterpret_cast<const float*>(bins);
+        const float* w = reinterpret_cast<const float*>(w_.data());
+        float* o = reinterpret_cast<float*>(out);
+        for (std::size_t k = 0; k < kData; ++k) {
+            const std::size_t b = 2 * std::size_t(layout.data_bins[k]);
+            const float yr = y[b], yi = y[b + 1];
+            const float wr = w[2 * k], wi = w[2 * k + 1];
+            o[2 * k] = yr * wr - yi * wi;
+            o[2 * k + 1] = yr * wi + yi * wr;
+        }
+    } else {
+        const std::int16_t* y = reinterpret_cast<const std::int16_t*>(bins);
+        const std::int16_t* w = reinterpret_cast<const std::int16_t*>(w_.data());
+        std::int16_t* o = reinterpret_cast<std::int16_t*>(out);
+        const std::int32_t round = shift_ > 0 ? std::int32_t(1) << (shift_ - 1) : 0;
+        // Gather the data subcarriers first so the arithmetic vectorises.
+        std::int16_t g[2 * kData];
+        for (std::size_t k = 0; k < kData; ++k) {
+            const std::size_t b = 2 * std::size_t(layout.data_bins[k]);
+            g[2 * k] = y[b];
+            g[2 * k + 1] = y[b + 1];
+        }
+        std::uint32_t clipped = 0;
+        for (std::size_t k = 0; k < kData; ++k) {
+            const std::int32_t yr = g[2 * k], yi = g[2 * k + 1];
+            const std::int32_t wr = w[2 * k], wi = w[2 * k + 1];
+            const std::int32_t re = (yr * wr - yi * wi + round) >> shift_;
+            const std::int32_t im = (yr * wi + yi * wr + round) >> shift_;
+            const std::int32_t cr = std::clamp(re, -32768, 32767);
+            const std::int32_t cm = std::clamp(im, -32768, 32767);
+            clipped += std::uint32_t(cr != re) + std::uint32_t(cm != im);
+            o[2 * k] = std::int16_t(cr);
+            o[2 * k + 1] = std::int16_t(cm);
+        }
+        saturated += clipped;
+    }
+}
+
+template class PilotEqualizer<cf32>;
+template class PilotEqualizer<ci16>;
+
+}  // namespace dcomm
@@ -0,0 +1,71 @@
+#include "dcomm/executor.hpp"
+
+#include <algorithm>
+
+namespace dcomm {
+
+namespace {
+
+thread_local const Executor* tl_executor = nullptr;
+thread_local std::size_t tl_worker = 0;
+
+}  // namespace
+
+Executor::Executor(std::size_t workers) {
+    if (workers == 0) {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        threads_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+Executor::~Executor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    ready_.notify_all();
+    for (std::thread& t : threads_) {
+        t.join();
+    }
+    for (auto& queue : queues_) {
+        for (std::coroutine_handle<> h : queue) {
+            h.destroy();
+        }
+    }
+}
+
+void Executor::post(std::coroutine_handle<> h, Priority p) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queues_[std::size_t(p)].push_back(h);
+    }
+    ready_.notify_one();
+}
+
+std::size_t Executor::current_worker() const noexcept {
+    return tl_executor == this ? tl_worker : threads_.size();
+}
+
+void Executor::worker_loop(std::size_t id) {
+    tl_executor = this;
+    tl_worker = id;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        auto queue = std::find_if(queues_.begin(), queues_.end(),
+                                  [](const auto& q) { return !q.empty(); });
+        if (queue == queues_.end()) {
+            ready_.wait(lock);
+            continue;
+        }
+        const std::coroutine_handle<> h = queue->front();
+        queue->pop_front();
+        lock.unlock();
+        h.resume();
+        lock.lock();
+    }
+}
+
+}  // namespace dcomm
@@ -0,0 +1,80 @@
+#include "dcomm/fast_math.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#include "kernels/math_kernels.hpp"
+#include "kernels/math_ref.hpp"
+
+namespace dcomm {
+
+namespace {
+
+const kernels::MathKernels& math_kernels_for(Isa isa) noexcept {
+    assert(isa_available(isa));
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx2: return kernels::math_avx2;
+    case Isa::avx512: return kernels::math_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+    case Isa::neon: return kernels::math_neon;
+#endif
+    default: return kernels::math_scalar;
+    }
+}
+
+const kernels::MathKernels& active_kernels() noexcept {
+    static const kernels::MathKernels& k = math_kernels_for(active_isa());
+    return k;
+}
+
+void nco_mix_with(const kernels::MathKernels& k, std::span<const cf32> in, std::uint32_t phase,
+                  std::uint32_t step, std::span<cf32> out) noexcept {
+    assert(in.size() == out.size());
+    k.nco_mix(reinterpret_cast<const float*>(in.data()), in.size(), phase, step,
+              reinterpret_cast<float*>(out.data()));
+}
+
+void angle_with(const kernels::MathKernels& k, std::span<const cf32> in,
+                std::span<float> out) noexcept {
+    assert(in.size() == out.size());
+    k.angle(reinterpret_cast<const float*>(in.data()), in.size(), out.data());
+}
+
+}  // namespace
+
+std::uint32_t nco_phase(double cycles) noexcept {
+    const double turn = cycles - std::floor(cycles);  // [0, 1]
+    return std::uint32_t(std::uint64_t(std::llround(std::ldexp(turn, 32))));
+}
+
+void nco_sincos(std::uint32_t phase, float& c, float& s) noexcept {
+    kernels::ref_sincos(kernels::math_tables(), phase, c, s);
+}
+
+void nco_mix(std::span<const cf32> in, std::uint32_t phase, std::uint32_t step,
+             std::span<cf32> out) noexcept {
+    nco_mix_with(active_kernels(), in, phase, step, out);
+}
+
+void nco_mix(Isa isa, std::span<const cf32> in, std::uint32_t phase, std::uint32_t step,
+             std::span<cf32> out) noexcept {
+    nco_mix_with(math_kernels_for(isa), in, phase, step, out);
+}
+
+float fast_atan2(float y, float x) noexcept { return kernels::ref_atan2(y, x); }
+
+void fast_angle(std::span<const cf32> in, std::span<float> out) noexcept {
+    angle_with(active_kernels(), in, out);
+}
+
+void fast_angle(Isa isa, std::span<const cf32> in, std::span<float> out) noexcept {
+    angle_with(math_kernels_for(isa), in, out);
+}
+
+float jacobian_log(float d) noexcept {
+    return kernels::ref_jacobian_log(kernels::math_tables(), d);
+}
+
+}  // namespace dcomm
@@ -0,0 +1,224 @@
+#include "dcomm/fft.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <numeric>
+#include <stdexcept>
+
+#include "kernels/fft_kernels.hpp"
+
+namespace dcomm {
+
+namespace {
+
+const kernels::FftKernels& fft_kernels_for(Isa isa) {
+    if (!isa_available(isa)) {
+        throw std::invalid_argument("FftPlan: ISA not available on this CPU");
+    }
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx2: return kernels::fft_avx2;
+    case Isa::avx512: return kernels::fft_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+    case Isa::neon: return kernels::fft_neon;
+#endif
+    default: return kernels::fft_scalar;
+    }
+}
+
+std::int16_t to_q15(double v) {
+    const double scaled = std::round(v * 32768.0);
+    return std::int16_t(std::clamp(scaled, -32767.0, 32767.0));
+}
+
+}  // namespace
+
+FftPlan::FftPlan(std::size_t n, Isa isa)
+    : n_(n), isa_(isa), kernels_(&fft_kernels_for(isa)) {
+    if (n < 2 || n > kMaxSize || !std::has_single_bit(n)) {
+        throw std::invalid_argument("FftPlan: size must be a power of two in [2, 65536]");
+    }
+
+    // Pass list, largest span first: one radix-2 pass for odd log2(N).
+    std::size_t twiddle_count = 0;
+    std::size_t span = n;
+    if (std::countr_zero(n) % 2 != 0) {
+        passes_.push_back({2, std::uint32_t(span), twiddle_count});
+        twiddle_count += span / 2;
+        span /= 2;
+    }
+    for (; span >= 4; span /= 4) {
+        passes_.push_back({4, std::uint32_t(span), twiddle_count});
+        twiddle_count += 3 * (span / 4);
+    }
+    first_blocked_pass_ = passes_.size();
+    for (std::size_t i = 0; i < passes_.size(); ++i) {
+        if (passes_[i].span <= kBlockPoints) {
+            first_blocked_pass_ = i;
+            break;
+        }
+    }
+
+    for (int dir = 0; dir < 2; ++dir) {
+        twiddles_[dir] = make_aligned_array<float>(2 * twiddle_count);
+        twiddles_q15_[dir] = make_aligned_array<std::int16_t>(2 * twiddle_count);
+    }
+    for (const Pass& p : passes_) {
+        const std::size_t count = p.radix == 2 ? p.span / 2 : p.span / 4;
+        const unsigned powers = p.radix == 2 ? 1 : 3;
+        for (unsigned m = 1; m <= powers; ++m) {
+            for (std::size_t k = 0; k < count; ++k) {
+                const double phi =
+                    -2.0 * std::numbers::pi * double(m * k) / double(p.span);
+                const std::size_t idx = 2 * (p.twiddle_offset + (m - 1) * count + k);
+                const double c = std::cos(phi);
+                const double s = std::sin(phi);
+                twiddles_[0][idx] = float(c);
+                twiddles_[0][idx + 1] = float(s);
+                twiddles_[1][idx] = float(c);
+                twiddles_[1][idx + 1] = float(-s);
+                twiddles_q15_[0][idx] = to_q15(c);
+                twiddles_q15_[0][idx + 1] = to_q15(s);
+                twiddles_q15_[1][idx] = to_q15(c);
+                twiddles_q15_[1][idx + 1] = to_q15(-s);
+            }
+        }
+    }
+
+    // DIF leaves frequency f at the mixed-radix digit reversal of f.
+    std::vector<std::uint32_t> position(n, 0);
+    for (std::size_t f = 0; f < n; ++f) {
+        std::size_t rest = f;
+        std::size_t weight = n;
+        std::size_t p = 0;
+        for (const Pass& pass : passes_) {
+            weight /= pass.radix;
+            p += (rest % pass.radix) * weight;
+            rest /= pass.radix;
+        }
+        position[f] = std::uint32_t(p);
+    }
+    // Turn "out[f] = in[position[f]]" into a sequence of in-place swaps.
+    std::vector<std::uint32_t> where(n);  // current slot of original element
+    std::vector<std::uint32_t> what(n);   // original element held by slot
+    std::iota(where.begin(), where.end(), 0u);
+    std::iota(what.begin(), what.end(), 0u);
+    for (std::uint32_t f = 0; f < n; ++f) {
+        const std::uint32_t e = position[f];
+        const std::uint32_t src = where[e];
+        if (src == f) {
+            continue;
+        }
+        swaps_.emplace_back(f, src);
+        const std::uint32_t displaced = what[f];
+        what[f] = e;
+        what[src] = displaced;
+        where[e] = f;
+        where[displaced] = src;
+    }
+}
+
+FftPlan::~FftPlan() = default;
+FftPlan::FftPlan(FftPlan&&) noexcept = default;
+FftPlan& FftPlan::operator=(FftPlan&&) noexcept = default;
+
+const FftPlan& FftPlan::get(std::size_t n) {
+    static std::mutex mutex;
+    static std::map<std::size_t, std::unique_ptr<FftPlan>> plans;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<FftPlan>& plan = plans[n];
+    if (!plan) {
+        plan = std::make_unique<FftPlan>(n);
+    }
+    return *plan;
+}
+
+template <class T>
+void FftPlan::permute(T* x) const noexcept {
+    for (const auto& [a, b] : swaps_) {
+        std::swap(x[a], x[b]);
+    }
+}
+
+void FftPlan::transform(cf32* data, bool inverse) const noexcept {
+    float* x = reinterpret_cast<float*>(data);
+    const float* tw = twiddles_[inverse].get();
+    auto run = [&](const Pass& p, float* base, std::size_t points) {
+        const float* t = tw + 2 * p.twiddle_offset;
+        if (p.radix == 2) {
+            kernels_->radix2(base, p.span, points / p.span, t);
+        } else {
+            kernels_->radix4(base, p.span, points / p.span, t, inverse);
+        }
+    };
+    for (std::size_t i = 0; i < first_blocked_pass_; ++i) {
+        run(passes_[i], x, n_);
+    }
+    if (first_blocked_pass_ < passes_.size()) {
+        const std::size_t block = passes_[first_blocked_pass_].span;
+        for (std::size_t base = 0; base < n_; base += block) {
+            for (std::size_t i = first_blocked_pass_; i < passes_.size(); ++i) {
+                run(passes_[i], x + 2 * base, block);
+            }
+        }
+    }
+    permute(data);
+}
+
+void FftPlan::transform(ci16* data, bool inverse) const noexcept {
+    std::int16_t* x = reinterpret_cast<std::int16_t*>(data);
+    const std::int16_t* tw = twiddles_q15_[inverse].get();
+    auto run = [&](const Pass& p, std::int16_t* base, std::size_t points) {
+        const std::int16_t* t = tw + 2 * p.twiddle_offset;
+        if (p.radix == 2) {
+            kernels_->radix2_q15(base, p.span, points / p.span, t);
+        } else {
+            kernels_->radix4_q15(base, p.span, points / p.span, t, inverse);
+        }
+    };
+    for (std::size_t i = 0; i < first_blocked_pass_; ++i) {
+        run(passes_[i], x, n_);
+    }
+    if (first_blocked_pass_ < passes_.size()) {
+        const std::size_t block = passes_[first_blocked_pass_].span;
+        for (std::size_t base = 0; base < n_; base += block) {
+            for (std::size_t i = first_blocked_pass_; i < passes_.size(); ++i) {
+                run(passes_[i], x + 2 * base, block);
+            }
+        }
+    }
+    permute(data);
+}
+
+void FftPlan::forward_batch(cf32* x, std::size_t count, std::size_t stride) const noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        transform(x + i * stride, false);
+    }
+}
+
+void FftPlan::inverse_batch(cf32* x, std::size_t count, std::size_t stride) const noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        transform(x + i * stride, true);
+    }
+}
+
+void FftPlan::forward_batch(ci16* x, std::size_t count, std::size_t stride) const noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        transform(x + i * stride, false);
+    }
+}
+
+void FftPlan::inverse_batch(ci16* x, std::size_t count, std::size_t stride) const noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        transform(x + i * stride, true);
+    }
+}
+
+}  // namespace dcomm
@@ -0,0 +1,200 @@
+#include "dcomm/frame.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <stdexcept>
+
+#include "dcomm/fft.hpp"
+#include "dcomm/modulation.hpp"
+#include "dcomm/phy_tables.hpp"
+
+namespace dcomm {
+
+namespace {
+
+using namespace tables;
+
+constexpr std::size_t kSignalInfoBits = 18;  // ahead of the 6 tail bits
+constexpr std::size_t kSignalCodedBits = conv_coded_bits(kSignalInfoBits);
+static_assert(kSignalCodedBits == kDataSubcarriers, "SIGNAL fills one BPSK symbol");
+
+struct Rate {
+    Modulation modulation;
+    CodeRate code_rate;
+    std::uint8_t bits;  // R1..R4 in bits 0..3
+};
+
+constexpr std::uint8_t rate_bits(const char (&r)[5]) noexcept {
+    std::uint8_t v = 0;
+    for (int i = 0; i < 4; ++i) {
+        v |= std::uint8_t((r[i] - '0') << i);
+    }
+    return v;
+}
+
+/// 17.3.4.2, Table 17-6.
+constexpr Rate kRates[] = {
+    {Modulation::bpsk, CodeRate::r1_2, rate_bits("1101")},
+    {Modulation::bpsk, CodeRate::r3_4, rate_bits("1111")},
+    {Modulation::qpsk, CodeRate::r1_2, rate_bits("0101")},
+    {Modulation::qpsk, CodeRate::r3_4, rate_bits("0111")},
+    {Modulation::qam16, CodeRate::r1_2, rate_bits("1001")},
+    {Modulation::qam16, CodeRate::r3_4, rate_bits("1011")},
+    {Modulation::qam64, CodeRate::r2_3, rate_bits("0001")},
+    {Modulation::qam64, CodeRate::r3_4, rate_bits("0011")},
+};
+
+const Rate* find_rate(Modulation m, CodeRate r) noexcept {
+    for (const Rate& rate : kRates) {
+        if (rate.modulation == m && rate.code_rate == r) {
+            return &rate;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+bool is_ieee80211a_rate(Modulation m, CodeRate r) noexcept { return find_rate(m, r) != nullptr; }
+
+std::uint32_t pack_signal(const SignalField& signal) {
+    const Rate* rate = find_rate(signal.modulation, signal.code_rate);
+    if (rate == nullptr) {
+        throw std::invalid_argument("pack_signal: not an 802.11a rate");
+    }
+    if (signal.length == 0 || signal.length > kMaxFrameBytes) {
+        throw std::invalid_argument("pack_signal: length must be 1..4095");
+    }
+    const std::uint32_t bits = std::uint32_t(rate->bits) | std::uint32_t(signal.length) << 5;
+    return bits | std::uint32_t(std::popcount(bits) & 1) << 17;
+}
+
+std::optional<SignalField> parse_signal(std::uint32_t bits) noexcept {
+    if ((bits & 0x10u) != 0 || (std::popcount(bits & 0x3ffffu) & 1) != 0) {
+        return std::nullopt;
+    }
+    const std::uint16_t length = std::uint16_t((bits >> 5) & 0xfffu);
+    if (length == 0) {
+        return std::nullopt;
+    }
+    for (const Rate& rate : kRates) {
+        if (rate.bits == (bits & 0xfu)) {
+            return SignalField{rate.modulation, rate.code_rate, length};
+        }
+    }
+    return std::nullopt;
+}
+
+FrameCodec::FrameCodec(const PhyConfig& base)
+    : base_(base),
+      // N_DBPS <= 8 * 48, so the padding never takes a frame past this.
+      padded_(8 * kMaxFrameBytes + 8 * kDataSubcarriers) {
+    base_.validate();
+}
+
+FramePhy& FrameCodec::phy(Modulation m, CodeRate r) {
+    std::unique_ptr<FramePhy>& p = phys_[std::size_t(m) * 3 + std::size_t(r)];
+    if (p == nullptr) {
+        PhyConfig c = base_;
+        c.modulation = m;
+        c.code_rate = r;
+        c.symbols_per_block = payload_symbols({m, r, std::uint16_t(kMaxFrameBytes)});
+        p = make_frame_phy(c);
+        p->set_pilot_offset(1);
+    }
+    return *p;
+}
+
+std::size_t FrameCodec::encode(const SignalField& signal, ConstBitSpan payload,
+                               std::span<cf32> samples) {
+    const std::uint32_t word = pack_signal(signal);
+    const std::size_t n_sym = payload_symbols(signal);
+    const std::size_t total = kSignalSamples * (1 + n_sym);
+    if (payload.size() < 8 * std::size_t(signal.length) || samples.size() < total) {
+        throw std::invalid_argument("FrameCodec::encode: buffers too short");
+    }
+
+    // SIGNAL: unscrambled, BPSK rate 1/2, interleaved, pilots p_0.
+    std::array<std::uint8_t, kSignalInfoBits> info;
+    for (std::size_t i = 0; i < kSignalInfoBits; ++i) {
+        info[i] = std::uint8_t((word >> i) & 1u);
+    }
+    std::array<std::uint8_t, kSignalCodedBits> coded, interleaved;
+    conv_encode(info, coded);
+    for (std::size_t j = 0; j < kSignalCodedBits; ++j) {
+        interleaved[j] = coded[kInterleaverSource<kSignalCodedBits, 1>[j]];
+    }
+    std::array<cf32, kDataSubcarriers> symbols;
+    map_bits(Modulation::bpsk, interleaved, symbols);
+    cf32* body = samples.data() + kCpLength;
+    std::fill(body, body + kFftSize, cf32{});
+    for (std::size_t k = 0; k < kDataSubcarriers; ++k) {
+        body[kDataBins[k]] = symbols[k] * kTxScale;
+    }
+    for (std::size_t k = 0; k < kPilotSubcarriers; ++k) {
+        body[kPilotBins[k]] = cf32(kPilotValues[k] * kPilotPolarity[0] * kTxScale, 0.0f);
+    }
+    FftPlan::get(kFftSize).inverse_batch(body, 1, kSymbolLength);
+    std::copy(body + kFftSize - kCpLength, body + kFftSize, samples.data());
+
+    // Payload bits, zero padded to fill the last symbol.
+    FramePhy& p = phy(signal.modulation, signal.code_rate);
+    const std::size_t n_bits = 8 * std::size_t(signal.length);
+    const BitSpan padded = padded_.view().subspan(0, p.info_bits(n_sym));
+    std::fill(padded.words, padded.words + padded.word_count(), 0);
+    std::copy(payload.words, payload.words + n_bits / 64, padded.words);
+    if (n_bits % 64 != 0) {
+        padded.words[n_bits / 64] = payload.words[n_bits / 64] & tail_mask(n_bits);
+    }
+    p.encode(padded, samples.subspan(kSignalSamples), n_sym);
+    return total;
+}
+
+std::optional<SignalField> FrameCodec::decode_signal(std::span<const cf32> symbol) {
+    assert(symbol.size() >= kSignalSamples);
+    std::array<cf32, kFftSize> bins;
+    std::copy(symbol.data() + kCpLength, symbol.data() + kSymbolLength, bins.begin());
+    FftPlan::get(kFftSize).forward_batch(bins.data(), 1, kFftSize);
+
+    std::array<cf32, kDataSubcarriers> symbols;
+    if (base_.equalizer == Equalizer::pilot_zf) {
+        std::uint64_t saturated = 0;
+        signal_equalizer_.estimate(bins.data(), 1, kFftSize, 0);
+        signal_equalizer_.apply(bins.data(), symbols.data(), saturated);
+    } else {
+        for (std::size_t k = 0; k < kDataSubcarriers; ++k) {
+            symbols[k] = bins[kDataBins[k]] * kRxScale;
+        }
+    }
+    std::array<float, kSignalCodedBits> llrs, deinterleaved;
+    demap_maxlog(Modulation::bpsk, symbols, base_.noise_variance, llrs);
+    for (std::size_t i = 0; i < kSignalCodedBits; ++i) {
+        deinterleaved[i] = llrs[kInterleaverTarget<kSignalCodedBits, 1>[i]];
+    }
+    std::array<std::uint8_t, kSignalInfoBits> info;
+    signal_decoder_.decode(deinterleaved, info, CodeRate::r1_2);
+    std::uint32_t word = 0;
+    for (std::size_t i = 0; i < kSignalInfoBits; ++i) {
+        word |= std::uint32_t(info[i]) << i;
+    }
+    return parse_signal(word);
+}
+
+void FrameCodec::decode_payload(const SignalField& signal, std::span<const cf32> samples,
+                                BitSpan payload) {
+    const std::size_t n_sym = payload_symbols(signal);
+    const std::size_t n_bits = 8 * std::size_t(signal.length);
+    assert(samples.size() >= n_sym * kSymbolLength && payload.size() >= n_bits);
+    FramePhy& p = phy(signal.modulation, signal.code_rate);
+    const BitSpan padded = padded_.view().subspan(0, p.info_bits(n_sym));
+    p.decode(samples, padded, n_sym);
+    std::copy(padded.words, padded.words + n_bits / 64, payload.words);
+    if (n_bits % 64 != 0) {
+        const std::uint64_t m = tail_mask(n_bits);
+        std::uint64_t& w = payload.words[n_bits / 64];
+        w = (w & ~m) | (padded.words[n_bits / 64] & m);
+    }
+}
+
+}  // namespace dcomm
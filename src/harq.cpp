@@ -0,0 +1,330 @@
+#include "dcomm/harq.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "kernels/harq_kernels.hpp"
+
+namespace dcomm {
+
+namespace {
+
+constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+/// int4 steps are 8 int8 units.
+constexpr float kS4Step = 8.0f;
+
+const kernels::HarqKernels& harq_kernels_for(Isa isa) {
+    if (!isa_available(isa)) {
+        throw std::invalid_argument("HarqSoftBuffers: ISA not available on this CPU");
+    }
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx2: return kernels::harq_avx2;
+    case Isa::avx512: return kernels::harq_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+    case Isa::neon: return kernels::harq_neon;
+#endif
+    default: return kernels::harq_scalar;
+    }
+}
+
+const HarqConfig& validated(const HarqConfig& config) {
+    if (config.page_bytes == 0 || config.page_bytes % kCacheLine != 0 ||
+        config.budget_bytes < config.page_bytes ||
+        config.budget_bytes / config.page_bytes >= kNone) {
+        throw std::invalid_argument("HarqSoftBuffers: bad page size or budget");
+    }
+    if (config.users == 0 || config.processes == 0 ||
+        config.users * config.processes >= kNone || !(config.llr_scale > 0.0f)) {
+        throw std::invalid_argument("HarqSoftBuffers: bad configuration");
+    }
+    return config;
+}
+
+}  // namespace
+
+HarqSoftBuffers::HarqSoftBuffers(const HarqConfig& config, Isa isa)
+    : config_(validated(config)),
+      kernels_(&harq_kernels_for(isa)),
+      arena_(make_aligned_array<std::uint8_t>(config.budget_bytes / config.page_bytes *
+                                              config.page_bytes)),
+      next_(config.budget_bytes / config.page_bytes),
+      free_(0),
+      free_count_(next_.size()),
+      entries_(config.users * config.processes,
+               Entry{kNone, 0, 0, config.format, kNone, kNone}),
+      newest_(kNone),
+      oldest_(kNone) {
+    for (std::size_t p = 0; p < next_.size(); ++p) {
+        next_[p] = p + 1 < next_.size() ? std::uint32_t(p + 1) : kNone;
+    }
+}
+
+bool HarqSoftBuffers::combine(std::size_t user, std::size_t process, std::size_t length,
+                              std::size_t offset, std::span<const float> llrs, bool new_data) {
+    assert(offset < length && llrs.size() <= length);
+    const auto id = std::uint32_t(index(user, process));
+    const bool combined =
+        !new_data && entries_[id].first != kNone && entries_[id].length == length;
+    if (combined) {
+        ++stats_.combines;
+        unlink(id);
+        link_newest(id);
+    } else {
+        ++(new_data ? stats_.fresh : stats_.lost);
+        drop(id);
+        allocate(id, length);
+    }
+
+    const Entry& e = entries_[id];
+    const std::size_t head = std::min(llrs.size(), length - offset);
+    if (e.format == SoftFormat::int8) {
+        add_s8(e, offset, llrs.data(), head);
+        add_s8(e, 0, llrs.data() + head, llrs.size() - head);
+    } else {
+        add_s4(e, offset, llrs.data(), head);
+        add_s4(e, 0, llrs.data() + head, llrs.size() - head);
+    }
+    return combined;
+}
+
+bool HarqSoftBuffers::read(std::size_t user, std::size_t process,
+                           std::span<std::int8_t> out) const {
+    const Entry& e = entries_[index(user, process)];
+    if (e.first == kNone) {
+        return false;
+    }
+    assert(out.size() == e.length);
+    const std::size_t bytes = config_.page_bytes;
+    std::uint32_t p = e.first;
+    if (e.format == SoftFormat::int8) {
+        for (std::size_t pos = 0; pos < e.length; pos += bytes, p = next_[p]) {
+            std::memcpy(out.data() + pos, page(p), std::min(bytes, e.length - pos));
+        }
+        return true;
+    }
+    for (std::size_t pos = 0; pos < e.length; pos += 2 * bytes, p = next_[p]) {
+        const std::size_t n = std::min(2 * bytes, e.length - pos);
+        kernels_->expand_s4(page(p), n / 2, out.data() + pos);
+        if (n % 2 != 0) {
+            std::int8_t pair[2];
+            kernels_->expand_s4(page(p) + n / 2, 1, pair);
+            out[pos + n - 1] = pair[0];
+        }
+    }
+    return true;
+}
+
+void HarqSoftBuffers::release(std::size_t user, std::size_t process) noexcept {
+    drop(std::uint32_t(index(user, process)));
+}
+
+bool HarqSoftBuffers::holds(std::size_t user, std::size_t process) const noexcept {
+    return entries_[index(user, process)].first != kNone;
+}
+
+std::size_t HarqSoftBuffers::length(std::size_t user, std::size_t process) const noexcept {
+    const Entry& e = entries_[index(user, process)];
+    return e.first != kNone ? e.length : 0;
+}
+
+SoftFormat HarqSoftBuffers::format(std::size_t user, std::size_t process) const noexcept {
+    return entries_[index(user, process)].format;
+}
+
+std::size_t HarqSoftBuffers::index(std::size_t user, std::size_t process) const noexcept {
+    assert(user < config_.users && process < config_.processes);
+    return user * config_.processes + process;
+}
+
+std::size_t HarqSoftBuffers::pages_for(std::size_t length, SoftFormat format) const noexcept {
+    const std::size_t bytes = format == SoftFormat::int8 ? length : (length + 1) / 2;
+    return std::max<std::size_t>((bytes + config_.page_bytes - 1) / config_.page_bytes, 1);
+}
+
+std::uint8_t* HarqSoftBuffers::page(std::uint32_t p) const noexcept {
+    return arena_.get() + std::size_t(p) * config_.page_bytes;
+}
+
+std::uint32_t HarqSoftBuffers::page_at(const Entry& e, std::size_t k) const noexcept {
+    std::uint32_t p = e.first;
+    for (; k > 0; --k) {
+        p = next_[p];
+    }
+    return p;
+}
+
+void HarqSoftBuffers::allocate(std::uint32_t id, std::size_t length) {
+    SoftFormat format = config_.format;
+    std::size_t needed = pages_for(length, format);
+    if (needed > pages() || length >= kNone) {
+        throw std::invalid_argument("HarqSoftBuffers: buffer larger than the budget");
+    }
+    while (free_count_ < needed) {
+        if (config_.compress_under_pressure) {
+            // Oldest int8 buffer that int4 would shrink, else this one as
+            // int4 if that fits, else evict.
+            std::uint32_t victim = kNone;
+            for (std::uint32_t v = oldest_; v != kNone; v = entries_[v].newer) {
+                const Entry& e = entries_[v];
+                if (e.format == SoftFormat::int8 &&
+                    pages_for(e.length, SoftFormat::int4) < e.pages) {
+                    victim = v;
+                    break;
+                }
+            }
+            if (victim != kNone) {
+                narrow(victim);
+                ++stats_.compressions;
+                continue;
+            }
+            if (format == SoftFormat::int8) {
+                format = SoftFormat::int4;
+                needed = pages_for(length, format);
+                ++stats_.compressions;
+                continue;
+            }
+        }
+        drop(oldest_);
+        ++stats_.evictions;
+    }
+
+    Entry& e = entries_[id];
+    e.first = free_;
+    e.pages = std::uint32_t(needed);
+    e.length = std::uint32_t(length);
+    e.format = format;
+    std::uint32_t p = free_;
+    for (std::size_t k = 0; k < needed; ++k) {
+        std::memset(page(p), 0, config_.page_bytes);
+        if (k + 1 < needed) {
+            p = next_[p];
+        }
+    }
+    free_ = next_[p];
+    next_[p] = kNone;
+    free_count_ -= needed;
+    link_newest(id);
+}
+
+void HarqSoftBuffers::drop(std::uint32_t id) noexcept {
+    Entry& e = entries_[id];
+    if (e.first == kNone) {
+        return;
+    }
+    unlink(id);
+    free_chain(e.first);
+    free_count_ += e.pages;
+    e.first = kNone;
+    e.pages = 0;
+    e.length = 0;
+}
+
+void HarqSoftBuffers::narrow(std::uint32_t id) noexcept {
+    // Input page q lands in half q % 2 of output page q / 2; every output
+    // page is read before it is written, and page 0 only in place.
+    Entry& e = entries_[id];
+    const std::size_t bytes = config_.page_bytes;
+    std::uint32_t in = e.first;
+    std::uint32_t out = e.first;
+    for (std::size_t q = 0, pos = 0; pos < e.length; ++q, pos += bytes, in = next_[in]) {
+        const std::size_t n = std::min(bytes, e.length - pos);
+        std::uint8_t* dst = page(out) + (q % 2) * (bytes / 2);
+        const auto* src = reinterpret_cast<const std::int8_t*>(page(in));
+        kernels_->compress_s4(src, n / 2, dst);
+        if (n % 2 != 0) {
+            const std::int8_t pair[2] = {src[n - 1], 0};
+            kernels_->compress_s4(pair, 1, dst + n / 2);
+        }
+        if (q % 2 == 1) {
+            out = next_[out];
+        }
+    }
+    const std::size_t kept = pages_for(e.length, SoftFormat::int4);
+    const std::uint32_t last = page_at(e, kept - 1);
+    free_chain(next_[last]);
+    next_[last] = kNone;
+    free_count_ += e.pages - kept;
+    e.pages = std::uint32_t(kept);
+    e.format = SoftFormat::int4;
+}
+
+void HarqSoftBuffers::free_chain(std::uint32_t first) noexcept {
+    if (first == kNone) {
+        return;
+    }
+    std::uint32_t last = first;
+    while (next_[last] != kNone) {
+        last = next_[last];
+    }
+    next_[last] = free_;
+    free_ = first;
+}
+
+void HarqSoftBuffers::link_newest(std::uint32_t id) noexcept {
+    Entry& e = entries_[id];
+    e.older = newest_;
+    e.newer = kNone;
+    if (newest_ != kNone) {
+        entries_[newest_].newer = id;
+    } else {
+        oldest_ = id;
+    }
+    newest_ = id;
+}
+
+void HarqSoftBuffers::unlink(std::uint32_t id) noexcept {
+    Entry& e = entries_[id];
+    (e.older != kNone ? entries_[e.older].newer : oldest_) = e.newer;
+    (e.newer != kNone ? entries_[e.newer].older : newest_) = e.older;
+    e.older = e.newer = kNone;
+}
+
+void HarqSoftBuffers::add_s8(const Entry& e, std::size_t pos, const float* llrs,
+                             std::size_t n) noexcept {
+    const std::size_t bytes = config_.page_bytes;
+    std::uint32_t p = page_at(e, pos / bytes);
+    for (std::size_t off = pos % bytes; n > 0; off = 0, p = next_[p]) {
+        const std::size_t run = std::min(n, bytes - off);
+        kernels_->combine_s8(reinterpret_cast<std::int8_t*>(page(p) + off), llrs, run,
+                             config_.llr_scale);
+        llrs += run;
+        n -= run;
+    }
+}
+
+void HarqSoftBuffers::add_s4(const Entry& e, std::size_t pos, const float* llrs,
+                             std::size_t n) noexcept {
+    // Values 2j and 2j + 1 share a byte; a run starting or ending between
+    // them goes through the kernel as a pair with a zero LLR, which leaves
+    // the other nibble as it is.
+    const std::size_t values = 2 * config_.page_bytes;
+    const float scale = config_.llr_scale / kS4Step;
+    std::uint32_t p = page_at(e, pos / values);
+    for (std::size_t off = pos % values; n > 0; off = 0, p = next_[p]) {
+        const std::size_t run = std::min(n, values - off);
+        std::uint8_t* buf = page(p) + off / 2;
+        std::size_t k = 0;
+        if (off % 2 != 0) {
+            const float pair[2] = {0.0f, llrs[0]};
+            kernels_->combine_s4(buf++, pair, 1, scale);
+            k = 1;
+        }
+        const std::size_t pairs = (run - k) / 2;
+        kernels_->combine_s4(buf, llrs + k, pairs, scale);
+        k += 2 * pairs;
+        if (k < run) {
+            const float pair[2] = {llrs[k], 0.0f};
+            kernels_->combine_s4(buf + pairs, pair, 1, scale);
+        }
+        llrs += run;
+        n -= run;
+    }
+}
+
+}  // namespace dcomm
@@ -0,0 +1,163 @@
+#include "dcomm/incremental_rx.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "dcomm/modulation.hpp"
+#include "dcomm/phy_tables.hpp"
+
+namespace dcomm {
+
+namespace {
+
+using namespace tables;
+
+}  // namespace
+
+IncrementalReceiver::IncrementalReceiver(const PhyConfig& base, FrameFilter filter)
+    : base_(base),
+      filter_(std::move(filter)),
+      signal_codec_(base),
+      fft_(FftPlan::get(kFftSize)),
+      // N_DBPS <= 8 * 48 bounds the padding, as in FrameCodec.
+      info_(8 * kMaxFrameBytes + 8 * kDataSubcarriers),
+      header_(filter_.header_bytes),
+      payload_(8 * kMaxFrameBytes) {}
+
+void IncrementalReceiver::reset() noexcept {
+    state_ = State::signal;
+    signal_ = {};
+    symbol_ = 0;
+    released_ = 0;
+    skip_ = 0;
+    admitted_ = false;
+    filled_ = 0;
+}
+
+std::size_t IncrementalReceiver::push(std::span<const cf32> samples) {
+    std::size_t used = 0;
+    while (used < samples.size()) {
+        if (skip_ > 0) {
+            const std::size_t n = std::min(skip_, samples.size() - used);
+            skip_ -= n;
+            used += n;
+            continue;
+        }
+        if (state_ != State::signal && state_ != State::payload) {
+            break;
+        }
+        const std::size_t n = std::min(kSignalSamples - filled_, samples.size() - used);
+        std::copy_n(samples.data() + used, n, pending_.data() + filled_);
+        filled_ += n;
+        used += n;
+        if (filled_ == kSignalSamples) {
+            filled_ = 0;
+            if (state_ == State::signal) {
+                decode_signal();
+            } else {
+                decode_symbol();
+            }
+        }
+    }
+    return used;
+}
+
+void IncrementalReceiver::decode_signal() {
+    ++stats_.frames;
+    const std::optional<SignalField> signal = signal_codec_.decode_signal(pending_);
+    if (!signal) {
+        ++stats_.dropped_signal;
+        state_ = State::dropped;
+        return;
+    }
+    signal_ = *signal;
+    n_sym_ = payload_symbols(signal_);
+    n_cbps_ = kDataSubcarriers * bits_per_symbol(signal_.modulation);
+    n_info_ = n_sym_ * n_cbps_ * code_rate_numerator(signal_.code_rate) /
+                  code_rate_denominator(signal_.code_rate) -
+              PhyConfig::code_memory;
+    interleaver_ = base_.interleave
+                       ? &BlockInterleaver::ieee80211(n_cbps_, bits_per_symbol(signal_.modulation))
+                       : nullptr;
+    scrambler_.reset(base_.scrambler_seed);
+    state_ = State::payload;
+    if (!admit()) {
+        drop_payload();
+    }
+}
+
+void IncrementalReceiver::decode_symbol() {
+    std::copy(pending_.begin() + kCpLength, pending_.end(), bins_.begin());
+    fft_.forward_batch(bins_.data(), 1, kFftSize);
+    if (base_.equalizer == Equalizer::pilot_zf) {
+        std::uint64_t saturated = 0;
+        equalizer_.estimate(bins_.data(), 1, kFftSize, 1 + symbol_);
+        equalizer_.apply(bins_.data(), symbols_.data(), saturated);
+    } else {
+        for (std::size_t k = 0; k < kDataSubcarriers; ++k) {
+            symbols_[k] = bins_[kDataBins[k]] * kRxScale;
+        }
+    }
+    const std::span<float> llrs(llrs_.data(), n_cbps_);
+    demap_maxlog(signal_.modulation, symbols_, base_.noise_variance, llrs);
+    std::span<const float> coded = llrs;
+    if (interleaver_ != nullptr) {
+        interleaver_->deinterleave(llrs, std::span(deinterleaved_.data(), n_cbps_));
+        coded = std::span(deinterleaved_.data(), n_cbps_);
+    }
+
+    const std::span<std::uint8_t> info(info_.data(), n_info_);
+    if (symbol_ == 0) {
+        decoder_.begin(n_info_, signal_.code_rate, ViterbiDecoder::soft_scale(coded));
+    }
+    std::size_t released = decoder_.feed(coded, info);
+    ++symbol_;
+    ++stats_.symbols_decoded;
+    if (symbol_ == n_sym_) {
+        decoder_.finish(info);
+        released = n_info_;
+    }
+    scrambler_.apply(info.subspan(released_, released - released_),
+                     info.subspan(released_, released - released_));
+    released_ = released;
+
+    if (!admit()) {
+        drop_payload();
+        return;
+    }
+    if (symbol_ == n_sym_) {
+        const std::size_t n_bits = 8 * std::size_t(signal_.length);
+        pack_bits(info.subspan(0, n_bits), payload_.view().subspan(0, n_bits));
+        ++stats_.delivered;
+        state_ = State::done;
+    }
+}
+
+bool IncrementalReceiver::admit() {
+    if (admitted_ || !filter_.accept) {
+        admitted_ = true;
+        return true;
+    }
+    const std::size_t bytes = std::min(filter_.header_bytes, std::size_t(signal_.length));
+    if (released_ < 8 * bytes) {
+        return true;  // not yet known
+    }
+    for (std::size_t b = 0; b < bytes; ++b) {
+        std::uint8_t v = 0;
+        for (std::size_t i = 0; i < 8; ++i) {
+            v |= std::uint8_t(info_[8 * b + i] << i);
+        }
+        header_[b] = v;
+    }
+    admitted_ = filter_.accept(signal_, std::span<const std::uint8_t>(header_.data(), bytes));
+    return admitted_;
+}
+
+void IncrementalReceiver::drop_payload() {
+    ++stats_.dropped_filter;
+    stats_.symbols_skipped += n_sym_ - symbol_;
+    skip_ = (n_sym_ - symbol_) * kSignalSamples;
+    state_ = State::dropped;
+}
+
+}  // namespace dcomm
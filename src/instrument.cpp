@@ -0,0 +1,109 @@
+#include "dcomm/instrument.hpp"
+
+#include <bit>
+#include <cinttypes>
+#include <stdexcept>
+#include <string>
+
+namespace dcomm {
+
+std::uint32_t probe_thread_id() noexcept {
+    static std::atomic<std::uint32_t> next{0};
+    thread_local const std::uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+TraceRing::TraceRing(std::size_t capacity)
+    : mask_(std::bit_ceil(capacity == 0 ? 1 : capacity) - 1),
+      events_(make_aligned_array<TraceEvent>(mask_ + 1)),
+      origin_cycles_(read_cycles()),
+      origin_ns_(now_ns()) {}
+
+void TraceRing::write_chrome_trace(std::FILE* out) const {
+    // Tick rate from the span between construction and now; fall back to
+    // one tick per nanosecond when too little time has passed to tell.
+    const std::uint64_t dc = read_cycles() - origin_cycles_;
+    const std::uint64_t dn = now_ns() - origin_ns_;
+    const double us_per_tick = (dc == 0 || dn < 1000) ? 1e-3 : double(dn) * 1e-3 / double(dc);
+
+    std::fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    bool first = true;
+    for_each([&](const TraceEvent& e) {
+        const double ts = double(std::int64_t(e.begin - origin_cycles_)) * us_per_tick;
+        const double dur = double(e.end - e.begin) * us_per_tick;
+        std::fprintf(out,
+                     "%s\n{\"name\":\"%s\",\"cat\":\"dcomm\",\"ph\":\"X\",\"pid\":1,"
+                     "\"tid\":%" PRIu32 ",\"ts\":%.3f,\"dur\":%.3f,"
+                     "\"args\":{\"samples\":%" PRIu32 "}}",
+                     first ? "" : ",", e.name, e.thread, ts, dur, e.samples);
+        first = false;
+    });
+    std::fprintf(out, "\n]}\n");
+}
+
+void TraceRing::write_chrome_trace(const char* path) const {
+    std::FILE* f = std::fopen(path, "w");
+    if (f == nullptr) {
+        throw std::runtime_error(std::string("TraceRing: cannot open ") + path);
+    }
+    write_chrome_trace(f);
+    if (std::fclose(f) != 0) {
+        throw std::runtime_error(std::string("TraceRing: cannot write ") + path);
+    }
+}
+
+#if DCOMM_INSTRUMENT
+
+StageProbe::StageProbe(const char* name)
+    : name_(name), slots_(std::make_unique<Slot[]>(kProbeThreads)) {}
+
+StageStats StageProbe::stats() const noexcept {
+    StageStats s;
+    s.name = name_;
+    for (std::size_t i = 0; i < kProbeThreads; ++i) {
+        s.blocks += slots_[i].blocks.load(std::memory_order_relaxed);
+        s.samples += slots_[i].samples.load(std::memory_order_relaxed);
+        s.busy_cycles += slots_[i].busy.load(std::memory_order_relaxed);
+        s.wait_cycles += slots_[i].wait.load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+void StageProbe::clear() noexcept {
+    for (std::size_t i = 0; i < kProbeThreads; ++i) {
+        slots_[i].blocks.store(0, std::memory_order_relaxed);
+        slots_[i].samples.store(0, std::memory_order_relaxed);
+        slots_[i].busy.store(0, std::memory_order_relaxed);
+        slots_[i].wait.store(0, std::memory_order_relaxed);
+    }
+}
+
+#endif
+
+void write_stage_report(std::FILE* out, std::span<const StageStats> stats) {
+    if (!kInstrumented) {
+        std::fprintf(out, "  (instrumentation compiled out)\n");
+        return;
+    }
+    const StageStats* bottleneck = nullptr;
+    double worst = 0.0;
+    for (const StageStats& s : stats) {
+        const double per_block = s.blocks == 0 ? 0.0 : double(s.busy_cycles) / double(s.blocks);
+        if (per_block > worst) {
+            worst = per_block;
+            bottleneck = &s;
+        }
+    }
+    std::fprintf(out, "  %-16s %10s %12s %14s %7s\n", "stage", "blocks", "cyc/sample",
+                 "cyc/block", "busy%");
+    for (const StageStats& s : stats) {
+        const double per_sample =
+            s.samples == 0 ? 0.0 : double(s.busy_cycles) / double(s.samples);
+        const double per_block = s.blocks == 0 ? 0.0 : double(s.busy_cycles) / double(s.blocks);
+        std::fprintf(out, "  %-16s %10" PRIu64 " %12.2f %14.0f %6.1f%%%s\n", s.name, s.blocks,
+                     per_sample, per_block, 100.0 * s.utilisation(),
+                     &s == bottleneck ? "  <- bottleneck" : "");
+    }
+}
+
+}  // namespace dcomm
@@ -0,0 +1,196 @@
+#include "dcomm/interleaver.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace dcomm {
+
+namespace {
+
+enum class Kind : std::uint8_t { ieee80211, row_column };
+
+using Key = std::tuple<Kind, std::size_t, std::size_t>;
+
+template <class Build>
+const BlockInterleaver& cached(const Key& key, Build build) {
+    static std::mutex mutex;
+    static std::map<Key, std::unique_ptr<BlockInterleaver>> tables;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<BlockInterleaver>& table = tables[key];
+    if (!table) {
+        table = std::make_unique<BlockInterleaver>(build());
+    }
+    return *table;
+}
+
+/// out[j] = in[index[j]] in every block of index.size() values.
+template <class T>
+void gather(const std::vector<std::uint32_t>& index, std::span<const T> in,
+            std::span<T> out) noexcept {
+    const std::size_t n = index.size();
+    assert(in.size() % n == 0 && out.size() == in.size());
+    const std::uint32_t* idx = index.data();
+    for (std::size_t base = 0; base < in.size(); base += n) {
+        const T* src = in.data() + base;
+        T* dst = out.data() + base;
+        for (std::size_t j = 0; j < n; ++j) {
+            dst[j] = src[idx[j]];
+        }
+    }
+}
+
+/// Bits converted per step of the packed gather.
+constexpr std::size_t kPackedRun = 4096;
+
+/// Packed streams are permuted as bytes: single-bit reads and writes cost
+/// variable shifts, while unpacking and packing a run is a few cycles per
+/// 64 bits. Runs are whole blocks starting on a word, so they span
+/// lcm(n, 64) bits; a block size that makes that too long is done bit by
+/// bit.
+void gather(const std::vector<std::uint32_t>& index, ConstBitSpan in, BitSpan out) noexcept {
+    const std::size_t n = index.size();
+    assert(in.size() % n == 0 && out.size() == in.size());
+    const std::size_t period = n / std::gcd(n, std::size_t(64)) * 64;
+    if (period > kPackedRun) {
+        for (std::size_t j = 0; j < out.size(); ++j) {
+            out.set(j, in[j - j % n + index[j % n]]);
+        }
+        return;
+    }
+    const std::size_t run = kPackedRun / period * period;
+    std::uint8_t src[kPackedRun];
+    std::uint8_t dst[kPackedRun];
+    for (std::size_t offset = 0; offset < in.size(); offset += run) {
+        const std::size_t m = std::min(run, in.size() - offset);
+        unpack_bits(in.subspan(offset, m), std::span(src, m));
+        gather(index, std::span<const std::uint8_t>(src, m), std::span(dst, m));
+        pack_bits(std::span<const std::uint8_t>(dst, m), out.subspan(offset, m));
+    }
+}
+
+}  // namespace
+
+BlockInterleaver::BlockInterleaver(std::vector<std::uint32_t> source)
+    : source_(std::move(source)), target_(source_.size(), ~std::uint32_t(0)) {
+    if (source_.empty()) {
+        throw std::invalid_argument("BlockInterleaver: empty permutation");
+    }
+    for (std::size_t j = 0; j < source_.size(); ++j) {
+        const std::uint32_t i = source_[j];
+        if (i >= source_.size() || target_[i] != ~std::uint32_t(0)) {
+            throw std::invalid_argument("BlockInterleaver: not a permutation");
+        }
+        target_[i] = std::uint32_t(j);
+    }
+}
+
+const BlockInterleaver& BlockInterleaver::ieee80211(std::size_t n_cbps, unsigned n_bpsc) {
+    if (n_bpsc == 0 || n_cbps == 0 || n_cbps % 16 != 0 || n_cbps % n_bpsc != 0) {
+        throw std::invalid_argument("BlockInterleaver: bad N_CBPS / N_BPSC");
+    }
+    return cached({Kind::ieee80211, n_cbps, n_bpsc}, [&] {
+        // Input bit k goes to i by the first permutation, then to j.
+        const std::size_t s = std::max<std::size_t>(n_bpsc / 2, 1);
+        std::vector<std::uint32_t> source(n_cbps);
+        for (std::size_t k = 0; k < n_cbps; ++k) {
+            const std::size_t i = (n_cbps / 16) * (k % 16) + k / 16;
+            const std::size_t j = s * (i / s) + (i + n_cbps - (16 * i / n_cbps)) % s;
+            source[j] = std::uint32_t(k);
+        }
+        return BlockInterleaver(std::move(source));
+    });
+}
+
+const BlockInterleaver& BlockInterleaver::ieee80211(const PhyConfig& config) {
+    return ieee80211(config.coded_bits_per_ofdm_symbol(), bits_per_symbol(config.modulation));
+}
+
+const BlockInterleaver& BlockInterleaver::row_column(std::size_t rows, std::size_t columns) {
+    if (rows == 0 || columns == 0) {
+        throw std::invalid_argument("BlockInterleaver: empty matrix");
+    }
+    return cached({Kind::row_column, rows, columns}, [&] {
+        std::vector<std::uint32_t> source(rows * columns);
+        for (std::size_t c = 0; c < columns; ++c) {
+            for (std::size_t r = 0; r < rows; ++r) {
+                source[c * rows + r] = std::uint32_t(r * columns + c);
+            }
+        }
+        return BlockInterleaver(std::move(source));
+    });
+}
+
+void BlockInterleaver::interleave(std::span<const std::uint8_t> in,
+                                  std::span<std::uint8_t> out) const noexcept {
+    gather(source_, in, out);
+}
+
+void BlockInterleaver::deinterleave(std::span<const std::uint8_t> in,
+                                    std::span<std::uint8_t> out) const noexcept {
+    gather(target_, in, out);
+}
+
+void BlockInterleaver::interleave(std::span<const float> in,
+                                  std::span<float> out) const noexcept {
+    gather(source_, in, out);
+}
+
+void BlockInterleaver::deinterleave(std::span<const float> in,
+                                    std::span<float> out) const noexcept {
+    gather(target_, in, out);
+}
+
+void BlockInterleaver::interleave(ConstBitSpan in, BitSpan out) const noexcept {
+    gather(source_, in, out);
+}
+
+void BlockInterleaver::deinterleave(ConstBitSpan in, BitSpan out) const noexcept {
+    gather(target_, in, out);
+}
+
+// --- Stages --------------------------------------------------------------
+
+InterleaverStage::InterleaverStage(const BlockInterleaver& interleaver,
+                                   std::size_t block_bits, std::size_t pool_depth)
+    : interleaver_(interleaver), block_bits_(block_bits),
+      pool_(pool_depth, packed_words(block_bits)) {}
+
+BufferView<std::uint64_t> InterleaverStage::process(BufferView<std::uint64_t> in) {
+    if (!in) {
+        return {};
+    }
+    BufferView<std::uint64_t> out = pool_.acquire();
+    if (!out) {
+        return {};
+    }
+    assert(in.size() == packed_words(block_bits_));
+    interleaver_.interleave(ConstBitSpan(in.span(), block_bits_),
+                            BitSpan(out.span(), block_bits_));
+    return out;
+}
+
+DeinterleaverStage::DeinterleaverStage(const BlockInterleaver& interleaver,
+                                       std::size_t block_bits, std::size_t pool_depth)
+    : interleaver_(interleaver), pool_(pool_depth, block_bits) {}
+
+BufferView<float> DeinterleaverStage::process(BufferView<float> in) {
+    if (!in) {
+        return {};
+    }
+    BufferView<float> out = pool_.acquire();
+    if (!out) {
+        return {};
+    }
+    out.resize(in.size());
+    interleaver_.deinterleave(in.span(), out.span());
+    return out;
+}
+
+}  // namespace dcomm
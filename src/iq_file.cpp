@@ -0,0 +1,479 @@
+#include "dcomm/iq_file.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dcomm {
+
+namespace {
+
+/// Resident window of a source: pages this far behind the read position
+/// are dropped, and this far ahead are requested.
+constexpr std::size_t kWindowBytes = std::size_t(64) << 20;
+
+constexpr const char* kDataSuffix = ".sigmf-data";
+constexpr const char* kMetaSuffix = ".sigmf-meta";
+
+[[noreturn]] void throw_errno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+bool ends_with(const std::string& s, const char* suffix) {
+    const std::size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+std::size_t page_size() {
+    static const std::size_t size = std::size_t(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+// --- SigMF metadata ------------------------------------------------------
+//
+// Only the handful of fields below are read, so rather than a JSON parser
+// the lookup finds the first occurrence of a key and reads its scalar
+// value. SigMF keys are namespaced ("core:..."), which keeps that safe.
+
+std::size_t value_of(const std::string& json, const char* key) {
+    const std::string quoted = std::string("\"") + key + "\"";
+    std::size_t at = json.find(quoted);
+    if (at == std::string::npos) {
+        return std::string::npos;
+    }
+    at = json.find_first_not_of(" \t\r\n", at + quoted.size());
+    if (at == std::string::npos || json[at] != ':') {
+        return std::string::npos;
+    }
+    return json.find_first_not_of(" \t\r\n", at + 1);
+}
+
+bool read_string(const std::string& json, const char* key, std::string& out) {
+    std::size_t at = value_of(json, key);
+    if (at == std::string::npos || json[at] != '"') {
+        return false;
+    }
+    out.clear();
+    for (++at; at < json.size() && json[at] != '"'; ++at) {
+        char c = json[at];
+        if (c == '\\' && at + 1 < json.size()) {
+            c = json[++at];
+            c = c == 'n' ? '\n' : c == 't' ? '\t' : c == 'r' ? '\r' : c;
+        }
+        out += c;
+    }
+    return true;
+}
+
+bool read_number(const std::string& json, const char* key, double& out) {
+    const std::size_t at = value_of(json, key);
+    if (at == std::string::npos) {
+        return false;
+    }
+    char* end = nullptr;
+    const double v = std::strtod(json.c_str() + at, &end);
+    if (end == json.c_str() + at) {
+        return false;
+    }
+    out = v;
+    return true;
+}
+
+std::string escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\t': out += "\\t"; break;
+        case '\r': out += "\\r"; break;
+        default:
+            if (static_cast<unsigned char>(c) >= 0x20) {
+                out += c;
+            }
+        }
+    }
+    return out;
+}
+
+// --- Sample conversion ---------------------------------------------------
+
+template <class From, class To>
+void convert(const From* in, To* out, std::size_t n, SaturationStats& stats) noexcept {
+    if constexpr (std::is_same_v<From, To>) {
+        std::memcpy(static_cast<void*>(out), in, n * sizeof(From));
+    } else if constexpr (std::is_same_v<From, cf32>) {
+        quantize<To>({in, n}, {out, n}, stats);
+    } else if constexpr (std::is_same_v<To, cf32>) {
+        dequantize<From>({in, n}, {out, n});
+    } else {
+        std::uint64_t saturated = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const ci16 w = widen(in[i]);
+            out[i] = narrow<To>(w.re, w.im, saturated);
+        }
+        stats.values += 2 * n;
+        stats.saturated += saturated;
+    }
+}
+
+/// Convert `n` samples between a typed buffer and raw bytes in `format`.
+template <class T>
+void from_file(IqFormat format, const std::byte* in, T* out, std::size_t n,
+               SaturationStats& stats) noexcept {
+    switch (format) {
+    case IqFormat::cf32: convert(reinterpret_cast<const cf32*>(in), out, n, stats); break;
+    case IqFormat::ci16: convert(reinterpret_cast<const ci16*>(in), out, n, stats); break;
+    case IqFormat::ci8: convert(reinterpret_cast<const ci8*>(in), out, n, stats); break;
+    }
+}
+
+template <class T>
+void to_file(IqFormat format, const T* in, std::byte* out, std::size_t n,
+             SaturationStats& stats) noexcept {
+    switch (format) {
+    case IqFormat::cf32: convert(in, reinterpret_cast<cf32*>(out), n, stats); break;
+    case IqFormat::ci16: convert(in, reinterpret_cast<ci16*>(out), n, stats); break;
+    case IqFormat::ci8: convert(in, reinterpret_cast<ci8*>(out), n, stats); break;
+    }
+}
+
+}  // namespace
+
+const char* to_string(IqFormat f) noexcept {
+    switch (f) {
+    case IqFormat::cf32: return "cf32_le";
+    case IqFormat::ci16: return "ci16_le";
+    case IqFormat::ci8: return "ci8";
+    }
+    return "unknown";
+}
+
+std::string sigmf_meta_path(const std::string& data_path) {
+    if (ends_with(data_path, kDataSuffix)) {
+        return data_path.substr(0, data_path.size() - std::strlen(kDataSuffix)) + kMetaSuffix;
+    }
+    return data_path + kMetaSuffix;
+}
+
+SigmfMeta read_sigmf_meta(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw_errno("read_sigmf_meta: cannot open " + path);
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    const std::string json = text.str();
+
+    SigmfMeta meta;
+    std::string datatype;
+    if (!read_string(json, "core:datatype", datatype)) {
+        throw std::invalid_argument("read_sigmf_meta: no core:datatype in " + path);
+    }
+    bool known = false;
+    for (IqFormat f : {IqFormat::cf32, IqFormat::ci16, IqFormat::ci8}) {
+        // ci8 has no byte order; "ci8_le" is accepted as well.
+        if (datatype == to_string(f) || (f == IqFormat::ci8 && datatype == "ci8_le")) {
+            meta.format = f;
+            known = true;
+        }
+    }
+    if (!known) {
+        throw std::invalid_argument("read_sigmf_meta: unsupported datatype " + datatype);
+    }
+    read_number(json, "core:sample_rate", meta.sample_rate);
+    read_number(json, "core:frequency", meta.frequency);
+    read_string(json, "core:description", meta.description);
+    return meta;
+}
+
+void write_sigmf_meta(const std::string& path, const SigmfMeta& meta) {
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (f == nullptr) {
+        throw_errno("write_sigmf_meta: cannot create " + path);
+    }
+    std::fprintf(f,
+                 "{\n"
+                 "    \"global\": {\n"
+                 "        \"core:datatype\": \"%s\",\n"
+                 "        \"core:sample_rate\": %.17g,\n"
+                 "        \"core:version\": \"1.0.0\",\n"
+                 "        \"core:description\": \"%s\"\n"
+                 "    },\n"
+                 "    \"captures\": [\n"
+                 "        {\"core:sample_start\": 0, \"core:frequency\": %.17g}\n"
+                 "    ],\n"
+                 "    \"annotations\": []\n"
+                 "}\n",
+                 to_string(meta.format), meta.sample_rate, escape(meta.description).c_str(),
+                 meta.frequency);
+    if (std::fclose(f) != 0) {
+        throw_errno("write_sigmf_meta: cannot write " + path);
+    }
+}
+
+// --- IqFileSource --------------------------------------------------------
+
+IqFileSource::IqFileSource(const std::string& path) {
+    std::string data = path;
+    if (ends_with(path, kMetaSuffix)) {
+        data = path.substr(0, path.size() - std::strlen(kMetaSuffix)) + kDataSuffix;
+    }
+    meta_ = read_sigmf_meta(sigmf_meta_path(data));
+    open(data);
+}
+
+IqFileSource::IqFileSource(const std::string& path, IqFormat format, double sample_rate) {
+    if (sample_bytes(format) == 0) {
+        throw std::invalid_argument("IqFileSource: unknown format");
+    }
+    meta_.format = format;
+    meta_.sample_rate = sample_rate;
+    open(path);
+}
+
+IqFileSource::~IqFileSource() {
+    if (map_ != nullptr) {
+        ::munmap(const_cast<std::byte*>(map_), map_bytes_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+void IqFileSource::open(const std::string& path) {
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        throw_errno("IqFileSource: cannot open " + path);
+    }
+    struct stat st {};
+    if (::fstat(fd_, &st) != 0) {
+        const int err = errno;
+        ::close(fd_);
+        fd_ = -1;
+        throw std::system_error(err, std::generic_category(), "IqFileSource: stat " + path);
+    }
+    map_bytes_ = std::size_t(st.st_size);
+    samples_ = map_bytes_ / sample_bytes(meta_.format);
+    if (map_bytes_ == 0) {
+        return;  // mmap rejects empty mappings; an empty file reads as end of file
+    }
+    void* p = ::mmap(nullptr, map_bytes_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (p == MAP_FAILED) {
+        const int err = errno;
+        ::close(fd_);
+        fd_ = -1;
+        throw std::system_error(err, std::generic_category(), "IqFileSource: mmap " + path);
+    }
+    map_ = static_cast<const std::byte*>(p);
+    // Advice only; a kernel that ignores it still reads the file correctly.
+    ::madvise(p, map_bytes_, MADV_SEQUENTIAL);
+    advance(0);
+}
+
+void IqFileSource::seek(std::uint64_t sample) noexcept {
+    position_ = std::min(sample, samples_);
+    const std::size_t at = std::size_t(position_ * sample_bytes(meta_.format));
+    // Seeking backwards into dropped pages faults them back in from the
+    // file; only the bookkeeping has to follow.
+    released_ = std::min(released_, at & ~(page_size() - 1));
+    prefetched_ = std::min(prefetched_, at);
+    advance(0);
+}
+
+void IqFileSource::advance(std::uint64_t count) noexcept {
+    position_ += count;
+    if (map_ == nullptr) {
+        return;
+    }
+    const std::size_t page = page_size();
+    const std::size_t at = std::size_t(position_ * sample_bytes(meta_.format));
+    auto* base = const_cast<std::byte*>(map_);
+    if (at >= released_ + 2 * kWindowBytes) {
+        const std::size_t until = (at - kWindowBytes) & ~(page - 1);
+        ::madvise(base + released_, until - released_, MADV_DONTNEED);
+        released_ = until;
+    }
+    if (at + kWindowBytes / 2 >= prefetched_ && prefetched_ < map_bytes_) {
+        const std::size_t from = std::max(prefetched_, at) & ~(page - 1);
+        const std::size_t until = std::min(map_bytes_, at + kWindowBytes);
+        ::madvise(base + from, until - from, MADV_WILLNEED);
+        prefetched_ = until;
+    }
+}
+
+template <SampleType T>
+std::size_t IqFileSource::read(std::span<T> out) noexcept {
+    const std::size_t n = std::size_t(std::min<std::uint64_t>(out.size(), remaining()));
+    if (n == 0) {
+        return 0;
+    }
+    const std::byte* in = map_ + position_ * sample_bytes(meta_.format);
+    from_file(meta_.format, in, out.data(), n, saturation_);
+    advance(n);
+    return n;
+}
+
+template <SampleType T>
+std::span<const T> IqFileSource::view(std::size_t count) {
+    if (iq_format_of<T> != meta_.format) {
+        throw std::invalid_argument("IqFileSource: view type does not match the file format");
+    }
+    const std::size_t n = std::size_t(std::min<std::uint64_t>(count, remaining()));
+    if (n == 0) {
+        return {};
+    }
+    const T* first = reinterpret_cast<const T*>(map_) + position_;
+    advance(n);
+    return {first, n};
+}
+
+// --- IqFileSink ----------------------------------------------------------
+
+IqFileSink::IqFileSink(const std::string& path, SigmfMeta meta, std::size_t chunk_bytes,
+                       bool direct)
+    : path_(path), meta_(std::move(meta)),
+      chunk_bytes_(align_up(std::max(chunk_bytes, kPageBytes), kPageBytes)) {
+    if (sample_bytes(meta_.format) == 0) {
+        throw std::invalid_argument("IqFileSink: unknown format");
+    }
+    const int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+#ifdef O_DIRECT
+    if (direct) {
+        fd_ = ::open(path.c_str(), flags | O_DIRECT, 0644);
+        direct_ = fd_ >= 0;
+    }
+#endif
+    if (fd_ < 0) {
+        fd_ = ::open(path.c_str(), flags, 0644);
+    }
+    if (fd_ < 0) {
+        throw_errno("IqFileSink: cannot create " + path);
+    }
+    // O_DIRECT needs the buffer, offsets and lengths page aligned.
+    void* p = std::aligned_alloc(kPageBytes, chunk_bytes_);
+    if (p == nullptr) {
+        ::close(fd_);
+        throw std::bad_alloc();
+    }
+    chunk_.reset(static_cast<std::byte*>(p));
+}
+
+IqFileSink::~IqFileSink() {
+    try {
+        close();
+    } catch (...) {
+        // The destructor cannot report a failed flush; call close() to see it.
+    }
+}
+
+template <SampleType T>
+void IqFileSink::write(std::span<const T> in) {
+    if (fd_ < 0) {
+        throw std::invalid_argument("IqFileSink: write after close");
+    }
+    const std::size_t size = sample_bytes(meta_.format);
+    // Chunks hold whole samples; every power-of-two sample size divides
+    // the page-aligned chunk, so a full chunk is always page aligned too.
+    const std::size_t capacity = chunk_bytes_ / size;
+    std::size_t done = 0;
+    while (done < in.size()) {
+        const std::size_t n = std::min(in.size() - done, capacity - fill_ / size);
+        to_file(meta_.format, in.data() + done, chunk_.get() + fill_, n, saturation_);
+        fill_ += n * size;
+        done += n;
+        if (fill_ == chunk_bytes_) {
+            write_chunk(fill_);
+            fill_ = 0;
+        }
+    }
+    samples_ += in.size();
+}
+
+void IqFileSink::write_chunk(std::size_t bytes) {
+    std::size_t written = 0;
+    while (written < bytes) {
+        const ssize_t n = ::pwrite(fd_, chunk_.get() + written, bytes - written,
+                                   off_t(offset_ + written));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw_errno("IqFileSink: write " + path_);
+        }
+        written += std::size_t(n);
+    }
+#if defined(__linux__) && defined(SYNC_FILE_RANGE_WRITE)
+    if (!direct_) {
+        // Start writeback of this chunk now, then wait for the previous one
+        // (long since submitted) and drop it from the page cache, so dirty
+        // and cached pages stay at about two chunks.
+        ::sync_file_range(fd_, off_t(offset_), off_t(bytes), SYNC_FILE_RANGE_WRITE);
+        if (offset_ >= chunk_bytes_) {
+            const off_t prev = off_t(offset_ - chunk_bytes_);
+            ::sync_file_range(fd_, prev, off_t(chunk_bytes_),
+                              SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE |
+                                  SYNC_FILE_RANGE_WAIT_AFTER);
+            ::posix_fadvise(fd_, prev, off_t(chunk_bytes_), POSIX_FADV_DONTNEED);
+        }
+    }
+#endif
+    offset_ += bytes;
+}
+
+void IqFileSink::close() {
+    if (fd_ < 0) {
+        return;
+    }
+    const int fd = fd_;
+    try {
+        if (fill_ > 0) {
+#ifdef O_DIRECT
+            // The tail is not a whole number of pages: finish it buffered.
+            if (direct_) {
+                ::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) & ~O_DIRECT);
+                direct_ = false;
+            }
+#endif
+            write_chunk(fill_);
+            fill_ = 0;
+        }
+    } catch (...) {
+        fd_ = -1;
+        ::close(fd);
+        throw;
+    }
+    fd_ = -1;
+    if (::close(fd) != 0) {
+        throw_errno("IqFileSink: close " + path_);
+    }
+    if (ends_with(path_, kDataSuffix)) {
+        write_sigmf_meta(sigmf_meta_path(path_), meta_);
+    }
+}
+
+template std::size_t IqFileSource::read<cf32>(std::span<cf32>) noexcept;
+template std::size_t IqFileSource::read<ci16>(std::span<ci16>) noexcept;
+template std::size_t IqFileSource::read<ci8>(std::span<ci8>) noexcept;
+template std::span<const cf32> IqFileSource::view<cf32>(std::size_t);
+template std::span<const ci16> IqFileSource::view<ci16>(std::size_t);
+template std::span<const ci8> IqFileSource::view<ci8>(std::size_t);
+template void IqFileSink::write<cf32>(std::span<const cf32>);
+template void IqFileSink::write<ci16>(std::span<const ci16>);
+template void IqFileSink::write<ci8>(std::span<const ci8>);
+
+}  // namespace dcomm
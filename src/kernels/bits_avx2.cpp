@@ -0,0 +1,95 @@
+// BMI2 bit kernels (see bits_kernels.hpp): one pdep or pext per word, or
+// per eight fields, for the field, zip and select kernels; AVX2 movemask to
+// pack bytes and float signs. Like every AVX2 unit this is built with
+// -mbmi2; bits.cpp only picks it when the CPU reports BMI2.
+
+#include <immintrin.h>
+
+#include "bits_kernels.hpp"
+#include "bits_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void pack_avx2(const std::uint8_t* bits, std::size_t n, std::uint64_t* words) {
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        // Bit 0 of each byte to its sign position for movemask.
+        const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits + i));
+        const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits + i + 32));
+        const auto l = std::uint32_t(_mm256_movemask_epi8(_mm256_slli_epi16(lo, 7)));
+        const auto h = std::uint32_t(_mm256_movemask_epi8(_mm256_slli_epi16(hi, 7)));
+        *words++ = std::uint64_t(h) << 32 | l;
+    }
+    ref_pack(bits + i, n - i, words);
+}
+
+void unpack_avx2(const std::uint64_t* words, std::size_t n, std::uint8_t* bits) {
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        const std::uint64_t w = words[i / 64];
+        for (unsigned g = 0; g < 8; ++g) {
+            const std::uint64_t x = _pdep_u64(w >> (8 * g), kByteLsbs);
+            std::memcpy(bits + i + 8 * g, &x, 8);
+        }
+    }
+    ref_unpack(words + i / 64, n - i, bits + i);
+}
+
+void pack_signs_avx2(const float* x, std::size_t n, std::uint64_t* words) {
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        std::uint64_t w = 0;
+        for (unsigned g = 0; g < 8; ++g) {
+            w |= std::uint64_t(_mm256_movemask_ps(_mm256_loadu_ps(x + i + 8 * g))) << (8 * g);
+        }
+        *words++ = w;
+    }
+    ref_pack_signs(x + i, n - i, words);
+}
+
+void unpack_signs_avx2(const std::uint64_t* words, std::size_t n, float magnitude, float* x) {
+    const __m256i lane_bit = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256 pos = _mm256_set1_ps(magnitude);
+    const __m256 neg = _mm256_set1_ps(-magnitude);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const auto byte = std::int32_t((words[i / 64] >> (i % 64)) & 0xff);
+        const __m256i set = _mm256_cmpeq_epi32(
+            _mm256_and_si256(_mm256_set1_epi32(byte), lane_bit), lane_bit);
+        _mm256_storeu_ps(x + i, _mm256_blendv_ps(pos, neg, _mm256_castsi256_ps(set)));
+    }
+    for (; i < n; ++i) {
+        x[i] = (words[i / 64] >> (i % 64)) & 1u ? -magnitude : magnitude;
+    }
+}
+
+void unpack_fields_avx2(const std::uint64_t* words, std::size_t n, unsigned width,
+                        std::uint8_t* fields) {
+    ref_unpack_fields<Bmi2BitOps>(words, n, width, fields);
+}
+
+void pack_fields_avx2(const std::uint8_t* fields, std::size_t n, unsigned width,
+                      std::uint64_t* words) {
+    ref_pack_fields<Bmi2BitOps>(fields, n, width, words);
+}
+
+void zip_avx2(const std::uint64_t* a, const std::uint64_t* b, std::size_t n,
+              std::uint64_t* out) {
+    ref_zip<Bmi2BitOps>(a, b, n, out);
+}
+
+std::size_t select_avx2(const std::uint64_t* in, std::size_t n, const std::uint64_t* keep,
+                        std::size_t p, std::uint64_t* out) {
+    return ref_select<Bmi2BitOps>(in, n, keep, p, out);
+}
+
+}  // namespace
+
+const BitKernels bits_avx2 = {
+    pack_avx2,          unpack_avx2,      pack_signs_avx2, unpack_signs_avx2,
+    unpack_fields_avx2, pack_fields_avx2, zip_avx2,        select_avx2,
+};
+
+}  // namespace dcomm::kernels
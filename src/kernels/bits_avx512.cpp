@@ -0,0 +1,94 @@
+// AVX-512 bit kernels (see bits_kernels.hpp): a packed word is exactly a
+// 64-lane byte mask, so packing is one test into a mask register and
+// unpacking one masked move; float signs go through 16-lane masks the same
+// way. The field, zip and select kernels are the BMI2 ones.
+
+#include <immintrin.h>
+
+#include "bits_kernels.hpp"
+#include "bits_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void pack_avx512(const std::uint8_t* bits, std::size_t n, std::uint64_t* words) {
+    const __m512i one = _mm512_set1_epi8(1);
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        *words++ = _mm512_test_epi8_mask(_mm512_loadu_si512(bits + i), one);
+    }
+    if (i < n) {
+        const __mmask64 live = _cvtu64_mask64(ref_tail_mask(n - i));
+        *words = _mm512_mask_test_epi8_mask(live, _mm512_maskz_loadu_epi8(live, bits + i), one);
+    }
+}
+
+void unpack_avx512(const std::uint64_t* words, std::size_t n, std::uint8_t* bits) {
+    const __m512i one = _mm512_set1_epi8(1);
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        _mm512_storeu_si512(bits + i, _mm512_maskz_mov_epi8(_cvtu64_mask64(words[i / 64]), one));
+    }
+    if (i < n) {
+        const __mmask64 live = _cvtu64_mask64(ref_tail_mask(n - i));
+        _mm512_mask_storeu_epi8(bits + i, live,
+                                _mm512_maskz_mov_epi8(_cvtu64_mask64(words[i / 64]), one));
+    }
+}
+
+void pack_signs_avx512(const float* x, std::size_t n, std::uint64_t* words) {
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        std::uint64_t w = 0;
+        for (unsigned g = 0; g < 4; ++g) {
+            const __m512i v = _mm512_castps_si512(_mm512_loadu_ps(x + i + 16 * g));
+            w |= std::uint64_t(_cvtmask16_u32(_mm512_movepi32_mask(v))) << (16 * g);
+        }
+        *words++ = w;
+    }
+    ref_pack_signs(x + i, n - i, words);
+}
+
+void unpack_signs_avx512(const std::uint64_t* words, std::size_t n, float magnitude,
+                         float* x) {
+    const __m512 pos = _mm512_set1_ps(magnitude);
+    const __m512 neg = _mm512_set1_ps(-magnitude);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const auto k = __mmask16((words[i / 64] >> (i % 64)) & 0xffff);
+        _mm512_storeu_ps(x + i, _mm512_mask_blend_ps(k, pos, neg));
+    }
+    for (; i < n; ++i) {
+        x[i] = (words[i / 64] >> (i % 64)) & 1u ? -magnitude : magnitude;
+    }
+}
+
+void unpack_fields_avx512(const std::uint64_t* words, std::size_t n, unsigned width,
+                          std::uint8_t* fields) {
+    ref_unpack_fields<Bmi2BitOps>(words, n, width, fields);
+}
+
+void pack_fields_avx512(const std::uint8_t* fields, std::size_t n, unsigned width,
+                        std::uint64_t* words) {
+    ref_pack_fields<Bmi2BitOps>(fields, n, width, words);
+}
+
+void zip_avx512(const std::uint64_t* a, const std::uint64_t* b, std::size_t n,
+                std::uint64_t* out) {
+    ref_zip<Bmi2BitOps>(a, b, n, out);
+}
+
+std::size_t select_avx512(const std::uint64_t* in, std::size_t n, const std::uint64_t* keep,
+                          std::size_t p, std::uint64_t* out) {
+    return ref_select<Bmi2BitOps>(in, n, keep, p, out);
+}
+
+}  // namespace
+
+const BitKernels bits_avx512 = {
+    pack_avx512,          unpack_avx512,      pack_signs_avx512, unpack_signs_avx512,
+    unpack_fields_avx512, pack_fields_avx512, zip_avx512,        select_avx512,
+};
+
+}  // namespace dcomm::kernels
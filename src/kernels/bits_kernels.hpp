@@ -0,0 +1,47 @@
+#pragma once
+
+// Per-ISA kernels behind bits.hpp.
+//
+// Streams are packed LSB first into 64-bit words. Counts are in bits (or
+// fields, or values): kernels read no word past the last one holding input
+// bits and clear the padding of the last word they write. The field, zip
+// and select kernels are pdep/pext at heart. The portable variant emulates
+// both with loops over the mask bits; the AVX2 one has BMI2 (every AVX2
+// unit is built with -mbmi2, and bits.cpp only picks it when the CPU has
+// it) and packs bytes and float signs with movemask; the AVX-512 one does
+// those through mask registers instead.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dcomm::kernels {
+
+struct BitKernels {
+    /// n unpacked bits (bit 0 of each byte) to words, and back.
+    void (*pack)(const std::uint8_t* bits, std::size_t n, std::uint64_t* words);
+    void (*unpack)(const std::uint64_t* words, std::size_t n, std::uint8_t* bits);
+    /// Sign bits of n floats; n floats +magnitude for a 0, -magnitude for a 1.
+    void (*pack_signs)(const float* x, std::size_t n, std::uint64_t* words);
+    void (*unpack_signs)(const std::uint64_t* words, std::size_t n, float magnitude,
+                         float* x);
+    /// n `width`-bit fields, first bit most significant, one per byte.
+    void (*unpack_fields)(const std::uint64_t* words, std::size_t n, unsigned width,
+                          std::uint8_t* fields);
+    void (*pack_fields)(const std::uint8_t* fields, std::size_t n, unsigned width,
+                        std::uint64_t* words);
+    /// 2n bits a0 b0 a1 b1 ... of two n-bit streams.
+    void (*zip)(const std::uint64_t* a, const std::uint64_t* b, std::size_t n,
+                std::uint64_t* out);
+    /// The bits of an n-bit stream whose bit of the p-word periodic mask is
+    /// set; returns their number. `out` may be `in`.
+    std::size_t (*select)(const std::uint64_t* in, std::size_t n, const std::uint64_t* keep,
+                          std::size_t p, std::uint64_t* out);
+};
+
+extern const BitKernels bits_scalar;
+#if defined(DCOMM_KERNELS_X86)
+extern const BitKernels bits_avx2;    ///< BMI2 pdep/pext, AVX2 movemask
+extern const BitKernels bits_avx512;  ///< mask-register pack/unpack, BMI2 for the rest
+#endif
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,278 @@
+#pragma once
+
+// Reference bit kernels (see bits_kernels.hpp). The field, zip and select
+// kernels are templates over the pdep/pext implementation, so the portable
+// and BMI2 variants share all their other arithmetic. Internal linkage:
+// every kernel translation unit includes this and compiles it for its own
+// ISA.
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "bits_kernels.hpp"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace dcomm::kernels {
+namespace {
+
+static_assert(std::endian::native == std::endian::little,
+              "byte i of a loaded word must be its bits 8i..8i+7");
+
+constexpr std::uint64_t kByteLsbs = 0x0101010101010101;
+constexpr std::uint64_t kEvenBits = 0x5555555555555555;
+
+constexpr std::size_t ref_words(std::size_t bits) noexcept { return (bits + 63) / 64; }
+
+constexpr std::uint64_t ref_tail_mask(std::size_t bits) noexcept {
+    return bits % 64 == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << (bits % 64)) - 1;
+}
+
+/// The low bit of each byte of `x` gathered into 8 bits.
+constexpr unsigned gather_byte_lsbs(std::uint64_t x) noexcept {
+    return unsigned(((x & kByteLsbs) * 0x0102040810204080) >> 56);
+}
+
+/// kSpreadBits[v] has bit j of v in bit 0 of byte j.
+constexpr std::array<std::uint64_t, 256> kSpreadBits = [] {
+    std::array<std::uint64_t, 256> t{};
+    for (unsigned v = 0; v < 256; ++v) {
+        for (unsigned j = 0; j < 8; ++j) {
+            t[v] |= std::uint64_t((v >> j) & 1u) << (8 * j);
+        }
+    }
+    return t;
+}();
+
+constexpr std::uint64_t reverse_bits_in_bytes(std::uint64_t x) noexcept {
+    x = ((x >> 1) & 0x5555555555555555) | ((x & 0x5555555555555555) << 1);
+    x = ((x >> 2) & 0x3333333333333333) | ((x & 0x3333333333333333) << 2);
+    return ((x >> 4) & 0x0f0f0f0f0f0f0f0f) | ((x & 0x0f0f0f0f0f0f0f0f) << 4);
+}
+
+constexpr unsigned reverse_low_bits(unsigned v, unsigned width) noexcept {
+    unsigned r = 0;
+    for (unsigned j = 0; j < width; ++j) {
+        r = (r << 1) | ((v >> j) & 1u);
+    }
+    return r;
+}
+
+/// pdep / pext as loops over the set bits of the mask; spread() moves the
+/// 32 bits of x to the even positions.
+struct PortableBitOps {
+    static std::uint64_t deposit(std::uint64_t x, std::uint64_t m) noexcept {
+        std::uint64_t r = 0;
+        for (std::uint64_t bit = 1; m != 0; m &= m - 1, bit <<= 1) {
+            r |= x & bit ? m & -m : 0;
+        }
+        return r;
+    }
+    static std::uint64_t extract(std::uint64_t x, std::uint64_t m) noexcept {
+        std::uint64_t r = 0;
+        for (std::uint64_t bit = 1; m != 0; m &= m - 1, bit <<= 1) {
+            r |= x & m & -m ? bit : 0;
+        }
+        return r;
+    }
+    static std::uint64_t spread(std::uint32_t v) noexcept {
+        std::uint64_t x = v;
+        x = (x | (x << 16)) & 0x0000ffff0000ffff;
+        x = (x | (x << 8)) & 0x00ff00ff00ff00ff;
+        x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0f;
+        x = (x | (x << 2)) & 0x3333333333333333;
+        return (x | (x << 1)) & kEvenBits;
+    }
+};
+
+#if defined(__BMI2__)
+struct Bmi2BitOps {
+    static std::uint64_t deposit(std::uint64_t x, std::uint64_t m) noexcept {
+        return _pdep_u64(x, m);
+    }
+    static std::uint64_t extract(std::uint64_t x, std::uint64_t m) noexcept {
+        return _pext_u64(x, m);
+    }
+    static std::uint64_t spread(std::uint32_t v) noexcept { return _pdep_u64(v, kEvenBits); }
+};
+#endif
+
+/// Appends groups of bits to a packed stream a word at a time.
+class BitWriter {
+public:
+    explicit BitWriter(std::uint64_t* out) noexcept : out_(out) {}
+
+    /// Append the low k (0..64) bits of v; its other bits must be zero.
+    void put(std::uint64_t v, unsigned k) noexcept {
+        acc_ |= v << fill_;
+        if (fill_ + k >= 64) {
+            *out_++ = acc_;
+            const unsigned used = 64 - fill_;
+            acc_ = used == 64 ? 0 : v >> used;
+            fill_ = fill_ + k - 64;
+        } else {
+            fill_ += k;
+        }
+    }
+    /// Store the partial last word, its padding clear.
+    void finish() noexcept {
+        if (fill_ != 0) {
+            *out_ = acc_;
+        }
+    }
+
+private:
+    std::uint64_t* out_;
+    std::uint64_t acc_ = 0;
+    unsigned fill_ = 0;
+};
+
+/// Bits [pos, pos + k) of an n-word stream, k <= 64, in the low bits.
+inline std::uint64_t read_bits(const std::uint64_t* w, std::size_t nwords, std::size_t pos,
+                               unsigned k) noexcept {
+    const std::size_t i = pos / 64;
+    const unsigned s = pos % 64;
+    std::uint64_t v = w[i] >> s;
+    if (s != 0 && s + k > 64) {
+        assert(i + 1 < nwords);
+        v |= w[i + 1] << (64 - s);
+    }
+    (void)nwords;
+    return k == 64 ? v : v & ((std::uint64_t(1) << k) - 1);
+}
+
+inline void ref_pack(const std::uint8_t* bits, std::size_t n, std::uint64_t* words) noexcept {
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        std::uint64_t w = 0;
+        for (unsigned g = 0; g < 8; ++g) {
+            std::uint64_t x;
+            std::memcpy(&x, bits + i + 8 * g, 8);
+            w |= std::uint64_t(gather_byte_lsbs(x)) << (8 * g);
+        }
+        *words++ = w;
+    }
+    if (i < n) {
+        std::uint64_t w = 0;
+        for (unsigned j = 0; i + j < n; ++j) {
+            w |= std::uint64_t(bits[i + j] & 1u) << j;
+        }
+        *words = w;
+    }
+}
+
+inline void ref_unpack(const std::uint64_t* words, std::size_t n, std::uint8_t* bits) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const std::uint64_t x = kSpreadBits[(words[i / 64] >> (i % 64)) & 0xff];
+        std::memcpy(bits + i, &x, 8);
+    }
+    for (; i < n; ++i) {
+        bits[i] = std::uint8_t((words[i / 64] >> (i % 64)) & 1u);
+    }
+}
+
+inline void ref_pack_signs(const float* x, std::size_t n, std::uint64_t* words) noexcept {
+    for (std::size_t w = 0; w < ref_words(n); ++w) {
+        std::uint64_t v = 0;
+        for (std::size_t j = 0; j < 64 && 64 * w + j < n; ++j) {
+            v |= std::uint64_t(std::bit_cast<std::uint32_t>(x[64 * w + j]) >> 31) << j;
+        }
+        words[w] = v;
+    }
+}
+
+inline void ref_unpack_signs(const std::uint64_t* words, std::size_t n, float magnitude,
+                             float* x) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = (words[i / 64] >> (i % 64)) & 1u ? -magnitude : magnitude;
+    }
+}
+
+template <class Ops>
+void ref_unpack_fields(const std::uint64_t* words, std::size_t n, unsigned width,
+                       std::uint8_t* fields) noexcept {
+    assert(width >= 1 && width <= 8);
+    const std::size_t nwords = ref_words(n * width);
+    const std::uint64_t m = kByteLsbs * ((1u << width) - 1);
+    std::size_t i = 0;
+    std::size_t pos = 0;
+    for (; i + 8 <= n; i += 8, pos += 8 * width) {
+        // One field per byte, first bit lowest; reversing each byte puts the
+        // first bit on top, and the shift brings the field back down.
+        const std::uint64_t v = Ops::deposit(read_bits(words, nwords, pos, 8 * width), m);
+        const std::uint64_t r = (reverse_bits_in_bytes(v) >> (8 - width)) & m;
+        std::memcpy(fields + i, &r, 8);
+    }
+    for (; i < n; ++i, pos += width) {
+        fields[i] = std::uint8_t(
+            reverse_low_bits(unsigned(read_bits(words, nwords, pos, width)), width));
+    }
+}
+
+template <class Ops>
+void ref_pack_fields(const std::uint8_t* fields, std::size_t n, unsigned width,
+                     std::uint64_t* words) noexcept {
+    assert(width >= 1 && width <= 8);
+    const std::uint64_t m = kByteLsbs * ((1u << width) - 1);
+    BitWriter out(words);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        std::uint64_t x;
+        std::memcpy(&x, fields + i, 8);
+        const std::uint64_t r = reverse_bits_in_bytes((x & m) << (8 - width));
+        out.put(Ops::extract(r, m), 8 * width);
+    }
+    for (; i < n; ++i) {
+        out.put(reverse_low_bits(fields[i] & ((1u << width) - 1), width), width);
+    }
+    out.finish();
+}
+
+template <class Ops>
+void ref_zip(const std::uint64_t* a, const std::uint64_t* b, std::size_t n,
+             std::uint64_t* out) noexcept {
+    const std::size_t nw = ref_words(n);
+    const std::size_t out_words = ref_words(2 * n);
+    for (std::size_t w = 0; w < nw; ++w) {
+        const std::uint64_t keep = w + 1 == nw ? ref_tail_mask(n) : ~std::uint64_t(0);
+        const std::uint64_t x = a[w] & keep;
+        const std::uint64_t y = b[w] & keep;
+        out[2 * w] = Ops::spread(std::uint32_t(x)) | Ops::spread(std::uint32_t(y)) << 1;
+        if (2 * w + 1 < out_words) {
+            out[2 * w + 1] =
+                Ops::spread(std::uint32_t(x >> 32)) | Ops::spread(std::uint32_t(y >> 32)) << 1;
+        }
+    }
+}
+
+template <class Ops>
+std::size_t ref_select(const std::uint64_t* in, std::size_t n, const std::uint64_t* keep,
+                       std::size_t p, std::uint64_t* out) noexcept {
+    // Word w of the output is written only once input words 0..w are read,
+    // so the selection can run in place.
+    const std::size_t nw = ref_words(n);
+    BitWriter writer(out);
+    std::size_t count = 0;
+    for (std::size_t w = 0; w < nw; ++w) {
+        std::uint64_t m = keep[w % p];
+        if (w + 1 == nw) {
+            m &= ref_tail_mask(n);
+        }
+        const std::uint64_t v = Ops::extract(in[w], m);
+        const unsigned k = unsigned(std::popcount(m));
+        writer.put(v, k);
+        count += k;
+    }
+    writer.finish();
+    return count;
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
@@ -0,0 +1,35 @@
+#include "bits_kernels.hpp"
+#include "bits_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void unpack_fields_scalar(const std::uint64_t* words, std::size_t n, unsigned width,
+                          std::uint8_t* fields) {
+    ref_unpack_fields<PortableBitOps>(words, n, width, fields);
+}
+
+void pack_fields_scalar(const std::uint8_t* fields, std::size_t n, unsigned width,
+                        std::uint64_t* words) {
+    ref_pack_fields<PortableBitOps>(fields, n, width, words);
+}
+
+void zip_scalar(const std::uint64_t* a, const std::uint64_t* b, std::size_t n,
+                std::uint64_t* out) {
+    ref_zip<PortableBitOps>(a, b, n, out);
+}
+
+std::size_t select_scalar(const std::uint64_t* in, std::size_t n, const std::uint64_t* keep,
+                          std::size_t p, std::uint64_t* out) {
+    return ref_select<PortableBitOps>(in, n, keep, p, out);
+}
+
+}  // namespace
+
+const BitKernels bits_scalar = {
+    ref_pack, ref_unpack, ref_pack_signs, ref_unpack_signs,
+    unpack_fields_scalar, pack_fields_scalar, zip_scalar, select_scalar,
+};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,167 @@
+// AVX2 Gaussian noise: eight Philox blocks, sixteen complex samples, per
+// iteration. Philox's 32x32->64 multiplies use _mm256_mul_epu32 on the even
+// and odd lanes; log and sincos follow the reference polynomials step by
+// step (see channel_ref.hpp), so the output is bit-identical to it.
+
+#include <immintrin.h>
+
+#include "channel_kernels.hpp"
+#include "channel_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+/// High and low halves of the eight 32x32-bit products a * m.
+inline __m256i mulhilo(__m256i a, __m256i m, __m256i& lo) noexcept {
+    const __m256i pe = _mm256_mul_epu32(a, m);
+    const __m256i po = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+    lo = _mm256_blend_epi32(pe, _mm256_slli_epi64(po, 32), 0xaa);
+    return _mm256_blend_epi32(_mm256_srli_epi64(pe, 32), po, 0xaa);
+}
+
+inline void philox8(__m256i& c0, __m256i& c1, __m256i& c2, __m256i& c3,
+                    const std::uint32_t* key) noexcept {
+    const __m256i m0 = _mm256_set1_epi32(std::int32_t(0xD2511F53u));
+    const __m256i m1 = _mm256_set1_epi32(std::int32_t(0xCD9E8D57u));
+    std::uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; ++round) {
+        __m256i lo0, lo1;
+        const __m256i hi0 = mulhilo(c0, m0, lo0);
+        const __m256i hi1 = mulhilo(c2, m1, lo1);
+        c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(std::int32_t(k0)));
+        c1 = lo1;
+        c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(std::int32_t(k1)));
+        c3 = lo0;
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+}
+
+inline __m256 log8(__m256 x) noexcept {
+    const __m256i b = _mm256_castps_si256(x);
+    __m256i e = _mm256_sub_epi32(_mm256_srli_epi32(b, 23), _mm256_set1_epi32(126));
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(
+        _mm256_and_si256(b, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f000000)));
+    const __m256 lt = _mm256_cmp_ps(m, _mm256_set1_ps(kSqrtHalf), _CMP_LT_OQ);
+    e = _mm256_add_epi32(e, _mm256_castps_si256(lt));  // -1 where m < sqrt(1/2)
+    const __m256 one = _mm256_set1_ps(1.0f);
+    m = _mm256_blendv_ps(_mm256_sub_ps(m, one), _mm256_sub_ps(_mm256_add_ps(m, m), one), lt);
+    const __m256 z = _mm256_mul_ps(m, m);
+    __m256 p = _mm256_set1_ps(kLogP[0]);
+    for (int k = 1; k < 9; ++k) {
+        p = _mm256_add_ps(_mm256_mul_ps(p, m), _mm256_set1_ps(kLogP[k]));
+    }
+    const __m256 fe = _mm256_cvtepi32_ps(e);
+    __m256 y = _mm256_mul_ps(_mm256_mul_ps(m, z), p);
+    y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_set1_ps(kLogQ1), fe));
+    y = _mm256_sub_ps(y, _mm256_mul_ps(_mm256_set1_ps(0.5f), z));
+    const __m256 r = _mm256_add_ps(m, y);
+    return _mm256_add_ps(r, _mm256_mul_ps(_mm256_set1_ps(kLogQ2), fe));
+}
+
+inline __m256 radius8(__m256i w, __m256 sigma) noexcept {
+    const __m256 u = _mm256_mul_ps(
+        _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_srli_epi32(w, 8), _mm256_set1_epi32(1))),
+        _mm256_set1_ps(kTwoPow24));
+    return _mm256_mul_ps(_mm256_sqrt_ps(_mm256_mul_ps(log8(u), _mm256_set1_ps(-2.0f))), sigma);
+}
+
+inline void sincos8(__m256i w, __m256& c, __m256& s) noexcept {
+    const __m256i q = _mm256_srli_epi32(w, 30);
+    const __m256 f = _mm256_mul_ps(
+        _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(w, 8), _mm256_set1_epi32(0x3fffff))),
+        _mm256_set1_ps(kTwoPow22));
+    const __m256 x = _mm256_mul_ps(_mm256_sub_ps(f, _mm256_set1_ps(0.5f)), _mm256_set1_ps(kHalfPi));
+    const __m256 z = _mm256_mul_ps(x, x);
+    __m256 ps = _mm256_set1_ps(kSinP[0]);
+    ps = _mm256_add_ps(_mm256_mul_ps(ps, z), _mm256_set1_ps(kSinP[1]));
+    ps = _mm256_add_ps(_mm256_mul_ps(ps, z), _mm256_set1_ps(kSinP[2]));
+    const __m256 sx = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(ps, z), x), x);
+    __m256 pc = _mm256_set1_ps(kCosP[0]);
+    pc = _mm256_add_ps(_mm256_mul_ps(pc, z), _mm256_set1_ps(kCosP[1]));
+    pc = _mm256_add_ps(_mm256_mul_ps(pc, z), _mm256_set1_ps(kCosP[2]));
+    __m256 cx = _mm256_mul_ps(_mm256_mul_ps(pc, z), z);
+    cx = _mm256_sub_ps(cx, _mm256_mul_ps(_mm256_set1_ps(0.5f), z));
+    cx = _mm256_add_ps(cx, _mm256_set1_ps(1.0f));
+
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256 swap = _mm256_castsi256_ps(
+        _mm256_cmpeq_epi32(_mm256_and_si256(q, one), one));
+    const __m256i neg_c =
+        _mm256_slli_epi32(_mm256_and_si256(_mm256_xor_si256(q, _mm256_srli_epi32(q, 1)), one), 31);
+    const __m256i neg_s = _mm256_slli_epi32(_mm256_srli_epi32(q, 1), 31);
+    c = _mm256_xor_ps(_mm256_blendv_ps(cx, sx, swap), _mm256_castsi256_ps(neg_c));
+    s = _mm256_xor_ps(_mm256_blendv_ps(sx, cx, swap), _mm256_castsi256_ps(neg_s));
+}
+
+/// Unsigned a < b per lane.
+inline __m256i less_u32(__m256i a, __m256i b) noexcept {
+    const __m256i bias = _mm256_set1_epi32(std::int32_t(0x80000000u));
+    return _mm256_cmpgt_epi32(_mm256_xor_si256(b, bias), _mm256_xor_si256(a, bias));
+}
+
+void gaussian_avx2(const std::uint32_t* key, std::uint64_t stream, std::uint64_t counter,
+                   std::size_t blocks, float sigma, const float* in, float* out) {
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i s_lo = _mm256_set1_epi32(std::int32_t(std::uint32_t(stream)));
+    const __m256i s_hi = _mm256_set1_epi32(std::int32_t(std::uint32_t(stream >> 32)));
+    const __m256 vsigma = _mm256_set1_ps(sigma);
+    std::size_t i = 0;
+    for (; i + 8 <= blocks; i += 8) {
+        const std::uint64_t ctr = counter + i;
+        __m256i c0 = _mm256_add_epi32(_mm256_set1_epi32(std::int32_t(std::uint32_t(ctr))), lane);
+        // Lanes whose low word wrapped carry into the high word.
+        __m256i c1 = _mm256_sub_epi32(_mm256_set1_epi32(std::int32_t(std::uint32_t(ctr >> 32))),
+                                      less_u32(c0, lane));
+        __m256i c2 = s_lo;
+        __m256i c3 = s_hi;
+        philox8(c0, c1, c2, c3, key);
+
+        __m256 ca, sa, cb, sb;
+        const __m256 ra = radius8(c0, vsigma);
+        sincos8(c1, ca, sa);
+        const __m256 rb = radius8(c2, vsigma);
+        sincos8(c3, cb, sb);
+        const __m256 are = _mm256_mul_ps(ra, ca), aim = _mm256_mul_ps(ra, sa);
+        const __m256 bre = _mm256_mul_ps(rb, cb), bim = _mm256_mul_ps(rb, sb);
+
+        // Interleave to block order (a.re, a.im, b.re, b.im) per lane. Within
+        // each 128-bit half, p..s hold blocks 4h + 0..3.
+        const __m256 x0 = _mm256_unpacklo_ps(are, aim), x1 = _mm256_unpackhi_ps(are, aim);
+        const __m256 y0 = _mm256_unpacklo_ps(bre, bim), y1 = _mm256_unpackhi_ps(bre, bim);
+        const __m256 p = _mm256_castpd_ps(
+            _mm256_unpacklo_pd(_mm256_castps_pd(x0), _mm256_castps_pd(y0)));
+        const __m256 q = _mm256_castpd_ps(
+            _mm256_unpackhi_pd(_mm256_castps_pd(x0), _mm256_castps_pd(y0)));
+        const __m256 r = _mm256_castpd_ps(
+            _mm256_unpacklo_pd(_mm256_castps_pd(x1), _mm256_castps_pd(y1)));
+        const __m256 t = _mm256_castpd_ps(
+            _mm256_unpackhi_pd(_mm256_castps_pd(x1), _mm256_castps_pd(y1)));
+        __m256 v[4] = {_mm256_permute2f128_ps(p, q, 0x20), _mm256_permute2f128_ps(r, t, 0x20),
+                       _mm256_permute2f128_ps(p, q, 0x31), _mm256_permute2f128_ps(r, t, 0x31)};
+        float* o = out + 4 * i;
+        if (in != nullptr) {
+            const float* x = in + 4 * i;
+            for (int j = 0; j < 4; ++j) {
+                v[j] = _mm256_add_ps(_mm256_loadu_ps(x + 8 * j), v[j]);
+            }
+        }
+        for (int j = 0; j < 4; ++j) {
+            _mm256_storeu_ps(o + 8 * j, v[j]);
+        }
+    }
+    ref_gaussian(key, stream, counter + i, blocks - i, sigma, in != nullptr ? in + 4 * i : nullptr,
+                 out + 4 * i);
+}
+
+void fir_avx2(const float* taps, std::size_t n_taps, const float* xr, const float* xi,
+              std::size_t n, float* yr, float* yi) {
+    ref_fir(taps, n_taps, xr, xi, n, yr, yi);
+}
+
+}  // namespace
+
+const ChannelKernels channel_avx2 = {gaussian_avx2, fir_avx2};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,167 @@
+// AVX-512 Gaussian noise: sixteen Philox blocks, 32 complex samples, per
+// iteration. Same structure as channel_avx2.cpp with mask registers for
+// the selects; bit-identical to the reference.
+
+#include <immintrin.h>
+
+#include "channel_kernels.hpp"
+#include "channel_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+inline __m512i mulhilo(__m512i a, __m512i m, __m512i& lo) noexcept {
+    const __m512i pe = _mm512_mul_epu32(a, m);
+    const __m512i po = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), m);
+    lo = _mm512_mask_blend_epi32(0xaaaa, pe, _mm512_slli_epi64(po, 32));
+    return _mm512_mask_blend_epi32(0xaaaa, _mm512_srli_epi64(pe, 32), po);
+}
+
+inline void philox16(__m512i& c0, __m512i& c1, __m512i& c2, __m512i& c3,
+                     const std::uint32_t* key) noexcept {
+    const __m512i m0 = _mm512_set1_epi32(std::int32_t(0xD2511F53u));
+    const __m512i m1 = _mm512_set1_epi32(std::int32_t(0xCD9E8D57u));
+    std::uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; ++round) {
+        __m512i lo0, lo1;
+        const __m512i hi0 = mulhilo(c0, m0, lo0);
+        const __m512i hi1 = mulhilo(c2, m1, lo1);
+        c0 = _mm512_xor_si512(_mm512_xor_si512(hi1, c1), _mm512_set1_epi32(std::int32_t(k0)));
+        c1 = lo1;
+        c2 = _mm512_xor_si512(_mm512_xor_si512(hi0, c3), _mm512_set1_epi32(std::int32_t(k1)));
+        c3 = lo0;
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+}
+
+inline __m512 log16(__m512 x) noexcept {
+    const __m512i b = _mm512_castps_si512(x);
+    __m512i e = _mm512_sub_epi32(_mm512_srli_epi32(b, 23), _mm512_set1_epi32(126));
+    __m512 m = _mm512_castsi512_ps(_mm512_or_si512(
+        _mm512_and_si512(b, _mm512_set1_epi32(0x007fffff)), _mm512_set1_epi32(0x3f000000)));
+    const __mmask16 lt = _mm512_cmp_ps_mask(m, _mm512_set1_ps(kSqrtHalf), _CMP_LT_OQ);
+    e = _mm512_mask_sub_epi32(e, lt, e, _mm512_set1_epi32(1));
+    const __m512 one = _mm512_set1_ps(1.0f);
+    m = _mm512_mask_blend_ps(lt, _mm512_sub_ps(m, one),
+                             _mm512_sub_ps(_mm512_add_ps(m, m), one));
+    const __m512 z = _mm512_mul_ps(m, m);
+    __m512 p = _mm512_set1_ps(kLogP[0]);
+    for (int k = 1; k < 9; ++k) {
+        p = _mm512_add_ps(_mm512_mul_ps(p, m), _mm512_set1_ps(kLogP[k]));
+    }
+    const __m512 fe = _mm512_cvtepi32_ps(e);
+    __m512 y = _mm512_mul_ps(_mm512_mul_ps(m, z), p);
+    y = _mm512_add_ps(y, _mm512_mul_ps(_mm512_set1_ps(kLogQ1), fe));
+    y = _mm512_sub_ps(y, _mm512_mul_ps(_mm512_set1_ps(0.5f), z));
+    const __m512 r = _mm512_add_ps(m, y);
+    return _mm512_add_ps(r, _mm512_mul_ps(_mm512_set1_ps(kLogQ2), fe));
+}
+
+inline __m512 radius16(__m512i w, __m512 sigma) noexcept {
+    const __m512 u = _mm512_mul_ps(
+        _mm512_cvtepi32_ps(_mm512_add_epi32(_mm512_srli_epi32(w, 8), _mm512_set1_epi32(1))),
+        _mm512_set1_ps(kTwoPow24));
+    return _mm512_mul_ps(_mm512_sqrt_ps(_mm512_mul_ps(log16(u), _mm512_set1_ps(-2.0f))), sigma);
+}
+
+inline void sincos16(__m512i w, __m512& c, __m512& s) noexcept {
+    const __m512i q = _mm512_srli_epi32(w, 30);
+    const __m512 f = _mm512_mul_ps(
+        _mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(w, 8), _mm512_set1_epi32(0x3fffff))),
+        _mm512_set1_ps(kTwoPow22));
+    const __m512 x = _mm512_mul_ps(_mm512_sub_ps(f, _mm512_set1_ps(0.5f)), _mm512_set1_ps(kHalfPi));
+    const __m512 z = _mm512_mul_ps(x, x);
+    __m512 ps = _mm512_set1_ps(kSinP[0]);
+    ps = _mm512_add_ps(_mm512_mul_ps(ps, z), _mm512_set1_ps(kSinP[1]));
+    ps = _mm512_add_ps(_mm512_mul_ps(ps, z), _mm512_set1_ps(kSinP[2]));
+    const __m512 sx = _mm512_add_ps(_mm512_mul_ps(_mm512_mul_ps(ps, z), x), x);
+    __m512 pc = _mm512_set1_ps(kCosP[0]);
+    pc = _mm512_add_ps(_mm512_mul_ps(pc, z), _mm512_set1_ps(kCosP[1]));
+    pc = _mm512_add_ps(_mm512_mul_ps(pc, z), _mm512_set1_ps(kCosP[2]));
+    __m512 cx = _mm512_mul_ps(_mm512_mul_ps(pc, z), z);
+    cx = _mm512_sub_ps(cx, _mm512_mul_ps(_mm512_set1_ps(0.5f), z));
+    cx = _mm512_add_ps(cx, _mm512_set1_ps(1.0f));
+
+    const __m512i one = _mm512_set1_epi32(1);
+    const __mmask16 swap = _mm512_test_epi32_mask(q, one);
+    const __m512i neg_c =
+        _mm512_slli_epi32(_mm512_and_si512(_mm512_xor_si512(q, _mm512_srli_epi32(q, 1)), one), 31);
+    const __m512i neg_s = _mm512_slli_epi32(_mm512_srli_epi32(q, 1), 31);
+    c = _mm512_castsi512_ps(_mm512_xor_si512(
+        _mm512_castps_si512(_mm512_mask_blend_ps(swap, cx, sx)), neg_c));
+    s = _mm512_castsi512_ps(_mm512_xor_si512(
+        _mm512_castps_si512(_mm512_mask_blend_ps(swap, sx, cx)), neg_s));
+}
+
+void gaussian_avx512(const std::uint32_t* key, std::uint64_t stream, std::uint64_t counter,
+                     std::size_t blocks, float sigma, const float* in, float* out) {
+    const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m512i s_lo = _mm512_set1_epi32(std::int32_t(std::uint32_t(stream)));
+    const __m512i s_hi = _mm512_set1_epi32(std::int32_t(std::uint32_t(stream >> 32)));
+    const __m512 vsigma = _mm512_set1_ps(sigma);
+    std::size_t i = 0;
+    for (; i + 16 <= blocks; i += 16) {
+        const std::uint64_t ctr = counter + i;
+        __m512i c0 = _mm512_add_epi32(_mm512_set1_epi32(std::int32_t(std::uint32_t(ctr))), lane);
+        const __mmask16 wrapped = _mm512_cmplt_epu32_mask(c0, lane);
+        const __m512i hi = _mm512_set1_epi32(std::int32_t(std::uint32_t(ctr >> 32)));
+        __m512i c1 = _mm512_mask_add_epi32(hi, wrapped, hi, _mm512_set1_epi32(1));
+        __m512i c2 = s_lo;
+        __m512i c3 = s_hi;
+        philox16(c0, c1, c2, c3, key);
+
+        __m512 ca, sa, cb, sb;
+        const __m512 ra = radius16(c0, vsigma);
+        sincos16(c1, ca, sa);
+        const __m512 rb = radius16(c2, vsigma);
+        sincos16(c3, cb, sb);
+        const __m512 are = _mm512_mul_ps(ra, ca), aim = _mm512_mul_ps(ra, sa);
+        const __m512 bre = _mm512_mul_ps(rb, cb), bim = _mm512_mul_ps(rb, sb);
+
+        // Within each 128-bit lane k, p..t hold blocks 4k + 0..3; the
+        // 128-bit shuffles then gather blocks 4j..4j+3 into vector j.
+        const __m512 x0 = _mm512_unpacklo_ps(are, aim), x1 = _mm512_unpackhi_ps(are, aim);
+        const __m512 y0 = _mm512_unpacklo_ps(bre, bim), y1 = _mm512_unpackhi_ps(bre, bim);
+        const __m512 p = _mm512_castpd_ps(
+            _mm512_unpacklo_pd(_mm512_castps_pd(x0), _mm512_castps_pd(y0)));
+        const __m512 q = _mm512_castpd_ps(
+            _mm512_unpackhi_pd(_mm512_castps_pd(x0), _mm512_castps_pd(y0)));
+        const __m512 r = _mm512_castpd_ps(
+            _mm512_unpacklo_pd(_mm512_castps_pd(x1), _mm512_castps_pd(y1)));
+        const __m512 t = _mm512_castpd_ps(
+            _mm512_unpackhi_pd(_mm512_castps_pd(x1), _mm512_castps_pd(y1)));
+        const __m512 pq_lo = _mm512_shuffle_f32x4(p, q, 0x44);  // p0 p1 q0 q1
+        const __m512 rt_lo = _mm512_shuffle_f32x4(r, t, 0x44);
+        const __m512 pq_hi = _mm512_shuffle_f32x4(p, q, 0xee);  // p2 p3 q2 q3
+        const __m512 rt_hi = _mm512_shuffle_f32x4(r, t, 0xee);
+        __m512 v[4] = {_mm512_shuffle_f32x4(pq_lo, rt_lo, 0x88),
+                       _mm512_shuffle_f32x4(pq_lo, rt_lo, 0xdd),
+                       _mm512_shuffle_f32x4(pq_hi, rt_hi, 0x88),
+                       _mm512_shuffle_f32x4(pq_hi, rt_hi, 0xdd)};
+        float* o = out + 4 * i;
+        if (in != nullptr) {
+            const float* x = in + 4 * i;
+            for (int j = 0; j < 4; ++j) {
+                v[j] = _mm512_add_ps(_mm512_loadu_ps(x + 16 * j), v[j]);
+            }
+        }
+        for (int j = 0; j < 4; ++j) {
+            _mm512_storeu_ps(o + 16 * j, v[j]);
+        }
+    }
+    ref_gaussian(key, stream, counter + i, blocks - i, sigma, in != nullptr ? in + 4 * i : nullptr,
+                 out + 4 * i);
+}
+
+void fir_avx512(const float* taps, std::size_t n_taps, const float* xr, const float* xi,
+              std::size_t n, float* yr, float* yi) {
+    ref_fir(taps, n_taps, xr, xi, n, yr, yi);
+}
+
+}  // namespace
+
+const ChannelKernels channel_avx512 = {gaussian_avx512, fir_avx512};
+
+}  // namespace dcomm::kernels
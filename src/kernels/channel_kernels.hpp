@@ -0,0 +1,43 @@
+#pragma once
+
+// Per-ISA kernels behind GaussianNoise and FadingChannel.
+//
+// Noise is a pure function of the Philox counter: counter block i of the
+// stream yields out[4i..4i+3], two complex samples. The first word of the
+// block sets the radius sqrt(-2 ln u) of sample 0 and the second its
+// angle, the third and fourth do the same for sample 1 (Box-Muller).
+// Vector kernels run one Philox block per lane and evaluate log, sin and
+// cos with the same polynomials, in the same operation order, as the
+// reference, so every variant produces bit-identical noise.
+//
+// The fading FIR runs tap by tap over contiguous split re/im samples; it is
+// the reference loop in every variant, vectorised by the compiler under
+// each translation unit's ISA flags.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dcomm::kernels {
+
+struct ChannelKernels {
+    /// Noise of per-component standard deviation `sigma` for `blocks`
+    /// counter blocks starting at `counter`, written to out (4 floats per
+    /// block). With `in` set the noise is added to it; in may equal out.
+    void (*gaussian)(const std::uint32_t* key, std::uint64_t stream, std::uint64_t counter,
+                     std::size_t blocks, float sigma, const float* in, float* out);
+    /// y[i] = sum_k taps[k] * x[i - k] for i < n over split re/im arrays;
+    /// x points at sample 0 with n_taps - 1 samples of history before it.
+    void (*fir)(const float* taps, std::size_t n_taps, const float* xr, const float* xi,
+                std::size_t n, float* yr, float* yi);
+};
+
+extern const ChannelKernels channel_scalar;
+#if defined(DCOMM_KERNELS_X86)
+extern const ChannelKernels channel_avx2;
+extern const ChannelKernels channel_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+extern const ChannelKernels channel_neon;
+#endif
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,138 @@
+// NEON Gaussian noise for AArch64: four Philox blocks, eight complex
+// samples, per iteration. vmull_u32 gives the Philox products, and vst4q /
+// vld4q do the interleaving the x86 kernels need shuffles for. Same
+// polynomials and operation order as channel_ref.hpp.
+
+#include <arm_neon.h>
+
+#include "channel_kernels.hpp"
+#include "channel_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+inline uint32x4_t mulhilo(uint32x4_t a, uint32x4_t m, uint32x4_t& lo) noexcept {
+    const uint32x4_t p01 = vreinterpretq_u32_u64(vmull_u32(vget_low_u32(a), vget_low_u32(m)));
+    const uint32x4_t p23 = vreinterpretq_u32_u64(vmull_high_u32(a, m));
+    lo = vuzp1q_u32(p01, p23);
+    return vuzp2q_u32(p01, p23);
+}
+
+inline void philox4(uint32x4_t& c0, uint32x4_t& c1, uint32x4_t& c2, uint32x4_t& c3,
+                    const std::uint32_t* key) noexcept {
+    const uint32x4_t m0 = vdupq_n_u32(0xD2511F53u);
+    const uint32x4_t m1 = vdupq_n_u32(0xCD9E8D57u);
+    std::uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; ++round) {
+        uint32x4_t lo0, lo1;
+        const uint32x4_t hi0 = mulhilo(c0, m0, lo0);
+        const uint32x4_t hi1 = mulhilo(c2, m1, lo1);
+        c0 = veorq_u32(veorq_u32(hi1, c1), vdupq_n_u32(k0));
+        c1 = lo1;
+        c2 = veorq_u32(veorq_u32(hi0, c3), vdupq_n_u32(k1));
+        c3 = lo0;
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+}
+
+inline float32x4_t log4(float32x4_t x) noexcept {
+    const uint32x4_t b = vreinterpretq_u32_f32(x);
+    int32x4_t e = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(b, 23)), vdupq_n_s32(126));
+    float32x4_t m = vreinterpretq_f32_u32(
+        vorrq_u32(vandq_u32(b, vdupq_n_u32(0x007fffffu)), vdupq_n_u32(0x3f000000u)));
+    const uint32x4_t lt = vcltq_f32(m, vdupq_n_f32(kSqrtHalf));
+    e = vaddq_s32(e, vreinterpretq_s32_u32(lt));  // -1 where m < sqrt(1/2)
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    m = vbslq_f32(lt, vsubq_f32(vaddq_f32(m, m), one), vsubq_f32(m, one));
+    const float32x4_t z = vmulq_f32(m, m);
+    float32x4_t p = vdupq_n_f32(kLogP[0]);
+    for (int k = 1; k < 9; ++k) {
+        p = vaddq_f32(vmulq_f32(p, m), vdupq_n_f32(kLogP[k]));
+    }
+    const float32x4_t fe = vcvtq_f32_s32(e);
+    float32x4_t y = vmulq_f32(vmulq_f32(m, z), p);
+    y = vaddq_f32(y, vmulq_f32(vdupq_n_f32(kLogQ1), fe));
+    y = vsubq_f32(y, vmulq_f32(vdupq_n_f32(0.5f), z));
+    const float32x4_t r = vaddq_f32(m, y);
+    return vaddq_f32(r, vmulq_f32(vdupq_n_f32(kLogQ2), fe));
+}
+
+inline float32x4_t radius4(uint32x4_t w, float32x4_t sigma) noexcept {
+    const float32x4_t u = vmulq_f32(vcvtq_f32_u32(vaddq_u32(vshrq_n_u32(w, 8), vdupq_n_u32(1))),
+                                    vdupq_n_f32(kTwoPow24));
+    return vmulq_f32(vsqrtq_f32(vmulq_f32(log4(u), vdupq_n_f32(-2.0f))), sigma);
+}
+
+inline void sincos4(uint32x4_t w, float32x4_t& c, float32x4_t& s) noexcept {
+    const uint32x4_t q = vshrq_n_u32(w, 30);
+    const float32x4_t f = vmulq_f32(
+        vcvtq_f32_u32(vandq_u32(vshrq_n_u32(w, 8), vdupq_n_u32(0x3fffffu))),
+        vdupq_n_f32(kTwoPow22));
+    const float32x4_t x = vmulq_f32(vsubq_f32(f, vdupq_n_f32(0.5f)), vdupq_n_f32(kHalfPi));
+    const float32x4_t z = vmulq_f32(x, x);
+    float32x4_t ps = vdupq_n_f32(kSinP[0]);
+    ps = vaddq_f32(vmulq_f32(ps, z), vdupq_n_f32(kSinP[1]));
+    ps = vaddq_f32(vmulq_f32(ps, z), vdupq_n_f32(kSinP[2]));
+    const float32x4_t sx = vaddq_f32(vmulq_f32(vmulq_f32(ps, z), x), x);
+    float32x4_t pc = vdupq_n_f32(kCosP[0]);
+    pc = vaddq_f32(vmulq_f32(pc, z), vdupq_n_f32(kCosP[1]));
+    pc = vaddq_f32(vmulq_f32(pc, z), vdupq_n_f32(kCosP[2]));
+    float32x4_t cx = vmulq_f32(vmulq_f32(pc, z), z);
+    cx = vsubq_f32(cx, vmulq_f32(vdupq_n_f32(0.5f), z));
+    cx = vaddq_f32(cx, vdupq_n_f32(1.0f));
+
+    const uint32x4_t one = vdupq_n_u32(1);
+    const uint32x4_t swap = vtstq_u32(q, one);
+    const uint32x4_t neg_c = vshlq_n_u32(vandq_u32(veorq_u32(q, vshrq_n_u32(q, 1)), one), 31);
+    const uint32x4_t neg_s = vshlq_n_u32(vshrq_n_u32(q, 1), 31);
+    c = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, sx, cx)), neg_c));
+    s = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, cx, sx)), neg_s));
+}
+
+void gaussian_neon(const std::uint32_t* key, std::uint64_t stream, std::uint64_t counter,
+                   std::size_t blocks, float sigma, const float* in, float* out) {
+    const uint32x4_t lane = {0, 1, 2, 3};
+    const uint32x4_t s_lo = vdupq_n_u32(std::uint32_t(stream));
+    const uint32x4_t s_hi = vdupq_n_u32(std::uint32_t(stream >> 32));
+    const float32x4_t vsigma = vdupq_n_f32(sigma);
+    std::size_t i = 0;
+    for (; i + 4 <= blocks; i += 4) {
+        const std::uint64_t ctr = counter + i;
+        uint32x4_t c0 = vaddq_u32(vdupq_n_u32(std::uint32_t(ctr)), lane);
+        // Lanes whose low word wrapped carry into the high word (mask = -1).
+        uint32x4_t c1 = vsubq_u32(vdupq_n_u32(std::uint32_t(ctr >> 32)), vcltq_u32(c0, lane));
+        uint32x4_t c2 = s_lo;
+        uint32x4_t c3 = s_hi;
+        philox4(c0, c1, c2, c3, key);
+
+        float32x4_t ca, sa, cb, sb;
+        const float32x4_t ra = radius4(c0, vsigma);
+        sincos4(c1, ca, sa);
+        const float32x4_t rb = radius4(c2, vsigma);
+        sincos4(c3, cb, sb);
+        float32x4x4_t v = {{vmulq_f32(ra, ca), vmulq_f32(ra, sa), vmulq_f32(rb, cb),
+                            vmulq_f32(rb, sb)}};
+        if (in != nullptr) {
+            const float32x4x4_t x = vld4q_f32(in + 4 * i);
+            for (int j = 0; j < 4; ++j) {
+                v.val[j] = vaddq_f32(x.val[j], v.val[j]);
+            }
+        }
+        vst4q_f32(out + 4 * i, v);
+    }
+    ref_gaussian(key, stream, counter + i, blocks - i, sigma, in != nullptr ? in + 4 * i : nullptr,
+                 out + 4 * i);
+}
+
+void fir_neon(const float* taps, std::size_t n_taps, const float* xr, const float* xi,
+              std::size_t n, float* yr, float* yi) {
+    ref_fir(taps, n_taps, xr, xi, n, yr, yi);
+}
+
+}  // namespace
+
+const ChannelKernels channel_neon = {gaussian_neon, fir_neon};
+
+}  // namespace dcomm::kernels
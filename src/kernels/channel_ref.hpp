@@ -0,0 +1,134 @@
+#pragma once
+
+// Scalar reference Gaussian noise kernel (see channel_kernels.hpp for the
+// contract). The log and sincos polynomials are the Cephes single
+// precision ones; vector kernels repeat every operation below in the same
+// order, and the build disables FMA contraction, so results match bit for
+// bit. Internal linkage: every kernel translation unit includes this for
+// its tail.
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "dcomm/philox.hpp"
+
+namespace dcomm::kernels {
+namespace {
+
+constexpr float kSqrtHalf = 0.707106781186547524f;
+constexpr float kLogP[9] = {7.0376836292e-2f,  -1.1514610310e-1f, 1.1676998740e-1f,
+                            -1.2420140846e-1f, 1.4249322787e-1f,  -1.6668057665e-1f,
+                            2.0000714765e-1f,  -2.4999993993e-1f, 3.3333331174e-1f};
+constexpr float kLogQ1 = -2.12194440e-4f;
+constexpr float kLogQ2 = 0.693359375f;
+constexpr float kSinP[3] = {-1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f};
+constexpr float kCosP[3] = {2.443315711809948e-5f, -1.388731625493765e-3f,
+                            4.166664568298827e-2f};
+constexpr float kHalfPi = 1.57079632679489662f;
+constexpr float kTwoPow24 = 1.0f / 16777216.0f;
+constexpr float kTwoPow22 = 1.0f / 4194304.0f;
+
+/// ln(x) for x in (0, 1].
+inline float ref_log(float x) noexcept {
+    const std::uint32_t b = std::bit_cast<std::uint32_t>(x);
+    std::int32_t e = std::int32_t(b >> 23) - 126;
+    float m = std::bit_cast<float>((b & 0x007fffffu) | 0x3f000000u);  // [0.5, 1)
+    if (m < kSqrtHalf) {
+        e -= 1;
+        m = (m + m) - 1.0f;
+    } else {
+        m = m - 1.0f;
+    }
+    const float z = m * m;
+    float p = kLogP[0];
+    for (int k = 1; k < 9; ++k) {
+        p = p * m + kLogP[k];
+    }
+    const float fe = float(e);
+    float y = (m * z) * p;
+    y = y + kLogQ1 * fe;
+    y = y - 0.5f * z;
+    float r = m + y;
+    r = r + kLogQ2 * fe;
+    return r;
+}
+
+/// Box-Muller radius of uniform word `w`, scaled by `sigma`.
+inline float ref_radius(std::uint32_t w, float sigma) noexcept {
+    const float u = float((w >> 8) + 1) * kTwoPow24;  // (0, 1]
+    return std::sqrt(ref_log(u) * -2.0f) * sigma;
+}
+
+/// cos and sin of the angle of uniform word `w`. The top two bits pick the
+/// quadrant and the next 22 the offset x in [-pi/4, pi/4) within it, so
+/// the polynomials only ever see their accurate range.
+inline void ref_sincos(std::uint32_t w, float& c, float& s) noexcept {
+    const std::uint32_t q = w >> 30;
+    const float f = float((w >> 8) & 0x3fffffu) * kTwoPow22;
+    const float x = (f - 0.5f) * kHalfPi;
+    const float z = x * x;
+    float ps = kSinP[0];
+    ps = ps * z + kSinP[1];
+    ps = ps * z + kSinP[2];
+    const float sx = ((ps * z) * x) + x;
+    float pc = kCosP[0];
+    pc = pc * z + kCosP[1];
+    pc = pc * z + kCosP[2];
+    float cx = (pc * z) * z;
+    cx = cx - 0.5f * z;
+    cx = cx + 1.0f;
+    // Rotate by q quarter turns.
+    c = (q & 1u) != 0 ? sx : cx;
+    s = (q & 1u) != 0 ? cx : sx;
+    if (((q ^ (q >> 1)) & 1u) != 0) {
+        c = -c;
+    }
+    if (q >= 2) {
+        s = -s;
+    }
+}
+
+inline void ref_gaussian(const std::uint32_t* key, std::uint64_t stream, std::uint64_t counter,
+                         std::size_t blocks, float sigma, const float* in, float* out) noexcept {
+    const Philox4x32::Key k = {key[0], key[1]};
+    for (std::size_t i = 0; i < blocks; ++i) {
+        const std::uint64_t ctr = counter + i;
+        const Philox4x32::Block w = Philox4x32::generate(
+            {std::uint32_t(ctr), std::uint32_t(ctr >> 32), std::uint32_t(stream),
+             std::uint32_t(stream >> 32)},
+            k);
+        float v[4];
+        for (int j = 0; j < 2; ++j) {
+            float c, s;
+            const float a = ref_radius(w[2 * j], sigma);
+            ref_sincos(w[2 * j + 1], c, s);
+            v[2 * j] = a * c;
+            v[2 * j + 1] = a * s;
+        }
+        for (int j = 0; j < 4; ++j) {
+            out[4 * i + j] = in != nullptr ? in[4 * i + j] + v[j] : v[j];
+        }
+    }
+}
+
+inline void ref_fir(const float* taps, std::size_t n_taps, const float* xr, const float* xi,
+                    std::size_t n, float* yr, float* yi) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        yr[i] = 0.0f;
+        yi[i] = 0.0f;
+    }
+    for (std::size_t k = 0; k < n_taps; ++k) {
+        const float tr = taps[2 * k], ti = taps[2 * k + 1];
+        const float* __restrict ar = xr - k;
+        const float* __restrict ai = xi - k;
+        for (std::size_t i = 0; i < n; ++i) {
+            yr[i] += ar[i] * tr - ai[i] * ti;
+            yi[i] += ar[i] * ti + ai[i] * tr;
+        }
+    }
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
@@ -0,0 +1,22 @@
+#include "channel_kernels.hpp"
+#include "channel_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void gaussian_scalar(const std::uint32_t* key, std::uint64_t stream, std::uint64_t counter,
+                     std::size_t blocks, float sigma, const float* in, float* out) {
+    ref_gaussian(key, stream, counter, blocks, sigma, in, out);
+}
+
+void fir_scalar(const float* taps, std::size_t n_taps, const float* xr, const float* xi,
+                std::size_t n, float* yr, float* yi) {
+    ref_fir(taps, n_taps, xr, xi, n, yr, yi);
+}
+
+}  // namespace
+
+const ChannelKernels channel_scalar = {gaussian_scalar, fir_scalar};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,43 @@
+#pragma once
+
+// Per-ISA kernels behind the complex_layout.hpp element-wise functions.
+//
+// Interleaved data is re, im, re, im, ... floats; split data is a plane of
+// re floats and a plane of im floats. Each kernel is the reference loop in
+// every variant, vectorised by the compiler under the translation unit's
+// ISA flags: for interleaved products that means duplicating re and im
+// lanes and an add-subtract, for split ones plain multiplies. Nothing is
+// reassociated and the build disables FMA contraction, so all variants,
+// and both layouts, agree bit for bit. Outputs may be the same buffer as
+// an input but must not otherwise overlap it.
+
+#include <cstddef>
+
+namespace dcomm::kernels {
+
+struct ComplexKernels {
+    /// re[i] = x[2i], im[i] = x[2i + 1] for i < n.
+    void (*deinterleave)(const float* x, std::size_t n, float* re, float* im);
+    /// x[2i] = re[i], x[2i + 1] = im[i] for i < n.
+    void (*interleave)(const float* re, const float* im, std::size_t n, float* x);
+    /// out = a * b, or a * conj(b) when `conj`, over n interleaved samples.
+    void (*multiply)(const float* a, const float* b, std::size_t n, bool conj, float* out);
+    /// The same over split samples.
+    void (*multiply_split)(const float* ar, const float* ai, const float* br, const float* bi,
+                           std::size_t n, bool conj, float* out_re, float* out_im);
+    /// out[i] = re^2 + im^2 of n interleaved samples.
+    void (*magnitude_squared)(const float* x, std::size_t n, float* out);
+    void (*magnitude_squared_split)(const float* re, const float* im, std::size_t n,
+                                    float* out);
+};
+
+extern const ComplexKernels complex_scalar;
+#if defined(DCOMM_KERNELS_X86)
+extern const ComplexKernels complex_avx2;
+extern const ComplexKernels complex_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+extern const ComplexKernels complex_neon;
+#endif
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,51 @@
+// NEON complex layout kernels: the reference loops, four floats per
+// instruction; interleaved data goes through ld2 / st2.
+
+#include "complex_kernels.hpp"
+#include "complex_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void deinterleave_neon(const float* x, std::size_t n, float* re, float* im) {
+    ref_deinterleave(x, n, re, im);
+}
+
+void interleave_neon(const float* re, const float* im, std::size_t n, float* x) {
+    ref_interleave(re, im, n, x);
+}
+
+void multiply_neon(const float* a, const float* b, std::size_t n, bool conj, float* out) {
+    if (conj) {
+        ref_multiply<true>(a, b, n, out);
+    } else {
+        ref_multiply<false>(a, b, n, out);
+    }
+}
+
+void multiply_split_neon(const float* ar, const float* ai, const float* br, const float* bi,
+                         std::size_t n, bool conj, float* out_re, float* out_im) {
+    if (conj) {
+        ref_multiply_split<true>(ar, ai, br, bi, n, out_re, out_im);
+    } else {
+        ref_multiply_split<false>(ar, ai, br, bi, n, out_re, out_im);
+    }
+}
+
+void magnitude_squared_neon(const float* x, std::size_t n, float* out) {
+    ref_magnitude_squared(x, n, out);
+}
+
+void magnitude_squared_split_neon(const float* re, const float* im, std::size_t n, float* out) {
+    ref_magnitude_squared_split(re, im, n, out);
+}
+
+}  // namespace
+
+const ComplexKernels complex_neon = {
+    deinterleave_neon, interleave_neon, multiply_neon, multiply_split_neon,
+    magnitude_squared_neon, magnitude_squared_split_neon,
+};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,71 @@
+#pragma once
+
+// Reference complex layout kernels (see complex_kernels.hpp for the
+// contract). Both layouts form re = ar br - ai bi and im = ar bi + ai br,
+// with conj(b) taken by negating bi first, which is exact. Internal
+// linkage: every kernel translation unit includes this and compiles it for
+// its own ISA.
+
+#include <cstddef>
+
+#include "complex_kernels.hpp"
+
+namespace dcomm::kernels {
+namespace {
+
+inline void ref_deinterleave(const float* x, std::size_t n, float* re, float* im) noexcept {
+#pragma GCC ivdep
+    for (std::size_t i = 0; i < n; ++i) {
+        re[i] = x[2 * i];
+        im[i] = x[2 * i + 1];
+    }
+}
+
+inline void ref_interleave(const float* re, const float* im, std::size_t n, float* x) noexcept {
+#pragma GCC ivdep
+    for (std::size_t i = 0; i < n; ++i) {
+        x[2 * i] = re[i];
+        x[2 * i + 1] = im[i];
+    }
+}
+
+template <bool Conj>
+void ref_multiply(const float* a, const float* b, std::size_t n, float* out) noexcept {
+#pragma GCC ivdep
+    for (std::size_t i = 0; i < n; ++i) {
+        const float ar = a[2 * i], ai = a[2 * i + 1];
+        const float br = b[2 * i], bi = Conj ? -b[2 * i + 1] : b[2 * i + 1];
+        out[2 * i] = ar * br - ai * bi;
+        out[2 * i + 1] = ar * bi + ai * br;
+    }
+}
+
+template <bool Conj>
+void ref_multiply_split(const float* ar, const float* ai, const float* br, const float* bi,
+                        std::size_t n, float* out_re, float* out_im) noexcept {
+#pragma GCC ivdep
+    for (std::size_t i = 0; i < n; ++i) {
+        const float r = ar[i], m = ai[i];
+        const float s = br[i], t = Conj ? -bi[i] : bi[i];
+        out_re[i] = r * s - m * t;
+        out_im[i] = r * t + m * s;
+    }
+}
+
+inline void ref_magnitude_squared(const float* x, std::size_t n, float* out) noexcept {
+#pragma GCC ivdep
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = x[2 * i] * x[2 * i] + x[2 * i + 1] * x[2 * i + 1];
+    }
+}
+
+inline void ref_magnitude_squared_split(const float* re, const float* im, std::size_t n,
+                                        float* out) noexcept {
+#pragma GCC ivdep
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = re[i] * re[i] + im[i] * im[i];
+    }
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
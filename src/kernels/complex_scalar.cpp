@@ -0,0 +1,48 @@
+#include "complex_kernels.hpp"
+#include "complex_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void deinterleave_scalar(const float* x, std::size_t n, float* re, float* im) {
+    ref_deinterleave(x, n, re, im);
+}
+
+void interleave_scalar(const float* re, const float* im, std::size_t n, float* x) {
+    ref_interleave(re, im, n, x);
+}
+
+void multiply_scalar(const float* a, const float* b, std::size_t n, bool conj, float* out) {
+    if (conj) {
+        ref_multiply<true>(a, b, n, out);
+    } else {
+        ref_multiply<false>(a, b, n, out);
+    }
+}
+
+void multiply_split_scalar(const float* ar, const float* ai, const float* br, const float* bi,
+                           std::size_t n, bool conj, float* out_re, float* out_im) {
+    if (conj) {
+        ref_multiply_split<true>(ar, ai, br, bi, n, out_re, out_im);
+    } else {
+        ref_multiply_split<false>(ar, ai, br, bi, n, out_re, out_im);
+    }
+}
+
+void magnitude_squared_scalar(const float* x, std::size_t n, float* out) {
+    ref_magnitude_squared(x, n, out);
+}
+
+void magnitude_squared_split_scalar(const float* re, const float* im, std::size_t n, float* out) {
+    ref_magnitude_squared_split(re, im, n, out);
+}
+
+}  // namespace
+
+const ComplexKernels complex_scalar = {
+    deinterleave_scalar, interleave_scalar, multiply_scalar, multiply_split_scalar,
+    magnitude_squared_scalar, magnitude_squared_split_scalar,
+};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,87 @@
+// PCLMULQDQ CRC folding (see crc_kernels.hpp): four 128-bit accumulators
+// take 64 bytes per step, two carry-less multiplies each, then combine
+// into one and take the remaining blocks one at a time. Compiled with
+// -mpclmul on top of the AVX2 flags; crc.cpp only picks it when the CPU
+// reports PCLMULQDQ.
+
+#include <immintrin.h>
+
+#include "crc_kernels.hpp"
+#include "crc_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+/// Below this the tables are faster than setting up the fold.
+constexpr std::size_t kFoldMin = 64;
+
+inline __m128i multipliers(const CrcFold& f) noexcept {
+    return _mm_set_epi64x(std::int64_t(f.hi), std::int64_t(f.lo));
+}
+
+/// x moved ahead by the distance of k.
+inline __m128i fold(__m128i x, __m128i k) noexcept {
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+template <bool Reflected>
+inline __m128i order(__m128i v) noexcept {
+    if constexpr (Reflected) {
+        return v;
+    } else {
+        // MSB-first: the first byte holds the highest coefficients.
+        return _mm_shuffle_epi8(
+            v, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    }
+}
+
+template <bool Reflected>
+inline __m128i load(const std::uint8_t* p) noexcept {
+    return order<Reflected>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+template <bool Reflected>
+std::uint32_t update_pclmul(const CrcConstants& c, std::uint32_t reg, const std::uint8_t* p,
+                            std::size_t n) noexcept {
+    if (n < kFoldMin) {
+        return ref_crc_update(c, reg, p, n);
+    }
+    // The register enters as an XOR onto the first four message bytes.
+    const __m128i r = _mm_cvtsi32_si128(std::int32_t(Reflected ? reg : __builtin_bswap32(reg)));
+    __m128i x0 = order<Reflected>(
+        _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), r));
+    __m128i x1 = load<Reflected>(p + 16);
+    __m128i x2 = load<Reflected>(p + 32);
+    __m128i x3 = load<Reflected>(p + 48);
+    p += 64;
+    n -= 64;
+    const __m128i k512 = multipliers(c.fold512);
+    for (; n >= 64; p += 64, n -= 64) {
+        x0 = _mm_xor_si128(fold(x0, k512), load<Reflected>(p));
+        x1 = _mm_xor_si128(fold(x1, k512), load<Reflected>(p + 16));
+        x2 = _mm_xor_si128(fold(x2, k512), load<Reflected>(p + 32));
+        x3 = _mm_xor_si128(fold(x3, k512), load<Reflected>(p + 48));
+    }
+    const __m128i k128 = multipliers(c.fold128);
+    __m128i x = _mm_xor_si128(_mm_xor_si128(fold(x0, multipliers(c.fold384)),
+                                            fold(x1, multipliers(c.fold256))),
+                              _mm_xor_si128(fold(x2, k128), x3));
+    for (; n >= 16; p += 16, n -= 16) {
+        x = _mm_xor_si128(fold(x, k128), load<Reflected>(p));
+    }
+    alignas(16) std::uint8_t block[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(block), order<Reflected>(x));
+    return ref_crc_update(c, ref_crc_update(c, 0, block, 16), p, n);
+}
+
+std::uint32_t update_avx2(const CrcConstants& c, std::uint32_t reg, const std::uint8_t* p,
+                          std::size_t n) {
+    return c.reflected ? update_pclmul<true>(c, reg, p, n) : update_pclmul<false>(c, reg, p, n);
+}
+
+}  // namespace
+
+const CrcKernels crc_avx2 = {update_avx2};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,116 @@
+// VPCLMULQDQ CRC folding (see crc_kernels.hpp): four 512-bit accumulators,
+// sixteen blocks, take 256 bytes per step. They combine into one register,
+// which folds the remaining 64-byte chunks; its four lanes then reduce to a
+// single block as in the PCLMULQDQ kernel. Messages shorter than one step
+// go to that kernel. Compiled with -mvpclmulqdq -mpclmul on top of the
+// AVX-512 flags; crc.cpp only picks it when the CPU reports VPCLMULQDQ.
+
+#include <immintrin.h>
+
+#include "crc_kernels.hpp"
+#include "crc_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+inline __m128i multipliers(const CrcFold& f) noexcept {
+    return _mm_set_epi64x(std::int64_t(f.hi), std::int64_t(f.lo));
+}
+
+inline __m512i multipliers4(const CrcFold& f) noexcept {
+    return _mm512_broadcast_i32x4(multipliers(f));
+}
+
+inline __m128i fold(__m128i x, __m128i k) noexcept {
+    return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00), _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+/// Each lane of x moved ahead by the distance of k.
+inline __m512i fold(__m512i x, __m512i k) noexcept {
+    return _mm512_xor_si512(_mm512_clmulepi64_epi128(x, k, 0x00),
+                            _mm512_clmulepi64_epi128(x, k, 0x11));
+}
+
+inline __m128i byte_reverse() noexcept {
+    return _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+}
+
+template <bool Reflected>
+inline __m128i order(__m128i v) noexcept {
+    if constexpr (Reflected) {
+        return v;
+    } else {
+        return _mm_shuffle_epi8(v, byte_reverse());
+    }
+}
+
+template <bool Reflected>
+inline __m512i order(__m512i v) noexcept {
+    if constexpr (Reflected) {
+        return v;
+    } else {
+        return _mm512_shuffle_epi8(v, _mm512_broadcast_i32x4(byte_reverse()));
+    }
+}
+
+template <bool Reflected>
+inline __m512i load(const std::uint8_t* p) noexcept {
+    return order<Reflected>(_mm512_loadu_si512(p));
+}
+
+template <bool Reflected>
+std::uint32_t update_vpclmul(const CrcConstants& c, std::uint32_t reg, const std::uint8_t* p,
+                             std::size_t n) noexcept {
+    if (n < 256) {
+        return crc_avx2.update(c, reg, p, n);
+    }
+    const __m512i r = _mm512_castsi128_si512(
+        _mm_cvtsi32_si128(std::int32_t(Reflected ? reg : __builtin_bswap32(reg))));
+    __m512i z0 = order<Reflected>(_mm512_xor_si512(_mm512_loadu_si512(p), r));
+    __m512i z1 = load<Reflected>(p + 64);
+    __m512i z2 = load<Reflected>(p + 128);
+    __m512i z3 = load<Reflected>(p + 192);
+    p += 256;
+    n -= 256;
+    const __m512i k2048 = multipliers4(c.fold2048);
+    for (; n >= 256; p += 256, n -= 256) {
+        z0 = _mm512_xor_si512(fold(z0, k2048), load<Reflected>(p));
+        z1 = _mm512_xor_si512(fold(z1, k2048), load<Reflected>(p + 64));
+        z2 = _mm512_xor_si512(fold(z2, k2048), load<Reflected>(p + 128));
+        z3 = _mm512_xor_si512(fold(z3, k2048), load<Reflected>(p + 192));
+    }
+    const __m512i k512 = multipliers4(c.fold512);
+    __m512i z = _mm512_xor_si512(_mm512_xor_si512(fold(z0, multipliers4(c.fold1536)),
+                                                  fold(z1, multipliers4(c.fold1024))),
+                                 _mm512_xor_si512(fold(z2, k512), z3));
+    for (; n >= 64; p += 64, n -= 64) {
+        z = _mm512_xor_si512(fold(z, k512), load<Reflected>(p));
+    }
+    // Lane 0 holds the earliest block.
+    const __m128i k128 = multipliers(c.fold128);
+    __m128i x = _mm_xor_si128(
+        _mm_xor_si128(fold(_mm512_extracti32x4_epi32(z, 0), multipliers(c.fold384)),
+                      fold(_mm512_extracti32x4_epi32(z, 1), multipliers(c.fold256))),
+        _mm_xor_si128(fold(_mm512_extracti32x4_epi32(z, 2), k128),
+                      _mm512_extracti32x4_epi32(z, 3)));
+    for (; n >= 16; p += 16, n -= 16) {
+        x = _mm_xor_si128(fold(x, k128),
+                          order<Reflected>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))));
+    }
+    alignas(16) std::uint8_t block[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(block), order<Reflected>(x));
+    return ref_crc_update(c, ref_crc_update(c, 0, block, 16), p, n);
+}
+
+std::uint32_t update_avx512(const CrcConstants& c, std::uint32_t reg, const std::uint8_t* p,
+                            std::size_t n) {
+    return c.reflected ? update_vpclmul<true>(c, reg, p, n)
+                       : update_vpclmul<false>(c, reg, p, n);
+}
+
+}  // namespace
+
+const CrcKernels crc_avx512 = {update_avx512};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,120 @@
+#pragma once
+
+// Per-ISA kernels behind Crc<Spec>.
+//
+// Every CRC runs on a 32-bit register. An MSB-first CRC of width w keeps
+// its value in the top w bits, so the modulus is G = x^32 + (poly << (32 -
+// w)); a reflected one keeps it bit-reversed in the low w bits. The scalar
+// kernel is slicing-by-8 over eight 256-entry tables. The wide kernels fold
+// 128-bit message blocks with carry-less multiplies: a block H x^64 + L
+// moved D bits ahead is congruent to H (x^(D+64) mod G) + L (x^D mod G),
+// which is again 128 bits wide, so the whole message folds into a single
+// block. Stored back as 16 message bytes, that block has the CRC of
+// everything it replaced and finishes through the tables. One code path
+// serves both bit orders: MSB-first blocks are byte-reversed on load, and
+// reflected multipliers are bit-reversed with one power of x less to
+// absorb the one-bit shift of a reflected carry-less product. Every
+// variant computes the same remainder, so all agree exactly.
+//
+// The tables and multipliers are constexpr functions of the polynomial:
+// crc.cpp builds one CrcConstants per CRC at compile time.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dcomm::kernels {
+
+/// Multipliers of the low and high 64-bit halves of a block folded ahead.
+struct CrcFold {
+    std::uint64_t lo;
+    std::uint64_t hi;
+};
+
+struct CrcConstants {
+    /// table[k][b]: register contribution of byte b followed by k zeros.
+    std::uint32_t table[8][256];
+    bool reflected;
+    CrcFold fold128;  ///< one block ahead
+    CrcFold fold256;
+    CrcFold fold384;
+    CrcFold fold512;  ///< four blocks, one 512-bit register
+    CrcFold fold1024;
+    CrcFold fold1536;
+    CrcFold fold2048;
+};
+
+/// x^n mod (x^32 + p).
+constexpr std::uint32_t crc_xpow_mod(std::size_t n, std::uint32_t p) noexcept {
+    std::uint32_t r = 1;
+    for (std::size_t i = 0; i < n; ++i) {
+        r = (r << 1) ^ ((r >> 31) != 0 ? p : 0u);
+    }
+    return r;
+}
+
+constexpr std::uint32_t crc_reverse32(std::uint32_t v) noexcept {
+    std::uint32_t r = 0;
+    for (int i = 0; i < 32; ++i, v >>= 1) {
+        r = (r << 1) | (v & 1u);
+    }
+    return r;
+}
+
+/// Multipliers for folding `bits` ahead; see the header comment.
+constexpr CrcFold crc_fold(std::size_t bits, std::uint32_t p, bool reflected) noexcept {
+    if (reflected) {
+        // The low half holds the high-order coefficients, bit-reversed.
+        return {std::uint64_t(crc_reverse32(crc_xpow_mod(bits + 63, p))) << 32,
+                std::uint64_t(crc_reverse32(crc_xpow_mod(bits - 1, p))) << 32};
+    }
+    return {crc_xpow_mod(bits, p), crc_xpow_mod(bits + 64, p)};
+}
+
+/// Tables and fold multipliers of a CRC (width 8..32, poly without x^width).
+constexpr CrcConstants make_crc_constants(unsigned width, std::uint32_t poly,
+                                          bool reflected) noexcept {
+    CrcConstants c{};
+    const std::uint32_t p = poly << (32 - width);
+    const std::uint32_t rp = crc_reverse32(p);
+    for (std::uint32_t b = 0; b < 256; ++b) {
+        std::uint32_t r = reflected ? b : b << 24;
+        for (int i = 0; i < 8; ++i) {
+            r = reflected ? (r >> 1) ^ ((r & 1u) != 0 ? rp : 0u)
+                          : (r << 1) ^ ((r >> 31) != 0 ? p : 0u);
+        }
+        c.table[0][b] = r;
+    }
+    for (int k = 1; k < 8; ++k) {
+        for (int b = 0; b < 256; ++b) {
+            const std::uint32_t r = c.table[k - 1][b];
+            c.table[k][b] = reflected ? (r >> 8) ^ c.table[0][r & 0xff]
+                                      : (r << 8) ^ c.table[0][r >> 24];
+        }
+    }
+    c.reflected = reflected;
+    c.fold128 = crc_fold(128, p, reflected);
+    c.fold256 = crc_fold(256, p, reflected);
+    c.fold384 = crc_fold(384, p, reflected);
+    c.fold512 = crc_fold(512, p, reflected);
+    c.fold1024 = crc_fold(1024, p, reflected);
+    c.fold1536 = crc_fold(1536, p, reflected);
+    c.fold2048 = crc_fold(2048, p, reflected);
+    return c;
+}
+
+struct CrcKernels {
+    /// Register after n more bytes from register `reg`.
+    std::uint32_t (*update)(const CrcConstants& c, std::uint32_t reg, const std::uint8_t* p,
+                            std::size_t n);
+};
+
+extern const CrcKernels crc_scalar;  ///< slicing-by-8
+#if defined(DCOMM_KERNELS_X86)
+extern const CrcKernels crc_avx2;    ///< PCLMULQDQ, four 128-bit blocks at a time
+extern const CrcKernels crc_avx512;  ///< VPCLMULQDQ, sixteen blocks at a time
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+extern const CrcKernels crc_neon;  ///< PMULL, four blocks at a time
+#endif
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,83 @@
+// PMULL CRC folding for AArch64 (see crc_kernels.hpp): four 128-bit
+// accumulators take 64 bytes per step, as in the PCLMULQDQ kernel, with
+// vmull_p64 / vmull_high_p64 for the carry-less products. Compiled with
+// +crypto; crc.cpp only picks it when the CPU reports PMULL.
+
+#include <arm_neon.h>
+
+#include "crc_kernels.hpp"
+#include "crc_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+constexpr std::size_t kFoldMin = 64;
+
+inline uint64x2_t multipliers(const CrcFold& f) noexcept {
+    return vcombine_u64(vcreate_u64(f.lo), vcreate_u64(f.hi));
+}
+
+inline uint64x2_t fold(uint64x2_t x, uint64x2_t k) noexcept {
+    const poly128_t lo = vmull_p64(poly64_t(vgetq_lane_u64(x, 0)), poly64_t(vgetq_lane_u64(k, 0)));
+    const poly128_t hi = vmull_high_p64(vreinterpretq_p64_u64(x), vreinterpretq_p64_u64(k));
+    return veorq_u64(vreinterpretq_u64_p128(lo), vreinterpretq_u64_p128(hi));
+}
+
+template <bool Reflected>
+inline uint64x2_t order(uint8x16_t v) noexcept {
+    if constexpr (!Reflected) {
+        const uint8x16_t r = vrev64q_u8(v);
+        v = vextq_u8(r, r, 8);
+    }
+    return vreinterpretq_u64_u8(v);
+}
+
+template <bool Reflected>
+inline uint64x2_t load(const std::uint8_t* p) noexcept {
+    return order<Reflected>(vld1q_u8(p));
+}
+
+template <bool Reflected>
+std::uint32_t update_pmull(const CrcConstants& c, std::uint32_t reg, const std::uint8_t* p,
+                           std::size_t n) noexcept {
+    if (n < kFoldMin) {
+        return ref_crc_update(c, reg, p, n);
+    }
+    const std::uint32_t first = Reflected ? reg : __builtin_bswap32(reg);
+    const uint32x4_t r = vsetq_lane_u32(first, vdupq_n_u32(0), 0);
+    uint64x2_t x0 = order<Reflected>(veorq_u8(vld1q_u8(p), vreinterpretq_u8_u32(r)));
+    uint64x2_t x1 = load<Reflected>(p + 16);
+    uint64x2_t x2 = load<Reflected>(p + 32);
+    uint64x2_t x3 = load<Reflected>(p + 48);
+    p += 64;
+    n -= 64;
+    const uint64x2_t k512 = multipliers(c.fold512);
+    for (; n >= 64; p += 64, n -= 64) {
+        x0 = veorq_u64(fold(x0, k512), load<Reflected>(p));
+        x1 = veorq_u64(fold(x1, k512), load<Reflected>(p + 16));
+        x2 = veorq_u64(fold(x2, k512), load<Reflected>(p + 32));
+        x3 = veorq_u64(fold(x3, k512), load<Reflected>(p + 48));
+    }
+    const uint64x2_t k128 = multipliers(c.fold128);
+    uint64x2_t x = veorq_u64(
+        veorq_u64(fold(x0, multipliers(c.fold384)), fold(x1, multipliers(c.fold256))),
+        veorq_u64(fold(x2, k128), x3));
+    for (; n >= 16; p += 16, n -= 16) {
+        x = veorq_u64(fold(x, k128), load<Reflected>(p));
+    }
+    alignas(16) std::uint8_t block[16];
+    vst1q_u8(block, vreinterpretq_u8_u64(order<Reflected>(vreinterpretq_u8_u64(x))));
+    return ref_crc_update(c, ref_crc_update(c, 0, block, 16), p, n);
+}
+
+std::uint32_t update_neon(const CrcConstants& c, std::uint32_t reg, const std::uint8_t* p,
+                          std::size_t n) {
+    return c.reflected ? update_pmull<true>(c, reg, p, n) : update_pmull<false>(c, reg, p, n);
+}
+
+}  // namespace
+
+const CrcKernels crc_neon = {update_neon};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,57 @@
+#pragma once
+
+// Reference CRC kernel (see crc_kernels.hpp for the register layout):
+// slicing-by-8, eight bytes per step through eight table lookups, then
+// byte at a time. The wide kernels use it for short messages and to
+// finish their folded block. Internal linkage: every kernel translation
+// unit includes this and compiles it for its own ISA.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "crc_kernels.hpp"
+
+namespace dcomm::kernels {
+namespace {
+
+inline std::uint32_t load_le32(const std::uint8_t* p) noexcept {
+    return std::uint32_t(p[0]) | std::uint32_t(p[1]) << 8 | std::uint32_t(p[2]) << 16 |
+           std::uint32_t(p[3]) << 24;
+}
+
+inline std::uint32_t load_be32(const std::uint8_t* p) noexcept {
+    return std::uint32_t(p[0]) << 24 | std::uint32_t(p[1]) << 16 | std::uint32_t(p[2]) << 8 |
+           std::uint32_t(p[3]);
+}
+
+inline std::uint32_t ref_crc_update(const CrcConstants& c, std::uint32_t reg,
+                                    const std::uint8_t* p, std::size_t n) noexcept {
+    const auto& t = c.table;
+    if (c.reflected) {
+        for (; n >= 8; n -= 8, p += 8) {
+            const std::uint32_t x = reg ^ load_le32(p);
+            const std::uint32_t y = load_le32(p + 4);
+            reg = t[7][x & 0xff] ^ t[6][(x >> 8) & 0xff] ^ t[5][(x >> 16) & 0xff] ^
+                  t[4][x >> 24] ^ t[3][y & 0xff] ^ t[2][(y >> 8) & 0xff] ^
+                  t[1][(y >> 16) & 0xff] ^ t[0][y >> 24];
+        }
+        for (; n > 0; --n, ++p) {
+            reg = (reg >> 8) ^ t[0][(reg ^ *p) & 0xff];
+        }
+    } else {
+        for (; n >= 8; n -= 8, p += 8) {
+            const std::uint32_t x = reg ^ load_be32(p);
+            const std::uint32_t y = load_be32(p + 4);
+            reg = t[7][x >> 24] ^ t[6][(x >> 16) & 0xff] ^ t[5][(x >> 8) & 0xff] ^
+                  t[4][x & 0xff] ^ t[3][y >> 24] ^ t[2][(y >> 16) & 0xff] ^
+                  t[1][(y >> 8) & 0xff] ^ t[0][y & 0xff];
+        }
+        for (; n > 0; --n, ++p) {
+            reg = (reg << 8) ^ t[0][(reg >> 24) ^ *p];
+        }
+    }
+    return reg;
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
@@ -0,0 +1,17 @@
+#include "crc_kernels.hpp"
+#include "crc_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+std::uint32_t update_scalar(const CrcConstants& c, std::uint32_t reg, const std::uint8_t* p,
+                            std::size_t n) {
+    return ref_crc_update(c, reg, p, n);
+}
+
+}  // namespace
+
+const CrcKernels crc_scalar = {update_scalar};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,260 @@
+// AVX2 FFT passes: four float or eight Q15 complex points per register.
+// Float passes whose butterfly stride is narrower than a register fall back
+// to the reference code; in an OFDM-sized transform that is only the last
+// one or two passes. Q15 radix-4 passes of span 16 and 4 are vectorised by
+// rearranging the sub-transforms, since those passes dominate a 64-point
+// transform.
+
+#include <cstring>
+#include <immintrin.h>
+
+#include "fft_kernels.hpp"
+#include "fft_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+// ---- float ------------------------------------------------------------------
+
+inline __m256 cmul(__m256 x, __m256 w) noexcept {
+    const __m256 wr = _mm256_moveldup_ps(w);
+    const __m256 wi = _mm256_movehdup_ps(w);
+    const __m256 xs = _mm256_permute_ps(x, 0xb1);
+    return _mm256_addsub_ps(_mm256_mul_ps(x, wr), _mm256_mul_ps(xs, wi));
+}
+
+/// Multiply by -j (forward) or +j (inverse).
+inline __m256 rotate(__m256 u, __m256 sign) noexcept {
+    return _mm256_xor_ps(_mm256_permute_ps(u, 0xb1), sign);
+}
+
+void radix2_avx2(float* x, std::size_t span, std::size_t count, const float* tw) {
+    const std::size_t h = span / 2;
+    if (h < 4) {
+        ref_radix2(x, span, count, tw);
+        return;
+    }
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < h; k += 4) {
+            float* p0 = x + 2 * k;
+            float* p1 = p0 + 2 * h;
+            const __m256 a = _mm256_loadu_ps(p0);
+            const __m256 b = _mm256_loadu_ps(p1);
+            _mm256_storeu_ps(p0, _mm256_add_ps(a, b));
+            _mm256_storeu_ps(p1, cmul(_mm256_sub_ps(a, b), _mm256_loadu_ps(tw + 2 * k)));
+        }
+    }
+}
+
+void radix4_avx2(float* x, std::size_t span, std::size_t count, const float* tw,
+                 bool inverse) {
+    const std::size_t q = span / 4;
+    if (q < 4) {
+        ref_radix4(x, span, count, tw, inverse);
+        return;
+    }
+    const __m256 sign = inverse ? _mm256_setr_ps(-0.0f, 0, -0.0f, 0, -0.0f, 0, -0.0f, 0)
+                                : _mm256_setr_ps(0, -0.0f, 0, -0.0f, 0, -0.0f, 0, -0.0f);
+    const float* w1 = tw;
+    const float* w2 = tw + 2 * q;
+    const float* w3 = tw + 4 * q;
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < q; k += 4) {
+            float* p0 = x + 2 * k;
+            float* p1 = p0 + 2 * q;
+            float* p2 = p0 + 4 * q;
+            float* p3 = p0 + 6 * q;
+            const __m256 a = _mm256_loadu_ps(p0);
+            const __m256 b = _mm256_loadu_ps(p1);
+            const __m256 c = _mm256_loadu_ps(p2);
+            const __m256 d = _mm256_loadu_ps(p3);
+            const __m256 t0 = _mm256_add_ps(a, c);
+            const __m256 t1 = _mm256_sub_ps(a, c);
+            const __m256 t2 = _mm256_add_ps(b, d);
+            const __m256 t3 = rotate(_mm256_sub_ps(b, d), sign);
+            _mm256_storeu_ps(p0, _mm256_add_ps(t0, t2));
+            _mm256_storeu_ps(p1, cmul(_mm256_add_ps(t1, t3), _mm256_loadu_ps(w1 + 2 * k)));
+            _mm256_storeu_ps(p2, cmul(_mm256_sub_ps(t0, t2), _mm256_loadu_ps(w2 + 2 * k)));
+            _mm256_storeu_ps(p3, cmul(_mm256_sub_ps(t1, t3), _mm256_loadu_ps(w3 + 2 * k)));
+        }
+    }
+}
+
+// ---- Q15 --------------------------------------------------------------------
+
+inline __m256i q15_half8(__m256i v) noexcept {
+    return _mm256_mulhrs_epi16(v, _mm256_set1_epi16(0x4000));
+}
+
+inline __m256i cmul_q15(__m256i x, __m256i w) noexcept {
+    const __m256i dup_re = _mm256_setr_epi8(0, 1, 0, 1, 4, 5, 4, 5, 8, 9, 8, 9, 12, 13, 12, 13,
+                                            0, 1, 0, 1, 4, 5, 4, 5, 8, 9, 8, 9, 12, 13, 12, 13);
+    const __m256i dup_im = _mm256_setr_epi8(2, 3, 2, 3, 6, 7, 6, 7, 10, 11, 10, 11, 14, 15, 14,
+                                            15, 2, 3, 2, 3, 6, 7, 6, 7, 10, 11, 10, 11, 14, 15,
+                                            14, 15);
+    const __m256i swap = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                          2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    // p1 = (xr wr, xi wr), p2 = (xi wi, xr wi)
+    const __m256i p1 = _mm256_mulhrs_epi16(x, _mm256_shuffle_epi8(w, dup_re));
+    const __m256i p2 =
+        _mm256_mulhrs_epi16(_mm256_shuffle_epi8(x, swap), _mm256_shuffle_epi8(w, dup_im));
+    return _mm256_blend_epi16(_mm256_subs_epi16(p1, p2), _mm256_adds_epi16(p1, p2), 0xaa);
+}
+
+inline __m256i rotate_q15(__m256i u, __m256i sign) noexcept {
+    const __m256i swap = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                          2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    return _mm256_sign_epi16(_mm256_shuffle_epi8(u, swap), sign);
+}
+
+inline __m256i load8(const std::int16_t* p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+inline void store8(std::int16_t* p, __m256i v) noexcept {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+void radix2_q15_avx2(std::int16_t* x, std::size_t span, std::size_t count,
+                     const std::int16_t* tw) {
+    const std::size_t h = span / 2;
+    if (h < 8) {
+        ref_radix2_q15(x, span, count, tw);
+        return;
+    }
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < h; k += 8) {
+            std::int16_t* p0 = x + 2 * k;
+            std::int16_t* p1 = p0 + 2 * h;
+            const __m256i a = q15_half8(load8(p0));
+            const __m256i b = q15_half8(load8(p1));
+            store8(p0, _mm256_adds_epi16(a, b));
+            store8(p1, cmul_q15(_mm256_subs_epi16(a, b), load8(tw + 2 * k)));
+        }
+    }
+}
+
+/// Radix-4 pass of span 16: one sub-transform per register pair, the four
+/// quarter-blocks sitting in 128-bit lanes.
+void radix4_q15_span16(std::int16_t* x, std::size_t count, const std::int16_t* tw,
+                       __m256i sign) noexcept {
+    const __m256i w1 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(tw)));
+    const __m256i w23 = load8(tw + 8);  // W^2k and W^3k are adjacent
+    for (std::size_t s = 0; s < count; ++s, x += 32) {
+        const __m256i ab = q15_half8(load8(x));       // [a | b]
+        const __m256i cd = q15_half8(load8(x + 16));  // [c | d]
+        const __m256i sum = q15_half8(_mm256_adds_epi16(ab, cd));   // [t0 | t2]
+        const __m256i diff = q15_half8(_mm256_subs_epi16(ab, cd));  // [t1 | u]
+        const __m256i d = _mm256_blend_epi32(diff, rotate_q15(diff, sign), 0xf0);  // [t1 | t3]
+        const __m256i lo = _mm256_permute2x128_si256(sum, d, 0x20);  // [t0 | t1]
+        const __m256i hi = _mm256_permute2x128_si256(sum, d, 0x31);  // [t2 | t3]
+        const __m256i o01 = _mm256_adds_epi16(lo, hi);
+        // The first quarter takes no twiddle: W^0 is not exact in Q15.
+        store8(x, _mm256_blend_epi32(o01, cmul_q15(o01, w1), 0xf0));
+        store8(x + 16, cmul_q15(_mm256_subs_epi16(lo, hi), w23));
+    }
+}
+
+/// 4x4 transpose of complex values within each 128-bit lane of four
+/// registers; its own inverse.
+inline void transpose4(__m256i& r0, __m256i& r1, __m256i& r2, __m256i& r3) noexcept {
+    const __m256i a = _mm256_unpacklo_epi32(r0, r1);
+    const __m256i b = _mm256_unpackhi_epi32(r0, r1);
+    const __m256i c = _mm256_unpacklo_epi32(r2, r3);
+    const __m256i d = _mm256_unpackhi_epi32(r2, r3);
+    r0 = _mm256_unpacklo_epi64(a, c);
+    r1 = _mm256_unpackhi_epi64(a, c);
+    r2 = _mm256_unpacklo_epi64(b, d);
+    r3 = _mm256_unpackhi_epi64(b, d);
+}
+
+/// Radix-4 pass of span 4, eight sub-transforms at a time: transposed so
+/// that each register holds one quarter of all eight.
+void radix4_q15_span4(std::int16_t* x, std::size_t count, const std::int16_t* tw,
+                      __m256i sign, bool inverse) noexcept {
+    const auto twiddle = [&](int m) {
+        std::int32_t w;
+        std::memcpy(&w, tw + 2 * m, sizeof(w));
+        return _mm256_set1_epi32(w);
+    };
+    const __m256i w1 = twiddle(0);
+    const __m256i w2 = twiddle(1);
+    const __m256i w3 = twiddle(2);
+    std::size_t s = 0;
+    for (; s + 8 <= count; s += 8, x += 64) {
+        __m256i a = load8(x);
+        __m256i b = load8(x + 16);
+        __m256i c = load8(x + 32);
+        __m256i d = load8(x + 48);
+        transpose4(a, b, c, d);
+        a = q15_half8(a);
+        b = q15_half8(b);
+        c = q15_half8(c);
+        d = q15_half8(d);
+        const __m256i t0 = q15_half8(_mm256_adds_epi16(a, c));
+        const __m256i t1 = q15_half8(_mm256_subs_epi16(a, c));
+        const __m256i t2 = q15_half8(_mm256_adds_epi16(b, d));
+        const __m256i t3 = rotate_q15(q15_half8(_mm256_subs_epi16(b, d)), sign);
+        __m256i o0 = _mm256_adds_epi16(t0, t2);
+        __m256i o1 = cmul_q15(_mm256_adds_epi16(t1, t3), w1);
+        __m256i o2 = cmul_q15(_mm256_subs_epi16(t0, t2), w2);
+        __m256i o3 = cmul_q15(_mm256_subs_epi16(t1, t3), w3);
+        transpose4(o0, o1, o2, o3);
+        store8(x, o0);
+        store8(x + 16, o1);
+        store8(x + 32, o2);
+        store8(x + 48, o3);
+    }
+    if (s < count) {
+        ref_radix4_q15(x, 4, count - s, tw, inverse);
+    }
+}
+
+void radix4_q15_avx2(std::int16_t* x, std::size_t span, std::size_t count,
+                     const std::int16_t* tw, bool inverse) {
+    const std::size_t q = span / 4;
+    // Sign pattern applied after swapping re/im: -j -> (im, -re), +j -> (-im, re).
+    const __m256i sign = inverse ? _mm256_set1_epi32(0x0001ffff) : _mm256_set1_epi32(0xffff0001);
+    if (q == 4) {
+        radix4_q15_span16(x, count, tw, sign);
+        return;
+    }
+    if (q == 1) {
+        radix4_q15_span4(x, count, tw, sign, inverse);
+        return;
+    }
+    if (q < 8) {
+        ref_radix4_q15(x, span, count, tw, inverse);
+        return;
+    }
+    const std::int16_t* w1 = tw;
+    const std::int16_t* w2 = tw + 2 * q;
+    const std::int16_t* w3 = tw + 4 * q;
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < q; k += 8) {
+            std::int16_t* p0 = x + 2 * k;
+            std::int16_t* p1 = p0 + 2 * q;
+            std::int16_t* p2 = p0 + 4 * q;
+            std::int16_t* p3 = p0 + 6 * q;
+            const __m256i a = q15_half8(load8(p0));
+            const __m256i b = q15_half8(load8(p1));
+            const __m256i c = q15_half8(load8(p2));
+            const __m256i d = q15_half8(load8(p3));
+            const __m256i t0 = q15_half8(_mm256_adds_epi16(a, c));
+            const __m256i t1 = q15_half8(_mm256_subs_epi16(a, c));
+            const __m256i t2 = q15_half8(_mm256_adds_epi16(b, d));
+            const __m256i t3 = rotate_q15(q15_half8(_mm256_subs_epi16(b, d)), sign);
+            store8(p0, _mm256_adds_epi16(t0, t2));
+            store8(p1, cmul_q15(_mm256_adds_epi16(t1, t3), load8(w1 + 2 * k)));
+            store8(p2, cmul_q15(_mm256_subs_epi16(t0, t2), load8(w2 + 2 * k)));
+            store8(p3, cmul_q15(_mm256_subs_epi16(t1, t3), load8(w3 + 2 * k)));
+        }
+    }
+}
+
+}  // namespace
+
+const FftKernels fft_avx2 = {radix2_avx2, radix4_avx2, radix2_q15_avx2, radix4_q15_avx2};
+
+}  // namespace dcomm::kernels
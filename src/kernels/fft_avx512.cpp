@@ -0,0 +1,164 @@
+// AVX-512 FFT passes: eight float or sixteen Q15 complex points per register.
+// Same structure as fft_avx2.cpp; radix-4 passes narrower than a register
+// use the AVX2 kernels, which every AVX-512 CPU also runs.
+
+#include <immintrin.h>
+
+#include "fft_kernels.hpp"
+#include "fft_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+// ---- float ------------------------------------------------------------------
+
+inline __m512 cmul(__m512 x, __m512 w) noexcept {
+    const __m512 wr = _mm512_moveldup_ps(w);
+    const __m512 wi = _mm512_movehdup_ps(w);
+    const __m512 xs = _mm512_permute_ps(x, 0xb1);
+    return _mm512_fmaddsub_ps(x, wr, _mm512_mul_ps(xs, wi));
+}
+
+void radix2_avx512(float* x, std::size_t span, std::size_t count, const float* tw) {
+    const std::size_t h = span / 2;
+    if (h < 8) {
+        ref_radix2(x, span, count, tw);
+        return;
+    }
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < h; k += 8) {
+            float* p0 = x + 2 * k;
+            float* p1 = p0 + 2 * h;
+            const __m512 a = _mm512_loadu_ps(p0);
+            const __m512 b = _mm512_loadu_ps(p1);
+            _mm512_storeu_ps(p0, _mm512_add_ps(a, b));
+            _mm512_storeu_ps(p1, cmul(_mm512_sub_ps(a, b), _mm512_loadu_ps(tw + 2 * k)));
+        }
+    }
+}
+
+void radix4_avx512(float* x, std::size_t span, std::size_t count, const float* tw,
+                   bool inverse) {
+    const std::size_t q = span / 4;
+    if (q < 8) {
+        fft_avx2.radix4(x, span, count, tw, inverse);
+        return;
+    }
+    // Lanes negated after swapping re/im: odd for -j, even for +j.
+    const __m512i sign = inverse ? _mm512_set1_epi64(0x0000000080000000)
+                                 : _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull));
+    const float* w1 = tw;
+    const float* w2 = tw + 2 * q;
+    const float* w3 = tw + 4 * q;
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < q; k += 8) {
+            float* p0 = x + 2 * k;
+            float* p1 = p0 + 2 * q;
+            float* p2 = p0 + 4 * q;
+            float* p3 = p0 + 6 * q;
+            const __m512 a = _mm512_loadu_ps(p0);
+            const __m512 b = _mm512_loadu_ps(p1);
+            const __m512 c = _mm512_loadu_ps(p2);
+            const __m512 d = _mm512_loadu_ps(p3);
+            const __m512 t0 = _mm512_add_ps(a, c);
+            const __m512 t1 = _mm512_sub_ps(a, c);
+            const __m512 t2 = _mm512_add_ps(b, d);
+            const __m512 t3 = _mm512_castsi512_ps(_mm512_xor_si512(
+                _mm512_castps_si512(_mm512_permute_ps(_mm512_sub_ps(b, d), 0xb1)), sign));
+            _mm512_storeu_ps(p0, _mm512_add_ps(t0, t2));
+            _mm512_storeu_ps(p1, cmul(_mm512_add_ps(t1, t3), _mm512_loadu_ps(w1 + 2 * k)));
+            _mm512_storeu_ps(p2, cmul(_mm512_sub_ps(t0, t2), _mm512_loadu_ps(w2 + 2 * k)));
+            _mm512_storeu_ps(p3, cmul(_mm512_sub_ps(t1, t3), _mm512_loadu_ps(w3 + 2 * k)));
+        }
+    }
+}
+
+// ---- Q15 --------------------------------------------------------------------
+
+constexpr __mmask32 kImLanes = 0xaaaaaaaau;
+constexpr __mmask32 kReLanes = 0x55555555u;
+
+inline __m512i q15_half16(__m512i v) noexcept {
+    return _mm512_mulhrs_epi16(v, _mm512_set1_epi16(0x4000));
+}
+
+inline __m512i swap_re_im(__m512i v) noexcept {
+    return _mm512_shuffle_epi8(v, _mm512_broadcast_i32x4(_mm_setr_epi8(
+                                      2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13)));
+}
+
+inline __m512i cmul_q15(__m512i x, __m512i w) noexcept {
+    const __m512i dup_re = _mm512_broadcast_i32x4(
+        _mm_setr_epi8(0, 1, 0, 1, 4, 5, 4, 5, 8, 9, 8, 9, 12, 13, 12, 13));
+    const __m512i dup_im = _mm512_broadcast_i32x4(
+        _mm_setr_epi8(2, 3, 2, 3, 6, 7, 6, 7, 10, 11, 10, 11, 14, 15, 14, 15));
+    const __m512i p1 = _mm512_mulhrs_epi16(x, _mm512_shuffle_epi8(w, dup_re));
+    const __m512i p2 = _mm512_mulhrs_epi16(swap_re_im(x), _mm512_shuffle_epi8(w, dup_im));
+    return _mm512_mask_blend_epi16(kImLanes, _mm512_subs_epi16(p1, p2),
+                                   _mm512_adds_epi16(p1, p2));
+}
+
+inline __m512i load16(const std::int16_t* p) noexcept { return _mm512_loadu_si512(p); }
+inline void store16(std::int16_t* p, __m512i v) noexcept { _mm512_storeu_si512(p, v); }
+
+void radix2_q15_avx512(std::int16_t* x, std::size_t span, std::size_t count,
+                       const std::int16_t* tw) {
+    const std::size_t h = span / 2;
+    if (h < 16) {
+        ref_radix2_q15(x, span, count, tw);
+        return;
+    }
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < h; k += 16) {
+            std::int16_t* p0 = x + 2 * k;
+            std::int16_t* p1 = p0 + 2 * h;
+            const __m512i a = q15_half16(load16(p0));
+            const __m512i b = q15_half16(load16(p1));
+            store16(p0, _mm512_adds_epi16(a, b));
+            store16(p1, cmul_q15(_mm512_subs_epi16(a, b), load16(tw + 2 * k)));
+        }
+    }
+}
+
+void radix4_q15_avx512(std::int16_t* x, std::size_t span, std::size_t count,
+                       const std::int16_t* tw, bool inverse) {
+    const std::size_t q = span / 4;
+    if (q < 16) {
+        fft_avx2.radix4_q15(x, span, count, tw, inverse);
+        return;
+    }
+    const __mmask32 negate = inverse ? kReLanes : kImLanes;
+    const __m512i zero = _mm512_setzero_si512();
+    const std::int16_t* w1 = tw;
+    const std::int16_t* w2 = tw + 2 * q;
+    const std::int16_t* w3 = tw + 4 * q;
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < q; k += 16) {
+            std::int16_t* p0 = x + 2 * k;
+            std::int16_t* p1 = p0 + 2 * q;
+            std::int16_t* p2 = p0 + 4 * q;
+            std::int16_t* p3 = p0 + 6 * q;
+            const __m512i a = q15_half16(load16(p0));
+            const __m512i b = q15_half16(load16(p1));
+            const __m512i c = q15_half16(load16(p2));
+            const __m512i d = q15_half16(load16(p3));
+            const __m512i t0 = q15_half16(_mm512_adds_epi16(a, c));
+            const __m512i t1 = q15_half16(_mm512_subs_epi16(a, c));
+            const __m512i t2 = q15_half16(_mm512_adds_epi16(b, d));
+            const __m512i u = swap_re_im(q15_half16(_mm512_subs_epi16(b, d)));
+            const __m512i t3 = _mm512_mask_sub_epi16(u, negate, zero, u);
+            store16(p0, _mm512_adds_epi16(t0, t2));
+            store16(p1, cmul_q15(_mm512_adds_epi16(t1, t3), load16(w1 + 2 * k)));
+            store16(p2, cmul_q15(_mm512_subs_epi16(t0, t2), load16(w2 + 2 * k)));
+            store16(p3, cmul_q15(_mm512_subs_epi16(t1, t3), load16(w3 + 2 * k)));
+        }
+    }
+}
+
+}  // namespace
+
+const FftKernels fft_avx512 = {radix2_avx512, radix4_avx512, radix2_q15_avx512,
+                               radix4_q15_avx512};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,36 @@
+#pragma once
+
+// Per-ISA butterfly passes behind FftPlan.
+//
+// A pass applies one decimation-in-frequency stage to `count` consecutive
+// sub-transforms of `span` points each, in place on interleaved data. Its
+// twiddle table holds, for radix 4, W^k, W^2k and W^3k for k < span / 4
+// (three consecutive runs), and for radix 2, W^k for k < span / 2, with W
+// already conjugated for inverse passes. Q15 passes halve their data at
+// every butterfly level so a full transform is scaled by 1/N.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dcomm::kernels {
+
+struct FftKernels {
+    void (*radix2)(float* x, std::size_t span, std::size_t count, const float* tw);
+    void (*radix4)(float* x, std::size_t span, std::size_t count, const float* tw,
+                   bool inverse);
+    void (*radix2_q15)(std::int16_t* x, std::size_t span, std::size_t count,
+                       const std::int16_t* tw);
+    void (*radix4_q15)(std::int16_t* x, std::size_t span, std::size_t count,
+                       const std::int16_t* tw, bool inverse);
+};
+
+extern const FftKernels fft_scalar;
+#if defined(DCOMM_KERNELS_X86)
+extern const FftKernels fft_avx2;
+extern const FftKernels fft_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+extern const FftKernels fft_neon;
+#endif
+
+}  // namespace dcomm::kernels
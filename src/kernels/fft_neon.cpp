@@ -0,0 +1,157 @@
+// NEON FFT passes. vld2/vst2 split the interleaved data into separate re/im
+// registers, so the butterflies need no lane shuffles: four float or eight
+// Q15 complex points per pass step.
+
+#include <arm_neon.h>
+
+#include "fft_kernels.hpp"
+#include "fft_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+// ---- float ------------------------------------------------------------------
+
+inline float32x4x2_t cmul(float32x4x2_t x, float32x4x2_t w) noexcept {
+    float32x4x2_t r;
+    r.val[0] = vsubq_f32(vmulq_f32(x.val[0], w.val[0]), vmulq_f32(x.val[1], w.val[1]));
+    r.val[1] = vaddq_f32(vmulq_f32(x.val[0], w.val[1]), vmulq_f32(x.val[1], w.val[0]));
+    return r;
+}
+
+inline float32x4x2_t add(float32x4x2_t a, float32x4x2_t b) noexcept {
+    return {{vaddq_f32(a.val[0], b.val[0]), vaddq_f32(a.val[1], b.val[1])}};
+}
+inline float32x4x2_t sub(float32x4x2_t a, float32x4x2_t b) noexcept {
+    return {{vsubq_f32(a.val[0], b.val[0]), vsubq_f32(a.val[1], b.val[1])}};
+}
+
+void radix2_neon(float* x, std::size_t span, std::size_t count, const float* tw) {
+    const std::size_t h = span / 2;
+    if (h < 4) {
+        ref_radix2(x, span, count, tw);
+        return;
+    }
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < h; k += 4) {
+            float* p0 = x + 2 * k;
+            float* p1 = p0 + 2 * h;
+            const float32x4x2_t a = vld2q_f32(p0);
+            const float32x4x2_t b = vld2q_f32(p1);
+            vst2q_f32(p0, add(a, b));
+            vst2q_f32(p1, cmul(sub(a, b), vld2q_f32(tw + 2 * k)));
+        }
+    }
+}
+
+void radix4_neon(float* x, std::size_t span, std::size_t count, const float* tw,
+                 bool inverse) {
+    const std::size_t q = span / 4;
+    if (q < 4) {
+        ref_radix4(x, span, count, tw, inverse);
+        return;
+    }
+    const float* w1 = tw;
+    const float* w2 = tw + 2 * q;
+    const float* w3 = tw + 4 * q;
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < q; k += 4) {
+            float* p0 = x + 2 * k;
+            float* p1 = p0 + 2 * q;
+            float* p2 = p0 + 4 * q;
+            float* p3 = p0 + 6 * q;
+            const float32x4x2_t a = vld2q_f32(p0);
+            const float32x4x2_t b = vld2q_f32(p1);
+            const float32x4x2_t c = vld2q_f32(p2);
+            const float32x4x2_t d = vld2q_f32(p3);
+            const float32x4x2_t t0 = add(a, c);
+            const float32x4x2_t t1 = sub(a, c);
+            const float32x4x2_t t2 = add(b, d);
+            const float32x4x2_t u = sub(b, d);
+            const float32x4x2_t t3 = inverse ? float32x4x2_t{{vnegq_f32(u.val[1]), u.val[0]}}
+                                             : float32x4x2_t{{u.val[1], vnegq_f32(u.val[0])}};
+            vst2q_f32(p0, add(t0, t2));
+            vst2q_f32(p1, cmul(add(t1, t3), vld2q_f32(w1 + 2 * k)));
+            vst2q_f32(p2, cmul(sub(t0, t2), vld2q_f32(w2 + 2 * k)));
+            vst2q_f32(p3, cmul(sub(t1, t3), vld2q_f32(w3 + 2 * k)));
+        }
+    }
+}
+
+// ---- Q15 --------------------------------------------------------------------
+
+inline int16x8x2_t half(int16x8x2_t v) noexcept {
+    const int16x8_t k = vdupq_n_s16(0x4000);
+    return {{vqrdmulhq_s16(v.val[0], k), vqrdmulhq_s16(v.val[1], k)}};
+}
+inline int16x8x2_t qadd(int16x8x2_t a, int16x8x2_t b) noexcept {
+    return {{vqaddq_s16(a.val[0], b.val[0]), vqaddq_s16(a.val[1], b.val[1])}};
+}
+inline int16x8x2_t qsub(int16x8x2_t a, int16x8x2_t b) noexcept {
+    return {{vqsubq_s16(a.val[0], b.val[0]), vqsubq_s16(a.val[1], b.val[1])}};
+}
+inline int16x8x2_t cmul_q15(int16x8x2_t x, int16x8x2_t w) noexcept {
+    return {{vqsubq_s16(vqrdmulhq_s16(x.val[0], w.val[0]), vqrdmulhq_s16(x.val[1], w.val[1])),
+             vqaddq_s16(vqrdmulhq_s16(x.val[1], w.val[0]), vqrdmulhq_s16(x.val[0], w.val[1]))}};
+}
+
+void radix2_q15_neon(std::int16_t* x, std::size_t span, std::size_t count,
+                     const std::int16_t* tw) {
+    const std::size_t h = span / 2;
+    if (h < 8) {
+        ref_radix2_q15(x, span, count, tw);
+        return;
+    }
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < h; k += 8) {
+            std::int16_t* p0 = x + 2 * k;
+            std::int16_t* p1 = p0 + 2 * h;
+            const int16x8x2_t a = half(vld2q_s16(p0));
+            const int16x8x2_t b = half(vld2q_s16(p1));
+            vst2q_s16(p0, qadd(a, b));
+            vst2q_s16(p1, cmul_q15(qsub(a, b), vld2q_s16(tw + 2 * k)));
+        }
+    }
+}
+
+void radix4_q15_neon(std::int16_t* x, std::size_t span, std::size_t count,
+                     const std::int16_t* tw, bool inverse) {
+    const std::size_t q = span / 4;
+    if (q < 8) {
+        ref_radix4_q15(x, span, count, tw, inverse);
+        return;
+    }
+    const std::int16_t* w1 = tw;
+    const std::int16_t* w2 = tw + 2 * q;
+    const std::int16_t* w3 = tw + 4 * q;
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < q; k += 8) {
+            std::int16_t* p0 = x + 2 * k;
+            std::int16_t* p1 = p0 + 2 * q;
+            std::int16_t* p2 = p0 + 4 * q;
+            std::int16_t* p3 = p0 + 6 * q;
+            const int16x8x2_t a = half(vld2q_s16(p0));
+            const int16x8x2_t b = half(vld2q_s16(p1));
+            const int16x8x2_t c = half(vld2q_s16(p2));
+            const int16x8x2_t d = half(vld2q_s16(p3));
+            const int16x8x2_t t0 = half(qadd(a, c));
+            const int16x8x2_t t1 = half(qsub(a, c));
+            const int16x8x2_t t2 = half(qadd(b, d));
+            const int16x8x2_t u = half(qsub(b, d));
+            // Plain (wrapping) negation, matching the reference.
+            const int16x8x2_t t3 = inverse ? int16x8x2_t{{vnegq_s16(u.val[1]), u.val[0]}}
+                                           : int16x8x2_t{{u.val[1], vnegq_s16(u.val[0])}};
+            vst2q_s16(p0, qadd(t0, t2));
+            vst2q_s16(p1, cmul_q15(qadd(t1, t3), vld2q_s16(w1 + 2 * k)));
+            vst2q_s16(p2, cmul_q15(qsub(t0, t2), vld2q_s16(w2 + 2 * k)));
+            vst2q_s16(p3, cmul_q15(qsub(t1, t3), vld2q_s16(w3 + 2 * k)));
+        }
+    }
+}
+
+}  // namespace
+
+const FftKernels fft_neon = {radix2_neon, radix4_neon, radix2_q15_neon, radix4_q15_neon};
+
+}  // namespace dcomm::kernels
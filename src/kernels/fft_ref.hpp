@@ -0,0 +1,139 @@
+#pragma once
+
+// Scalar reference FFT passes (see fft_kernels.hpp for the contract). Used
+// as the scalar kernels and by the vector kernels for passes narrower than
+// their registers, hence internal linkage.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dcomm::kernels {
+namespace {
+
+inline void ref_cmul(float xr, float xi, const float* w, float* out) noexcept {
+    out[0] = xr * w[0] - xi * w[1];
+    out[1] = xr * w[1] + xi * w[0];
+}
+
+inline void ref_radix2(float* x, std::size_t span, std::size_t count,
+                       const float* tw) noexcept {
+    const std::size_t h = span / 2;
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < h; ++k) {
+            float* p0 = x + 2 * k;
+            float* p1 = p0 + 2 * h;
+            const float ar = p0[0], ai = p0[1], br = p1[0], bi = p1[1];
+            p0[0] = ar + br;
+            p0[1] = ai + bi;
+            ref_cmul(ar - br, ai - bi, tw + 2 * k, p1);
+        }
+    }
+}
+
+inline void ref_radix4(float* x, std::size_t span, std::size_t count, const float* tw,
+                       bool inverse) noexcept {
+    const std::size_t q = span / 4;
+    const float* w1 = tw;
+    const float* w2 = tw + 2 * q;
+    const float* w3 = tw + 4 * q;
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < q; ++k) {
+            float* p0 = x + 2 * k;
+            float* p1 = p0 + 2 * q;
+            float* p2 = p0 + 4 * q;
+            float* p3 = p0 + 6 * q;
+            const float t0r = p0[0] + p2[0], t0i = p0[1] + p2[1];
+            const float t1r = p0[0] - p2[0], t1i = p0[1] - p2[1];
+            const float t2r = p1[0] + p3[0], t2i = p1[1] + p3[1];
+            const float ur = p1[0] - p3[0], ui = p1[1] - p3[1];
+            // (b - d) rotated by -j (forward) or +j (inverse).
+            const float t3r = inverse ? -ui : ui;
+            const float t3i = inverse ? ur : -ur;
+            p0[0] = t0r + t2r;
+            p0[1] = t0i + t2i;
+            ref_cmul(t1r + t3r, t1i + t3i, w1 + 2 * k, p1);
+            ref_cmul(t0r - t2r, t0i - t2i, w2 + 2 * k, p2);
+            ref_cmul(t1r - t3r, t1i - t3i, w3 + 2 * k, p3);
+        }
+    }
+}
+
+// ---- Q15 --------------------------------------------------------------------
+// These mirror the vector instructions exactly: half() is pmulhrsw by 0x4000,
+// mul() is pmulhrsw / vqrdmulh, add() and sub() saturate. Twiddles never hold
+// -32768, which keeps every negation and product in range.
+
+inline std::int16_t q15_sat(std::int32_t v) noexcept {
+    return std::int16_t(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+}
+inline std::int16_t q15_half(std::int16_t v) noexcept {
+    return std::int16_t((std::int32_t(v) + 1) >> 1);
+}
+inline std::int16_t q15_mul(std::int16_t a, std::int16_t b) noexcept {
+    return std::int16_t((std::int32_t(a) * b + 0x4000) >> 15);
+}
+inline std::int16_t q15_add(std::int16_t a, std::int16_t b) noexcept {
+    return q15_sat(std::int32_t(a) + b);
+}
+inline std::int16_t q15_sub(std::int16_t a, std::int16_t b) noexcept {
+    return q15_sat(std::int32_t(a) - b);
+}
+
+inline void ref_cmul_q15(std::int16_t xr, std::int16_t xi, const std::int16_t* w,
+                         std::int16_t* out) noexcept {
+    out[0] = q15_sub(q15_mul(xr, w[0]), q15_mul(xi, w[1]));
+    out[1] = q15_add(q15_mul(xi, w[0]), q15_mul(xr, w[1]));
+}
+
+inline void ref_radix2_q15(std::int16_t* x, std::size_t span, std::size_t count,
+                           const std::int16_t* tw) noexcept {
+    const std::size_t h = span / 2;
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < h; ++k) {
+            std::int16_t* p0 = x + 2 * k;
+            std::int16_t* p1 = p0 + 2 * h;
+            const std::int16_t ar = q15_half(p0[0]), ai = q15_half(p0[1]);
+            const std::int16_t br = q15_half(p1[0]), bi = q15_half(p1[1]);
+            p0[0] = q15_add(ar, br);
+            p0[1] = q15_add(ai, bi);
+            ref_cmul_q15(q15_sub(ar, br), q15_sub(ai, bi), tw + 2 * k, p1);
+        }
+    }
+}
+
+inline void ref_radix4_q15(std::int16_t* x, std::size_t span, std::size_t count,
+                           const std::int16_t* tw, bool inverse) noexcept {
+    const std::size_t q = span / 4;
+    const std::int16_t* w1 = tw;
+    const std::int16_t* w2 = tw + 2 * q;
+    const std::int16_t* w3 = tw + 4 * q;
+    for (std::size_t s = 0; s < count; ++s, x += 2 * span) {
+        for (std::size_t k = 0; k < q; ++k) {
+            std::int16_t* p[4] = {x + 2 * k, x + 2 * (k + q), x + 2 * (k + 2 * q),
+                                  x + 2 * (k + 3 * q)};
+            std::int16_t v[4][2];
+            for (int r = 0; r < 4; ++r) {
+                v[r][0] = q15_half(p[r][0]);
+                v[r][1] = q15_half(p[r][1]);
+            }
+            const std::int16_t t0r = q15_half(q15_add(v[0][0], v[2][0]));
+            const std::int16_t t0i = q15_half(q15_add(v[0][1], v[2][1]));
+            const std::int16_t t1r = q15_half(q15_sub(v[0][0], v[2][0]));
+            const std::int16_t t1i = q15_half(q15_sub(v[0][1], v[2][1]));
+            const std::int16_t t2r = q15_half(q15_add(v[1][0], v[3][0]));
+            const std::int16_t t2i = q15_half(q15_add(v[1][1], v[3][1]));
+            const std::int16_t ur = q15_half(q15_sub(v[1][0], v[3][0]));
+            const std::int16_t ui = q15_half(q15_sub(v[1][1], v[3][1]));
+            const std::int16_t t3r = inverse ? std::int16_t(-ui) : ui;
+            const std::int16_t t3i = inverse ? ur : std::int16_t(-ur);
+            p[0][0] = q15_add(t0r, t2r);
+            p[0][1] = q15_add(t0i, t2i);
+            ref_cmul_q15(q15_add(t1r, t3r), q15_add(t1i, t3i), w1 + 2 * k, p[1]);
+            ref_cmul_q15(q15_sub(t0r, t2r), q15_sub(t0i, t2i), w2 + 2 * k, p[2]);
+            ref_cmul_q15(q15_sub(t1r, t3r), q15_sub(t1i, t3i), w3 + 2 * k, p[3]);
+        }
+    }
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
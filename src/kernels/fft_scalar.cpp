@@ -0,0 +1,29 @@
+#include "fft_kernels.hpp"
+#include "fft_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void radix2_scalar(float* x, std::size_t span, std::size_t count, const float* tw) {
+    ref_radix2(x, span, count, tw);
+}
+void radix4_scalar(float* x, std::size_t span, std::size_t count, const float* tw,
+                   bool inverse) {
+    ref_radix4(x, span, count, tw, inverse);
+}
+void radix2_q15_scalar(std::int16_t* x, std::size_t span, std::size_t count,
+                       const std::int16_t* tw) {
+    ref_radix2_q15(x, span, count, tw);
+}
+void radix4_q15_scalar(std::int16_t* x, std::size_t span, std::size_t count,
+                       const std::int16_t* tw, bool inverse) {
+    ref_radix4_q15(x, span, count, tw, inverse);
+}
+
+}  // namespace
+
+const FftKernels fft_scalar = {radix2_scalar, radix4_scalar, radix2_q15_scalar,
+                               radix4_q15_scalar};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,115 @@
+// AVX2 soft combining: 32 values per iteration. Floats are quantised as in
+// ldpc_avx2.cpp; nibbles are widened to 16-bit words (even value in the low
+// byte, odd in the high), so unpacking and repacking need no shuffles
+// beyond the final 16-to-8-bit pack.
+
+#include <immintrin.h>
+
+#include "harq_kernels.hpp"
+#include "harq_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+inline __m256i quantize8(const float* in, __m256 scale, __m256 limit) noexcept {
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 v = _mm256_min_ps(
+        _mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(in), scale), _mm256_xor_ps(limit, sign)),
+        limit);
+    // copysign(0.5, v), as in ldpc_avx2.cpp.
+    const __m256 half = _mm256_or_ps(_mm256_and_ps(v, sign), _mm256_set1_ps(0.5f));
+    return _mm256_cvttps_epi32(_mm256_add_ps(v, half));
+}
+
+/// Quantised in[0..32) as int8, in order.
+inline __m256i quantize32(const float* in, __m256 scale, __m256 limit) noexcept {
+    const __m256i a =
+        _mm256_packs_epi32(quantize8(in, scale, limit), quantize8(in + 8, scale, limit));
+    const __m256i b =
+        _mm256_packs_epi32(quantize8(in + 16, scale, limit), quantize8(in + 24, scale, limit));
+    // packs works per 128-bit lane; restore element order.
+    return _mm256_permutevar8x32_epi32(_mm256_packs_epi16(a, b),
+                                       _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+/// The 32 sign-extended nibbles of 16 bytes, in order.
+inline __m256i unpack_nibbles(const std::uint8_t* in) noexcept {
+    const __m256i w = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+    const __m256i low = _mm256_set1_epi16(0x0f);
+    const __m256i v = _mm256_or_si256(
+        _mm256_and_si256(w, low), _mm256_slli_epi16(_mm256_and_si256(_mm256_srli_epi16(w, 4), low), 8));
+    const __m256i eight = _mm256_set1_epi8(8);
+    return _mm256_sub_epi8(_mm256_xor_si256(v, eight), eight);
+}
+
+/// Inverse of unpack_nibbles for values in -8..7.
+inline void pack_nibbles(__m256i v, std::uint8_t* out) noexcept {
+    const __m256i t = _mm256_and_si256(v, _mm256_set1_epi8(0x0f));
+    const __m256i u =
+        _mm256_and_si256(_mm256_or_si256(t, _mm256_srli_epi16(t, 4)), _mm256_set1_epi16(0xff));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                     _mm_packus_epi16(_mm256_castsi256_si128(u), _mm256_extracti128_si256(u, 1)));
+}
+
+void combine_s8_avx2(std::int8_t* buf, const float* llrs, std::size_t n, float scale) {
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 limit = _mm256_set1_ps(127.0f);
+    const __m256i floor = _mm256_set1_epi8(-127);
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        auto* p = reinterpret_cast<__m256i*>(buf + i);
+        const __m256i sum = _mm256_adds_epi8(_mm256_loadu_si256(p), quantize32(llrs + i, vscale, limit));
+        _mm256_storeu_si256(p, _mm256_max_epi8(sum, floor));
+    }
+    ref_harq_combine_s8(buf + i, llrs + i, n - i, scale);
+}
+
+void combine_s4_avx2(std::uint8_t* buf, const float* llrs, std::size_t pairs, float scale) {
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 limit = _mm256_set1_ps(7.0f);
+    const __m256i lo = _mm256_set1_epi8(-7);
+    const __m256i hi = _mm256_set1_epi8(7);
+    std::size_t j = 0;
+    for (; j + 16 <= pairs; j += 16) {
+        const __m256i sum =
+            _mm256_add_epi8(unpack_nibbles(buf + j), quantize32(llrs + 2 * j, vscale, limit));
+        pack_nibbles(_mm256_min_epi8(_mm256_max_epi8(sum, lo), hi), buf + j);
+    }
+    ref_harq_combine_s4(buf + j, llrs + 2 * j, pairs - j, scale);
+}
+
+void expand_s4_avx2(const std::uint8_t* in, std::size_t pairs, std::int8_t* out) {
+    std::size_t j = 0;
+    for (; j + 16 <= pairs; j += 16) {
+        __m256i v = unpack_nibbles(in + j);
+        v = _mm256_add_epi8(v, v);
+        v = _mm256_add_epi8(v, v);
+        v = _mm256_add_epi8(v, v);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * j), v);
+    }
+    ref_harq_expand_s4(in + j, pairs - j, out + 2 * j);
+}
+
+void compress_s4_avx2(const std::int8_t* in, std::size_t pairs, std::uint8_t* out) {
+    const __m256i four = _mm256_set1_epi8(4);
+    const __m256i mask = _mm256_set1_epi8(0x1f);
+    const __m256i seven = _mm256_set1_epi8(7);
+    std::size_t j = 0;
+    for (; j + 16 <= pairs; j += 16) {
+        // Loaded before the store: out may equal in, and out + j <= in + 2j.
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * j));
+        // |v| + 4 <= 131 fits an unsigned byte.
+        __m256i r = _mm256_add_epi8(_mm256_abs_epi8(v), four);
+        r = _mm256_min_epu8(_mm256_and_si256(_mm256_srli_epi16(r, 3), mask), seven);
+        pack_nibbles(_mm256_sign_epi8(r, v), out + j);
+    }
+    ref_harq_compress_s4(in + 2 * j, pairs - j, out + j);
+}
+
+}  // namespace
+
+const HarqKernels harq_avx2 = {combine_s8_avx2, combine_s4_avx2, expand_s4_avx2,
+                               compress_s4_avx2};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,112 @@
+// AVX-512 soft combining: 64 values per iteration, same layout tricks as
+// harq_avx2.cpp with _mm512_cvtepi16_epi8 doing the repack and mask
+// registers the sign handling. Bit-exact with the reference.
+
+#include <immintrin.h>
+
+#include "harq_kernels.hpp"
+#include "harq_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+/// Quantised in[0..16) as int8.
+inline __m128i quantize16(const float* in, __m512 scale, __m512 limit) noexcept {
+    const __m512i sign = _mm512_set1_epi32(std::int32_t(0x80000000u));
+    const __m512 neg = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(limit), sign));
+    const __m512 v =
+        _mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(_mm512_loadu_ps(in), scale), neg), limit);
+    // copysign(0.5, v), as in ldpc_avx2.cpp.
+    const __m512i half = _mm512_or_si512(_mm512_and_si512(_mm512_castps_si512(v), sign),
+                                         _mm512_castps_si512(_mm512_set1_ps(0.5f)));
+    return _mm512_cvtepi32_epi8(_mm512_cvttps_epi32(_mm512_add_ps(v, _mm512_castsi512_ps(half))));
+}
+
+/// Quantised in[0..64) as int8, in order.
+inline __m512i quantize64(const float* in, __m512 scale, __m512 limit) noexcept {
+    __m512i q = _mm512_castsi128_si512(quantize16(in, scale, limit));
+    q = _mm512_inserti32x4(q, quantize16(in + 16, scale, limit), 1);
+    q = _mm512_inserti32x4(q, quantize16(in + 32, scale, limit), 2);
+    return _mm512_inserti32x4(q, quantize16(in + 48, scale, limit), 3);
+}
+
+/// The 64 sign-extended nibbles of 32 bytes, in order.
+inline __m512i unpack_nibbles(const std::uint8_t* in) noexcept {
+    const __m512i w =
+        _mm512_cvtepu8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)));
+    const __m512i low = _mm512_set1_epi16(0x0f);
+    const __m512i v = _mm512_or_si512(
+        _mm512_and_si512(w, low), _mm512_slli_epi16(_mm512_and_si512(_mm512_srli_epi16(w, 4), low), 8));
+    const __m512i eight = _mm512_set1_epi8(8);
+    return _mm512_sub_epi8(_mm512_xor_si512(v, eight), eight);
+}
+
+/// Inverse of unpack_nibbles for values in -8..7.
+inline void pack_nibbles(__m512i v, std::uint8_t* out) noexcept {
+    const __m512i t = _mm512_and_si512(v, _mm512_set1_epi8(0x0f));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                        _mm512_cvtepi16_epi8(_mm512_or_si512(t, _mm512_srli_epi16(t, 4))));
+}
+
+void combine_s8_avx512(std::int8_t* buf, const float* llrs, std::size_t n, float scale) {
+    const __m512 vscale = _mm512_set1_ps(scale);
+    const __m512 limit = _mm512_set1_ps(127.0f);
+    const __m512i floor = _mm512_set1_epi8(-127);
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        const __m512i sum =
+            _mm512_adds_epi8(_mm512_loadu_si512(buf + i), quantize64(llrs + i, vscale, limit));
+        _mm512_storeu_si512(buf + i, _mm512_max_epi8(sum, floor));
+    }
+    ref_harq_combine_s8(buf + i, llrs + i, n - i, scale);
+}
+
+void combine_s4_avx512(std::uint8_t* buf, const float* llrs, std::size_t pairs, float scale) {
+    const __m512 vscale = _mm512_set1_ps(scale);
+    const __m512 limit = _mm512_set1_ps(7.0f);
+    const __m512i lo = _mm512_set1_epi8(-7);
+    const __m512i hi = _mm512_set1_epi8(7);
+    std::size_t j = 0;
+    for (; j + 32 <= pairs; j += 32) {
+        const __m512i sum =
+            _mm512_add_epi8(unpack_nibbles(buf + j), quantize64(llrs + 2 * j, vscale, limit));
+        pack_nibbles(_mm512_min_epi8(_mm512_max_epi8(sum, lo), hi), buf + j);
+    }
+    ref_harq_combine_s4(buf + j, llrs + 2 * j, pairs - j, scale);
+}
+
+void expand_s4_avx512(const std::uint8_t* in, std::size_t pairs, std::int8_t* out) {
+    std::size_t j = 0;
+    for (; j + 32 <= pairs; j += 32) {
+        __m512i v = unpack_nibbles(in + j);
+        v = _mm512_add_epi8(v, v);
+        v = _mm512_add_epi8(v, v);
+        v = _mm512_add_epi8(v, v);
+        _mm512_storeu_si512(out + 2 * j, v);
+    }
+    ref_harq_expand_s4(in + j, pairs - j, out + 2 * j);
+}
+
+void compress_s4_avx512(const std::int8_t* in, std::size_t pairs, std::uint8_t* out) {
+    const __m512i four = _mm512_set1_epi8(4);
+    const __m512i mask = _mm512_set1_epi8(0x1f);
+    const __m512i seven = _mm512_set1_epi8(7);
+    std::size_t j = 0;
+    for (; j + 32 <= pairs; j += 32) {
+        // Loaded before the store: out may equal in, and out + j <= in + 2j.
+        const __m512i v = _mm512_loadu_si512(in + 2 * j);
+        __m512i r = _mm512_add_epi8(_mm512_abs_epi8(v), four);
+        r = _mm512_min_epu8(_mm512_and_si512(_mm512_srli_epi16(r, 3), mask), seven);
+        r = _mm512_mask_sub_epi8(r, _mm512_movepi8_mask(v), _mm512_setzero_si512(), r);
+        pack_nibbles(r, out + j);
+    }
+    ref_harq_compress_s4(in + 2 * j, pairs - j, out + j);
+}
+
+}  // namespace
+
+const HarqKernels harq_avx512 = {combine_s8_avx512, combine_s4_avx512, expand_s4_avx512,
+                                 compress_s4_avx512};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,40 @@
+#pragma once
+
+// Per-ISA soft-combining kernels behind HarqSoftBuffers.
+//
+// Stored soft bits are int8 LLRs in the units LdpcDecoder consumes
+// (round(llr * llr_scale)), either one per byte or two per byte as 4-bit
+// two's complement nibbles: value 2j in the low nibble of byte j, value
+// 2j + 1 in the high nibble. Incoming float LLRs are quantised as in
+// LdpcKernels::quantize (clamp, then round half away from zero) and added
+// with saturation. Every variant is bit-exact with the reference.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dcomm::kernels {
+
+struct HarqKernels {
+    /// buf[i] = clamp(buf[i] + q(llrs[i]), -127, 127) with
+    /// q(x) = clamp(x * scale, -127, 127) rounded half away from zero.
+    void (*combine_s8)(std::int8_t* buf, const float* llrs, std::size_t n, float scale);
+    /// Same on the 2 * pairs nibbles of buf, clamped to -7..7 at both
+    /// steps.
+    void (*combine_s4)(std::uint8_t* buf, const float* llrs, std::size_t pairs, float scale);
+    /// out[2j], out[2j + 1] = 8 * the low and high nibbles of in[j].
+    void (*expand_s4)(const std::uint8_t* in, std::size_t pairs, std::int8_t* out);
+    /// Nibbles of in[2j], in[2j + 1] divided by 8, rounded half away from
+    /// zero and clamped to -7..7, into out[j]. out may equal in.
+    void (*compress_s4)(const std::int8_t* in, std::size_t pairs, std::uint8_t* out);
+};
+
+extern const HarqKernels harq_scalar;
+#if defined(DCOMM_KERNELS_X86)
+extern const HarqKernels harq_avx2;
+extern const HarqKernels harq_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+extern const HarqKernels harq_neon;
+#endif
+
+}  // namespace dcomm::kernels
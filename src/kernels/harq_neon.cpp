@@ -0,0 +1,106 @@
+// NEON soft combining for AArch64: 32 values per iteration. vld2q / vst2q
+// split and merge even and odd values, which is exactly the nibble layout,
+// and vsliq packs the pairs. Bit-exact with the reference.
+
+#include <arm_neon.h>
+
+#include "harq_kernels.hpp"
+#include "harq_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+/// Quantised in[0..16) as int8.
+inline int8x16_t quantize16(const float* in, float scale, float32x4_t limit) noexcept {
+    const uint32x4_t sign = vdupq_n_u32(0x80000000u);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    int16x8_t q16[2];
+    for (unsigned h = 0; h < 2; ++h) {
+        int32x4_t q32[2];
+        for (unsigned j = 0; j < 2; ++j) {
+            const float32x4_t v = vminq_f32(
+                vmaxq_f32(vmulq_n_f32(vld1q_f32(in + 8 * h + 4 * j), scale), vnegq_f32(limit)),
+                limit);
+            // copysign(0.5, v), as in ldpc_neon.cpp.
+            q32[j] = vcvtq_s32_f32(vaddq_f32(v, vbslq_f32(sign, v, half)));
+        }
+        q16[h] = vcombine_s16(vmovn_s32(q32[0]), vmovn_s32(q32[1]));
+    }
+    return vcombine_s8(vmovn_s16(q16[0]), vmovn_s16(q16[1]));
+}
+
+/// Even and odd values of 16 bytes of nibbles.
+inline int8x16x2_t unpack_nibbles(const std::uint8_t* in) noexcept {
+    const int8x16_t b = vreinterpretq_s8_u8(vld1q_u8(in));
+    return {{vshrq_n_s8(vshlq_n_s8(b, 4), 4), vshrq_n_s8(b, 4)}};
+}
+
+inline uint8x16_t pack_nibbles(int8x16_t even, int8x16_t odd) noexcept {
+    return vsliq_n_u8(vandq_u8(vreinterpretq_u8_s8(even), vdupq_n_u8(0x0f)),
+                      vreinterpretq_u8_s8(odd), 4);
+}
+
+void combine_s8_neon(std::int8_t* buf, const float* llrs, std::size_t n, float scale) {
+    const float32x4_t limit = vdupq_n_f32(127.0f);
+    const int8x16_t floor = vdupq_n_s8(-127);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const int8x16_t sum = vqaddq_s8(vld1q_s8(buf + i), quantize16(llrs + i, scale, limit));
+        vst1q_s8(buf + i, vmaxq_s8(sum, floor));
+    }
+    ref_harq_combine_s8(buf + i, llrs + i, n - i, scale);
+}
+
+void combine_s4_neon(std::uint8_t* buf, const float* llrs, std::size_t pairs, float scale) {
+    const float32x4_t limit = vdupq_n_f32(7.0f);
+    const int8x16_t lo = vdupq_n_s8(-7);
+    const int8x16_t hi = vdupq_n_s8(7);
+    std::size_t j = 0;
+    for (; j + 16 <= pairs; j += 16) {
+        const int8x16_t q0 = quantize16(llrs + 2 * j, scale, limit);
+        const int8x16_t q1 = quantize16(llrs + 2 * j + 16, scale, limit);
+        const int8x16x2_t v = unpack_nibbles(buf + j);
+        const int8x16_t even = vaddq_s8(v.val[0], vuzp1q_s8(q0, q1));
+        const int8x16_t odd = vaddq_s8(v.val[1], vuzp2q_s8(q0, q1));
+        vst1q_u8(buf + j, pack_nibbles(vminq_s8(vmaxq_s8(even, lo), hi),
+                                       vminq_s8(vmaxq_s8(odd, lo), hi)));
+    }
+    ref_harq_combine_s4(buf + j, llrs + 2 * j, pairs - j, scale);
+}
+
+void expand_s4_neon(const std::uint8_t* in, std::size_t pairs, std::int8_t* out) {
+    std::size_t j = 0;
+    for (; j + 16 <= pairs; j += 16) {
+        int8x16x2_t v = unpack_nibbles(in + j);
+        v.val[0] = vshlq_n_s8(v.val[0], 3);
+        v.val[1] = vshlq_n_s8(v.val[1], 3);
+        vst2q_s8(out + 2 * j, v);
+    }
+    ref_harq_expand_s4(in + j, pairs - j, out + 2 * j);
+}
+
+/// round(v / 8) half away from zero, clamped to -7..7.
+inline int8x16_t eighth(int8x16_t v) noexcept {
+    const uint8x16_t a = vreinterpretq_u8_s8(vabsq_s8(v));
+    const int8x16_t r =
+        vreinterpretq_s8_u8(vminq_u8(vshrq_n_u8(vaddq_u8(a, vdupq_n_u8(4)), 3), vdupq_n_u8(7)));
+    return vbslq_s8(vcltzq_s8(v), vnegq_s8(r), r);
+}
+
+void compress_s4_neon(const std::int8_t* in, std::size_t pairs, std::uint8_t* out) {
+    std::size_t j = 0;
+    for (; j + 16 <= pairs; j += 16) {
+        // Loaded before the store: out may equal in, and out + j <= in + 2j.
+        const int8x16x2_t v = vld2q_s8(in + 2 * j);
+        vst1q_u8(out + j, pack_nibbles(eighth(v.val[0]), eighth(v.val[1])));
+    }
+    ref_harq_compress_s4(in + 2 * j, pairs - j, out + j);
+}
+
+}  // namespace
+
+const HarqKernels harq_neon = {combine_s8_neon, combine_s4_neon, expand_s4_neon,
+                               compress_s4_neon};
+
+}  // namespace dcomm::kernels
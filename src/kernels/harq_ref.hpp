@@ -0,0 +1,66 @@
+#pragma once
+
+// Scalar reference soft-combining kernels (see harq_kernels.hpp for the
+// contract). Internal linkage: every kernel translation unit includes this
+// for its tail.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace dcomm::kernels {
+namespace {
+
+inline int ref_harq_quantize(float llr, float scale, float limit) noexcept {
+    const float v = std::clamp(llr * scale, -limit, limit);
+    return int(v + (v < 0.0f ? -0.5f : 0.5f));
+}
+
+/// Sign-extended nibble.
+inline int ref_harq_nibble(unsigned v) noexcept { return int((v & 0x0fu) ^ 0x08u) - 8; }
+
+inline std::uint8_t ref_harq_pack(int even, int odd) noexcept {
+    return std::uint8_t((unsigned(even) & 0x0fu) | (unsigned(odd) & 0x0fu) << 4);
+}
+
+inline int ref_harq_eighth(int v) noexcept {
+    const int r = std::min((std::abs(v) + 4) >> 3, 7);
+    return v < 0 ? -r : r;
+}
+
+inline void ref_harq_combine_s8(std::int8_t* buf, const float* llrs, std::size_t n,
+                                float scale) noexcept {
+#pragma GCC ivdep
+    for (std::size_t i = 0; i < n; ++i) {
+        const int q = ref_harq_quantize(llrs[i], scale, 127.0f);
+        buf[i] = std::int8_t(std::clamp(buf[i] + q, -127, 127));
+    }
+}
+
+inline void ref_harq_combine_s4(std::uint8_t* buf, const float* llrs, std::size_t pairs,
+                                float scale) noexcept {
+    for (std::size_t j = 0; j < pairs; ++j) {
+        const int even = ref_harq_nibble(buf[j]) + ref_harq_quantize(llrs[2 * j], scale, 7.0f);
+        const int odd = ref_harq_nibble(buf[j] >> 4) + ref_harq_quantize(llrs[2 * j + 1], scale, 7.0f);
+        buf[j] = ref_harq_pack(std::clamp(even, -7, 7), std::clamp(odd, -7, 7));
+    }
+}
+
+inline void ref_harq_expand_s4(const std::uint8_t* in, std::size_t pairs,
+                               std::int8_t* out) noexcept {
+    for (std::size_t j = 0; j < pairs; ++j) {
+        out[2 * j] = std::int8_t(8 * ref_harq_nibble(in[j]));
+        out[2 * j + 1] = std::int8_t(8 * ref_harq_nibble(in[j] >> 4));
+    }
+}
+
+inline void ref_harq_compress_s4(const std::int8_t* in, std::size_t pairs,
+                                 std::uint8_t* out) noexcept {
+    for (std::size_t j = 0; j < pairs; ++j) {
+        out[j] = ref_harq_pack(ref_harq_eighth(in[2 * j]), ref_harq_eighth(in[2 * j + 1]));
+    }
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
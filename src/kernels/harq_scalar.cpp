@@ -0,0 +1,29 @@
+#include "harq_kernels.hpp"
+#include "harq_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void combine_s8_scalar(std::int8_t* buf, const float* llrs, std::size_t n, float scale) {
+    ref_harq_combine_s8(buf, llrs, n, scale);
+}
+
+void combine_s4_scalar(std::uint8_t* buf, const float* llrs, std::size_t pairs, float scale) {
+    ref_harq_combine_s4(buf, llrs, pairs, scale);
+}
+
+void expand_s4_scalar(const std::uint8_t* in, std::size_t pairs, std::int8_t* out) {
+    ref_harq_expand_s4(in, pairs, out);
+}
+
+void compress_s4_scalar(const std::int8_t* in, std::size_t pairs, std::uint8_t* out) {
+    ref_harq_compress_s4(in, pairs, out);
+}
+
+}  // namespace
+
+const HarqKernels harq_scalar = {combine_s8_scalar, combine_s4_scalar, expand_s4_scalar,
+                                 compress_s4_scalar};
+
+}  // namespace dcomm::kernels
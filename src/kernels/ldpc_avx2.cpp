@@ -0,0 +1,131 @@
+// AVX2 layered min-sum: 32 checks per register. The two-minimum search is
+// branch-free (min2 = min(min2, max(min1, a)) before min1 moves), which is
+// exactly the reference's if/else-if order, and the sign of each outgoing
+// message comes from _mm256_sign_epi8 against (total sign ^ own sign) | 1.
+// The variable-to-check values are recomputed in the second pass rather
+// than stored by the first, which keeps the row loads free of
+// store-forwarding stalls.
+
+#include <immintrin.h>
+
+#include "ldpc_kernels.hpp"
+#include "ldpc_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+inline __m256i scale(__m256i m, __m256i alpha) noexcept {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lo = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(m, zero), alpha), 3);
+    const __m256i hi = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(m, zero), alpha), 3);
+    return _mm256_packus_epi16(lo, hi);
+}
+
+inline __m256i load(const std::int8_t* p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+inline void store(std::int8_t* p, __m256i v) noexcept {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+bool layer_avx2(std::int8_t* const* rows, std::int8_t* check, std::size_t degree,
+                std::size_t lanes, std::size_t z, unsigned alpha) {
+    const __m256i floor = _mm256_set1_epi8(-127);
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i valpha = _mm256_set1_epi16(std::int16_t(alpha));
+    bool satisfied = true;
+    for (std::size_t c = 0; c < lanes; c += 32) {
+        __m256i min1 = _mm256_set1_epi8(127);
+        __m256i min2 = min1;
+        __m256i idx = _mm256_setzero_si256();
+        __m256i sign = _mm256_setzero_si256();
+        __m256i parity = _mm256_setzero_si256();
+        for (std::size_t k = 0; k < degree; ++k) {
+            const __m256i v = load(rows[k] + c);
+            parity = _mm256_xor_si256(parity, v);
+            const __m256i t = _mm256_max_epi8(_mm256_subs_epi8(v, load(check + k * lanes + c)), floor);
+            sign = _mm256_xor_si256(sign, t);
+            const __m256i a = _mm256_abs_epi8(t);
+            const __m256i below = _mm256_cmpgt_epi8(min1, a);
+            min2 = _mm256_min_epi8(min2, _mm256_max_epi8(min1, a));
+            idx = _mm256_blendv_epi8(idx, _mm256_set1_epi8(char(k)), below);
+            min1 = _mm256_min_epi8(min1, a);
+        }
+        if (c < z) {
+            const std::uint32_t odd = std::uint32_t(_mm256_movemask_epi8(parity));
+            const std::uint32_t valid = z - c >= 32 ? ~0u : (1u << (z - c)) - 1;
+            satisfied &= (odd & valid) == 0;
+        }
+        const __m256i m1 = scale(min1, valpha);
+        const __m256i m2 = scale(min2, valpha);
+        for (std::size_t k = 0; k < degree; ++k) {
+            std::int8_t* p = rows[k] + c;
+            std::int8_t* q = check + k * lanes + c;
+            const __m256i t = _mm256_max_epi8(_mm256_subs_epi8(load(p), load(q)), floor);
+            const __m256i mag =
+                _mm256_blendv_epi8(m1, m2, _mm256_cmpeq_epi8(idx, _mm256_set1_epi8(char(k))));
+            const __m256i r = _mm256_sign_epi8(mag, _mm256_or_si256(_mm256_xor_si256(sign, t), one));
+            store(q, r);
+            store(p, _mm256_max_epi8(_mm256_adds_epi8(t, r), floor));
+        }
+    }
+    return satisfied;
+}
+
+bool parity_avx2(std::int8_t* const* rows, std::size_t degree, std::size_t,
+                 std::size_t z) {
+    for (std::size_t c = 0; c < z; c += 32) {
+        __m256i parity = _mm256_setzero_si256();
+        for (std::size_t k = 0; k < degree; ++k) {
+            parity = _mm256_xor_si256(parity, load(rows[k] + c));
+        }
+        const std::uint32_t odd = std::uint32_t(_mm256_movemask_epi8(parity));
+        const std::uint32_t valid = z - c >= 32 ? ~0u : (1u << (z - c)) - 1;
+        if ((odd & valid) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline __m256i quantize8(const float* in, __m256 scale) noexcept {
+    const __m256 lo = _mm256_set1_ps(-127.0f);
+    const __m256 hi = _mm256_set1_ps(127.0f);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 v = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(in), scale), lo), hi);
+    // copysign(0.5, v): -0.0 rounds to -0.5 and truncates to 0 like +0.5.
+    const __m256 half = _mm256_or_ps(_mm256_and_ps(v, sign), _mm256_set1_ps(0.5f));
+    return _mm256_cvttps_epi32(_mm256_add_ps(v, half));
+}
+
+void quantize_avx2(const float* in, std::size_t n, float scale, std::int8_t* out) {
+    const __m256 vscale = _mm256_set1_ps(scale);
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i a = _mm256_packs_epi32(quantize8(in + i, vscale), quantize8(in + i + 8, vscale));
+        const __m256i b =
+            _mm256_packs_epi32(quantize8(in + i + 16, vscale), quantize8(in + i + 24, vscale));
+        // packs works per 128-bit lane; restore element order.
+        const __m256i packed = _mm256_packs_epi16(a, b);
+        store(out + i, _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)));
+    }
+    ref_ldpc_quantize(in + i, n - i, scale, out + i);
+}
+
+void hard_avx2(const std::int8_t* in, std::size_t n, std::uint8_t* out) {
+    const __m256i one = _mm256_set1_epi8(1);
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v = load(in + i);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_setzero_si256(), v), one));
+    }
+    ref_ldpc_hard(in + i, n - i, out + i);
+}
+
+}  // namespace
+
+const LdpcKernels ldpc_avx2 = {layer_avx2, parity_avx2, quantize_avx2, hard_avx2};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,175 @@
+// AVX-512 layered min-sum, same algorithm as ldpc_avx2.cpp. Rows are
+// padded to 32 lanes only, so a row is a run of 64-lane chunks plus at most
+// one 32-lane chunk; both widths share one body through the traits below
+// (the 256-bit one uses the AVX-512VL mask forms).
+
+#include <immintrin.h>
+
+#include "ldpc_kernels.hpp"
+#include "ldpc_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+struct Zmm {
+    using V = __m512i;
+    using M = __mmask64;
+    static constexpr std::size_t kLanes = 64;
+    static V load(const std::int8_t* p) noexcept { return _mm512_loadu_si512(p); }
+    static void store(std::int8_t* p, V v) noexcept { _mm512_storeu_si512(p, v); }
+    static V set1(int v) noexcept { return _mm512_set1_epi8(char(v)); }
+    static V zero() noexcept { return _mm512_setzero_si512(); }
+    static V subs(V a, V b) noexcept { return _mm512_subs_epi8(a, b); }
+    static V adds(V a, V b) noexcept { return _mm512_adds_epi8(a, b); }
+    static V max(V a, V b) noexcept { return _mm512_max_epi8(a, b); }
+    static V min(V a, V b) noexcept { return _mm512_min_epi8(a, b); }
+    static V abs(V a) noexcept { return _mm512_abs_epi8(a); }
+    static V bxor(V a, V b) noexcept { return _mm512_xor_si512(a, b); }
+    static M gt(V a, V b) noexcept { return _mm512_cmpgt_epi8_mask(a, b); }
+    static M eq(V a, V b) noexcept { return _mm512_cmpeq_epi8_mask(a, b); }
+    static M sign_mask(V a) noexcept { return _mm512_movepi8_mask(a); }
+    static V blend(M m, V a, V b) noexcept { return _mm512_mask_blend_epi8(m, a, b); }
+    static V negate(V a, M m) noexcept { return _mm512_mask_sub_epi8(a, m, zero(), a); }
+    static V scale(V m, std::int16_t alpha) noexcept {
+        const V a = _mm512_set1_epi16(alpha);
+        const V lo = _mm512_srli_epi16(_mm512_mullo_epi16(_mm512_unpacklo_epi8(m, zero()), a), 3);
+        const V hi = _mm512_srli_epi16(_mm512_mullo_epi16(_mm512_unpackhi_epi8(m, zero()), a), 3);
+        return _mm512_packus_epi16(lo, hi);
+    }
+};
+
+struct Ymm {
+    using V = __m256i;
+    using M = __mmask32;
+    static constexpr std::size_t kLanes = 32;
+    static V load(const std::int8_t* p) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    static void store(std::int8_t* p, V v) noexcept {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    static V set1(int v) noexcept { return _mm256_set1_epi8(char(v)); }
+    static V zero() noexcept { return _mm256_setzero_si256(); }
+    static V subs(V a, V b) noexcept { return _mm256_subs_epi8(a, b); }
+    static V adds(V a, V b) noexcept { return _mm256_adds_epi8(a, b); }
+    static V max(V a, V b) noexcept { return _mm256_max_epi8(a, b); }
+    static V min(V a, V b) noexcept { return _mm256_min_epi8(a, b); }
+    static V abs(V a) noexcept { return _mm256_abs_epi8(a); }
+    static V bxor(V a, V b) noexcept { return _mm256_xor_si256(a, b); }
+    static M gt(V a, V b) noexcept { return _mm256_cmpgt_epi8_mask(a, b); }
+    static M eq(V a, V b) noexcept { return _mm256_cmpeq_epi8_mask(a, b); }
+    static M sign_mask(V a) noexcept { return _mm256_movepi8_mask(a); }
+    static V blend(M m, V a, V b) noexcept { return _mm256_mask_blend_epi8(m, a, b); }
+    static V negate(V a, M m) noexcept { return _mm256_mask_sub_epi8(a, m, zero(), a); }
+    static V scale(V m, std::int16_t alpha) noexcept {
+        const V a = _mm256_set1_epi16(alpha);
+        const V lo = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(m, zero()), a), 3);
+        const V hi = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(m, zero()), a), 3);
+        return _mm256_packus_epi16(lo, hi);
+    }
+};
+
+/// One chunk of W::kLanes checks starting at lane c; returns satisfied.
+template <class W>
+bool chunk(std::int8_t* const* rows, std::int8_t* check, std::size_t degree, std::size_t lanes,
+           std::size_t c, std::size_t z, unsigned alpha) noexcept {
+    using V = typename W::V;
+    using M = typename W::M;
+    const V floor = W::set1(-127);
+    V min1 = W::set1(127);
+    V min2 = min1;
+    V idx = W::zero();
+    V sign = W::zero();
+    V parity = W::zero();
+    for (std::size_t k = 0; k < degree; ++k) {
+        const V v = W::load(rows[k] + c);
+        parity = W::bxor(parity, v);
+        const V t = W::max(W::subs(v, W::load(check + k * lanes + c)), floor);
+        sign = W::bxor(sign, t);
+        const V a = W::abs(t);
+        const M below = W::gt(min1, a);
+        min2 = W::min(min2, W::max(min1, a));
+        idx = W::blend(below, idx, W::set1(int(k)));
+        min1 = W::min(min1, a);
+    }
+    bool satisfied = true;
+    if (c < z) {
+        const M valid = z - c >= W::kLanes ? M(~M(0)) : M((M(1) << (z - c)) - 1);
+        satisfied = (W::sign_mask(parity) & valid) == 0;
+    }
+    const V m1 = W::scale(min1, std::int16_t(alpha));
+    const V m2 = W::scale(min2, std::int16_t(alpha));
+    for (std::size_t k = 0; k < degree; ++k) {
+        std::int8_t* p = rows[k] + c;
+        std::int8_t* q = check + k * lanes + c;
+        const V t = W::max(W::subs(W::load(p), W::load(q)), floor);
+        const V mag = W::blend(W::eq(idx, W::set1(int(k))), m1, m2);
+        const V r = W::negate(mag, W::sign_mask(W::bxor(sign, t)));
+        W::store(q, r);
+        W::store(p, W::max(W::adds(t, r), floor));
+    }
+    return satisfied;
+}
+
+bool layer_avx512(std::int8_t* const* rows, std::int8_t* check, std::size_t degree,
+                  std::size_t lanes, std::size_t z, unsigned alpha) {
+    bool satisfied = true;
+    std::size_t c = 0;
+    for (; c + 64 <= lanes; c += 64) {
+        satisfied &= chunk<Zmm>(rows, check, degree, lanes, c, z, alpha);
+    }
+    if (c < lanes) {
+        satisfied &= chunk<Ymm>(rows, check, degree, lanes, c, z, alpha);
+    }
+    return satisfied;
+}
+
+bool parity_avx512(std::int8_t* const* rows, std::size_t degree, std::size_t lanes,
+                   std::size_t z) {
+    for (std::size_t c = 0; c < z; c += 64) {
+        const __mmask64 live = lanes - c >= 64 ? ~__mmask64(0) : __mmask64(0xffffffffu);
+        __m512i parity = _mm512_setzero_si512();
+        for (std::size_t k = 0; k < degree; ++k) {
+            parity = _mm512_xor_si512(parity, _mm512_maskz_loadu_epi8(live, rows[k] + c));
+        }
+        const __mmask64 valid = z - c >= 64 ? ~__mmask64(0) : (__mmask64(1) << (z - c)) - 1;
+        if ((_mm512_movepi8_mask(parity) & valid) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void quantize_avx512(const float* in, std::size_t n, float scale, std::int8_t* out) {
+    const __m512 vscale = _mm512_set1_ps(scale);
+    const __m512 lo = _mm512_set1_ps(-127.0f);
+    const __m512 hi = _mm512_set1_ps(127.0f);
+    const __m512i sign = _mm512_set1_epi32(std::int32_t(0x80000000u));
+    const __m512i half = _mm512_castps_si512(_mm512_set1_ps(0.5f));
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512 v = _mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(_mm512_loadu_ps(in + i), vscale), lo), hi);
+        // copysign(0.5, v), as in the AVX2 variant.
+        const __m512i h = _mm512_or_si512(_mm512_and_si512(_mm512_castps_si512(v), sign), half);
+        const __m512i q = _mm512_cvttps_epi32(_mm512_add_ps(v, _mm512_castsi512_ps(h)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm512_cvtepi32_epi8(q));
+    }
+    ref_ldpc_quantize(in + i, n - i, scale, out + i);
+}
+
+void hard_avx512(const std::int8_t* in, std::size_t n, std::uint8_t* out) {
+    const __m512i one = _mm512_set1_epi8(1);
+    std::size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        const __mmask64 negative = _mm512_movepi8_mask(_mm512_loadu_si512(in + i));
+        _mm512_storeu_si512(out + i, _mm512_maskz_mov_epi8(negative, one));
+    }
+    ref_ldpc_hard(in + i, n - i, out + i);
+}
+
+}  // namespace
+
+const LdpcKernels ldpc_avx512 = {layer_avx512, parity_avx512, quantize_avx512, hard_avx512};
+
+}  // namespace dcomm::kernels
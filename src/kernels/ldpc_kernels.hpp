@@ -0,0 +1,46 @@
+#pragma once
+
+// Per-ISA check-node kernel behind LdpcDecoder.
+//
+// The decoder presents the `degree` a-posteriori blocks of one layer (one
+// base-graph row) as rows of `lanes` int8 values, each cyclically rotated by
+// its shift, so that lane i of every row belongs to check i of the layer.
+// `rows[k]` points at row k and is updated in place; `check` holds the
+// layer's check-to-variable messages as consecutive rows of `lanes` values.
+// `lanes` is a multiple of 32; lanes >= z are computed but never read.
+//
+// All values stay in [-127, 127]. The update is normalised min-sum with
+// factor alpha / 8, and every variant is bit-exact with the reference.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dcomm::kernels {
+
+inline constexpr std::size_t kLdpcLaneAlign = 32;
+
+struct LdpcKernels {
+    /// Update one layer in place. Returns true if the hard decisions of the
+    /// incoming a-posteriori values satisfied all z checks of the layer.
+    bool (*layer)(std::int8_t* const* rows, std::int8_t* check, std::size_t degree,
+                  std::size_t lanes, std::size_t z, unsigned alpha);
+    /// True if the hard decisions of `rows` (same layout) satisfy all z
+    /// checks.
+    bool (*parity)(std::int8_t* const* rows, std::size_t degree, std::size_t lanes,
+                   std::size_t z);
+    /// out[i] = clamp(in[i] * scale, -127, 127) rounded half away from zero.
+    void (*quantize)(const float* in, std::size_t n, float scale, std::int8_t* out);
+    /// out[i] = in[i] < 0.
+    void (*hard_decisions)(const std::int8_t* in, std::size_t n, std::uint8_t* out);
+};
+
+extern const LdpcKernels ldpc_scalar;
+#if defined(DCOMM_KERNELS_X86)
+extern const LdpcKernels ldpc_avx2;
+extern const LdpcKernels ldpc_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+extern const LdpcKernels ldpc_neon;
+#endif
+
+}  // namespace dcomm::kernels
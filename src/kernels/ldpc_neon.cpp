@@ -0,0 +1,122 @@
+// NEON layered min-sum: 16 checks per register, same algorithm as
+// ldpc_avx2.cpp with vbsl selects in place of blends and sign tricks.
+
+#include <arm_neon.h>
+
+#include "ldpc_kernels.hpp"
+#include "ldpc_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+inline int8x16_t scale(int8x16_t m, uint8x8_t alpha) noexcept {
+    const uint8x16_t u = vreinterpretq_u8_s8(m);
+    const uint8x8_t lo = vshrn_n_u16(vmull_u8(vget_low_u8(u), alpha), 3);
+    const uint8x8_t hi = vshrn_n_u16(vmull_u8(vget_high_u8(u), alpha), 3);
+    return vreinterpretq_s8_u8(vcombine_u8(lo, hi));
+}
+
+bool layer_neon(std::int8_t* const* rows, std::int8_t* check, std::size_t degree,
+                std::size_t lanes, std::size_t z, unsigned alpha) {
+    const int8x16_t floor = vdupq_n_s8(-127);
+    const int8x16_t zero = vdupq_n_s8(0);
+    const uint8x8_t valpha = vdup_n_u8(std::uint8_t(alpha));
+    const uint8x16_t iota = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    bool satisfied = true;
+    for (std::size_t c = 0; c < lanes; c += 16) {
+        int8x16_t min1 = vdupq_n_s8(127);
+        int8x16_t min2 = min1;
+        int8x16_t idx = zero;
+        int8x16_t sign = zero;
+        int8x16_t parity = zero;
+        for (std::size_t k = 0; k < degree; ++k) {
+            const int8x16_t v = vld1q_s8(rows[k] + c);
+            parity = veorq_s8(parity, v);
+            const int8x16_t t = vmaxq_s8(vqsubq_s8(v, vld1q_s8(check + k * lanes + c)), floor);
+            sign = veorq_s8(sign, t);
+            const int8x16_t a = vabsq_s8(t);
+            const uint8x16_t below = vcgtq_s8(min1, a);
+            min2 = vminq_s8(min2, vmaxq_s8(min1, a));
+            idx = vbslq_s8(below, vdupq_n_s8(std::int8_t(k)), idx);
+            min1 = vminq_s8(min1, a);
+        }
+        if (c < z) {
+            uint8x16_t odd = vcltq_s8(parity, zero);
+            if (z - c < 16) {
+                odd = vandq_u8(odd, vcltq_u8(iota, vdupq_n_u8(std::uint8_t(z - c))));
+            }
+            satisfied &= vmaxvq_u8(odd) == 0;
+        }
+        const int8x16_t m1 = scale(min1, valpha);
+        const int8x16_t m2 = scale(min2, valpha);
+        for (std::size_t k = 0; k < degree; ++k) {
+            std::int8_t* p = rows[k] + c;
+            std::int8_t* q = check + k * lanes + c;
+            const int8x16_t t = vmaxq_s8(vqsubq_s8(vld1q_s8(p), vld1q_s8(q)), floor);
+            const int8x16_t mag = vbslq_s8(vceqq_s8(idx, vdupq_n_s8(std::int8_t(k))), m2, m1);
+            const uint8x16_t negative = vcltq_s8(veorq_s8(sign, t), zero);
+            const int8x16_t r = vbslq_s8(negative, vnegq_s8(mag), mag);
+            vst1q_s8(q, r);
+            vst1q_s8(p, vmaxq_s8(vqaddq_s8(t, r), floor));
+        }
+    }
+    return satisfied;
+}
+
+bool parity_neon(std::int8_t* const* rows, std::size_t degree, std::size_t,
+                 std::size_t z) {
+    const uint8x16_t iota = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    for (std::size_t c = 0; c < z; c += 16) {
+        int8x16_t parity = vdupq_n_s8(0);
+        for (std::size_t k = 0; k < degree; ++k) {
+            parity = veorq_s8(parity, vld1q_s8(rows[k] + c));
+        }
+        uint8x16_t odd = vcltq_s8(parity, vdupq_n_s8(0));
+        if (z - c < 16) {
+            odd = vandq_u8(odd, vcltq_u8(iota, vdupq_n_u8(std::uint8_t(z - c))));
+        }
+        if (vmaxvq_u8(odd) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void quantize_neon(const float* in, std::size_t n, float scale, std::int8_t* out) {
+    const float32x4_t lo = vdupq_n_f32(-127.0f);
+    const float32x4_t hi = vdupq_n_f32(127.0f);
+    const uint32x4_t sign = vdupq_n_u32(0x80000000u);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        int16x8_t q16[2];
+        for (unsigned h = 0; h < 2; ++h) {
+            int32x4_t q32[2];
+            for (unsigned j = 0; j < 2; ++j) {
+                const float* p = in + i + 8 * h + 4 * j;
+                const float32x4_t v = vminq_f32(vmaxq_f32(vmulq_n_f32(vld1q_f32(p), scale), lo), hi);
+                // copysign(0.5, v), as in the AVX2 variant.
+                const float32x4_t r = vbslq_f32(sign, v, half);
+                q32[j] = vcvtq_s32_f32(vaddq_f32(v, r));
+            }
+            q16[h] = vcombine_s16(vmovn_s32(q32[0]), vmovn_s32(q32[1]));
+        }
+        vst1q_s8(out + i, vcombine_s8(vmovn_s16(q16[0]), vmovn_s16(q16[1])));
+    }
+    ref_ldpc_quantize(in + i, n - i, scale, out + i);
+}
+
+void hard_neon(const std::int8_t* in, std::size_t n, std::uint8_t* out) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        vst1q_u8(out + i, vshrq_n_u8(vreinterpretq_u8_s8(vld1q_s8(in + i)), 7));
+    }
+    ref_ldpc_hard(in + i, n - i, out + i);
+}
+
+}  // namespace
+
+const LdpcKernels ldpc_neon = {layer_neon, parity_neon, quantize_neon, hard_neon};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,86 @@
+#pragma once
+
+// Scalar reference of the layered min-sum update (see ldpc_kernels.hpp).
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace dcomm::kernels {
+namespace {
+
+inline std::int8_t ref_sat8(int v) noexcept {
+    return std::int8_t(std::clamp(v, -127, 127));
+}
+
+inline bool ref_ldpc_layer(std::int8_t* const* rows, std::int8_t* check, std::size_t degree,
+                           std::size_t lanes, std::size_t z,
+                           unsigned alpha) noexcept {
+    bool satisfied = true;
+    for (std::size_t i = 0; i < lanes; ++i) {
+        int min1 = 127;
+        int min2 = 127;
+        std::size_t idx = 0;
+        bool sign = false;
+        bool parity = false;
+        for (std::size_t k = 0; k < degree; ++k) {
+            std::int8_t& v = rows[k][i];
+            parity ^= v < 0;
+            const std::int8_t t = ref_sat8(v - check[k * lanes + i]);
+            v = t;
+            sign ^= t < 0;
+            const int a = t < 0 ? -t : t;
+            if (a < min1) {
+                min2 = min1;
+                min1 = a;
+                idx = k;
+            } else if (a < min2) {
+                min2 = a;
+            }
+        }
+        if (i < z && parity) {
+            satisfied = false;
+        }
+        const int m1 = (min1 * int(alpha)) >> 3;
+        const int m2 = (min2 * int(alpha)) >> 3;
+        for (std::size_t k = 0; k < degree; ++k) {
+            std::int8_t& v = rows[k][i];
+            const int mag = k == idx ? m2 : m1;
+            const int r = (sign ^ (v < 0)) ? -mag : mag;
+            check[k * lanes + i] = std::int8_t(r);
+            v = ref_sat8(v + r);
+        }
+    }
+    return satisfied;
+}
+
+inline bool ref_ldpc_parity(std::int8_t* const* rows, std::size_t degree,
+                            std::size_t z) noexcept {
+    for (std::size_t i = 0; i < z; ++i) {
+        bool parity = false;
+        for (std::size_t k = 0; k < degree; ++k) {
+            parity ^= rows[k][i] < 0;
+        }
+        if (parity) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline void ref_ldpc_quantize(const float* in, std::size_t n, float scale,
+                              std::int8_t* out) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        const float v = std::clamp(in[i] * scale, -127.0f, 127.0f);
+        out[i] = std::int8_t(v + (v < 0.0f ? -0.5f : 0.5f));
+    }
+}
+
+inline void ref_ldpc_hard(const std::int8_t* in, std::size_t n, std::uint8_t* out) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = in[i] < 0;
+    }
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
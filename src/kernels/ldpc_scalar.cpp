@@ -0,0 +1,30 @@
+#include "ldpc_kernels.hpp"
+#include "ldpc_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+bool layer_scalar(std::int8_t* const* rows, std::int8_t* check, std::size_t degree,
+                  std::size_t lanes, std::size_t z, unsigned alpha) {
+    return ref_ldpc_layer(rows, check, degree, lanes, z, alpha);
+}
+
+bool parity_scalar(std::int8_t* const* rows, std::size_t degree, std::size_t,
+                   std::size_t z) {
+    return ref_ldpc_parity(rows, degree, z);
+}
+
+void quantize_scalar(const float* in, std::size_t n, float scale, std::int8_t* out) {
+    ref_ldpc_quantize(in, n, scale, out);
+}
+
+void hard_scalar(const std::int8_t* in, std::size_t n, std::uint8_t* out) {
+    ref_ldpc_hard(in, n, out);
+}
+
+}  // namespace
+
+const LdpcKernels ldpc_scalar = {layer_scalar, parity_scalar, quantize_scalar, hard_scalar};
+
+}  // namespace dcomm::kernels
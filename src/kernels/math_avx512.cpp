@@ -0,0 +1,22 @@
+// AVX-512 fast-math kernels: the reference loops, sixteen lanes per
+// instruction with the table reads as gathers.
+
+#include "math_kernels.hpp"
+#include "math_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void nco_mix_avx512(const float* x, std::size_t n, std::uint32_t phase, std::uint32_t step,
+                    float* out) {
+    ref_nco_mix(math_tables(), x, n, phase, step, out);
+}
+
+void angle_avx512(const float* x, std::size_t n, float* out) { ref_angle(x, n, out); }
+
+}  // namespace
+
+const MathKernels math_avx512 = {nco_mix_avx512, angle_avx512};
+
+}  // namespace dcomm::kernels
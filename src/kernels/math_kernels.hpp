@@ -0,0 +1,51 @@
+#pragma once
+
+// Per-ISA kernels behind fast_math.hpp: table/polynomial replacements for
+// the libm calls of the per-sample DSP loops.
+//
+// Each kernel is the reference loop of math_ref.hpp in every variant,
+// vectorised by the compiler under the translation unit's ISA flags; the
+// table reads become gathers on AVX2 and AVX-512. Nothing is reassociated
+// and the build disables FMA contraction, so all variants agree bit for
+// bit. Outputs may be the same buffer as the input but must not otherwise
+// overlap it.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dcomm::kernels {
+
+/// Lookup tables shared by every variant, filled from libm once.
+struct MathTables {
+    static constexpr int kSinCosBits = 10;
+    static constexpr std::size_t kSinCosSize = std::size_t(1) << kSinCosBits;
+    /// log(1 + exp(-x)) is tabulated at x = i / kJacobianStep.
+    static constexpr float kJacobianStep = 16.0f;
+    static constexpr std::size_t kJacobianSize = 161;  // x in [0, 10]
+
+    alignas(64) float cos[kSinCosSize];  ///< cos(2 pi i / kSinCosSize)
+    alignas(64) float sin[kSinCosSize];
+    alignas(64) float jacobian[kJacobianSize];
+};
+
+const MathTables& math_tables() noexcept;
+
+struct MathKernels {
+    /// out[i] = x[i] * exp(j 2 pi (phase + i step) / 2^32) over n
+    /// interleaved samples, phase arithmetic modulo 2^32.
+    void (*nco_mix)(const float* x, std::size_t n, std::uint32_t phase, std::uint32_t step,
+                    float* out);
+    /// out[i] = atan2(x[2i + 1], x[2i]) over n interleaved samples.
+    void (*angle)(const float* x, std::size_t n, float* out);
+};
+
+extern const MathKernels math_scalar;
+#if defined(DCOMM_KERNELS_X86)
+extern const MathKernels math_avx2;
+extern const MathKernels math_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+extern const MathKernels math_neon;
+#endif
+
+}  // namespace dcomm::kernels
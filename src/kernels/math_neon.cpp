@@ -0,0 +1,22 @@
+// NEON fast-math kernels: the reference loops, four lanes per
+// instruction; NEON has no gather, so the table reads stay scalar.
+
+#include "math_kernels.hpp"
+#include "math_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void nco_mix_neon(const float* x, std::size_t n, std::uint32_t phase, std::uint32_t step,
+                  float* out) {
+    ref_nco_mix(math_tables(), x, n, phase, step, out);
+}
+
+void angle_neon(const float* x, std::size_t n, float* out) { ref_angle(x, n, out); }
+
+}  // namespace
+
+const MathKernels math_neon = {nco_mix_neon, angle_neon};
+
+}  // namespace dcomm::kernels
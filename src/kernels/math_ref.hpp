@@ -0,0 +1,99 @@
+#pragma once
+
+// Reference fast-math kernels (see math_kernels.hpp for the contract and
+// fast_math.hpp for the error bounds). Internal linkage: every kernel
+// translation unit includes this and compiles it for its own ISA.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "math_kernels.hpp"
+
+namespace dcomm::kernels {
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+constexpr float kHalfPi = 1.57079632679490f;
+constexpr float kQuarterPi = 0.785398163397448f;
+constexpr float kTanPi8 = 0.414213562373095f;
+/// Radians per unit of a 32-bit phase, 2 pi / 2^32.
+constexpr float kPhaseRadian = 1.46291807926716e-9f;
+constexpr std::uint32_t kSinCosShift = 32 - MathTables::kSinCosBits;
+constexpr std::uint32_t kSinCosFraction = (std::uint32_t(1) << kSinCosShift) - 1;
+/// Cephes atanf minimax polynomial on [0, tan(pi/8)]:
+/// atan(z) ~ z + z^3 (P0 z^6 + P1 z^4 + P2 z^2 + P3).
+constexpr float kAtanP[4] = {8.05374449538e-2f, -1.38776856032e-1f, 1.99777106478e-1f,
+                             -3.33329491539e-1f};
+
+/// cos and sin of 2 pi p / 2^32: the table entry of the top bits, turned
+/// by the remaining angle d < 2 pi / 1024 with the second-order terms of
+/// the angle-sum formulas.
+inline void ref_sincos(const MathTables& t, std::uint32_t p, float& c, float& s) noexcept {
+    const std::uint32_t i = p >> kSinCosShift;
+    const float c0 = t.cos[i];
+    const float s0 = t.sin[i];
+    const float d = float(std::int32_t(p & kSinCosFraction)) * kPhaseRadian;
+    const float h = d * 0.5f;
+    c = c0 - d * (s0 + c0 * h);
+    s = s0 + d * (c0 - s0 * h);
+}
+
+inline void ref_nco_mix(const MathTables& t, const float* x, std::size_t n, std::uint32_t phase,
+                        std::uint32_t step, float* out) noexcept {
+#pragma GCC ivdep
+    for (std::size_t i = 0; i < n; ++i) {
+        float c, s;
+        ref_sincos(t, phase + std::uint32_t(i) * step, c, s);
+        const float xr = x[2 * i], xi = x[2 * i + 1];
+        out[2 * i] = xr * c - xi * s;
+        out[2 * i + 1] = xr * s + xi * c;
+    }
+}
+
+/// atan2 folded to the first octant, where z = min / max of |x|, |y| is
+/// further reduced to [0, tan(pi/8)] through atan(z) = pi/4 +
+/// atan((z - 1) / (z + 1)); one division either way. atan2(0, 0) = 0.
+/// The selects only pick operands, adding an exact 0 where a step does
+/// not apply, so AVX2 can if-convert the loop without masked arithmetic.
+inline float ref_atan2(float y, float x) noexcept {
+    const float ax = x < 0.0f ? -x : x;
+    const float ay = y < 0.0f ? -y : y;
+    const float mx = ax > ay ? ax : ay;
+    const float mn = ax > ay ? ay : ax;
+    const bool wide = mn > kTanPi8 * mx;
+    const float num = mn - (wide ? mx : 0.0f);
+    float den = (wide ? mn : 0.0f) + mx;
+    den = den + (den > 0.0f ? 0.0f : 1.0f);
+    const float z = num / den;
+    const float zz = z * z;
+    float p = kAtanP[0];
+    p = p * zz + kAtanP[1];
+    p = p * zz + kAtanP[2];
+    p = p * zz + kAtanP[3];
+    float r = ((p * zz) * z) + z;
+    r = r + (wide ? kQuarterPi : 0.0f);
+    r = (ay > ax ? kHalfPi : 0.0f) + (ay > ax ? -r : r);
+    r = (x < 0.0f ? kPi : 0.0f) + (x < 0.0f ? -r : r);
+    return y < 0.0f ? -r : r;
+}
+
+inline void ref_angle(const float* x, std::size_t n, float* out) noexcept {
+#pragma GCC ivdep
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = ref_atan2(x[2 * i + 1], x[2 * i]);
+    }
+}
+
+/// log(1 + exp(-|d|)) by linear interpolation in the table; 0 past its end.
+inline float ref_jacobian_log(const MathTables& t, float d) noexcept {
+    const float a = (d < 0.0f ? -d : d) * MathTables::kJacobianStep;
+    if (!(a < float(MathTables::kJacobianSize - 1))) {
+        return 0.0f;
+    }
+    const std::size_t i = std::size_t(a);
+    const float f = a - float(i);
+    return t.jacobian[i] + f * (t.jacobian[i + 1] - t.jacobian[i]);
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
@@ -0,0 +1,39 @@
+#include <cmath>
+#include <numbers>
+
+#include "math_kernels.hpp"
+#include "math_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void nco_mix_scalar(const float* x, std::size_t n, std::uint32_t phase, std::uint32_t step,
+                    float* out) {
+    ref_nco_mix(math_tables(), x, n, phase, step, out);
+}
+
+void angle_scalar(const float* x, std::size_t n, float* out) { ref_angle(x, n, out); }
+
+}  // namespace
+
+const MathTables& math_tables() noexcept {
+    static const MathTables tables = [] {
+        MathTables t{};
+        for (std::size_t i = 0; i < MathTables::kSinCosSize; ++i) {
+            const double a = 2.0 * std::numbers::pi * double(i) / double(MathTables::kSinCosSize);
+            t.cos[i] = float(std::cos(a));
+            t.sin[i] = float(std::sin(a));
+        }
+        for (std::size_t i = 0; i < MathTables::kJacobianSize; ++i) {
+            const double x = double(i) / double(MathTables::kJacobianStep);
+            t.jacobian[i] = float(std::log1p(std::exp(-x)));
+        }
+        return t;
+    }();
+    return tables;
+}
+
+const MathKernels math_scalar = {nco_mix_scalar, angle_scalar};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,25 @@
+// AVX-512 MIMO detector kernels: the reference loops, vectorised by the
+// compiler sixteen subcarriers per instruction under this file's flags.
+
+#include "mimo_kernels.hpp"
+#include "mimo_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void weights_avx512(const float* h, std::size_t ld, std::size_t rx, std::size_t tx, std::size_t n,
+                    float sigma2, bool mmse, float* w, float* noise) {
+    ref_mimo_weights(h, ld, rx, tx, n, sigma2, mmse, w, noise);
+}
+
+void apply_avx512(const float* w, std::size_t ld, std::size_t rx, std::size_t tx, const float* y,
+                  std::size_t n, float* x) {
+    ref_mimo_apply(w, ld, rx, tx, y, n, x);
+}
+
+}  // namespace
+
+const MimoKernels mimo_avx512 = {weights_avx512, apply_avx512};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,41 @@
+#pragma once
+
+// Per-ISA kernels behind MimoEqualizer.
+//
+// Every complex matrix entry is a pair of float planes over n subcarriers,
+// re then im, each `ld` floats after the previous one; entry (i, j) of a
+// rows x cols matrix is planes 2 (i cols + j) and 2 (i cols + j) + 1. The
+// per-subcarrier arithmetic is straight-line code over those planes, so
+// the reference loops are the kernels in every variant, vectorised by the
+// compiler under each translation unit's ISA flags, many subcarriers per
+// instruction. Nothing is reassociated and the build disables FMA
+// contraction, so all variants agree bit for bit.
+
+#include <cstddef>
+
+namespace dcomm::kernels {
+
+struct MimoKernels {
+    /// Linear detector weights for an rx x tx channel h, tx = 2 or 4 and
+    /// tx <= rx <= 8: G = H^H H (+ sigma2 I when `mmse`), w = G^-1 H^H as a
+    /// tx x rx matrix. MMSE rows are scaled by 1 / (1 - sigma2 G^-1_tt) to
+    /// remove the detector's bias. noise (tx real planes) receives the
+    /// post-detection noise plus interference variance of each stream,
+    /// sigma2 G^-1_tt before that scaling, divided by it after.
+    void (*weights)(const float* h, std::size_t ld, std::size_t rx, std::size_t tx, std::size_t n,
+                    float sigma2, bool mmse, float* w, float* noise);
+    /// x = w y per subcarrier, w tx x rx, y rx x 1, x tx x 1.
+    void (*apply)(const float* w, std::size_t ld, std::size_t rx, std::size_t tx,
+                  const float* y, std::size_t n, float* x);
+};
+
+extern const MimoKernels mimo_scalar;
+#if defined(DCOMM_KERNELS_X86)
+extern const MimoKernels mimo_avx2;
+extern const MimoKernels mimo_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+extern const MimoKernels mimo_neon;
+#endif
+
+}  // namespace dcomm::kernels
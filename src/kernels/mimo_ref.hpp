@@ -0,0 +1,229 @@
+#pragma once
+
+// Reference MIMO detector kernels (see mimo_kernels.hpp for the contract
+// and plane layout). Each subcarrier's weights come from its Gram matrix,
+// the matrix's inverse and the product with H^H, all in one pass. The 2x2
+// inverse is the adjugate over the determinant; the 4x4 one goes through
+// 2x2 blocks,
+//
+//   G = [A B; B^H D], S = D - B^H A^-1 B, E = A^-1 B, F = E S^-1,
+//   G^-1 = [A^-1 + F E^H, -F; -F^H, S^-1],
+//
+// which needs two real reciprocals per subcarrier and no pivoting, as G is
+// Hermitian positive definite. Determinants are offset by kDetFloor, so a zero
+// channel gets zero weights rather than NaN, and under MMSE an
+// enormous noise variance. Internal linkage: every kernel translation unit
+// includes this and compiles it for its own ISA.
+
+#include <cassert>
+#include <cstddef>
+
+#include "mimo_kernels.hpp"
+
+namespace dcomm::kernels {
+namespace {
+
+constexpr float kDetFloor = 1e-30f;
+
+struct Cplx {
+    float r, i;
+};
+
+inline Cplx cadd(Cplx a, Cplx b) noexcept { return {a.r + b.r, a.i + b.i}; }
+inline Cplx csub(Cplx a, Cplx b) noexcept { return {a.r - b.r, a.i - b.i}; }
+inline Cplx cmul(Cplx a, Cplx b) noexcept {
+    return {a.r * b.r - a.i * b.i, a.r * b.i + a.i * b.r};
+}
+/// conj(a) b
+inline Cplx cmulc(Cplx a, Cplx b) noexcept {
+    return {a.r * b.r + a.i * b.i, a.r * b.i - a.i * b.r};
+}
+inline Cplx cscale(Cplx a, float s) noexcept { return {a.r * s, a.i * s}; }
+/// 1 / det, kept finite by an offset far below any float rounding of a
+/// real determinant. A clamp or select would be turned into a branch
+/// around the division, which AVX2 cannot if-convert.
+inline float recip_floor(float det) noexcept { return 1.0f / (det + kDetFloor); }
+
+/// 2x2 Hermitian inverse: [a c; c* d] -> [q00 q01; q01* q11].
+struct Herm2 {
+    float a, d;
+    Cplx c;
+};
+
+inline Herm2 herm2_inverse(const Herm2& g) noexcept {
+    const float det = g.a * g.d - (g.c.r * g.c.r + g.c.i * g.c.i);
+    const float inv = recip_floor(det);
+    return {g.d * inv, g.a * inv, {-g.c.r * inv, -g.c.i * inv}};
+}
+
+/// 4x4 Hermitian inverse through 2x2 blocks; g holds the upper triangle.
+/// Forced inline: a call would keep the subcarrier loop from vectorising.
+[[gnu::always_inline]] inline void herm4_inverse(const Cplx (&g)[4][4],
+                                                 Cplx (&q)[4][4]) noexcept {
+    const Herm2 a = herm2_inverse({g[0][0].r, g[1][1].r, g[0][1]});
+    const Cplx b00 = g[0][2], b01 = g[0][3], b10 = g[1][2], b11 = g[1][3];
+    // E = A^-1 B, A^-1 = [a.a a.c; a.c* a.d].
+    const Cplx e00 = cadd(cscale(b00, a.a), cmul(a.c, b10));
+    const Cplx e01 = cadd(cscale(b01, a.a), cmul(a.c, b11));
+    const Cplx e10 = cadd(cmulc(a.c, b00), cscale(b10, a.d));
+    const Cplx e11 = cadd(cmulc(a.c, b01), cscale(b11, a.d));
+    // S = D - B^H E, Hermitian.
+    const Herm2 sd = {g[2][2].r - (cmulc(b00, e00).r + cmulc(b10, e10).r),
+                      g[3][3].r - (cmulc(b01, e01).r + cmulc(b11, e11).r),
+                      csub(g[2][3], cadd(cmulc(b00, e01), cmulc(b10, e11)))};
+    const Herm2 si = herm2_inverse(sd);
+    // F = E S^-1.
+    const Cplx f00 = cadd(cscale(e00, si.a), cmulc(si.c, e01));
+    const Cplx f01 = cadd(cmul(e00, si.c), cscale(e01, si.d));
+    const Cplx f10 = cadd(cscale(e10, si.a), cmulc(si.c, e11));
+    const Cplx f11 = cadd(cmul(e10, si.c), cscale(e11, si.d));
+    // Top left: A^-1 + F E^H.
+    const float t00 = a.a + (cmulc(e00, f00).r + cmulc(e01, f01).r);
+    const float t11 = a.d + (cmulc(e10, f10).r + cmulc(e11, f11).r);
+    const Cplx t01 = cadd(a.c, cadd(cmulc(e10, f00), cmulc(e11, f01)));
+
+    q[0][0] = {t00, 0.0f};
+    q[0][1] = t01;
+    q[0][2] = {-f00.r, -f00.i};
+    q[0][3] = {-f01.r, -f01.i};
+    q[1][0] = {t01.r, -t01.i};
+    q[1][1] = {t11, 0.0f};
+    q[1][2] = {-f10.r, -f10.i};
+    q[1][3] = {-f11.r, -f11.i};
+    q[2][0] = {-f00.r, f00.i};
+    q[2][1] = {-f10.r, f10.i};
+    q[2][2] = {si.a, 0.0f};
+    q[2][3] = si.c;
+    q[3][0] = {-f01.r, f01.i};
+    q[3][1] = {-f11.r, f11.i};
+    q[3][2] = {si.c.r, -si.c.i};
+    q[3][3] = {si.d, 0.0f};
+}
+
+/// One loop over the subcarriers with the shape fixed at compile time:
+/// the loops over antennas and streams unroll completely, every
+/// intermediate stays in registers and the subcarrier loop vectorises.
+template <std::size_t Rx, std::size_t Tx>
+void ref_weights_fixed(const float* h, std::size_t ld, std::size_t n, float sigma2, bool mmse,
+                       float* w, float* noise) noexcept {
+    // Selected once: an invariant condition in the loop would not vectorise.
+    const float load = mmse ? sigma2 : 0.0f;
+    const float bias = mmse ? 1.0f : 0.0f;
+    // Planes of one matrix never overlap: ld >= n.
+#pragma GCC ivdep
+    for (std::size_t k = 0; k < n; ++k) {
+        Cplx hm[Rx][Tx];
+#pragma GCC unroll 8
+        for (std::size_t r = 0; r < Rx; ++r) {
+#pragma GCC unroll 8
+            for (std::size_t t = 0; t < Tx; ++t) {
+                const float* p = h + 2 * (r * Tx + t) * ld;
+                hm[r][t] = {p[k], p[k + ld]};
+            }
+        }
+        Cplx g[Tx][Tx];
+#pragma GCC unroll 8
+        for (std::size_t i = 0; i < Tx; ++i) {
+#pragma GCC unroll 8
+            for (std::size_t j = i; j < Tx; ++j) {
+                Cplx acc = {0.0f, 0.0f};
+#pragma GCC unroll 8
+                for (std::size_t r = 0; r < Rx; ++r) {
+                    acc = cadd(acc, cmulc(hm[r][i], hm[r][j]));
+                }
+                g[i][j] = acc;
+            }
+            g[i][i].r += load;
+        }
+        Cplx q[Tx][Tx];
+        if constexpr (Tx == 2) {
+            const Herm2 qi = herm2_inverse({g[0][0].r, g[1][1].r, g[0][1]});
+            q[0][0] = {qi.a, 0.0f};
+            q[0][1] = qi.c;
+            q[1][0] = {qi.c.r, -qi.c.i};
+            q[1][1] = {qi.d, 0.0f};
+        } else {
+            herm4_inverse(g, q);
+        }
+#pragma GCC unroll 8
+        for (std::size_t t = 0; t < Tx; ++t) {
+            const float v = sigma2 * q[t][t].r;
+            const float c = recip_floor(1.0f - bias * v);  // 1 for ZF
+            noise[t * ld + k] = v * c;
+            // sum_j G^-1_tj conj(H_rj)
+#pragma GCC unroll 8
+            for (std::size_t r = 0; r < Rx; ++r) {
+                Cplx acc = {0.0f, 0.0f};
+#pragma GCC unroll 8
+                for (std::size_t j = 0; j < Tx; ++j) {
+                    acc = cadd(acc, cmulc(hm[r][j], q[t][j]));
+                }
+                float* p = w + 2 * (t * Rx + r) * ld;
+                p[k] = acc.r * c;
+                p[k + ld] = acc.i * c;
+            }
+        }
+    }
+}
+
+template <std::size_t Rx, std::size_t Tx>
+void ref_apply_fixed(const float* w, std::size_t ld, const float* y, std::size_t n,
+                     float* x) noexcept {
+#pragma GCC ivdep
+    for (std::size_t k = 0; k < n; ++k) {
+        Cplx yv[Rx];
+#pragma GCC unroll 8
+        for (std::size_t r = 0; r < Rx; ++r) {
+            yv[r] = {y[2 * r * ld + k], y[(2 * r + 1) * ld + k]};
+        }
+#pragma GCC unroll 8
+        for (std::size_t t = 0; t < Tx; ++t) {
+            Cplx acc = {0.0f, 0.0f};
+#pragma GCC unroll 8
+            for (std::size_t r = 0; r < Rx; ++r) {
+                const float* p = w + 2 * (t * Rx + r) * ld;
+                acc = cadd(acc, cmul({p[k], p[k + ld]}, yv[r]));
+            }
+            x[2 * t * ld + k] = acc.r;
+            x[(2 * t + 1) * ld + k] = acc.i;
+        }
+    }
+}
+
+/// Calls f.template operator()<Rx, Tx>() for the runtime shape.
+template <class F>
+void dispatch_shape(std::size_t rx, std::size_t tx, F&& f) noexcept {
+    switch (tx * 16 + rx) {
+    case 2 * 16 + 2: f.template operator()<2, 2>(); break;
+    case 2 * 16 + 3: f.template operator()<3, 2>(); break;
+    case 2 * 16 + 4: f.template operator()<4, 2>(); break;
+    case 2 * 16 + 5: f.template operator()<5, 2>(); break;
+    case 2 * 16 + 6: f.template operator()<6, 2>(); break;
+    case 2 * 16 + 7: f.template operator()<7, 2>(); break;
+    case 2 * 16 + 8: f.template operator()<8, 2>(); break;
+    case 4 * 16 + 4: f.template operator()<4, 4>(); break;
+    case 4 * 16 + 5: f.template operator()<5, 4>(); break;
+    case 4 * 16 + 6: f.template operator()<6, 4>(); break;
+    case 4 * 16 + 7: f.template operator()<7, 4>(); break;
+    case 4 * 16 + 8: f.template operator()<8, 4>(); break;
+    default: assert(false);
+    }
+}
+
+inline void ref_mimo_weights(const float* h, std::size_t ld, std::size_t rx, std::size_t tx,
+                             std::size_t n, float sigma2, bool mmse, float* w,
+                             float* noise) noexcept {
+    dispatch_shape(rx, tx, [&]<std::size_t Rx, std::size_t Tx>() {
+        ref_weights_fixed<Rx, Tx>(h, ld, n, sigma2, mmse, w, noise);
+    });
+}
+
+inline void ref_mimo_apply(const float* w, std::size_t ld, std::size_t rx, std::size_t tx,
+                           const float* y, std::size_t n, float* x) noexcept {
+    dispatch_shape(rx, tx, [&]<std::size_t Rx, std::size_t Tx>() {
+        ref_apply_fixed<Rx, Tx>(w, ld, y, n, x);
+    });
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
@@ -0,0 +1,22 @@
+#include "mimo_kernels.hpp"
+#include "mimo_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void weights_scalar(const float* h, std::size_t ld, std::size_t rx, std::size_t tx, std::size_t n,
+                    float sigma2, bool mmse, float* w, float* noise) {
+    ref_mimo_weights(h, ld, rx, tx, n, sigma2, mmse, w, noise);
+}
+
+void apply_scalar(const float* w, std::size_t ld, std::size_t rx, std::size_t tx, const float* y,
+                  std::size_t n, float* x) {
+    ref_mimo_apply(w, ld, rx, tx, y, n, x);
+}
+
+}  // namespace
+
+const MimoKernels mimo_scalar = {weights_scalar, apply_scalar};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,220 @@
+// AVX-512 constellation kernels, sixteen PAM axis values per iteration.
+// Same algorithms as the AVX2 variant (see modulation_avx2.cpp for why the
+// folded demapper search is bit-exact); the wider permutes hold every level
+// table in one register.
+
+#include <immintrin.h>
+
+#include <cfloat>
+
+#include "modulation_kernels.hpp"
+#include "modulation_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+// ---- mapper ---------------------------------------------------------------
+
+template <unsigned M>
+inline __m512i axis_codes16(const std::uint8_t* bits) noexcept {
+    if constexpr (M == 1) {
+        return _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bits)));
+    } else if constexpr (M == 2) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits));
+        return _mm512_cvtepi16_epi32(_mm256_maddubs_epi16(v, _mm256_set1_epi16(0x0102)));
+    } else if constexpr (M == 3) {
+        // Four 12-byte quarters, each spread to four dwords of {b0, b1, b2, 0}.
+        __m512i v = _mm512_castsi128_si512(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(bits)));
+        v = _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(bits + 12)), 1);
+        v = _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(bits + 24)), 2);
+        v = _mm512_inserti32x4(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(bits + 36)), 3);
+        const __m512i spread = _mm512_broadcast_i32x4(_mm_setr_epi8(
+            0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1));
+        const __m512i weights = _mm512_set1_epi32(0x00010204);
+        return _mm512_madd_epi16(
+            _mm512_maddubs_epi16(_mm512_shuffle_epi8(v, spread), weights),
+            _mm512_set1_epi16(1));
+    } else {
+        const __m512i v = _mm512_loadu_si512(bits);
+        return _mm512_madd_epi16(_mm512_maddubs_epi16(v, _mm512_set1_epi32(0x01020408)),
+                                 _mm512_set1_epi16(1));
+    }
+}
+
+template <unsigned M>
+void map_axes(const float* levels, const std::uint8_t* bits, std::size_t n_axes,
+              float* out) noexcept {
+    alignas(64) float table[16] = {};
+    for (unsigned i = 0; i < (1u << M); ++i) {
+        table[i] = levels[i];
+    }
+    const __m512 lut = _mm512_load_ps(table);
+    // The M == 3 loader reads 52 bytes per 48 consumed.
+    constexpr std::size_t kReadBytes = M == 3 ? 52 : 16 * M;
+    std::size_t j = 0;
+    for (; j * M + kReadBytes <= n_axes * M; j += 16) {
+        _mm512_storeu_ps(out + j, _mm512_permutexvar_ps(axis_codes16<M>(bits + j * M), lut));
+    }
+    ref_map_axes(M, levels, bits + j * M, n_axes - j, out + j);
+}
+
+void map_bpsk(const float* levels, const std::uint8_t* bits, std::size_t n_symbols,
+              float* out) noexcept {
+    alignas(64) float table[16] = {levels[0], levels[1]};
+    const __m512 lut = _mm512_load_ps(table);
+    const __m512 zero = _mm512_setzero_ps();
+    // Index 16 selects element 0 of `zero`.
+    const __m512i lo = _mm512_setr_epi32(0, 16, 1, 16, 2, 16, 3, 16, 4, 16, 5, 16, 6, 16, 7, 16);
+    const __m512i hi = _mm512_setr_epi32(8, 16, 9, 16, 10, 16, 11, 16, 12, 16, 13, 16, 14, 16,
+                                         15, 16);
+    std::size_t i = 0;
+    for (; i + 16 <= n_symbols; i += 16) {
+        const __m512 v = _mm512_permutexvar_ps(axis_codes16<1>(bits + i), lut);
+        _mm512_storeu_ps(out + 2 * i, _mm512_permutex2var_ps(v, lo, zero));
+        _mm512_storeu_ps(out + 2 * i + 16, _mm512_permutex2var_ps(v, hi, zero));
+    }
+    ref_map_bpsk(levels, bits + i, n_symbols - i, out + 2 * i);
+}
+
+void map_avx512(Modulation m, const float* levels, const std::uint8_t* bits,
+                std::size_t n_symbols, float* out) {
+    switch (m) {
+    case Modulation::bpsk: map_bpsk(levels, bits, n_symbols, out); break;
+    case Modulation::qpsk: map_axes<1>(levels, bits, 2 * n_symbols, out); break;
+    case Modulation::qam16: map_axes<2>(levels, bits, 2 * n_symbols, out); break;
+    case Modulation::qam64: map_axes<3>(levels, bits, 2 * n_symbols, out); break;
+    case Modulation::qam256: map_axes<4>(levels, bits, 2 * n_symbols, out); break;
+    }
+}
+
+// ---- demapper -------------------------------------------------------------
+
+template <unsigned M>
+inline void demap16(__m512 x, __m512 inv_scale, __m512 factor, __m512 llr[M]) noexcept {
+    constexpr unsigned kHalf = 1u << (M - 1);
+    const __m512 inf = _mm512_set1_ps(FLT_MAX);
+    const __m512 y = _mm512_mul_ps(x, inv_scale);
+    const __m512 ay = _mm512_abs_ps(y);
+
+    __m512 near = inf;
+    __m512 min0[M];
+    __m512 min1[M];
+    for (unsigned k = 0; k < M; ++k) {
+        min0[k] = inf;
+        min1[k] = inf;
+    }
+    for (unsigned j = 0; j < kHalf; ++j) {
+        const unsigned idx = kHalf + j;
+        const unsigned gray = idx ^ (idx >> 1);
+        const __m512 diff = _mm512_sub_ps(ay, _mm512_set1_ps(float(2 * j + 1)));
+        const __m512 d = _mm512_mul_ps(diff, diff);
+        near = _mm512_min_ps(d, near);
+        for (unsigned k = 1; k < M; ++k) {
+            if ((gray >> (M - 1 - k)) & 1u) {
+                min1[k] = _mm512_min_ps(d, min1[k]);
+            } else {
+                min0[k] = _mm512_min_ps(d, min0[k]);
+            }
+        }
+    }
+    const __m512 far_sum = _mm512_add_ps(ay, _mm512_set1_ps(1.0f));
+    const __m512 far = _mm512_mul_ps(far_sum, far_sum);
+    const __mmask16 negative = _mm512_cmp_ps_mask(y, _mm512_setzero_ps(), _CMP_LT_OQ);
+    llr[0] = _mm512_mask_blend_ps(negative, _mm512_mul_ps(_mm512_sub_ps(near, far), factor),
+                                  _mm512_mul_ps(_mm512_sub_ps(far, near), factor));
+    for (unsigned k = 1; k < M; ++k) {
+        llr[k] = _mm512_mul_ps(_mm512_sub_ps(min1[k], min0[k]), factor);
+    }
+}
+
+template <unsigned M>
+inline void store_llrs16(const __m512 llr[M], float* out) noexcept {
+    if constexpr (M == 1) {
+        _mm512_storeu_ps(out, llr[0]);
+    } else if constexpr (M == 2 || M == 4) {
+        const __m512i pair_lo = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21,
+                                                  6, 22, 7, 23);
+        const __m512i pair_hi = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13,
+                                                  29, 14, 30, 15, 31);
+        const __m512 a0 = _mm512_permutex2var_ps(llr[0], pair_lo, llr[1]);
+        const __m512 a1 = _mm512_permutex2var_ps(llr[0], pair_hi, llr[1]);
+        if constexpr (M == 2) {
+            _mm512_storeu_ps(out, a0);
+            _mm512_storeu_ps(out + 16, a1);
+        } else {
+            const __m512 b0 = _mm512_permutex2var_ps(llr[2], pair_lo, llr[3]);
+            const __m512 b1 = _mm512_permutex2var_ps(llr[2], pair_hi, llr[3]);
+            // Interleave (bit0, bit1) and (bit2, bit3) pairs as 64-bit units.
+            const __m512i quad_lo = _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11);
+            const __m512i quad_hi = _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15);
+            auto quads = [](__m512 a, __m512i idx, __m512 b) {
+                return _mm512_castpd_ps(
+                    _mm512_permutex2var_pd(_mm512_castps_pd(a), idx, _mm512_castps_pd(b)));
+            };
+            _mm512_storeu_ps(out, quads(a0, quad_lo, b0));
+            _mm512_storeu_ps(out + 16, quads(a0, quad_hi, b0));
+            _mm512_storeu_ps(out + 32, quads(a1, quad_lo, b1));
+            _mm512_storeu_ps(out + 48, quads(a1, quad_hi, b1));
+        }
+    } else {
+        alignas(64) float tmp[M][16];
+        for (unsigned k = 0; k < M; ++k) {
+            _mm512_store_ps(tmp[k], llr[k]);
+        }
+        for (unsigned j = 0; j < 16; ++j) {
+            for (unsigned k = 0; k < M; ++k) {
+                out[j * M + k] = tmp[k][j];
+            }
+        }
+    }
+}
+
+template <unsigned M>
+void demap_axes(const float* in, std::size_t n_axes, float inv_scale, float factor,
+                float* llrs) noexcept {
+    const __m512 vinv = _mm512_set1_ps(inv_scale);
+    const __m512 vfactor = _mm512_set1_ps(factor);
+    std::size_t j = 0;
+    for (; j + 16 <= n_axes; j += 16) {
+        __m512 llr[M];
+        demap16<M>(_mm512_loadu_ps(in + j), vinv, vfactor, llr);
+        store_llrs16<M>(llr, llrs + j * M);
+    }
+    ref_demap_axes(M, in + j, n_axes - j, inv_scale, factor, llrs + j * M);
+}
+
+void demap_bpsk(const float* in, std::size_t n_symbols, float inv_scale, float factor,
+                float* llrs) noexcept {
+    const __m512 vinv = _mm512_set1_ps(inv_scale);
+    const __m512 vfactor = _mm512_set1_ps(factor);
+    const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26,
+                                           28, 30);
+    std::size_t i = 0;
+    for (; i + 16 <= n_symbols; i += 16) {
+        const __m512 re = _mm512_permutex2var_ps(_mm512_loadu_ps(in + 2 * i), even,
+                                                 _mm512_loadu_ps(in + 2 * i + 16));
+        __m512 llr[1];
+        demap16<1>(re, vinv, vfactor, llr);
+        _mm512_storeu_ps(llrs + i, llr[0]);
+    }
+    ref_demap_bpsk(in + 2 * i, n_symbols - i, inv_scale, factor, llrs + i);
+}
+
+void demap_avx512(Modulation m, const float* symbols, std::size_t n_symbols,
+                  float inv_scale, float factor, float* llrs) {
+    switch (m) {
+    case Modulation::bpsk: demap_bpsk(symbols, n_symbols, inv_scale, factor, llrs); break;
+    case Modulation::qpsk: demap_axes<1>(symbols, 2 * n_symbols, inv_scale, factor, llrs); break;
+    case Modulation::qam16: demap_axes<2>(symbols, 2 * n_symbols, inv_scale, factor, llrs); break;
+    case Modulation::qam64: demap_axes<3>(symbols, 2 * n_symbols, inv_scale, factor, llrs); break;
+    case Modulation::qam256: demap_axes<4>(symbols, 2 * n_symbols, inv_scale, factor, llrs); break;
+    }
+}
+
+}  // namespace
+
+const ModulationKernels modulation_avx512 = {map_avx512, demap_avx512};
+
+}  // namespace dcomm::kernels
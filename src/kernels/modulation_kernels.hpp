@@ -0,0 +1,37 @@
+#pragma once
+
+// Per-ISA constellation kernels behind map_bits() and demap_maxlog().
+//
+// Kernels see samples as interleaved floats (re, im, re, im, ...). Every
+// non-BPSK modulation is then a stream of independent PAM axis values whose
+// bits and LLRs sit consecutively in memory, which is what the wide kernels
+// vectorise over. Kernel translation units are compiled with ISA-specific
+// flags, so they keep all helpers at internal linkage.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "dcomm/phy_config.hpp"
+
+namespace dcomm::kernels {
+
+struct ModulationKernels {
+    /// `levels[c]` is the scaled amplitude of axis code `c` (the axis' Gray
+    /// bits read first-bit-most-significant); out receives 2 * n floats.
+    void (*map)(Modulation m, const float* levels, const std::uint8_t* bits,
+                std::size_t n_symbols, float* out);
+    /// Max-log LLRs; `inv_scale` = 1 / K_MOD, `factor` = K_MOD^2 / N0.
+    void (*demap)(Modulation m, const float* symbols, std::size_t n_symbols,
+                  float inv_scale, float factor, float* llrs);
+};
+
+extern const ModulationKernels modulation_scalar;
+#if defined(DCOMM_KERNELS_X86)
+extern const ModulationKernels modulation_avx2;
+extern const ModulationKernels modulation_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+extern const ModulationKernels modulation_neon;
+#endif
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,193 @@
+// NEON constellation kernels for AArch64. Same algorithms as the AVX2
+// variant (see modulation_avx2.cpp for why the folded demapper search is
+// bit-exact). The structure loads and stores (vld2..vld4, vst2..vst4) do the
+// bit grouping and LLR interleaving that the x86 kernels do with shuffles.
+
+#include <arm_neon.h>
+
+#include <cfloat>
+
+#include "modulation_kernels.hpp"
+#include "modulation_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+// ---- mapper ---------------------------------------------------------------
+
+/// Axis codes of eight consecutive groups of M unpacked bits.
+template <unsigned M>
+inline uint8x8_t axis_codes8(const std::uint8_t* bits) noexcept {
+    if constexpr (M == 1) {
+        return vld1_u8(bits);
+    } else if constexpr (M == 2) {
+        const uint8x8x2_t v = vld2_u8(bits);
+        return vorr_u8(vshl_n_u8(v.val[0], 1), v.val[1]);
+    } else if constexpr (M == 3) {
+        const uint8x8x3_t v = vld3_u8(bits);
+        return vorr_u8(vorr_u8(vshl_n_u8(v.val[0], 2), vshl_n_u8(v.val[1], 1)), v.val[2]);
+    } else {
+        const uint8x8x4_t v = vld4_u8(bits);
+        return vorr_u8(vorr_u8(vshl_n_u8(v.val[0], 3), vshl_n_u8(v.val[1], 2)),
+                       vorr_u8(vshl_n_u8(v.val[2], 1), v.val[3]));
+    }
+}
+
+/// Eight table lookups of 32-bit levels: byte indices 4 * code + {0..3}.
+inline void lookup8(const uint8x16x4_t& table, uint8x8_t codes, float* out) noexcept {
+    const uint8x8x2_t c2 = vzip_u8(codes, codes);
+    const uint8x16_t dup = vcombine_u8(c2.val[0], c2.val[1]);
+    const uint8x16x2_t c4 = vzipq_u8(dup, dup);
+    const uint8x16_t lane = {0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3};
+    const uint8x16_t idx0 = vaddq_u8(vshlq_n_u8(c4.val[0], 2), lane);
+    const uint8x16_t idx1 = vaddq_u8(vshlq_n_u8(c4.val[1], 2), lane);
+    vst1q_u8(reinterpret_cast<std::uint8_t*>(out), vqtbl4q_u8(table, idx0));
+    vst1q_u8(reinterpret_cast<std::uint8_t*>(out + 4), vqtbl4q_u8(table, idx1));
+}
+
+inline uint8x16x4_t load_table(const float* levels, unsigned count) noexcept {
+    alignas(16) float table[16] = {};
+    for (unsigned i = 0; i < count; ++i) {
+        table[i] = levels[i];
+    }
+    return vld1q_u8_x4(reinterpret_cast<const std::uint8_t*>(table));
+}
+
+template <unsigned M>
+void map_axes(const float* levels, const std::uint8_t* bits, std::size_t n_axes,
+              float* out) noexcept {
+    const uint8x16x4_t table = load_table(levels, 1u << M);
+    std::size_t j = 0;
+    for (; j + 8 <= n_axes; j += 8) {
+        lookup8(table, axis_codes8<M>(bits + j * M), out + j);
+    }
+    ref_map_axes(M, levels, bits + j * M, n_axes - j, out + j);
+}
+
+void map_bpsk(const float* levels, const std::uint8_t* bits, std::size_t n_symbols,
+              float* out) noexcept {
+    const uint8x16x4_t table = load_table(levels, 2);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    std::size_t i = 0;
+    for (; i + 8 <= n_symbols; i += 8) {
+        alignas(16) float re[8];
+        lookup8(table, axis_codes8<1>(bits + i), re);
+        for (unsigned h = 0; h < 2; ++h) {
+            const float32x4_t v = vld1q_f32(re + 4 * h);
+            vst1q_f32(out + 2 * i + 8 * h, vzip1q_f32(v, zero));
+            vst1q_f32(out + 2 * i + 8 * h + 4, vzip2q_f32(v, zero));
+        }
+    }
+    ref_map_bpsk(levels, bits + i, n_symbols - i, out + 2 * i);
+}
+
+void map_neon(Modulation m, const float* levels, const std::uint8_t* bits,
+              std::size_t n_symbols, float* out) {
+    switch (m) {
+    case Modulation::bpsk: map_bpsk(levels, bits, n_symbols, out); break;
+    case Modulation::qpsk: map_axes<1>(levels, bits, 2 * n_symbols, out); break;
+    case Modulation::qam16: map_axes<2>(levels, bits, 2 * n_symbols, out); break;
+    case Modulation::qam64: map_axes<3>(levels, bits, 2 * n_symbols, out); break;
+    case Modulation::qam256: map_axes<4>(levels, bits, 2 * n_symbols, out); break;
+    }
+}
+
+// ---- demapper -------------------------------------------------------------
+
+template <unsigned M>
+inline void demap4(float32x4_t x, float32x4_t inv_scale, float32x4_t factor,
+                   float32x4_t llr[M]) noexcept {
+    constexpr unsigned kHalf = 1u << (M - 1);
+    const float32x4_t inf = vdupq_n_f32(FLT_MAX);
+    const float32x4_t y = vmulq_f32(x, inv_scale);
+    const float32x4_t ay = vabsq_f32(y);
+
+    float32x4_t near = inf;
+    float32x4_t min0[M];
+    float32x4_t min1[M];
+    for (unsigned k = 0; k < M; ++k) {
+        min0[k] = inf;
+        min1[k] = inf;
+    }
+    for (unsigned j = 0; j < kHalf; ++j) {
+        const unsigned idx = kHalf + j;
+        const unsigned gray = idx ^ (idx >> 1);
+        const float32x4_t diff = vsubq_f32(ay, vdupq_n_f32(float(2 * j + 1)));
+        const float32x4_t d = vmulq_f32(diff, diff);
+        near = vminq_f32(d, near);
+        for (unsigned k = 1; k < M; ++k) {
+            if ((gray >> (M - 1 - k)) & 1u) {
+                min1[k] = vminq_f32(d, min1[k]);
+            } else {
+                min0[k] = vminq_f32(d, min0[k]);
+            }
+        }
+    }
+    const float32x4_t far_sum = vaddq_f32(ay, vdupq_n_f32(1.0f));
+    const float32x4_t far = vmulq_f32(far_sum, far_sum);
+    const uint32x4_t negative = vcltq_f32(y, vdupq_n_f32(0.0f));
+    llr[0] = vbslq_f32(negative, vmulq_f32(vsubq_f32(far, near), factor),
+                       vmulq_f32(vsubq_f32(near, far), factor));
+    for (unsigned k = 1; k < M; ++k) {
+        llr[k] = vmulq_f32(vsubq_f32(min1[k], min0[k]), factor);
+    }
+}
+
+template <unsigned M>
+inline void store_llrs4(const float32x4_t llr[M], float* out) noexcept {
+    if constexpr (M == 1) {
+        vst1q_f32(out, llr[0]);
+    } else if constexpr (M == 2) {
+        vst2q_f32(out, (float32x4x2_t{{llr[0], llr[1]}}));
+    } else if constexpr (M == 3) {
+        vst3q_f32(out, (float32x4x3_t{{llr[0], llr[1], llr[2]}}));
+    } else {
+        vst4q_f32(out, (float32x4x4_t{{llr[0], llr[1], llr[2], llr[3]}}));
+    }
+}
+
+template <unsigned M>
+void demap_axes(const float* in, std::size_t n_axes, float inv_scale, float factor,
+                float* llrs) noexcept {
+    const float32x4_t vinv = vdupq_n_f32(inv_scale);
+    const float32x4_t vfactor = vdupq_n_f32(factor);
+    std::size_t j = 0;
+    for (; j + 4 <= n_axes; j += 4) {
+        float32x4_t llr[M];
+        demap4<M>(vld1q_f32(in + j), vinv, vfactor, llr);
+        store_llrs4<M>(llr, llrs + j * M);
+    }
+    ref_demap_axes(M, in + j, n_axes - j, inv_scale, factor, llrs + j * M);
+}
+
+void demap_bpsk(const float* in, std::size_t n_symbols, float inv_scale, float factor,
+                float* llrs) noexcept {
+    const float32x4_t vinv = vdupq_n_f32(inv_scale);
+    const float32x4_t vfactor = vdupq_n_f32(factor);
+    std::size_t i = 0;
+    for (; i + 4 <= n_symbols; i += 4) {
+        const float32x4x2_t v = vld2q_f32(in + 2 * i);
+        float32x4_t llr[1];
+        demap4<1>(v.val[0], vinv, vfactor, llr);
+        vst1q_f32(llrs + i, llr[0]);
+    }
+    ref_demap_bpsk(in + 2 * i, n_symbols - i, inv_scale, factor, llrs + i);
+}
+
+void demap_neon(Modulation m, const float* symbols, std::size_t n_symbols,
+                float inv_scale, float factor, float* llrs) {
+    switch (m) {
+    case Modulation::bpsk: demap_bpsk(symbols, n_symbols, inv_scale, factor, llrs); break;
+    case Modulation::qpsk: demap_axes<1>(symbols, 2 * n_symbols, inv_scale, factor, llrs); break;
+    case Modulation::qam16: demap_axes<2>(symbols, 2 * n_symbols, inv_scale, factor, llrs); break;
+    case Modulation::qam64: demap_axes<3>(symbols, 2 * n_symbols, inv_scale, factor, llrs); break;
+    case Modulation::qam256: demap_axes<4>(symbols, 2 * n_symbols, inv_scale, factor, llrs); break;
+    }
+}
+
+}  // namespace
+
+const ModulationKernels modulation_neon = {map_neon, demap_neon};
+
+}  // namespace dcomm::kernels
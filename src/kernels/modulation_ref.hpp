@@ -0,0 +1,92 @@
+#pragma once
+
+// Scalar reference constellation kernels. Included by every kernel
+// translation unit (for the reference itself and for vector tails), hence
+// internal linkage throughout.
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "dcomm/phy_config.hpp"
+
+namespace dcomm::kernels {
+namespace {
+
+/// Bits per PAM axis; BPSK puts its single bit on I.
+constexpr unsigned ref_axis_bits(Modulation m) noexcept {
+    switch (m) {
+    case Modulation::bpsk:
+    case Modulation::qpsk: return 1;
+    case Modulation::qam16: return 2;
+    case Modulation::qam64: return 3;
+    case Modulation::qam256: return 4;
+    }
+    return 0;
+}
+
+/// Code of the `m` unpacked bits at `bits`, first bit most significant.
+inline unsigned ref_axis_code(const std::uint8_t* bits, unsigned m) noexcept {
+    unsigned code = 0;
+    for (unsigned k = 0; k < m; ++k) {
+        code = (code << 1) | (bits[k] & 1u);
+    }
+    return code;
+}
+
+/// Map `n_axes` consecutive PAM axis values (QPSK and above).
+inline void ref_map_axes(unsigned m, const float* levels, const std::uint8_t* bits,
+                         std::size_t n_axes, float* out) noexcept {
+    for (std::size_t j = 0; j < n_axes; ++j, bits += m) {
+        out[j] = levels[ref_axis_code(bits, m)];
+    }
+}
+
+inline void ref_map_bpsk(const float* levels, const std::uint8_t* bits,
+                         std::size_t n_symbols, float* out) noexcept {
+    for (std::size_t i = 0; i < n_symbols; ++i) {
+        out[2 * i] = levels[bits[i] & 1u];
+        out[2 * i + 1] = 0.0f;
+    }
+}
+
+/// Max-log LLRs of one Gray PAM axis by exhaustive search over its levels:
+/// llr_k = (min_{a: b_k=1} (y-a)^2 - min_{a: b_k=0} (y-a)^2) * factor with
+/// y = x * inv_scale in integer level units.
+inline void ref_demap_axis(float x, unsigned m, float inv_scale, float factor,
+                           float* out) noexcept {
+    constexpr float kInf = std::numeric_limits<float>::max();
+    float min0[4] = {kInf, kInf, kInf, kInf};
+    float min1[4] = {kInf, kInf, kInf, kInf};
+    const float y = x * inv_scale;
+    const unsigned levels = 1u << m;
+    for (unsigned i = 0; i < levels; ++i) {
+        const float diff = y - float(2 * int(i) - int(levels - 1));
+        const float d = diff * diff;
+        const unsigned gray = i ^ (i >> 1);
+        for (unsigned k = 0; k < m; ++k) {
+            float& slot = ((gray >> (m - 1 - k)) & 1u) ? min1[k] : min0[k];
+            slot = d < slot ? d : slot;
+        }
+    }
+    for (unsigned k = 0; k < m; ++k) {
+        out[k] = (min1[k] - min0[k]) * factor;
+    }
+}
+
+inline void ref_demap_axes(unsigned m, const float* in, std::size_t n_axes,
+                           float inv_scale, float factor, float* llrs) noexcept {
+    for (std::size_t j = 0; j < n_axes; ++j, llrs += m) {
+        ref_demap_axis(in[j], m, inv_scale, factor, llrs);
+    }
+}
+
+inline void ref_demap_bpsk(const float* in, std::size_t n_symbols, float inv_scale,
+                           float factor, float* llrs) noexcept {
+    for (std::size_t i = 0; i < n_symbols; ++i) {
+        ref_demap_axis(in[2 * i], 1, inv_scale, factor, llrs + i);
+    }
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
@@ -0,0 +1,31 @@
+#include "modulation_kernels.hpp"
+#include "modulation_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void map_scalar(Modulation m, const float* levels, const std::uint8_t* bits,
+                std::size_t n_symbols, float* out) {
+    if (m == Modulation::bpsk) {
+        ref_map_bpsk(levels, bits, n_symbols, out);
+    } else {
+        ref_map_axes(ref_axis_bits(m), levels, bits, 2 * n_symbols, out);
+    }
+}
+
+void demap_scalar(Modulation m, const float* symbols, std::size_t n_symbols,
+                  float inv_scale, float factor, float* llrs) {
+    if (m == Modulation::bpsk) {
+        ref_demap_bpsk(symbols, n_symbols, inv_scale, factor, llrs);
+    } else {
+        ref_demap_axes(ref_axis_bits(m), symbols, 2 * n_symbols, inv_scale, factor,
+                       llrs);
+    }
+}
+
+}  // namespace
+
+const ModulationKernels modulation_scalar = {map_scalar, demap_scalar};
+
+}  // namespace dcomm::kernels
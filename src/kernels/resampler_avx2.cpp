@@ -0,0 +1,62 @@
+// AVX2 resampler kernels. The FIR keeps sixteen complex outputs in four
+// registers and streams the taps past them, one broadcast, four loads and
+// four multiply-adds per tap; the dot product runs two registers of
+// partial sums, which is the reference's sixteen lanes.
+
+#include <immintrin.h>
+
+#include "resampler_kernels.hpp"
+#include "resampler_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void fir_avx2(const float* taps, std::size_t n_taps, const float* x, std::size_t n, float* y) {
+    const std::size_t floats = 2 * n;
+    std::size_t j = 0;
+    for (; j + 32 <= floats; j += 32) {
+        __m256 a0 = _mm256_setzero_ps(), a1 = _mm256_setzero_ps();
+        __m256 a2 = _mm256_setzero_ps(), a3 = _mm256_setzero_ps();
+        const float* p = x + j;
+        for (std::size_t k = 0; k < n_taps; ++k, p += 2) {
+            const __m256 t = _mm256_broadcast_ss(taps + k);
+            a0 = _mm256_add_ps(a0, _mm256_mul_ps(t, _mm256_loadu_ps(p)));
+            a1 = _mm256_add_ps(a1, _mm256_mul_ps(t, _mm256_loadu_ps(p + 8)));
+            a2 = _mm256_add_ps(a2, _mm256_mul_ps(t, _mm256_loadu_ps(p + 16)));
+            a3 = _mm256_add_ps(a3, _mm256_mul_ps(t, _mm256_loadu_ps(p + 24)));
+        }
+        _mm256_storeu_ps(y + j, a0);
+        _mm256_storeu_ps(y + j + 8, a1);
+        _mm256_storeu_ps(y + j + 16, a2);
+        _mm256_storeu_ps(y + j + 24, a3);
+    }
+    for (; j + 8 <= floats; j += 8) {
+        __m256 a = _mm256_setzero_ps();
+        const float* p = x + j;
+        for (std::size_t k = 0; k < n_taps; ++k, p += 2) {
+            a = _mm256_add_ps(a, _mm256_mul_ps(_mm256_broadcast_ss(taps + k), _mm256_loadu_ps(p)));
+        }
+        _mm256_storeu_ps(y + j, a);
+    }
+    ref_fir(taps, n_taps, x + j, n - j / 2, y + j);
+}
+
+void dot_avx2(const float* taps, std::size_t n_taps, const float* x, float* y) {
+    __m256 lo = _mm256_setzero_ps(), hi = _mm256_setzero_ps();
+    for (std::size_t j = 0; j < 2 * n_taps; j += kDotLanes) {
+        lo = _mm256_add_ps(lo, _mm256_mul_ps(_mm256_loadu_ps(taps + j), _mm256_loadu_ps(x + j)));
+        hi = _mm256_add_ps(hi, _mm256_mul_ps(_mm256_loadu_ps(taps + j + 8),
+                                             _mm256_loadu_ps(x + j + 8)));
+    }
+    const __m256 s8 = _mm256_add_ps(lo, hi);
+    const __m128 s4 = _mm_add_ps(_mm256_castps256_ps128(s8), _mm256_extractf128_ps(s8, 1));
+    const __m128 s2 = _mm_add_ps(s4, _mm_movehl_ps(s4, s4));
+    _mm_storel_pi(reinterpret_cast<__m64*>(y), s2);
+}
+
+}  // namespace
+
+const ResamplerKernels resampler_avx2 = {fir_avx2, dot_avx2};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,37 @@
+#pragma once
+
+// Per-ISA kernels behind PolyphaseResampler and HalfbandCascade.
+//
+// Both apply real coefficients to interleaved complex samples, so a
+// coefficient scales the re and im float of a sample alike. Vector
+// kernels keep the reference's summation order (see resampler_ref.hpp),
+// and the results are bit-identical across instruction sets.
+
+#include <cstddef>
+
+namespace dcomm::kernels {
+
+/// Complex taps per step of the dot kernel; its tap count is a multiple.
+inline constexpr std::size_t kDotTaps = 8;
+
+struct ResamplerKernels {
+    /// y[i] = sum_k taps[k] * x[i + k] for i < n complex samples; x holds
+    /// n + n_taps - 1 samples, y n. Correlation form: taps are stored
+    /// time-reversed, oldest sample first.
+    void (*fir)(const float* taps, std::size_t n_taps, const float* x, std::size_t n, float* y);
+    /// y[0..1] = sum_k taps[2k] * x[k] over n_taps complex samples, for
+    /// n_taps a multiple of kDotTaps. Taps are stored duplicated, one per
+    /// float, so the product runs over 2 * n_taps floats.
+    void (*dot)(const float* taps, std::size_t n_taps, const float* x, float* y);
+};
+
+extern const ResamplerKernels resampler_scalar;
+#if defined(DCOMM_KERNELS_X86)
+extern const ResamplerKernels resampler_avx2;
+extern const ResamplerKernels resampler_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+extern const ResamplerKernels resampler_neon;
+#endif
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,54 @@
+// NEON resampler kernels for AArch64: the FIR holds eight complex outputs
+// in four registers, the dot product four registers of partial sums (the
+// reference's sixteen lanes), folded pairwise.
+
+#include <arm_neon.h>
+
+#include "resampler_kernels.hpp"
+#include "resampler_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void fir_neon(const float* taps, std::size_t n_taps, const float* x, std::size_t n, float* y) {
+    const std::size_t floats = 2 * n;
+    std::size_t j = 0;
+    for (; j + 16 <= floats; j += 16) {
+        float32x4_t a0 = vdupq_n_f32(0.0f), a1 = vdupq_n_f32(0.0f);
+        float32x4_t a2 = vdupq_n_f32(0.0f), a3 = vdupq_n_f32(0.0f);
+        const float* p = x + j;
+        for (std::size_t k = 0; k < n_taps; ++k, p += 2) {
+            const float32x4_t t = vdupq_n_f32(taps[k]);
+            a0 = vaddq_f32(a0, vmulq_f32(t, vld1q_f32(p)));
+            a1 = vaddq_f32(a1, vmulq_f32(t, vld1q_f32(p + 4)));
+            a2 = vaddq_f32(a2, vmulq_f32(t, vld1q_f32(p + 8)));
+            a3 = vaddq_f32(a3, vmulq_f32(t, vld1q_f32(p + 12)));
+        }
+        vst1q_f32(y + j, a0);
+        vst1q_f32(y + j + 4, a1);
+        vst1q_f32(y + j + 8, a2);
+        vst1q_f32(y + j + 12, a3);
+    }
+    ref_fir(taps, n_taps, x + j, n - j / 2, y + j);
+}
+
+void dot_neon(const float* taps, std::size_t n_taps, const float* x, float* y) {
+    float32x4_t a0 = vdupq_n_f32(0.0f), a1 = vdupq_n_f32(0.0f);
+    float32x4_t a2 = vdupq_n_f32(0.0f), a3 = vdupq_n_f32(0.0f);
+    for (std::size_t j = 0; j < 2 * n_taps; j += kDotLanes) {
+        a0 = vaddq_f32(a0, vmulq_f32(vld1q_f32(taps + j), vld1q_f32(x + j)));
+        a1 = vaddq_f32(a1, vmulq_f32(vld1q_f32(taps + j + 4), vld1q_f32(x + j + 4)));
+        a2 = vaddq_f32(a2, vmulq_f32(vld1q_f32(taps + j + 8), vld1q_f32(x + j + 8)));
+        a3 = vaddq_f32(a3, vmulq_f32(vld1q_f32(taps + j + 12), vld1q_f32(x + j + 12)));
+    }
+    const float32x4_t s4 = vaddq_f32(vaddq_f32(a0, a2), vaddq_f32(a1, a3));
+    const float32x2_t s2 = vadd_f32(vget_low_f32(s4), vget_high_f32(s4));
+    vst1_f32(y, s2);
+}
+
+}  // namespace
+
+const ResamplerKernels resampler_neon = {fir_neon, dot_neon};
+
+}  // namespace dcomm::kernels
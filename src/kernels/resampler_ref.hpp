@@ -0,0 +1,51 @@
+#pragma once
+
+// Scalar reference resampler kernels (see resampler_kernels.hpp for the
+// contract). The FIR sums each output tap by tap from zero. The dot
+// product keeps sixteen float partial sums, lane l taking floats l,
+// l + 16, ..., then folds them as lanes l + 8, l + 4 and l + 2 onto l, so
+// lanes 0 and 1 end as re and im. That is one AVX-512 register, two AVX2
+// or four NEON ones, folded by halves. Internal linkage: every kernel
+// translation unit includes this for its tail.
+
+#include <cstddef>
+
+#include "resampler_kernels.hpp"
+
+namespace dcomm::kernels {
+namespace {
+
+inline constexpr std::size_t kDotLanes = 2 * kDotTaps;
+
+inline void ref_fir(const float* taps, std::size_t n_taps, const float* x, std::size_t n,
+                    float* y) noexcept {
+    for (std::size_t j = 0; j < 2 * n; ++j) {
+        y[j] = 0.0f;
+    }
+    for (std::size_t k = 0; k < n_taps; ++k) {
+        const float t = taps[k];
+        const float* __restrict a = x + 2 * k;
+        for (std::size_t j = 0; j < 2 * n; ++j) {
+            y[j] += t * a[j];
+        }
+    }
+}
+
+inline void ref_dot(const float* taps, std::size_t n_taps, const float* x, float* y) noexcept {
+    float acc[kDotLanes] = {};
+    for (std::size_t j = 0; j < 2 * n_taps; j += kDotLanes) {
+        for (std::size_t l = 0; l < kDotLanes; ++l) {
+            acc[l] += taps[j + l] * x[j + l];
+        }
+    }
+    for (std::size_t width = kDotLanes / 2; width >= 2; width /= 2) {
+        for (std::size_t l = 0; l < width; ++l) {
+            acc[l] += acc[l + width];
+        }
+    }
+    y[0] = acc[0];
+    y[1] = acc[1];
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
@@ -0,0 +1,20 @@
+#include "resampler_kernels.hpp"
+#include "resampler_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void fir_scalar(const float* taps, std::size_t n_taps, const float* x, std::size_t n, float* y) {
+    ref_fir(taps, n_taps, x, n, y);
+}
+
+void dot_scalar(const float* taps, std::size_t n_taps, const float* x, float* y) {
+    ref_dot(taps, n_taps, x, y);
+}
+
+}  // namespace
+
+const ResamplerKernels resampler_scalar = {fir_scalar, dot_scalar};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,92 @@
+// AVX2 sync kernels: eight samples per register. The lagged products
+// deinterleave with shuffle + permute; the window-sum scan shifts lanes
+// with permutevar8x32 and blends zeros into the vacated ones.
+
+#include <immintrin.h>
+
+#include "sync_kernels.hpp"
+#include "sync_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+/// Re and im of eight interleaved complex samples.
+inline void load_split(const float* p, __m256& re, __m256& im) noexcept {
+    const __m256 a = _mm256_loadu_ps(p);
+    const __m256 b = _mm256_loadu_ps(p + 8);
+    // Samples 0 1 4 5 | 2 3 6 7 after the shuffle; the permute restores order.
+    re = _mm256_castpd_ps(
+        _mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, 0x88)), 0xd8));
+    im = _mm256_castpd_ps(
+        _mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, 0xdd)), 0xd8));
+}
+
+void lagged_products_avx2(const float* x, std::size_t n, std::size_t lag, float* c_re,
+                          float* c_im, float* e) {
+    const float* y = x + 2 * lag;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 xr, xi, yr, yi;
+        load_split(x + 2 * i, xr, xi);
+        load_split(y + 2 * i, yr, yi);
+        _mm256_storeu_ps(c_re + i, _mm256_add_ps(_mm256_mul_ps(xr, yr), _mm256_mul_ps(xi, yi)));
+        _mm256_storeu_ps(c_im + i, _mm256_sub_ps(_mm256_mul_ps(xr, yi), _mm256_mul_ps(xi, yr)));
+        _mm256_storeu_ps(e + i, _mm256_add_ps(_mm256_mul_ps(yr, yr), _mm256_mul_ps(yi, yi)));
+    }
+    ref_lagged_products(x + 2 * i, n - i, lag, c_re + i, c_im + i, e + i);
+}
+
+float window_sums_avx2(const float* a, std::size_t n, std::size_t window, float carry,
+                       float* out) {
+    const __m256i shift1 = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+    const __m256i shift2 = _mm256_setr_epi32(0, 0, 0, 1, 2, 3, 4, 5);
+    const __m256i shift4 = _mm256_setr_epi32(0, 0, 0, 0, 0, 1, 2, 3);
+    const __m256i last = _mm256_set1_epi32(7);
+    const __m256 zero = _mm256_setzero_ps();
+    __m256 c = _mm256_set1_ps(carry);
+    std::size_t i = 0;
+    for (; i + kScanLanes <= n; i += kScanLanes) {
+        __m256 d = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(a + i - window));
+        d = _mm256_add_ps(d, _mm256_blend_ps(_mm256_permutevar8x32_ps(d, shift1), zero, 0x01));
+        d = _mm256_add_ps(d, _mm256_blend_ps(_mm256_permutevar8x32_ps(d, shift2), zero, 0x03));
+        d = _mm256_add_ps(d, _mm256_blend_ps(_mm256_permutevar8x32_ps(d, shift4), zero, 0x0f));
+        const __m256 s = _mm256_add_ps(c, d);
+        _mm256_storeu_ps(out + i, s);
+        c = _mm256_permutevar8x32_ps(s, last);
+    }
+    return ref_window_sums(a + i, n - i, window, _mm256_cvtss_f32(c), out + i);
+}
+
+void metric_avx2(const float* p_re, const float* p_im, const float* r, std::size_t n, float* m) {
+    const __m256 floor = _mm256_set1_ps(kMetricFloor);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 pr = _mm256_loadu_ps(p_re + i), pi = _mm256_loadu_ps(p_im + i);
+        const __m256 rr = _mm256_loadu_ps(r + i);
+        const __m256 num = _mm256_add_ps(_mm256_mul_ps(pr, pr), _mm256_mul_ps(pi, pi));
+        const __m256 den = _mm256_max_ps(_mm256_mul_ps(rr, rr), floor);
+        _mm256_storeu_ps(m + i, _mm256_div_ps(num, den));
+    }
+    ref_metric(p_re + i, p_im + i, r + i, n - i, m + i);
+}
+
+std::size_t find_avx2(const float* m, std::size_t n, float threshold, bool above) {
+    const __m256 t = _mm256_set1_ps(threshold);
+    const int flip = above ? 0 : 0xff;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const int mask =
+            _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(m + i), t, _CMP_GT_OQ)) ^ flip;
+        if (mask != 0) {
+            return i + std::size_t(__builtin_ctz(unsigned(mask)));
+        }
+    }
+    return i + ref_find(m + i, n - i, threshold, above);
+}
+
+}  // namespace
+
+const SyncKernels sync_avx2 = {lagged_products_avx2, window_sums_avx2, metric_avx2, find_avx2};
+
+}  // namespace dcomm::kernels
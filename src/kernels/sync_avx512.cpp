@@ -0,0 +1,99 @@
+// AVX-512 sync kernels: sixteen samples per register. The window-sum scan
+// runs the reference's two eight-lane groups side by side, shifting with
+// masked permutes (zeros in the vacated lanes of each half), then chains
+// the upper group onto the lower one's last sum.
+
+#include <immintrin.h>
+
+#include "sync_kernels.hpp"
+#include "sync_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+inline void load_split(const float* p, __m512& re, __m512& im) noexcept {
+    const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26,
+                                           28, 30);
+    const __m512i odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27,
+                                          29, 31);
+    const __m512 a = _mm512_loadu_ps(p);
+    const __m512 b = _mm512_loadu_ps(p + 16);
+    re = _mm512_permutex2var_ps(a, even, b);
+    im = _mm512_permutex2var_ps(a, odd, b);
+}
+
+void lagged_products_avx512(const float* x, std::size_t n, std::size_t lag, float* c_re,
+                            float* c_im, float* e) {
+    const float* y = x + 2 * lag;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 xr, xi, yr, yi;
+        load_split(x + 2 * i, xr, xi);
+        load_split(y + 2 * i, yr, yi);
+        _mm512_storeu_ps(c_re + i, _mm512_add_ps(_mm512_mul_ps(xr, yr), _mm512_mul_ps(xi, yi)));
+        _mm512_storeu_ps(c_im + i, _mm512_sub_ps(_mm512_mul_ps(xr, yi), _mm512_mul_ps(xi, yr)));
+        _mm512_storeu_ps(e + i, _mm512_add_ps(_mm512_mul_ps(yr, yr), _mm512_mul_ps(yi, yi)));
+    }
+    ref_lagged_products(x + 2 * i, n - i, lag, c_re + i, c_im + i, e + i);
+}
+
+float window_sums_avx512(const float* a, std::size_t n, std::size_t window, float carry,
+                         float* out) {
+    const __m512i shift1 = _mm512_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6, 0, 8, 9, 10, 11, 12, 13, 14);
+    const __m512i shift2 = _mm512_setr_epi32(0, 0, 0, 1, 2, 3, 4, 5, 0, 0, 8, 9, 10, 11, 12, 13);
+    const __m512i shift4 = _mm512_setr_epi32(0, 0, 0, 0, 0, 1, 2, 3, 0, 0, 0, 0, 8, 9, 10, 11);
+    const __m512i lane7 = _mm512_set1_epi32(7);
+    const __m512i lane15 = _mm512_set1_epi32(15);
+    __m512 c = _mm512_set1_ps(carry);
+    std::size_t i = 0;
+    for (; i + 2 * kScanLanes <= n; i += 2 * kScanLanes) {
+        __m512 d = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(a + i - window));
+        d = _mm512_add_ps(d, _mm512_maskz_permutexvar_ps(0xfefe, shift1, d));
+        d = _mm512_add_ps(d, _mm512_maskz_permutexvar_ps(0xfcfc, shift2, d));
+        d = _mm512_add_ps(d, _mm512_maskz_permutexvar_ps(0xf0f0, shift4, d));
+        // Lower group: carry + d. Upper group: (carry + d[7]) + d.
+        const __m512 upper =
+            _mm512_add_ps(c, _mm512_permutexvar_ps(lane7, d));
+        const __m512 base = _mm512_mask_blend_ps(0xff00, c, upper);
+        const __m512 s = _mm512_add_ps(base, d);
+        _mm512_storeu_ps(out + i, s);
+        c = _mm512_permutexvar_ps(lane15, s);
+    }
+    return ref_window_sums(a + i, n - i, window, _mm512_cvtss_f32(c), out + i);
+}
+
+void metric_avx512(const float* p_re, const float* p_im, const float* r, std::size_t n,
+                   float* m) {
+    const __m512 floor = _mm512_set1_ps(kMetricFloor);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512 pr = _mm512_loadu_ps(p_re + i), pi = _mm512_loadu_ps(p_im + i);
+        const __m512 rr = _mm512_loadu_ps(r + i);
+        const __m512 num = _mm512_add_ps(_mm512_mul_ps(pr, pr), _mm512_mul_ps(pi, pi));
+        const __m512 den = _mm512_max_ps(_mm512_mul_ps(rr, rr), floor);
+        _mm512_storeu_ps(m + i, _mm512_div_ps(num, den));
+    }
+    ref_metric(p_re + i, p_im + i, r + i, n - i, m + i);
+}
+
+std::size_t find_avx512(const float* m, std::size_t n, float threshold, bool above) {
+    const __m512 t = _mm512_set1_ps(threshold);
+    const unsigned flip = above ? 0u : 0xffffu;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const unsigned mask =
+            unsigned(_mm512_cmp_ps_mask(_mm512_loadu_ps(m + i), t, _CMP_GT_OQ)) ^ flip;
+        if (mask != 0) {
+            return i + std::size_t(__builtin_ctz(mask));
+        }
+    }
+    return i + ref_find(m + i, n - i, threshold, above);
+}
+
+}  // namespace
+
+const SyncKernels sync_avx512 = {lagged_products_avx512, window_sums_avx512, metric_avx512,
+                                 find_avx512};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,46 @@
+#pragma once
+
+// Per-ISA kernels behind PacketSync's Schmidl-Cox correlator.
+//
+// The correlator's window sums are kept by recursion, one add and one
+// subtract per sample, and the recursion is vectorised as an eight-lane
+// prefix scan: each group of eight differences is scanned in log2(8)
+// shifted adds with zeros shifted in, then offset by the running carry.
+// The reference performs exactly those operations (sync_ref.hpp), so
+// every variant produces bit-identical sums and therefore identical
+// detections.
+
+#include <cstddef>
+
+namespace dcomm::kernels {
+
+/// Lanes of one scan group of window_sums.
+inline constexpr std::size_t kScanLanes = 8;
+
+struct SyncKernels {
+    /// For i < n over interleaved complex x: c[i] = conj(x[i]) * x[i + lag],
+    /// split into c_re / c_im, and e[i] = |x[i + lag]|^2.
+    void (*lagged_products)(const float* x, std::size_t n, std::size_t lag, float* c_re,
+                            float* c_im, float* e);
+    /// Sliding sums by recursion from s = carry: s += a[i] - a[i - window],
+    /// out[i] = s, for i < n; a has `window` values of history before it.
+    /// Returns the final s.
+    float (*window_sums)(const float* a, std::size_t n, std::size_t window, float carry,
+                         float* out);
+    /// m[i] = (p_re^2 + p_im^2) / max(r^2, kMetricFloor).
+    void (*metric)(const float* p_re, const float* p_im, const float* r, std::size_t n,
+                   float* m);
+    /// First i < n with (m[i] > threshold) == above, or n.
+    std::size_t (*find)(const float* m, std::size_t n, float threshold, bool above);
+};
+
+extern const SyncKernels sync_scalar;
+#if defined(DCOMM_KERNELS_X86)
+extern const SyncKernels sync_avx2;
+extern const SyncKernels sync_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+extern const SyncKernels sync_neon;
+#endif
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,85 @@
+// NEON sync kernels for AArch64: four samples per register, vld2q for the
+// deinterleave. An eight-lane scan group is a register pair; vextq shifts
+// across the pair with zeros entering at the bottom.
+
+#include <arm_neon.h>
+
+#include "sync_kernels.hpp"
+#include "sync_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void lagged_products_neon(const float* x, std::size_t n, std::size_t lag, float* c_re,
+                          float* c_im, float* e) {
+    const float* y = x + 2 * lag;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4x2_t a = vld2q_f32(x + 2 * i);
+        const float32x4x2_t b = vld2q_f32(y + 2 * i);
+        vst1q_f32(c_re + i, vaddq_f32(vmulq_f32(a.val[0], b.val[0]), vmulq_f32(a.val[1], b.val[1])));
+        vst1q_f32(c_im + i, vsubq_f32(vmulq_f32(a.val[0], b.val[1]), vmulq_f32(a.val[1], b.val[0])));
+        vst1q_f32(e + i, vaddq_f32(vmulq_f32(b.val[0], b.val[0]), vmulq_f32(b.val[1], b.val[1])));
+    }
+    ref_lagged_products(x + 2 * i, n - i, lag, c_re + i, c_im + i, e + i);
+}
+
+float window_sums_neon(const float* a, std::size_t n, std::size_t window, float carry,
+                       float* out) {
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    float32x4_t c = vdupq_n_f32(carry);
+    std::size_t i = 0;
+    for (; i + kScanLanes <= n; i += kScanLanes) {
+        float32x4_t lo = vsubq_f32(vld1q_f32(a + i), vld1q_f32(a + i - window));
+        float32x4_t hi = vsubq_f32(vld1q_f32(a + i + 4), vld1q_f32(a + i + 4 - window));
+        float32x4_t slo = vextq_f32(zero, lo, 3), shi = vextq_f32(lo, hi, 3);
+        lo = vaddq_f32(lo, slo);
+        hi = vaddq_f32(hi, shi);
+        slo = vextq_f32(zero, lo, 2);
+        shi = vextq_f32(lo, hi, 2);
+        lo = vaddq_f32(lo, slo);
+        hi = vaddq_f32(hi, shi);
+        hi = vaddq_f32(hi, lo);
+        lo = vaddq_f32(lo, zero);
+        const float32x4_t s_lo = vaddq_f32(c, lo);
+        const float32x4_t s_hi = vaddq_f32(c, hi);
+        vst1q_f32(out + i, s_lo);
+        vst1q_f32(out + i + 4, s_hi);
+        c = vdupq_laneq_f32(s_hi, 3);
+    }
+    return ref_window_sums(a + i, n - i, window, vgetq_lane_f32(c, 0), out + i);
+}
+
+void metric_neon(const float* p_re, const float* p_im, const float* r, std::size_t n, float* m) {
+    const float32x4_t floor = vdupq_n_f32(kMetricFloor);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t pr = vld1q_f32(p_re + i), pi = vld1q_f32(p_im + i);
+        const float32x4_t rr = vld1q_f32(r + i);
+        const float32x4_t num = vaddq_f32(vmulq_f32(pr, pr), vmulq_f32(pi, pi));
+        const float32x4_t den2 = vmulq_f32(rr, rr);
+        const float32x4_t den = vbslq_f32(vcgtq_f32(den2, floor), den2, floor);
+        vst1q_f32(m + i, vdivq_f32(num, den));
+    }
+    ref_metric(p_re + i, p_im + i, r + i, n - i, m + i);
+}
+
+std::size_t find_neon(const float* m, std::size_t n, float threshold, bool above) {
+    const float32x4_t t = vdupq_n_f32(threshold);
+    const uint32x4_t flip = vdupq_n_u32(above ? 0u : ~0u);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const uint32x4_t hit = veorq_u32(vcgtq_f32(vld1q_f32(m + i), t), flip);
+        if (vmaxvq_u32(hit) != 0) {
+            break;
+        }
+    }
+    return i + ref_find(m + i, n - i, threshold, above);
+}
+
+}  // namespace
+
+const SyncKernels sync_neon = {lagged_products_neon, window_sums_neon, metric_neon, find_neon};
+
+}  // namespace dcomm::kernels
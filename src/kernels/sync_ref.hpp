@@ -0,0 +1,77 @@
+#pragma once
+
+// Scalar reference sync kernels (see sync_kernels.hpp for the contract).
+// The window-sum scan is written lane by lane as the vector kernels run
+// it, zeros included, so that results match bit for bit. Internal
+// linkage: every kernel translation unit includes this for its tail.
+
+#include <cstddef>
+
+#include "sync_kernels.hpp"
+
+namespace dcomm::kernels {
+namespace {
+
+inline constexpr float kMetricFloor = 1e-30f;
+
+inline void ref_lagged_products(const float* x, std::size_t n, std::size_t lag, float* c_re,
+                                float* c_im, float* e) noexcept {
+    const float* y = x + 2 * lag;
+    for (std::size_t i = 0; i < n; ++i) {
+        const float xr = x[2 * i], xi = x[2 * i + 1];
+        const float yr = y[2 * i], yi = y[2 * i + 1];
+        c_re[i] = xr * yr + xi * yi;
+        c_im[i] = xr * yi - xi * yr;
+        e[i] = yr * yr + yi * yi;
+    }
+}
+
+inline float ref_window_sums(const float* a, std::size_t n, std::size_t window, float carry,
+                             float* out) noexcept {
+    std::size_t i = 0;
+    for (; i + kScanLanes <= n; i += kScanLanes) {
+        float d[kScanLanes];
+        for (std::size_t j = 0; j < kScanLanes; ++j) {
+            d[j] = a[i + j] - a[i + j - window];
+        }
+        for (std::size_t shift = 1; shift < kScanLanes; shift *= 2) {
+            float t[kScanLanes];
+            for (std::size_t j = 0; j < kScanLanes; ++j) {
+                t[j] = d[j] + (j >= shift ? d[j - shift] : 0.0f);
+            }
+            for (std::size_t j = 0; j < kScanLanes; ++j) {
+                d[j] = t[j];
+            }
+        }
+        for (std::size_t j = 0; j < kScanLanes; ++j) {
+            out[i + j] = carry + d[j];
+        }
+        carry = out[i + kScanLanes - 1];
+    }
+    for (; i < n; ++i) {
+        carry = carry + (a[i] - a[i - window]);
+        out[i] = carry;
+    }
+    return carry;
+}
+
+inline void ref_metric(const float* p_re, const float* p_im, const float* r, std::size_t n,
+                       float* m) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        const float num = p_re[i] * p_re[i] + p_im[i] * p_im[i];
+        const float den = r[i] * r[i];
+        m[i] = num / (den > kMetricFloor ? den : kMetricFloor);
+    }
+}
+
+inline std::size_t ref_find(const float* m, std::size_t n, float threshold, bool above) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        if ((m[i] > threshold) == above) {
+            return i;
+        }
+    }
+    return n;
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
@@ -0,0 +1,32 @@
+#include "sync_kernels.hpp"
+#include "sync_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void lagged_products_scalar(const float* x, std::size_t n, std::size_t lag, float* c_re,
+                            float* c_im, float* e) {
+    ref_lagged_products(x, n, lag, c_re, c_im, e);
+}
+
+float window_sums_scalar(const float* a, std::size_t n, std::size_t window, float carry,
+                         float* out) {
+    return ref_window_sums(a, n, window, carry, out);
+}
+
+void metric_scalar(const float* p_re, const float* p_im, const float* r, std::size_t n,
+                   float* m) {
+    ref_metric(p_re, p_im, r, n, m);
+}
+
+std::size_t find_scalar(const float* m, std::size_t n, float threshold, bool above) {
+    return ref_find(m, n, threshold, above);
+}
+
+}  // namespace
+
+const SyncKernels sync_scalar = {lagged_products_scalar, window_sums_scalar, metric_scalar,
+                                 find_scalar};
+
+}  // namespace dcomm::kernels
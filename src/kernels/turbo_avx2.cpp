@@ -0,0 +1,148 @@
+// AVX2 max-log-MAP: 16 sub-blocks per register, one register per trellis
+// state. Lanes never interact, so the ACS needs no shuffles and the whole
+// trellis of a step is a fixed sequence of saturating adds and maxes.
+
+#include <immintrin.h>
+
+#include "turbo_kernels.hpp"
+#include "turbo_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+struct Ymm {
+    using V = __m256i;
+    static constexpr std::size_t kLanes = 16;
+    static V load(const std::int16_t* p) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    static void store(std::int16_t* p, V v) noexcept {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    static V set1(std::int16_t v) noexcept { return _mm256_set1_epi16(v); }
+    static V zero() noexcept { return _mm256_setzero_si256(); }
+    static V adds(V a, V b) noexcept { return _mm256_adds_epi16(a, b); }
+    static V subs(V a, V b) noexcept { return _mm256_subs_epi16(a, b); }
+    static V max(V a, V b) noexcept { return _mm256_max_epi16(a, b); }
+    static V min(V a, V b) noexcept { return _mm256_min_epi16(a, b); }
+    static V srai2(V a) noexcept { return _mm256_srai_epi16(a, 2); }
+    /// hard[l] = llr[l] < 0 as bytes.
+    static void store_hard(std::uint8_t* p, V llr) noexcept {
+        const V neg = _mm256_cmpgt_epi16(zero(), llr);
+        const V bytes = _mm256_permute4x64_epi64(_mm256_packs_epi16(neg, neg), 0xd8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p),
+                         _mm256_castsi256_si128(_mm256_abs_epi8(bytes)));
+    }
+};
+
+/// Lanes [g, g + W::kLanes) of one SISO pass.
+template <class W>
+void siso_group(const std::int16_t* sys, const std::int16_t* par, const std::int16_t* apriori,
+                std::size_t steps, std::size_t lanes, std::size_t g, std::int16_t* alpha,
+                std::int16_t* beta, std::int16_t* scratch, std::int16_t* ext,
+                std::uint8_t* hard) noexcept {
+    using V = typename W::V;
+    constexpr const TurboTrellis& tr = kTurboTrellis;
+    const V zero = W::zero();
+    V m[kTurboStates];
+    V next[kTurboStates];
+    V gm[4];
+    const auto gamma = [&](std::size_t i) {
+        const V sa = W::adds(W::load(sys + i), W::load(apriori + i));
+        const V p = W::load(par + i);
+        gm[0] = zero;
+        gm[1] = W::subs(zero, p);
+        gm[2] = W::subs(zero, sa);
+        gm[3] = W::subs(gm[2], p);
+        return sa;
+    };
+
+    for_each_state([&](auto s) { m[s] = W::load(alpha + s * lanes + g); });
+    for (std::size_t t = 0; t < steps; ++t) {
+        std::int16_t* saved = scratch + t * kTurboStates * lanes + g;
+        for_each_state([&](auto s) { W::store(saved + s * lanes, m[s]); });
+        gamma(t * lanes + g);
+        for_each_state([&](auto s) {
+            next[s] = W::max(W::adds(m[tr.from[s][0]], gm[tr.from_branch[s][0]]),
+                             W::adds(m[tr.from[s][1]], gm[tr.from_branch[s][1]]));
+        });
+        const V ref = next[0];
+        for_each_state([&](auto s) { m[s] = W::subs(next[s], ref); });
+    }
+    for_each_state([&](auto s) { W::store(alpha + s * lanes + g, m[s]); });
+
+    const V ext_max = W::set1(kTurboExtMax);
+    const V ext_min = W::set1(-kTurboExtMax);
+    for_each_state([&](auto s) { m[s] = W::load(beta + s * lanes + g); });
+    for (std::size_t t = steps; t-- > 0;) {
+        const std::size_t i = t * lanes + g;
+        const std::int16_t* saved = scratch + t * kTurboStates * lanes + g;
+        const V sa = gamma(i);
+        V m0 = W::set1(-32768);
+        V m1 = m0;
+        for_each_state([&](auto s) {
+            const V q0 = W::adds(gm[tr.to_branch[s][0]], m[tr.to[s][0]]);
+            const V q1 = W::adds(gm[tr.to_branch[s][1]], m[tr.to[s][1]]);
+            const V a = W::load(saved + s * lanes);
+            m0 = W::max(m0, W::adds(a, q0));
+            m1 = W::max(m1, W::adds(a, q1));
+            next[s] = W::max(q0, q1);
+        });
+        const V ref = next[0];
+        for_each_state([&](auto s) { m[s] = W::subs(next[s], ref); });
+        const V llr = W::subs(m0, m1);
+        V e = W::subs(llr, sa);
+        e = W::subs(e, W::srai2(e));
+        W::store(ext + i, W::min(W::max(e, ext_min), ext_max));
+        W::store_hard(hard + i, llr);
+    }
+    for_each_state([&](auto s) { W::store(beta + s * lanes + g, m[s]); });
+}
+
+void siso_avx2(const std::int16_t* sys, const std::int16_t* par, const std::int16_t* apriori,
+               std::size_t steps, std::size_t lanes, std::int16_t* alpha, std::int16_t* beta,
+               std::int16_t* scratch, std::int16_t* ext, std::uint8_t* hard) {
+    for (std::size_t g = 0; g < lanes; g += Ymm::kLanes) {
+        siso_group<Ymm>(sys, par, apriori, steps, lanes, g, alpha, beta, scratch, ext, hard);
+    }
+}
+
+std::uint32_t syndrome_avx2(const std::uint8_t* hard, const std::uint32_t* syn, std::size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    for (std::size_t i = 0; i < n; i += 8) {
+        const __m256i h = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(hard + i)));
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(syn + i));
+        acc = _mm256_xor_si256(acc, _mm256_and_si256(_mm256_sub_epi32(_mm256_setzero_si256(), h), s));
+    }
+    __m128i x = _mm_xor_si128(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    x = _mm_xor_si128(x, _mm_shuffle_epi32(x, 0x4e));
+    x = _mm_xor_si128(x, _mm_shuffle_epi32(x, 0xb1));
+    return std::uint32_t(_mm_cvtsi128_si32(x));
+}
+
+void quantize_avx2(const float* in, std::size_t n, float scale, std::int16_t* out) {
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 lo = _mm256_set1_ps(-127.0f);
+    const __m256 hi = _mm256_set1_ps(127.0f);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i q[2];
+        for (unsigned h = 0; h < 2; ++h) {
+            const __m256 v = _mm256_min_ps(
+                _mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i + 8 * h), vscale), lo), hi);
+            q[h] = _mm256_cvttps_epi32(_mm256_add_ps(v, _mm256_or_ps(_mm256_and_ps(v, sign), half)));
+        }
+        Ymm::store(out + i, _mm256_permute4x64_epi64(_mm256_packs_epi32(q[0], q[1]), 0xd8));
+    }
+    ref_turbo_quantize(in + i, n - i, scale, out + i);
+}
+
+}  // namespace
+
+const TurboKernels turbo_avx2 = {siso_avx2, syndrome_avx2, quantize_avx2};
+
+}  // namespace dcomm::kernels
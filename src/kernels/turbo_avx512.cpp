@@ -0,0 +1,170 @@
+// AVX-512 max-log-MAP, same algorithm as turbo_avx2.cpp: 32 sub-blocks per
+// register, with a 256-bit pass for a trailing group of 16 lanes.
+
+#include <immintrin.h>
+
+#include "turbo_kernels.hpp"
+#include "turbo_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+struct Zmm {
+    using V = __m512i;
+    static constexpr std::size_t kLanes = 32;
+    static V load(const std::int16_t* p) noexcept { return _mm512_loadu_si512(p); }
+    static void store(std::int16_t* p, V v) noexcept { _mm512_storeu_si512(p, v); }
+    static V set1(std::int16_t v) noexcept { return _mm512_set1_epi16(v); }
+    static V zero() noexcept { return _mm512_setzero_si512(); }
+    static V adds(V a, V b) noexcept { return _mm512_adds_epi16(a, b); }
+    static V subs(V a, V b) noexcept { return _mm512_subs_epi16(a, b); }
+    static V max(V a, V b) noexcept { return _mm512_max_epi16(a, b); }
+    static V min(V a, V b) noexcept { return _mm512_min_epi16(a, b); }
+    static V srai2(V a) noexcept { return _mm512_srai_epi16(a, 2); }
+    static void store_hard(std::uint8_t* p, V llr) noexcept {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p),
+                            _mm256_maskz_set1_epi8(_mm512_movepi16_mask(llr), 1));
+    }
+};
+
+struct Ymm {
+    using V = __m256i;
+    static constexpr std::size_t kLanes = 16;
+    static V load(const std::int16_t* p) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    static void store(std::int16_t* p, V v) noexcept {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    static V set1(std::int16_t v) noexcept { return _mm256_set1_epi16(v); }
+    static V zero() noexcept { return _mm256_setzero_si256(); }
+    static V adds(V a, V b) noexcept { return _mm256_adds_epi16(a, b); }
+    static V subs(V a, V b) noexcept { return _mm256_subs_epi16(a, b); }
+    static V max(V a, V b) noexcept { return _mm256_max_epi16(a, b); }
+    static V min(V a, V b) noexcept { return _mm256_min_epi16(a, b); }
+    static V srai2(V a) noexcept { return _mm256_srai_epi16(a, 2); }
+    static void store_hard(std::uint8_t* p, V llr) noexcept {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p),
+                         _mm_maskz_set1_epi8(_mm256_movepi16_mask(llr), 1));
+    }
+};
+
+/// Lanes [g, g + W::kLanes) of one SISO pass.
+template <class W>
+void siso_group(const std::int16_t* sys, const std::int16_t* par, const std::int16_t* apriori,
+                std::size_t steps, std::size_t lanes, std::size_t g, std::int16_t* alpha,
+                std::int16_t* beta, std::int16_t* scratch, std::int16_t* ext,
+                std::uint8_t* hard) noexcept {
+    using V = typename W::V;
+    constexpr const TurboTrellis& tr = kTurboTrellis;
+    const V zero = W::zero();
+    V m[kTurboStates];
+    V next[kTurboStates];
+    V gm[4];
+    const auto gamma = [&](std::size_t i) {
+        const V sa = W::adds(W::load(sys + i), W::load(apriori + i));
+        const V p = W::load(par + i);
+        gm[0] = zero;
+        gm[1] = W::subs(zero, p);
+        gm[2] = W::subs(zero, sa);
+        gm[3] = W::subs(gm[2], p);
+        return sa;
+    };
+
+    for_each_state([&](auto s) { m[s] = W::load(alpha + s * lanes + g); });
+    for (std::size_t t = 0; t < steps; ++t) {
+        std::int16_t* saved = scratch + t * kTurboStates * lanes + g;
+        for_each_state([&](auto s) { W::store(saved + s * lanes, m[s]); });
+        gamma(t * lanes + g);
+        for_each_state([&](auto s) {
+            next[s] = W::max(W::adds(m[tr.from[s][0]], gm[tr.from_branch[s][0]]),
+                             W::adds(m[tr.from[s][1]], gm[tr.from_branch[s][1]]));
+        });
+        const V ref = next[0];
+        for_each_state([&](auto s) { m[s] = W::subs(next[s], ref); });
+    }
+    for_each_state([&](auto s) { W::store(alpha + s * lanes + g, m[s]); });
+
+    const V ext_max = W::set1(kTurboExtMax);
+    const V ext_min = W::set1(-kTurboExtMax);
+    for_each_state([&](auto s) { m[s] = W::load(beta + s * lanes + g); });
+    for (std::size_t t = steps; t-- > 0;) {
+        const std::size_t i = t * lanes + g;
+        const std::int16_t* saved = scratch + t * kTurboStates * lanes + g;
+        const V sa = gamma(i);
+        V m0 = W::set1(-32768);
+        V m1 = m0;
+        for_each_state([&](auto s) {
+            const V q0 = W::adds(gm[tr.to_branch[s][0]], m[tr.to[s][0]]);
+            const V q1 = W::adds(gm[tr.to_branch[s][1]], m[tr.to[s][1]]);
+            const V a = W::load(saved + s * lanes);
+            m0 = W::max(m0, W::adds(a, q0));
+            m1 = W::max(m1, W::adds(a, q1));
+            next[s] = W::max(q0, q1);
+        });
+        const V ref = next[0];
+        for_each_state([&](auto s) { m[s] = W::subs(next[s], ref); });
+        const V llr = W::subs(m0, m1);
+        V e = W::subs(llr, sa);
+        e = W::subs(e, W::srai2(e));
+        W::store(ext + i, W::min(W::max(e, ext_min), ext_max));
+        W::store_hard(hard + i, llr);
+    }
+    for_each_state([&](auto s) { W::store(beta + s * lanes + g, m[s]); });
+}
+
+void siso_avx512(const std::int16_t* sys, const std::int16_t* par, const std::int16_t* apriori,
+                 std::size_t steps, std::size_t lanes, std::int16_t* alpha, std::int16_t* beta,
+                 std::int16_t* scratch, std::int16_t* ext, std::uint8_t* hard) {
+    std::size_t g = 0;
+    for (; g + Zmm::kLanes <= lanes; g += Zmm::kLanes) {
+        siso_group<Zmm>(sys, par, apriori, steps, lanes, g, alpha, beta, scratch, ext, hard);
+    }
+    if (g < lanes) {
+        siso_group<Ymm>(sys, par, apriori, steps, lanes, g, alpha, beta, scratch, ext, hard);
+    }
+}
+
+std::uint32_t syndrome_avx512(const std::uint8_t* hard, const std::uint32_t* syn,
+                              std::size_t n) {
+    __m512i acc = _mm512_setzero_si512();
+    for (std::size_t i = 0; i < n; i += 16) {
+        const __m512i h =
+            _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hard + i)));
+        acc = _mm512_mask_xor_epi32(acc, _mm512_test_epi32_mask(h, h), acc,
+                                    _mm512_loadu_si512(syn + i));
+    }
+    // Reduce through memory: GCC 12's 512-bit extract intrinsics trip
+    // -Wuninitialized.
+    alignas(64) std::uint32_t lanes[16];
+    _mm512_store_si512(lanes, acc);
+    std::uint32_t x = 0;
+    for (const std::uint32_t v : lanes) {
+        x ^= v;
+    }
+    return x;
+}
+
+void quantize_avx512(const float* in, std::size_t n, float scale, std::int16_t* out) {
+    const __m512 vscale = _mm512_set1_ps(scale);
+    const __m512 lo = _mm512_set1_ps(-127.0f);
+    const __m512 hi = _mm512_set1_ps(127.0f);
+    const __m512i sign = _mm512_set1_epi32(std::int32_t(0x80000000u));
+    const __m512i half = _mm512_castps_si512(_mm512_set1_ps(0.5f));
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512 v =
+            _mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(_mm512_loadu_ps(in + i), vscale), lo), hi);
+        const __m512i h = _mm512_or_si512(_mm512_and_si512(_mm512_castps_si512(v), sign), half);
+        const __m512i q = _mm512_cvttps_epi32(_mm512_add_ps(v, _mm512_castsi512_ps(h)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_cvtepi32_epi16(q));
+    }
+    ref_turbo_quantize(in + i, n - i, scale, out + i);
+}
+
+}  // namespace
+
+const TurboKernels turbo_avx512 = {siso_avx512, syndrome_avx512, quantize_avx512};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,47 @@
+#pragma once
+
+// Per-ISA max-log-MAP kernel behind TurboDecoder.
+//
+// A constituent decoder pass covers `lanes` independent sub-blocks of the
+// codeblock at once, one sub-block per SIMD lane: every array is laid out
+// step-major, element t * lanes + l belonging to step t of sub-block l.
+// `alpha` and `beta` hold the 8 state metrics of every lane as rows of
+// `lanes` values (state-major); on entry they are the metrics at the start
+// and end of each sub-block, on return the metrics at its end and start, so
+// the caller can pass them to the neighbouring sub-blocks on the next
+// iteration. `scratch` holds steps * 8 * lanes forward metrics.
+//
+// All arithmetic is saturating int16 and every variant is bit-exact with
+// the reference. `lanes` is a multiple of kTurboLaneAlign.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dcomm::kernels {
+
+inline constexpr std::size_t kTurboLaneAlign = 16;
+
+struct TurboKernels {
+    /// One SISO pass. `sys` and `apriori` are added to form the systematic
+    /// input. Writes the scaled, clamped extrinsic output to `ext` and the
+    /// a-posteriori hard decision (1 for a negative LLR) to `hard`.
+    void (*siso)(const std::int16_t* sys, const std::int16_t* par, const std::int16_t* apriori,
+                 std::size_t steps, std::size_t lanes, std::int16_t* alpha, std::int16_t* beta,
+                 std::int16_t* scratch, std::int16_t* ext, std::uint8_t* hard);
+    /// XOR of syn[i] over all i with hard[i] set; `n` is a multiple of 16.
+    std::uint32_t (*syndrome)(const std::uint8_t* hard, const std::uint32_t* syn,
+                              std::size_t n);
+    /// out[i] = clamp(in[i] * scale, -127, 127) rounded half away from zero.
+    void (*quantize)(const float* in, std::size_t n, float scale, std::int16_t* out);
+};
+
+extern const TurboKernels turbo_scalar;
+#if defined(DCOMM_KERNELS_X86)
+extern const TurboKernels turbo_avx2;
+extern const TurboKernels turbo_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+extern const TurboKernels turbo_neon;
+#endif
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,137 @@
+// NEON max-log-MAP, same algorithm as turbo_avx2.cpp with eight sub-blocks
+// per register.
+
+#include <arm_neon.h>
+
+#include "turbo_kernels.hpp"
+#include "turbo_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+struct Q {
+    using V = int16x8_t;
+    static constexpr std::size_t kLanes = 8;
+    static V load(const std::int16_t* p) noexcept { return vld1q_s16(p); }
+    static void store(std::int16_t* p, V v) noexcept { vst1q_s16(p, v); }
+    static V set1(std::int16_t v) noexcept { return vdupq_n_s16(v); }
+    static V zero() noexcept { return vdupq_n_s16(0); }
+    static V adds(V a, V b) noexcept { return vqaddq_s16(a, b); }
+    static V subs(V a, V b) noexcept { return vqsubq_s16(a, b); }
+    static V max(V a, V b) noexcept { return vmaxq_s16(a, b); }
+    static V min(V a, V b) noexcept { return vminq_s16(a, b); }
+    static V srai2(V a) noexcept { return vshrq_n_s16(a, 2); }
+    static void store_hard(std::uint8_t* p, V llr) noexcept {
+        vst1_u8(p, vshrn_n_u16(vcltzq_s16(llr), 15));
+    }
+};
+
+/// Lanes [g, g + W::kLanes) of one SISO pass.
+template <class W>
+void siso_group(const std::int16_t* sys, const std::int16_t* par, const std::int16_t* apriori,
+                std::size_t steps, std::size_t lanes, std::size_t g, std::int16_t* alpha,
+                std::int16_t* beta, std::int16_t* scratch, std::int16_t* ext,
+                std::uint8_t* hard) noexcept {
+    using V = typename W::V;
+    constexpr const TurboTrellis& tr = kTurboTrellis;
+    const V zero = W::zero();
+    V m[kTurboStates];
+    V next[kTurboStates];
+    V gm[4];
+    const auto gamma = [&](std::size_t i) {
+        const V sa = W::adds(W::load(sys + i), W::load(apriori + i));
+        const V p = W::load(par + i);
+        gm[0] = zero;
+        gm[1] = W::subs(zero, p);
+        gm[2] = W::subs(zero, sa);
+        gm[3] = W::subs(gm[2], p);
+        return sa;
+    };
+
+    for_each_state([&](auto s) { m[s] = W::load(alpha + s * lanes + g); });
+    for (std::size_t t = 0; t < steps; ++t) {
+        std::int16_t* saved = scratch + t * kTurboStates * lanes + g;
+        for_each_state([&](auto s) { W::store(saved + s * lanes, m[s]); });
+        gamma(t * lanes + g);
+        for_each_state([&](auto s) {
+            next[s] = W::max(W::adds(m[tr.from[s][0]], gm[tr.from_branch[s][0]]),
+                             W::adds(m[tr.from[s][1]], gm[tr.from_branch[s][1]]));
+        });
+        const V ref = next[0];
+        for_each_state([&](auto s) { m[s] = W::subs(next[s], ref); });
+    }
+    for_each_state([&](auto s) { W::store(alpha + s * lanes + g, m[s]); });
+
+    const V ext_max = W::set1(kTurboExtMax);
+    const V ext_min = W::set1(-kTurboExtMax);
+    for_each_state([&](auto s) { m[s] = W::load(beta + s * lanes + g); });
+    for (std::size_t t = steps; t-- > 0;) {
+        const std::size_t i = t * lanes + g;
+        const std::int16_t* saved = scratch + t * kTurboStates * lanes + g;
+        const V sa = gamma(i);
+        V m0 = W::set1(-32768);
+        V m1 = m0;
+        for_each_state([&](auto s) {
+            const V q0 = W::adds(gm[tr.to_branch[s][0]], m[tr.to[s][0]]);
+            const V q1 = W::adds(gm[tr.to_branch[s][1]], m[tr.to[s][1]]);
+            const V a = W::load(saved + s * lanes);
+            m0 = W::max(m0, W::adds(a, q0));
+            m1 = W::max(m1, W::adds(a, q1));
+            next[s] = W::max(q0, q1);
+        });
+        const V ref = next[0];
+        for_each_state([&](auto s) { m[s] = W::subs(next[s], ref); });
+        const V llr = W::subs(m0, m1);
+        V e = W::subs(llr, sa);
+        e = W::subs(e, W::srai2(e));
+        W::store(ext + i, W::min(W::max(e, ext_min), ext_max));
+        W::store_hard(hard + i, llr);
+    }
+    for_each_state([&](auto s) { W::store(beta + s * lanes + g, m[s]); });
+}
+
+void siso_neon(const std::int16_t* sys, const std::int16_t* par, const std::int16_t* apriori,
+               std::size_t steps, std::size_t lanes, std::int16_t* alpha, std::int16_t* beta,
+               std::int16_t* scratch, std::int16_t* ext, std::uint8_t* hard) {
+    for (std::size_t g = 0; g < lanes; g += Q::kLanes) {
+        siso_group<Q>(sys, par, apriori, steps, lanes, g, alpha, beta, scratch, ext, hard);
+    }
+}
+
+std::uint32_t syndrome_neon(const std::uint8_t* hard, const std::uint32_t* syn, std::size_t n) {
+    uint32x4_t acc = vdupq_n_u32(0);
+    for (std::size_t i = 0; i < n; i += 8) {
+        const uint16x8_t h = vmovl_u8(vld1_u8(hard + i));
+        const uint32x4_t h0 = vmovl_u16(vget_low_u16(h));
+        const uint32x4_t h1 = vmovl_u16(vget_high_u16(h));
+        acc = veorq_u32(acc, vandq_u32(vtstq_u32(h0, h0), vld1q_u32(syn + i)));
+        acc = veorq_u32(acc, vandq_u32(vtstq_u32(h1, h1), vld1q_u32(syn + i + 4)));
+    }
+    return vgetq_lane_u32(acc, 0) ^ vgetq_lane_u32(acc, 1) ^ vgetq_lane_u32(acc, 2) ^
+           vgetq_lane_u32(acc, 3);
+}
+
+void quantize_neon(const float* in, std::size_t n, float scale, std::int16_t* out) {
+    const float32x4_t lo = vdupq_n_f32(-127.0f);
+    const float32x4_t hi = vdupq_n_f32(127.0f);
+    const uint32x4_t sign = vdupq_n_u32(0x80000000u);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int32x4_t q[2];
+        for (unsigned h = 0; h < 2; ++h) {
+            const float32x4_t v =
+                vminq_f32(vmaxq_f32(vmulq_n_f32(vld1q_f32(in + i + 4 * h), scale), lo), hi);
+            q[h] = vcvtq_s32_f32(vaddq_f32(v, vbslq_f32(sign, v, half)));
+        }
+        vst1q_s16(out + i, vcombine_s16(vmovn_s32(q[0]), vmovn_s32(q[1])));
+    }
+    ref_turbo_quantize(in + i, n - i, scale, out + i);
+}
+
+}  // namespace
+
+const TurboKernels turbo_neon = {siso_neon, syndrome_neon, quantize_neon};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,165 @@
+#pragma once
+
+// Scalar reference max-log-MAP (see turbo_kernels.hpp) and the trellis of
+// the LTE constituent code, g0 = 1 + D^2 + D^3 (feedback), g1 = 1 + D + D^3.
+//
+// State s = d1 << 2 | d2 << 1 | d3, the register contents with the newest
+// bit in d1. Input u feeds back as a = u ^ d2 ^ d3, the parity is
+// z = a ^ d1 ^ d3 and the next state is a << 2 | s >> 1.
+//
+// Branch metrics drop the constant per-step offset: the branch with input u
+// and parity z scores -(u * sys) - (z * par), one of the four values
+// {0, -par, -sys, -sys - par} indexed by u << 1 | z.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace dcomm::kernels {
+namespace {
+
+constexpr unsigned kTurboStates = 8;
+/// Largest extrinsic magnitude passed between the constituent decoders.
+constexpr std::int16_t kTurboExtMax = 1024;
+
+struct TurboTrellis {
+    // Forward: the two predecessors of state s and their branch index.
+    std::array<std::array<std::uint8_t, 2>, kTurboStates> from{};
+    std::array<std::array<std::uint8_t, 2>, kTurboStates> from_branch{};
+    // Backward: successor of state s for input u, and its branch index.
+    std::array<std::array<std::uint8_t, 2>, kTurboStates> to{};
+    std::array<std::array<std::uint8_t, 2>, kTurboStates> to_branch{};
+};
+
+constexpr TurboTrellis make_turbo_trellis() {
+    TurboTrellis t;
+    for (unsigned s = 0; s < kTurboStates; ++s) {
+        const unsigned d1 = (s >> 2) & 1u;
+        const unsigned d2 = (s >> 1) & 1u;
+        const unsigned d3 = s & 1u;
+        for (unsigned u = 0; u < 2; ++u) {
+            const unsigned a = u ^ d2 ^ d3;
+            const unsigned z = a ^ d1 ^ d3;
+            const unsigned next = a << 2 | s >> 1;
+            t.to[s][u] = std::uint8_t(next);
+            t.to_branch[s][u] = std::uint8_t(u << 1 | z);
+            // Predecessors of `next` differ in d3.
+            t.from[next][d3] = std::uint8_t(s);
+            t.from_branch[next][d3] = std::uint8_t(u << 1 | z);
+        }
+    }
+    return t;
+}
+
+constexpr TurboTrellis kTurboTrellis = make_turbo_trellis();
+
+/// Call f(std::integral_constant<unsigned, s>{}) for every state, fully
+/// unrolled, so SIMD variants can keep the state metrics in registers.
+template <class F, unsigned... S>
+inline void for_each_state(F&& f, std::integer_sequence<unsigned, S...>) {
+    (f(std::integral_constant<unsigned, S>{}), ...);
+}
+template <class F>
+inline void for_each_state(F&& f) {
+    for_each_state(f, std::make_integer_sequence<unsigned, kTurboStates>{});
+}
+
+inline std::int16_t ref_turbo_sat(int v) noexcept {
+    return std::int16_t(std::clamp(v, -32768, 32767));
+}
+
+/// 0.75 * e with an arithmetic shift, clamped to +-kTurboExtMax.
+inline std::int16_t ref_turbo_scale_ext(std::int16_t e) noexcept {
+    const std::int16_t scaled = ref_turbo_sat(e - (e >> 2));
+    return std::clamp<std::int16_t>(scaled, -kTurboExtMax, kTurboExtMax);
+}
+
+inline void ref_turbo_gamma(int sys, int par, std::int16_t* g) noexcept {
+    g[0] = 0;
+    g[1] = ref_turbo_sat(-par);
+    g[2] = ref_turbo_sat(-sys);
+    g[3] = ref_turbo_sat(g[2] - par);
+}
+
+inline void ref_turbo_siso(const std::int16_t* sys, const std::int16_t* par,
+                           const std::int16_t* apriori, std::size_t steps, std::size_t lanes,
+                           std::int16_t* alpha, std::int16_t* beta, std::int16_t* scratch,
+                           std::int16_t* ext, std::uint8_t* hard) noexcept {
+    const TurboTrellis& tr = kTurboTrellis;
+    for (std::size_t l = 0; l < lanes; ++l) {
+        std::int16_t a[kTurboStates];
+        std::int16_t next[kTurboStates];
+        std::int16_t g[4];
+        for (unsigned s = 0; s < kTurboStates; ++s) {
+            a[s] = alpha[s * lanes + l];
+        }
+        for (std::size_t t = 0; t < steps; ++t) {
+            const std::size_t i = t * lanes + l;
+            for (unsigned s = 0; s < kTurboStates; ++s) {
+                scratch[(t * kTurboStates + s) * lanes + l] = a[s];
+            }
+            ref_turbo_gamma(ref_turbo_sat(sys[i] + apriori[i]), par[i], g);
+            for (unsigned s = 0; s < kTurboStates; ++s) {
+                next[s] = std::max(ref_turbo_sat(a[tr.from[s][0]] + g[tr.from_branch[s][0]]),
+                                   ref_turbo_sat(a[tr.from[s][1]] + g[tr.from_branch[s][1]]));
+            }
+            for (unsigned s = 0; s < kTurboStates; ++s) {
+                a[s] = ref_turbo_sat(next[s] - next[0]);
+            }
+        }
+        for (unsigned s = 0; s < kTurboStates; ++s) {
+            alpha[s * lanes + l] = a[s];
+        }
+
+        std::int16_t b[kTurboStates];
+        for (unsigned s = 0; s < kTurboStates; ++s) {
+            b[s] = beta[s * lanes + l];
+        }
+        for (std::size_t t = steps; t-- > 0;) {
+            const std::size_t i = t * lanes + l;
+            const std::int16_t sa = ref_turbo_sat(sys[i] + apriori[i]);
+            ref_turbo_gamma(sa, par[i], g);
+            std::int16_t m0 = -32768;
+            std::int16_t m1 = -32768;
+            for (unsigned s = 0; s < kTurboStates; ++s) {
+                const std::int16_t q0 = ref_turbo_sat(g[tr.to_branch[s][0]] + b[tr.to[s][0]]);
+                const std::int16_t q1 = ref_turbo_sat(g[tr.to_branch[s][1]] + b[tr.to[s][1]]);
+                const std::int16_t as = scratch[(t * kTurboStates + s) * lanes + l];
+                m0 = std::max(m0, ref_turbo_sat(as + q0));
+                m1 = std::max(m1, ref_turbo_sat(as + q1));
+                next[s] = std::max(q0, q1);
+            }
+            for (unsigned s = 0; s < kTurboStates; ++s) {
+                b[s] = ref_turbo_sat(next[s] - next[0]);
+            }
+            const std::int16_t llr = ref_turbo_sat(m0 - m1);
+            ext[i] = ref_turbo_scale_ext(ref_turbo_sat(llr - sa));
+            hard[i] = llr < 0;
+        }
+        for (unsigned s = 0; s < kTurboStates; ++s) {
+            beta[s * lanes + l] = b[s];
+        }
+    }
+}
+
+inline std::uint32_t ref_turbo_syndrome(const std::uint8_t* hard, const std::uint32_t* syn,
+                                        std::size_t n) noexcept {
+    std::uint32_t acc = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        acc ^= hard[i] ? syn[i] : 0u;
+    }
+    return acc;
+}
+
+inline void ref_turbo_quantize(const float* in, std::size_t n, float scale,
+                               std::int16_t* out) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        const float v = std::clamp(in[i] * scale, -127.0f, 127.0f);
+        out[i] = std::int16_t(v + (v < 0.0f ? -0.5f : 0.5f));
+    }
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
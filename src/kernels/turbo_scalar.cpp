@@ -0,0 +1,27 @@
+#include "turbo_kernels.hpp"
+#include "turbo_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void siso_scalar(const std::int16_t* sys, const std::int16_t* par, const std::int16_t* apriori,
+                 std::size_t steps, std::size_t lanes, std::int16_t* alpha, std::int16_t* beta,
+                 std::int16_t* scratch, std::int16_t* ext, std::uint8_t* hard) {
+    ref_turbo_siso(sys, par, apriori, steps, lanes, alpha, beta, scratch, ext, hard);
+}
+
+std::uint32_t syndrome_scalar(const std::uint8_t* hard, const std::uint32_t* syn,
+                              std::size_t n) {
+    return ref_turbo_syndrome(hard, syn, n);
+}
+
+void quantize_scalar(const float* in, std::size_t n, float scale, std::int16_t* out) {
+    ref_turbo_quantize(in, n, scale, out);
+}
+
+}  // namespace
+
+const TurboKernels turbo_scalar = {siso_scalar, syndrome_scalar, quantize_scalar};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,115 @@
+// AVX2 add-compare-select: the 64 int16 metrics live in four registers for
+// the whole call. Each stage splits them into even and odd predecessors
+// (in-lane byte shuffle + qword permute), runs the 32 butterflies as two
+// registers of each successor half, and packs the compare masks straight
+// into the 64-bit decision word.
+
+#include <immintrin.h>
+
+#include "viterbi_kernels.hpp"
+#include "viterbi_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+inline __m256i load(const std::int16_t* p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+inline void store(std::int16_t* p, __m256i v) noexcept {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+/// Evens of each 128-bit lane to the low half of the register, odds high.
+inline __m256i split(__m256i v) noexcept {
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15,
+                                             0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, shuffle), 0xd8);
+}
+
+inline std::uint32_t decision_bits(__m256i c0, __m256i c1) noexcept {
+    return std::uint32_t(
+        _mm256_movemask_epi8(_mm256_permute4x64_epi64(_mm256_packs_epi16(c0, c1), 0xd8)));
+}
+
+void forward_avx2(const std::int16_t* llrs, std::size_t steps, std::int16_t* metrics,
+                  std::uint64_t* decisions) {
+    const __m256i sa0 = load(kBranchA.data());
+    const __m256i sa1 = load(kBranchA.data() + 16);
+    const __m256i sb0 = load(kBranchB.data());
+    const __m256i sb1 = load(kBranchB.data() + 16);
+    __m256i m0 = load(metrics);
+    __m256i m1 = load(metrics + 16);
+    __m256i m2 = load(metrics + 32);
+    __m256i m3 = load(metrics + 48);
+    for (std::size_t t = 0; t < steps; ++t) {
+        const __m256i la = _mm256_set1_epi16(llrs[2 * t]);
+        const __m256i lb = _mm256_set1_epi16(llrs[2 * t + 1]);
+        const __m256i b0 = _mm256_adds_epi16(_mm256_sign_epi16(la, sa0), _mm256_sign_epi16(lb, sb0));
+        const __m256i b1 = _mm256_adds_epi16(_mm256_sign_epi16(la, sa1), _mm256_sign_epi16(lb, sb1));
+
+        const __m256i s0 = split(m0);
+        const __m256i s1 = split(m1);
+        const __m256i s2 = split(m2);
+        const __m256i s3 = split(m3);
+        const __m256i e0 = _mm256_permute2x128_si256(s0, s1, 0x20);  // states 0, 2, .., 30
+        const __m256i o0 = _mm256_permute2x128_si256(s0, s1, 0x31);
+        const __m256i e1 = _mm256_permute2x128_si256(s2, s3, 0x20);  // states 32, .., 62
+        const __m256i o1 = _mm256_permute2x128_si256(s2, s3, 0x31);
+
+        const __m256i lo00 = _mm256_adds_epi16(e0, b0);
+        const __m256i lo01 = _mm256_subs_epi16(o0, b0);
+        const __m256i lo10 = _mm256_adds_epi16(e1, b1);
+        const __m256i lo11 = _mm256_subs_epi16(o1, b1);
+        const __m256i hi00 = _mm256_subs_epi16(e0, b0);
+        const __m256i hi01 = _mm256_adds_epi16(o0, b0);
+        const __m256i hi10 = _mm256_subs_epi16(e1, b1);
+        const __m256i hi11 = _mm256_adds_epi16(o1, b1);
+
+        const std::uint32_t dlo = decision_bits(_mm256_cmpgt_epi16(lo01, lo00),
+                                                _mm256_cmpgt_epi16(lo11, lo10));
+        const std::uint32_t dhi = decision_bits(_mm256_cmpgt_epi16(hi01, hi00),
+                                                _mm256_cmpgt_epi16(hi11, hi10));
+        decisions[t] = std::uint64_t(dhi) << 32 | dlo;
+
+        m0 = _mm256_max_epi16(lo00, lo01);
+        m1 = _mm256_max_epi16(lo10, lo11);
+        m2 = _mm256_max_epi16(hi00, hi01);
+        m3 = _mm256_max_epi16(hi10, hi11);
+        const __m256i ref = _mm256_broadcastw_epi16(_mm256_castsi256_si128(m0));
+        m0 = _mm256_subs_epi16(m0, ref);
+        m1 = _mm256_subs_epi16(m1, ref);
+        m2 = _mm256_subs_epi16(m2, ref);
+        m3 = _mm256_subs_epi16(m3, ref);
+    }
+    store(metrics, m0);
+    store(metrics + 16, m1);
+    store(metrics + 32, m2);
+    store(metrics + 48, m3);
+}
+
+void quantize_avx2(const float* in, std::size_t n, float scale, std::int16_t* out) {
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 lo = _mm256_set1_ps(-127.0f);
+    const __m256 hi = _mm256_set1_ps(127.0f);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i q[2];
+        for (unsigned h = 0; h < 2; ++h) {
+            const __m256 v = _mm256_min_ps(
+                _mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i + 8 * h), vscale), lo), hi);
+            // copysign(0.5, v): -0.0 rounds to -0.5 and truncates to 0 like +0.5.
+            q[h] = _mm256_cvttps_epi32(_mm256_add_ps(v, _mm256_or_ps(_mm256_and_ps(v, sign), half)));
+        }
+        store(out + i, _mm256_permute4x64_epi64(_mm256_packs_epi32(q[0], q[1]), 0xd8));
+    }
+    ref_viterbi_quantize(in + i, n - i, scale, out + i);
+}
+
+}  // namespace
+
+const ViterbiKernels viterbi_avx2 = {forward_avx2, quantize_avx2};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,78 @@
+// AVX-512 add-compare-select: two registers hold all 64 metrics, a single
+// two-source permute per half splits them into even and odd predecessors,
+// and the compare masks are the decision bits.
+
+#include <immintrin.h>
+
+#include "viterbi_kernels.hpp"
+#include "viterbi_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void forward_avx512(const std::int16_t* llrs, std::size_t steps, std::int16_t* metrics,
+                    std::uint64_t* decisions) {
+    alignas(64) std::int16_t even_idx[32];
+    alignas(64) std::int16_t odd_idx[32];
+    for (int j = 0; j < 32; ++j) {
+        even_idx[j] = std::int16_t(2 * j);
+        odd_idx[j] = std::int16_t(2 * j + 1);
+    }
+    const __m512i even = _mm512_load_si512(even_idx);
+    const __m512i odd = _mm512_load_si512(odd_idx);
+    const __m512i sa = _mm512_loadu_si512(kBranchA.data());
+    const __m512i sb = _mm512_loadu_si512(kBranchB.data());
+    __m512i m0 = _mm512_loadu_si512(metrics);
+    __m512i m1 = _mm512_loadu_si512(metrics + 32);
+    for (std::size_t t = 0; t < steps; ++t) {
+        const __m512i la = _mm512_set1_epi16(llrs[2 * t]);
+        const __m512i lb = _mm512_set1_epi16(llrs[2 * t + 1]);
+        // sa, sb are +-1, so the products are exact.
+        const __m512i b = _mm512_adds_epi16(_mm512_mullo_epi16(la, sa), _mm512_mullo_epi16(lb, sb));
+        const __m512i e = _mm512_permutex2var_epi16(m0, even, m1);
+        const __m512i o = _mm512_permutex2var_epi16(m0, odd, m1);
+        const __m512i lo0 = _mm512_adds_epi16(e, b);
+        const __m512i lo1 = _mm512_subs_epi16(o, b);
+        const __m512i hi0 = _mm512_subs_epi16(e, b);
+        const __m512i hi1 = _mm512_adds_epi16(o, b);
+        // Join the halves in the mask registers (kunpckdq). Widening each
+        // __mmask32 in general registers instead miscompiles with GCC 12 at
+        // -O1 under -fsanitize=undefined: a 32-bit kmovd spill is reloaded
+        // as 64 bits, leaking stale stack bytes into the high decisions.
+        const __mmask32 dlo = _mm512_cmpgt_epi16_mask(lo1, lo0);
+        const __mmask32 dhi = _mm512_cmpgt_epi16_mask(hi1, hi0);
+        decisions[t] = _cvtmask64_u64(_mm512_kunpackd(dhi, dlo));
+        m0 = _mm512_max_epi16(lo0, lo1);
+        m1 = _mm512_max_epi16(hi0, hi1);
+        const __m512i ref = _mm512_broadcastw_epi16(_mm512_castsi512_si128(m0));
+        m0 = _mm512_subs_epi16(m0, ref);
+        m1 = _mm512_subs_epi16(m1, ref);
+    }
+    _mm512_storeu_si512(metrics, m0);
+    _mm512_storeu_si512(metrics + 32, m1);
+}
+
+void quantize_avx512(const float* in, std::size_t n, float scale, std::int16_t* out) {
+    const __m512 vscale = _mm512_set1_ps(scale);
+    const __m512 lo = _mm512_set1_ps(-127.0f);
+    const __m512 hi = _mm512_set1_ps(127.0f);
+    const __m512i sign = _mm512_set1_epi32(std::int32_t(0x80000000u));
+    const __m512i half = _mm512_castps_si512(_mm512_set1_ps(0.5f));
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512 v =
+            _mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(_mm512_loadu_ps(in + i), vscale), lo), hi);
+        // copysign(0.5, v), as in the AVX2 variant.
+        const __m512i h = _mm512_or_si512(_mm512_and_si512(_mm512_castps_si512(v), sign), half);
+        const __m512i q = _mm512_cvttps_epi32(_mm512_add_ps(v, _mm512_castsi512_ps(h)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_cvtepi32_epi16(q));
+    }
+    ref_viterbi_quantize(in + i, n - i, scale, out + i);
+}
+
+}  // namespace
+
+const ViterbiKernels viterbi_avx512 = {forward_avx512, quantize_avx512};
+
+}  // namespace dcomm::kernels
@@ -0,0 +1,33 @@
+#pragma once
+
+// Per-ISA add-compare-select for the K=7 code behind ViterbiDecoder.
+//
+// Path metrics are 64 int16 correlations in state order (state = previous
+// six inputs, most recent in bit 5). Stage t takes the int16 LLR pair of
+// its two coded bits and writes one decision word with bit s set when the
+// survivor into state s came from the odd predecessor ((s << 1) & 63) | 1.
+// Metrics are renormalised to state 0 after every stage and all arithmetic
+// saturates, so every variant is bit-exact with the reference.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dcomm::kernels {
+
+struct ViterbiKernels {
+    void (*forward)(const std::int16_t* llrs, std::size_t steps, std::int16_t* metrics,
+                    std::uint64_t* decisions);
+    /// out[i] = clamp(in[i] * scale, -127, 127) rounded half away from zero.
+    void (*quantize)(const float* in, std::size_t n, float scale, std::int16_t* out);
+};
+
+extern const ViterbiKernels viterbi_scalar;
+#if defined(DCOMM_KERNELS_X86)
+extern const ViterbiKernels viterbi_avx2;
+extern const ViterbiKernels viterbi_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+extern const ViterbiKernels viterbi_neon;
+#endif
+
+}  // namespace dcomm::kernels
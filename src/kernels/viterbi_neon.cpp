@@ -0,0 +1,83 @@
+// NEON add-compare-select: eight registers of metrics; vuzp1/vuzp2 split
+// even and odd predecessors and the compare masks are folded into decision
+// bytes with a weighted horizontal add.
+
+#include <arm_neon.h>
+
+#include "viterbi_kernels.hpp"
+#include "viterbi_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+inline std::uint64_t decision_byte(uint16x8_t c) noexcept {
+    const uint16x8_t weights = {1, 2, 4, 8, 16, 32, 64, 128};
+    return vaddvq_u16(vandq_u16(c, weights));
+}
+
+void forward_neon(const std::int16_t* llrs, std::size_t steps, std::int16_t* metrics,
+                  std::uint64_t* decisions) {
+    int16x8_t m[8];
+    int16x8_t sa[4];
+    int16x8_t sb[4];
+    for (unsigned i = 0; i < 8; ++i) {
+        m[i] = vld1q_s16(metrics + 8 * i);
+    }
+    for (unsigned i = 0; i < 4; ++i) {
+        sa[i] = vld1q_s16(kBranchA.data() + 8 * i);
+        sb[i] = vld1q_s16(kBranchB.data() + 8 * i);
+    }
+    for (std::size_t t = 0; t < steps; ++t) {
+        const int16x8_t la = vdupq_n_s16(llrs[2 * t]);
+        const int16x8_t lb = vdupq_n_s16(llrs[2 * t + 1]);
+        int16x8_t next[8];
+        std::uint64_t d = 0;
+        for (unsigned i = 0; i < 4; ++i) {
+            const int16x8_t b = vqaddq_s16(vmulq_s16(la, sa[i]), vmulq_s16(lb, sb[i]));
+            const int16x8_t e = vuzp1q_s16(m[2 * i], m[2 * i + 1]);
+            const int16x8_t o = vuzp2q_s16(m[2 * i], m[2 * i + 1]);
+            const int16x8_t lo0 = vqaddq_s16(e, b);
+            const int16x8_t lo1 = vqsubq_s16(o, b);
+            const int16x8_t hi0 = vqsubq_s16(e, b);
+            const int16x8_t hi1 = vqaddq_s16(o, b);
+            next[i] = vmaxq_s16(lo0, lo1);
+            next[4 + i] = vmaxq_s16(hi0, hi1);
+            d |= decision_byte(vcgtq_s16(lo1, lo0)) << (8 * i);
+            d |= decision_byte(vcgtq_s16(hi1, hi0)) << (32 + 8 * i);
+        }
+        decisions[t] = d;
+        const int16x8_t ref = vdupq_laneq_s16(next[0], 0);
+        for (unsigned i = 0; i < 8; ++i) {
+            m[i] = vqsubq_s16(next[i], ref);
+        }
+    }
+    for (unsigned i = 0; i < 8; ++i) {
+        vst1q_s16(metrics + 8 * i, m[i]);
+    }
+}
+
+void quantize_neon(const float* in, std::size_t n, float scale, std::int16_t* out) {
+    const float32x4_t lo = vdupq_n_f32(-127.0f);
+    const float32x4_t hi = vdupq_n_f32(127.0f);
+    const uint32x4_t sign = vdupq_n_u32(0x80000000u);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int32x4_t q[2];
+        for (unsigned h = 0; h < 2; ++h) {
+            const float32x4_t v =
+                vminq_f32(vmaxq_f32(vmulq_n_f32(vld1q_f32(in + i + 4 * h), scale), lo), hi);
+            // copysign(0.5, v), as in the AVX2 variant.
+            q[h] = vcvtq_s32_f32(vaddq_f32(v, vbslq_f32(sign, v, half)));
+        }
+        vst1q_s16(out + i, vcombine_s16(vmovn_s32(q[0]), vmovn_s32(q[1])));
+    }
+    ref_viterbi_quantize(in + i, n - i, scale, out + i);
+}
+
+}  // namespace
+
+const ViterbiKernels viterbi_neon = {forward_neon, quantize_neon};
+
+}  // namespace dcomm::kernels
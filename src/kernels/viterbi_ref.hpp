@@ -0,0 +1,77 @@
+#pragma once
+
+// Scalar reference ACS (see viterbi_kernels.hpp).
+//
+// The two polynomials both tap the newest and the oldest bit, so the four
+// branches of the butterfly on predecessors 2j / 2j+1 and successors
+// j / j+32 carry +-b_j, where b_j is the metric of predecessor 2j with input
+// 0. kBranchA/kBranchB hold the sign that b_j gives each LLR.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "dcomm/convcode.hpp"
+
+namespace dcomm::kernels {
+namespace {
+
+constexpr std::array<std::int16_t, 32> branch_signs(std::uint8_t poly) {
+    std::array<std::int16_t, 32> s{};
+    for (unsigned j = 0; j < 32; ++j) {
+        unsigned window = (2 * j) & poly;
+        unsigned parity = 0;
+        for (; window != 0; window >>= 1) {
+            parity ^= window & 1u;
+        }
+        s[j] = parity ? -1 : 1;
+    }
+    return s;
+}
+
+constexpr std::array<std::int16_t, 32> kBranchA = branch_signs(kConvPolyA);
+constexpr std::array<std::int16_t, 32> kBranchB = branch_signs(kConvPolyB);
+
+inline std::int16_t ref_sat16(int v) noexcept {
+    return std::int16_t(std::clamp(v, -32768, 32767));
+}
+
+inline void ref_viterbi_forward(const std::int16_t* llrs, std::size_t steps,
+                                std::int16_t* metrics, std::uint64_t* decisions) noexcept {
+    std::int16_t next[64];
+    for (std::size_t t = 0; t < steps; ++t) {
+        const int la = llrs[2 * t];
+        const int lb = llrs[2 * t + 1];
+        std::uint64_t d = 0;
+        for (unsigned j = 0; j < 32; ++j) {
+            const int b = ref_sat16(la * kBranchA[j] + lb * kBranchB[j]);
+            const int e = metrics[2 * j];
+            const int o = metrics[2 * j + 1];
+            const std::int16_t lo0 = ref_sat16(e + b);
+            const std::int16_t lo1 = ref_sat16(o - b);
+            const std::int16_t hi0 = ref_sat16(e - b);
+            const std::int16_t hi1 = ref_sat16(o + b);
+            next[j] = std::max(lo0, lo1);
+            next[j + 32] = std::max(hi0, hi1);
+            d |= std::uint64_t(lo1 > lo0) << j;
+            d |= std::uint64_t(hi1 > hi0) << (j + 32);
+        }
+        const int ref = next[0];
+        for (unsigned s = 0; s < 64; ++s) {
+            metrics[s] = ref_sat16(next[s] - ref);
+        }
+        decisions[t] = d;
+    }
+}
+
+inline void ref_viterbi_quantize(const float* in, std::size_t n, float scale,
+                                 std::int16_t* out) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        const float v = std::clamp(in[i] * scale, -127.0f, 127.0f);
+        out[i] = std::int16_t(v + (v < 0.0f ? -0.5f : 0.5f));
+    }
+}
+
+}  // namespace
+}  // namespace dcomm::kernels
@@ -0,0 +1,21 @@
+#include "viterbi_kernels.hpp"
+#include "viterbi_ref.hpp"
+
+namespace dcomm::kernels {
+
+namespace {
+
+void forward_scalar(const std::int16_t* llrs, std::size_t steps, std::int16_t* metrics,
+                    std::uint64_t* decisions) {
+    ref_viterbi_forward(llrs, steps, metrics, decisions);
+}
+
+void quantize_scalar(const float* in, std::size_t n, float scale, std::int16_t* out) {
+    ref_viterbi_quantize(in, n, scale, out);
+}
+
+}  // namespace
+
+const ViterbiKernels viterbi_scalar = {forward_scalar, quantize_scalar};
+
+}  // namespace dcomm::kernels
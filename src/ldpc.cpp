@@ -0,0 +1,394 @@
+#include "dcomm/ldpc.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+#include "dcomm/types.hpp"
+#include "kernels/ldpc_kernels.hpp"
+
+namespace dcomm {
+
+namespace {
+
+constexpr std::uint32_t kCoreSum = std::numeric_limits<std::uint32_t>::max();
+
+// IEEE 802.11-2012 Annex F, n = 648, R = 1/2, Z = 27.
+constexpr std::string_view kIeee80211_648_r12 = R"(
+12 24
+ 0  -  -  -  0  0  -  -  0  -  -  0  1  0  -  -  -  -  -  -  -  -  -  -
+22  0  -  - 17  -  0  0 12  -  -  -  -  0  0  -  -  -  -  -  -  -  -  -
+ 6  -  0  - 10  -  -  - 24  -  0  -  -  -  0  0  -  -  -  -  -  -  -  -
+ 2  -  -  0 20  -  -  - 25  0  -  -  -  -  -  0  0  -  -  -  -  -  -  -
+23  -  -  -  3  -  -  -  0  -  9 11  -  -  -  -  0  0  -  -  -  -  -  -
+24  - 23  1 17  -  3  - 10  -  -  -  -  -  -  -  -  0  0  -  -  -  -  -
+25  -  -  -  8  -  -  -  7 18  -  -  0  -  -  -  -  -  0  0  -  -  -  -
+13 24  -  -  0  -  8  -  6  -  -  -  -  -  -  -  -  -  -  0  0  -  -  -
+ 7 20  - 16 22 10  -  - 23  -  -  -  -  -  -  -  -  -  -  -  0  0  -  -
+11  -  -  - 19  -  -  - 13  -  3 17  -  -  -  -  -  -  -  -  -  0  0  -
+25  -  8  - 23 18  - 14  9  -  -  -  -  -  -  -  -  -  -  -  -  -  0  0
+ 3  -  -  - 16  -  -  2 25  5  -  -  1  -  -  -  -  -  -  -  -  -  -  0
+)";
+
+/// rot(x, s)[i] = x[(i + s) mod z], XORed into `acc`.
+void xor_rotated(std::uint8_t* acc, const std::uint8_t* x, std::size_t z,
+                 std::size_t s) noexcept {
+    for (std::size_t i = 0; i < z - s; ++i) {
+        acc[i] ^= x[i + s];
+    }
+    for (std::size_t i = z - s; i < z; ++i) {
+        acc[i] ^= x[i + s - z];
+    }
+}
+
+/// Inverse rotation: out[(i + s) mod z] = x[i].
+void unrotate(std::uint8_t* out, const std::uint8_t* x, std::size_t z,
+              std::size_t s) noexcept {
+    std::memcpy(out + s, x, z - s);
+    std::memcpy(out, x + z - s, s);
+}
+
+/// Copy n bytes rounded up to whole chunks; callers size buffers for it.
+constexpr std::size_t kChunk = 32;
+
+inline void copy_chunks(std::int8_t* dst, const std::int8_t* src, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; i += kChunk) {
+        std::memcpy(dst + i, src + i, kChunk);
+    }
+}
+
+const kernels::LdpcKernels& ldpc_kernels_for(Isa isa) {
+    if (!isa_available(isa)) {
+        throw std::invalid_argument("LdpcDecoder: ISA not available on this CPU");
+    }
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx2: return kernels::ldpc_avx2;
+    case Isa::avx512: return kernels::ldpc_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+    case Isa::neon: return kernels::ldpc_neon;
+#endif
+    default: return kernels::ldpc_scalar;
+    }
+}
+
+}  // namespace
+
+const LdpcBaseGraph& LdpcBaseGraph::ieee80211_648_r12() {
+    static const LdpcBaseGraph graph = parse("802.11 n=648 r=1/2", kIeee80211_648_r12);
+    return graph;
+}
+
+LdpcBaseGraph LdpcBaseGraph::parse(std::string name, std::string_view text) {
+    std::vector<long> values;
+    std::size_t i = 0;
+    while (i < text.size()) {
+        const char c = text[i];
+        if (c == '#') {
+            while (i < text.size() && text[i] != '\n') {
+                ++i;
+            }
+        } else if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',') {
+            ++i;
+        } else if (c == '-' && (i + 1 == text.size() || !std::isdigit(
+                                                            static_cast<unsigned char>(text[i + 1])))) {
+            values.push_back(-1);
+            ++i;
+        } else if (c == '-' || std::isdigit(static_cast<unsigned char>(c))) {
+            std::size_t j = i + 1;
+            while (j < text.size() && std::isdigit(static_cast<unsigned char>(text[j]))) {
+                ++j;
+            }
+            values.push_back(std::stol(std::string(text.substr(i, j - i))));
+            i = j;
+        } else {
+            throw std::invalid_argument("LdpcBaseGraph::parse: unexpected character");
+        }
+    }
+    if (values.size() < 2 || values[0] <= 0 || values[1] <= values[0]) {
+        throw std::invalid_argument("LdpcBaseGraph::parse: bad dimensions");
+    }
+    LdpcBaseGraph g;
+    g.name = std::move(name);
+    g.rows = std::size_t(values[0]);
+    g.cols = std::size_t(values[1]);
+    if (values.size() != 2 + g.rows * g.cols) {
+        throw std::invalid_argument("LdpcBaseGraph::parse: wrong number of shifts");
+    }
+    for (std::size_t k = 2; k < values.size(); ++k) {
+        if (values[k] < -1 || values[k] > std::numeric_limits<std::int16_t>::max()) {
+            throw std::invalid_argument("LdpcBaseGraph::parse: shift out of range");
+        }
+        g.shifts.push_back(std::int16_t(values[k]));
+    }
+    return g;
+}
+
+LdpcCode::LdpcCode(const LdpcBaseGraph& graph, std::size_t z)
+    : z_(z), rows_(graph.rows), cols_(graph.cols) {
+    if (z == 0 || rows_ == 0 || cols_ <= rows_ || graph.shifts.size() != rows_ * cols_) {
+        throw std::invalid_argument("LdpcCode: malformed base graph");
+    }
+    row_start_.push_back(0);
+    for (std::size_t r = 0; r < rows_; ++r) {
+        for (std::size_t c = 0; c < cols_; ++c) {
+            const std::int16_t v = graph.shift(r, c);
+            if (v >= 0) {
+                edges_.push_back({std::uint32_t(c), std::uint32_t(std::size_t(v) % z)});
+            }
+        }
+        row_start_.push_back(edges_.size());
+        max_degree_ = std::max(max_degree_, row_start_[r + 1] - row_start_[r]);
+    }
+    if (max_degree_ > 255) {
+        throw std::invalid_argument("LdpcCode: row degree above 255");
+    }
+
+    // Encoding schedule. Core rows are those without a degree-1 parity
+    // column; summing them cancels every core parity column but one.
+    const std::size_t kb = cols_ - rows_;
+    std::vector<std::size_t> weight(cols_, 0);
+    for (const Edge& e : edges_) {
+        ++weight[e.col];
+    }
+    std::vector<bool> core_row(rows_, true);
+    for (std::size_t r = 0; r < rows_; ++r) {
+        for (const Edge& e : row(r)) {
+            if (e.col >= kb && weight[e.col] == 1) {
+                core_row[r] = false;
+            }
+        }
+        if (core_row[r]) {
+            core_rows_.push_back(std::uint32_t(r));
+        }
+    }
+    std::map<std::uint32_t, std::map<std::uint32_t, unsigned>> residue;
+    for (std::uint32_t r : core_rows_) {
+        for (const Edge& e : row(r)) {
+            if (e.col >= kb) {
+                residue[e.col][e.shift] ^= 1u;
+            }
+        }
+    }
+    std::vector<bool> known(cols_, false);
+    std::fill(known.begin(), known.begin() + std::ptrdiff_t(kb), true);
+    for (const auto& [col, shifts] : residue) {
+        std::vector<std::uint32_t> odd;
+        for (const auto& [shift, count] : shifts) {
+            if (count != 0) {
+                odd.push_back(shift);
+            }
+        }
+        if (odd.empty()) {
+            continue;
+        }
+        if (odd.size() != 1 || !schedule_.empty()) {
+            throw std::invalid_argument("LdpcCode: unsupported parity structure");
+        }
+        schedule_.push_back({kCoreSum, col, odd[0]});
+        known[col] = true;
+    }
+    if (schedule_.empty()) {
+        throw std::invalid_argument("LdpcCode: unsupported parity structure");
+    }
+    for (bool progress = true; progress;) {
+        progress = false;
+        for (std::size_t r = 0; r < rows_; ++r) {
+            const Edge* unknown = nullptr;
+            std::size_t count = 0;
+            for (const Edge& e : row(r)) {
+                if (!known[e.col]) {
+                    unknown = &e;
+                    ++count;
+                }
+            }
+            if (count == 1) {
+                schedule_.push_back({std::uint32_t(r), unknown->col, unknown->shift});
+                known[unknown->col] = true;
+                progress = true;
+            }
+        }
+    }
+    if (std::find(known.begin(), known.end(), false) != known.end()) {
+        throw std::invalid_argument("LdpcCode: unsupported parity structure");
+    }
+}
+
+void LdpcCode::encode(std::span<const std::uint8_t> info,
+                      std::span<std::uint8_t> codeword) const {
+    assert(info.size() == k() && codeword.size() == n());
+    std::copy(info.begin(), info.end(), codeword.begin());
+    std::vector<std::uint8_t> acc(z_);
+    for (const Step& step : schedule_) {
+        std::fill(acc.begin(), acc.end(), std::uint8_t(0));
+        if (step.row == kCoreSum) {
+            for (std::uint32_t r : core_rows_) {
+                for (const Edge& e : row(r)) {
+                    if (e.col < cols_ - rows_) {
+                        xor_rotated(acc.data(), codeword.data() + e.col * z_, z_, e.shift);
+                    }
+                }
+            }
+        } else {
+            for (const Edge& e : row(step.row)) {
+                if (e.col != step.col) {
+                    xor_rotated(acc.data(), codeword.data() + e.col * z_, z_, e.shift);
+                }
+            }
+        }
+        unrotate(codeword.data() + step.col * z_, acc.data(), z_, step.shift);
+    }
+}
+
+bool LdpcCode::check(std::span<const std::uint8_t> codeword) const {
+    assert(codeword.size() == n());
+    std::vector<std::uint8_t> acc(z_);
+    for (std::size_t r = 0; r < rows_; ++r) {
+        std::fill(acc.begin(), acc.end(), std::uint8_t(0));
+        for (const Edge& e : row(r)) {
+            xor_rotated(acc.data(), codeword.data() + e.col * z_, z_, e.shift);
+        }
+        if (std::find(acc.begin(), acc.end(), std::uint8_t(1)) != acc.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+LdpcDecoder::LdpcDecoder(const LdpcCode& code, LdpcDecoderOptions options, Isa isa)
+    : code_(&code),
+      options_(options),
+      kernels_(&ldpc_kernels_for(isa)),
+      lanes_(align_up(code.z(), kernels::kLdpcLaneAlign)),
+      block_stride_(lanes_ + kChunk),
+      app_(make_aligned_array<std::int8_t>(code.cols() * block_stride_)),
+      check_(make_aligned_array<std::int8_t>(code.edge_count() * lanes_)),
+      rows_(make_aligned_array<std::int8_t>(code.max_row_degree() * 2 * lanes_)),
+      row_ptrs_(code.max_row_degree()) {
+    if (options.max_iterations == 0 || options.alpha_eighths == 0 ||
+        options.alpha_eighths > 8 || !(options.llr_scale > 0.0f)) {
+        throw std::invalid_argument("LdpcDecoder: invalid options");
+    }
+}
+
+LdpcDecoder::~LdpcDecoder() = default;
+LdpcDecoder::LdpcDecoder(LdpcDecoder&&) noexcept = default;
+LdpcDecoder& LdpcDecoder::operator=(LdpcDecoder&&) noexcept = default;
+
+LdpcResult LdpcDecoder::decode(std::span<const float> llrs, std::span<std::uint8_t> info) {
+    assert(llrs.size() == code_->n());
+    // Quantise in one contiguous run, then spread the blocks out to their
+    // padded pitch from the back.
+    const std::size_t z = code_->z();
+    kernels_->quantize(llrs.data(), llrs.size(), options_.llr_scale, app_.get());
+    for (std::size_t j = code_->cols(); j-- > 1;) {
+        std::memmove(app_.get() + j * block_stride_, app_.get() + j * z, z);
+    }
+    return run(info);
+}
+
+LdpcResult LdpcDecoder::decode(std::span<const std::int8_t> llrs,
+                               std::span<std::uint8_t> info) {
+    assert(llrs.size() == code_->n());
+    const std::size_t z = code_->z();
+    for (std::size_t j = 0; j < code_->cols(); ++j) {
+        const std::int8_t* in = llrs.data() + j * z;
+        std::int8_t* out = app_.get() + j * block_stride_;
+        for (std::size_t i = 0; i < z; ++i) {
+            out[i] = std::max(in[i], std::int8_t(-127));
+        }
+    }
+    return run(info);
+}
+
+void LdpcDecoder::gather(std::span<const LdpcCode::Edge> edges) noexcept {
+    // Each row buffer receives its block twice in a row, so the rotated
+    // view is simply buffer + shift.
+    const std::size_t z = code_->z();
+    for (std::size_t k = 0; k < edges.size(); ++k) {
+        std::int8_t* buf = rows_.get() + k * 2 * lanes_;
+        const std::int8_t* blk = app_.get() + edges[k].col * block_stride_;
+        copy_chunks(buf, blk, z);
+        copy_chunks(buf + z, blk, z);
+        row_ptrs_[k] = buf + edges[k].shift;
+    }
+}
+
+void LdpcDecoder::scatter(std::span<const LdpcCode::Edge> edges) noexcept {
+    // Undo the rotation. Both copies may overrun by up to one chunk: the
+    // first into the range the second rewrites, the second into the block
+    // padding.
+    const std::size_t z = code_->z();
+    for (std::size_t k = 0; k < edges.size(); ++k) {
+        const std::int8_t* buf = rows_.get() + k * 2 * lanes_;
+        std::int8_t* blk = app_.get() + edges[k].col * block_stride_;
+        const std::size_t s = edges[k].shift;
+        copy_chunks(blk, buf + z, s);
+        copy_chunks(blk + s, buf + s, z - s);
+    }
+}
+
+LdpcResult LdpcDecoder::run(std::span<std::uint8_t> info) {
+    assert(info.size() == code_->k());
+    const std::size_t z = code_->z();
+    std::fill_n(check_.get(), code_->edge_count() * lanes_, std::int8_t(0));
+    LdpcResult result;
+    for (unsigned it = 1; it <= options_.max_iterations; ++it) {
+        bool satisfied = true;
+        for (std::size_t r = 0; r < code_->rows(); ++r) {
+            const auto edges = code_->row(r);
+            gather(edges);
+            satisfied &= kernels_->layer(row_ptrs_.data(),
+                                         check_.get() + code_->edge_offset(r) * lanes_,
+                                         edges.size(), lanes_, z, options_.alpha_eighths);
+            scatter(edges);
+        }
+        result.iterations = it;
+        if (satisfied && syndrome_ok()) {
+            result.converged = true;
+            break;
+        }
+    }
+    for (std::size_t j = 0; j < code_->cols() - code_->rows(); ++j) {
+        kernels_->hard_decisions(app_.get() + j * block_stride_, z, info.data() + j * z);
+    }
+    return result;
+}
+
+bool LdpcDecoder::syndrome_ok() noexcept {
+    for (std::size_t r = 0; r < code_->rows(); ++r) {
+        const auto edges = code_->row(r);
+        gather(edges);
+        if (!kernels_->parity(row_ptrs_.data(), edges.size(), lanes_, code_->z())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+LdpcBatchDecoder::LdpcBatchDecoder(const LdpcCode& code, WorkStealingPool& pool,
+                                   LdpcDecoderOptions options)
+    : code_(&code), pool_(&pool) {
+    decoders_.reserve(pool.size());
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        decoders_.emplace_back(code, options);
+    }
+}
+
+void LdpcBatchDecoder::decode(std::span<const float> llrs, std::span<std::uint8_t> info,
+                              std::span<LdpcResult> results) {
+    const std::size_t n = code_->n();
+    const std::size_t k = code_->k();
+    assert(llrs.size() == results.size() * n && info.size() == results.size() * k);
+    pool_->run(results.size(), [&](std::size_t i, std::size_t worker) {
+        results[i] = decoders_[worker].decode(llrs.subspan(i * n, n), info.subspan(i * k, k));
+    });
+}
+
+}  // namespace dcomm
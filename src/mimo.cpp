@@ -0,0 +1,236 @@
+#include "dcomm/mimo.hpp"
+
+#include <cassert>
+#include <stdexcept>
+
+#include "kernels/mimo_kernels.hpp"
+
+namespace dcomm {
+
+namespace {
+
+const kernels::MimoKernels& mimo_kernels_for(Isa isa) noexcept {
+    assert(isa_available(isa));
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx2: return kernels::mimo_avx2;
+    case Isa::avx512: return kernels::mimo_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+    case Isa::neon: return kernels::mimo_neon;
+#endif
+    default: return kernels::mimo_scalar;
+    }
+}
+
+// 802.11n equation 20-27; rows are streams, columns LTF symbols.
+constexpr float kHtLtfCover[4][4] = {
+    {1, -1, 1, 1},
+    {1, 1, -1, 1},
+    {1, 1, 1, -1},
+    {-1, 1, 1, 1},
+};
+
+constexpr std::size_t kMaxRx = 8;
+
+/// Keep `m` if it already has the shape, so steady-state calls allocate
+/// nothing.
+void reshape(SubcarrierMatrix& m, std::size_t rows, std::size_t cols, std::size_t subcarriers) {
+    if (m.rows() != rows || m.cols() != cols || m.subcarriers() != subcarriers) {
+        m = SubcarrierMatrix(rows, cols, subcarriers);
+    }
+}
+
+}  // namespace
+
+// --- SubcarrierMatrix ----------------------------------------------------
+
+SubcarrierMatrix::SubcarrierMatrix(std::size_t rows, std::size_t cols, std::size_t subcarriers)
+    : rows_(rows), cols_(cols), subcarriers_(subcarriers),
+      stride_(align_up(subcarriers, kCacheLine / sizeof(float))),
+      data_(make_aligned_array<float>(2 * rows * cols * stride_)) {}
+
+void SubcarrierMatrix::load(std::size_t i, std::size_t j, const cf32* bins,
+                            std::span<const std::uint16_t> index) noexcept {
+    assert(index.size() == subcarriers_);
+    float* r = re(i, j);
+    float* m = im(i, j);
+    for (std::size_t k = 0; k < subcarriers_; ++k) {
+        const cf32 v = bins[index[k]];
+        r[k] = v.real();
+        m[k] = v.imag();
+    }
+}
+
+void SubcarrierMatrix::store(std::size_t i, std::size_t j, cf32* out) const noexcept {
+    const float* r = re(i, j);
+    const float* m = im(i, j);
+    for (std::size_t k = 0; k < subcarriers_; ++k) {
+        out[k] = {r[k], m[k]};
+    }
+}
+
+// --- LTF channel estimate ------------------------------------------------
+
+std::size_t ht_ltf_symbols(std::size_t streams) noexcept {
+    switch (streams) {
+    case 1: return 1;
+    case 2: return 2;
+    case 3:
+    case 4: return 4;
+    default: return 0;
+    }
+}
+
+float ht_ltf_cover(std::size_t stream, std::size_t symbol) noexcept {
+    assert(stream < 4 && symbol < 4);
+    return kHtLtfCover[stream][symbol];
+}
+
+LtfChannelEstimator::LtfChannelEstimator(std::size_t rx, std::size_t tx,
+                                         std::span<const std::uint16_t> bins,
+                                         std::span<const float> reference)
+    : rx_(rx), tx_(tx), ltf_symbols_(ht_ltf_symbols(tx)), bins_(bins.begin(), bins.end()) {
+    if (ltf_symbols_ == 0) {
+        throw std::invalid_argument("LtfChannelEstimator: 1..4 streams supported");
+    }
+    if (rx == 0 || rx > kMaxRx) {
+        throw std::invalid_argument("LtfChannelEstimator: 1..8 receive antennas supported");
+    }
+    if (bins.empty() || reference.size() != bins.size()) {
+        throw std::invalid_argument("LtfChannelEstimator: one reference value per bin required");
+    }
+    inverse_.reserve(reference.size());
+    for (float v : reference) {
+        if (v == 0.0f) {
+            throw std::invalid_argument("LtfChannelEstimator: zero reference value");
+        }
+        inverse_.push_back(1.0f / v);
+    }
+}
+
+void LtfChannelEstimator::estimate(std::span<const cf32* const> symbols,
+                                   SubcarrierMatrix& h) const {
+    if (symbols.size() != ltf_symbols_ * rx_) {
+        throw std::invalid_argument("LtfChannelEstimator: expected N_LTF * rx symbols");
+    }
+    const std::size_t n = bins_.size();
+    reshape(h, rx_, tx_, n);
+    const float scale = 1.0f / float(ltf_symbols_);
+    for (std::size_t r = 0; r < rx_; ++r) {
+        for (std::size_t t = 0; t < tx_; ++t) {
+            float* hr = h.re(r, t);
+            float* hi = h.im(r, t);
+            for (std::size_t k = 0; k < n; ++k) {
+                hr[k] = 0.0f;
+                hi[k] = 0.0f;
+            }
+            for (std::size_t s = 0; s < ltf_symbols_; ++s) {
+                const float* y = reinterpret_cast<const float*>(symbols[s * rx_ + r]);
+                const float c = kHtLtfCover[t][s];
+                for (std::size_t k = 0; k < n; ++k) {
+                    const std::size_t b = 2 * std::size_t(bins_[k]);
+                    hr[k] += c * y[b];
+                    hi[k] += c * y[b + 1];
+                }
+            }
+            for (std::size_t k = 0; k < n; ++k) {
+                const float g = scale * inverse_[k];
+                hr[k] *= g;
+                hi[k] *= g;
+            }
+        }
+    }
+}
+
+// --- SubcarrierInterpolator ----------------------------------------------
+
+SubcarrierInterpolator::SubcarrierInterpolator(std::span<const int> from,
+                                               std::span<const int> to)
+    : from_size_(from.size()) {
+    if (from.size() < 2) {
+        throw std::invalid_argument("SubcarrierInterpolator: at least two source subcarriers");
+    }
+    for (std::size_t j = 1; j < from.size(); ++j) {
+        if (from[j] <= from[j - 1]) {
+            throw std::invalid_argument("SubcarrierInterpolator: sources must increase");
+        }
+    }
+    left_.reserve(to.size());
+    weight_.reserve(to.size());
+    for (int sc : to) {
+        std::size_t j = 0;  // segment [from j, from j + 1], edges extrapolate
+        while (j + 2 < from.size() && sc > from[j + 1]) {
+            ++j;
+        }
+        left_.push_back(std::uint32_t(j));
+        weight_.push_back(float(double(sc - from[j]) / double(from[j + 1] - from[j])));
+    }
+}
+
+void SubcarrierInterpolator::apply(const SubcarrierMatrix& in, SubcarrierMatrix& out) const {
+    if (in.subcarriers() != from_size_) {
+        throw std::invalid_argument("SubcarrierInterpolator: input subcarrier count mismatch");
+    }
+    reshape(out, in.rows(), in.cols(), left_.size());
+    for (std::size_t i = 0; i < in.rows(); ++i) {
+        for (std::size_t j = 0; j < in.cols(); ++j) {
+            for (const bool imag : {false, true}) {
+                const float* a = imag ? in.im(i, j) : in.re(i, j);
+                float* o = imag ? out.im(i, j) : out.re(i, j);
+                for (std::size_t k = 0; k < left_.size(); ++k) {
+                    const float w = weight_[k];
+                    o[k] = a[left_[k]] * (1.0f - w) + a[left_[k] + 1] * w;
+                }
+            }
+        }
+    }
+}
+
+// --- MimoEqualizer -------------------------------------------------------
+
+const char* to_string(MimoDetector d) noexcept {
+    switch (d) {
+    case MimoDetector::zf: return "zf";
+    case MimoDetector::mmse: return "mmse";
+    }
+    return "unknown";
+}
+
+MimoEqualizer::MimoEqualizer(std::size_t rx, std::size_t streams, MimoDetector detector)
+    : MimoEqualizer(rx, streams, detector, active_isa()) {}
+
+MimoEqualizer::MimoEqualizer(std::size_t rx, std::size_t streams, MimoDetector detector,
+                             Isa isa)
+    : kernels_(&mimo_kernels_for(isa)), rx_(rx), streams_(streams), detector_(detector) {
+    if (streams != 2 && streams != 4) {
+        throw std::invalid_argument("MimoEqualizer: 2 or 4 streams supported");
+    }
+    if (rx < streams || rx > kMaxRx) {
+        throw std::invalid_argument("MimoEqualizer: need streams <= rx <= 8");
+    }
+}
+
+void MimoEqualizer::prepare(const SubcarrierMatrix& h, float noise_variance) {
+    if (h.rows() != rx_ || h.cols() != streams_) {
+        throw std::invalid_argument("MimoEqualizer: channel must be rx x streams");
+    }
+    const std::size_t n = h.subcarriers();
+    if (weights_.subcarriers() != n || weights_.data() == nullptr) {
+        weights_ = SubcarrierMatrix(streams_, rx_, n);
+        noise_ = make_aligned_array<float>(streams_ * weights_.stride());
+    }
+    kernels_->weights(h.data(), h.stride(), rx_, streams_, n, noise_variance,
+                      detector_ == MimoDetector::mmse, weights_.data(), noise_.get());
+}
+
+void MimoEqualizer::apply(const SubcarrierMatrix& y, SubcarrierMatrix& x) const {
+    const std::size_t n = weights_.subcarriers();
+    if (y.rows() != rx_ || y.cols() != 1 || y.subcarriers() != n) {
+        throw std::invalid_argument("MimoEqualizer: input must be rx x 1 over the prepared band");
+    }
+    reshape(x, streams_, 1, n);
+    kernels_->apply(weights_.data(), weights_.stride(), rx_, streams_, y.data(), n, x.data());
+}
+
+}  // namespace dcomm
@@ -0,0 +1,297 @@
+#include "dcomm/modulation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <initializer_list>
+
+#include "kernels/modulation_kernels.hpp"
+
+namespace dcomm {
+
+namespace {
+
+constexpr std::size_t kModulations = 5;
+
+/// Scaled PAM amplitude of every axis code, per modulation.
+struct LevelTables {
+    std::array<std::array<float, 16>, kModulations> levels{};
+
+    LevelTables() {
+        for (Modulation m : {Modulation::bpsk, Modulation::qpsk, Modulation::qam16,
+                             Modulation::qam64, Modulation::qam256}) {
+            const unsigned bits = m == Modulation::bpsk ? 1 : bits_per_symbol(m) / 2;
+            const unsigned count = 1u << bits;
+            const float scale = modulation_scale(m);
+            for (unsigned code = 0; code < count; ++code) {
+                unsigned idx = code;  // Gray to binary
+                for (unsigned shift = 1; shift < bits; shift <<= 1) {
+                    idx ^= idx >> shift;
+                }
+                levels[std::size_t(m)][code] =
+                    float(2 * int(idx) - int(count - 1)) * scale;
+            }
+        }
+    }
+};
+
+const LevelTables g_levels;
+
+/// The level tables rounded to a fixed-point sample type, with a flag for
+/// every level that had to be clipped.
+template <FixedSample T>
+struct FixedLevelTables {
+    using C = typename SampleTraits<T>::component;
+    std::array<std::array<C, 16>, kModulations> levels{};
+    std::array<std::array<std::uint8_t, 16>, kModulations> clipped{};
+
+    FixedLevelTables() {
+        for (std::size_t m = 0; m < kModulations; ++m) {
+            for (std::size_t code = 0; code < 16; ++code) {
+                std::uint64_t sat = 0;
+                levels[m][code] = saturate<T>(
+                    std::int32_t(std::lround(g_levels.levels[m][code] * SampleTraits<T>::unit)),
+                    sat);
+                clipped[m][code] = std::uint8_t(sat);
+            }
+        }
+    }
+};
+
+template <FixedSample T>
+void map_bits_fixed(Modulation m, std::span<const std::uint8_t> bits, std::span<T> symbols,
+                    SaturationStats& stats) noexcept {
+    static const FixedLevelTables<T> tables;
+    using C = typename SampleTraits<T>::component;
+    assert(bits.size() == symbols.size() * bits_per_symbol(m));
+    const C* levels = tables.levels[std::size_t(m)].data();
+    const std::uint8_t* clipped = tables.clipped[std::size_t(m)].data();
+    std::uint64_t saturated = 0;
+    if (m == Modulation::bpsk) {
+        for (std::size_t i = 0; i < symbols.size(); ++i) {
+            const unsigned c = bits[i] & 1u;
+            symbols[i] = {levels[c], 0};
+            saturated += clipped[c];
+        }
+    } else {
+        const unsigned axis = bits_per_symbol(m) / 2;
+        const std::uint8_t* b = bits.data();
+        for (std::size_t i = 0; i < symbols.size(); ++i, b += 2 * axis) {
+            unsigned ci = 0;
+            unsigned cq = 0;
+            for (unsigned k = 0; k < axis; ++k) {
+                ci = (ci << 1) | (b[k] & 1u);
+                cq = (cq << 1) | (b[axis + k] & 1u);
+            }
+            symbols[i] = {levels[ci], levels[cq]};
+            saturated += clipped[ci] + clipped[cq];
+        }
+    }
+    stats.values += 2 * symbols.size();
+    stats.saturated += saturated;
+}
+
+/// Symbols per unpack_indices() call of the packed mappers; a multiple of
+/// 64 keeps every run word-aligned.
+constexpr std::size_t kCodeRun = 64;
+
+/// Split packed bits into axis codes a run at a time: codes[2i] and
+/// codes[2i + 1] are the I and Q codes of symbol i (BPSK: codes[i], I only).
+/// Calls emit(first_symbol, symbols, codes) per run.
+template <class Emit>
+void for_each_code_run(Modulation m, ConstBitSpan bits, std::size_t n_symbols,
+                       Emit emit) noexcept {
+    const unsigned bps = bits_per_symbol(m);
+    const unsigned width = m == Modulation::bpsk ? 1 : bps / 2;
+    assert(bits.size() == n_symbols * bps);
+    std::uint8_t codes[2 * kCodeRun];
+    for (std::size_t s = 0; s < n_symbols; s += kCodeRun) {
+        const std::size_t n = std::min(kCodeRun, n_symbols - s);
+        unpack_indices(bits.subspan(s * bps, n * bps), width, std::span(codes, n * bps / width));
+        emit(s, n, codes);
+    }
+}
+
+template <FixedSample T>
+void map_packed_fixed(Modulation m, ConstBitSpan bits, std::span<T> symbols,
+                      SaturationStats& stats) noexcept {
+    static const FixedLevelTables<T> tables;
+    const auto* levels = tables.levels[std::size_t(m)].data();
+    const std::uint8_t* clipped = tables.clipped[std::size_t(m)].data();
+    std::uint64_t saturated = 0;
+    for_each_code_run(m, bits, symbols.size(),
+                      [&](std::size_t s, std::size_t n, const std::uint8_t* codes) {
+        if (m == Modulation::bpsk) {
+            for (std::size_t i = 0; i < n; ++i) {
+                symbols[s + i] = {levels[codes[i]], 0};
+                saturated += clipped[codes[i]];
+            }
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                symbols[s + i] = {levels[codes[2 * i]], levels[codes[2 * i + 1]]};
+                saturated += clipped[codes[2 * i]] + clipped[codes[2 * i + 1]];
+            }
+        }
+    });
+    stats.values += 2 * symbols.size();
+    stats.saturated += saturated;
+}
+
+const kernels::ModulationKernels& kernels_for(Isa isa) noexcept {
+    assert(isa_available(isa));
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx2: return kernels::modulation_avx2;
+    case Isa::avx512: return kernels::modulation_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+    case Isa::neon: return kernels::modulation_neon;
+#endif
+    default: return kernels::modulation_scalar;
+    }
+}
+
+}  // namespace
+
+float modulation_scale(Modulation m) noexcept {
+    switch (m) {
+    case Modulation::bpsk: return 1.0f;
+    case Modulation::qpsk: return float(1.0 / std::sqrt(2.0));
+    case Modulation::qam16: return float(1.0 / std::sqrt(10.0));
+    case Modulation::qam64: return float(1.0 / std::sqrt(42.0));
+    case Modulation::qam256: return float(1.0 / std::sqrt(170.0));
+    }
+    return 0.0f;
+}
+
+void map_bits(Isa isa, Modulation m, std::span<const std::uint8_t> bits,
+              std::span<cf32> symbols) noexcept {
+    assert(bits.size() == symbols.size() * bits_per_symbol(m));
+    kernels_for(isa).map(m, g_levels.levels[std::size_t(m)].data(), bits.data(),
+                         symbols.size(), reinterpret_cast<float*>(symbols.data()));
+}
+
+void demap_maxlog(Isa isa, Modulation m, std::span<const cf32> symbols,
+                  float noise_variance, std::span<float> llrs) noexcept {
+    assert(llrs.size() == symbols.size() * bits_per_symbol(m));
+    const float scale = modulation_scale(m);
+    kernels_for(isa).demap(m, reinterpret_cast<const float*>(symbols.data()),
+                           symbols.size(), 1.0f / scale,
+                           scale * scale / noise_variance, llrs.data());
+}
+
+void map_bits(Modulation m, std::span<const std::uint8_t> bits,
+              std::span<cf32> symbols) noexcept {
+    static const kernels::ModulationKernels& k = kernels_for(active_isa());
+    k.map(m, g_levels.levels[std::size_t(m)].data(), bits.data(), symbols.size(),
+          reinterpret_cast<float*>(symbols.data()));
+}
+
+void map_bits(Modulation m, ConstBitSpan bits, std::span<cf32> symbols) noexcept {
+    static const kernels::ModulationKernels& k = kernels_for(active_isa());
+    const unsigned bps = bits_per_symbol(m);
+    assert(bits.size() == symbols.size() * bps);
+    // The float kernels take unpacked bits and are faster than a table
+    // lookup per axis code, so runs are unpacked in front of them.
+    constexpr std::size_t kRun = 8 * kCodeRun;
+    std::uint8_t unpacked[kRun * 8];
+    for (std::size_t s = 0; s < symbols.size(); s += kRun) {
+        const std::size_t n = std::min(kRun, symbols.size() - s);
+        unpack_bits(bits.subspan(s * bps, n * bps), std::span(unpacked, n * bps));
+        k.map(m, g_levels.levels[std::size_t(m)].data(), unpacked, n,
+              reinterpret_cast<float*>(symbols.data() + s));
+    }
+}
+
+void demap_maxlog(Modulation m, std::span<const cf32> symbols,
+                  float noise_variance, std::span<float> llrs) noexcept {
+    static const kernels::ModulationKernels& k = kernels_for(active_isa());
+    const float scale = modulation_scale(m);
+    k.demap(m, reinterpret_cast<const float*>(symbols.data()), symbols.size(),
+            1.0f / scale, scale * scale / noise_variance, llrs.data());
+}
+
+void map_bits(Modulation m, std::span<const std::uint8_t> bits, std::span<ci16> symbols,
+              SaturationStats& stats) noexcept {
+    map_bits_fixed(m, bits, symbols, stats);
+}
+
+void map_bits(Modulation m, std::span<const std::uint8_t> bits, std::span<ci8> symbols,
+              SaturationStats& stats) noexcept {
+    map_bits_fixed(m, bits, symbols, stats);
+}
+
+void map_bits(Modulation m, ConstBitSpan bits, std::span<ci16> symbols,
+              SaturationStats& stats) noexcept {
+    map_packed_fixed(m, bits, symbols, stats);
+}
+
+void map_bits(Modulation m, ConstBitSpan bits, std::span<ci8> symbols,
+              SaturationStats& stats) noexcept {
+    map_packed_fixed(m, bits, symbols, stats);
+}
+
+template <SampleType T>
+BasicMapperStage<T>::BasicMapperStage(Modulation m, std::size_t symbols,
+                                      std::size_t pool_depth)
+    : modulation_(m), symbols_(symbols), pool_(pool_depth, symbols) {}
+
+template <SampleType T>
+BufferView<T> BasicMapperStage<T>::process(BufferView<std::uint64_t> in) {
+    if (!in) {
+        return {};
+    }
+    BufferView<T> out = pool_.acquire();
+    if (!out) {
+        return {};
+    }
+    const ConstBitSpan bits(in.span(), symbols_ * bits_per_symbol(modulation_));
+    if constexpr (SampleTraits<T>::fixed_point) {
+        map_bits(modulation_, bits, out.span(), saturation_);
+    } else {
+        map_bits(modulation_, bits, out.span());
+    }
+    return out;
+}
+
+template <SampleType T>
+BasicDemapperStage<T>::BasicDemapperStage(Modulation m, float noise_variance,
+                                          std::size_t max_symbols, std::size_t pool_depth,
+                                          FrameArena& arena)
+    : modulation_(m), noise_variance_(noise_variance),
+      pool_(pool_depth, max_symbols * bits_per_symbol(m)), arena_(arena) {}
+
+template <SampleType T>
+std::size_t BasicDemapperStage<T>::scratch_bytes(std::size_t max_symbols) noexcept {
+    return SampleTraits<T>::fixed_point ? align_up(max_symbols * sizeof(cf32), kCacheLine) : 0;
+}
+
+template <SampleType T>
+BufferView<float> BasicDemapperStage<T>::process(BufferView<T> in) {
+    if (!in) {
+        return {};
+    }
+    BufferView<float> out = pool_.acquire();
+    if (!out) {
+        return {};
+    }
+    out.resize(in.size() * bits_per_symbol(modulation_));
+    if constexpr (SampleTraits<T>::fixed_point) {
+        const std::span<cf32> symbols = arena_.allocate<cf32>(in.size());
+        dequantize<T>(in.span(), symbols);
+        demap_maxlog(modulation_, symbols, noise_variance_, out.span());
+    } else {
+        demap_maxlog(modulation_, in.span(), noise_variance_, out.span());
+    }
+    return out;
+}
+
+template class BasicMapperStage<cf32>;
+template class BasicMapperStage<ci16>;
+template class BasicMapperStage<ci8>;
+template class BasicDemapperStage<cf32>;
+template class BasicDemapperStage<ci16>;
+template class BasicDemapperStage<ci8>;
+
+}  // namespace dcomm
@@ -0,0 +1,213 @@
+#include "dcomm/montecarlo.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "dcomm/channel.hpp"
+#include "dcomm/philox.hpp"
+#include "dcomm/pipeline.hpp"
+#include "dcomm/thread_pool.hpp"
+
+namespace dcomm {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Batches issued per worker and round: enough to balance uneven batches,
+/// few enough that little work is thrown away past the stopping batch.
+constexpr std::size_t kBatchesPerWorker = 4;
+
+struct Counts {
+    std::uint64_t blocks = 0;
+    std::uint64_t bits = 0;
+    std::uint64_t bit_errors = 0;
+    std::uint64_t block_errors = 0;
+};
+
+/// One worker's chain pair and channel, configured for the current point.
+struct Trial {
+    Trial(const PhyConfig& phy, const SweepConfig& config)
+        : tx(phy), rx(phy), noise(config.seed, 0) {
+        if (config.fading) {
+            fading.emplace(*config.fading, config.seed, 0);
+        }
+    }
+    TxChain tx;
+    RxChain rx;
+    GaussianNoise noise;
+    std::optional<FadingChannel> fading;
+};
+
+/// What a Philox stream is used for; keeps the streams of one block apart.
+enum class Draw : std::uint64_t { data = 0, noise = 1, fading = 2 };
+
+/// Philox stream of block `block` of point `point`: independent of which
+/// worker runs it and in which order.
+std::uint64_t stream_of(Draw draw, std::size_t point, std::uint64_t block) noexcept {
+    return std::uint64_t(draw) << 62 | std::uint64_t(point) << 40 | block;
+}
+
+/// Time-domain noise variance per complex sample for Es/N0 `snr_db` on
+/// the data subcarriers. The modulator spreads its unit output power over
+/// the 52 used of 64 bins, and the demodulator's gain maps time-domain
+/// noise of variance v to 52/64 v per subcarrier.
+double sample_noise_variance(double snr_db) noexcept {
+    constexpr double used = double(PhyConfig::data_subcarriers + PhyConfig::pilot_subcarriers);
+    return std::pow(10.0, -snr_db / 10.0) * double(PhyConfig::fft_size) / used;
+}
+
+Counts run_batch(Trial& trial, const SweepConfig& config, std::size_t point,
+                 std::uint64_t first, std::uint64_t count, float noise_variance) {
+    Counts c;
+    for (std::uint64_t block = first; block < first + count; ++block) {
+        Philox4x32 rng(config.seed, stream_of(Draw::data, point, block));
+        trial.tx.reset();
+        trial.rx.reset();
+        trial.noise.seek(stream_of(Draw::noise, point, block));
+        if (trial.fading) {
+            trial.fading->reset(stream_of(Draw::fading, point, block));
+        }
+
+        // One draw per 32 data bits, the first in the low half of the word.
+        const std::size_t n_bits = trial.tx.config().info_bits_per_block();
+        BufferView<std::uint64_t> data = trial.tx.acquire_input();
+        for (std::size_t w = 0; w < data.size(); ++w) {
+            const std::uint64_t lo = rng();
+            data[w] = 64 * w + 32 < n_bits ? lo | std::uint64_t(rng()) << 32 : lo;
+        }
+        // Keep a reference for comparison; the scrambler works out of place.
+        BufferView<std::uint64_t> sent = data;
+        BufferView<cf32> samples = trial.tx.process(std::move(data));
+        BufferView<cf32> noisy = trial.rx.acquire_input();
+        // Every view is released before the next block, so the pools
+        // never run dry.
+        assert(samples && noisy);
+
+        if (trial.fading) {
+            trial.fading->process(samples.span(), noisy.span());
+            trial.noise.add(noisy.span(), noise_variance);
+        } else {
+            trial.noise.add(samples.span(), noisy.span(), noise_variance);
+        }
+        samples.reset();
+
+        BufferView<std::uint64_t> received = trial.rx.process(std::move(noisy));
+        assert(received);
+        const std::uint64_t errors = count_bit_errors(ConstBitSpan(sent.span(), n_bits),
+                                                      ConstBitSpan(received.span(), n_bits));
+        ++c.blocks;
+        c.bits += n_bits;
+        c.bit_errors += errors;
+        c.block_errors += errors != 0;
+    }
+    return c;
+}
+
+bool targets_met(const SweepConfig& config, const SweepPoint& p) noexcept {
+    if (p.blocks >= config.max_blocks) {
+        return true;
+    }
+    if (config.target_block_errors == 0 && config.target_bit_errors == 0) {
+        return false;
+    }
+    return p.block_errors >= config.target_block_errors &&
+           p.bit_errors >= config.target_bit_errors;
+}
+
+}  // namespace
+
+MonteCarloSweep::MonteCarloSweep(SweepConfig config) : config_(std::move(config)) {
+    config_.phy.validate();
+    if (config_.snr_db.empty()) {
+        throw std::invalid_argument("MonteCarloSweep: no SNR points");
+    }
+    if (config_.batch_blocks == 0 || config_.max_blocks == 0) {
+        throw std::invalid_argument("MonteCarloSweep: batch and block limits must be > 0");
+    }
+    for (double snr : config_.snr_db) {
+        if (!std::isfinite(snr)) {
+            throw std::invalid_argument("MonteCarloSweep: SNR must be finite");
+        }
+    }
+}
+
+std::vector<SweepPoint> MonteCarloSweep::run(const PointHandler& on_point) {
+    WorkStealingPool pool(config_.workers);
+    const std::size_t round = pool.size() * kBatchesPerWorker;
+    const double info_per_symbol = double(config_.phy.info_bits_per_block()) /
+                                   double(config_.phy.constellation_symbols_per_block());
+
+    std::vector<SweepPoint> points;
+    std::vector<std::unique_ptr<Trial>> trials(pool.size());
+    std::vector<Counts> results(round);
+    for (std::size_t p = 0; p < config_.snr_db.size(); ++p) {
+        const auto t0 = Clock::now();
+        SweepPoint point;
+        point.snr_db = config_.snr_db[p];
+        point.ebn0_db = point.snr_db - 10.0 * std::log10(info_per_symbol);
+
+        PhyConfig phy = config_.phy;
+        phy.noise_variance = float(std::pow(10.0, -point.snr_db / 10.0));
+        for (auto& t : trials) {
+            t = std::make_unique<Trial>(phy, config_);
+        }
+        const float variance = float(sample_noise_variance(point.snr_db));
+
+        std::uint64_t next_batch = 0;
+        while (!targets_met(config_, point)) {
+            const std::uint64_t first_batch = next_batch;
+            pool.run(round, [&](std::size_t i, std::size_t worker) {
+                const std::uint64_t first = (first_batch + i) * config_.batch_blocks;
+                const std::uint64_t count =
+                    first < config_.max_blocks
+                        ? std::min<std::uint64_t>(config_.batch_blocks, config_.max_blocks - first)
+                        : 0;
+                results[i] = run_batch(*trials[worker], config_, p, first, count, variance);
+            });
+            next_batch += round;
+            // Fold in block order and stop at the first batch meeting the
+            // targets, so the outcome does not depend on the round size.
+            for (const Counts& c : results) {
+                if (targets_met(config_, point)) {
+                    break;
+                }
+                point.blocks += c.blocks;
+                point.bits += c.bits;
+                point.bit_errors += c.bit_errors;
+                point.block_errors += c.block_errors;
+            }
+        }
+        point.seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+        points.push_back(point);
+        if (on_point) {
+            on_point(point);
+        }
+        if (config_.stop_when_error_free && point.block_errors == 0) {
+            break;
+        }
+    }
+    return points;
+}
+
+void write_csv_header(std::FILE* out) {
+    std::fprintf(out, "snr_db,ebn0_db,blocks,bits,bit_errors,block_errors,ber,bler,seconds\n");
+    std::fflush(out);
+}
+
+void write_csv_row(std::FILE* out, const SweepPoint& p) {
+    std::fprintf(out, "%.3f,%.3f,%llu,%llu,%llu,%llu,%.6e,%.6e,%.3f\n", p.snr_db, p.ebn0_db,
+                 static_cast<unsigned long long>(p.blocks),
+                 static_cast<unsigned long long>(p.bits),
+                 static_cast<unsigned long long>(p.bit_errors),
+                 static_cast<unsigned long long>(p.block_errors), p.ber(), p.bler(), p.seconds);
+    std::fflush(out);
+}
+
+}  // namespace dcomm
@@ -0,0 +1,207 @@
+#include "dcomm/ofdm.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dcomm {
+
+namespace {
+
+constexpr std::size_t kN = PhyConfig::fft_size;
+constexpr std::size_t kCp = PhyConfig::cp_length;
+constexpr std::size_t kSymbolLen = kN + kCp;
+constexpr std::size_t kUsed =
+    PhyConfig::data_subcarriers + PhyConfig::pilot_subcarriers;
+
+constexpr OfdmLayout kIeee80211Layout{tables::kDataBins, tables::kPilotBins};
+
+// Tx IFFT gain giving unit average power; the Rx applies the inverse.
+constexpr float kTxScale = tables::kTxScale;
+constexpr float kRxScale = tables::kRxScale;
+
+// Fixed point: subcarriers enter the Q15 IFFT at twice the unit level and
+// both transforms scale by 1/N, so the gains differ from the float ones.
+constexpr int kGainBits = 12;
+constexpr std::int32_t kGainRound = 1 << (kGainBits - 1);
+const std::int32_t kTxGainQ12 =
+    std::int32_t(std::lround(double(kN) / (2.0 * std::sqrt(double(kUsed))) * (1 << kGainBits)));
+const std::int32_t kRxGainQ12 =
+    std::int32_t(std::lround(std::sqrt(double(kUsed)) * (1 << kGainBits)));
+constexpr std::int16_t kPilotQ15 = std::int16_t(2 * SampleTraits<ci16>::unit);
+
+}  // namespace
+
+const OfdmLayout& OfdmLayout::ieee80211() {
+    return kIeee80211Layout;
+}
+
+float pilot_polarity(std::size_t symbol_index) noexcept {
+    return tables::kPilotPolarity[symbol_index % tables::kPilotPolarity.size()];
+}
+
+template <SampleType T>
+BasicOfdmModulatorStage<T>::BasicOfdmModulatorStage(std::size_t max_ofdm_symbols,
+                                                    std::size_t pool_depth)
+    : fft_(FftPlan::get(kN)), pool_(pool_depth, max_ofdm_symbols * kSymbolLen) {}
+
+template <SampleType T>
+BufferView<T> BasicOfdmModulatorStage<T>::process(BufferView<T> in) {
+    if (!in) {
+        return {};
+    }
+    BufferView<T> out = pool_.acquire();
+    if (!out) {
+        return {};
+    }
+    const OfdmLayout& layout = OfdmLayout::ieee80211();
+    const std::size_t n_sym = in.size() / PhyConfig::data_subcarriers;
+    out.resize(n_sym * kSymbolLen);
+    if constexpr (!SampleTraits<T>::fixed_point) {
+        for (std::size_t s = 0; s < n_sym; ++s) {
+            const cf32* data = in.data() + s * PhyConfig::data_subcarriers;
+            // The IFFT runs directly in the output, behind the prefix slot.
+            cf32* sym = out.data() + s * kSymbolLen;
+            cf32* body = sym + kCp;
+            std::fill(body, body + kN, cf32{});
+            for (std::size_t k = 0; k < PhyConfig::data_subcarriers; ++k) {
+                body[layout.data_bins[k]] = data[k] * kTxScale;
+            }
+            const float polarity = pilot_polarity(symbol_index_++) * kTxScale;
+            for (std::size_t k = 0; k < PhyConfig::pilot_subcarriers; ++k) {
+                body[layout.pilot_bins[k]] = cf32(OfdmLayout::pilot_values[k] * polarity, 0.0f);
+            }
+        }
+        // One batched IFFT over every symbol body, then the prefixes.
+        fft_.inverse_batch(out.data() + kCp, n_sym, kSymbolLen);
+        for (std::size_t s = 0; s < n_sym; ++s) {
+            cf32* sym = out.data() + s * kSymbolLen;
+            std::copy(sym + kN, sym + kSymbolLen, sym);
+        }
+    } else {
+        std::uint64_t saturated = 0;
+        for (std::size_t s = 0; s < n_sym; ++s) {
+            const T* data = in.data() + s * PhyConfig::data_subcarriers;
+            std::fill(scratch_.begin(), scratch_.end(), ci16{0, 0});
+            for (std::size_t k = 0; k < PhyConfig::data_subcarriers; ++k) {
+                const ci16 d = widen(data[k]);
+                scratch_[layout.data_bins[k]] = {saturate<ci16>(2 * d.re, saturated),
+                                                 saturate<ci16>(2 * d.im, saturated)};
+            }
+            const bool flip = pilot_polarity(symbol_index_++) < 0.0f;
+            for (std::size_t k = 0; k < PhyConfig::pilot_subcarriers; ++k) {
+                const bool negative = (OfdmLayout::pilot_values[k] < 0.0f) != flip;
+                scratch_[layout.pilot_bins[k]] = {negative ? std::int16_t(-kPilotQ15) : kPilotQ15,
+                                                  0};
+            }
+            fft_.inverse(std::span<ci16>(scratch_));
+            T* sym = out.data() + s * kSymbolLen;
+            T* body = sym + kCp;
+            for (std::size_t n = 0; n < kN; ++n) {
+                body[n] = narrow<T>((scratch_[n].re * kTxGainQ12 + kGainRound) >> kGainBits,
+                                    (scratch_[n].im * kTxGainQ12 + kGainRound) >> kGainBits,
+                                    saturated);
+            }
+            std::copy(sym + kN, sym + kSymbolLen, sym);
+        }
+        saturation_.values += 2 * n_sym * kN;
+        saturation_.saturated += saturated;
+    }
+    return out;
+}
+
+template <SampleType T>
+BasicOfdmDemodulatorStage<T>::BasicOfdmDemodulatorStage(std::size_t max_ofdm_symbols,
+                                                        std::size_t pool_depth,
+                                                        FrameArena& arena,
+                                                        Equalizer equalizer)
+    : fft_(FftPlan::get(kN)), mode_(equalizer), arena_(arena),
+      pool_(pool_depth, max_ofdm_symbols * PhyConfig::data_subcarriers) {}
+
+template <SampleType T>
+std::size_t BasicOfdmDemodulatorStage<T>::scratch_bytes(std::size_t max_ofdm_symbols) noexcept {
+    return align_up(max_ofdm_symbols * kN * sizeof(work_type), kCacheLine);
+}
+
+template <SampleType T>
+BufferView<T> BasicOfdmDemodulatorStage<T>::process(BufferView<T> in) {
+    if (!in) {
+        return {};
+    }
+    BufferView<T> out = pool_.acquire();
+    if (!out) {
+        return {};
+    }
+    const OfdmLayout& layout = OfdmLayout::ieee80211();
+    const std::size_t n_sym = in.size() / kSymbolLen;
+    out.resize(n_sym * PhyConfig::data_subcarriers);
+
+    // FFT bodies of the block: the input itself when we own it, else scratch.
+    work_type* bodies;
+    std::size_t stride = kN;
+    if constexpr (std::is_same_v<T, work_type>) {
+        if (in.unique()) {
+            bodies = in.data() + kCp;
+            stride = kSymbolLen;
+        } else {
+            bodies = arena_.allocate<work_type>(n_sym * kN).data();
+            for (std::size_t s = 0; s < n_sym; ++s) {
+                const T* body = in.data() + s * kSymbolLen + kCp;
+                std::copy(body, body + kN, bodies + s * kN);
+            }
+        }
+    } else {
+        bodies = arena_.allocate<work_type>(n_sym * kN).data();
+        for (std::size_t s = 0; s < n_sym; ++s) {
+            const T* body = in.data() + s * kSymbolLen + kCp;
+            for (std::size_t n = 0; n < kN; ++n) {
+                bodies[s * kN + n] = widen(body[n]);
+            }
+        }
+    }
+    fft_.forward_batch(bodies, n_sym, stride);
+
+    std::uint64_t saturated = 0;
+    if (mode_ == Equalizer::pilot_zf) {
+        equalizer_.estimate(bodies, n_sym, stride, symbol_index_);
+    }
+    for (std::size_t s = 0; s < n_sym; ++s) {
+        const work_type* body = bodies + s * stride;
+        T* data = out.data() + s * PhyConfig::data_subcarriers;
+        if (mode_ == Equalizer::pilot_zf) {
+            if constexpr (std::is_same_v<T, work_type>) {
+                equalizer_.apply(body, data, saturated);
+            } else {
+                ci16 eq[PhyConfig::data_subcarriers];
+                equalizer_.apply(body, eq, saturated);
+                for (std::size_t k = 0; k < PhyConfig::data_subcarriers; ++k) {
+                    data[k] = narrow<T>(eq[k].re, eq[k].im, saturated);
+                }
+            }
+        } else if constexpr (!SampleTraits<T>::fixed_point) {
+            for (std::size_t k = 0; k < PhyConfig::data_subcarriers; ++k) {
+                data[k] = body[layout.data_bins[k]] * kRxScale;
+            }
+        } else {
+            for (std::size_t k = 0; k < PhyConfig::data_subcarriers; ++k) {
+                const ci16 v = body[layout.data_bins[k]];
+                data[k] = narrow<T>((v.re * kRxGainQ12 + kGainRound) >> kGainBits,
+                                    (v.im * kRxGainQ12 + kGainRound) >> kGainBits, saturated);
+            }
+        }
+    }
+    symbol_index_ += n_sym;
+    if constexpr (SampleTraits<T>::fixed_point) {
+        saturation_.values += 2 * out.size();
+        saturation_.saturated += saturated;
+    }
+    return out;
+}
+
+template class BasicOfdmModulatorStage<cf32>;
+template class BasicOfdmModulatorStage<ci16>;
+template class BasicOfdmModulatorStage<ci8>;
+template class BasicOfdmDemodulatorStage<cf32>;
+template class BasicOfdmDemodulatorStage<ci16>;
+template class BasicOfdmDemodulatorStage<ci8>;
+
+}  // namespace dcomm
@@ -0,0 +1,59 @@
+#include "dcomm/phy_config.hpp"
+
+#include <stdexcept>
+
+namespace dcomm {
+
+const char* to_string(Modulation m) noexcept {
+    switch (m) {
+    case Modulation::bpsk: return "bpsk";
+    case Modulation::qpsk: return "qpsk";
+    case Modulation::qam16: return "qam16";
+    case Modulation::qam64: return "qam64";
+    case Modulation::qam256: return "qam256";
+    }
+    return "unknown";
+}
+
+const char* to_string(CodeRate r) noexcept {
+    switch (r) {
+    case CodeRate::r1_2: return "r12";
+    case CodeRate::r2_3: return "r23";
+    case CodeRate::r3_4: return "r34";
+    }
+    return "unknown";
+}
+
+const char* to_string(Equalizer e) noexcept {
+    switch (e) {
+    case Equalizer::none: return "none";
+    case Equalizer::pilot_zf: return "zf";
+    }
+    return "unknown";
+}
+
+void PhyConfig::validate() const {
+    if (bits_per_symbol(modulation) == 0) {
+        throw std::invalid_argument("PhyConfig: unknown modulation");
+    }
+    if (code_rate_denominator(code_rate) == 0) {
+        throw std::invalid_argument("PhyConfig: unknown code rate");
+    }
+    if (equalizer != Equalizer::none && equalizer != Equalizer::pilot_zf) {
+        throw std::invalid_argument("PhyConfig: unknown equalizer");
+    }
+    if (symbols_per_block == 0) {
+        throw std::invalid_argument("PhyConfig: symbols_per_block must be > 0");
+    }
+    if (pool_depth < 2) {
+        throw std::invalid_argument("PhyConfig: pool_depth must be >= 2");
+    }
+    if ((scrambler_seed & 0x7f) == 0) {
+        throw std::invalid_argument("PhyConfig: scrambler seed must be non-zero");
+    }
+    if (!(noise_variance > 0.0f)) {
+        throw std::invalid_argument("PhyConfig: noise_variance must be > 0");
+    }
+}
+
+}  // namespace dcomm
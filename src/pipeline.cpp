@@ -0,0 +1,166 @@
+#include "dcomm/pipeline.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace dcomm {
+
+namespace {
+
+const PhyConfig& validated(const PhyConfig& config) {
+    config.validate();
+    return config;
+}
+
+template <std::size_t N>
+std::vector<StageStats> collect_stats(const std::array<StageProbe, N>& probes) {
+    std::vector<StageStats> out;
+    out.reserve(N);
+    for (const StageProbe& p : probes) {
+        out.push_back(p.stats());
+    }
+    return out;
+}
+
+}  // namespace
+
+template <SampleType T>
+BasicTxChain<T>::BasicTxChain(const PhyConfig& config)
+    : config_(validated(config)),
+      probes_{StageProbe("scrambler"), StageProbe("conv_encoder"), StageProbe("interleaver"),
+              StageProbe("mapper"), StageProbe("ofdm_mod")},
+      input_pool_(config.pool_depth, packed_words(config.info_bits_per_block())),
+      scrambler_("scrambler", config.scrambler_seed, config.info_bits_per_block(),
+                 config.pool_depth),
+      encoder_(config.info_bits_per_block(), config.code_rate, config.pool_depth),
+      interleaver_(BlockInterleaver::ieee80211(config), config.coded_bits_per_block(),
+                   config.pool_depth),
+      mapper_(config.modulation, config.constellation_symbols_per_block(),
+              config.pool_depth),
+      modulator_(config.symbols_per_block, config.pool_depth) {}
+
+template <SampleType T>
+BufferView<T> BasicTxChain<T>::process(BufferView<std::uint64_t> bits) {
+    const std::size_t n = config_.samples_per_block();
+    auto scrambled = timed_process(probes_[0], n, scrambler_, std::move(bits));
+    auto coded = timed_process(probes_[1], n, encoder_, std::move(scrambled));
+    if (config_.interleave) {
+        coded = timed_process(probes_[2], n, interleaver_, std::move(coded));
+    }
+    auto symbols = timed_process(probes_[3], n, mapper_, std::move(coded));
+    return timed_process(probes_[4], n, modulator_, std::move(symbols));
+}
+
+template <SampleType T>
+void BasicTxChain<T>::reset() noexcept {
+    scrambler_.scrambler().reset(config_.scrambler_seed);
+    modulator_.reset();
+}
+
+template <SampleType T>
+SaturationStats BasicTxChain<T>::saturation() const noexcept {
+    SaturationStats s = mapper_.saturation();
+    s += modulator_.saturation();
+    return s;
+}
+
+template <SampleType T>
+std::vector<StageStats> BasicTxChain<T>::stage_stats() const {
+    return collect_stats(probes_);
+}
+
+template <SampleType T>
+void BasicTxChain<T>::clear_stage_stats() noexcept {
+    for (StageProbe& p : probes_) {
+        p.clear();
+    }
+}
+
+template <SampleType T>
+void BasicTxChain<T>::attach_trace(TraceRing* trace) noexcept {
+    for (StageProbe& p : probes_) {
+        p.attach(trace);
+    }
+}
+
+template <SampleType T>
+BasicRxChain<T>::BasicRxChain(const PhyConfig& config)
+    : BasicRxChain(config, nullptr) {}
+
+template <SampleType T>
+BasicRxChain<T>::BasicRxChain(const PhyConfig& config, FrameArena& arena)
+    : BasicRxChain(config, &arena) {}
+
+template <SampleType T>
+BasicRxChain<T>::BasicRxChain(const PhyConfig& config, FrameArena* shared)
+    : config_(validated(config)),
+      probes_{StageProbe("ofdm_demod"), StageProbe("demapper"), StageProbe("deinterleaver"),
+              StageProbe("viterbi"), StageProbe("descrambler")},
+      own_arena_(shared == nullptr ? scratch_bytes(config) : 0),
+      arena_(shared == nullptr ? own_arena_ : *shared),
+      input_pool_(config.pool_depth, config.samples_per_block()),
+      demodulator_(config.symbols_per_block, config.pool_depth, arena_, config.equalizer),
+      demapper_(config.modulation, config.noise_variance,
+                config.constellation_symbols_per_block(), config.pool_depth, arena_),
+      deinterleaver_(BlockInterleaver::ieee80211(config), config.coded_bits_per_block(),
+                     config.pool_depth),
+      decoder_(config.info_bits_per_block(), config.code_rate, config.pool_depth),
+      descrambler_(config.scrambler_seed, config.info_bits_per_block(), config.pool_depth) {
+    if (arena_.capacity() < scratch_bytes(config_)) {
+        throw std::invalid_argument("BasicRxChain: arena too small for the configuration");
+    }
+}
+
+template <SampleType T>
+std::size_t BasicRxChain<T>::scratch_bytes(const PhyConfig& config) noexcept {
+    return BasicOfdmDemodulatorStage<T>::scratch_bytes(config.symbols_per_block) +
+           BasicDemapperStage<T>::scratch_bytes(config.constellation_symbols_per_block());
+}
+
+template <SampleType T>
+BufferView<std::uint64_t> BasicRxChain<T>::process(BufferView<T> samples) {
+    const std::size_t n = config_.samples_per_block();
+    auto symbols = timed_process(probes_[0], n, demodulator_, std::move(samples));
+    auto llrs = timed_process(probes_[1], n, demapper_, std::move(symbols));
+    if (config_.interleave) {
+        llrs = timed_process(probes_[2], n, deinterleaver_, std::move(llrs));
+    }
+    auto bits = timed_process(probes_[3], n, decoder_, std::move(llrs));
+    auto out = timed_process(probes_[4], n, descrambler_, std::move(bits));
+    arena_.reset();
+    return out;
+}
+
+template <SampleType T>
+void BasicRxChain<T>::reset() noexcept {
+    demodulator_.reset();
+    descrambler_.scrambler().reset(config_.scrambler_seed);
+}
+
+template <SampleType T>
+std::vector<StageStats> BasicRxChain<T>::stage_stats() const {
+    return collect_stats(probes_);
+}
+
+template <SampleType T>
+void BasicRxChain<T>::clear_stage_stats() noexcept {
+    for (StageProbe& p : probes_) {
+        p.clear();
+    }
+}
+
+template <SampleType T>
+void BasicRxChain<T>::attach_trace(TraceRing* trace) noexcept {
+    for (StageProbe& p : probes_) {
+        p.attach(trace);
+    }
+}
+
+template class BasicTxChain<cf32>;
+template class BasicTxChain<ci16>;
+template class BasicTxChain<ci8>;
+template class BasicRxChain<cf32>;
+template class BasicRxChain<ci16>;
+template class BasicRxChain<ci8>;
+
+}  // namespace dcomm
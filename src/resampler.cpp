@@ -0,0 +1,402 @@
+#include "dcomm/resampler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include "kernels/resampler_kernels.hpp"
+
+namespace dcomm {
+
+namespace {
+
+const kernels::ResamplerKernels& resampler_kernels_for(Isa isa) noexcept {
+    assert(isa_available(isa));
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx2: return kernels::resampler_avx2;
+    case Isa::avx512: return kernels::resampler_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+    case Isa::neon: return kernels::resampler_neon;
+#endif
+    default: return kernels::resampler_scalar;
+    }
+}
+
+void validate(const ResamplerConfig& config, const char* who) {
+    if (!(config.passband > 0.0 && config.passband < 1.0) ||
+        !(config.stopband_db >= 20.0 && config.stopband_db <= 200.0)) {
+        throw std::invalid_argument(std::string(who) +
+                                    ": passband must be in (0, 1), stopband 20..200 dB");
+    }
+}
+
+double sinc(double x) noexcept {
+    const double px = std::numbers::pi * x;
+    return std::abs(x) < 1e-12 ? 1.0 : std::sin(px) / px;
+}
+
+/// Modified Bessel function of the first kind, order 0.
+double bessel_i0(double x) noexcept {
+    double sum = 1.0;
+    double term = 1.0;
+    const double q = x * x / 4.0;
+    for (int k = 1; k < 64 && term > sum * 1e-17; ++k) {
+        term *= q / (double(k) * double(k));
+        sum += term;
+    }
+    return sum;
+}
+
+double kaiser_beta(double attenuation_db) noexcept {
+    if (attenuation_db > 50.0) {
+        return 0.1102 * (attenuation_db - 8.7);
+    }
+    if (attenuation_db >= 21.0) {
+        return 0.5842 * std::pow(attenuation_db - 21.0, 0.4) + 0.07886 * (attenuation_db - 21.0);
+    }
+    return 0.0;
+}
+
+/// Taps of a Kaiser-window low-pass with transition width `transition`
+/// (cycles per sample) meeting `attenuation_db`.
+std::size_t kaiser_length(double attenuation_db, double transition) noexcept {
+    return std::size_t(std::ceil((attenuation_db - 7.95) / (14.36 * transition))) + 1;
+}
+
+/// Kaiser window of length n, sample i.
+double kaiser(std::size_t i, std::size_t n, double beta) noexcept {
+    if (n == 1) {
+        return 1.0;
+    }
+    const double r = 2.0 * double(i) / double(n - 1) - 1.0;
+    return bessel_i0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / bessel_i0(beta);
+}
+
+}  // namespace
+
+ResampleRatio resample_ratio(double in_rate, double out_rate) {
+    if (!(in_rate > 0.0) || !(out_rate > 0.0) || !std::isfinite(in_rate) ||
+        !std::isfinite(out_rate)) {
+        throw std::invalid_argument("resample_ratio: rates must be positive");
+    }
+    // Continued fraction of out/in, stopping at the first convergent that
+    // reproduces the ratio to double precision.
+    const double target = out_rate / in_rate;
+    constexpr std::uint64_t kMaxDown = std::uint64_t(1) << 20;
+    std::uint64_t p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+    double x = target;
+    for (int i = 0; i < 64; ++i) {
+        const double a = std::floor(x);
+        const std::uint64_t p2 = std::uint64_t(a) * p1 + p0;
+        const std::uint64_t q2 = std::uint64_t(a) * q1 + q0;
+        if (p2 > PolyphaseResampler::kMaxPhases || q2 >= kMaxDown) {
+            break;
+        }
+        p0 = p1, q0 = q1, p1 = p2, q1 = q2;
+        if (std::abs(double(p1) / double(q1) - target) <= 1e-12 * target) {
+            return {std::uint32_t(p1), std::uint32_t(q1)};
+        }
+        if (x - a < 1e-12) {
+            break;
+        }
+        x = 1.0 / (x - a);
+    }
+    throw std::invalid_argument("resample_ratio: rate ratio is not a small rational");
+}
+
+// --- PolyphaseResampler --------------------------------------------------
+
+PolyphaseResampler::PolyphaseResampler(ResampleRatio ratio, const ResamplerConfig& config)
+    : PolyphaseResampler(ratio, config, active_isa()) {}
+
+PolyphaseResampler::PolyphaseResampler(ResampleRatio ratio, const ResamplerConfig& config,
+                                       Isa isa)
+    : kernels_(&resampler_kernels_for(isa)) {
+    validate(config, "PolyphaseResampler");
+    if (ratio.up == 0 || ratio.down == 0 || ratio.up > kMaxPhases) {
+        throw std::invalid_argument("PolyphaseResampler: up must be 1..4096, down > 0");
+    }
+    const std::uint32_t g = std::gcd(ratio.up, ratio.down);
+    up_ = ratio.up / g;
+    down_ = ratio.down / g;
+
+    // Prototype at up_ times the input rate, band-limited to the lower
+    // Nyquist rate.
+    const double nyquist = 0.5 / double(std::max(up_, down_));
+    const double transition = (1.0 - config.passband) * nyquist;
+    const double cutoff = nyquist - transition / 2.0;
+    const std::size_t needed = kaiser_length(config.stopband_db, transition);
+    taps_ = (needed + up_ - 1) / up_;
+    taps_ = (taps_ + kernels::kDotTaps - 1) / kernels::kDotTaps * kernels::kDotTaps;
+    const std::size_t n = taps_ * up_;
+    const double beta = kaiser_beta(config.stopband_db);
+    const double centre = double(n - 1) / 2.0;
+    std::vector<double> h(n);
+    double sum = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        h[i] = 2.0 * cutoff * sinc(2.0 * cutoff * (double(i) - centre)) * kaiser(i, n, beta);
+        sum += h[i];
+    }
+    const double gain = double(up_) / sum;
+
+    // Phase p's tap j multiplies input window sample j, oldest first.
+    phases_.resize(std::size_t(up_) * 2 * taps_);
+    for (std::uint32_t p = 0; p < up_; ++p) {
+        float* dst = &phases_[std::size_t(p) * 2 * taps_];
+        for (std::size_t j = 0; j < taps_; ++j) {
+            const float c = float(h[p + (taps_ - 1 - j) * up_] * gain);
+            dst[2 * j] = c;
+            dst[2 * j + 1] = c;
+        }
+    }
+    next_phase_.resize(up_);
+    advance_.resize(up_);
+    for (std::uint32_t p = 0; p < up_; ++p) {
+        next_phase_[p] = (p + down_) % up_;
+        advance_[p] = (p + down_) / up_;
+    }
+    reset();
+}
+
+void PolyphaseResampler::reset() noexcept {
+    std::fill(history_.begin(), history_.end(), cf32{});
+    if (history_.size() < taps_ - 1) {
+        history_.assign(taps_ - 1, cf32{});
+    }
+    offset_ = 0;
+    phase_ = 0;
+}
+
+std::size_t PolyphaseResampler::output_size(std::size_t input) const noexcept {
+    const std::uint64_t end = std::uint64_t(input) * up_;
+    const std::uint64_t t0 = std::uint64_t(offset_) * up_ + phase_;
+    return end <= t0 ? 0 : std::size_t((end - t0 + down_ - 1) / down_);
+}
+
+std::size_t PolyphaseResampler::process(std::span<const cf32> in, std::span<cf32> out) {
+    assert(out.size() >= output_size(in.size()));
+    const std::size_t keep = taps_ - 1;
+    const std::size_t n = in.size();
+    if (history_.size() < keep + n) {
+        history_.resize(keep + n);
+    }
+    std::copy(in.begin(), in.end(), history_.begin() + std::ptrdiff_t(keep));
+
+    const float* x = reinterpret_cast<const float*>(history_.data());
+    float* y = reinterpret_cast<float*>(out.data());
+    const float* taps = phases_.data();
+    std::size_t offset = offset_;
+    std::uint32_t phase = phase_;
+    std::size_t written = 0;
+    while (offset < n) {
+        kernels_->dot(taps + std::size_t(phase) * 2 * taps_, taps_, x + 2 * offset,
+                      y + 2 * written);
+        ++written;
+        offset += advance_[phase];
+        phase = next_phase_[phase];
+    }
+    std::copy(history_.begin() + std::ptrdiff_t(n), history_.begin() + std::ptrdiff_t(n + keep),
+              history_.begin());
+    offset_ = offset - n;
+    phase_ = phase;
+    return written;
+}
+
+double PolyphaseResampler::delay() const noexcept {
+    return double(taps_ * up_ - 1) / 2.0 / double(down_);
+}
+
+// --- HalfbandCascade -----------------------------------------------------
+
+HalfbandCascade::HalfbandCascade(HalfbandMode mode, std::size_t stages,
+                                 const ResamplerConfig& config)
+    : HalfbandCascade(mode, stages, config, active_isa()) {}
+
+HalfbandCascade::HalfbandCascade(HalfbandMode mode, std::size_t stages,
+                                 const ResamplerConfig& config, Isa isa)
+    : kernels_(&resampler_kernels_for(isa)), mode_(mode) {
+    validate(config, "HalfbandCascade");
+    if (stages == 0 || stages > 8) {
+        throw std::invalid_argument("HalfbandCascade: 1..8 stages");
+    }
+    const double beta = kaiser_beta(config.stopband_db);
+    stages_.resize(stages);
+    for (std::size_t b = 0; b < stages; ++b) {
+        // Stage b from baseband works between 2^b and 2^(b+1) times the
+        // baseband rate. Normalised to its higher rate the band it must keep
+        // clear of images (aliases) ends at fp, so its stopband starts at
+        // 1/2 - fp. For stage 0 that is the passband; later stages must
+        // also protect stage 0's transition band, which reaches out to its
+        // stopband edge at 1 - passband / 2 times the baseband Nyquist rate.
+        const double edge = b == 0 ? config.passband : 2.0 - config.passband;
+        const double fp = edge / double(std::size_t(4) << b);
+        const std::size_t needed = kaiser_length(config.stopband_db, 0.5 - 2.0 * fp);
+        const std::size_t k = std::max<std::size_t>(1, (needed + 4) / 4);  // 4k - 1 >= needed
+        const std::size_t n = 4 * k - 1;
+        const std::size_t centre = 2 * k - 1;
+        std::vector<double> dense(2 * k);
+        double sum = 0.0;
+        for (std::size_t i = 0; i < 2 * k; ++i) {
+            const double offset = double(std::ptrdiff_t(2 * i) - std::ptrdiff_t(centre));
+            dense[i] = 0.5 * sinc(offset / 2.0) * kaiser(2 * i, n, beta);
+            sum += dense[i];
+        }
+        // The dense branch carries half the DC gain, the centre tap the
+        // other half; interpolation doubles both to restore the level.
+        const double gain = (mode == HalfbandMode::interpolate ? 1.0 : 0.5) / sum;
+        Stage& s = stages_[mode == HalfbandMode::interpolate ? b : stages - 1 - b];
+        s.taps.resize(2 * k);
+        for (std::size_t i = 0; i < 2 * k; ++i) {
+            s.taps[i] = float(dense[i] * gain);  // symmetric: reversal is a no-op
+        }
+    }
+    reset();
+}
+
+void HalfbandCascade::reset() noexcept {
+    for (Stage& s : stages_) {
+        const std::size_t k = s.taps.size() / 2;
+        std::fill(s.history.begin(), s.history.end(), cf32{});
+        if (s.history.size() < s.taps.size() - 1) {
+            s.history.assign(s.taps.size() - 1, cf32{});
+        }
+        std::fill(s.odd.begin(), s.odd.end(), cf32{});
+        if (s.odd.size() < k) {
+            s.odd.assign(k, cf32{});
+        }
+        s.pending = false;
+    }
+}
+
+std::vector<std::size_t> HalfbandCascade::stage_taps() const {
+    std::vector<std::size_t> taps;
+    for (const Stage& s : stages_) {
+        taps.push_back(s.taps.size());
+    }
+    if (mode_ == HalfbandMode::decimate) {
+        std::reverse(taps.begin(), taps.end());
+    }
+    return taps;
+}
+
+double HalfbandCascade::delay() const noexcept {
+    // A stage delays by its centre tap, 2k - 1 samples at its higher rate.
+    const std::size_t count = stages_.size();
+    double delay = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double centre = double(stages_[i].taps.size() - 1);
+        if (mode_ == HalfbandMode::interpolate) {
+            delay += centre * double(std::size_t(1) << (count - 1 - i));  // outputs of stage i
+        } else {
+            delay += centre / double(std::size_t(2) << (count - 1 - i));
+        }
+    }
+    return delay;
+}
+
+std::size_t HalfbandCascade::output_size(std::size_t input) const noexcept {
+    std::size_t n = input;
+    for (const Stage& s : stages_) {
+        if (mode_ == HalfbandMode::interpolate) {
+            n *= 2;
+        } else {
+            n = s.pending ? n / 2 : (n + 1) / 2;
+        }
+    }
+    return n;
+}
+
+std::size_t HalfbandCascade::process(std::span<const cf32> in, std::span<cf32> out) {
+    assert(out.size() >= output_size(in.size()));
+    std::span<const cf32> cur = in;
+    for (std::size_t i = 0; i < stages_.size(); ++i) {
+        Stage& s = stages_[i];
+        const bool last = i + 1 == stages_.size();
+        const std::size_t size = mode_ == HalfbandMode::interpolate
+                                     ? 2 * cur.size()
+                                     : (s.pending ? cur.size() / 2 : (cur.size() + 1) / 2);
+        std::vector<cf32>& buffer = scratch_[i % 2];
+        if (!last && buffer.size() < size) {
+            buffer.resize(size);
+        }
+        cf32* dst = last ? out.data() : buffer.data();
+        const std::size_t written =
+            mode_ == HalfbandMode::interpolate ? interpolate(s, cur, dst) : decimate(s, cur, dst);
+        assert(written == size);
+        cur = std::span<const cf32>(dst, written);
+    }
+    return cur.size();
+}
+
+std::size_t HalfbandCascade::interpolate(Stage& s, std::span<const cf32> in, cf32* out) {
+    // y[2j] = dense FIR over x[j - 2k + 1 .. j], y[2j + 1] = x[j - k + 1].
+    const std::size_t keep = s.taps.size() - 1;
+    const std::size_t k = s.taps.size() / 2;
+    const std::size_t n = in.size();
+    if (s.history.size() < keep + n) {
+        s.history.resize(keep + n);
+    }
+    if (s.dense.size() < n) {
+        s.dense.resize(n);
+    }
+    std::copy(in.begin(), in.end(), s.history.begin() + std::ptrdiff_t(keep));
+    kernels_->fir(s.taps.data(), s.taps.size(), reinterpret_cast<const float*>(s.history.data()),
+                  n, reinterpret_cast<float*>(s.dense.data()));
+    for (std::size_t j = 0; j < n; ++j) {
+        out[2 * j] = s.dense[j];
+        out[2 * j + 1] = s.history[j + k];
+    }
+    std::copy(s.history.begin() + std::ptrdiff_t(n),
+              s.history.begin() + std::ptrdiff_t(n + keep), s.history.begin());
+    return 2 * n;
+}
+
+std::size_t HalfbandCascade::decimate(Stage& s, std::span<const cf32> in, cf32* out) {
+    // With e[j] = x[2j] and o[j] = x[2j + 1]:
+    // y[j] = dense FIR over e[j - 2k + 1 .. j] + o[j - k] / 2.
+    // s.odd holds o[j0 - k .. j0 - 1] for the first output j0 of the call,
+    // the last one still to come while an even sample is pending.
+    const std::size_t keep = s.taps.size() - 1;
+    const std::size_t k = s.taps.size() / 2;
+    const std::size_t n = in.size();
+    if (s.history.size() < keep + n / 2 + 1) {
+        s.history.resize(keep + n / 2 + 1);
+    }
+    if (s.odd.size() < k + n / 2 + 1) {
+        s.odd.resize(k + n / 2 + 1);
+    }
+    std::size_t i = 0;
+    if (s.pending && n > 0) {
+        s.odd[k - 1] = in[0];
+        s.pending = false;
+        i = 1;
+    }
+    std::size_t even = 0;
+    std::size_t odd = 0;
+    while (i < n) {
+        s.history[keep + even++] = in[i++];
+        if (i < n) {
+            s.odd[k + odd++] = in[i++];
+        } else {
+            s.pending = true;
+        }
+    }
+    kernels_->fir(s.taps.data(), s.taps.size(), reinterpret_cast<const float*>(s.history.data()),
+                  even, reinterpret_cast<float*>(out));
+    for (std::size_t j = 0; j < even; ++j) {
+        out[j] += s.odd[j] * 0.5f;
+    }
+    std::copy(s.history.begin() + std::ptrdiff_t(even),
+              s.history.begin() + std::ptrdiff_t(even + keep), s.history.begin());
+    std::copy(s.odd.begin() + std::ptrdiff_t(even), s.odd.begin() + std::ptrdiff_t(even + k),
+              s.odd.begin());
+    return even;
+}
+
+}  // namespace dcomm
@@ -0,0 +1,125 @@
+#include "dcomm/scheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace dcomm {
+
+namespace {
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+}  // namespace
+
+void AdaptiveWaiter::idle() noexcept {
+    ++idle_;
+    if (idle_ <= policy_.spin) {
+        cpu_relax();
+    } else if (idle_ <= std::uint64_t(policy_.spin) + policy_.yield) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(sleep_);
+        sleep_ = std::min(sleep_ * 2, policy_.max_sleep);
+        ++sleeps_;
+    }
+}
+
+std::size_t PipelineScheduler::add(std::string name, int cpu, Task task) {
+    if (running()) {
+        throw std::logic_error("PipelineScheduler::add: scheduler is running");
+    }
+    auto e = std::make_unique<Entry>();
+    e->name = std::move(name);
+    e->cpu = cpu;
+    e->node = cpu < 0 ? 0 : numa_node_of_cpu(cpu);
+    e->task = std::move(task);
+    tasks_.push_back(std::move(e));
+    return tasks_.size() - 1;
+}
+
+void PipelineScheduler::start() {
+    if (running()) {
+        return;
+    }
+    stop_.store(false, std::memory_order_relaxed);
+    threads_.reserve(tasks_.size());
+    for (auto& e : tasks_) {
+        threads_.emplace_back([this, entry = e.get()] { run(*entry); });
+    }
+}
+
+void PipelineScheduler::stop() {
+    stop_.store(true, std::memory_order_relaxed);
+    for (std::thread& t : threads_) {
+        t.join();
+    }
+    threads_.clear();
+}
+
+void PipelineScheduler::run(Entry& e) {
+    if (e.cpu >= 0) {
+        e.pinned.store(pin_current_thread(e.cpu), std::memory_order_relaxed);
+    }
+    AdaptiveWaiter waiter(policy_);
+    // Counters have a single writer; see SpscRing::bump().
+    auto bump = [](std::atomic<std::uint64_t>& c) {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    };
+    while (!stop_.load(std::memory_order_relaxed)) {
+        if (e.task()) {
+            bump(e.busy);
+            waiter.reset();
+        } else {
+            bump(e.idle);
+            const std::uint64_t before = waiter.sleeps();
+            waiter.idle();
+            if (waiter.sleeps() != before) {
+                bump(e.sleeps);
+            }
+        }
+    }
+}
+
+std::vector<TaskStats> PipelineScheduler::stats() const {
+    std::vector<TaskStats> out;
+    out.reserve(tasks_.size());
+    for (const auto& e : tasks_) {
+        TaskStats s;
+        s.name = e->name;
+        s.cpu = e->cpu;
+        s.node = e->node;
+        s.pinned = e->pinned.load(std::memory_order_relaxed);
+        s.busy_polls = e->busy.load(std::memory_order_relaxed);
+        s.idle_polls = e->idle.load(std::memory_order_relaxed);
+        s.sleeps = e->sleeps.load(std::memory_order_relaxed);
+        out.push_back(std::move(s));
+    }
+    return out;
+}
+
+std::vector<int> PipelineScheduler::spread(std::size_t count, int node) {
+    const int cpus = int(cpu_count());
+    std::vector<int> local;
+    std::vector<int> remote;
+    for (int c = 0; c < cpus; ++c) {
+        (numa_node_of_cpu(c) == node ? local : remote).push_back(c);
+    }
+    local.insert(local.end(), remote.begin(), remote.end());
+    std::vector<int> out(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = local.empty() ? -1 : local[i % local.size()];
+    }
+    return out;
+}
+
+}  // namespace dcomm
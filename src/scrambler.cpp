@@ -0,0 +1,305 @@
+#include "dcomm/scrambler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+namespace dcomm {
+
+namespace {
+
+// --- 802.11 sequence table -----------------------------------------------
+
+constexpr std::size_t kPeriod = 127;
+
+/// One period of the x^7 + x^4 + 1 sequence from state 0x7f, the position
+/// of every state on it, the sequence twice over so any block of up to one
+/// period is a contiguous slice, and the 64 bits from every phase packed.
+struct SequenceTable {
+    std::uint8_t state_at[kPeriod];
+    std::uint8_t position[128];
+    std::uint8_t bits[2 * kPeriod];
+    std::uint64_t words[kPeriod];  // words[k]: bits k .. k + 63, first in bit 0
+};
+
+constexpr SequenceTable make_sequence_table() noexcept {
+    SequenceTable t{};
+    std::uint8_t state = 0x7f;
+    for (std::size_t k = 0; k < kPeriod; ++k) {
+        t.state_at[k] = state;
+        t.position[state] = std::uint8_t(k);
+        const std::uint8_t fb = ((state >> 6) ^ (state >> 3)) & 1;
+        state = std::uint8_t(((state << 1) | fb) & 0x7f);
+        t.bits[k] = t.bits[k + kPeriod] = fb;
+    }
+    for (std::size_t k = 0; k < kPeriod; ++k) {
+        for (std::size_t i = 0; i < 64; ++i) {
+            t.words[k] |= std::uint64_t(t.bits[k + i]) << i;
+        }
+    }
+    return t;
+}
+
+constexpr SequenceTable kSequence = make_sequence_table();
+
+// --- Gold sequence jump-ahead --------------------------------------------
+
+constexpr unsigned kGoldOffset = 1600;  // N_C
+
+/// First two words of x1(n + N_C), and of x2(n + N_C) for every c_init
+/// with a single bit set.
+struct GoldTable {
+    std::uint64_t x1[2];
+    std::uint64_t x2[31][2];
+};
+
+/// Run x(n + 31) = x(n + 3) + x(n) (`second`: + x(n + 2) + x(n + 1)) from
+/// x(0..30) = init and keep x(N_C) .. x(N_C + 127).
+constexpr void run_msequence(std::uint32_t init, bool second, std::uint64_t (&out)[2]) noexcept {
+    std::uint32_t reg = init;  // bit i: x(n + i)
+    for (unsigned n = 0; n < kGoldOffset + 128; ++n) {
+        if (n >= kGoldOffset) {
+            out[(n - kGoldOffset) / 64] |= std::uint64_t(reg & 1u) << ((n - kGoldOffset) % 64);
+        }
+        const std::uint32_t fb =
+            (second ? reg ^ (reg >> 1) ^ (reg >> 2) ^ (reg >> 3) : reg ^ (reg >> 3)) & 1u;
+        reg = (reg >> 1) | (fb << 30);
+    }
+}
+
+constexpr GoldTable make_gold_table() noexcept {
+    GoldTable t{};
+    run_msequence(1, false, t.x1);
+    for (unsigned b = 0; b < 31; ++b) {
+        run_msequence(1u << b, true, t.x2[b]);
+    }
+    return t;
+}
+
+constexpr GoldTable kGold = make_gold_table();
+
+/// kSpread[v]: bit i of v in byte i, to XOR eight unpacked bits at once.
+constexpr std::array<std::uint64_t, 256> make_spread() noexcept {
+    std::array<std::uint64_t, 256> t{};
+    for (unsigned v = 0; v < 256; ++v) {
+        for (unsigned i = 0; i < 8; ++i) {
+            t[v] |= std::uint64_t((v >> i) & 1u) << (8 * i);
+        }
+    }
+    return t;
+}
+
+constexpr std::array<std::uint64_t, 256> kSpread = make_spread();
+
+/// kSigns[v][i]: float sign bit if bit i of v is set, to negate four LLRs
+/// at once. Shifts by a per-lane count need AVX2; table rows do not.
+constexpr std::array<std::array<std::uint32_t, 4>, 16> make_signs() noexcept {
+    std::array<std::array<std::uint32_t, 4>, 16> t{};
+    for (unsigned v = 0; v < 16; ++v) {
+        for (unsigned i = 0; i < 4; ++i) {
+            t[v][i] = ((v >> i) & 1u) << 31;
+        }
+    }
+    return t;
+}
+
+constexpr std::array<std::array<std::uint32_t, 4>, 16> kSigns = make_signs();
+
+/// Bits 64 - lag .. 127 - lag of the two words {x[0], x[1]}: the lag-`lag`
+/// term of the word after them.
+constexpr std::uint64_t lagged(const std::uint64_t (&x)[2], unsigned lag) noexcept {
+    const unsigned s = 128 - lag;
+    return (x[0] >> s) | (x[1] << (64 - s));
+}
+
+}  // namespace
+
+// --- Scrambler -----------------------------------------------------------
+
+void Scrambler::reset(std::uint8_t seed) {
+    if ((seed & 0x7f) == 0) {
+        throw std::invalid_argument("Scrambler: seed must be non-zero");
+    }
+    state_ = seed & 0x7f;
+}
+
+void Scrambler::apply(std::span<const std::uint8_t> in,
+                      std::span<std::uint8_t> out) noexcept {
+    assert(out.size() >= in.size());
+    const std::size_t pos = kSequence.position[state_];
+    const std::uint8_t* seq = kSequence.bits + pos;
+    // A whole period ends where it started, so every chunk begins at pos.
+    for (std::size_t i = 0; i < in.size(); i += kPeriod) {
+        const std::size_t n = std::min(kPeriod, in.size() - i);
+        for (std::size_t j = 0; j < n; ++j) {
+            out[i + j] = in[i + j] ^ seq[j];
+        }
+    }
+    state_ = kSequence.state_at[(pos + in.size()) % kPeriod];
+}
+
+void Scrambler::apply(ConstBitSpan in, BitSpan out) noexcept {
+    assert(out.size() == in.size());
+    const std::size_t pos = kSequence.position[state_];
+    const std::size_t nw = in.word_count();
+    std::size_t phase = pos;
+    for (std::size_t w = 0; w < nw; ++w) {
+        out.words[w] = in.words[w] ^ kSequence.words[phase];
+        phase = phase + 64 >= kPeriod ? phase + 64 - kPeriod : phase + 64;
+    }
+    if (nw != 0) {
+        out.words[nw - 1] &= tail_mask(in.size());
+    }
+    state_ = kSequence.state_at[(pos + in.size()) % kPeriod];
+}
+
+// --- GoldSequence --------------------------------------------------------
+
+void GoldSequence::reset(std::uint32_t c_init) noexcept {
+    assert(c_init < (1u << 31));
+    x1_[0] = kGold.x1[0];
+    x1_[1] = kGold.x1[1];
+    x2_[0] = x2_[1] = 0;
+    for (unsigned b = 0; b < 31; ++b) {
+        if ((c_init >> b) & 1u) {
+            x2_[0] ^= kGold.x2[b][0];
+            x2_[1] ^= kGold.x2[b][1];
+        }
+    }
+    word_ = 0;
+    left_ = 0;
+}
+
+std::uint64_t GoldSequence::step() noexcept {
+    // (x^31 + x^3 + 1)^4 = x^124 + x^12 + 1 and (x^31 + x^3 + x^2 + x + 1)^4
+    // = x^124 + x^12 + x^8 + x^4 + 1 generate the same sequences.
+    const std::uint64_t c = x1_[0] ^ x2_[0];
+    const std::uint64_t n1 = lagged(x1_, 112) ^ lagged(x1_, 124);
+    const std::uint64_t n2 =
+        lagged(x2_, 112) ^ lagged(x2_, 116) ^ lagged(x2_, 120) ^ lagged(x2_, 124);
+    x1_[0] = x1_[1];
+    x1_[1] = n1;
+    x2_[0] = x2_[1];
+    x2_[1] = n2;
+    return c;
+}
+
+std::uint64_t GoldSequence::next_bits(unsigned count) noexcept {
+    assert(count >= 1 && count <= 64);
+    const std::uint64_t mask = count == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+    if (left_ >= count) {
+        const std::uint64_t r = word_ & mask;
+        word_ = count == 64 ? 0 : word_ >> count;
+        left_ -= count;
+        return r;
+    }
+    const std::uint64_t w = step();
+    const std::uint64_t r = (word_ | (w << left_)) & mask;
+    const unsigned used = count - left_;
+    word_ = used == 64 ? 0 : w >> used;
+    left_ = 64 - used;
+    return r;
+}
+
+void GoldSequence::apply(std::span<const std::uint8_t> in,
+                         std::span<std::uint8_t> out) noexcept {
+    assert(out.size() >= in.size());
+    std::size_t i = 0;
+    for (; i + 64 <= in.size(); i += 64) {
+        const std::uint64_t c = next_bits(64);
+        for (unsigned b = 0; b < 8; ++b) {
+            std::uint64_t x;
+            std::memcpy(&x, in.data() + i + 8 * b, 8);
+            x ^= kSpread[(c >> (8 * b)) & 0xff];
+            std::memcpy(out.data() + i + 8 * b, &x, 8);
+        }
+    }
+    if (i < in.size()) {
+        const auto n = unsigned(in.size() - i);
+        const std::uint64_t c = next_bits(n);
+        for (unsigned j = 0; j < n; ++j) {
+            out[i + j] = in[i + j] ^ std::uint8_t((c >> j) & 1u);
+        }
+    }
+}
+
+void GoldSequence::apply(ConstBitSpan in, BitSpan out) noexcept {
+    assert(out.size() == in.size());
+    for (std::size_t w = 0; w < in.word_count(); ++w) {
+        const auto n = unsigned(std::min<std::size_t>(64, in.size() - 64 * w));
+        out.words[w] = (in.words[w] ^ next_bits(n)) & tail_mask(n);
+    }
+}
+
+void GoldSequence::apply(std::span<const float> in, std::span<float> out) noexcept {
+    assert(out.size() >= in.size());
+    std::size_t i = 0;
+    for (; i + 64 <= in.size(); i += 64) {
+        const std::uint64_t c = next_bits(64);
+        for (unsigned g = 0; g < 16; ++g) {
+            const auto& sign = kSigns[(c >> (4 * g)) & 15];
+            std::uint32_t x[4];
+            std::memcpy(x, in.data() + i + 4 * g, sizeof x);
+            for (unsigned k = 0; k < 4; ++k) {
+                x[k] ^= sign[k];
+            }
+            std::memcpy(out.data() + i + 4 * g, x, sizeof x);
+        }
+    }
+    if (i < in.size()) {
+        const auto n = unsigned(in.size() - i);
+        const std::uint64_t c = next_bits(n);
+        for (unsigned j = 0; j < n; ++j) {
+            out[i + j] = (c >> j) & 1u ? -in[i + j] : in[i + j];
+        }
+    }
+}
+
+// --- Stages --------------------------------------------------------------
+
+ScramblerStage::ScramblerStage(const char* name, std::uint8_t seed,
+                               std::size_t block_bits, std::size_t pool_depth)
+    : name_(name), scrambler_(seed), block_bits_(block_bits),
+      pool_(pool_depth, packed_words(block_bits)) {}
+
+BufferView<std::uint64_t> ScramblerStage::process(BufferView<std::uint64_t> in) {
+    if (!in) {
+        return {};
+    }
+    assert(in.size() == packed_words(block_bits_));
+    if (in.unique()) {
+        const BitSpan bits(in.span(), block_bits_);
+        scrambler_.apply(bits, bits);
+        return in;
+    }
+    BufferView<std::uint64_t> out = pool_.acquire();
+    if (!out) {
+        return {};
+    }
+    out.resize(in.size());
+    scrambler_.apply(ConstBitSpan(in.span(), block_bits_), BitSpan(out.span(), block_bits_));
+    return out;
+}
+
+DescramblerStage::DescramblerStage(std::uint8_t seed, std::size_t block_bits,
+                                   std::size_t pool_depth)
+    : scrambler_(seed), block_bits_(block_bits), pool_(pool_depth, packed_words(block_bits)) {}
+
+BufferView<std::uint64_t> DescramblerStage::process(BufferView<std::uint8_t> in) {
+    if (!in) {
+        return {};
+    }
+    BufferView<std::uint64_t> out = pool_.acquire();
+    if (!out) {
+        return {};
+    }
+    assert(in.size() == block_bits_);
+    const BitSpan bits(out.span(), block_bits_);
+    pack_bits(in.span(), bits);
+    scrambler_.apply(bits, bits);
+    return out;
+}
+
+}  // namespace dcomm
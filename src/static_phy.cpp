@@ -0,0 +1,252 @@
+#include "dcomm/static_phy.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "dcomm/convcode.hpp"
+#include "dcomm/equalizer.hpp"
+#include "dcomm/fft.hpp"
+#include "dcomm/interleaver.hpp"
+#include "dcomm/modulation.hpp"
+#include "dcomm/phy_tables.hpp"
+#include "dcomm/scrambler.hpp"
+
+namespace dcomm {
+
+namespace {
+
+using namespace tables;
+
+/// Compile-time parameters: every member is a constant, so the loops of
+/// FramePhyImpl built on them have fixed bounds and index .rodata tables.
+template <Modulation M, CodeRate R, bool Interleave>
+struct StaticParams {
+    using mcs = Mcs<M, R>;
+
+    explicit StaticParams(const PhyConfig&) noexcept {}
+
+    static constexpr bool specialized = true;
+    static constexpr Modulation modulation() noexcept { return M; }
+    static constexpr CodeRate code_rate() noexcept { return R; }
+    static constexpr std::size_t n_cbps() noexcept { return mcs::n_cbps; }
+    static constexpr bool interleave() noexcept { return Interleave; }
+
+    /// One OFDM symbol of coded bits, out[j] = in[source[j]].
+    static void interleave_symbol(const std::uint8_t* in, std::uint8_t* out) noexcept {
+        for (std::size_t j = 0; j < mcs::n_cbps; ++j) {
+            out[j] = in[mcs::interleaver_source[j]];
+        }
+    }
+    /// One OFDM symbol of LLRs, out[i] = in[target[i]].
+    static void deinterleave_symbol(const float* in, float* out) noexcept {
+        for (std::size_t i = 0; i < mcs::n_cbps; ++i) {
+            out[i] = in[mcs::interleaver_target[i]];
+        }
+    }
+};
+
+/// The same interface over the runtime configuration.
+struct DynamicParams {
+    explicit DynamicParams(const PhyConfig& c)
+        : modulation_(c.modulation), code_rate_(c.code_rate),
+          n_cbps_(c.coded_bits_per_ofdm_symbol()), interleave_(c.interleave),
+          interleaver_(&BlockInterleaver::ieee80211(c)) {}
+
+    static constexpr bool specialized = false;
+    Modulation modulation() const noexcept { return modulation_; }
+    CodeRate code_rate() const noexcept { return code_rate_; }
+    std::size_t n_cbps() const noexcept { return n_cbps_; }
+    bool interleave() const noexcept { return interleave_; }
+
+    void interleave_symbol(const std::uint8_t* in, std::uint8_t* out) const noexcept {
+        interleaver_->interleave(std::span(in, n_cbps_), std::span(out, n_cbps_));
+    }
+    void deinterleave_symbol(const float* in, float* out) const noexcept {
+        interleaver_->deinterleave(std::span(in, n_cbps_), std::span(out, n_cbps_));
+    }
+
+private:
+    Modulation modulation_;
+    CodeRate code_rate_;
+    std::size_t n_cbps_;
+    bool interleave_;
+    const BlockInterleaver* interleaver_;
+};
+
+/// The frame pipeline over parameters P.
+template <class P>
+class FramePhyImpl final : public FramePhy {
+public:
+    explicit FramePhyImpl(const PhyConfig& config)
+        : FramePhy(config), p_(config), fft_(FftPlan::get(kFftSize)),
+          n_sym_(config.symbols_per_block),
+          scrambled_(config.info_bits_per_block()),
+          mother_(conv_coded_bits(config.info_bits_per_block())),
+          punctured_(config.coded_bits_per_block()),
+          bytes_(make_aligned_array<std::uint8_t>(config.coded_bits_per_block())),
+          permuted_(make_aligned_array<std::uint8_t>(config.coded_bits_per_block())),
+          symbols_(make_aligned_array<cf32>(n_sym_ * kDataSubcarriers)),
+          bodies_(make_aligned_array<cf32>(n_sym_ * kFftSize)),
+          llrs_(make_aligned_array<float>(config.coded_bits_per_block())),
+          deinterleaved_(make_aligned_array<float>(config.coded_bits_per_block())) {}
+
+    using FramePhy::decode;
+    using FramePhy::encode;
+    void encode(ConstBitSpan bits, std::span<cf32> samples, std::size_t symbols) override;
+    void decode(std::span<const cf32> samples, BitSpan bits, std::size_t symbols) override;
+    bool specialized() const noexcept override { return P::specialized; }
+
+private:
+    P p_;
+    const FftPlan& fft_;
+    ViterbiDecoder decoder_;
+    std::size_t n_sym_;  // capacity
+    PackedBits scrambled_;
+    PackedBits mother_;  // rate-1/2 codeword before puncturing
+    PackedBits punctured_;
+    AlignedArray<std::uint8_t> bytes_;
+    AlignedArray<std::uint8_t> permuted_;
+    AlignedArray<cf32> symbols_;
+    AlignedArray<cf32> bodies_;
+    AlignedArray<float> llrs_;
+    AlignedArray<float> deinterleaved_;
+    PilotEqualizer<cf32> equalizer_;
+};
+
+template <class P>
+void FramePhyImpl<P>::encode(ConstBitSpan bits, std::span<cf32> samples, std::size_t n_sym) {
+    const std::size_t n_info = info_bits(n_sym);
+    const std::size_t n_coded = n_sym * p_.n_cbps();
+    assert(n_sym <= n_sym_ && bits.size() >= n_info &&
+           samples.size() >= n_sym * kSymbolLength);
+    const BitSpan scrambled = scrambled_.view().subspan(0, n_info);
+    const BitSpan mother = mother_.view().subspan(0, conv_coded_bits(n_info));
+    const BitSpan punctured = punctured_.view().subspan(0, n_coded);
+    Scrambler(config_.scrambler_seed).apply(bits.subspan(0, n_info), scrambled);
+    conv_encode(scrambled, mother);
+    puncture(p_.code_rate(), mother, punctured);
+    unpack_bits(punctured, std::span(bytes_.get(), n_coded));
+
+    const std::uint8_t* coded = bytes_.get();
+    if (p_.interleave()) {
+        for (std::size_t s = 0; s < n_sym; ++s) {
+            p_.interleave_symbol(bytes_.get() + s * p_.n_cbps(),
+                                 permuted_.get() + s * p_.n_cbps());
+        }
+        coded = permuted_.get();
+    }
+    map_bits(p_.modulation(), std::span(coded, n_coded),
+             std::span(symbols_.get(), n_sym * kDataSubcarriers));
+
+    for (std::size_t s = 0; s < n_sym; ++s) {
+        const cf32* data = symbols_.get() + s * kDataSubcarriers;
+        cf32* sym = samples.data() + s * kSymbolLength;
+        cf32* body = sym + kCpLength;
+        std::fill(body, body + kFftSize, cf32{});
+        for (std::size_t k = 0; k < kDataSubcarriers; ++k) {
+            body[kDataBins[k]] = data[k] * kTxScale;
+        }
+        const float polarity =
+            kPilotPolarity[(pilot_offset_ + s) % kPilotPolarity.size()] * kTxScale;
+        for (std::size_t k = 0; k < kPilotSubcarriers; ++k) {
+            body[kPilotBins[k]] = cf32(kPilotValues[k] * polarity, 0.0f);
+        }
+    }
+    fft_.inverse_batch(samples.data() + kCpLength, n_sym, kSymbolLength);
+    for (std::size_t s = 0; s < n_sym; ++s) {
+        cf32* sym = samples.data() + s * kSymbolLength;
+        std::copy(sym + kFftSize, sym + kSymbolLength, sym);
+    }
+}
+
+template <class P>
+void FramePhyImpl<P>::decode(std::span<const cf32> samples, BitSpan bits, std::size_t n_sym) {
+    const std::size_t n_info = info_bits(n_sym);
+    const std::size_t n_coded = n_sym * p_.n_cbps();
+    assert(n_sym <= n_sym_ && bits.size() >= n_info &&
+           samples.size() >= n_sym * kSymbolLength);
+    cf32* bodies = bodies_.get();
+    for (std::size_t s = 0; s < n_sym; ++s) {
+        const cf32* body = samples.data() + s * kSymbolLength + kCpLength;
+        std::copy(body, body + kFftSize, bodies + s * kFftSize);
+    }
+    fft_.forward_batch(bodies, n_sym, kFftSize);
+
+    cf32* symbols = symbols_.get();
+    if (config_.equalizer == Equalizer::pilot_zf) {
+        std::uint64_t saturated = 0;
+        equalizer_.estimate(bodies, n_sym, kFftSize, pilot_offset_);
+        for (std::size_t s = 0; s < n_sym; ++s) {
+            equalizer_.apply(bodies + s * kFftSize, symbols + s * kDataSubcarriers, saturated);
+        }
+    } else {
+        for (std::size_t s = 0; s < n_sym; ++s) {
+            for (std::size_t k = 0; k < kDataSubcarriers; ++k) {
+                symbols[s * kDataSubcarriers + k] = bodies[s * kFftSize + kDataBins[k]] * kRxScale;
+            }
+        }
+    }
+
+    demap_maxlog(p_.modulation(), std::span<const cf32>(symbols, n_sym * kDataSubcarriers),
+                 config_.noise_variance, std::span(llrs_.get(), n_coded));
+    const float* llrs = llrs_.get();
+    if (p_.interleave()) {
+        for (std::size_t s = 0; s < n_sym; ++s) {
+            p_.deinterleave_symbol(llrs_.get() + s * p_.n_cbps(),
+                                   deinterleaved_.get() + s * p_.n_cbps());
+        }
+        llrs = deinterleaved_.get();
+    }
+    decoder_.decode(std::span(llrs, n_coded), std::span(bytes_.get(), n_info),
+                    p_.code_rate());
+    const BitSpan out = bits.subspan(0, n_info);
+    pack_bits(std::span<const std::uint8_t>(bytes_.get(), n_info), out);
+    Scrambler(config_.scrambler_seed).apply(out, out);
+}
+
+using Factory = std::unique_ptr<FramePhy> (*)(const PhyConfig&);
+
+template <Modulation M, CodeRate R>
+std::unique_ptr<FramePhy> make_static(const PhyConfig& c) {
+    if (c.interleave) {
+        return std::make_unique<FramePhyImpl<StaticParams<M, R, true>>>(c);
+    }
+    return std::make_unique<FramePhyImpl<StaticParams<M, R, false>>>(c);
+}
+
+struct Specialization {
+    Modulation modulation;
+    CodeRate code_rate;
+    Factory make;
+};
+
+/// The 802.11a rate table (17.3.2.3), 6 to 54 Mbit/s.
+constexpr Specialization kSpecializations[] = {
+    {Modulation::bpsk, CodeRate::r1_2, &make_static<Modulation::bpsk, CodeRate::r1_2>},
+    {Modulation::bpsk, CodeRate::r3_4, &make_static<Modulation::bpsk, CodeRate::r3_4>},
+    {Modulation::qpsk, CodeRate::r1_2, &make_static<Modulation::qpsk, CodeRate::r1_2>},
+    {Modulation::qpsk, CodeRate::r3_4, &make_static<Modulation::qpsk, CodeRate::r3_4>},
+    {Modulation::qam16, CodeRate::r1_2, &make_static<Modulation::qam16, CodeRate::r1_2>},
+    {Modulation::qam16, CodeRate::r3_4, &make_static<Modulation::qam16, CodeRate::r3_4>},
+    {Modulation::qam64, CodeRate::r2_3, &make_static<Modulation::qam64, CodeRate::r2_3>},
+    {Modulation::qam64, CodeRate::r3_4, &make_static<Modulation::qam64, CodeRate::r3_4>},
+};
+
+}  // namespace
+
+std::unique_ptr<FramePhy> make_frame_phy(const PhyConfig& config) {
+    config.validate();
+    for (const Specialization& s : kSpecializations) {
+        if (s.modulation == config.modulation && s.code_rate == config.code_rate) {
+            return s.make(config);
+        }
+    }
+    return std::make_unique<FramePhyImpl<DynamicParams>>(config);
+}
+
+std::unique_ptr<FramePhy> make_generic_frame_phy(const PhyConfig& config) {
+    config.validate();
+    return std::make_unique<FramePhyImpl<DynamicParams>>(config);
+}
+
+}  // namespace dcomm
@@ -0,0 +1,360 @@
+#include "dcomm/sync.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <stdexcept>
+
+#include "dcomm/fast_math.hpp"
+#include "kernels/sync_kernels.hpp"
+
+namespace dcomm {
+
+namespace {
+
+using cd = std::complex<double>;
+
+const kernels::SyncKernels& sync_kernels_for(Isa isa) {
+    if (!isa_available(isa)) {
+        throw std::invalid_argument("PacketSync: ISA not available on this CPU");
+    }
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx2: return kernels::sync_avx2;
+    case Isa::avx512: return kernels::sync_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+    case Isa::neon: return kernels::sync_neon;
+#endif
+    default: return kernels::sync_scalar;
+    }
+}
+
+constexpr std::size_t kN = 64;
+constexpr std::size_t kStf = Preamble80211::stf_length;
+constexpr std::size_t kLtf = Preamble80211::ltf_symbol;
+
+// Coarse CFO: lag-16 products over kCoarseSpan samples ending kCoarseGap
+// before the end of the metric plateau, which falls somewhat after the
+// last L-STF sample.
+constexpr std::size_t kCoarseSpan = 96;
+constexpr std::size_t kCoarseGap = 20;
+// Where the first long symbol may start, relative to the plateau end. At
+// high SNR the metric falls about (1 - sqrt(threshold)) * window samples
+// after the L-STF, which is 32 samples before the long symbol; at low SNR
+// noise cuts the plateau short, up to a few dozen samples earlier. The
+// search must not reach back to 64 samples before the long symbol, where
+// the guard and the first symbol make a weaker but real match.
+constexpr std::size_t kSearchBefore = 8;
+constexpr std::size_t kSearchAfter = 88;
+// A metric run this long is a periodic interferer, not an L-STF.
+constexpr std::size_t kMaxRun = 4 * kStf;
+
+struct PreambleTable {
+    std::array<cf32, Preamble80211::length> samples{};
+
+    PreambleTable() {
+        // 17.3.3: subcarriers -26..26.
+        constexpr int kShort[53] = {0, 0,  1, 0, 0, 0, -1, 0, 0, 0, 1, 0, 0, 0, -1, 0, 0, 0,
+                                    -1, 0, 0, 0, 1, 0, 0, 0, 0,  0, 0, 0, -1, 0, 0, 0, -1, 0,
+                                    0, 0, 1, 0, 0, 0, 1,  0, 0, 0, 1, 0, 0, 0, 1, 0, 0};
+        constexpr int kLong[53] = {1,  1,  -1, -1, 1,  1,  -1, 1,  -1, 1,  1,  1,  1, 1,
+                                   1,  -1, -1, 1,  1,  -1, 1,  -1, 1,  1,  1,  1,  0, 1,
+                                   -1, -1, 1,  1,  -1, 1,  -1, 1,  -1, -1, -1, -1, -1, 1,
+                                   1,  -1, -1, 1,  -1, 1,  -1, 1,  1,  1,  1};
+        // Unit average power over the 52 used subcarriers, as the modulator;
+        // the short symbol's 12 subcarriers carry sqrt(13/6) (1 + j).
+        const double scale = 1.0 / std::sqrt(52.0);
+        const double short_gain = std::sqrt(13.0 / 6.0);
+        std::array<cd, kN> stf{}, ltf{};
+        for (std::size_t n = 0; n < kN; ++n) {
+            for (int k = -26; k <= 26; ++k) {
+                const cd w = std::polar(1.0, 2.0 * std::numbers::pi * double(k) * double(n) /
+                                                 double(kN));
+                stf[n] += double(kShort[k + 26]) * short_gain * cd(1.0, 1.0) * w;
+                ltf[n] += double(kLong[k + 26]) * w;
+            }
+        }
+        std::size_t i = 0;
+        for (std::size_t n = 0; n < kStf; ++n) {
+            samples[i++] = cf32(stf[n % kN] * scale);
+        }
+        for (std::size_t n = 0; n < Preamble80211::ltf_guard; ++n) {
+            samples[i++] = cf32(ltf[kN - Preamble80211::ltf_guard + n] * scale);
+        }
+        for (std::size_t n = 0; n < 2 * kLtf; ++n) {
+            samples[i++] = cf32(ltf[n % kN] * scale);
+        }
+    }
+};
+
+/// out[k] = x[k] exp(-j 2 pi cfo (k + first)), from the NCO of
+/// fast_math.hpp: the phase accumulates exactly, so nothing drifts over a
+/// long payload.
+void derotate(const cf32* x, std::size_t n, double cfo, double first, cf32* out) noexcept {
+    nco_mix(std::span<const cf32>(x, n), nco_phase(-cfo * first), nco_phase(-cfo),
+            std::span<cf32>(out, n));
+}
+
+/// Angle of an accumulated correlation, in radians.
+double angle(cd v) noexcept { return fast_atan2(float(v.imag()), float(v.real())); }
+
+cd correlate_ltf(const cf32* y, std::span<const cf32> ltf) noexcept {
+    cd acc = 0.0;
+    for (std::size_t n = 0; n < ltf.size(); ++n) {
+        acc += std::conj(cd(ltf[n])) * cd(y[n]);
+    }
+    return acc;
+}
+
+double energy(const cf32* y, std::size_t n) noexcept {
+    double e = 0.0;
+    for (std::size_t k = 0; k < n; ++k) {
+        e += double(std::norm(y[k]));
+    }
+    return e;
+}
+
+}  // namespace
+
+std::span<const cf32> Preamble80211::samples() {
+    static const PreambleTable table;
+    return table.samples;
+}
+
+PacketSync::PacketSync(const SyncConfig& config) : PacketSync(config, active_isa()) {}
+
+PacketSync::PacketSync(const SyncConfig& config, Isa isa)
+    : kernels_(&sync_kernels_for(isa)), config_(config), pad_(config.window + kLag) {
+    if (config.payload_samples == 0) {
+        throw std::invalid_argument("PacketSync: payload_samples must be > 0");
+    }
+    if (config.window < kLag || config.window > kStf - kLag) {
+        throw std::invalid_argument("PacketSync: window must be 16..144 samples");
+    }
+    if (!(config.threshold > 0.0f && config.threshold < 1.0f) ||
+        !(config.ltf_threshold >= 0.0f && config.ltf_threshold <= 1.0f)) {
+        throw std::invalid_argument("PacketSync: thresholds must be in (0, 1)");
+    }
+    if (config.plateau == 0 || config.plateau >= kMaxRun) {
+        throw std::invalid_argument("PacketSync: plateau must be 1..639 samples");
+    }
+    c_re_.resize(config.window + kChunk);
+    c_im_.resize(config.window + kChunk);
+    e_.resize(config.window + kChunk);
+    p_re_.resize(kChunk);
+    p_im_.resize(kChunk);
+    r_.resize(kChunk);
+    metric_.resize(kChunk);
+    reset();
+}
+
+void PacketSync::reset() {
+    samples_.assign(pad_, cf32{});
+    base_ = 0;
+    end_ = pad_;
+    pending_ = false;
+    detections_ = 0;
+    false_alarms_ = 0;
+    restart(pad_);
+}
+
+void PacketSync::restart(std::uint64_t from) {
+    const std::size_t w = config_.window;
+    assert(from >= base_ + w + kLag && from <= end_);
+    kernels_->lagged_products(reinterpret_cast<const float*>(at(from - w - kLag)), w, kLag,
+                              c_re_.data(), c_im_.data(), e_.data());
+    resync();
+    next_ = from;
+    in_run_ = false;
+}
+
+void PacketSync::resync() noexcept {
+    // Direct sums of the window, oldest first, replacing the recursion's.
+    float re = 0.0f, im = 0.0f, e = 0.0f;
+    for (std::size_t k = 0; k < config_.window; ++k) {
+        re += c_re_[k];
+        im += c_im_[k];
+        e += e_[k];
+    }
+    carry_re_ = re;
+    carry_im_ = im;
+    carry_e_ = e;
+}
+
+void PacketSync::correlate() {
+    const std::size_t w = config_.window;
+    while (!pending_ && next_ < end_) {
+        // A chunk cut short by the end of the input stops on a multiple of
+        // the scan width, so the window sums round the same way however the
+        // stream is split into process() calls.
+        std::size_t n = std::size_t(std::min<std::uint64_t>(kChunk, kResync - next_ % kResync));
+        if (end_ - next_ < n) {
+            n = std::size_t(end_ - next_) / kernels::kScanLanes * kernels::kScanLanes;
+            if (n == 0) {
+                return;
+            }
+        }
+        kernels_->lagged_products(reinterpret_cast<const float*>(at(next_ - kLag)), n, kLag,
+                                  c_re_.data() + w, c_im_.data() + w, e_.data() + w);
+        carry_re_ = kernels_->window_sums(c_re_.data() + w, n, w, carry_re_, p_re_.data());
+        carry_im_ = kernels_->window_sums(c_im_.data() + w, n, w, carry_im_, p_im_.data());
+        carry_e_ = kernels_->window_sums(e_.data() + w, n, w, carry_e_, r_.data());
+        kernels_->metric(p_re_.data(), p_im_.data(), r_.data(), n, metric_.data());
+
+        const float* m = metric_.data();
+        std::size_t i = 0;
+        while (i < n) {
+            if (!in_run_) {
+                i += kernels_->find(m + i, n - i, config_.threshold, true);
+                if (i < n) {
+                    in_run_ = true;
+                    run_start_ = next_ + i;
+                }
+                continue;
+            }
+            i += kernels_->find(m + i, n - i, config_.threshold, false);
+            if (i == n) {
+                break;
+            }
+            in_run_ = false;
+            const std::uint64_t run = next_ + i - run_start_;
+            if (run >= config_.plateau && run <= kMaxRun) {
+                // The products past i are stale from here; the correlator
+                // restarts once the detection is resolved.
+                pending_ = true;
+                run_end_ = next_ + i;
+                next_ += i;
+                return;
+            }
+        }
+        std::copy(c_re_.begin() + std::ptrdiff_t(n), c_re_.begin() + std::ptrdiff_t(n + w),
+                  c_re_.begin());
+        std::copy(c_im_.begin() + std::ptrdiff_t(n), c_im_.begin() + std::ptrdiff_t(n + w),
+                  c_im_.begin());
+        std::copy(e_.begin() + std::ptrdiff_t(n), e_.begin() + std::ptrdiff_t(n + w),
+                  e_.begin());
+        next_ += n;
+        if (next_ % kResync == 0) {
+            resync();
+        }
+    }
+}
+
+bool PacketSync::synchronise(const Handler& on_frame) {
+    pending_ = false;
+    const std::span<const cf32> ltf = Preamble80211::ltf();
+    const double ltf_energy = energy(ltf.data(), kLtf);
+
+    // A plateau this close to the start of the stream has less L-STF behind
+    // it than the coarse CFO reads: the stream began partway through a
+    // preamble, or inside something else.
+    const std::uint64_t history = kCoarseGap + kCoarseSpan + kLag;
+    if (run_end_ < std::max<std::uint64_t>(base_, pad_) + history) {
+        ++false_alarms_;
+        restart(run_end_);
+        return false;
+    }
+
+    // Coarse CFO from the tail of the L-STF: +-1/32 cycles per sample.
+    cd p = 0.0;
+    for (std::uint64_t k = run_end_ - kCoarseGap - kCoarseSpan; k < run_end_ - kCoarseGap; ++k) {
+        p += std::conj(cd(*at(k - kLag))) * cd(*at(k));
+    }
+    const double coarse = angle(p) / (2.0 * std::numbers::pi * double(kLag));
+
+    // Fine timing: the offset whose two long symbols best match the
+    // reference, on coarse-corrected samples.
+    const std::uint64_t first = run_end_ - kSearchBefore;
+    const std::size_t offsets = kSearchBefore + kSearchAfter + 1;
+    frame_.resize(std::max(offsets - 1 + 2 * kLtf, 2 * kLtf + config_.payload_samples));
+    derotate(at(first), offsets - 1 + 2 * kLtf, coarse, 0.0, frame_.data());
+    std::size_t best = 0;
+    double best_score = -1.0;
+    cd c1, c2;
+    for (std::size_t t = 0; t < offsets; ++t) {
+        const cd a = correlate_ltf(&frame_[t], ltf);
+        const cd b = correlate_ltf(&frame_[t + kLtf], ltf);
+        const double score = std::norm(a) + std::norm(b);
+        if (score > best_score) {
+            best_score = score;
+            best = t;
+            c1 = a;
+            c2 = b;
+        }
+    }
+    const double e1 = energy(&frame_[best], kLtf);
+    const double e2 = energy(&frame_[best + kLtf], kLtf);
+    const double norm = std::sqrt(ltf_energy) * (std::sqrt(e1) + std::sqrt(e2));
+    const float quality = norm > 0.0 ? float((std::abs(c1) + std::abs(c2)) / norm) : 0.0f;
+    // A long symbol less than a preamble into the stream leaves no room for
+    // the frame's start.
+    const std::uint64_t ltf_at = first + best;
+    if (quality < config_.ltf_threshold || ltf_at < pad_ + Preamble80211::ltf_start) {
+        ++false_alarms_;
+        restart(run_end_);
+        return false;
+    }
+
+    // Fine CFO from the repeated long symbol: +-1/128 cycles per sample.
+    cd f = 0.0;
+    for (std::size_t k = 0; k < kLtf; ++k) {
+        f += std::conj(cd(frame_[best + k])) * cd(frame_[best + kLtf + k]);
+    }
+    SyncDetection d;
+    d.cfo = coarse + angle(f) / (2.0 * std::numbers::pi * double(kLtf));
+
+    // Derotate the long symbols and the payload with the final estimate,
+    // phase referenced to the first long symbol, and take the flat gain.
+    derotate(at(ltf_at), 2 * kLtf + config_.payload_samples, d.cfo, 0.0, frame_.data());
+    const cd g = (correlate_ltf(&frame_[0], ltf) + correlate_ltf(&frame_[kLtf], ltf)) /
+                 (2.0 * ltf_energy);
+    const cf32 inv = cf32(1.0 / g);
+    cf32* payload = &frame_[2 * kLtf];
+    for (std::size_t k = 0; k < config_.payload_samples; ++k) {
+        payload[k] *= inv;
+    }
+    d.start = ltf_at - Preamble80211::ltf_start - pad_;
+    d.gain = cf32(g);
+    d.quality = quality;
+    ++detections_;
+    if (on_frame) {
+        on_frame(d, std::span<const cf32>(payload, config_.payload_samples));
+    }
+    restart(ltf_at + 2 * kLtf + config_.payload_samples);
+    return true;
+}
+
+std::uint64_t PacketSync::keep_from() const noexcept {
+    // A plateau that ends at or after next_ reaches back for the coarse
+    // CFO; a restart reaches back for its window of products.
+    const std::uint64_t back = std::max<std::uint64_t>(kCoarseGap + kCoarseSpan + kLag, pad_);
+    const std::uint64_t anchor = pending_ ? run_end_ : next_;
+    return anchor > base_ + back ? anchor - back : base_;
+}
+
+std::size_t PacketSync::process(std::span<const cf32> in, const Handler& on_frame) {
+    samples_.insert(samples_.end(), in.begin(), in.end());
+    end_ += in.size();
+    const std::uint64_t needed = kSearchAfter + 2 * kLtf + config_.payload_samples;
+    std::size_t frames = 0;
+    for (;;) {
+        correlate();
+        if (!pending_ || end_ < run_end_ + needed) {
+            break;
+        }
+        frames += synchronise(on_frame) ? 1 : 0;
+    }
+    // Drop what no later step can reach, once it is worth the move.
+    const std::uint64_t dead = keep_from() - base_;
+    if (dead >= kChunk && 2 * dead >= samples_.size()) {
+        samples_.erase(samples_.begin(), samples_.begin() + std::ptrdiff_t(dead));
+        base_ += dead;
+    }
+    return frames;
+}
+
+}  // namespace dcomm
@@ -0,0 +1,151 @@
+#include "dcomm/thread_pool.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace dcomm {
+
+namespace {
+
+constexpr std::uint64_t pack(std::uint32_t begin, std::uint32_t end) noexcept {
+    return std::uint64_t(begin) << 32 | end;
+}
+constexpr std::uint32_t range_begin(std::uint64_t r) noexcept { return std::uint32_t(r >> 32); }
+constexpr std::uint32_t range_end(std::uint64_t r) noexcept { return std::uint32_t(r); }
+
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(std::size_t workers) {
+    if (workers == 0) {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    slots_storage_ = std::make_unique<Slot[]>(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        slots_.push_back(&slots_storage_[i]);
+    }
+    threads_.reserve(workers - 1);
+    for (std::size_t i = 1; i < workers; ++i) {
+        threads_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_.notify_all();
+    for (std::thread& t : threads_) {
+        t.join();
+    }
+}
+
+void WorkStealingPool::run(std::size_t count,
+                           const std::function<void(std::size_t, std::size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+    if (count > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("WorkStealingPool::run: too many items");
+    }
+    const std::size_t n = slots_.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint32_t begin = std::uint32_t(count * i / n);
+        const std::uint32_t end = std::uint32_t(count * (i + 1) / n);
+        slots_[i]->range.store(pack(begin, end), std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        running_ = n;
+        ++generation_;
+    }
+    start_.notify_all();
+    work(0);
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return running_ == 0; });
+    job_ = nullptr;
+}
+
+void WorkStealingPool::worker_loop(std::size_t id) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+        }
+        work(id);
+    }
+}
+
+void WorkStealingPool::work(std::size_t id) {
+    const auto& fn = *job_;
+    for (;;) {
+        std::uint32_t index;
+        while (pop(id, index)) {
+            fn(index, id);
+        }
+        if (!steal(id)) {
+            break;
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--running_ == 0) {
+        done_.notify_one();
+    }
+}
+
+bool WorkStealingPool::pop(std::size_t id, std::uint32_t& index) noexcept {
+    std::atomic<std::uint64_t>& slot = slots_[id]->range;
+    std::uint64_t r = slot.load(std::memory_order_acquire);
+    while (range_begin(r) < range_end(r)) {
+        if (slot.compare_exchange_weak(r, pack(range_begin(r) + 1, range_end(r)),
+                                       std::memory_order_acq_rel)) {
+            index = range_begin(r);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingPool::steal(std::size_t id) noexcept {
+    // Indices only ever move between ranges, never back, so a range value
+    // cannot reappear and the CAS below is ABA-free. Once every range reads
+    // empty no work is left unowned.
+    const std::size_t n = slots_.size();
+    for (;;) {
+        std::size_t victim = n;
+        std::uint32_t best = 0;
+        for (std::size_t k = 1; k < n; ++k) {
+            const std::size_t v = (id + k) % n;
+            const std::uint64_t r = slots_[v]->range.load(std::memory_order_relaxed);
+            const std::uint32_t left = range_end(r) - std::min(range_end(r), range_begin(r));
+            if (left > best) {
+                best = left;
+                victim = v;
+            }
+        }
+        if (victim == n) {
+            return false;
+        }
+        std::atomic<std::uint64_t>& slot = slots_[victim]->range;
+        std::uint64_t r = slot.load(std::memory_order_acquire);
+        const std::uint32_t begin = range_begin(r);
+        const std::uint32_t end = range_end(r);
+        if (begin >= end) {
+            continue;
+        }
+        const std::uint32_t mid = end - (end - begin + 1) / 2;
+        if (slot.compare_exchange_strong(r, pack(begin, mid), std::memory_order_acq_rel)) {
+            slots_[id]->range.store(pack(mid, end), std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+}  // namespace dcomm
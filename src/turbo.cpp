@@ -0,0 +1,348 @@
+#include "dcomm/turbo.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+#include "dcomm/crc.hpp"
+#include "kernels/turbo_kernels.hpp"
+
+namespace dcomm {
+
+namespace {
+
+struct QppParams {
+    std::uint16_t k;
+    std::uint16_t f1;
+    std::uint16_t f2;
+};
+
+// TS 36.212 Table 5.1.3-3.
+constexpr QppParams kQppTable[] = {
+    {40, 3, 10}, {48, 7, 12}, {56, 19, 42}, {64, 7, 16}, {72, 7, 18}, {80, 11, 20},
+    {88, 5, 22}, {96, 11, 24}, {104, 7, 26}, {112, 41, 84}, {120, 103, 90}, {128, 15, 32},
+    {136, 9, 34}, {144, 17, 108}, {152, 9, 38}, {160, 21, 120}, {168, 101, 84}, {176, 21, 44},
+    {184, 57, 46}, {192, 23, 48}, {200, 13, 50}, {208, 27, 52}, {216, 11, 36}, {224, 27, 56},
+    {232, 85, 58}, {240, 29, 60}, {248, 33, 62}, {256, 15, 32}, {264, 17, 198}, {272, 33, 68},
+    {280, 103, 210}, {288, 19, 36}, {296, 19, 74}, {304, 37, 76}, {312, 19, 78}, {320, 21, 120},
+    {328, 21, 82}, {336, 115, 84}, {344, 193, 86}, {352, 21, 44}, {360, 133, 90}, {368, 81, 46},
+    {376, 45, 94}, {384, 23, 48}, {392, 243, 98}, {400, 151, 40}, {408, 155, 102}, {416, 25, 52},
+    {424, 51, 106}, {432, 47, 72}, {440, 91, 110}, {448, 29, 168}, {456, 29, 114}, {464, 247, 58},
+    {472, 29, 118}, {480, 89, 180}, {488, 91, 122}, {496, 157, 62}, {504, 55, 84}, {512, 31, 64},
+    {528, 17, 66}, {544, 35, 68}, {560, 227, 420}, {576, 65, 96}, {592, 19, 74}, {608, 37, 76},
+    {624, 41, 234}, {640, 39, 80}, {656, 185, 82}, {672, 43, 252}, {688, 21, 86}, {704, 155, 44},
+    {720, 79, 120}, {736, 139, 92}, {752, 23, 94}, {768, 217, 48}, {784, 25, 98}, {800, 17, 80},
+    {816, 127, 102}, {832, 25, 52}, {848, 239, 106}, {864, 17, 48}, {880, 137, 110}, {896, 215, 112},
+    {912, 29, 114}, {928, 15, 58}, {944, 147, 118}, {960, 29, 60}, {976, 59, 122}, {992, 65, 124},
+    {1008, 55, 84}, {1024, 31, 64}, {1056, 17, 66}, {1088, 171, 204}, {1120, 67, 140}, {1152, 35, 72},
+    {1184, 19, 74}, {1216, 39, 76}, {1248, 19, 78}, {1280, 199, 240}, {1312, 21, 82}, {1344, 211, 252},
+    {1376, 21, 86}, {1408, 43, 88}, {1440, 149, 60}, {1472, 45, 92}, {1504, 49, 846}, {1536, 71, 48},
+    {1568, 13, 28}, {1600, 17, 80}, {1632, 25, 102}, {1664, 183, 104}, {1696, 55, 954}, {1728, 127, 96},
+    {1760, 27, 110}, {1792, 29, 112}, {1824, 29, 114}, {1856, 57, 116}, {1888, 45, 354}, {1920, 31, 120},
+    {1952, 59, 610}, {1984, 185, 124}, {2016, 113, 420}, {2048, 31, 64}, {2112, 17, 66}, {2176, 171, 136},
+    {2240, 209, 420}, {2304, 253, 216}, {2368, 367, 444}, {2432, 265, 456}, {2496, 181, 468}, {2560, 39, 80},
+    {2624, 27, 164}, {2688, 127, 504}, {2752, 143, 172}, {2816, 43, 88}, {2880, 29, 300}, {2944, 45, 92},
+    {3008, 157, 188}, {3072, 47, 96}, {3136, 13, 28}, {3200, 111, 240}, {3264, 443, 204}, {3328, 51, 104},
+    {3392, 51, 212}, {3456, 451, 192}, {3520, 257, 220}, {3584, 57, 336}, {3648, 313, 228}, {3712, 271, 232},
+    {3776, 179, 236}, {3840, 331, 120}, {3904, 363, 244}, {3968, 375, 248}, {4032, 127, 168}, {4096, 31, 64},
+    {4160, 33, 130}, {4224, 43, 264}, {4288, 33, 134}, {4352, 477, 408}, {4416, 35, 138}, {4480, 233, 280},
+    {4544, 357, 142}, {4608, 337, 480}, {4672, 37, 146}, {4736, 71, 444}, {4800, 71, 120}, {4864, 37, 152},
+    {4928, 39, 462}, {4992, 127, 234}, {5056, 39, 158}, {5120, 39, 80}, {5184, 31, 96}, {5248, 113, 902},
+    {5312, 41, 166}, {5376, 251, 336}, {5440, 43, 170}, {5504, 21, 86}, {5568, 43, 174}, {5632, 45, 176},
+    {5696, 45, 178}, {5760, 161, 120}, {5824, 89, 182}, {5888, 323, 184}, {5952, 47, 186}, {6016, 23, 94},
+    {6080, 47, 190}, {6144, 263, 480},
+};
+
+const QppParams* find_qpp(std::size_t k) noexcept {
+    const auto it = std::lower_bound(std::begin(kQppTable), std::end(kQppTable), k,
+                                     [](const QppParams& p, std::size_t v) { return p.k < v; });
+    return it != std::end(kQppTable) && it->k == k ? it : nullptr;
+}
+
+/// One RSC step from `state` (d1 d2 d3, newest in bit 2); returns the
+/// parity and advances the state.
+inline unsigned rsc_step(unsigned& state, unsigned u) noexcept {
+    const unsigned d1 = (state >> 2) & 1u;
+    const unsigned d2 = (state >> 1) & 1u;
+    const unsigned d3 = state & 1u;
+    const unsigned a = u ^ d2 ^ d3;
+    state = a << 2 | state >> 1;
+    return a ^ d1 ^ d3;
+}
+
+/// Input that drives the feedback to zero, used by the tail steps.
+inline unsigned rsc_tail_input(unsigned state) noexcept {
+    return ((state >> 1) ^ state) & 1u;
+}
+
+/// Sub-blocks are at least this many steps long.
+constexpr std::size_t kMinWindow = 32;
+constexpr std::size_t kMaxWindows = 32;
+/// Target mean magnitude of the quantised channel LLRs.
+constexpr float kSoftMean = 16.0f;
+constexpr std::size_t kScaleSamples = 1024;
+/// Start metric of the states a window boundary rules out.
+constexpr std::int16_t kUnreachable = -8192;
+
+const kernels::TurboKernels& turbo_kernels_for(Isa isa) {
+    if (!isa_available(isa)) {
+        throw std::invalid_argument("TurboDecoder: ISA not available on this CPU");
+    }
+    switch (isa) {
+#if defined(DCOMM_KERNELS_X86)
+    case Isa::avx2: return kernels::turbo_avx2;
+    case Isa::avx512: return kernels::turbo_avx512;
+#endif
+#if defined(DCOMM_KERNELS_NEON)
+    case Isa::neon: return kernels::turbo_neon;
+#endif
+    default: return kernels::turbo_scalar;
+    }
+}
+
+/// Backward metrics at the start of a tail given its systematic and parity
+/// LLRs; the tail always ends in state 0.
+void tail_metrics(const std::int16_t (&x)[3], const std::int16_t (&z)[3],
+                  std::int16_t* out) noexcept {
+    int b[8];
+    std::fill(std::begin(b), std::end(b), int(kUnreachable));
+    b[0] = 0;
+    for (unsigned i = 3; i-- > 0;) {
+        int next[8];
+        for (unsigned s = 0; s < 8; ++s) {
+            unsigned state = s;
+            const unsigned u = rsc_tail_input(s);
+            const unsigned p = rsc_step(state, u);
+            next[s] = b[state] - (u ? x[i] : 0) - (p ? z[i] : 0);
+        }
+        for (unsigned s = 0; s < 8; ++s) {
+            b[s] = std::max(next[s] - next[0], int(kUnreachable));
+        }
+    }
+    for (unsigned s = 0; s < 8; ++s) {
+        out[s] = std::int16_t(b[s]);
+    }
+}
+
+}  // namespace
+
+QppInterleaver::QppInterleaver(std::size_t k) : k_(k) {
+    const QppParams* p = find_qpp(k);
+    if (p == nullptr) {
+        throw std::invalid_argument("QppInterleaver: unsupported codeblock size");
+    }
+    f1_ = p->f1;
+    f2_ = p->f2;
+}
+
+bool QppInterleaver::supported(std::size_t k) noexcept {
+    return find_qpp(k) != nullptr;
+}
+
+void turbo_encode(const QppInterleaver& pi, std::span<const std::uint8_t> info,
+                  std::span<std::uint8_t> coded) noexcept {
+    const std::size_t k = pi.size();
+    assert(info.size() == k && coded.size() >= turbo_coded_bits(k));
+    std::uint8_t* d0 = coded.data();
+    std::uint8_t* d1 = d0 + k + 4;
+    std::uint8_t* d2 = d1 + k + 4;
+    unsigned s1 = 0;
+    unsigned s2 = 0;
+    for (std::size_t i = 0; i < k; ++i) {
+        d0[i] = info[i] & 1u;
+        d1[i] = std::uint8_t(rsc_step(s1, info[i] & 1u));
+        d2[i] = std::uint8_t(rsc_step(s2, info[pi(i)] & 1u));
+    }
+    // Tail bits x, z of each encoder, multiplexed over the three streams.
+    std::uint8_t x[2][3];
+    std::uint8_t z[2][3];
+    for (unsigned i = 0; i < 3; ++i) {
+        x[0][i] = std::uint8_t(rsc_tail_input(s1));
+        z[0][i] = std::uint8_t(rsc_step(s1, x[0][i]));
+        x[1][i] = std::uint8_t(rsc_tail_input(s2));
+        z[1][i] = std::uint8_t(rsc_step(s2, x[1][i]));
+    }
+    for (unsigned e = 0; e < 2; ++e) {
+        const std::size_t t = k + 2 * e;
+        d0[t] = x[e][0];
+        d1[t] = z[e][0];
+        d2[t] = x[e][1];
+        d0[t + 1] = z[e][1];
+        d1[t + 1] = x[e][2];
+        d2[t + 1] = z[e][2];
+    }
+}
+
+TurboDecoder::TurboDecoder(std::size_t k, TurboDecoderOptions options, Isa isa)
+    : pi_(k), options_(options), kernels_(&turbo_kernels_for(isa)) {
+    if (options_.max_iterations == 0) {
+        throw std::invalid_argument("TurboDecoder: max_iterations must be > 0");
+    }
+    windows_ = 1;
+    while (2 * windows_ <= kMaxWindows && k % (2 * windows_) == 0 &&
+           k / (2 * windows_) >= kMinWindow) {
+        windows_ *= 2;
+    }
+    steps_ = k / windows_;
+    lanes_ = align_up(windows_, kernels::kTurboLaneAlign);
+    slots_ = steps_ * lanes_;
+
+    const auto slot = [&](std::size_t i) { return (i % steps_) * lanes_ + i / steps_; };
+    // Padding lanes map onto themselves and stay zero throughout.
+    map12_.resize(slots_);
+    map21_.resize(slots_);
+    for (std::size_t s = 0; s < slots_; ++s) {
+        map12_[s] = map21_[s] = std::uint32_t(s);
+    }
+    for (std::size_t j = 0; j < k; ++j) {
+        map12_[slot(j)] = std::uint32_t(slot(pi_(j)));
+        map21_[slot(pi_(j))] = std::uint32_t(slot(j));
+    }
+
+    // A block with its CRC appended satisfies B(x) = 0 mod g(x), which is the XOR of
+    // x^(k-1-i) mod g(x) over its set bits i in any order.
+    syn1_ = make_aligned_array<std::uint32_t>(slots_);
+    syn2_ = make_aligned_array<std::uint32_t>(slots_);
+    if (options_.crc != TurboCrc::none) {
+        const std::uint32_t poly = options_.crc == TurboCrc::crc24a ? kCrc24aPoly : kCrc24bPoly;
+        std::uint32_t r = 1;
+        for (std::size_t i = k; i-- > 0;) {
+            syn1_[slot(i)] = r;
+            syn2_[map21_[slot(i)]] = r;
+            r = ((r << 1) ^ ((r >> 23) & 1u ? poly : 0u)) & 0xffffff;
+        }
+    }
+
+    soft_ = make_aligned_array<std::int16_t>(turbo_coded_bits(k));
+    sys1_ = make_aligned_array<std::int16_t>(slots_);
+    par1_ = make_aligned_array<std::int16_t>(slots_);
+    sys2_ = make_aligned_array<std::int16_t>(slots_);
+    par2_ = make_aligned_array<std::int16_t>(slots_);
+    apriori_ = make_aligned_array<std::int16_t>(slots_);
+    ext1_ = make_aligned_array<std::int16_t>(slots_);
+    ext2_ = make_aligned_array<std::int16_t>(slots_);
+    alpha1_ = make_aligned_array<std::int16_t>(8 * lanes_);
+    beta1_ = make_aligned_array<std::int16_t>(8 * lanes_);
+    alpha2_ = make_aligned_array<std::int16_t>(8 * lanes_);
+    beta2_ = make_aligned_array<std::int16_t>(8 * lanes_);
+    scratch_ = make_aligned_array<std::int16_t>(8 * slots_);
+    hard_ = make_aligned_array<std::uint8_t>(slots_);
+}
+
+TurboDecoder::~TurboDecoder() = default;
+TurboDecoder::TurboDecoder(TurboDecoder&&) noexcept = default;
+TurboDecoder& TurboDecoder::operator=(TurboDecoder&&) noexcept = default;
+
+void TurboDecoder::load(std::span<const float> llrs) {
+    // Max-log-MAP is scale invariant: normalise the soft values to a fixed
+    // mean magnitude whatever the channel SNR.
+    const std::size_t stride = std::max<std::size_t>(1, llrs.size() / kScaleSamples);
+    float sum = 0.0f;
+    std::size_t samples = 0;
+    for (std::size_t i = 0; i < llrs.size(); i += stride, ++samples) {
+        sum += std::fabs(llrs[i]);
+    }
+    const float scale = sum > 0.0f ? kSoftMean * float(samples) / sum : 1.0f;
+    kernels_->quantize(llrs.data(), llrs.size(), scale, soft_.get());
+
+    const std::size_t k = pi_.size();
+    const std::int16_t* d0 = soft_.get();
+    const std::int16_t* d1 = d0 + k + 4;
+    const std::int16_t* d2 = d1 + k + 4;
+    for (std::size_t l = 0; l < windows_; ++l) {
+        for (std::size_t t = 0; t < steps_; ++t) {
+            const std::size_t i = l * steps_ + t;
+            const std::size_t s = t * lanes_ + l;
+            sys1_[s] = d0[i];
+            par1_[s] = d1[i];
+            par2_[s] = d2[i];
+        }
+    }
+    for (std::size_t s = 0; s < slots_; ++s) {
+        sys2_[s] = sys1_[map12_[s]];
+    }
+    tail_metrics({d0[k], d2[k], d1[k + 1]}, {d1[k], d0[k + 1], d2[k + 1]}, tail1_);
+    tail_metrics({d0[k + 2], d2[k + 2], d1[k + 3]}, {d1[k + 2], d0[k + 3], d2[k + 3]}, tail2_);
+}
+
+void TurboDecoder::exchange_boundaries(std::int16_t* alpha, std::int16_t* beta,
+                                       const std::int16_t* tail) noexcept {
+    for (unsigned s = 0; s < 8; ++s) {
+        std::int16_t* a = alpha + s * lanes_;
+        std::int16_t* b = beta + s * lanes_;
+        std::copy_backward(a, a + windows_ - 1, a + windows_);
+        a[0] = s == 0 ? 0 : kUnreachable;
+        std::copy(b + 1, b + windows_, b);
+        b[windows_ - 1] = tail[s];
+    }
+}
+
+void TurboDecoder::output(bool interleaved, std::span<std::uint8_t> info) const noexcept {
+    for (std::size_t l = 0; l < windows_; ++l) {
+        for (std::size_t t = 0; t < steps_; ++t) {
+            const std::size_t s = t * lanes_ + l;
+            info[l * steps_ + t] = hard_[interleaved ? map21_[s] : s];
+        }
+    }
+}
+
+TurboResult TurboDecoder::decode(std::span<const float> llrs, std::span<std::uint8_t> info) {
+    assert(llrs.size() == turbo_coded_bits(k()) && info.size() == k());
+    load(llrs);
+    std::fill_n(apriori_.get(), slots_, std::int16_t(0));
+    for (std::int16_t* m : {alpha1_.get(), beta1_.get(), alpha2_.get(), beta2_.get()}) {
+        std::fill_n(m, 8 * lanes_, std::int16_t(0));
+    }
+
+    const bool crc = options_.crc != TurboCrc::none;
+    TurboResult result;
+    for (unsigned it = 0; it < options_.max_iterations; ++it) {
+        exchange_boundaries(alpha1_.get(), beta1_.get(), tail1_);
+        kernels_->siso(sys1_.get(), par1_.get(), apriori_.get(), steps_, lanes_, alpha1_.get(),
+                       beta1_.get(), scratch_.get(), ext1_.get(), hard_.get());
+        ++result.half_iterations;
+        if (crc && kernels_->syndrome(hard_.get(), syn1_.get(), slots_) == 0) {
+            result.crc_ok = true;
+            output(false, info);
+            return result;
+        }
+        for (std::size_t s = 0; s < slots_; ++s) {
+            apriori_[s] = ext1_[map12_[s]];
+        }
+
+        exchange_boundaries(alpha2_.get(), beta2_.get(), tail2_);
+        kernels_->siso(sys2_.get(), par2_.get(), apriori_.get(), steps_, lanes_, alpha2_.get(),
+                       beta2_.get(), scratch_.get(), ext2_.get(), hard_.get());
+        ++result.half_iterations;
+        if (crc && kernels_->syndrome(hard_.get(), syn2_.get(), slots_) == 0) {
+            result.crc_ok = true;
+            break;
+        }
+        for (std::size_t s = 0; s < slots_; ++s) {
+            apriori_[s] = ext2_[map21_[s]];
+        }
+    }
+    output(true, info);
+    return result;
+}
+
+TurboBatchDecoder::TurboBatchDecoder(std::size_t k, WorkStealingPool& pool,
+                                     TurboDecoderOptions options)
+    : k_(k), pool_(&pool) {
+    decoders_.reserve(pool.size());
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        decoders_.emplace_back(k, options);
+    }
+}
+
+void TurboBatchDecoder::decode(std::span<const float> llrs, std::span<std::uint8_t> info,
+                               std::span<TurboResult> results) {
+    const std::size_t n = turbo_coded_bits(k_);
+    assert(llrs.size() == results.size() * n && info.size() == results.size() * k_);
+    pool_->run(results.size(), [&](std::size_t i, std::size_t worker) {
+        results[i] = decoders_[worker].decode(llrs.subspan(i * n, n), info.subspan(i * k_, k_));
+    });
+}
+
+}  // namespace dcomm
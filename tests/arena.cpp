@@ -0,0 +1,97 @@
+// FrameArena: aligned bump allocation, reset(), the counted heap fallback,
+// and fixed-point Rx chains (which take scratch in the demodulator and
+// the demapper) sharing one arena sized for the larger of them without
+// ever touching the heap.
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+#include "check.hpp"
+#include "dcomm/arena.hpp"
+#include "dcomm/pipeline.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+using dcomm::test::expect_throws;
+
+bool aligned(const void* p) { return reinterpret_cast<std::uintptr_t>(p) % kCacheLine == 0; }
+
+void bump() {
+    FrameArena arena(1000);
+    expect(arena.capacity() == 1024, "capacity rounds up to whole cache lines");
+    const std::span<float> a = arena.allocate<float>(3);
+    const std::span<cf32> b = arena.allocate<cf32>(20);
+    expect(a.size() == 3 && b.size() == 20 && aligned(a.data()) && aligned(b.data()),
+           "slices are cache-line aligned");
+    expect(reinterpret_cast<std::byte*>(b.data()) - reinterpret_cast<std::byte*>(a.data()) ==
+               std::ptrdiff_t(kCacheLine),
+           "slices are consecutive, padded to a cache line");
+    expect(arena.used() == 64 + 192 && arena.high_water() == arena.used(),
+           "used() counts the padding");
+
+    arena.reset();
+    expect(arena.used() == 0 && arena.high_water() == 256, "reset() keeps the high water");
+    expect(arena.allocate<float>(3).data() == a.data(), "reset() reuses the block");
+    arena.reset();
+
+    const std::span<std::uint64_t> all = arena.allocate<std::uint64_t>(128);
+    expect(arena.used() == 1024 && arena.heap_allocations() == 0, "an exact fit stays in place");
+    const std::span<std::uint64_t> spill = arena.allocate<std::uint64_t>(100);
+    expect(arena.heap_allocations() == 1 && aligned(spill.data()) &&
+               (spill.data() < all.data() || spill.data() >= all.data() + all.size()),
+           "a request that does not fit is served and counted");
+    std::fill(spill.begin(), spill.end(), 7u);
+    expect(arena.used() == 1024 && arena.high_water() == 1024 + 832,
+           "spilled bytes count towards the high water only");
+    arena.reset();
+    arena.allocate<std::uint64_t>(16);
+    expect(arena.heap_allocations() == 1, "the counter is cumulative");
+
+    FrameArena empty(0);
+    expect(empty.allocate<float>(1).size() == 1 && empty.heap_allocations() == 1,
+           "an empty arena spills everything");
+}
+
+void shared_by_chains() {
+    PhyConfig small, large;
+    small.modulation = Modulation::bpsk;
+    large.modulation = Modulation::qam64;
+    large.interleave = true;
+    large.symbols_per_block = 32;
+    using Tx = BasicTxChain<ci16>;
+    using Rx = BasicRxChain<ci16>;
+    FrameArena arena(std::max(Rx::scratch_bytes(small), Rx::scratch_bytes(large)));
+    Tx tx_small(small), tx_large(large);
+    Rx rx_small(small, arena), rx_large(large, arena);
+    std::mt19937 rng(2);
+    for (int b = 0; b < 6; ++b) {
+        Tx& tx = b % 2 ? tx_large : tx_small;
+        Rx& rx = b % 2 ? rx_large : rx_small;
+        BufferView<std::uint64_t> data = tx.acquire_input();
+        for (std::uint64_t& w : data.span()) {
+            w = rng();
+        }
+        rx.process(tx.process(std::move(data)));
+        expect(arena.used() == 0, "process() resets the arena after every block");
+    }
+    expect(arena.heap_allocations() == 0, "an arena sized for the largest chain never spills");
+    expect(arena.high_water() > Rx::scratch_bytes(small) &&
+               arena.high_water() <= Rx::scratch_bytes(large),
+           "scratch_bytes() bounds what each chain takes");
+
+    FrameArena small_arena(Rx::scratch_bytes(small));
+    expect_throws<std::invalid_argument>([&] { Rx rx(large, small_arena); },
+                                         "an arena too small for the configuration");
+}
+
+}  // namespace
+
+int main() {
+    bump();
+    shared_by_chains();
+    return dcomm::test::finish("arena");
+}
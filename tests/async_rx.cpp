@@ -0,0 +1,193 @@
+// Coroutine receiver: the executor's priority queues, short frames
+// overtaking a long one behind a busy worker, frames dropped at the
+// SIGNAL symbol, and every frame delivered intact across several workers.
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/async_rx.hpp"
+#include "dcomm/executor.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+
+/// Occupies a worker from its first resumption until `state` is set to 2.
+Detached hold(Executor& executor, std::atomic<int>& state) {
+    co_await executor.schedule(Priority::high);
+    state = 1;
+    while (state.load() != 2) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+/// Blocks the caller until `hold` is running on the executor's worker.
+void hold_worker(Executor& executor, std::atomic<int>& state) {
+    state = 0;
+    hold(executor, state);
+    while (state.load() != 1) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+Detached record(Executor& executor, Priority p, int tag, std::mutex& m, std::vector<int>& log) {
+    co_await executor.schedule(p);
+    std::lock_guard<std::mutex> lock(m);
+    log.push_back(tag);
+}
+
+void priorities() {
+    std::vector<int> log;
+    std::mutex m;
+    {
+        Executor executor(1);
+        expect(executor.size() == 1 && executor.current_worker() == 1,
+               "threads outside the executor are not workers");
+        std::atomic<int> state;
+        hold_worker(executor, state);
+        record(executor, Priority::low, 30, m, log);
+        record(executor, Priority::normal, 20, m, log);
+        record(executor, Priority::high, 10, m, log);
+        record(executor, Priority::low, 31, m, log);
+        record(executor, Priority::high, 11, m, log);
+        state = 2;
+        const auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < until) {
+            std::lock_guard<std::mutex> lock(m);
+            if (log.size() == 5) {
+                break;
+            }
+        }
+    }
+    expect(log == std::vector<int>{10, 11, 20, 30, 31},
+           "highest queue first, each queue in order");
+}
+
+struct Frame {
+    SignalField signal;
+    PackedBits payload;
+    std::vector<cf32> samples;
+};
+
+Frame make_frame(FrameCodec& codec, const SignalField& signal, std::mt19937& rng) {
+    Frame f{signal, PackedBits(8 * std::size_t(signal.length)), {}};
+    for (std::size_t i = 0; i < f.payload.size(); ++i) {
+        f.payload.set(i, rng() & 1u);
+    }
+    f.samples.resize(frame_samples(signal));
+    codec.encode(signal, f.payload.view(), f.samples);
+    return f;
+}
+
+struct Delivery {
+    std::uint64_t id;
+    SignalField signal;
+    std::size_t errors;
+};
+
+void ordering() {
+    PhyConfig base;
+    base.interleave = true;
+    FrameCodec codec(base);
+    std::mt19937 rng(21);
+    // 200 symbols at 6 Mbit/s, then single-symbol frames at 54.
+    const Frame long_frame = make_frame(codec, {Modulation::bpsk, CodeRate::r1_2, 600}, rng);
+    std::vector<Frame> short_frames;
+    for (std::uint16_t length : {10, 20, 26}) {
+        short_frames.push_back(make_frame(codec, {Modulation::qam64, CodeRate::r3_4, length}, rng));
+    }
+    std::vector<cf32> noise(kSignalSamples * 4);
+    std::normal_distribution<float> g(0.0f, 1.0f);
+    for (cf32& s : noise) {
+        s = cf32(g(rng), g(rng));
+    }
+
+    std::vector<Delivery> delivered;
+    const std::vector<const Frame*> by_id = {&long_frame, nullptr, &short_frames[0], nullptr,
+                                             &short_frames[1], &short_frames[2]};
+    Executor executor(1);
+    AsyncReceiver rx(
+        executor, base,
+        [&](std::uint64_t id, const SignalField& signal, ConstBitSpan payload) {
+            const Frame* f = id < by_id.size() ? by_id[id] : nullptr;
+            const std::size_t errors = f && payload.size() == f->payload.size()
+                                           ? count_bit_errors(payload, f->payload.view())
+                                           : payload.size() + 1;
+            delivered.push_back({id, signal, errors});
+        },
+        8, 4);
+    std::atomic<int> state;
+    hold_worker(executor, state);
+    rx.submit(long_frame.samples);
+    rx.submit(noise);  // no valid SIGNAL
+    rx.submit(short_frames[0].samples);
+    // Cut short of what its SIGNAL announces.
+    rx.submit(std::span(long_frame.samples).first(long_frame.samples.size() / 2));
+    rx.submit(short_frames[1].samples);
+    rx.submit(short_frames[2].samples);
+    state = 2;
+    rx.drain();
+
+    expect(rx.submitted() == 6 && rx.delivered() == 4 && rx.dropped() == 2,
+           "bad and truncated frames are dropped at the SIGNAL symbol");
+    std::vector<std::uint64_t> order;
+    bool intact = true;
+    for (const Delivery& d : delivered) {
+        order.push_back(d.id);
+        intact = intact && d.errors == 0 && d.signal == by_id[d.id]->signal;
+    }
+    expect(order == std::vector<std::uint64_t>{2, 4, 5, 0},
+           "short frames overtake the long one queued ahead of them");
+    expect(intact, "delivered payloads match what was sent");
+}
+
+void many_workers() {
+    PhyConfig base;
+    FrameCodec codec(base);
+    std::mt19937 rng(22);
+    const Modulation mods[] = {Modulation::bpsk, Modulation::qpsk, Modulation::qam16,
+                               Modulation::qam64};
+    std::vector<Frame> frames;
+    for (int i = 0; i < 40; ++i) {
+        const Modulation m = mods[rng() % 4];
+        const CodeRate r = m == Modulation::qam64 ? CodeRate::r2_3 : CodeRate::r1_2;
+        frames.push_back(make_frame(codec, {m, r, std::uint16_t(1 + rng() % 300)}, rng));
+    }
+    std::map<std::uint64_t, std::size_t> errors;
+    Executor executor(3);
+    {
+        AsyncReceiver rx(
+            executor, base,
+            [&](std::uint64_t id, const SignalField&, ConstBitSpan payload) {
+                errors[id] = payload.size() == frames[id].payload.size()
+                                 ? count_bit_errors(payload, frames[id].payload.view())
+                                 : payload.size() + 1;
+            },
+            4);
+        for (const Frame& f : frames) {
+            rx.submit(f.samples);
+        }
+        // The destructor drains.
+    }
+    bool all = errors.size() == frames.size();
+    for (const auto& [id, e] : errors) {
+        all = all && e == 0;
+    }
+    expect(all, "every frame is delivered once and intact with four in flight");
+}
+
+}  // namespace
+
+int main() {
+    priorities();
+    ordering();
+    many_workers();
+    return dcomm::test::finish("async_rx");
+}
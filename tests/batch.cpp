@@ -0,0 +1,151 @@
+// BatchReceiver: mixed-MCS batches of different lengths decoded error free
+// with and without the pilot equaliser, the parameter-set grouping, the
+// same bits inline and across the pool, and the arena sizing.
+
+#include <complex>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/batch.hpp"
+#include "dcomm/pipeline.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+using dcomm::test::expect_throws;
+
+const McsKey kMcs[] = {
+    {Modulation::bpsk, CodeRate::r1_2, true},   {Modulation::qpsk, CodeRate::r3_4, false},
+    {Modulation::qam16, CodeRate::r1_2, true},  {Modulation::qam64, CodeRate::r2_3, true},
+    {Modulation::qam256, CodeRate::r3_4, false},
+};
+
+/// Transmitted frames of random MCS and 1..3 OFDM symbols, each a stream
+/// of its own, through a flat channel of gain `gain`.
+struct Traffic {
+    std::vector<PhyConfig> configs;
+    std::vector<std::vector<cf32>> samples;
+    std::vector<PackedBits> sent;
+    std::size_t ofdm_symbols = 0;
+    std::set<McsKey> keys;
+
+    Traffic(std::size_t frames, cf32 gain, std::mt19937& rng) {
+        for (std::size_t i = 0; i < frames; ++i) {
+            const McsKey key = kMcs[rng() % std::size(kMcs)];
+            PhyConfig c;
+            c.modulation = key.modulation;
+            c.code_rate = key.code_rate;
+            c.interleave = key.interleave;
+            c.symbols_per_block = 1 + rng() % 3;
+            c.scrambler_seed = std::uint8_t(1 + rng() % 127);
+            TxChain tx(c);
+            BufferView<std::uint64_t> data = tx.acquire_input();
+            const BitSpan bits(data.span(), c.info_bits_per_block());
+            sent.emplace_back(bits.size());
+            for (std::size_t b = 0; b < bits.size(); ++b) {
+                bits.set(b, rng() & 1u);
+                sent.back().set(b, bits[b]);
+            }
+            const BufferView<cf32> out = tx.process(std::move(data));
+            samples.emplace_back(out.begin(), out.end());
+            for (cf32& s : samples.back()) {
+                s *= gain;
+            }
+            configs.push_back(c);
+            ofdm_symbols += c.symbols_per_block;
+            keys.insert(key);
+        }
+    }
+};
+
+/// Decode `t` in one call and return the bits of every frame.
+std::vector<PackedBits> decode(BatchReceiver& rx, const Traffic& t) {
+    std::vector<PackedBits> received;
+    std::vector<BatchFrame> frames;
+    for (std::size_t i = 0; i < t.configs.size(); ++i) {
+        received.emplace_back(t.configs[i].info_bits_per_block());
+    }
+    for (std::size_t i = 0; i < t.configs.size(); ++i) {
+        frames.push_back({t.configs[i], t.samples[i], received[i].view()});
+    }
+    rx.process(frames);
+    return received;
+}
+
+std::size_t errors(const Traffic& t, const std::vector<PackedBits>& received) {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < t.sent.size(); ++i) {
+        n += count_bit_errors(t.sent[i].view(), received[i].view());
+    }
+    return n;
+}
+
+void mixed_batches() {
+    std::mt19937 rng(7);
+    const Traffic t(40, cf32(1.0f, 0.0f), rng);
+    BatchReceiver rx(t.ofdm_symbols);
+    const std::vector<PackedBits> inline_bits = decode(rx, t);
+    expect(errors(t, inline_bits) == 0, "a mixed batch decodes error free");
+    expect(rx.groups() == t.keys.size(), "one group per parameter set");
+    expect(rx.arena().heap_allocations() == 0, "an arena sized for the batch never spills");
+
+    // Decoding again gives the same bits: nothing carries over between
+    // batches.
+    expect(errors(t, decode(rx, t)) == 0, "every frame starts its own stream");
+
+    WorkStealingPool pool(3);
+    BatchReceiver parallel(t.ofdm_symbols, Equalizer::none, &pool);
+    const std::vector<PackedBits> pool_bits = decode(parallel, t);
+    bool same = true;
+    for (std::size_t i = 0; i < pool_bits.size(); ++i) {
+        same = same && count_bit_errors(pool_bits[i].view(), inline_bits[i].view()) == 0;
+    }
+    expect(same, "decoding across the pool gives the inline bits");
+
+    BatchReceiver small(2);
+    expect(errors(t, decode(small, t)) == 0 && small.arena().heap_allocations() > 0,
+           "an undersized arena spills but still decodes");
+}
+
+void equalised() {
+    // A flat channel that Equalizer::none cannot undo and pilot_zf can.
+    std::mt19937 rng(8);
+    const Traffic t(12, std::polar(0.6f, 2.0f), rng);
+    BatchReceiver zf(t.ofdm_symbols, Equalizer::pilot_zf);
+    expect(errors(t, decode(zf, t)) == 0, "the pilot equaliser corrects a flat channel");
+    BatchReceiver none(t.ofdm_symbols);
+    expect(errors(t, decode(none, t)) > 0, "and is needed for it");
+}
+
+void invalid() {
+    std::mt19937 rng(9);
+    const Traffic t(1, cf32(1.0f, 0.0f), rng);
+    BatchReceiver rx(t.ofdm_symbols);
+    PackedBits bits(t.configs[0].info_bits_per_block());
+    const BatchFrame short_samples{t.configs[0],
+                                   std::span(t.samples[0]).first(t.samples[0].size() - 1),
+                                   bits.view()};
+    expect_throws<std::invalid_argument>(
+        [&] { rx.process(std::span(&short_samples, 1)); }, "too few samples");
+    PhyConfig bad = t.configs[0];
+    bad.symbols_per_block = 0;
+    const BatchFrame bad_config{bad, t.samples[0], bits.view()};
+    expect_throws<std::invalid_argument>([&] { rx.process(std::span(&bad_config, 1)); },
+                                         "invalid configuration");
+    rx.process({});
+    expect(rx.groups() == 0, "an empty batch has no groups");
+}
+
+}  // namespace
+
+int main() {
+    mixed_batches();
+    equalised();
+    invalid();
+    return dcomm::test::finish("batch");
+}
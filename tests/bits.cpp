@@ -0,0 +1,196 @@
+// Packed bits: every conversion and shuffle against a bit-by-bit model on
+// every available instruction set, at sizes that end mid-word, with the
+// padding of the last word cleared.
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/bits.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+
+// Odd sizes, so the last word is partial.
+constexpr std::size_t kSizes[] = {1, 63, 64, 65, 1000, 4099};
+
+std::vector<std::uint8_t> random_bits(std::size_t n, std::mt19937& rng) {
+    std::vector<std::uint8_t> bits(n);
+    for (auto& b : bits) {
+        b = std::uint8_t(rng() & 1u);
+    }
+    return bits;
+}
+
+std::vector<Isa> available_isas() {
+    std::vector<Isa> isas;
+    for (Isa isa : {Isa::scalar, Isa::avx2, Isa::avx512, Isa::neon}) {
+        if (isa_available(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+/// The packed form of `bits` per the layout: bit i in word i / 64, bit
+/// i % 64, padding clear.
+bool matches(ConstBitSpan packed, const std::vector<std::uint8_t>& bits) {
+    if (packed.size() != bits.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < bits.size(); ++i) {
+        if (((packed.words[i / 64] >> (i % 64)) & 1u) != bits[i]) {
+            return false;
+        }
+    }
+    return (packed.words[packed.word_count() - 1] & ~tail_mask(bits.size())) == 0;
+}
+
+/// A PackedBits of `n` bits whose words are all ones, padding included.
+PackedBits dirty(std::size_t n) {
+    PackedBits p(n);
+    for (std::uint64_t& w : p.view().word_span()) {
+        w = ~std::uint64_t(0);
+    }
+    return p;
+}
+
+void conversions(Isa isa) {
+    std::mt19937 rng(1);
+    bool pack = true, unpack = true, hard = true, llrs = true;
+    for (std::size_t n : kSizes) {
+        const std::vector<std::uint8_t> bits = random_bits(n, rng);
+        PackedBits p = dirty(n);
+        pack_bits(isa, bits, p.view());
+        pack = pack && matches(p.view(), bits);
+
+        std::vector<std::uint8_t> back(n, 7);
+        unpack_bits(isa, p.view(), back);
+        unpack = unpack && back == bits;
+
+        std::vector<float> l(n);
+        unpack_llrs(isa, p.view(), 2.5f, l);
+        for (std::size_t i = 0; i < n; ++i) {
+            llrs = llrs && l[i] == (bits[i] ? -2.5f : 2.5f);
+        }
+        // The sign bit decides, so -0.0 is a one.
+        l[0] = bits[0] ? -0.0f : 0.0f;
+        PackedBits h = dirty(n);
+        pack_hard_decisions(isa, l, h.view());
+        hard = hard && matches(h.view(), bits);
+    }
+    const std::string name = to_string(isa);
+    expect(pack, ("pack_bits " + name).c_str());
+    expect(unpack, ("unpack_bits " + name).c_str());
+    expect(llrs, ("unpack_llrs " + name).c_str());
+    expect(hard, ("pack_hard_decisions " + name).c_str());
+}
+
+void fields(Isa isa) {
+    std::mt19937 rng(2);
+    bool indices = true, repack = true;
+    for (unsigned width = 1; width <= 8; ++width) {
+        for (std::size_t count : {1, 7, 100, 513}) {
+            const std::vector<std::uint8_t> bits = random_bits(count * width, rng);
+            PackedBits p(bits.size());
+            pack_bits(isa, bits, p.view());
+            std::vector<std::uint8_t> idx(count);
+            unpack_indices(isa, p.view(), width, idx);
+            for (std::size_t k = 0; k < count; ++k) {
+                unsigned want = 0;
+                for (unsigned b = 0; b < width; ++b) {
+                    want = want << 1 | bits[k * width + b];
+                }
+                indices = indices && idx[k] == want;
+            }
+            PackedBits q = dirty(bits.size());
+            pack_indices(isa, idx, width, q.view());
+            repack = repack && matches(q.view(), bits);
+        }
+    }
+    const std::string name = to_string(isa);
+    expect(indices, ("unpack_indices, first bit most significant, " + name).c_str());
+    expect(repack, ("pack_indices inverts it " + name).c_str());
+}
+
+void shuffles(Isa isa) {
+    std::mt19937 rng(3);
+    bool zip = true, select = true, in_place = true;
+    // 3/4 puncturing keeps bits 0, 1, 2, 5 of every 6: a period of 192
+    // bits, three mask words.
+    std::vector<std::uint64_t> keep(3);
+    for (std::size_t i = 0; i < 192; ++i) {
+        const std::size_t r = i % 6;
+        keep[i / 64] |= std::uint64_t(r == 0 || r == 1 || r == 2 || r == 5) << (i % 64);
+    }
+    for (std::size_t n : kSizes) {
+        const std::vector<std::uint8_t> a = random_bits(n, rng), b = random_bits(n, rng);
+        PackedBits pa(n), pb(n), out = dirty(2 * n);
+        pack_bits(isa, a, pa.view());
+        pack_bits(isa, b, pb.view());
+        zip_bits(isa, pa.view(), pb.view(), out.view());
+        std::vector<std::uint8_t> zipped;
+        for (std::size_t i = 0; i < n; ++i) {
+            zipped.push_back(a[i]);
+            zipped.push_back(b[i]);
+        }
+        zip = zip && matches(out.view(), zipped);
+
+        std::vector<std::uint8_t> kept;
+        for (std::size_t i = 0; i < 2 * n; ++i) {
+            const std::size_t r = i % 192;
+            if ((keep[r / 64] >> (r % 64)) & 1u) {
+                kept.push_back(zipped[i]);
+            }
+        }
+        PackedBits sel = dirty(2 * n);
+        const std::size_t m = select_bits(isa, out.view(), keep, sel.view());
+        std::vector<std::uint8_t> got(m);
+        unpack_bits(isa, ConstBitSpan(sel.view().words, m), got);
+        select = select && m == kept.size() && got == kept;
+        for (std::size_t i = m; i < 2 * n; ++i) {
+            select = select && sel.get(i) == 0;
+        }
+
+        select_bits(isa, out.view(), keep, out.view());
+        in_place = in_place && matches(ConstBitSpan(out.view().words, m), kept);
+    }
+    const std::string name = to_string(isa);
+    expect(zip, ("zip_bits " + name).c_str());
+    expect(select, ("select_bits keeps the masked bits, clears the rest, " + name).c_str());
+    expect(in_place, ("select_bits in place " + name).c_str());
+}
+
+void spans() {
+    std::mt19937 rng(4);
+    const std::vector<std::uint8_t> a = random_bits(200, rng);
+    std::vector<std::uint8_t> b = a;
+    b[3] ^= 1u;
+    b[130] ^= 1u;
+    b[199] ^= 1u;
+    PackedBits pa(200), pb(200);
+    pack_bits(a, pa.view());
+    pack_bits(b, pb.view());
+    expect(count_bit_errors(pa.view(), pb.view()) == 3, "count_bit_errors");
+    expect(count_bit_errors(pa.view().subspan(128, 72), pb.view().subspan(128, 72)) == 2,
+           "subspan() from a word boundary");
+    expect(packed_words(0) == 0 && packed_words(64) == 1 && packed_words(65) == 2,
+           "packed_words");
+    expect(tail_mask(64) == ~std::uint64_t(0) && tail_mask(3) == 7, "tail_mask");
+}
+
+}  // namespace
+
+int main() {
+    for (Isa isa : available_isas()) {
+        conversions(isa);
+        fields(isa);
+        shuffles(isa);
+    }
+    spans();
+    return dcomm::test::finish("bits");
+}
@@ -0,0 +1,177 @@
+// Channel models: Gaussian noise statistics and its reproducibility from
+// (seed, stream, position); fading profiles, unit average gain, state
+// carried across calls, reset(), and the split and interleaved paths.
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/channel.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+
+void noise() {
+    constexpr std::size_t kN = 200000;
+    std::vector<cf32> n(kN);
+    GaussianNoise(5, 0).fill(n, 0.25f);
+    std::complex<double> mean = 0.0;
+    double power = 0.0, re_power = 0.0, fourth = 0.0;
+    for (const cf32& v : n) {
+        mean += std::complex<double>(v);
+        power += double(std::norm(v));
+        re_power += double(v.real()) * double(v.real());
+        fourth += std::pow(double(v.real()), 4.0);
+    }
+    mean /= double(kN);
+    power /= double(kN);
+    re_power /= double(kN);
+    fourth /= double(kN);
+    expect(std::abs(mean) < 0.005, "zero mean");
+    expect(std::abs(power - 0.25) < 0.0025, "E|n|^2 is the variance");
+    expect(std::abs(re_power - 0.125) < 0.002, "power splits evenly between re and im");
+    expect(std::abs(fourth / (re_power * re_power) - 3.0) < 0.05, "Gaussian kurtosis");
+
+    GaussianNoise a(5, 0);
+    std::vector<cf32> first(1000), second(1000);
+    a.fill(first, 0.25f);
+    a.fill(second, 0.25f);
+    expect(a.position() == 1000, "two samples per counter block");
+    bool continues = true;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        continues = continues && first[i] == n[i] && second[i] == n[1000 + i];
+    }
+    expect(continues, "the stream does not depend on how it is cut into calls");
+
+    std::vector<cf32> odd(3);
+    a.seek(0, 1);
+    a.fill(odd, 0.25f);
+    expect(odd[0] == n[2] && a.position() == 3, "seek() and odd sizes consume whole blocks");
+
+    std::vector<cf32> other(1000);
+    GaussianNoise(5, 1).fill(other, 0.25f);
+    expect(other[0] != n[0] && other[999] != n[999], "another stream gives other noise");
+
+    std::vector<cf32> signal(1000, cf32(1.0f, -2.0f)), added(1000);
+    GaussianNoise(5, 0).add(signal, added, 0.25f);
+    bool sum = true;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        sum = sum && added[i] == signal[i] + n[i];
+    }
+    expect(sum, "add() is the signal plus fill()");
+}
+
+std::vector<cf32> impulse(std::size_t n) {
+    std::vector<cf32> x(n);
+    x[0] = cf32(1.0f, 0.0f);
+    return x;
+}
+
+void profiles() {
+    for (FadingProfile p :
+         {FadingProfile::flat, FadingProfile::epa, FadingProfile::eva, FadingProfile::etu}) {
+        const std::span<const FadingTap> taps = fading_taps(p);
+        expect(!taps.empty() && taps[0].delay_ns == 0.0f, to_string(p));
+    }
+    expect(fading_taps(FadingProfile::flat).size() == 1 &&
+               fading_taps(FadingProfile::epa).size() == 7 &&
+               fading_taps(FadingProfile::etu).back().delay_ns == 5000.0f,
+           "TS 36.101 B.2.1 tap counts and spread");
+
+    FadingConfig flat;
+    flat.profile = FadingProfile::flat;
+    FadingChannel channel(flat, 1, 0);
+    std::vector<cf32> out(8);
+    channel.process(impulse(8), out);
+    bool single = std::abs(out[0]) > 0.0f;
+    for (std::size_t i = 1; i < out.size(); ++i) {
+        single = single && out[i] == cf32{};
+    }
+    expect(single, "a flat channel is one tap at delay 0");
+
+    // ETU spans 5 us, 100 samples at 20 Msps.
+    FadingConfig etu;
+    etu.profile = FadingProfile::etu;
+    expect(FadingChannel(etu, 1, 0).impulse_response().size() > 100,
+           "the FIR covers the delay spread");
+}
+
+void average_gain() {
+    // The first update of independent realisations: E|h|^2 summed over
+    // the taps is one.
+    FadingConfig config;
+    config.profile = FadingProfile::eva;
+    double gain = 0.0;
+    constexpr int kRealisations = 2000;
+    FadingChannel channel(config, 3, 0);
+    std::vector<cf32> out(1);
+    for (int r = 0; r < kRealisations; ++r) {
+        channel.reset(std::uint64_t(r));
+        channel.process(impulse(1), out);
+        for (const cf32& h : channel.impulse_response()) {
+            gain += double(std::norm(h));
+        }
+    }
+    gain /= kRealisations;
+    expect(std::abs(gain - 1.0) < 0.1, "unit average gain");
+}
+
+void state_and_layouts() {
+    FadingConfig config;
+    config.doppler_hz = 300.0;
+    config.update_interval = 16;
+    std::vector<cf32> in(1000);
+    GaussianNoise(9, 0).fill(in, 1.0f);
+
+    FadingChannel whole(config, 7, 2);
+    std::vector<cf32> once(in.size());
+    whole.process(in, once);
+
+    FadingChannel pieces(config, 7, 2);
+    std::vector<cf32> cut(in.size());
+    const std::span<const cf32> src(in);
+    const std::span<cf32> dst(cut);
+    pieces.process(src.first(123), dst.first(123));
+    pieces.process(src.subspan(123, 400), dst.subspan(123, 400));
+    pieces.process(src.subspan(523), dst.subspan(523));
+    expect(cut == once, "filter state and tap updates carry over between calls");
+
+    pieces.reset(2);
+    std::vector<cf32> again(in.size());
+    pieces.process(in, again);
+    expect(again == once, "reset() to the same stream repeats the realisation");
+    pieces.reset(3);
+    pieces.process(in, again);
+    expect(again != once, "another stream is another realisation");
+
+    std::vector<float> re(in.size()), im(in.size()), out_re(in.size()), out_im(in.size());
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        re[i] = in[i].real();
+        im[i] = in[i].imag();
+    }
+    FadingChannel split(config, 7, 2);
+    split.process(ConstSplitSpan(re.data(), im.data(), in.size()),
+                  SplitSpan(out_re.data(), out_im.data(), in.size()));
+    bool same = true;
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        same = same && out_re[i] == once[i].real() && out_im[i] == once[i].imag();
+    }
+    expect(same, "split and interleaved samples give identical output");
+
+    std::vector<cf32> in_place = in;
+    FadingChannel(config, 7, 2).process(in_place, in_place);
+    expect(in_place == once, "in-place filtering");
+}
+
+}  // namespace
+
+int main() {
+    noise();
+    profiles();
+    average_gain();
+    state_and_layouts();
+    return dcomm::test::finish("channel");
+}
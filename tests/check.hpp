@@ -0,0 +1,41 @@
+#pragma once
+
+// Minimal harness of the focused module tests (tests/<module>.cpp): each
+// expect() that fails prints its location, and finish() turns the count
+// into the exit status ctest reads.
+
+#include <cstdio>
+#include <source_location>
+
+namespace dcomm::test {
+
+inline int failures = 0;
+
+inline bool expect(bool ok, const char* what,
+                   std::source_location where = std::source_location::current()) {
+    if (!ok) {
+        ++failures;
+        std::fprintf(stderr, "%s:%u: FAIL %s\n", where.file_name(), unsigned(where.line()), what);
+    }
+    return ok;
+}
+
+/// Call `f` and expect it to throw E.
+template <class E, class F>
+bool expect_throws(F&& f, const char* what,
+                   std::source_location where = std::source_location::current()) {
+    try {
+        f();
+    } catch (const E&) {
+        return true;
+    } catch (...) {
+    }
+    return expect(false, what, where);
+}
+
+inline int finish(const char* name) {
+    std::printf("%s: %s (%d failed)\n", name, failures == 0 ? "PASS" : "FAIL", failures);
+    return failures == 0 ? 0 : 1;
+}
+
+}  // namespace dcomm::test
@@ -0,0 +1,117 @@
+// Complex layouts: aligned split planes, conversion both ways, and the
+// element-wise kernels agreeing bit for bit across layouts and with the
+// plain complex arithmetic they stand for.
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/complex_layout.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+
+// Not a multiple of any vector width, so the kernels' tails run.
+constexpr std::size_t kN = 1003;
+
+std::vector<cf32> random_samples(std::mt19937& rng) {
+    std::normal_distribution<float> g(0.0f, 1.0f);
+    std::vector<cf32> v(kN);
+    for (cf32& s : v) {
+        s = cf32(g(rng), g(rng));
+    }
+    return v;
+}
+
+bool bitwise_equal(std::span<const cf32> a, ConstSplitSpan b) {
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        const cf32 v = b[i];
+        if (std::memcmp(&a[i], &v, sizeof v) != 0) {
+            return false;
+        }
+    }
+    return a.size() == b.size();
+}
+
+void buffers() {
+    ComplexBuffer<Split> split(kN);
+    const SplitSpan v = split.view();
+    expect(v.size() == kN && reinterpret_cast<std::uintptr_t>(v.re) % kCacheLine == 0 &&
+               reinterpret_cast<std::uintptr_t>(v.im) % kCacheLine == 0,
+           "both planes are cache-line aligned");
+    split.set(5, cf32(1.0f, -2.0f));
+    expect(v.re[5] == 1.0f && v.im[5] == -2.0f && split.get(5) == cf32(1.0f, -2.0f),
+           "set() writes one float to each plane");
+    const ConstSplitSpan sub = ConstSplitSpan(v).subspan(5, 3);
+    expect(sub.size() == 3 && sub[0] == cf32(1.0f, -2.0f), "subspan() of a split view");
+
+    ComplexBuffer<Interleaved> inter(kN);
+    inter.set(5, cf32(3.0f, 4.0f));
+    expect(inter.view()[5] == cf32(3.0f, 4.0f), "interleaved buffers are plain cf32");
+}
+
+void conversion() {
+    std::mt19937 rng(8);
+    const std::vector<cf32> x = random_samples(rng);
+    ComplexBuffer<Split> split(kN);
+    convert(x, split.view());
+    expect(bitwise_equal(x, split.view()), "interleaved to split moves floats exactly");
+    std::vector<cf32> back(kN);
+    convert(split.view(), back);
+    expect(back == x, "split to interleaved round-trips");
+    ComplexBuffer<Split> copy(kN);
+    convert(split.view(), copy.view());
+    expect(bitwise_equal(x, copy.view()), "same-layout convert() copies");
+}
+
+void kernels() {
+    std::mt19937 rng(9);
+    const std::vector<cf32> a = random_samples(rng), b = random_samples(rng);
+    ComplexBuffer<Split> sa(kN), sb(kN), sout(kN);
+    convert(a, sa.view());
+    convert(b, sb.view());
+
+    std::vector<cf32> product(kN), conj_product(kN);
+    multiply(a, b, product);
+    multiply(sa.view(), sb.view(), sout.view());
+    expect(bitwise_equal(product, sout.view()), "multiply agrees across layouts");
+    multiply_conj(a, b, conj_product);
+    multiply_conj(sa.view(), sb.view(), sout.view());
+    expect(bitwise_equal(conj_product, sout.view()), "multiply_conj agrees across layouts");
+
+    double err = 0.0;
+    for (std::size_t i = 0; i < kN; ++i) {
+        const std::complex<double> da(a[i]), db(b[i]);
+        err = std::max({err, std::abs(std::complex<double>(product[i]) - da * db),
+                        std::abs(std::complex<double>(conj_product[i]) - da * std::conj(db))});
+    }
+    expect(err < 1e-5, "the kernels compute a * b and a * conj(b)");
+
+    std::vector<float> mag(kN), split_mag(kN);
+    magnitude_squared(a, mag);
+    magnitude_squared(sa.view(), split_mag);
+    bool norms = mag == split_mag;
+    for (std::size_t i = 0; i < kN; ++i) {
+        norms = norms && std::abs(mag[i] - std::norm(a[i])) <= 1e-5f * mag[i];
+    }
+    expect(norms, "magnitude_squared agrees across layouts and with std::norm");
+
+    std::vector<cf32> in_place = a;
+    multiply(in_place, b, in_place);
+    expect(in_place == product, "outputs may alias inputs");
+}
+
+}  // namespace
+
+int main() {
+    buffers();
+    conversion();
+    kernels();
+    return dcomm::test::finish("complex_layout");
+}
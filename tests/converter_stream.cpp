@@ -0,0 +1,293 @@
+// Converter streams: a FileBackend capture read back block by block, a
+// shared-memory ring pair within one process (drops, draining, block size
+// checks), and the deadline counts of DacStream and AdcStream when the
+// application stalls.
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "check.hpp"
+#include "dcomm/converter_stream.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+using dcomm::test::expect_throws;
+
+namespace fs = std::filesystem;
+
+/// Sample i of block b, so a block read back names itself.
+cf32 tag(std::size_t b, std::size_t i) { return cf32(float(b), float(i) / 1024.0f); }
+
+std::vector<cf32> tagged(std::size_t b, std::size_t n) {
+    std::vector<cf32> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = tag(b, i);
+    }
+    return v;
+}
+
+/// In-memory converter: read() hands out tagged blocks 0, 1, ... up to
+/// `blocks`, write() keeps what it is sent.
+class MemoryBackend final : public ConverterBackend {
+public:
+    explicit MemoryBackend(std::size_t blocks) : blocks_(blocks) {}
+
+    bool write(std::span<const cf32> block) override {
+        written.emplace_back(block.begin(), block.end());
+        return true;
+    }
+    bool read(std::span<cf32> block) override {
+        if (next_ == blocks_) {
+            return false;
+        }
+        for (std::size_t i = 0; i < block.size(); ++i) {
+            block[i] = tag(next_, i);
+        }
+        ++next_;
+        return true;
+    }
+
+    std::vector<std::vector<cf32>> written;
+
+private:
+    std::size_t blocks_;
+    std::size_t next_ = 0;
+};
+
+void file_roundtrip(const fs::path& dir) {
+    const std::string path = (dir / "capture.sigmf-data").string();
+    SigmfMeta meta;
+    meta.sample_rate = 1e6;
+    {
+        FileBackend capture("", path, meta);
+        for (std::size_t b = 0; b < 3; ++b) {
+            expect(capture.write(tagged(b, 100)), "the capture takes every block");
+        }
+        std::vector<cf32> block(100);
+        expect(!capture.read(block), "no recording to replay");
+        capture.close();
+    }
+    expect(read_sigmf_meta(sigmf_meta_path(path)).sample_rate == 1e6,
+           "the capture's metadata is written on close()");
+
+    // 300 samples in blocks of 64: four whole blocks and a padded one.
+    FileBackend replay(path, "");
+    std::vector<cf32> got, block(64);
+    while (replay.read(block)) {
+        got.insert(got.end(), block.begin(), block.end());
+    }
+    std::vector<cf32> want;
+    for (std::size_t b = 0; b < 3; ++b) {
+        const std::vector<cf32> t = tagged(b, 100);
+        want.insert(want.end(), t.begin(), t.end());
+    }
+    want.resize(5 * 64);
+    expect(got == want, "the recording replays in order, the last block zero-padded");
+    expect(!replay.write(block), "no capture to write");
+}
+
+std::string shm_name(const char* what) {
+    return "/dcomm_test_" + std::string(what) + "_" + std::to_string(::getpid());
+}
+
+void shm_pair() {
+    SharedMemoryConfig tx;
+    tx.tx_name = shm_name("pair");
+    tx.capacity = 250;  // rounded up to 256: two blocks of 100
+    tx.samples_per_block = 100;
+    auto writer = std::make_unique<SharedMemoryBackend>(tx);
+    SharedMemoryConfig rx;
+    rx.rx_name = tx.tx_name;
+    rx.create = false;
+    rx.samples_per_block = 100;
+    SharedMemoryBackend reader(rx);
+
+    for (std::size_t b = 0; b < 3; ++b) {
+        expect(writer->write(tagged(b, 100)), "write() never fails while the ring is open");
+    }
+    expect(writer->dropped() == 1, "a block that does not fit is dropped");
+    std::vector<cf32> block(100);
+    expect(reader.read(block) && block == tagged(0, 100) && reader.read(block) &&
+               block == tagged(1, 100),
+           "blocks come out in order");
+    // Wrap around the end of the ring.
+    writer->write(tagged(3, 100));
+    writer->write(tagged(4, 60));
+    expect(writer->dropped() == 1 && reader.read(block) && block == tagged(3, 100),
+           "a block across the end of the ring");
+
+    std::vector<cf32> too_long = tagged(5, 101);
+    expect(!writer->write(too_long) && !reader.read(too_long),
+           "blocks longer than samples_per_block fail instead of hanging");
+    writer.reset();  // closes the ring
+    expect(reader.read(block) && std::equal(block.begin(), block.begin() + 60,
+                                            tagged(4, 60).begin()) &&
+               block[60] == cf32{} && block[99] == cf32{},
+           "a closed ring drains, zero-padding the last block");
+    expect(!reader.read(block), "then ends");
+}
+
+void shm_block_size() {
+    SharedMemoryConfig config;
+    config.tx_name = shm_name("size");
+    config.capacity = 64;
+    config.samples_per_block = 100;
+    expect_throws<std::invalid_argument>([&] { SharedMemoryBackend b(config); },
+                                         "a created ring smaller than a block");
+    config.samples_per_block = 0;
+    expect_throws<std::invalid_argument>([&] { SharedMemoryBackend b(config); },
+                                         "no block size");
+    config.samples_per_block = 64;
+    SharedMemoryBackend owner(config);
+    SharedMemoryConfig attach;
+    attach.rx_name = config.tx_name;
+    attach.create = false;
+    attach.capacity = 1 << 20;  // ignored: the ring has its own
+    attach.samples_per_block = 100;
+    expect_throws<std::invalid_argument>([&] { SharedMemoryBackend b(attach); },
+                                         "an attached ring smaller than a block");
+    attach.samples_per_block = 64;
+    SharedMemoryBackend fits(attach);
+    attach.format = IqFormat::ci16;
+    expect_throws<std::invalid_argument>([&] { SharedMemoryBackend b(attach); },
+                                         "an attached ring of another format");
+}
+
+/// 1000 samples at 500 kHz: a 2 ms period, long against scheduling noise.
+StreamConfig clocked(bool paced = true) {
+    StreamConfig config;
+    config.sample_rate = 500e3;
+    config.samples_per_block = 1000;
+    config.buffers = 2;
+    config.paced = paced;
+    return config;
+}
+
+void dac_underrun() {
+    MemoryBackend backend(0);
+    DacStream dac(backend, clocked());
+    std::span<cf32> buffer = dac.acquire();
+    const std::vector<cf32> first = tagged(1, buffer.size());
+    std::copy(first.begin(), first.end(), buffer.begin());
+    dac.commit();  // primed before start()
+    dac.start();
+    // Miss about five periods, then send a second block.
+    std::this_thread::sleep_for(std::chrono::milliseconds(11));
+    buffer = dac.acquire();
+    const std::vector<cf32> second = tagged(2, buffer.size());
+    std::copy(second.begin(), second.end(), buffer.begin());
+    dac.commit();
+    dac.stop();
+
+    const DeadlineStats s = dac.deadline_stats();
+    expect(s.blocks == 2 && s.late >= 2 && backend.written.size() == s.blocks + s.late,
+           "every period sends a block, silence when none was committed");
+    bool silence = true;
+    for (std::size_t b = 1; b + 1 < backend.written.size(); ++b) {
+        silence = silence && backend.written[b] == std::vector<cf32>(first.size());
+    }
+    expect(backend.written.front() == first && backend.written.back() == second && silence,
+           "the late block follows the silence");
+    expect(s.period == std::chrono::milliseconds(2) && s.min_budget <= s.mean_budget,
+           "budgets are recorded per committed block");
+}
+
+/// Takes blocks from `adc`, stalling `stall_at` for `stall`, and returns
+/// the tag of each.
+std::vector<std::size_t> drain(AdcStream& adc, std::size_t stall_at,
+                               std::chrono::milliseconds stall) {
+    std::vector<std::size_t> ids;
+    for (std::span<const cf32> b = adc.acquire(); !b.empty(); b = adc.acquire()) {
+        ids.push_back(std::size_t(b[0].real()));
+        if (ids.size() == stall_at) {
+            std::this_thread::sleep_for(stall);
+        }
+        adc.release();
+    }
+    return ids;
+}
+
+bool consecutive(const std::vector<std::size_t>& ids, std::size_t n) {
+    bool ok = ids.size() == n;
+    for (std::size_t i = 0; ok && i < n; ++i) {
+        ok = ids[i] == i;
+    }
+    return ok;
+}
+
+void adc_stalls() {
+    {
+        // Paced: blocks read while the application holds every buffer are
+        // lost and counted.
+        MemoryBackend backend(20);
+        AdcStream adc(backend, clocked());
+        adc.start();
+        const std::vector<std::size_t> ids = drain(adc, 2, std::chrono::milliseconds(11));
+        const DeadlineStats s = adc.deadline_stats();
+        bool ordered = !ids.empty();
+        for (std::size_t i = 1; ordered && i < ids.size(); ++i) {
+            ordered = ids[i] > ids[i - 1];
+        }
+        expect(ordered && s.late >= 2 && ids.size() + s.late == 20 && s.blocks == ids.size(),
+               "a paced ADC drops the blocks it has no buffer for");
+        expect(s.min_budget < std::chrono::nanoseconds(0), "the stalled block was late");
+        expect(adc.finished(), "the stream ends with the backend");
+    }
+    {
+        // Unpaced on a clock: the thread waits instead, nothing is lost.
+        MemoryBackend backend(20);
+        AdcStream adc(backend, clocked(false));
+        adc.start();
+        const std::vector<std::size_t> ids = drain(adc, 2, std::chrono::milliseconds(5));
+        expect(consecutive(ids, 20) && adc.deadline_stats().late >= 1,
+               "an unpaced ADC stalls, counting it, and loses nothing");
+    }
+    {
+        // Running free.
+        MemoryBackend backend(50);
+        StreamConfig config = clocked();
+        config.sample_rate = 0.0;
+        config.buffers = 3;
+        AdcStream adc(backend, config);
+        adc.start();
+        const std::vector<std::size_t> ids = drain(adc, 10, std::chrono::milliseconds(2));
+        const DeadlineStats s = adc.deadline_stats();
+        expect(consecutive(ids, 50) && s.late == 0 && s.period.count() == 0 &&
+                   adc.budget_left().count() == 0,
+               "a free-running ADC waits for the application");
+    }
+
+    StreamConfig bad = clocked();
+    bad.buffers = 1;
+    MemoryBackend backend(0);
+    expect_throws<std::invalid_argument>([&] { AdcStream a(backend, bad); }, "one buffer");
+    bad = clocked();
+    bad.samples_per_block = 0;
+    expect_throws<std::invalid_argument>([&] { DacStream d(backend, bad); }, "empty blocks");
+}
+
+}  // namespace
+
+int main() {
+    const fs::path dir =
+        fs::temp_directory_path() / ("dcomm_converter_stream_" + std::to_string(::getpid()));
+    fs::create_directories(dir);
+    file_roundtrip(dir);
+    fs::remove_all(dir);
+    shm_pair();
+    shm_block_size();
+    dac_underrun();
+    adc_stalls();
+    return dcomm::test::finish("converter_stream");
+}
@@ -0,0 +1,1214 @@
+// Golden-vector regression tests of the stages.
+//
+//   dcomm_golden [--output PATH]
+//
+// Three kinds of checks:
+//  * standard vectors: the 802.11a scrambler sequence and the SIGNAL field
+//    example of IEEE 802.11-2012 17.3.5.5 and Annex L (36 Mbit/s,
+//    LENGTH 100) through the encoder and interleaver, the constellation
+//    tables of 17.3.5.8, the QPP parameters of TS 36.212 Table 5.1.3-3 and
+//    the catalogue check values of the 3GPP and 802.11 CRCs;
+//  * reference models: the defining recurrences and formulas (generator
+//    polynomials, puncturing patterns, interleaver permutations, the
+//    TS 38.211 Gold sequence, the DFT) written out bit by bit here;
+//  * cross-ISA: every available instruction set against Isa::scalar, bit
+//    for bit where the kernels promise it, plus noiseless decoding on each.
+//
+// Results go to stdout and to PATH (default test_output.txt): '#' comment
+// lines, a column header, then one row per check. The exit status is 1 if
+// any check failed.
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "dcomm/bits.hpp"
+#include "dcomm/channel.hpp"
+#include "dcomm/complex_layout.hpp"
+#include "dcomm/convcode.hpp"
+#include "dcomm/cpu_features.hpp"
+#include "dcomm/crc.hpp"
+#include "dcomm/fft.hpp"
+#include "dcomm/frame.hpp"
+#include "dcomm/fast_math.hpp"
+#include "dcomm/harq.hpp"
+#include "dcomm/interleaver.hpp"
+#include "dcomm/ldpc.hpp"
+#include "dcomm/mimo.hpp"
+#include "dcomm/modulation.hpp"
+#include "dcomm/resampler.hpp"
+#include "dcomm/scrambler.hpp"
+#include "dcomm/sync.hpp"
+#include "dcomm/turbo.hpp"
+
+namespace {
+
+using namespace dcomm;
+
+// 17.3.5.5: the 127-bit period from the all-ones state, leftmost first.
+constexpr std::string_view kScramblerAllOnes =
+    "00001110 11110010 11001001 00000010 00100110 00101110 10110110 00001100 "
+    "11010100 11100111 10110100 00101010 11111010 01010001 10111000 1111111";
+
+// Annex L: SIGNAL field of the 36 Mbit/s, 100-byte example, tail included,
+// after the rate-1/2 encoder and after the N_CBPS = 48 interleaver.
+constexpr std::string_view kSignalBits = "1011 0 001001100000 0 000000";
+constexpr std::string_view kSignalCoded =
+    "110100011010000100000010001111100111000000000000";
+constexpr std::string_view kSignalInterleaved =
+    "100101001101000000010100100000110010010010010100";
+
+// 17.3.5.8: in-phase level of 16-QAM (b0 b1) and 64-QAM (b0 b1 b2).
+constexpr int kQam16Levels[4] = {-3, -1, 3, 1};
+constexpr int kQam64Levels[8] = {-7, -5, -1, -3, 7, 5, 1, 3};
+
+struct QppEntry {
+    std::size_t k;
+    unsigned f1, f2;
+};
+// TS 36.212 Table 5.1.3-3, first and last rows.
+constexpr QppEntry kQppTable[] = {
+    {40, 3, 10}, {48, 7, 12}, {56, 19, 42}, {64, 7, 16}, {6144, 263, 480}};
+
+constexpr Modulation kModulations[] = {Modulation::bpsk, Modulation::qpsk, Modulation::qam16,
+                                       Modulation::qam64, Modulation::qam256};
+constexpr CodeRate kRates[] = {CodeRate::r1_2, CodeRate::r2_3, CodeRate::r3_4};
+
+struct Check {
+    std::string name;
+    bool pass;
+    std::string detail;
+};
+
+class Report {
+public:
+    void check(std::string name, bool pass, std::string detail = {}) {
+        checks_.push_back({std::move(name), pass, std::move(detail)});
+    }
+
+    std::size_t failures() const {
+        return std::size_t(std::count_if(checks_.begin(), checks_.end(),
+                                         [](const Check& c) { return !c.pass; }));
+    }
+
+    void write(std::FILE* out, const std::vector<std::string>& comments) const {
+        for (const std::string& c : comments) {
+            std::fprintf(out, "# %s\n", c.c_str());
+        }
+        std::fprintf(out, "%-44s %6s  %s\n", "check", "result", "detail");
+        for (const Check& c : checks_) {
+            std::fprintf(out, "%-44s %6s  %s\n", c.name.c_str(), c.pass ? "PASS" : "FAIL",
+                         c.detail.c_str());
+        }
+    }
+
+private:
+    std::vector<Check> checks_;
+};
+
+std::vector<std::uint8_t> bits_of(std::string_view s) {
+    std::vector<std::uint8_t> bits;
+    for (char c : s) {
+        if (c == '0' || c == '1') {
+            bits.push_back(std::uint8_t(c - '0'));
+        }
+    }
+    return bits;
+}
+
+std::vector<std::uint8_t> random_bits(std::size_t n, std::mt19937& rng) {
+    std::vector<std::uint8_t> bits(n);
+    for (auto& b : bits) {
+        b = std::uint8_t(rng() & 1u);
+    }
+    return bits;
+}
+
+/// Empty if equal, else where the first difference is.
+template <class A, class B>
+std::string mismatch(const A& got, const B& want) {
+    if (got.size() != want.size()) {
+        return "size " + std::to_string(got.size()) + " != " + std::to_string(want.size());
+    }
+    for (std::size_t i = 0; i < got.size(); ++i) {
+        if (!(got[i] == want[i])) {
+            return "first difference at " + std::to_string(i);
+        }
+    }
+    return {};
+}
+
+/// Bit-for-bit comparison of float data, which == would not give for NaN
+/// or signed zeros.
+template <class T>
+std::string bitwise_mismatch(const std::vector<T>& got, const std::vector<T>& want) {
+    if (got.size() != want.size()) {
+        return "size " + std::to_string(got.size()) + " != " + std::to_string(want.size());
+    }
+    for (std::size_t i = 0; i < got.size(); ++i) {
+        if (std::memcmp(&got[i], &want[i], sizeof(T)) != 0) {
+            return "first difference at " + std::to_string(i);
+        }
+    }
+    return {};
+}
+
+void expect_equal(Report& report, std::string name, const std::string& diff) {
+    report.check(std::move(name), diff.empty(), diff);
+}
+
+std::vector<Isa> available_isas() {
+    std::vector<Isa> isas;
+    for (Isa isa : {Isa::scalar, Isa::avx2, Isa::avx512, Isa::neon}) {
+        if (isa_available(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+std::vector<std::uint8_t> unpacked(ConstBitSpan bits) {
+    std::vector<std::uint8_t> out(bits.size());
+    unpack_bits(bits, out);
+    return out;
+}
+
+PackedBits packed(const std::vector<std::uint8_t>& bits) {
+    PackedBits out(bits.size());
+    pack_bits(bits, out.view());
+    return out;
+}
+
+// ---------------------------------------------------------------- 802.11
+
+void check_scrambler(Report& report) {
+    const std::vector<std::uint8_t> period = bits_of(kScramblerAllOnes);
+    std::vector<std::uint8_t> want(period);
+    want.insert(want.end(), period.begin(), period.end());
+
+    Scrambler s(0x7f);
+    std::vector<std::uint8_t> got(want.size());
+    s.apply(std::vector<std::uint8_t>(want.size()), got);
+    expect_equal(report, "ieee80211.scrambler.sequence", mismatch(got, want));
+
+    s.reset(0x7f);
+    for (auto& b : got) {
+        b = s.next_bit();
+    }
+    expect_equal(report, "ieee80211.scrambler.next_bit", mismatch(got, want));
+
+    s.reset(0x7f);
+    PackedBits out(want.size());
+    s.apply(PackedBits(want.size()).view(), out.view());
+    expect_equal(report, "ieee80211.scrambler.packed", mismatch(unpacked(out.view()), want));
+
+    // Both table-driven overloads against the stepped register, from other
+    // seeds and from part way through the period; the state must follow.
+    std::mt19937 rng(18);
+    std::string unpacked_diff, packed_diff;
+    for (std::uint8_t seed : {0x01, 0x40, 0x5d, 0x7f, 0xc9}) {
+        for (std::size_t phase : {1, 63, 126, 200}) {
+            const std::vector<std::uint8_t> data = random_bits(300, rng);
+            Scrambler ref(seed), a(seed), b(seed);
+            for (std::size_t i = 0; i < phase; ++i) {
+                ref.next_bit();
+                a.next_bit();
+                b.next_bit();
+            }
+            std::vector<std::uint8_t> expected(data.size());
+            for (std::size_t i = 0; i < data.size(); ++i) {
+                expected[i] = data[i] ^ ref.next_bit();
+            }
+            std::vector<std::uint8_t> got_a(data.size());
+            a.apply(data, got_a);
+            PackedBits got_b(data.size());
+            b.apply(packed(data).view(), got_b.view());
+            const std::string where =
+                " (seed " + std::to_string(seed) + ", phase " + std::to_string(phase) + ")";
+            if (unpacked_diff.empty() && (got_a != expected || a.state() != ref.state())) {
+                unpacked_diff = mismatch(got_a, expected) + where;
+            }
+            if (packed_diff.empty() &&
+                (unpacked(got_b.view()) != expected || b.state() != ref.state())) {
+                packed_diff = mismatch(unpacked(got_b.view()), expected) + where;
+            }
+        }
+    }
+    expect_equal(report, "ieee80211.scrambler.apply_matches_next_bit", unpacked_diff);
+    expect_equal(report, "ieee80211.scrambler.packed_matches_next_bit", packed_diff);
+
+    std::size_t threw = 0;
+    for (std::uint8_t seed : {0x00, 0x80}) {
+        try {
+            Scrambler z(seed);
+        } catch (const std::invalid_argument&) {
+            ++threw;
+        }
+        try {
+            s.reset(seed);
+        } catch (const std::invalid_argument&) {
+            ++threw;
+        }
+    }
+    report.check("ieee80211.scrambler.zero_seed", threw == 4,
+                 std::to_string(threw) + " of 4 rejected");
+}
+
+void check_signal(Report& report) {
+    const SignalField field{Modulation::qam16, CodeRate::r3_4, 100};
+    const std::vector<std::uint8_t> want = bits_of(kSignalBits);
+    const std::uint32_t word = pack_signal(field);
+    std::vector<std::uint8_t> bits(want.size());
+    for (std::size_t i = 0; i < 18; ++i) {
+        bits[i] = std::uint8_t(word >> i & 1u);
+    }
+    expect_equal(report, "ieee80211.signal.bits", mismatch(bits, want));
+    const std::optional<SignalField> parsed = parse_signal(word);
+    report.check("ieee80211.signal.parse", parsed && *parsed == field);
+
+    std::vector<std::uint8_t> coded(conv_coded_bits(18));
+    conv_encode(std::span(bits).first(18), coded);
+    expect_equal(report, "ieee80211.signal.encoded", mismatch(coded, bits_of(kSignalCoded)));
+
+    PackedBits coded_packed(coded.size());
+    conv_encode(packed(std::vector(bits.begin(), bits.begin() + 18)).view(), coded_packed.view());
+    expect_equal(report, "ieee80211.signal.encoded_packed",
+                 mismatch(unpacked(coded_packed.view()), bits_of(kSignalCoded)));
+
+    std::vector<std::uint8_t> interleaved(48);
+    BlockInterleaver::ieee80211(48, 1).interleave(coded, interleaved);
+    expect_equal(report, "ieee80211.signal.interleaved",
+                 mismatch(interleaved, bits_of(kSignalInterleaved)));
+}
+
+/// Rate-1/2 K = 7 encoder straight from g0 = 133, g1 = 171 (octal).
+std::vector<std::uint8_t> reference_conv(const std::vector<std::uint8_t>& info) {
+    std::vector<std::uint8_t> out;
+    unsigned window = 0;  // bit 6: current input, bit 0: six steps ago
+    auto step = [&](unsigned bit) {
+        window = (window >> 1) | bit << 6;
+        out.push_back(std::uint8_t(std::popcount(window & 0133u) & 1));
+        out.push_back(std::uint8_t(std::popcount(window & 0171u) & 1));
+    };
+    for (std::uint8_t b : info) {
+        step(b);
+    }
+    for (std::size_t i = 0; i < kConvMemory; ++i) {
+        step(0);
+    }
+    return out;
+}
+
+/// 802.11 puncturing: 2/3 drops B2 of every (A1 B1 A2 B2), 3/4 drops B2
+/// and A3 of every (A1 B1 A2 B2 A3 B3).
+std::vector<std::uint8_t> reference_puncture(CodeRate rate, const std::vector<std::uint8_t>& in) {
+    std::vector<std::uint8_t> out;
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        const bool drop = (rate == CodeRate::r2_3 && i % 4 == 3) ||
+                          (rate == CodeRate::r3_4 && (i % 6 == 3 || i % 6 == 4));
+        if (!drop) {
+            out.push_back(in[i]);
+        }
+    }
+    return out;
+}
+
+void check_convolutional(Report& report) {
+    std::mt19937 rng(1);
+    const std::vector<std::uint8_t> info = random_bits(1001, rng);
+    const std::vector<std::uint8_t> want = reference_conv(info);
+    std::vector<std::uint8_t> coded(conv_coded_bits(info.size()));
+    conv_encode(info, coded);
+    expect_equal(report, "ieee80211.conv.encode", mismatch(coded, want));
+    PackedBits coded_packed(coded.size());
+    conv_encode(packed(info).view(), coded_packed.view());
+    expect_equal(report, "ieee80211.conv.encode_packed",
+                 mismatch(unpacked(coded_packed.view()), want));
+
+    for (CodeRate rate : kRates) {
+        const std::string name = std::string("ieee80211.conv.puncture_") + to_string(rate);
+        const std::vector<std::uint8_t> punctured = reference_puncture(rate, want);
+        std::vector<std::uint8_t> out(punctured_bits(rate, want.size()));
+        puncture(rate, want, out);
+        expect_equal(report, name, mismatch(out, punctured));
+        PackedBits out_packed(out.size());
+        puncture(rate, packed(want).view(), out_packed.view());
+        expect_equal(report, name + "_packed", mismatch(unpacked(out_packed.view()), punctured));
+    }
+}
+
+void check_interleaver(Report& report) {
+    std::mt19937 rng(2);
+    for (Modulation m : {Modulation::bpsk, Modulation::qpsk, Modulation::qam16, Modulation::qam64}) {
+        // 17.3.5.7: first and second permutation of coded bit k.
+        const std::size_t n_bpsc = bits_per_symbol(m);
+        const std::size_t n_cbps = 48 * n_bpsc;
+        const std::size_t s = std::max<std::size_t>(n_bpsc / 2, 1);
+        const std::vector<std::uint8_t> in = random_bits(n_cbps, rng);
+        std::vector<std::uint8_t> want(n_cbps);
+        for (std::size_t k = 0; k < n_cbps; ++k) {
+            const std::size_t i = (n_cbps / 16) * (k % 16) + k / 16;
+            const std::size_t j = s * (i / s) + (i + n_cbps - 16 * i / n_cbps) % s;
+            want[j] = in[k];
+        }
+        const BlockInterleaver& il = BlockInterleaver::ieee80211(n_cbps, unsigned(n_bpsc));
+        std::vector<std::uint8_t> got(n_cbps), back(n_cbps);
+        il.interleave(in, got);
+        il.deinterleave(got, back);
+        const std::string name = std::string("ieee80211.interleaver.") + to_string(m);
+        expect_equal(report, name, mismatch(got, want));
+        expect_equal(report, name + "_inverse", mismatch(back, in));
+    }
+}
+
+/// 17.3.5.8 levels, extended to 256-QAM by the same Gray rule.
+int reference_level(Modulation m, unsigned v) {
+    switch (m) {
+    case Modulation::bpsk:
+    case Modulation::qpsk: return v != 0 ? 1 : -1;
+    case Modulation::qam16: return kQam16Levels[v];
+    case Modulation::qam64: return kQam64Levels[v];
+    default: {
+        unsigned index = v;
+        for (unsigned shift = 1; shift < 4; shift <<= 1) {
+            index ^= index >> shift;
+        }
+        return 2 * int(index) - 15;
+    }
+    }
+}
+
+void check_mapping(Report& report) {
+    const double kNorm[] = {1.0, 2.0, 10.0, 42.0, 170.0};
+    for (Modulation m : kModulations) {
+        const unsigned k = bits_per_symbol(m);
+        const unsigned half = m == Modulation::bpsk ? 1 : k / 2;
+        const std::size_t count = std::size_t(1) << k;
+        std::vector<std::uint8_t> bits(count * k);
+        std::vector<std::complex<double>> want(count);
+        for (std::size_t v = 0; v < count; ++v) {
+            for (unsigned b = 0; b < k; ++b) {
+                bits[v * k + b] = std::uint8_t(v >> (k - 1 - b) & 1u);
+            }
+            const double scale = 1.0 / std::sqrt(kNorm[std::size_t(m)]);
+            const unsigned i_bits = unsigned(v >> (k - half));
+            const unsigned q_bits = unsigned(v & ((1u << (k - half)) - 1));
+            want[v] = {reference_level(m, i_bits) * scale,
+                       m == Modulation::bpsk ? 0.0 : reference_level(m, q_bits) * scale};
+        }
+        for (Isa isa : available_isas()) {
+            std::vector<cf32> got(count);
+            map_bits(isa, m, bits, got);
+            double err = 0.0;
+            for (std::size_t v = 0; v < count; ++v) {
+                err = std::max(err, std::abs(std::complex<double>(got[v]) - want[v]));
+            }
+            char detail[64];
+            std::snprintf(detail, sizeof detail, "max error %.2e", err);
+            report.check(std::string("ieee80211.mapping.") + to_string(m) + "." + to_string(isa),
+                         err < 1e-6, detail);
+        }
+    }
+}
+
+void check_frames(Report& report) {
+    PhyConfig base;
+    base.interleave = true;
+    FrameCodec codec(base);
+    std::mt19937 rng(3);
+    std::size_t errors = 0, frames = 0;
+    std::vector<cf32> samples(kMaxFrameSamples);
+    for (Modulation m : kModulations) {
+        for (CodeRate r : kRates) {
+            if (!is_ieee80211a_rate(m, r)) {
+                continue;
+            }
+            const SignalField field{m, r, std::uint16_t(1 + rng() % kMaxFrameBytes)};
+            const std::size_t n_bits = 8 * std::size_t(field.length);
+            const PackedBits payload = packed(random_bits(n_bits, rng));
+            const std::span<cf32> frame(samples.data(), frame_samples(field));
+            codec.encode(field, payload.view(), frame);
+            const std::optional<SignalField> parsed = codec.decode_signal(frame);
+            PackedBits decoded(n_bits);
+            if (parsed && *parsed == field) {
+                codec.decode_payload(field, frame.subspan(kSignalSamples), decoded.view());
+                errors += count_bit_errors(payload.view(), decoded.view());
+            } else {
+                errors += n_bits;
+            }
+            ++frames;
+        }
+    }
+    report.check("ieee80211.frame.roundtrip", errors == 0,
+                 std::to_string(frames) + " rates, " + std::to_string(errors) + " bit errors");
+}
+
+/// Detections on a stream that starts `skip` samples into a preamble and
+/// holds a second, whole frame after it, fed in uneven pieces.
+std::vector<SyncDetection> sync_detections(const SyncConfig& config, std::size_t skip, Isa isa,
+                                           std::uint64_t& false_alarms) {
+    std::mt19937 rng(17);
+    std::normal_distribution<float> g(0.0f, 1.0f);
+    const std::span<const cf32> preamble = Preamble80211::samples();
+    std::vector<cf32> stream(preamble.begin() + std::ptrdiff_t(skip), preamble.end());
+    const auto payload_and_gap = [&] {
+        for (std::size_t k = 0; k < config.payload_samples; ++k) {
+            stream.push_back(cf32(g(rng), g(rng)) * 0.7f);
+        }
+        stream.resize(stream.size() + 600);
+    };
+    payload_and_gap();
+    stream.insert(stream.end(), preamble.begin(), preamble.end());
+    payload_and_gap();
+    for (cf32& s : stream) {
+        s += cf32(g(rng), g(rng)) * 0.01f;
+    }
+
+    PacketSync sync(config, isa);
+    std::vector<SyncDetection> found;
+    for (std::size_t at = 0; at < stream.size(); at += 97) {
+        const std::size_t n = std::min<std::size_t>(97, stream.size() - at);
+        sync.process(std::span<const cf32>(stream).subspan(at, n),
+                     [&](const SyncDetection& d, std::span<const cf32>) { found.push_back(d); });
+    }
+    false_alarms = sync.false_alarms();
+    return found;
+}
+
+void check_sync(Report& report) {
+    SyncConfig config;
+    config.payload_samples = 400;
+    config.window = 16;
+    config.plateau = 16;
+    const std::uint64_t gap = config.payload_samples + 600;
+    // A cut preamble adds one false alarm to those the whole stream has.
+    std::uint64_t whole_false_alarms = 0;
+    for (std::size_t skip : {0, 100, 110, 120}) {
+        // The second frame starts after the remainder of the first.
+        const std::uint64_t second = Preamble80211::length - skip + gap;
+        std::uint64_t false_alarms = 0;
+        const std::vector<SyncDetection> found =
+            sync_detections(config, skip, Isa::scalar, false_alarms);
+        std::string detail;
+        for (const SyncDetection& d : found) {
+            detail += (detail.empty() ? "starts " : ",") + std::to_string(d.start);
+        }
+        if (skip == 0) {
+            whole_false_alarms = false_alarms;
+        }
+        const bool pass = skip == 0 ? found.size() == 2 && found[0].start == 0 &&
+                                          found[1].start == second
+                                    : found.size() == 1 && found[0].start == second &&
+                                          false_alarms == whole_false_alarms + 1;
+        detail += ", " + std::to_string(false_alarms) + " false alarms";
+        report.check("ieee80211.sync.skip_" + std::to_string(skip), pass, detail);
+    }
+
+    std::size_t unavailable = 0, threw = 0;
+    for (Isa isa : {Isa::avx2, Isa::avx512, Isa::neon}) {
+        if (isa_available(isa)) {
+            continue;
+        }
+        ++unavailable;
+        try {
+            PacketSync sync(config, isa);
+        } catch (const std::invalid_argument&) {
+            ++threw;
+        }
+    }
+    report.check("ieee80211.sync.unavailable_isa", threw == unavailable,
+                 std::to_string(threw) + " of " + std::to_string(unavailable) + " rejected");
+}
+
+// ------------------------------------------------------------------ 3GPP
+
+template <CrcSpec Spec>
+std::string crc_cross_isa(std::mt19937& rng) {
+    std::vector<std::uint8_t> message(3000);
+    for (auto& b : message) {
+        b = std::uint8_t(rng());
+    }
+    for (Isa isa : available_isas()) {
+        for (std::size_t n : {0, 1, 7, 63, 64, 65, 255, 1500, 3000}) {
+            const std::span<const std::uint8_t> part(message.data(), n);
+            if (Crc<Spec>(isa).update(part).value() != Crc<Spec>(Isa::scalar).update(part).value()) {
+                return std::string(to_string(isa)) + " differs at " + std::to_string(n) + " bytes";
+            }
+        }
+    }
+    return {};
+}
+
+void check_crc(Report& report) {
+    const char* text = "123456789";
+    const std::span<const std::uint8_t> check(reinterpret_cast<const std::uint8_t*>(text), 9);
+    const struct {
+        const char* name;
+        std::uint32_t got, want;
+    } catalogue[] = {
+        {"3gpp.crc24a.check", Crc24a::compute(check), 0xcde703},
+        {"3gpp.crc24b.check", Crc24b::compute(check), 0x23ef52},
+        {"3gpp.crc16.check", Crc16::compute(check), 0x31c3},
+        {"ieee80211.fcs.check", Crc32::compute(check), 0xcbf43926},
+    };
+    for (const auto& c : catalogue) {
+        char detail[48];
+        std::snprintf(detail, sizeof detail, "0x%x (want 0x%x)", c.got, c.want);
+        report.check(c.name, c.got == c.want, detail);
+    }
+
+    std::vector<std::uint8_t> bits(9 * 8 + 24);
+    for (std::size_t i = 0; i < 9 * 8; ++i) {
+        bits[i] = std::uint8_t(check[i / 8] >> (7 - i % 8) & 1u);
+    }
+    report.check("3gpp.crc24a.bits", crc24a(std::span(bits).first(72)) == 0xcde703);
+    crc24_attach(kCrc24aPoly, bits);
+    report.check("3gpp.crc24a.attached_zero", crc24a(bits) == 0);
+
+    std::mt19937 rng(4);
+    expect_equal(report, "isa.crc24a", crc_cross_isa<kCrc24a>(rng));
+    expect_equal(report, "isa.crc24b", crc_cross_isa<kCrc24b>(rng));
+    expect_equal(report, "isa.crc24c", crc_cross_isa<kCrc24c>(rng));
+    expect_equal(report, "isa.crc16", crc_cross_isa<kCrc16>(rng));
+    expect_equal(report, "isa.crc32", crc_cross_isa<kCrc32>(rng));
+}
+
+/// TS 38.211 5.2.1 from the recurrences of x1 and x2.
+std::vector<std::uint8_t> reference_gold(std::uint32_t c_init, std::size_t n) {
+    constexpr std::size_t kNc = 1600;
+    std::vector<std::uint8_t> x1(n + kNc + 31), x2(n + kNc + 31);
+    x1[0] = 1;
+    for (std::size_t i = 0; i < 31; ++i) {
+        x2[i] = std::uint8_t(c_init >> i & 1u);
+    }
+    for (std::size_t i = 0; i + 31 < x1.size(); ++i) {
+        x1[i + 31] = x1[i + 3] ^ x1[i];
+        x2[i + 31] = x2[i + 3] ^ x2[i + 2] ^ x2[i + 1] ^ x2[i];
+    }
+    std::vector<std::uint8_t> c(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        c[i] = x1[i + kNc] ^ x2[i + kNc];
+    }
+    return c;
+}
+
+void check_gold(Report& report) {
+    for (std::uint32_t c_init : {0u, 1u, 0x1234567u, 0x7fffffffu}) {
+        const std::vector<std::uint8_t> want = reference_gold(c_init, 2000);
+        GoldSequence gold(c_init);
+        std::vector<std::uint8_t> got(want.size());
+        gold.apply(std::vector<std::uint8_t>(want.size()), got);
+        gold.reset(c_init);
+        PackedBits got_packed(want.size());
+        gold.apply(PackedBits(want.size()).view(), got_packed.view());
+        char name[48];
+        std::snprintf(name, sizeof name, "3gpp.gold.c_init_%x", c_init);
+        expect_equal(report, name, mismatch(got, want));
+        expect_equal(report, std::string(name) + "_packed",
+                     mismatch(unpacked(got_packed.view()), want));
+    }
+}
+
+void check_qpp(Report& report) {
+    for (const QppEntry& e : kQppTable) {
+        const QppInterleaver pi(e.k);
+        report.check("3gpp.qpp.table_k" + std::to_string(e.k), pi.f1() == e.f1 && pi.f2() == e.f2,
+                     std::to_string(pi.f1()) + ", " + std::to_string(pi.f2()));
+    }
+    std::size_t sizes = 0;
+    std::string diff;
+    for (std::size_t k = 40; k <= 6144 && diff.empty(); ++k) {
+        if (!QppInterleaver::supported(k)) {
+            continue;
+        }
+        ++sizes;
+        const QppInterleaver pi(k);
+        std::vector<std::uint8_t> seen(k);
+        for (std::size_t i = 0; i < k; ++i) {
+            const std::size_t j = pi(i);
+            if (j >= k || seen[j] || j != (pi.f1() * i + pi.f2() * i * i) % k) {
+                diff = "K = " + std::to_string(k) + " at " + std::to_string(i);
+                break;
+            }
+            seen[j] = 1;
+        }
+    }
+    report.check("3gpp.qpp.permutations", diff.empty() && sizes == 188,
+                 diff.empty() ? std::to_string(sizes) + " sizes" : diff);
+}
+
+// ------------------------------------------------------------- decoders
+
+/// BPSK LLRs of `bits`, noiseless (noise 0) or over AWGN of std dev sigma.
+std::vector<float> llrs_of(const std::vector<std::uint8_t>& bits, double sigma,
+                           std::mt19937& rng) {
+    std::normal_distribution<double> noise(0.0, sigma);
+    std::vector<float> llrs(bits.size());
+    for (std::size_t i = 0; i < bits.size(); ++i) {
+        const double y = (bits[i] ? -1.0 : 1.0) + (sigma > 0.0 ? noise(rng) : 0.0);
+        llrs[i] = float(2.0 * y / (sigma > 0.0 ? sigma * sigma : 0.25));
+    }
+    return llrs;
+}
+
+void check_viterbi(Report& report) {
+    std::mt19937 rng(5);
+    for (CodeRate rate : kRates) {
+        const std::vector<std::uint8_t> info = random_bits(777, rng);
+        std::vector<std::uint8_t> coded = reference_conv(info);
+        coded = reference_puncture(rate, coded);
+        const std::vector<float> clean = llrs_of(coded, 0.0, rng);
+        const std::vector<float> noisy = llrs_of(coded, 0.8, rng);
+        std::vector<std::uint8_t> reference(info.size());
+        ViterbiDecoder(Isa::scalar).decode(noisy, reference, rate);
+        for (Isa isa : available_isas()) {
+            const std::string name =
+                std::string("viterbi.") + to_string(rate) + "." + to_string(isa);
+            ViterbiDecoder decoder(isa);
+            std::vector<std::uint8_t> out(info.size());
+            decoder.decode(clean, out, rate);
+            expect_equal(report, name + ".noiseless", mismatch(out, info));
+            decoder.decode(noisy, out, rate);
+            expect_equal(report, name + ".matches_scalar", mismatch(out, reference));
+        }
+    }
+}
+
+void check_turbo(Report& report) {
+    std::mt19937 rng(6);
+    for (std::size_t k : {40, 1056, 6144}) {
+        const QppInterleaver pi(k);
+        std::vector<std::uint8_t> info = random_bits(k, rng);
+        crc24_attach(kCrc24bPoly, info);
+        std::vector<std::uint8_t> coded(turbo_coded_bits(k));
+        turbo_encode(pi, info, coded);
+        const std::vector<float> clean = llrs_of(coded, 0.0, rng);
+        const std::vector<float> noisy = llrs_of(coded, 1.0, rng);
+        std::vector<std::uint8_t> reference(k);
+        const TurboResult ref = TurboDecoder(k, {}, Isa::scalar).decode(noisy, reference);
+        for (Isa isa : available_isas()) {
+            const std::string name = "turbo.k" + std::to_string(k) + "." + to_string(isa);
+            TurboDecoder decoder(k, {}, isa);
+            std::vector<std::uint8_t> out(k);
+            const TurboResult r = decoder.decode(clean, out);
+            const std::string diff = mismatch(out, info);
+            report.check(name + ".noiseless", diff.empty() && r.crc_ok, diff);
+            const TurboResult n = decoder.decode(noisy, out);
+            std::string same = mismatch(out, reference);
+            if (same.empty() && (n.crc_ok != ref.crc_ok || n.half_iterations != ref.half_iterations)) {
+                same = "iterations or CRC differ";
+            }
+            expect_equal(report, name + ".matches_scalar", same);
+        }
+    }
+
+    // Past the waterfall (about 0.5 dB Eb/N0 at K = 6144) every codeblock
+    // must come back error free, with the CRC stopping the decoder early,
+    // although the channel flips about one bit in six.
+    constexpr std::size_t k = 6144;
+    constexpr double ebn0_db = 1.5;
+    const double rate = double(k) / double(turbo_coded_bits(k));
+    const double sigma = std::sqrt(1.0 / (2.0 * rate * std::pow(10.0, ebn0_db / 10.0)));
+    const QppInterleaver pi(k);
+    std::vector<std::vector<std::uint8_t>> infos;
+    std::vector<std::vector<float>> received;
+    std::size_t flipped = 0;
+    for (int block = 0; block < 4; ++block) {
+        std::vector<std::uint8_t> info = random_bits(k, rng);
+        crc24_attach(kCrc24bPoly, info);
+        std::vector<std::uint8_t> coded(turbo_coded_bits(k));
+        turbo_encode(pi, info, coded);
+        received.push_back(llrs_of(coded, sigma, rng));
+        for (std::size_t i = 0; i < coded.size(); ++i) {
+            flipped += (received.back()[i] < 0.0f) != (coded[i] != 0);
+        }
+        infos.push_back(std::move(info));
+    }
+    const TurboDecoderOptions options;
+    for (Isa isa : available_isas()) {
+        TurboDecoder decoder(k, options, isa);
+        std::vector<std::uint8_t> out(k);
+        std::string diff;
+        unsigned most = 0;
+        for (std::size_t b = 0; b < infos.size() && diff.empty(); ++b) {
+            const TurboResult r = decoder.decode(received[b], out);
+            most = std::max(most, r.half_iterations);
+            diff = mismatch(out, infos[b]);
+            if (diff.empty() && !r.crc_ok) {
+                diff = "CRC failed";
+            } else if (diff.empty() && r.half_iterations >= 2 * options.max_iterations) {
+                diff = "no early stop";
+            }
+            if (!diff.empty()) {
+                diff += " in block " + std::to_string(b);
+            }
+        }
+        report.check("turbo.k6144." + std::string(to_string(isa)) + ".corrects_1.5dB",
+                     diff.empty() && flipped > 0,
+                     diff.empty() ? std::to_string(flipped) + " channel errors, at most " +
+                                        std::to_string(most) + " half-iterations"
+                                  : diff);
+    }
+}
+
+void check_ldpc(Report& report) {
+    std::mt19937 rng(7);
+    const LdpcCode code(LdpcBaseGraph::ieee80211_648_r12(), 27);
+    const std::vector<std::uint8_t> info = random_bits(code.k(), rng);
+    std::vector<std::uint8_t> codeword(code.n());
+    code.encode(info, codeword);
+    report.check("ldpc.648.encode_checks", code.check(codeword));
+    report.check("ldpc.648.systematic", std::equal(info.begin(), info.end(), codeword.begin()));
+    const std::vector<float> clean = llrs_of(codeword, 0.0, rng);
+    const std::vector<float> noisy = llrs_of(codeword, 0.9, rng);
+    std::vector<std::uint8_t> reference(code.k());
+    const LdpcResult ref = LdpcDecoder(code, {}, Isa::scalar).decode(noisy, reference);
+    for (Isa isa : available_isas()) {
+        const std::string name = std::string("ldpc.648.") + to_string(isa);
+        LdpcDecoder decoder(code, {}, isa);
+        std::vector<std::uint8_t> out(code.k());
+        const LdpcResult r = decoder.decode(clean, out);
+        const std::string diff = mismatch(out, info);
+        report.check(name + ".noiseless", diff.empty() && r.converged, diff);
+        const LdpcResult n = decoder.decode(noisy, out);
+        std::string same = mismatch(out, reference);
+        if (same.empty() && (n.converged != ref.converged || n.iterations != ref.iterations)) {
+            same = "iterations or convergence differ";
+        }
+        expect_equal(report, name + ".matches_scalar", same);
+    }
+}
+
+// -------------------------------------------------------- sample stages
+
+void check_fft(Report& report) {
+    std::mt19937 rng(8);
+    std::normal_distribution<float> g(0.0f, 1.0f);
+    for (std::size_t n : {64, 256, 2048}) {
+        std::vector<cf32> x(n);
+        for (cf32& v : x) {
+            v = {g(rng), g(rng)};
+        }
+        std::vector<std::complex<double>> want(n);
+        double norm = 0.0;
+        for (std::size_t k = 0; k < n; ++k) {
+            std::complex<double> acc = 0.0;
+            for (std::size_t t = 0; t < n; ++t) {
+                const double a = -2.0 * std::numbers::pi * double(k * t % n) / double(n);
+                acc += std::complex<double>(x[t]) * std::polar(1.0, a);
+            }
+            want[k] = acc;
+            norm = std::max(norm, std::abs(acc));
+        }
+        for (Isa isa : available_isas()) {
+            const FftPlan plan(n, isa);
+            std::vector<cf32> y = x;
+            plan.forward(y);
+            double err = 0.0;
+            for (std::size_t k = 0; k < n; ++k) {
+                err = std::max(err, std::abs(std::complex<double>(y[k]) - want[k]) / norm);
+            }
+            plan.inverse(y);
+            double back = 0.0;
+            for (std::size_t t = 0; t < n; ++t) {
+                back = std::max(back, std::abs(std::complex<double>(y[t]) / double(n) -
+                                               std::complex<double>(x[t])));
+            }
+            char detail[64];
+            std::snprintf(detail, sizeof detail, "rel error %.2e, inverse %.2e", err, back);
+            report.check("fft.n" + std::to_string(n) + "." + to_string(isa),
+                         err < 1e-5 && back < 1e-4, detail);
+        }
+    }
+}
+
+/// The documented error bounds of fast_math.hpp against libm in double.
+void check_fast_math(Report& report) {
+    char detail[64];
+    double err = 0.0;
+    for (std::uint64_t p = 0; p < (std::uint64_t(1) << 32); p += 4093) {
+        float c, s;
+        nco_sincos(std::uint32_t(p), c, s);
+        const double a = 2.0 * std::numbers::pi * std::ldexp(double(p), -32);
+        err = std::max({err, std::abs(c - std::cos(a)), std::abs(s - std::sin(a))});
+    }
+    std::snprintf(detail, sizeof detail, "max error %.2e", err);
+    report.check("math.nco_sincos", err <= 1.2e-7, detail);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> u(-100.0f, 100.0f);
+    err = 0.0;
+    const auto atan2_error = [&](float y, float x) {
+        double d = std::abs(fast_atan2(y, x) - std::atan2(double(y), double(x)));
+        err = std::max(err, std::min(d, 2.0 * std::numbers::pi - d));
+    };
+    for (int i = -500; i <= 500; ++i) {
+        for (int j = -500; j <= 500; ++j) {
+            atan2_error(float(i) / 250.0f, float(j) / 250.0f);
+        }
+    }
+    for (int i = 0; i < 1000000; ++i) {
+        atan2_error(u(rng), u(rng));
+    }
+    std::snprintf(detail, sizeof detail, "max error %.2e", err);
+    report.check("math.fast_atan2", err <= 3e-7 && fast_atan2(0.0f, 0.0f) == 0.0f, detail);
+
+    err = 0.0;
+    for (int i = -200000; i <= 200000; ++i) {
+        const float d = float(i) / 10000.0f;
+        err = std::max(err, std::abs(jacobian_log(d) - std::log1p(std::exp(-std::abs(double(d))))));
+    }
+    std::snprintf(detail, sizeof detail, "max error %.2e", err);
+    report.check("math.jacobian_log", err <= 1.3e-4, detail);
+}
+
+void check_cross_isa(Report& report) {
+    std::mt19937 rng(9);
+    std::normal_distribution<float> g(0.0f, 1.0f);
+    const std::vector<Isa> isas = available_isas();
+
+    for (Modulation m : kModulations) {
+        const std::size_t symbols = 1000;
+        const std::vector<std::uint8_t> bits = random_bits(symbols * bits_per_symbol(m), rng);
+        std::vector<cf32> noisy(symbols);
+        map_bits(Isa::scalar, m, bits, noisy);
+        for (cf32& s : noisy) {
+            s += cf32(0.2f * g(rng), 0.2f * g(rng));
+        }
+        std::vector<cf32> ref_symbols(symbols);
+        std::vector<float> ref_llrs(bits.size());
+        map_bits(Isa::scalar, m, bits, ref_symbols);
+        demap_maxlog(Isa::scalar, m, noisy, 0.08f, ref_llrs);
+        for (Isa isa : isas) {
+            std::vector<cf32> s(symbols);
+            std::vector<float> llrs(bits.size());
+            map_bits(isa, m, bits, s);
+            demap_maxlog(isa, m, noisy, 0.08f, llrs);
+            const std::string name = std::string("isa.") + to_string(m) + "." + to_string(isa);
+            expect_equal(report, name + ".map", bitwise_mismatch(s, ref_symbols));
+            expect_equal(report, name + ".demap", bitwise_mismatch(llrs, ref_llrs));
+        }
+    }
+
+    const std::vector<std::uint8_t> bits = random_bits(10007, rng);
+    for (Isa isa : isas) {
+        PackedBits p(bits.size());
+        pack_bits(isa, bits, p.view());
+        std::vector<std::uint8_t> back(bits.size());
+        unpack_bits(isa, p.view(), back);
+        expect_equal(report, std::string("isa.bits.") + to_string(isa) + ".roundtrip",
+                     mismatch(back, bits));
+    }
+
+    std::vector<cf32> ref_noise(4099);
+    GaussianNoise(42, 3, Isa::scalar).fill(ref_noise, 0.5f);
+    for (Isa isa : isas) {
+        std::vector<cf32> noise(ref_noise.size());
+        GaussianNoise(42, 3, isa).fill(noise, 0.5f);
+        expect_equal(report, std::string("isa.noise.") + to_string(isa),
+                     bitwise_mismatch(noise, ref_noise));
+    }
+
+    std::vector<cf32> input(1000);
+    for (cf32& v : input) {
+        v = {g(rng), g(rng)};
+    }
+    const ResampleRatio ratio{3, 2};
+    std::vector<cf32> ref_out;
+    for (Isa isa : isas) {
+        PolyphaseResampler resampler(ratio, {}, isa);
+        std::vector<cf32> out(resampler.output_size(input.size()));
+        out.resize(resampler.process(input, out));
+        if (isa == Isa::scalar) {
+            ref_out = out;
+        }
+        expect_equal(report, std::string("isa.resampler.") + to_string(isa),
+                     bitwise_mismatch(out, ref_out));
+    }
+
+    std::vector<cf32> ref_mixed(input.size());
+    std::vector<float> ref_angles(input.size());
+    nco_mix(Isa::scalar, input, 0x9e3779b9u, nco_phase(-0.0123), ref_mixed);
+    fast_angle(Isa::scalar, input, ref_angles);
+    for (Isa isa : isas) {
+        std::vector<cf32> mixed(input.size());
+        std::vector<float> angles(input.size());
+        nco_mix(isa, input, 0x9e3779b9u, nco_phase(-0.0123), mixed);
+        fast_angle(isa, input, angles);
+        expect_equal(report, std::string("isa.math.nco_mix.") + to_string(isa),
+                     bitwise_mismatch(mixed, ref_mixed));
+        expect_equal(report, std::string("isa.math.angle.") + to_string(isa),
+                     bitwise_mismatch(angles, ref_angles));
+    }
+
+    HarqConfig config;
+    config.users = 2;
+    config.processes = 2;
+    config.page_bytes = 64;
+    config.budget_bytes = 64 * 24;
+    std::vector<std::int8_t> ref_soft;
+    for (Isa isa : isas) {
+        std::mt19937 local(10);
+        std::normal_distribution<float> llr(0.0f, 8.0f);
+        HarqSoftBuffers harq(config, isa);
+        std::vector<std::int8_t> soft;
+        for (int t = 0; t < 200; ++t) {
+            const std::size_t user = local() % 2, process = local() % 2;
+            const std::size_t length = 400 + local() % 3 * 101;
+            std::vector<float> llrs(local() % length);
+            for (float& v : llrs) {
+                v = llr(local);
+            }
+            harq.combine(user, process, length, local() % length, llrs, local() % 4 == 0);
+            std::vector<std::int8_t> out(length);
+            harq.read(user, process, out);
+            soft.insert(soft.end(), out.begin(), out.end());
+        }
+        if (isa == Isa::scalar) {
+            ref_soft = soft;
+        }
+        expect_equal(report, std::string("isa.harq.") + to_string(isa), mismatch(soft, ref_soft));
+    }
+}
+
+/// The kernels behind sync, MIMO detection, the complex layouts and the
+/// fading channel, each ISA against Isa::scalar bit for bit.
+void check_cross_isa_dsp(Report& report) {
+    std::mt19937 rng(11);
+    std::normal_distribution<float> g(0.0f, 1.0f);
+    const std::vector<Isa> isas = available_isas();
+    const auto random_samples = [&](std::size_t n) {
+        std::vector<cf32> v(n);
+        for (cf32& x : v) {
+            x = {g(rng), g(rng)};
+        }
+        return v;
+    };
+
+    SyncConfig sync_config;
+    sync_config.payload_samples = 400;
+    std::vector<SyncDetection> ref_found;
+    std::uint64_t ref_false_alarms = 0;
+    for (Isa isa : isas) {
+        std::uint64_t false_alarms = 0;
+        const std::vector<SyncDetection> found =
+            sync_detections(sync_config, 0, isa, false_alarms);
+        if (isa == Isa::scalar) {
+            ref_found = found;
+            ref_false_alarms = false_alarms;
+        }
+        std::string diff = false_alarms != ref_false_alarms ? "false alarms differ" : "";
+        if (diff.empty() && found.size() != ref_found.size()) {
+            diff = "detections differ";
+        }
+        for (std::size_t i = 0; diff.empty() && i < found.size(); ++i) {
+            const SyncDetection& a = found[i];
+            const SyncDetection& b = ref_found[i];
+            if (a.start != b.start || std::memcmp(&a.cfo, &b.cfo, sizeof a.cfo) != 0 ||
+                std::memcmp(&a.gain, &b.gain, sizeof a.gain) != 0 ||
+                std::memcmp(&a.quality, &b.quality, sizeof a.quality) != 0) {
+                diff = "detection " + std::to_string(i) + " differs";
+            }
+        }
+        if (diff.empty() && found.size() != 2) {
+            diff = std::to_string(found.size()) + " detections";
+        }
+        expect_equal(report, std::string("isa.sync.") + to_string(isa), diff);
+    }
+
+    // 53 subcarriers, so every kernel runs a tail.
+    constexpr std::size_t kSubcarriers = 53;
+    const auto planes = [](const SubcarrierMatrix& m) {
+        std::vector<cf32> v;
+        for (std::size_t i = 0; i < m.rows(); ++i) {
+            for (std::size_t j = 0; j < m.cols(); ++j) {
+                for (std::size_t k = 0; k < m.subcarriers(); ++k) {
+                    v.push_back(m.at(i, j, k));
+                }
+            }
+        }
+        return v;
+    };
+    using Shape = std::pair<std::size_t, std::size_t>;  // rx, streams
+    for (const auto& [rx, streams] : {Shape{2, 2}, Shape{4, 2}, Shape{4, 4}}) {
+        SubcarrierMatrix h(rx, streams, kSubcarriers), y(rx, 1, kSubcarriers);
+        for (std::size_t k = 0; k < kSubcarriers; ++k) {
+            for (std::size_t r = 0; r < rx; ++r) {
+                for (std::size_t t = 0; t < streams; ++t) {
+                    h.set(r, t, k, {g(rng), g(rng)});
+                }
+                y.set(r, 0, k, {g(rng), g(rng)});
+            }
+        }
+        for (MimoDetector detector : {MimoDetector::zf, MimoDetector::mmse}) {
+            std::vector<cf32> ref_weights, ref_x;
+            std::vector<float> ref_noise;
+            for (Isa isa : isas) {
+                MimoEqualizer eq(rx, streams, detector, isa);
+                eq.prepare(h, 0.1f);
+                SubcarrierMatrix x;
+                eq.apply(y, x);
+                std::vector<float> noise;
+                for (std::size_t t = 0; t < streams; ++t) {
+                    noise.insert(noise.end(), eq.noise(t).begin(), eq.noise(t).end());
+                }
+                if (isa == Isa::scalar) {
+                    ref_weights = planes(eq.weights());
+                    ref_x = planes(x);
+                    ref_noise = noise;
+                }
+                const std::string name = "isa.mimo." + std::to_string(rx) + "x" +
+                                         std::to_string(streams) + "." + to_string(detector) +
+                                         "." + to_string(isa);
+                expect_equal(report, name + ".weights",
+                             bitwise_mismatch(planes(eq.weights()), ref_weights));
+                expect_equal(report, name + ".detect", bitwise_mismatch(planes(x), ref_x));
+                expect_equal(report, name + ".noise", bitwise_mismatch(noise, ref_noise));
+            }
+        }
+    }
+
+    // Odd length, so both layouts run a tail.
+    const std::vector<cf32> a = random_samples(1001), b = random_samples(1001);
+    ComplexBuffer<Split> split_a(a.size()), split_b(a.size()), split_out(a.size());
+    convert(Isa::scalar, a, split_a.view());
+    convert(Isa::scalar, b, split_b.view());
+    const auto unsplit = [](const ComplexBuffer<Split>& x) {
+        std::vector<cf32> v(x.size());
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            v[i] = x.get(i);
+        }
+        return v;
+    };
+    std::vector<cf32> ref_product, ref_conj;
+    std::vector<float> ref_power;
+    for (Isa isa : isas) {
+        std::vector<cf32> product(a.size()), conj_product(a.size()), back(a.size());
+        std::vector<float> power(a.size()), split_power(a.size());
+        multiply(isa, a, b, product);
+        multiply_conj(isa, a, b, conj_product);
+        magnitude_squared(isa, a, power);
+        if (isa == Isa::scalar) {
+            ref_product = product;
+            ref_conj = conj_product;
+            ref_power = power;
+        }
+        const std::string name = std::string("isa.layout.") + to_string(isa);
+        ComplexBuffer<Split> converted(a.size());
+        convert(isa, a, converted.view());
+        convert(isa, converted.view(), back);
+        expect_equal(report, name + ".convert",
+                     bitwise_mismatch(unsplit(converted), a) + bitwise_mismatch(back, a));
+        expect_equal(report, name + ".multiply", bitwise_mismatch(product, ref_product));
+        expect_equal(report, name + ".multiply_conj", bitwise_mismatch(conj_product, ref_conj));
+        expect_equal(report, name + ".magnitude_squared", bitwise_mismatch(power, ref_power));
+        multiply(isa, split_a.view(), split_b.view(), split_out.view());
+        std::string split_diff = bitwise_mismatch(unsplit(split_out), ref_product);
+        multiply_conj(isa, split_a.view(), split_b.view(), split_out.view());
+        split_diff += bitwise_mismatch(unsplit(split_out), ref_conj);
+        magnitude_squared(isa, split_a.view(), split_power);
+        split_diff += bitwise_mismatch(split_power, ref_power);
+        expect_equal(report, name + ".split", split_diff);
+    }
+
+    // Two calls, so the filter history crosses a call boundary.
+    const std::vector<cf32> input = random_samples(5000);
+    for (FadingProfile profile : {FadingProfile::epa, FadingProfile::eva, FadingProfile::etu}) {
+        FadingConfig config;
+        config.profile = profile;
+        config.doppler_hz = 70.0;
+        std::vector<cf32> ref_out;
+        for (Isa isa : isas) {
+            FadingChannel channel(config, 7, 3, isa);
+            std::vector<cf32> out(input.size());
+            const std::size_t half = 2311;
+            channel.process(std::span(input).first(half), std::span(out).first(half));
+            channel.process(std::span(input).subspan(half), std::span(out).subspan(half));
+            if (isa == Isa::scalar) {
+                ref_out = out;
+            }
+            expect_equal(report,
+                         std::string("isa.fading.") + to_string(profile) + "." + to_string(isa),
+                         bitwise_mismatch(out, ref_out));
+        }
+    }
+    std::size_t unavailable = 0, threw = 0;
+    for (Isa isa : {Isa::avx2, Isa::avx512, Isa::neon}) {
+        if (isa_available(isa)) {
+            continue;
+        }
+        ++unavailable;
+        try {
+            FadingChannel channel(FadingConfig{}, 7, 3, isa);
+        } catch (const std::invalid_argument&) {
+            ++threw;
+        }
+    }
+    report.check("isa.fading.unavailable_isa", threw == unavailable,
+                 std::to_string(threw) + " of " + std::to_string(unavailable) + " rejected");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string output = "test_output.txt";
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--output PATH]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Report report;
+    check_scrambler(report);
+    check_signal(report);
+    check_convolutional(report);
+    check_interleaver(report);
+    check_mapping(report);
+    check_frames(report);
+    check_sync(report);
+    check_crc(report);
+    check_gold(report);
+    check_qpp(report);
+    check_viterbi(report);
+    check_turbo(report);
+    check_ldpc(report);
+    check_fft(report);
+    check_fast_math(report);
+    check_cross_isa(report);
+    check_cross_isa_dsp(report);
+
+    std::string isas;
+    for (Isa isa : available_isas()) {
+        isas += std::string(isas.empty() ? "" : ",") + to_string(isa);
+    }
+    const std::vector<std::string> comments = {
+        "dcomm golden v1",
+        std::string("isa=") + to_string(active_isa()) + " tested=" + isas,
+        "ieee80211.* and 3gpp.* rows check standard vectors or reference models",
+        "isa.* and *.matches_scalar rows compare each ISA bit for bit with scalar",
+        std::to_string(report.failures()) + " failed",
+    };
+    report.write(stdout, comments);
+    std::FILE* f = std::fopen(output.c_str(), "w");
+    if (f == nullptr) {
+        std::perror(output.c_str());
+        return 1;
+    }
+    report.write(f, comments);
+    std::fclose(f);
+    return report.failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,247 @@
+// HARQ soft buffers: Chase and incremental-redundancy combining in both
+// formats against a saturating model, narrowing to int4 under memory
+// pressure before anything is evicted, least-recently-used eviction and
+// lost retransmissions, and the counters, on every available instruction
+// set.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/harq.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+using dcomm::test::expect_throws;
+
+constexpr float kScale = 4.0f;
+
+std::vector<Isa> available_isas() {
+    std::vector<Isa> isas;
+    for (Isa isa : {Isa::scalar, Isa::avx2, Isa::avx512, Isa::neon}) {
+        if (isa_available(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+int quantize(float llr, float scale, float limit) {
+    const float v = std::clamp(llr * scale, -limit, limit);
+    return int(v + (v < 0.0f ? -0.5f : 0.5f));
+}
+
+/// One soft buffer as HarqSoftBuffers documents it: saturating int8 sums,
+/// or int4 sums in steps of 8 after narrowing.
+struct Model {
+    bool s4 = false;
+    std::vector<int> v;
+
+    Model(std::size_t length, bool int4) : s4(int4), v(length) {}
+
+    void add(std::size_t offset, const std::vector<float>& llrs) {
+        for (std::size_t i = 0; i < llrs.size(); ++i) {
+            int& x = v[(offset + i) % v.size()];
+            x = s4 ? std::clamp(x + quantize(llrs[i], kScale / 8.0f, 7.0f), -7, 7)
+                   : std::clamp(x + quantize(llrs[i], kScale, 127.0f), -127, 127);
+        }
+    }
+
+    void narrow() {
+        for (int& x : v) {
+            const int r = std::min((std::abs(x) + 4) >> 3, 7);
+            x = x < 0 ? -r : r;
+        }
+        s4 = true;
+    }
+
+    std::vector<std::int8_t> values() const {
+        std::vector<std::int8_t> out;
+        for (int x : v) {
+            out.push_back(std::int8_t(s4 ? 8 * x : x));
+        }
+        return out;
+    }
+};
+
+std::vector<float> random_llrs(std::size_t n, std::mt19937& rng) {
+    std::uniform_real_distribution<float> u(-20.0f, 20.0f);
+    std::vector<float> llrs(n);
+    for (float& l : llrs) {
+        l = u(rng);
+    }
+    return llrs;
+}
+
+bool matches(const HarqSoftBuffers& h, std::size_t user, std::size_t process, const Model& m) {
+    std::vector<std::int8_t> out(m.v.size());
+    return h.read(user, process, out) && out == m.values() &&
+           h.format(user, process) == (m.s4 ? SoftFormat::int4 : SoftFormat::int8);
+}
+
+/// Chase combining, then incremental redundancy wrapping around the
+/// buffer, at odd offsets and lengths so int4 runs split byte pairs.
+void combining(Isa isa, SoftFormat format) {
+    const std::string tag = std::string(to_string(isa)) +
+                            (format == SoftFormat::int4 ? " int4" : " int8");
+    const bool s4 = format == SoftFormat::int4;
+    std::mt19937 rng(27);
+    HarqConfig config;
+    config.users = 4;
+    config.processes = 8;
+    config.format = format;
+    config.llr_scale = kScale;
+    HarqSoftBuffers h(config, isa);
+
+    Model chase(1001, s4);
+    for (int tx = 0; tx < 4; ++tx) {
+        const std::vector<float> llrs = random_llrs(1001, rng);
+        chase.add(0, llrs);
+        expect(h.combine(3, 5, 1001, 0, llrs, tx == 0) == (tx > 0),
+               (tag + ": retransmissions combine").c_str());
+    }
+    expect(matches(h, 3, 5, chase), (tag + ": Chase combining saturates per LLR").c_str());
+
+    Model ir(1501, s4);
+    bool partial = true;
+    std::size_t offset = 0;
+    for (std::size_t n : {601, 600, 777}) {
+        const std::vector<float> llrs = random_llrs(n, rng);
+        ir.add(offset, llrs);
+        h.combine(1, 0, 1501, offset, llrs, offset == 0);
+        partial = partial && matches(h, 1, 0, ir);
+        offset = (offset + n) % 1501;
+    }
+    expect(partial, (tag + ": redundancy versions land at their offsets, wrapping").c_str());
+    expect(h.stats().fresh == 2 && h.stats().combines == 5 && h.stats().lost == 0,
+           (tag + ": fresh and combined transmissions are counted").c_str());
+
+    // Another length means another codeword: the old soft bits are lost.
+    Model other(333, s4);
+    const std::vector<float> llrs = random_llrs(333, rng);
+    other.add(0, llrs);
+    expect(!h.combine(3, 5, 333, 0, llrs, false) && h.stats().lost == 1 &&
+               h.length(3, 5) == 333 && matches(h, 3, 5, other),
+           (tag + ": a retransmission of another length starts over").c_str());
+    h.release(3, 5);
+    std::vector<std::int8_t> out(333);
+    expect(!h.holds(3, 5) && !h.read(3, 5, out) && h.length(3, 5) == 0,
+           (tag + ": release() drops the buffer").c_str());
+}
+
+/// Four 128-byte pages; a 256-LLR buffer takes two as int8, one as int4.
+HarqConfig tight(bool compress) {
+    HarqConfig config;
+    config.budget_bytes = 512;
+    config.page_bytes = 128;
+    config.users = 8;
+    config.processes = 2;
+    config.llr_scale = kScale;
+    config.compress_under_pressure = compress;
+    return config;
+}
+
+void narrowing(Isa isa) {
+    const std::string tag = to_string(isa);
+    std::mt19937 rng(28);
+    HarqSoftBuffers h(tight(true), isa);
+    std::vector<Model> m(6, Model(256, false));
+    const auto send = [&](std::size_t user, bool new_data) {
+        const std::vector<float> llrs = random_llrs(256, rng);
+        h.combine(user, 1, 256, 0, llrs, new_data);
+        if (h.format(user, 1) == SoftFormat::int4 && !m[user].s4) {
+            // A buffer started under pressure is int4 from the outset.
+            m[user] = Model(256, true);
+        }
+        m[user].add(0, llrs);
+    };
+    send(0, true);
+    send(1, true);
+    expect(h.free_pages() == 0 && h.bytes_used() == 512,
+           (tag + ": two int8 buffers fill it").c_str());
+
+    // No room for a third: both older buffers are narrowed, it stays int8.
+    send(2, true);
+    m[0].narrow();
+    m[1].narrow();
+    expect(h.stats().compressions == 2 && h.stats().evictions == 0 &&
+               matches(h, 0, 1, m[0]) && matches(h, 1, 1, m[1]) && matches(h, 2, 1, m[2]),
+           (tag + ": least recently used buffers are narrowed first").c_str());
+    send(0, false);
+    expect(matches(h, 0, 1, m[0]), (tag + ": narrowed buffers keep combining").c_str());
+
+    // Then the last int8 buffer, then the new one starts as int4.
+    send(3, true);
+    m[2].narrow();
+    expect(h.stats().compressions == 4 && h.stats().evictions == 0 && h.free_pages() == 0 &&
+               matches(h, 2, 1, m[2]) && matches(h, 3, 1, m[3]) && m[3].s4,
+           (tag + ": a new buffer is narrowed before anything is evicted").c_str());
+
+    // Nothing left to narrow: the least recently used buffer goes.
+    send(4, true);
+    expect(h.stats().evictions == 1 && !h.holds(1, 1) && h.holds(0, 1) && h.holds(2, 1),
+           (tag + ": then the least recently used buffer is evicted").c_str());
+    m[1] = Model(256, false);
+    send(1, false);
+    expect(h.stats().lost == 1 && h.stats().evictions == 2 && !h.holds(2, 1) &&
+               matches(h, 1, 1, m[1]),
+           (tag + ": its retransmission is lost and starts over").c_str());
+}
+
+void eviction(Isa isa) {
+    const std::string tag = to_string(isa);
+    std::mt19937 rng(29);
+    HarqSoftBuffers h(tight(false), isa);
+    const std::vector<float> llrs = random_llrs(256, rng);
+    h.combine(0, 0, 256, 0, llrs, true);
+    h.combine(1, 0, 256, 0, llrs, true);
+    h.combine(0, 0, 256, 0, llrs, false);  // now the newest
+    h.combine(2, 0, 256, 0, llrs, true);
+    expect(h.holds(0, 0) && !h.holds(1, 0) && h.holds(2, 0) && h.stats().evictions == 1 &&
+               h.stats().compressions == 0 && h.format(2, 0) == SoftFormat::int8,
+           (tag + ": without compression the least recently used buffer is evicted").c_str());
+    h.release(0, 0);
+    expect(h.free_pages() == 2 && h.bytes_used() == 256, (tag + ": release() frees pages").c_str());
+}
+
+void invalid() {
+    HarqConfig config = tight(true);
+    config.page_bytes = 100;
+    expect_throws<std::invalid_argument>([&] { HarqSoftBuffers h(config); }, "page size");
+    config = tight(true);
+    config.users = 0;
+    expect_throws<std::invalid_argument>([&] { HarqSoftBuffers h(config); }, "no users");
+    config = tight(true);
+    config.budget_bytes = 64;
+    expect_throws<std::invalid_argument>([&] { HarqSoftBuffers h(config); }, "budget");
+    HarqSoftBuffers h(tight(true));
+    const std::vector<float> llrs(600, 1.0f);
+    expect_throws<std::invalid_argument>([&] { h.combine(0, 0, 600, 0, llrs, true); },
+                                         "a buffer larger than the budget");
+    for (Isa isa : {Isa::avx2, Isa::avx512, Isa::neon}) {
+        if (!isa_available(isa)) {
+            expect_throws<std::invalid_argument>([&] { HarqSoftBuffers u(tight(true), isa); },
+                                                 "unavailable ISA");
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    for (Isa isa : available_isas()) {
+        combining(isa, SoftFormat::int8);
+        combining(isa, SoftFormat::int4);
+        narrowing(isa);
+        eviction(isa);
+    }
+    invalid();
+    return dcomm::test::finish("harq");
+}
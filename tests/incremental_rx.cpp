@@ -0,0 +1,190 @@
+// IncrementalReceiver: frames fed in arbitrary pieces decode to what was
+// sent, back to back in one stream; the address filter drops foreign
+// frames after their header and skips the rest; bad SIGNAL symbols stop
+// the frame at the SIGNAL symbol.
+
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/frame.hpp"
+#include "dcomm/incremental_rx.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+using dcomm::test::expect_throws;
+
+using Address = std::array<std::uint8_t, 6>;
+
+struct Frame {
+    SignalField signal;
+    PackedBits payload;
+    std::vector<cf32> samples;
+};
+
+/// A frame whose payload carries `to` at bytes 4..9, as an 802.11 MAC
+/// header does, when it is that long, and random bytes elsewhere.
+Frame make_frame(FrameCodec& codec, const SignalField& signal, const Address& to,
+                 cf32 gain, std::mt19937& rng) {
+    std::vector<std::uint8_t> bytes(signal.length);
+    for (std::uint8_t& b : bytes) {
+        b = std::uint8_t(rng());
+    }
+    if (bytes.size() >= 10) {
+        std::copy(to.begin(), to.end(), bytes.begin() + 4);
+    }
+    Frame f{signal, PackedBits(8 * bytes.size()), std::vector<cf32>(frame_samples(signal))};
+    for (std::size_t i = 0; i < f.payload.size(); ++i) {
+        f.payload.set(i, (bytes[i / 8] >> (i % 8)) & 1u);
+    }
+    codec.encode(signal, f.payload.view(), f.samples);
+    for (cf32& s : f.samples) {
+        s *= gain;
+    }
+    return f;
+}
+
+/// Feeds `stream` in random pieces and returns the payloads delivered.
+/// Once a push uses fewer samples than given the frame is over: the
+/// receiver is restarted and the rest goes to the next frame.
+std::vector<PackedBits> receive(IncrementalReceiver& rx, const std::vector<cf32>& stream,
+                                std::mt19937& rng) {
+    std::vector<PackedBits> out;
+    const auto take = [&] {
+        if (rx.state() == IncrementalReceiver::State::done) {
+            out.emplace_back(rx.payload().size());
+            for (std::size_t i = 0; i < rx.payload().size(); ++i) {
+                out.back().set(i, rx.payload()[i]);
+            }
+        }
+    };
+    std::size_t at = 0;
+    while (at < stream.size()) {
+        const std::size_t n = std::min<std::size_t>(1 + rng() % 200, stream.size() - at);
+        const std::size_t used = rx.push(std::span(stream).subspan(at, n));
+        at += used;
+        if (used == n) {
+            continue;
+        }
+        take();
+        rx.reset();
+    }
+    take();
+    return out;
+}
+
+const Address kUs = {0x02, 0x11, 0x22, 0x33, 0x44, 0x55};
+const Address kThem = {0x02, 0x11, 0x22, 0x33, 0x44, 0x56};
+
+void pieces() {
+    std::mt19937 rng(26);
+    for (Equalizer eq : {Equalizer::none, Equalizer::pilot_zf}) {
+        PhyConfig base;
+        base.interleave = true;
+        base.equalizer = eq;
+        FrameCodec codec(base);
+        // pilot_zf undoes a flat channel; without it the channel is clear.
+        const cf32 gain = eq == Equalizer::pilot_zf ? std::polar(0.7f, 1.0f) : cf32(1.0f, 0.0f);
+        std::vector<Frame> frames;
+        std::vector<cf32> stream;
+        for (SignalField s : {SignalField{Modulation::bpsk, CodeRate::r1_2, 100},
+                              SignalField{Modulation::qpsk, CodeRate::r3_4, 1},
+                              SignalField{Modulation::qam16, CodeRate::r1_2, 523},
+                              SignalField{Modulation::qam64, CodeRate::r2_3, 1500},
+                              SignalField{Modulation::qam64, CodeRate::r3_4, 37}}) {
+            frames.push_back(make_frame(codec, s, kUs, gain, rng));
+            stream.insert(stream.end(), frames.back().samples.begin(),
+                          frames.back().samples.end());
+        }
+        IncrementalReceiver rx(base);
+        const std::vector<PackedBits> got = receive(rx, stream, rng);
+        bool same = got.size() == frames.size();
+        std::size_t symbols = 0;
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            symbols += payload_symbols(frames[i].signal);
+            same = same && got[i].size() == frames[i].payload.size() &&
+                   count_bit_errors(got[i].view(), frames[i].payload.view()) == 0;
+        }
+        expect(same, "frames fed in pieces decode to what was sent");
+        expect(rx.stats().frames == frames.size() && rx.stats().delivered == frames.size() &&
+                   rx.stats().symbols_decoded == symbols && rx.stats().symbols_skipped == 0,
+               "every payload symbol is decoded once");
+    }
+}
+
+void address_filter() {
+    std::mt19937 rng(27);
+    PhyConfig base;
+    FrameCodec codec(base);
+    const SignalField signal{Modulation::qpsk, CodeRate::r1_2, 1000};  // 167 symbols
+    const Frame ours = make_frame(codec, signal, kUs, cf32(1.0f, 0.0f), rng);
+    const Frame theirs = make_frame(codec, signal, kThem, cf32(1.0f, 0.0f), rng);
+    std::vector<cf32> stream;
+    for (const Frame* f : {&ours, &theirs, &ours}) {
+        stream.insert(stream.end(), f->samples.begin(), f->samples.end());
+    }
+
+    std::size_t asked = 0;
+    IncrementalReceiver rx(base, {10, [&](const SignalField& s, std::span<const std::uint8_t> h) {
+                                      ++asked;
+                                      return s == signal && h.size() == 10 &&
+                                             std::equal(kUs.begin(), kUs.end(), h.begin() + 4);
+                                  }});
+    const std::vector<PackedBits> got = receive(rx, stream, rng);
+    expect(got.size() == 2 && count_bit_errors(got[0].view(), ours.payload.view()) == 0 &&
+               count_bit_errors(got[1].view(), ours.payload.view()) == 0,
+           "frames to us are delivered, the foreign one is not");
+    expect(asked == 3, "the filter is asked once per frame");
+    const IncrementalReceiver::Stats& st = rx.stats();
+    expect(st.frames == 3 && st.delivered == 2 && st.dropped_filter == 1,
+           "the foreign frame counts as filtered");
+    // 80 header bits at 48 bits per symbol, plus the traceback delay.
+    expect(st.symbols_skipped > 0 && st.symbols_skipped + st.symbols_decoded == 3 * 167 &&
+               st.symbols_skipped > 167 - 10,
+           "it is dropped a few symbols in and its remaining samples skipped");
+
+    // With no header bytes the verdict comes straight after the SIGNAL symbol.
+    IncrementalReceiver none(base, {0, [](const SignalField&, std::span<const std::uint8_t>) {
+                                        return false;
+                                    }});
+    expect(none.push(ours.samples) == ours.samples.size() &&
+               none.state() == IncrementalReceiver::State::dropped &&
+               none.symbols_decoded() == 0 && none.stats().symbols_skipped == 167,
+           "a rejected SIGNAL skips the whole payload");
+}
+
+void bad_signal() {
+    std::mt19937 rng(28);
+    std::normal_distribution<float> g(0.0f, 1.0f);
+    std::vector<cf32> noise(4 * kSignalSamples);
+    for (cf32& s : noise) {
+        s = cf32(g(rng), g(rng));
+    }
+    IncrementalReceiver rx(PhyConfig{});
+    expect(rx.push(noise) == kSignalSamples && rx.state() == IncrementalReceiver::State::dropped,
+           "nothing past a bad SIGNAL symbol is used");
+    expect(rx.stats().dropped_signal == 1 && rx.push(noise) == 0, "and the frame stays dropped");
+    rx.reset();
+    expect(rx.state() == IncrementalReceiver::State::signal, "reset() waits for a SIGNAL symbol");
+
+    PhyConfig invalid;
+    invalid.symbols_per_block = 0;
+    expect_throws<std::invalid_argument>([&] { IncrementalReceiver bad(invalid); },
+                                         "invalid configuration");
+}
+
+}  // namespace
+
+int main() {
+    pieces();
+    address_filter();
+    bad_signal();
+    return dcomm::test::finish("incremental_rx");
+}
@@ -0,0 +1,156 @@
+// Instrumentation: per-thread probe slots summing exactly under
+// contention, the trace ring's wrap-around and Chrome JSON, the stage
+// report's bottleneck, and the chains charging every block to their
+// probes. With DCOMM_INSTRUMENTATION=OFF the probes must report nothing.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/instrument.hpp"
+#include "dcomm/pipeline.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+
+std::string contents(std::FILE* f) {
+    std::rewind(f);
+    std::string s;
+    char buf[4096];
+    while (std::size_t n = std::fread(buf, 1, sizeof buf, f)) {
+        s.append(buf, n);
+    }
+    return s;
+}
+
+std::size_t occurrences(const std::string& s, const char* what) {
+    std::size_t n = 0;
+    for (std::size_t at = s.find(what); at != std::string::npos; at = s.find(what, at + 1)) {
+        ++n;
+    }
+    return n;
+}
+
+void probes() {
+    StageProbe probe("stage");
+    constexpr int kThreads = 4, kBlocks = 5000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            for (int b = 0; b < kBlocks; ++b) {
+                probe.record(StageProbe::start(), 10);
+                probe.add_wait(3);
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    const StageStats s = probe.stats();
+    expect(std::strcmp(s.name, "stage") == 0, "stats carry the probe name");
+    if (kInstrumented) {
+        expect(s.blocks == kThreads * kBlocks && s.samples == 10u * kThreads * kBlocks &&
+                   s.wait_cycles == 3u * kThreads * kBlocks,
+               "slots of concurrent threads sum exactly");
+        expect(s.utilisation() > 0.0 && s.utilisation() <= 1.0, "utilisation is a share");
+        probe.clear();
+        expect(probe.stats().blocks == 0 && probe.stats().wait_cycles == 0, "clear()");
+    } else {
+        expect(s.blocks == 0 && s.busy_cycles == 0, "compiled-out probes count nothing");
+    }
+    expect(StageStats{}.utilisation() == 0.0, "an idle stage has zero utilisation");
+}
+
+void trace() {
+    TraceRing ring(5);
+    expect(ring.capacity() == 8, "capacity rounds up to a power of two");
+    for (std::uint32_t i = 0; i < 11; ++i) {
+        ring.push({"ev", 0, i, i, i + 1});
+    }
+    expect(ring.pushed() == 11, "pushed() counts overwritten events");
+    std::vector<std::uint32_t> kept;
+    ring.for_each([&](const TraceEvent& e) { kept.push_back(e.samples); });
+    expect(kept == std::vector<std::uint32_t>{3, 4, 5, 6, 7, 8, 9, 10},
+           "the newest events are kept, oldest first");
+
+    std::FILE* f = std::tmpfile();
+    ring.write_chrome_trace(f);
+    const std::string json = contents(f);
+    std::fclose(f);
+    expect(json.find("\"traceEvents\":[") != std::string::npos &&
+               occurrences(json, "\"ph\":\"X\"") == 8 && json.find("]}") != std::string::npos,
+           "Chrome trace JSON with one complete event per retained event");
+
+    StageProbe probe("traced");
+    probe.attach(&ring);
+    probe.record(StageProbe::start(), 64);
+    probe.attach(nullptr);
+    probe.record(StageProbe::start(), 64);
+    expect(ring.pushed() == (kInstrumented ? 12u : 11u), "only attached probes log events");
+}
+
+void report() {
+    StageStats stats[3];
+    stats[0] = {"fast", 10, 1000, 100, 900};
+    stats[1] = {"slow", 10, 1000, 5000, 0};
+    stats[2] = {"idle", 0, 0, 0, 0};
+    std::FILE* f = std::tmpfile();
+    write_stage_report(f, stats);
+    const std::string text = contents(f);
+    std::fclose(f);
+    if (kInstrumented) {
+        const std::size_t mark = text.find("<- bottleneck");
+        expect(occurrences(text, "<- bottleneck") == 1 && mark != std::string::npos &&
+                   text.rfind("slow", mark) > text.rfind("fast", mark),
+               "the stage with the most cycles per block is the bottleneck");
+    } else {
+        expect(text.find("compiled out") != std::string::npos, "the report says it is empty");
+    }
+}
+
+void chains() {
+    PhyConfig config;
+    TxChain tx(config);
+    RxChain rx(config);
+    TraceRing ring(256);
+    tx.attach_trace(&ring);
+    rx.attach_trace(&ring);
+    constexpr int kBlocks = 7;
+    for (int b = 0; b < kBlocks; ++b) {
+        rx.process(tx.process(tx.acquire_input()));
+    }
+    bool counted = true;
+    for (const StageStats& s : rx.stage_stats()) {
+        // The deinterleaver only runs when interleaving is on.
+        const bool runs = config.interleave || std::strcmp(s.name, "deinterleaver") != 0;
+        counted = counted && s.blocks == (kInstrumented && runs ? kBlocks : 0);
+    }
+    expect(counted, "every Rx stage is charged every block");
+    expect(tx.stage_stats().front().samples ==
+               (kInstrumented ? kBlocks * config.samples_per_block() : 0),
+           "stages count baseband samples");
+    std::uint64_t executions = 0;
+    for (const std::vector<StageStats>& stats : {tx.stage_stats(), rx.stage_stats()}) {
+        for (const StageStats& s : stats) {
+            executions += s.blocks;
+        }
+    }
+    expect(ring.pushed() == executions, "an attached trace logs every stage execution");
+    rx.clear_stage_stats();
+    expect(rx.stage_stats().front().blocks == 0, "clear_stage_stats()");
+}
+
+}  // namespace
+
+int main() {
+    probes();
+    trace();
+    report();
+    chains();
+    return dcomm::test::finish("instrument");
+}
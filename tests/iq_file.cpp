@@ -0,0 +1,142 @@
+// IQ recordings: SigMF metadata round trip, chunked writes (buffered and
+// O_DIRECT) read back through the mapping, format conversion with
+// saturation counting, view(), seek() and raw files.
+
+#include <complex>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+#include "check.hpp"
+#include "dcomm/iq_file.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+using dcomm::test::expect_throws;
+
+namespace fs = std::filesystem;
+
+std::vector<cf32> ramp(std::size_t n) {
+    std::vector<cf32> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = cf32(float(i % 1000) / 1000.0f, -float(i % 777) / 777.0f);
+    }
+    return v;
+}
+
+void sigmf_roundtrip(const fs::path& dir, bool direct) {
+    // Not a whole number of 4 KiB chunks, so close() writes a partial tail.
+    const std::vector<cf32> samples = ramp(3001);
+    const std::string path =
+        (dir / (direct ? "direct.sigmf-data" : "buffered.sigmf-data")).string();
+    SigmfMeta meta;
+    meta.sample_rate = 20e6;
+    meta.frequency = 2.412e9;
+    meta.description = "test \"capture\"\\1";
+    {
+        IqFileSink sink(path, meta, 4096, direct);
+        sink.write<cf32>(std::span(samples).first(1000));
+        sink.write<cf32>(std::span(samples).subspan(1000));
+        expect(sink.samples() == samples.size(), "sink counts samples");
+        sink.close();
+    }
+    expect(fs::file_size(path) == samples.size() * sizeof(cf32),
+           "the file holds exactly the samples written");
+
+    const SigmfMeta read = read_sigmf_meta(sigmf_meta_path(path));
+    expect(read.format == IqFormat::cf32 && read.sample_rate == meta.sample_rate &&
+               read.frequency == meta.frequency && read.description == meta.description,
+           "metadata round-trips, escapes included");
+
+    IqFileSource source(path);
+    expect(source.samples() == samples.size() && source.meta().sample_rate == 20e6,
+           "source takes size and rate from the recording");
+    std::vector<cf32> back, block(512);
+    while (std::size_t n = source.read<cf32>(block)) {
+        back.insert(back.end(), block.begin(), block.begin() + std::ptrdiff_t(n));
+    }
+    expect(back == samples, "samples read back bit for bit");
+    expect(source.remaining() == 0, "the whole file was read");
+
+    source.seek(2990);
+    const std::span<const cf32> tail = source.view<cf32>(100);
+    expect(tail.size() == 11 && tail[0] == samples[2990], "view() is in place and clamped");
+    source.seek(1u << 30);
+    expect(source.position() == samples.size(), "seek() clamps to the end");
+}
+
+void conversions(const fs::path& dir) {
+    const std::string path = (dir / "fixed.sigmf-data").string();
+    std::vector<cf32> samples = ramp(100);
+    samples[7] = cf32(5.0f, -5.0f);  // beyond the 12 dB headroom
+    SigmfMeta meta;
+    meta.format = IqFormat::ci16;
+    {
+        IqFileSink sink(path, meta, 4096);
+        sink.write<cf32>(samples);
+        expect(sink.saturation().saturated == 2, "narrowing on write counts clipping");
+        sink.close();
+    }
+    IqFileSource source(path);
+    expect(source.format() == IqFormat::ci16, "format comes from the metadata");
+    std::vector<ci8> narrow(samples.size());
+    expect(source.read<ci8>(narrow) == samples.size(), "ci16 reads as ci8");
+    expect(narrow[50].re == 2, "ci8 keeps the unit scaling (0.05 in Q5)");
+    expect(narrow[7].re == 127 && narrow[7].im == -128, "clipped peaks stay at full scale");
+
+    source.seek(0);
+    std::vector<cf32> wide(samples.size());
+    source.read<cf32>(wide);
+    expect(std::abs(wide[50] - samples[50]) < 1.0f / 8192.0f,
+           "ci16 reads back as float within one step");
+
+    // Raw files: no metadata, format given by the caller; a trailing
+    // partial sample is ignored.
+    const std::string raw = (dir / "raw.ci8").string();
+    {
+        std::ofstream f(raw, std::ios::binary);
+        const char bytes[] = {1, 2, 3, 4, 5};
+        f.write(bytes, sizeof bytes);
+    }
+    IqFileSource raw_source(raw, IqFormat::ci8, 1e6);
+    std::vector<ci16> wide16(4);
+    expect(raw_source.samples() == 2 && raw_source.read<ci16>(wide16) == 2,
+           "raw ci8 file of two and a half samples");
+    expect(wide16[1].re == 3 * 256 && wide16[1].im == 4 * 256, "ci8 widens exactly to ci16");
+}
+
+void errors(const fs::path& dir) {
+    expect_throws<std::system_error>(
+        [&] { IqFileSource s((dir / "missing.sigmf-data").string()); }, "missing recording");
+    const std::string bad = (dir / "bad.sigmf-meta").string();
+    {
+        std::ofstream f(bad);
+        f << R"({"global": {"core:datatype": "ri16_be"}})";
+    }
+    expect_throws<std::invalid_argument>([&] { read_sigmf_meta(bad); },
+                                         "unsupported datatype");
+    expect(sigmf_meta_path("x/y.sigmf-data") == "x/y.sigmf-meta" &&
+               sigmf_meta_path("x/y") == "x/y.sigmf-meta",
+           "meta path next to the data");
+}
+
+}  // namespace
+
+int main() {
+    const fs::path dir =
+        fs::temp_directory_path() / ("dcomm_iq_file_" + std::to_string(::getpid()));
+    fs::create_directories(dir);
+    sigmf_roundtrip(dir, false);
+    sigmf_roundtrip(dir, true);
+    conversions(dir);
+    errors(dir);
+    fs::remove_all(dir);
+    return dcomm::test::finish("iq_file");
+}
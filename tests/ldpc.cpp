@@ -0,0 +1,192 @@
+// QC-LDPC: an NR-style base graph loaded through parse() (lifted V mod Z,
+// first two block columns punctured), encoded, checked and decoded on every
+// ISA; LdpcBatchDecoder against the single decoder; and WorkStealingPool
+// coverage, worker ids and stealing under uneven items.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/ldpc.hpp"
+#include "dcomm/thread_pool.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+using dcomm::test::expect_throws;
+
+// A small graph with the TS 38.212 structure: 6 information columns of which
+// the first two are high-degree and punctured, a 4-column double-diagonal
+// core (rows 0-3) and 4 extension rows with one degree-1 parity column each.
+// Shifts are V values of one lifting set, larger than Z so that the V mod Z
+// rule matters.
+constexpr const char* kNrStyleGraph = R"(
+8 14
+# i0  i1  i2  i3  i4  i5   p0 p1 p2 p3   e0 e1 e2 e3
+ 250  69 226 159   - 100    1  0  -  -    -  -  -  -
+   2   - 239 117 124  71    0  0  0  -    -  -  -  -
+ 106 111 185   -  63 117    -  -  0  0    -  -  -  -
+ 121  89   -  84  20   -    1  -  -  0    -  -  -  -
+ 157 102   -   -  33   -    -  12 -  -    0  -  -  -
+ 205   - 170   -   -  19    -  -  2  -    -  0  -  -
+   - 236   - 194  28   -  231  -  -  -    -  -  0  -
+  97 201 144   -   -   -    -  -  -  5    -  -  -  0
+)";
+constexpr std::size_t kZ = 16;
+
+std::vector<std::uint8_t> random_bits(std::size_t n, std::mt19937& rng) {
+    std::vector<std::uint8_t> bits(n);
+    for (auto& b : bits) {
+        b = std::uint8_t(rng() & 1u);
+    }
+    return bits;
+}
+
+/// BPSK LLRs with the first two block columns punctured (LLR 0).
+std::vector<float> channel(const std::vector<std::uint8_t>& codeword, double sigma,
+                           std::mt19937& rng) {
+    std::normal_distribution<double> noise(0.0, sigma);
+    std::vector<float> llrs(codeword.size());
+    for (std::size_t i = 0; i < codeword.size(); ++i) {
+        const double y = (codeword[i] ? -1.0 : 1.0) + (sigma > 0.0 ? noise(rng) : 0.0);
+        llrs[i] = i < 2 * kZ ? 0.0f : float(2.0 * y / (sigma > 0.0 ? sigma * sigma : 0.25));
+    }
+    return llrs;
+}
+
+void nr_style_graph() {
+    const LdpcBaseGraph graph = LdpcBaseGraph::parse("NR-style test graph", kNrStyleGraph);
+    expect(graph.rows == 8 && graph.cols == 14 && graph.shift(0, 0) == 250 &&
+               graph.shift(0, 4) == -1,
+           "parse reads dimensions, shifts and '-' blocks");
+    const LdpcCode code(graph, kZ);
+    expect(code.k() == 6 * kZ && code.n() == 14 * kZ, "lifted sizes");
+    expect(code.row(0)[0].shift == 250 % kZ, "shifts are lifted V mod Z");
+
+    std::mt19937 rng(1);
+    std::size_t codewords_ok = 0, decoded_ok = 0, matches = 0;
+    const int kCodewords = 20;
+    for (int t = 0; t < kCodewords; ++t) {
+        const std::vector<std::uint8_t> info = random_bits(code.k(), rng);
+        std::vector<std::uint8_t> codeword(code.n());
+        code.encode(info, codeword);
+        codewords_ok += code.check(codeword) &&
+                        std::equal(info.begin(), info.end(), codeword.begin());
+
+        std::vector<std::uint8_t> out(code.k());
+        const LdpcResult r = LdpcDecoder(code).decode(channel(codeword, 0.0, rng), out);
+        decoded_ok += r.converged && out == info;
+
+        const std::vector<float> noisy = channel(codeword, 0.7, rng);
+        std::vector<std::uint8_t> reference(code.k());
+        const LdpcResult ref = LdpcDecoder(code, {}, Isa::scalar).decode(noisy, reference);
+        bool same = true;
+        for (Isa isa : {Isa::avx2, Isa::avx512, Isa::neon}) {
+            if (isa_available(isa)) {
+                const LdpcResult n = LdpcDecoder(code, {}, isa).decode(noisy, out);
+                same = same && out == reference && n.iterations == ref.iterations &&
+                       n.converged == ref.converged;
+            }
+        }
+        matches += same;
+    }
+    expect(codewords_ok == kCodewords, "encoded words are systematic and pass every check");
+    expect(decoded_ok == kCodewords, "punctured columns are recovered without noise");
+    expect(matches == kCodewords, "every ISA decodes noisy words like scalar");
+
+    expect_throws<std::invalid_argument>([] { LdpcBaseGraph::parse("bad", "2 3 0 0 0"); },
+                                         "too few shifts");
+    expect_throws<std::invalid_argument>([] { LdpcBaseGraph::parse("bad", "1 2 0 x"); },
+                                         "unexpected character");
+    expect_throws<std::invalid_argument>(
+        [] { LdpcCode(LdpcBaseGraph::parse("bad", "2 4  0 0 0 0  0 0 0 0"), 4); },
+        "graph without the encodable parity structure");
+}
+
+void batch_decoder() {
+    const LdpcCode code(LdpcBaseGraph::ieee80211_648_r12(), 27);
+    WorkStealingPool pool(3);
+    LdpcBatchDecoder batch(code, pool);
+    LdpcDecoder single(code);
+    std::mt19937 rng(2);
+    std::normal_distribution<double> noise(0.0, 0.8);
+    const std::size_t count = 13;
+    std::vector<float> llrs;
+    for (std::size_t b = 0; b < count; ++b) {
+        std::vector<std::uint8_t> codeword(code.n());
+        code.encode(random_bits(code.k(), rng), codeword);
+        for (std::uint8_t bit : codeword) {
+            llrs.push_back(float(2.0 * ((bit ? -1.0 : 1.0) + noise(rng)) / 0.64));
+        }
+    }
+    std::vector<std::uint8_t> info(count * code.k()), one(code.k());
+    std::vector<LdpcResult> results(count);
+    batch.decode(llrs, info, results);
+    bool same = true;
+    for (std::size_t b = 0; b < count; ++b) {
+        const LdpcResult r =
+            single.decode(std::span(llrs).subspan(b * code.n(), code.n()), one);
+        same = same && r.iterations == results[b].iterations &&
+               r.converged == results[b].converged &&
+               std::equal(one.begin(), one.end(), info.begin() + std::ptrdiff_t(b * code.k()));
+    }
+    expect(same, "batch decoding matches one decoder block by block");
+}
+
+void work_stealing_pool() {
+    for (std::size_t workers : {1, 2, 4}) {
+        WorkStealingPool pool(workers);
+        expect(pool.size() == workers, "pool has the requested workers");
+        for (std::size_t count : {0, 1, 7, 1000}) {
+            std::vector<std::atomic<int>> hits(count);
+            std::atomic<bool> bad_worker{false};
+            pool.run(count, [&](std::size_t i, std::size_t w) {
+                hits[i].fetch_add(1, std::memory_order_relaxed);
+                if (w >= workers) {
+                    bad_worker.store(true);
+                }
+            });
+            bool once = true;
+            for (auto& h : hits) {
+                once = once && h.load() == 1;
+            }
+            expect(once, "run() calls every index exactly once");
+            expect(!bad_worker.load(), "worker ids are below size()");
+        }
+    }
+
+    WorkStealingPool inline_pool(1);
+    const std::thread::id caller = std::this_thread::get_id();
+    bool on_caller = true;
+    inline_pool.run(5, [&](std::size_t, std::size_t) {
+        on_caller = on_caller && std::this_thread::get_id() == caller;
+    });
+    expect(on_caller, "a pool of one runs inline on the caller");
+
+    // All slow items sit in worker 0's initial range; the others finish
+    // theirs at once and must steal to help.
+    WorkStealingPool pool(4);
+    std::vector<std::atomic<int>> by_worker(pool.size());
+    pool.run(64, [&](std::size_t i, std::size_t w) {
+        if (i < 16) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            by_worker[w].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    expect(by_worker[0].load() < 16, "slow items of one range are stolen by others");
+}
+
+}  // namespace
+
+int main() {
+    nr_style_graph();
+    batch_decoder();
+    work_stealing_pool();
+    return dcomm::test::finish("ldpc");
+}
@@ -0,0 +1,200 @@
+// MIMO: the HT-LTF cover, least-squares estimation that separates the
+// streams, interpolation across subcarriers, and ZF / MMSE detection of
+// 2 and 4 streams, with their noise predictions.
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/mimo.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+using dcomm::test::expect_throws;
+
+// Not a multiple of any vector width, so the kernels' tails run.
+constexpr std::size_t kSubcarriers = 37;
+
+SubcarrierMatrix random_matrix(std::size_t rows, std::size_t cols, std::mt19937& rng) {
+    std::normal_distribution<float> g(0.0f, 0.70710678f);
+    SubcarrierMatrix m(rows, cols, kSubcarriers);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            for (std::size_t k = 0; k < kSubcarriers; ++k) {
+                m.set(i, j, k, cf32(g(rng), g(rng)));
+            }
+        }
+    }
+    return m;
+}
+
+/// y = H x per subcarrier.
+SubcarrierMatrix multiply(const SubcarrierMatrix& h, const SubcarrierMatrix& x) {
+    SubcarrierMatrix y(h.rows(), 1, kSubcarriers);
+    for (std::size_t r = 0; r < h.rows(); ++r) {
+        for (std::size_t k = 0; k < kSubcarriers; ++k) {
+            cf32 acc{};
+            for (std::size_t t = 0; t < h.cols(); ++t) {
+                acc += h.at(r, t, k) * x.at(t, 0, k);
+            }
+            y.set(r, 0, k, acc);
+        }
+    }
+    return y;
+}
+
+float max_difference(const SubcarrierMatrix& a, const SubcarrierMatrix& b) {
+    float err = 0.0f;
+    for (std::size_t i = 0; i < a.rows(); ++i) {
+        for (std::size_t j = 0; j < a.cols(); ++j) {
+            for (std::size_t k = 0; k < a.subcarriers(); ++k) {
+                err = std::max(err, std::abs(a.at(i, j, k) - b.at(i, j, k)));
+            }
+        }
+    }
+    return err;
+}
+
+void cover() {
+    expect(ht_ltf_symbols(1) == 1 && ht_ltf_symbols(2) == 2 && ht_ltf_symbols(3) == 4 &&
+               ht_ltf_symbols(4) == 4 && ht_ltf_symbols(5) == 0,
+           "HT-LTF symbols per stream count");
+    bool orthogonal = true;
+    for (std::size_t t = 0; t < 4; ++t) {
+        for (std::size_t u = 0; u < 4; ++u) {
+            float dot = 0.0f;
+            for (std::size_t s = 0; s < 4; ++s) {
+                dot += ht_ltf_cover(t, s) * ht_ltf_cover(u, s);
+            }
+            orthogonal = orthogonal && dot == (t == u ? 4.0f : 0.0f);
+        }
+    }
+    expect(orthogonal, "the cover's rows are orthogonal");
+}
+
+void estimation() {
+    std::mt19937 rng(4);
+    for (std::size_t tx : {2, 4}) {
+        const std::size_t rx = 4;
+        const SubcarrierMatrix h = random_matrix(rx, tx, rng);
+        std::vector<std::uint16_t> bins(kSubcarriers);
+        std::vector<float> reference(kSubcarriers);
+        for (std::size_t k = 0; k < kSubcarriers; ++k) {
+            bins[k] = std::uint16_t(2 * k + 1);
+            reference[k] = rng() & 1u ? 1.0f : -1.0f;
+        }
+        LtfChannelEstimator estimator(rx, tx, bins, reference);
+        const std::size_t n = estimator.ltf_symbols();
+        std::vector<std::vector<cf32>> fft(n * rx, std::vector<cf32>(2 * kSubcarriers + 1));
+        for (std::size_t s = 0; s < n; ++s) {
+            for (std::size_t r = 0; r < rx; ++r) {
+                for (std::size_t k = 0; k < kSubcarriers; ++k) {
+                    cf32 y{};
+                    for (std::size_t t = 0; t < tx; ++t) {
+                        y += h.at(r, t, k) * reference[k] * ht_ltf_cover(t, s);
+                    }
+                    fft[s * rx + r][bins[k]] = y;
+                }
+            }
+        }
+        std::vector<const cf32*> symbols;
+        for (const auto& f : fft) {
+            symbols.push_back(f.data());
+        }
+        SubcarrierMatrix estimate;
+        estimator.estimate(symbols, estimate);
+        expect(estimate.rows() == rx && estimate.cols() == tx &&
+                   max_difference(estimate, h) < 1e-5f,
+               tx == 2 ? "two streams separated exactly" : "four streams separated exactly");
+    }
+    const std::uint16_t bins[] = {1, 2};
+    const float zero[] = {1.0f, 0.0f};
+    expect_throws<std::invalid_argument>([&] { LtfChannelEstimator e(2, 2, bins, zero); },
+                                         "zero reference");
+    expect_throws<std::invalid_argument>(
+        [&] { LtfChannelEstimator e(2, 5, bins, std::span(zero, 1)); }, "five streams");
+}
+
+void interpolation() {
+    // A channel linear in the subcarrier index is reproduced exactly, on
+    // the comb and past its ends.
+    const std::vector<int> from = {-20, -10, 0, 10, 20};
+    const std::vector<int> to = {-26, -15, -1, 3, 20, 26};
+    const auto line = [](int k) { return cf32(0.5f + 0.01f * float(k), -0.02f * float(k)); };
+    SubcarrierMatrix in(1, 1, from.size());
+    for (std::size_t k = 0; k < from.size(); ++k) {
+        in.set(0, 0, k, line(from[k]));
+    }
+    SubcarrierMatrix out;
+    SubcarrierInterpolator(from, to).apply(in, out);
+    float err = 0.0f;
+    for (std::size_t k = 0; k < to.size(); ++k) {
+        err = std::max(err, std::abs(out.at(0, 0, k) - line(to[k])));
+    }
+    expect(out.subcarriers() == to.size() && err < 1e-6f, "linear interpolation and extrapolation");
+    const std::vector<int> unsorted = {3, 1};
+    expect_throws<std::invalid_argument>([&] { SubcarrierInterpolator i(unsorted, to); },
+                                         "unsorted source subcarriers");
+}
+
+void detection() {
+    std::mt19937 rng(5);
+    for (auto [rx, streams] : {std::pair<std::size_t, std::size_t>{2, 2}, {4, 2}, {4, 4}}) {
+        const SubcarrierMatrix h = random_matrix(rx, streams, rng);
+        const SubcarrierMatrix x = random_matrix(streams, 1, rng);
+        const SubcarrierMatrix y = multiply(h, x);
+
+        MimoEqualizer zf(rx, streams, MimoDetector::zf);
+        zf.prepare(h, 0.0f);
+        SubcarrierMatrix detected;
+        zf.apply(y, detected);
+        expect(detected.rows() == streams && max_difference(detected, x) < 1e-3f,
+               "zero forcing inverts a noiseless channel");
+
+        // Unbiased MMSE: unit gain on the wanted stream, and never more
+        // post-detection noise than ZF.
+        zf.prepare(h, 0.01f);
+        MimoEqualizer mmse(rx, streams, MimoDetector::mmse);
+        mmse.prepare(h, 0.01f);
+        bool unit_gain = true, quieter = true;
+        for (std::size_t t = 0; t < streams; ++t) {
+            for (std::size_t k = 0; k < kSubcarriers; ++k) {
+                cf32 g{};
+                for (std::size_t r = 0; r < rx; ++r) {
+                    g += mmse.weights().at(t, r, k) * h.at(r, t, k);
+                }
+                unit_gain = unit_gain && std::abs(g - cf32(1.0f, 0.0f)) < 1e-3f;
+                quieter = quieter && mmse.noise(t)[k] > 0.0f &&
+                          mmse.noise(t)[k] <= zf.noise(t)[k] * 1.001f;
+            }
+        }
+        expect(unit_gain, "MMSE weights have unit gain on the wanted stream");
+        expect(quieter, "MMSE noise is positive and at most ZF's");
+    }
+    expect_throws<std::invalid_argument>([] { MimoEqualizer e(2, 3, MimoDetector::zf); },
+                                         "three streams");
+    expect_throws<std::invalid_argument>([] { MimoEqualizer e(1, 2, MimoDetector::zf); },
+                                         "fewer antennas than streams");
+    std::mt19937 local(6);
+    MimoEqualizer e(2, 2, MimoDetector::zf);
+    expect_throws<std::invalid_argument>([&] { e.prepare(random_matrix(4, 2, local), 0.0f); },
+                                         "channel shape mismatch");
+}
+
+}  // namespace
+
+int main() {
+    cover();
+    estimation();
+    interpolation();
+    detection();
+    return dcomm::test::finish("mimo");
+}
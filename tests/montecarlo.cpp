@@ -0,0 +1,134 @@
+// Monte-Carlo sweep: Philox4x32-10 known answers, identical results for
+// 1, 2 and 4 workers (AWGN and fading), the stopping rules and the CSV.
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/montecarlo.hpp"
+#include "dcomm/philox.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+using dcomm::test::expect_throws;
+
+void philox_known_answers() {
+    // Random123 kat_vectors, philox4x32_10.
+    using B = Philox4x32::Block;
+    expect(Philox4x32::generate(B{0, 0, 0, 0}, {0, 0}) ==
+               B{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+           "zero counter and key");
+    expect(Philox4x32::generate(B{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                                {0xffffffff, 0xffffffff}) ==
+               B{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+           "all-ones counter and key");
+    expect(Philox4x32::generate(B{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                                {0xa4093822, 0x299f31d0}) ==
+               B{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1},
+           "digits of pi");
+
+    Philox4x32 a(7, 3), b(7, 3), other(7, 4);
+    bool same = true, differs = false;
+    for (int i = 0; i < 100; ++i) {
+        const auto x = a();
+        same = same && x == b();
+        differs = differs || x != other();
+    }
+    expect(same && differs, "streams are reproducible and distinct");
+}
+
+bool same_counts(const std::vector<SweepPoint>& x, const std::vector<SweepPoint>& y) {
+    if (x.size() != y.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        if (x[i].blocks != y[i].blocks || x[i].bits != y[i].bits ||
+            x[i].bit_errors != y[i].bit_errors || x[i].block_errors != y[i].block_errors) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SweepConfig small_sweep() {
+    SweepConfig config;
+    config.phy.modulation = Modulation::qam16;
+    config.snr_db = {4.0, 8.0, 30.0, 40.0};
+    config.seed = 11;
+    config.target_block_errors = 10;
+    config.max_blocks = 96;
+    config.batch_blocks = 4;
+    return config;
+}
+
+void deterministic_across_threads() {
+    for (bool fading : {false, true}) {
+        SweepConfig config = small_sweep();
+        if (fading) {
+            config.fading = FadingConfig{};
+            config.phy.equalizer = Equalizer::pilot_zf;
+        }
+        std::vector<SweepPoint> reference;
+        for (std::size_t workers : {1, 2, 4}) {
+            config.workers = workers;
+            const std::vector<SweepPoint> points = MonteCarloSweep(config).run();
+            if (workers == 1) {
+                reference = points;
+            } else {
+                expect(same_counts(points, reference),
+                       fading ? "fading sweep is independent of the worker count"
+                              : "AWGN sweep is independent of the worker count");
+            }
+        }
+        config.seed = 12;
+        config.workers = 2;
+        const std::vector<SweepPoint> reseeded = MonteCarloSweep(config).run();
+        expect(!same_counts(reseeded, reference), "another seed gives other trials");
+    }
+}
+
+void stopping_rules() {
+    SweepConfig config = small_sweep();
+    config.workers = 3;
+    std::size_t reported = 0;
+    const std::vector<SweepPoint> points =
+        MonteCarloSweep(config).run([&](const SweepPoint&) { ++reported; });
+    expect(reported == points.size(), "the handler sees every point");
+    bool rules = !points.empty();
+    for (const SweepPoint& p : points) {
+        rules = rules && p.blocks % config.batch_blocks == 0 && p.blocks <= config.max_blocks &&
+                (p.block_errors >= config.target_block_errors || p.blocks == config.max_blocks);
+    }
+    expect(rules, "points stop at the error target or max_blocks, in whole batches");
+    expect(points.front().block_errors >= config.target_block_errors,
+           "the low-SNR point stops on errors");
+    expect(points.size() == 3 && points.back().block_errors == 0,
+           "the sweep ends after the first error-free point");
+
+    SweepConfig bad = small_sweep();
+    bad.batch_blocks = 0;
+    expect_throws<std::invalid_argument>([&] { MonteCarloSweep s(bad); }, "zero batch size");
+
+    std::FILE* f = std::tmpfile();
+    write_csv_header(f);
+    write_csv_row(f, points.front());
+    std::rewind(f);
+    char header[256] = {}, row[256] = {};
+    expect(std::fgets(header, sizeof header, f) && std::fgets(row, sizeof row, f) &&
+               std::strchr(header, ',') != nullptr && std::strncmp(row, "4", 1) == 0,
+           "CSV header and a row starting with the SNR");
+    std::fclose(f);
+}
+
+}  // namespace
+
+int main() {
+    philox_known_answers();
+    deterministic_across_threads();
+    stopping_rules();
+    return dcomm::test::finish("montecarlo");
+}
@@ -0,0 +1,121 @@
+// Rate conversion: ratio reduction, unit passband gain and stopband
+// rejection of the polyphase and half-band filters, output counts, and
+// streams cut into blocks resampling exactly as if passed whole.
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/resampler.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+using dcomm::test::expect_throws;
+
+/// exp(j 2 pi f n), f in cycles per sample.
+std::vector<cf32> tone(std::size_t n, double f) {
+    std::vector<cf32> x(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        x[k] = cf32(std::polar(1.0, 2.0 * std::numbers::pi * f * double(k)));
+    }
+    return x;
+}
+
+/// Largest deviation of |y| from `level` past the first `settle` samples.
+double envelope_error(const std::vector<cf32>& y, std::size_t settle, double level) {
+    double err = 0.0;
+    for (std::size_t k = settle; k < y.size(); ++k) {
+        err = std::max(err, std::abs(double(std::abs(y[k])) - level));
+    }
+    return err;
+}
+
+template <class R>
+std::vector<cf32> run(R& r, const std::vector<cf32>& in, std::size_t block) {
+    std::vector<cf32> out;
+    for (std::size_t at = 0; at < in.size(); at += block) {
+        const std::span<const cf32> part =
+            std::span(in).subspan(at, std::min(block, in.size() - at));
+        std::vector<cf32> y(r.output_size(part.size()));
+        y.resize(r.process(part, y));
+        out.insert(out.end(), y.begin(), y.end());
+    }
+    return out;
+}
+
+void ratios() {
+    const ResampleRatio lte = resample_ratio(30.72e6, 25e6);
+    expect(lte.up == 625 && lte.down == 768, "30.72 -> 25 Msps is 625/768");
+    const ResampleRatio wifi = resample_ratio(20e6, 80e6);
+    expect(wifi.up == 4 && wifi.down == 1, "20 -> 80 Msps is 4/1");
+    expect_throws<std::invalid_argument>([] { resample_ratio(1.0, std::numbers::pi); },
+                                         "irrational ratio");
+    expect_throws<std::invalid_argument>([] { resample_ratio(0.0, 1e6); }, "zero rate");
+    expect_throws<std::invalid_argument>([] { PolyphaseResampler r({0, 1}); }, "zero factor");
+    expect_throws<std::invalid_argument>([] { HalfbandCascade h(HalfbandMode::decimate, 0); },
+                                         "no stages");
+}
+
+void polyphase() {
+    const std::vector<cf32> in = tone(6000, 0.05);
+    PolyphaseResampler whole({3, 2});
+    const std::vector<cf32> once = run(whole, in, in.size());
+    expect(once.size() == 9000, "3/2 of the input");
+    const std::size_t settle = 2 * whole.taps_per_phase() * 2;
+    expect(envelope_error(once, settle, 1.0) < 1e-3, "unit passband gain");
+
+    PolyphaseResampler blocks({3, 2});
+    expect(run(blocks, in, 77) == once, "blocks of 77 resample as the whole stream");
+    blocks.reset();
+    expect(run(blocks, in, in.size()) == once, "reset() restarts the stream");
+
+    // Down by 2: the output Nyquist rate is 0.25 input cycles, so 0.4
+    // would alias to -0.1 and must be gone.
+    PolyphaseResampler down({1, 2});
+    const std::vector<cf32> rejected = run(down, tone(6000, 0.4), 6000);
+    expect(rejected.size() == 3000 && envelope_error(rejected, 200, 0.0) < 1e-3,
+           "stopband rejected by more than 60 dB");
+
+    PolyphaseResampler lte(resample_ratio(30.72e6, 25e6));
+    const std::vector<cf32> out = run(lte, tone(7680, 0.1), 1000);
+    expect(out.size() == 6250, "30.72 -> 25 Msps output count");
+    expect(envelope_error(out, 400, 1.0) < 1e-3, "625/768 passband gain");
+}
+
+void halfband() {
+    HalfbandCascade up(HalfbandMode::interpolate, 2);
+    const std::vector<std::size_t> taps = up.stage_taps();
+    expect(taps.size() == 2 && taps[0] > taps[1], "the stage next to baseband is the sharpest");
+
+    const std::vector<cf32> in = tone(4000, 0.08);
+    const std::vector<cf32> fast = run(up, in, 4000);
+    expect(fast.size() == 16000, "two interpolating stages give x4");
+    expect(envelope_error(fast, 400, 1.0) < 1e-3, "interpolation keeps unit gain");
+
+    HalfbandCascade down(HalfbandMode::decimate, 2);
+    const std::vector<cf32> back = run(down, fast, 16000);
+    expect(back.size() == 4000, "two decimating stages give /4");
+    expect(envelope_error(back, 200, 1.0) < 1e-3, "decimation keeps unit gain");
+
+    HalfbandCascade odd(HalfbandMode::decimate, 2);
+    expect(run(odd, fast, 101) == back, "odd blocks hold back a sample and lose nothing");
+
+    HalfbandCascade alias(HalfbandMode::decimate, 1);
+    expect(envelope_error(run(alias, tone(4000, 0.4), 4000), 200, 0.0) < 1e-3,
+           "half-band stopband rejected by more than 60 dB");
+}
+
+}  // namespace
+
+int main() {
+    ratios();
+    polyphase();
+    halfband();
+    return dcomm::test::finish("resampler");
+}
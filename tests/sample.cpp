@@ -0,0 +1,92 @@
+// Fixed-point samples: Q13 / Q5 scaling and its 12 dB of headroom,
+// rounding, saturation counting, ci8 <-> ci16 widening, and the ci16 and
+// ci8 chains decoding a noiseless stream like the float one.
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/pipeline.hpp"
+#include "dcomm/sample.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+
+void scaling() {
+    static_assert(SampleTraits<ci16>::unit == 8192.0f && SampleTraits<ci8>::unit == 32.0f);
+    const std::vector<cf32> in = {{1.0f, -1.0f}, {3.99f, -3.99f}, {4.01f, -4.2f},
+                                  {0.5f / 8192.0f, -1.5f / 8192.0f}};
+    std::vector<ci16> q(in.size());
+    SaturationStats stats;
+    quantize<ci16>(in, q, stats);
+    expect(q[0].re == 8192 && q[0].im == -8192, "unit level is 8192 (Q13)");
+    expect(q[1].re == 32686 && q[1].im == -32686, "peaks below 4x unit fit");
+    expect(q[2].re == 32767 && q[2].im == -32768, "peaks above 4x unit clip");
+    expect(q[3].re == 0 && q[3].im == -2, "rounding to nearest, ties to even");
+    expect(stats.values == 8 && stats.saturated == 2, "clipped components are counted");
+
+    std::vector<cf32> back(in.size());
+    dequantize<ci16>(q, back);
+    expect(back[0] == cf32(1.0f, -1.0f), "dequantize undoes the unit scaling");
+
+    std::vector<ci8> q8(in.size());
+    SaturationStats stats8;
+    quantize<ci8>(in, q8, stats8);
+    expect(q8[0].re == 32 && q8[1].re == 127 && q8[2].im == -128,
+           "ci8 is Q5 with the same headroom");
+    expect(stats8.saturated == 3, "ci8 clips 3.99 * 32 as well");
+}
+
+void widen_narrow() {
+    std::uint64_t saturated = 0;
+    const ci16 w = widen(ci8{-5, 17});
+    expect(w.re == -5 * 256 && w.im == 17 * 256, "ci8 widens by << 8");
+    const ci8 n = narrow<ci8>(-5 * 256 + 127, 17 * 256 + 128, saturated);
+    expect(n.re == -5 && n.im == 18 && saturated == 0, "narrowing rounds half up");
+    const ci8 c = narrow<ci8>(40000, -40000, saturated);
+    expect(c.re == 127 && c.im == -128 && saturated == 2, "narrowing saturates and counts");
+}
+
+template <SampleType T>
+std::size_t loopback_errors(const PhyConfig& config, SaturationStats& tx_sat) {
+    BasicTxChain<T> tx(config);
+    BasicRxChain<T> rx(config);
+    std::mt19937 rng(3);
+    const std::size_t block_bits = config.info_bits_per_block();
+    std::size_t errors = 0;
+    for (int b = 0; b < 10; ++b) {
+        BufferView<std::uint64_t> data = tx.acquire_input();
+        const BitSpan payload(data.span(), block_bits);
+        for (std::size_t i = 0; i < block_bits; ++i) {
+            payload.set(i, rng() & 1u);
+        }
+        BufferView<std::uint64_t> sent = data;
+        BufferView<std::uint64_t> received = rx.process(tx.process(std::move(data)));
+        errors += count_bit_errors(ConstBitSpan(sent.span(), block_bits),
+                                   ConstBitSpan(received.span(), block_bits));
+    }
+    tx_sat = tx.saturation();
+    return errors;
+}
+
+void chains() {
+    PhyConfig config;
+    config.modulation = Modulation::qam64;
+    SaturationStats s16, s8;
+    expect(loopback_errors<ci16>(config, s16) == 0, "ci16 chain decodes 64-QAM error free");
+    expect(loopback_errors<ci8>(config, s8) == 0, "ci8 chain decodes 64-QAM error free");
+    expect(s16.values > 0 && s16.rate() < 1e-3, "the headroom keeps ci16 clipping rare");
+    expect(s8.values > 0 && s8.rate() < 1e-3, "the headroom keeps ci8 clipping rare");
+}
+
+}  // namespace
+
+int main() {
+    scaling();
+    widen_narrow();
+    chains();
+    return dcomm::test::finish("sample");
+}
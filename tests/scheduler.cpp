@@ -0,0 +1,169 @@
+// Scheduler: the spin / yield / sleep waiting policy, CPU spreading,
+// pinned tasks moving a stream between rings in order, and OrderedFanOut
+// keeping block order across the work-stealing pool.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/scheduler.hpp"
+#include "dcomm/spsc_ring.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+using dcomm::test::expect_throws;
+
+void waiter() {
+    WaitPolicy policy;
+    policy.spin = 3;
+    policy.yield = 2;
+    policy.max_sleep = std::chrono::microseconds(4);
+    AdaptiveWaiter w(policy);
+    for (int i = 0; i < 5; ++i) {
+        w.idle();
+    }
+    expect(w.sleeps() == 0, "spin, then yield, before sleeping");
+    const auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < 4; ++i) {
+        w.idle();
+    }
+    expect(w.sleeps() == 4 && std::chrono::steady_clock::now() - begin >=
+                                  std::chrono::microseconds(1 + 2 + 4 + 4),
+           "backoff doubles up to max_sleep");
+    w.reset();
+    w.idle();
+    expect(w.sleeps() == 4, "reset() goes back to spinning");
+}
+
+void spread() {
+    const unsigned cpus = cpu_count();
+    const std::vector<int> cpus_for = PipelineScheduler::spread(2 * cpus + 1);
+    bool valid = cpus_for.size() == 2 * cpus + 1;
+    for (std::size_t i = 0; i < cpus_for.size(); ++i) {
+        valid = valid && cpus_for[i] >= 0 && cpus_for[i] == cpus_for[i % cpus];
+    }
+    std::vector<int> first(cpus_for.begin(), cpus_for.begin() + cpus);
+    std::sort(first.begin(), first.end());
+    expect(valid && std::unique(first.begin(), first.end()) == first.end(),
+           "one task per CPU, wrapping around when there are more tasks");
+}
+
+void pipeline() {
+    constexpr std::uint64_t kCount = 20000;
+    SpscRing<std::uint64_t> ring(64);
+    std::uint64_t produced = 0, consumed = 0;
+    bool ordered = true;
+    std::atomic<bool> done{false};
+
+    WaitPolicy policy;
+    policy.spin = 16;
+    PipelineScheduler scheduler(policy);
+    const std::vector<int> cpus = PipelineScheduler::spread(2);
+    scheduler.add("source", cpus[0], [&] {
+        if (produced == kCount || ring.full()) {
+            return false;
+        }
+        ring.try_push(produced++);
+        return true;
+    });
+    const std::size_t sink = scheduler.add("sink", cpus[1], [&] {
+        std::uint64_t v = 0;
+        if (!ring.try_pop(v)) {
+            return false;
+        }
+        ordered = ordered && v == consumed++;
+        done.store(consumed == kCount, std::memory_order_release);
+        return true;
+    });
+    expect(scheduler.node_of(sink) == numa_node_of_cpu(cpus[1]), "tasks know their NUMA node");
+    BufferPool<float> pool(4, 4096);
+    scheduler.place_for(pool, sink);  // false without NUMA; must not disturb the pool
+
+    scheduler.start();
+    expect(scheduler.running(), "running after start()");
+    expect_throws<std::logic_error>([&] { scheduler.add("late", -1, [] { return false; }); },
+                                    "no tasks added while running");
+    const auto until = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < until) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    scheduler.stop();
+    expect(!scheduler.running(), "stop() joins the threads");
+    expect(consumed == kCount && ordered, "every element crosses the pipeline in order");
+
+    const std::vector<TaskStats> stats = scheduler.stats();
+    expect(stats.size() == 2 && stats[0].name == "source" && stats[1].cpu == cpus[1],
+           "stats per task");
+    expect(stats[0].pinned && stats[1].pinned, "tasks are pinned to their CPUs");
+    expect(stats[0].busy_polls == kCount && stats[1].busy_polls == kCount,
+           "one busy poll per element");
+    expect(stats[0].idle_polls > 0 && stats[0].sleeps > 0,
+           "a source with nothing left to do backs off to sleeping");
+    expect(pool.acquire().size() == 4096, "the placed pool still hands out buffers");
+}
+
+/// Doubles its input, from its own output pool, deep enough for one
+/// replica to take the whole batch.
+class Doubler : public Stage<int, int> {
+public:
+    Doubler() : pool_(8, 1) {}
+    BufferView<int> process(BufferView<int> in) override {
+        BufferView<int> out = pool_.acquire();
+        if (!in || !out) {
+            return {};
+        }
+        // Uneven work, so blocks finish out of order.
+        std::this_thread::sleep_for(std::chrono::microseconds(50 * (in[0] % 5)));
+        out[0] = 2 * in[0];
+        return out;
+    }
+    const char* name() const noexcept override { return "doubler"; }
+
+private:
+    BufferPool<int> pool_;
+};
+
+void fan_out() {
+    WorkStealingPool workers(3);
+    OrderedFanOut<int, int> fan(workers, [] { return std::make_unique<Doubler>(); });
+    expect(fan.replicas() == 3, "one replica per worker");
+    BufferPool<int> inputs(8, 1);
+    std::vector<BufferView<int>> in(8), out(8);
+    for (int i = 0; i < 8; ++i) {
+        in[std::size_t(i)] = inputs.acquire();
+        in[std::size_t(i)][0] = i + 1;
+    }
+    fan.process(in, out);
+    bool ordered = true;
+    for (int i = 0; i < 8; ++i) {
+        ordered = ordered && out[std::size_t(i)] && out[std::size_t(i)][0] == 2 * (i + 1);
+    }
+    expect(ordered, "outputs keep their input positions");
+    expect(std::all_of(in.begin(), in.end(), [](const BufferView<int>& v) { return !v; }),
+           "inputs are consumed");
+    expect_throws<std::invalid_argument>(
+        [&] {
+            std::vector<BufferView<int>> two(2), one(1);
+            fan.process(two, one);
+        },
+        "output span too small");
+}
+
+}  // namespace
+
+int main() {
+    waiter();
+    spread();
+    pipeline();
+    fan_out();
+    return dcomm::test::finish("scheduler");
+}
@@ -0,0 +1,179 @@
+// SpscRing: capacity rounding, FIFO order across threads, overrun and
+// underrun counters. DacSink / AdcSource: free-running loopback, paced
+// underruns, and the ADC's accounting of blocks it could not queue.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <thread>
+
+#include "check.hpp"
+#include "dcomm/converter.hpp"
+#include "dcomm/spsc_ring.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+using dcomm::test::expect_throws;
+
+template <class F>
+bool wait_for(F done, std::chrono::milliseconds limit = std::chrono::seconds(5)) {
+    const auto until = std::chrono::steady_clock::now() + limit;
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > until) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return true;
+}
+
+/// Return queued blocks to their pool before it goes away.
+void drain(SampleRing& ring) {
+    for (BufferView<cf32> b; ring.try_pop(b);) {
+        b.reset();
+    }
+}
+
+void ring_basics() {
+    SpscRing<int> ring(5);
+    expect(ring.capacity() == 8, "capacity rounds up to a power of two");
+    int v = 0;
+    expect(!ring.try_pop(v) && ring.stats().underruns == 1, "an empty pop is an underrun");
+    for (int i = 0; i < 8; ++i) {
+        ring.try_push(i);
+    }
+    expect(ring.full() && ring.size() == 8, "eight pushes fill it");
+    expect(!ring.try_push(99) && ring.stats().overruns == 1, "a full push is an overrun");
+    bool fifo = true;
+    for (int i = 0; i < 8; ++i) {
+        fifo = ring.try_pop(v) && v == i && fifo;
+    }
+    expect(fifo && ring.empty(), "elements come out in order");
+    const RingStats s = ring.stats();
+    expect(s.pushed == 8 && s.popped == 8, "push and pop counters");
+    expect_throws<std::invalid_argument>([] { SpscRing<int> r(0); }, "zero capacity");
+}
+
+void ring_across_threads() {
+    constexpr std::uint64_t kCount = 200000;
+    SpscRing<std::uint64_t> ring(64);
+    std::thread producer([&] {
+        for (std::uint64_t i = 0; i < kCount;) {
+            if (ring.full()) {
+                std::this_thread::yield();
+            } else if (ring.try_push(i)) {
+                ++i;
+            }
+        }
+    });
+    std::uint64_t expected = 0;
+    bool ordered = true;
+    while (expected < kCount) {
+        std::uint64_t v;
+        if (ring.empty()) {
+            std::this_thread::yield();
+        } else if (ring.try_pop(v)) {
+            ordered = ordered && v == expected;
+            ++expected;
+        }
+    }
+    producer.join();
+    expect(ordered, "every element arrives once and in order");
+    expect(ring.stats().overruns == 0 && ring.stats().underruns == 0,
+           "polling on full()/empty() leaves the counters clean");
+}
+
+void converter_loopback() {
+    constexpr std::size_t kSamples = 64;
+    constexpr int kBlocks = 50;
+    SampleRing tx(4), rx(4);
+    std::atomic<int> produced{0};
+    AdcSource adc(rx, 4, 0.0, kSamples, [&](std::span<cf32> block) {
+        const int n = produced.fetch_add(1);
+        for (cf32& s : block) {
+            s = cf32(float(n), 0.0f);
+        }
+        return n + 1 < kBlocks;
+    });
+    std::atomic<int> played{0};
+    std::atomic<bool> in_order{true};
+    DacSink dac(tx, 0.0, kSamples, [&](BufferView<cf32> b) {
+        in_order = in_order && b[0].real() == float(played.fetch_add(1));
+    });
+    dac.start();
+    adc.start();
+    int forwarded = 0;
+    wait_for([&] {
+        BufferView<cf32> b;
+        while (rx.try_pop(b)) {
+            while (!tx.try_push(b)) {
+                std::this_thread::yield();
+            }
+            ++forwarded;
+        }
+        return adc.finished() && rx.empty();
+    });
+    wait_for([&] { return played.load() == forwarded; });
+    adc.stop();
+    dac.stop();
+    expect(forwarded == kBlocks - 1 && played.load() == forwarded,
+           "free-running source and sink pass every block");
+    expect(in_order.load(), "blocks reach the sink in order");
+    expect(adc.dropped() == 0 && adc.pool_overruns() == 0, "a free-running source loses nothing");
+}
+
+void dac_underruns() {
+    // 1 Msps, 1000-sample blocks: one period per millisecond, nothing queued.
+    SampleRing ring(4);
+    DacSink dac(ring, 1e6, 1000);
+    dac.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    dac.stop();
+    expect(dac.blocks() == 0 && ring.stats().underruns >= 10,
+           "every empty period is an underrun");
+}
+
+void adc_drops() {
+    // Free-running with nobody draining: the ring fills, the thread waits
+    // with one more block in hand, and stop() drops and counts it.
+    SampleRing ring(2);
+    AdcSource adc(ring, 8, 0.0, 16, [](std::span<cf32>) { return true; });
+    adc.start();
+    expect(wait_for([&] { return ring.full(); }), "the ring fills");
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    adc.stop();
+    expect(adc.blocks() == 2, "two blocks queued");
+    expect(adc.dropped() == 1, "the block in hand at stop() is counted as dropped");
+    drain(ring);
+
+    // Paced at 1000 periods per second with a ring of two: the rest of the
+    // periods are drops.
+    SampleRing paced_ring(2);
+    AdcSource paced(paced_ring, 8, 1e6, 1000, [](std::span<cf32>) { return true; });
+    paced.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    paced.stop();
+    expect(paced.blocks() == 2 && paced.dropped() + paced.pool_overruns() >= 10,
+           "periods that find the ring full are dropped");
+    drain(paced_ring);
+
+    expect_throws<std::invalid_argument>(
+        [&] { AdcSource bad(ring, 2, 0.0, 16, {}); }, "fill callback required");
+    expect_throws<std::invalid_argument>([&] { DacSink bad(ring, -1.0, 16); },
+                                         "negative sample rate");
+}
+
+}  // namespace
+
+int main() {
+    ring_basics();
+    ring_across_threads();
+    converter_loopback();
+    dac_underruns();
+    adc_drops();
+    return dcomm::test::finish("spsc_ring");
+}
@@ -0,0 +1,147 @@
+// Compile-time PHY: the constexpr tables against the runtime factories,
+// and every specialised 802.11a pipeline against the runtime fallback and
+// TxChain, sample for sample and bit for bit, at full and short lengths.
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "check.hpp"
+#include "dcomm/frame.hpp"
+#include "dcomm/interleaver.hpp"
+#include "dcomm/ofdm.hpp"
+#include "dcomm/phy_tables.hpp"
+#include "dcomm/pipeline.hpp"
+#include "dcomm/static_phy.hpp"
+
+namespace {
+
+using namespace dcomm;
+using dcomm::test::expect;
+using dcomm::test::expect_throws;
+
+template <std::size_t NCbps, unsigned NBpsc>
+bool interleaver_matches() {
+    const BlockInterleaver& runtime = BlockInterleaver::ieee80211(NCbps, NBpsc);
+    const auto& source = tables::kInterleaverSource<NCbps, NBpsc>;
+    const auto& target = tables::kInterleaverTarget<NCbps, NBpsc>;
+    for (std::size_t j = 0; j < NCbps; ++j) {
+        if (runtime.source(j) != source[j] || target[source[j]] != j) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void tables_match_runtime() {
+    static_assert(tables::Mcs<Modulation::qam64, CodeRate::r3_4>::n_dbps == 216);
+    static_assert(tables::Mcs<Modulation::bpsk, CodeRate::r1_2>::n_cbps == 48);
+    expect(interleaver_matches<48, 1>() && interleaver_matches<96, 2>() &&
+               interleaver_matches<192, 4>() && interleaver_matches<288, 6>(),
+           "constexpr interleavers equal BlockInterleaver's");
+    const OfdmLayout& layout = OfdmLayout::ieee80211();
+    bool bins = layout.data_bins.size() == tables::kDataBins.size();
+    for (std::size_t k = 0; bins && k < tables::kDataBins.size(); ++k) {
+        bins = layout.data_bins[k] == tables::kDataBins[k];
+    }
+    expect(bins, "constexpr data bins equal the OFDM layout's");
+    bool pilots = true;
+    for (std::size_t n = 0; n < 2 * 127; ++n) {
+        pilots = pilots && pilot_polarity(n) == tables::kPilotPolarity[n % 127];
+    }
+    expect(pilots, "constexpr pilot polarity equals pilot_polarity()");
+}
+
+PackedBits random_payload(std::size_t n, std::mt19937& rng) {
+    PackedBits bits(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        bits.set(i, rng() & 1u);
+    }
+    return bits;
+}
+
+void pipelines() {
+    std::mt19937 rng(12);
+    std::normal_distribution<float> g(0.0f, 0.3f);
+    std::size_t configurations = 0;
+    bool specialised = true, same_samples = true, same_as_chain = true, roundtrip = true,
+         same_decisions = true, offsets = true;
+    for (Modulation m : {Modulation::bpsk, Modulation::qpsk, Modulation::qam16,
+                         Modulation::qam64}) {
+        for (CodeRate r : {CodeRate::r1_2, CodeRate::r2_3, CodeRate::r3_4}) {
+            if (!is_ieee80211a_rate(m, r)) {
+                continue;
+            }
+            for (bool interleave : {false, true}) {
+                ++configurations;
+                PhyConfig config;
+                config.modulation = m;
+                config.code_rate = r;
+                config.interleave = interleave;
+                config.symbols_per_block = 4;
+                config.scrambler_seed = 0x5d;
+                const auto fast = make_frame_phy(config);
+                const auto generic = make_generic_frame_phy(config);
+                specialised = specialised && fast->specialized() && !generic->specialized();
+
+                const PackedBits payload = random_payload(config.info_bits_per_block(), rng);
+                std::vector<cf32> a(config.samples_per_block()), b(a.size());
+                fast->encode(payload.view(), a);
+                generic->encode(payload.view(), b);
+                same_samples = same_samples && a == b;
+
+                TxChain tx(config);
+                BufferView<std::uint64_t> in = tx.acquire_input();
+                std::copy(payload.view().words, payload.view().words + payload.view().word_count(),
+                          in.begin());
+                const BufferView<cf32> chain = tx.process(std::move(in));
+                same_as_chain = same_as_chain && std::equal(a.begin(), a.end(), chain.begin());
+
+                // Noisy samples: both pipelines make the same decisions.
+                for (cf32& s : a) {
+                    s += cf32(g(rng), g(rng));
+                }
+                PackedBits da(payload.size()), db(payload.size()), clean(payload.size());
+                fast->decode(a, da.view());
+                generic->decode(a, db.view());
+                same_decisions = same_decisions && count_bit_errors(da.view(), db.view()) == 0;
+                fast->decode(b, clean.view());
+                roundtrip = roundtrip && count_bit_errors(clean.view(), payload.view()) == 0;
+
+                // A two-symbol frame behind a SIGNAL symbol.
+                fast->set_pilot_offset(1);
+                generic->set_pilot_offset(1);
+                const PackedBits short_payload = random_payload(fast->info_bits(2), rng);
+                std::vector<cf32> sa(2 * tables::kSymbolLength), sb(sa.size());
+                fast->encode(short_payload.view(), sa, 2);
+                generic->encode(short_payload.view(), sb, 2);
+                PackedBits back(short_payload.size());
+                fast->decode(sa, back.view(), 2);
+                offsets = offsets && sa == sb &&
+                          count_bit_errors(back.view(), short_payload.view()) == 0;
+            }
+        }
+    }
+    expect(configurations == 16, "eight 802.11a MCS, with and without the interleaver");
+    expect(specialised, "every 802.11a MCS has its own pipeline");
+    expect(same_samples, "specialised and runtime pipelines encode identically");
+    expect(same_as_chain, "and match a fresh TxChain");
+    expect(roundtrip, "noiseless frames decode error free");
+    expect(same_decisions, "noisy frames decode to the same bits");
+    expect(offsets, "short frames with a pilot offset agree and decode");
+
+    PhyConfig other;
+    other.modulation = Modulation::qam256;
+    expect(!make_frame_phy(other)->specialized(), "other configurations fall back at runtime");
+    other.symbols_per_block = 0;
+    expect_throws<std::invalid_argument>([&] { make_frame_phy(other); }, "invalid config");
+}
+
+}  // namespace
+
+int main() {
+    tables_match_runtime();
+    pipelines();
+    return dcomm::test::finish("static_phy");
+}